@@ -17,6 +17,7 @@
 #include <esp_matter.h>
 #include <esp_matter_client.h>
 #include <esp_matter_core.h>
+#include <esp_matter_mem.h>
 #include <json_to_tlv.h>
 
 #include <app/ConcreteAttributePath.h>
@@ -26,9 +27,11 @@
 #include <app/ReadClient.h>
 #include <app/ReadPrepareParams.h>
 #include <app/clusters/bindings/BindingManager.h>
+#include <app/util/binding-table.h>
 #include <core/Optional.h>
 #include <core/TLVReader.h>
 #include <core/TLVWriter.h>
+#include <credentials/GroupDataProvider.h>
 
 #include "app/CommandPathParams.h"
 #include "app/CommandSender.h"
@@ -109,6 +112,34 @@ esp_err_t group_request_send(uint8_t fabric_index, request_handle_t *req_handle)
     return ESP_OK;
 }
 
+static void set_request_remote_endpoint(request_handle_t *req_handle, chip::EndpointId remote_endpoint)
+{
+    if (req_handle->type == INVOKE_CMD) {
+        req_handle->command_path.mFlags.Set(chip::app::CommandPathFlags::kEndpointIdValid);
+        req_handle->command_path.mFlags.Clear(chip::app::CommandPathFlags::kGroupIdValid);
+        req_handle->command_path.mEndpointId = remote_endpoint;
+    } else if (req_handle->type == WRITE_ATTR || req_handle->type == READ_ATTR ||
+               req_handle->type == SUBSCRIBE_ATTR) {
+        req_handle->attribute_path.mEndpointId = remote_endpoint;
+    } else if (req_handle->type == READ_EVENT || req_handle->type == SUBSCRIBE_EVENT) {
+        req_handle->event_path.mEndpointId = remote_endpoint;
+    }
+}
+
+static bool send_binding_group_request(chip::FabricIndex fabric_index, chip::GroupId group_id,
+                                       request_handle_t *req_handle)
+{
+    // Only the invoke command without response could be sent to a group
+    if (!client_group_request_callback || req_handle->type != INVOKE_CMD) {
+        return false;
+    }
+    req_handle->command_path.mFlags.Set(chip::app::CommandPathFlags::kGroupIdValid);
+    req_handle->command_path.mFlags.Clear(chip::app::CommandPathFlags::kEndpointIdValid);
+    req_handle->command_path.mGroupId = group_id;
+    client_group_request_callback(fabric_index, req_handle, request_callback_priv_data);
+    return true;
+}
+
 static void esp_matter_command_client_binding_callback(const EmberBindingTableEntry &binding,
                                                        OperationalDeviceProxy *peer_device, void *context)
 {
@@ -116,29 +147,11 @@ static void esp_matter_command_client_binding_callback(const EmberBindingTableEn
     VerifyOrReturn(req_handle, ESP_LOGE(TAG, "Failed to call the binding callback since command handle is NULL"));
     if (binding.type == MATTER_UNICAST_BINDING && peer_device) {
         if (client_request_callback) {
-            if (req_handle->type == INVOKE_CMD) {
-                req_handle->command_path.mFlags.Set(chip::app::CommandPathFlags::kEndpointIdValid);
-                req_handle->command_path.mFlags.Clear(chip::app::CommandPathFlags::kGroupIdValid);
-                req_handle->command_path.mEndpointId = binding.remote;
-            } else if (req_handle->type == WRITE_ATTR || req_handle->type == READ_ATTR ||
-                       req_handle->type == SUBSCRIBE_ATTR) {
-                req_handle->attribute_path.mEndpointId = binding.remote;
-            } else if (req_handle->type == READ_EVENT || req_handle->type == SUBSCRIBE_EVENT) {
-                req_handle->event_path.mEndpointId = binding.remote;
-            }
+            set_request_remote_endpoint(req_handle, binding.remote);
             client_request_callback(peer_device, req_handle, request_callback_priv_data);
         }
     } else if (binding.type == MATTER_MULTICAST_BINDING && !peer_device) {
-        if (client_group_request_callback) {
-            if (req_handle->type == INVOKE_CMD) {
-                req_handle->command_path.mFlags.Set(chip::app::CommandPathFlags::kGroupIdValid);
-                req_handle->command_path.mFlags.Clear(chip::app::CommandPathFlags::kEndpointIdValid);
-                req_handle->command_path.mGroupId = binding.groupId;
-            } else {
-                return;
-            }
-            client_group_request_callback(binding.fabricIndex, req_handle, request_callback_priv_data);
-        }
+        send_binding_group_request(binding.fabricIndex, binding.groupId, req_handle);
     }
 }
 
@@ -149,19 +162,24 @@ static void esp_matter_binding_context_release(void *context)
     }
 }
 
-esp_err_t cluster_update(uint16_t local_endpoint_id, request_handle_t *req_handle)
+static chip::ClusterId get_request_cluster_id(const request_handle_t *req_handle)
 {
-    request_handle_t *context = chip::Platform::New<request_handle_t>(req_handle);
-    VerifyOrReturnError(context, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "failed to alloc memory for the request handle"));
-    chip::ClusterId notified_cluster_id = chip::kInvalidClusterId;
     if (req_handle->type == INVOKE_CMD) {
-        notified_cluster_id = req_handle->command_path.mClusterId;
+        return req_handle->command_path.mClusterId;
     } else if (req_handle->type == WRITE_ATTR || req_handle->type == READ_ATTR || req_handle->type == SUBSCRIBE_ATTR) {
-        notified_cluster_id = req_handle->attribute_path.mClusterId;
+        return req_handle->attribute_path.mClusterId;
     } else if (req_handle->type == READ_EVENT || req_handle->type == SUBSCRIBE_EVENT) {
-        notified_cluster_id = req_handle->event_path.mClusterId;
+        return req_handle->event_path.mClusterId;
     }
+    return chip::kInvalidClusterId;
+}
+
+esp_err_t cluster_update(uint16_t local_endpoint_id, request_handle_t *req_handle)
+{
+    chip::ClusterId notified_cluster_id = get_request_cluster_id(req_handle);
     VerifyOrReturnError(notified_cluster_id != chip::kInvalidClusterId, ESP_ERR_INVALID_ARG);
+    request_handle_t *context = chip::Platform::New<request_handle_t>(req_handle);
+    VerifyOrReturnError(context, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "failed to alloc memory for the request handle"));
     if (CHIP_NO_ERROR !=
         chip::BindingManager::GetInstance().NotifyBoundClusterChanged(local_endpoint_id, notified_cluster_id,
                                                                       static_cast<void *>(context))) {
@@ -173,6 +191,344 @@ esp_err_t cluster_update(uint16_t local_endpoint_id, request_handle_t *req_handl
     return ESP_OK;
 }
 
+/* Members of a group, as registered by the application with set_group_members(). */
+typedef struct group_members {
+    uint8_t fabric_index;
+    uint16_t group_id;
+    uint16_t count;
+    uint64_t *node_ids;
+    struct group_members *next;
+} group_members_t;
+
+static group_members_t *s_group_members_list = NULL;
+
+static void free_group_members(group_members_t *members)
+{
+    esp_matter_mem_free(members->node_ids);
+    esp_matter_mem_free(members);
+}
+
+esp_err_t set_group_members(uint8_t fabric_index, uint16_t group_id, const uint64_t *node_ids, uint16_t count)
+{
+    VerifyOrReturnError(count == 0 || node_ids, ESP_ERR_INVALID_ARG);
+    group_members_t **current = &s_group_members_list;
+    while (*current && ((*current)->fabric_index != fabric_index || (*current)->group_id != group_id)) {
+        current = &(*current)->next;
+    }
+    if (*current) {
+        group_members_t *removed = *current;
+        *current = removed->next;
+        free_group_members(removed);
+    }
+    if (count == 0) {
+        return ESP_OK;
+    }
+
+    group_members_t *members = (group_members_t *)esp_matter_mem_calloc(1, sizeof(group_members_t));
+    VerifyOrReturnError(members, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Couldn't allocate group members"));
+    members->node_ids = (uint64_t *)esp_matter_mem_calloc(count, sizeof(uint64_t));
+    if (!members->node_ids) {
+        esp_matter_mem_free(members);
+        ESP_LOGE(TAG, "Couldn't allocate group member node IDs");
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(members->node_ids, node_ids, count * sizeof(uint64_t));
+    members->fabric_index = fabric_index;
+    members->group_id = group_id;
+    members->count = count;
+    members->next = s_group_members_list;
+    s_group_members_list = members;
+    return ESP_OK;
+}
+
+static bool has_group_key(uint8_t fabric_index, uint16_t group_id)
+{
+    chip::Credentials::GroupDataProvider *provider = chip::Credentials::GetGroupDataProvider();
+    VerifyOrReturnValue(provider, false);
+    auto *iterator = provider->IterateGroupKeys(fabric_index);
+    VerifyOrReturnValue(iterator, false);
+    chip::Credentials::GroupDataProvider::GroupKey mapping;
+    bool found = false;
+    while (!found && iterator->Next(mapping)) {
+        found = mapping.group_id == group_id;
+    }
+    iterator->Release();
+    return found;
+}
+
+namespace fan_out {
+
+static uint32_t now_ms()
+{
+    return static_cast<uint32_t>(chip::System::SystemClock().GetMonotonicMilliseconds64().count());
+}
+
+struct context;
+
+/* One peer of the fan-out. All the unicast binding entries pointing to the same (fabric, node) share it, so the
+ * session is found or established once and reused for each of their remote endpoints.
+ */
+struct peer {
+    peer(context *owner, const ScopedNodeId &id)
+        : owner(owner)
+        , id(id)
+        , on_connected_cb(on_connected, this)
+        , on_failure_cb(on_failure, this)
+    {
+    }
+
+    static void on_connected(void *ctx, ExchangeManager &exchange_mgr, const SessionHandle &session_handle);
+    static void on_failure(void *ctx, const ScopedNodeId &peer_id, CHIP_ERROR error);
+
+    context *owner;
+    ScopedNodeId id;
+    uint32_t start_ms = 0;
+    bool done = false;
+    Callback<chip::OnDeviceConnected> on_connected_cb;
+    Callback<chip::OnDeviceConnectionFailure> on_failure_cb;
+};
+
+struct target {
+    uint8_t peer_index;
+    chip::EndpointId remote;
+};
+
+struct context {
+    context(request_handle_t *req, const fan_out_config_t &config)
+        : request(req)
+        , config(config)
+    {
+        if (this->config.max_in_flight == 0) {
+            this->config.max_in_flight = CONFIG_ESP_MATTER_BINDING_FAN_OUT_MAX_IN_FLIGHT;
+        }
+    }
+
+    uint8_t group_fallback_min_peers() const
+    {
+        return config.group_fallback_min_peers ? config.group_fallback_min_peers
+                                               : CONFIG_ESP_MATTER_BINDING_FAN_OUT_GROUP_MIN_PEERS;
+    }
+
+    ~context()
+    {
+        for (uint16_t i = 0; i < report.peers; ++i) {
+            chip::Platform::Delete(peers[i]);
+        }
+    }
+
+    request_handle_t request;
+    fan_out_config_t config;
+    fan_out_report_t report = {};
+    uint32_t start_ms = 0;
+    peer *peers[MATTER_BINDING_TABLE_SIZE] = {};
+    target targets[MATTER_BINDING_TABLE_SIZE] = {};
+    uint16_t next_peer = 0;
+    uint16_t in_flight = 0;
+    uint16_t completed = 0;
+    bool dispatching = false;
+};
+
+static void finish(context *ctx)
+{
+    ctx->report.elapsed_ms = now_ms() - ctx->start_ms;
+    ESP_LOGI(TAG, "Fan-out done: %u/%u peers succeeded (%u reused sessions), max latency %" PRIu32 " ms",
+             ctx->report.succeeded, ctx->report.peers, ctx->report.reused_sessions, ctx->report.max_latency_ms);
+    if (ctx->config.done_cb) {
+        ctx->config.done_cb(&ctx->report, ctx->config.priv_data);
+    }
+    chip::Platform::Delete(ctx);
+}
+
+static void dispatch(context *ctx);
+
+static void complete_peer(peer *p, bool success)
+{
+    context *ctx = p->owner;
+    if (p->done) {
+        return;
+    }
+    p->done = true;
+    if (success) {
+        uint32_t latency_ms = now_ms() - p->start_ms;
+        ctx->report.succeeded++;
+        ctx->report.total_latency_ms += latency_ms;
+        if (latency_ms > ctx->report.max_latency_ms) {
+            ctx->report.max_latency_ms = latency_ms;
+        }
+    } else {
+        ctx->report.failed++;
+    }
+    ctx->in_flight--;
+    ctx->completed++;
+    // The completion might be called synchronously from FindOrEstablishSession() in dispatch(), in which case the
+    // dispatch loop carries on by itself.
+    if (!ctx->dispatching) {
+        dispatch(ctx);
+    }
+}
+
+void peer::on_connected(void *ctx, ExchangeManager &exchange_mgr, const SessionHandle &session_handle)
+{
+    peer *p = static_cast<peer *>(ctx);
+    context *owner = p->owner;
+    if (client_request_callback) {
+        OperationalDeviceProxy device(&exchange_mgr, session_handle);
+        for (uint16_t i = 0; i < owner->report.unicast_targets; ++i) {
+            if (owner->peers[owner->targets[i].peer_index] != p) {
+                continue;
+            }
+            request_handle_t req_handle(&owner->request);
+            set_request_remote_endpoint(&req_handle, owner->targets[i].remote);
+            client_request_callback(&device, &req_handle, request_callback_priv_data);
+        }
+    }
+    complete_peer(p, true);
+}
+
+void peer::on_failure(void *ctx, const ScopedNodeId &peer_id, CHIP_ERROR error)
+{
+    ESP_LOGE(TAG, "Fan-out failed to connect to node 0x%" PRIx64 ": %" CHIP_ERROR_FORMAT, peer_id.GetNodeId(),
+             error.Format());
+    complete_peer(static_cast<peer *>(ctx), false);
+}
+
+static void dispatch(context *ctx)
+{
+    chip::CASESessionManager *case_session_mgr = chip::Server::GetInstance().GetCASESessionManager();
+    ctx->dispatching = true;
+    while (ctx->in_flight < ctx->config.max_in_flight && ctx->next_peer < ctx->report.peers) {
+        peer *p = ctx->peers[ctx->next_peer++];
+        if (p->done) {
+            // Already served by a group request
+            continue;
+        }
+        p->start_ms = now_ms();
+        ctx->in_flight++;
+        if (case_session_mgr->FindExistingSession(p->id).HasValue()) {
+            ctx->report.reused_sessions++;
+        }
+        // The callbacks are called synchronously if the session is already established.
+        case_session_mgr->FindOrEstablishSession(p->id, &p->on_connected_cb, &p->on_failure_cb);
+    }
+    ctx->dispatching = false;
+    if (ctx->completed == ctx->report.peers) {
+        finish(ctx);
+    }
+}
+
+static esp_err_t add_unicast_target(context *ctx, const EmberBindingTableEntry &binding)
+{
+    ScopedNodeId peer_id(binding.nodeId, binding.fabricIndex);
+    uint16_t peer_index = 0;
+    for (; peer_index < ctx->report.peers; ++peer_index) {
+        if (ctx->peers[peer_index]->id == peer_id) {
+            break;
+        }
+    }
+    if (peer_index == ctx->report.peers) {
+        ctx->peers[peer_index] = chip::Platform::New<peer>(ctx, peer_id);
+        VerifyOrReturnError(ctx->peers[peer_index], ESP_ERR_NO_MEM);
+        ctx->report.peers++;
+    }
+    ctx->targets[ctx->report.unicast_targets].peer_index = static_cast<uint8_t>(peer_index);
+    ctx->targets[ctx->report.unicast_targets].remote = binding.remote;
+    ctx->report.unicast_targets++;
+    return ESP_OK;
+}
+
+/* Count the peers of the fan-out covered by a group, or 0 if the group has a member which is not a pending peer of
+ * the fan-out, since the group request would then also reach a node which is not bound.
+ */
+static uint16_t count_covered_peers(context *ctx, const group_members_t *members)
+{
+    for (uint16_t i = 0; i < members->count; ++i) {
+        ScopedNodeId member_id(members->node_ids[i], members->fabric_index);
+        bool pending = false;
+        for (uint16_t j = 0; j < ctx->report.peers && !pending; ++j) {
+            pending = !ctx->peers[j]->done && ctx->peers[j]->id == member_id;
+        }
+        if (!pending) {
+            return 0;
+        }
+    }
+    return members->count;
+}
+
+/* Replace the unicast requests to the peers which are all the members of a registered group with a single group
+ * request, picking the group covering the most peers first. The remaining peers are then served by unicast.
+ */
+static void collapse_to_groups(context *ctx)
+{
+    VerifyOrReturn(ctx->config.group_fallback && ctx->request.type == INVOKE_CMD && client_group_request_callback);
+    while (true) {
+        const group_members_t *best = NULL;
+        uint16_t best_count = 0;
+        for (const group_members_t *members = s_group_members_list; members; members = members->next) {
+            uint16_t covered = count_covered_peers(ctx, members);
+            if (covered >= ctx->group_fallback_min_peers() && covered > best_count &&
+                has_group_key(members->fabric_index, members->group_id)) {
+                best = members;
+                best_count = covered;
+            }
+        }
+        if (!best) {
+            return;
+        }
+
+        request_handle_t group_req_handle(&ctx->request);
+        send_binding_group_request(best->fabric_index, best->group_id, &group_req_handle);
+        ctx->report.group_targets++;
+        for (uint16_t i = 0; i < ctx->report.peers; ++i) {
+            peer *p = ctx->peers[i];
+            for (uint16_t j = 0; j < best->count && !p->done; ++j) {
+                if (p->id == ScopedNodeId(best->node_ids[j], best->fabric_index)) {
+                    p->done = true;
+                    ctx->completed++;
+                    ctx->report.collapsed_peers++;
+                }
+            }
+        }
+        ESP_LOGI(TAG, "Fan-out collapsed %u peers into group 0x%04x", best_count, best->group_id);
+    }
+}
+
+} // namespace fan_out
+
+esp_err_t cluster_update_fan_out(uint16_t local_endpoint_id, request_handle_t *req_handle,
+                                 const fan_out_config_t *config)
+{
+    VerifyOrReturnError(req_handle, ESP_ERR_INVALID_ARG);
+    chip::ClusterId cluster_id = get_request_cluster_id(req_handle);
+    VerifyOrReturnError(cluster_id != chip::kInvalidClusterId, ESP_ERR_INVALID_ARG);
+    fan_out_config_t default_config;
+    fan_out::context *ctx = chip::Platform::New<fan_out::context>(req_handle, config ? *config : default_config);
+    VerifyOrReturnError(ctx, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "failed to alloc memory for the fan-out context"));
+    ctx->start_ms = fan_out::now_ms();
+
+    for (const EmberBindingTableEntry &binding : chip::BindingTable::GetInstance()) {
+        if (binding.local != local_endpoint_id ||
+            (binding.clusterId.HasValue() && binding.clusterId.Value() != cluster_id)) {
+            continue;
+        }
+        if (binding.type == MATTER_UNICAST_BINDING) {
+            if (fan_out::add_unicast_target(ctx, binding) != ESP_OK) {
+                chip::Platform::Delete(ctx);
+                ESP_LOGE(TAG, "failed to alloc memory for the fan-out peer");
+                return ESP_ERR_NO_MEM;
+            }
+        } else if (binding.type == MATTER_MULTICAST_BINDING) {
+            request_handle_t group_req_handle(req_handle);
+            if (send_binding_group_request(binding.fabricIndex, binding.groupId, &group_req_handle)) {
+                ctx->report.group_targets++;
+            }
+        }
+    }
+
+    fan_out::collapse_to_groups(ctx);
+    fan_out::dispatch(ctx);
+    return ESP_OK;
+}
+
 static void __binding_manager_init(intptr_t arg)
 {
     auto &server = chip::Server::GetInstance();
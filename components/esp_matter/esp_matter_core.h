@@ -1088,5 +1088,99 @@ esp_err_t set_request_callback(request_callback_t callback, group_request_callba
  */
 esp_err_t cluster_update(uint16_t local_endpoint_id, request_handle_t *req_handle);
 
+/** Binding fan-out report
+ *
+ * Aggregated result of a `cluster_update_fan_out()` call. It is passed to the fan-out done callback once every bound
+ * target has been served.
+ */
+typedef struct fan_out_report {
+    /** Number of unicast binding entries matching the local endpoint and cluster */
+    uint16_t unicast_targets;
+    /** Number of distinct peers (fabric index, node ID) among the unicast targets */
+    uint16_t peers;
+    /** Peers for which the request send callback has been called */
+    uint16_t succeeded;
+    /** Peers to which no session could be established */
+    uint16_t failed;
+    /** Peers served from an already established CASE session */
+    uint16_t reused_sessions;
+    /** Number of group requests sent, for multicast binding entries and for collapsed unicast peers */
+    uint16_t group_targets;
+    /** Unicast peers served by a group request instead of a unicast session, see `fan_out_config_t::group_fallback` */
+    uint16_t collapsed_peers;
+    /** Latency of the slowest peer, from dispatch to request send callback */
+    uint32_t max_latency_ms;
+    /** Sum of the per-peer latencies, divide it by `succeeded` to get the mean latency */
+    uint32_t total_latency_ms;
+    /** Time from the fan-out start to the completion of the last peer */
+    uint32_t elapsed_ms;
+} fan_out_report_t;
+
+/** Binding fan-out done callback
+ *
+ * @param[in] report Aggregated report of the fan-out. It is only valid during the callback.
+ * @param[in] priv_data Private data passed in the fan-out configuration.
+ */
+typedef void (*fan_out_done_callback_t)(const fan_out_report_t *report, void *priv_data);
+
+/** Binding fan-out configuration */
+typedef struct fan_out_config {
+    /** Maximum number of peers with a session establishment in flight, 0 means using
+     * CONFIG_ESP_MATTER_BINDING_FAN_OUT_MAX_IN_FLIGHT.
+     */
+    uint8_t max_in_flight;
+    /** (Optional) Callback called when all the bound targets have been served */
+    fan_out_done_callback_t done_cb;
+    /** (Optional) Private data passed to the done callback */
+    void *priv_data;
+    /** Collapse the unicast peers which are all the members of a common group into a single group request. Only
+     * applies to INVOKE_CMD requests and to the groups registered with `set_group_members()`.
+     */
+    bool group_fallback;
+    /** Minimum number of unicast peers a group should cover to be used for the fallback, 0 means using
+     * CONFIG_ESP_MATTER_BINDING_FAN_OUT_GROUP_MIN_PEERS.
+     */
+    uint8_t group_fallback_min_peers;
+    fan_out_config()
+        : max_in_flight(0), done_cb(NULL), priv_data(NULL), group_fallback(false), group_fallback_min_peers(0) {}
+} fan_out_config_t;
+
+/** Cluster update with concurrent fan-out
+ *
+ * Same as `cluster_update()`, but the sessions to all the unicast binding targets are found or established
+ * concurrently, with at most `max_in_flight` establishments pending at a time. Binding entries pointing to the same
+ * peer share a single session, and peers which already have an established CASE session are served immediately. The
+ * request send callback is called once per unicast binding entry and the group request send callback once per
+ * multicast binding entry, as for `cluster_update()`.
+ *
+ * @param[in] local_endpoint_id The ID of the local endpoint with a binding cluster.
+ * @param[in] req_handle Request information to send to the bound targets.
+ * @param[in] config (Optional) Fan-out configuration, NULL for the defaults.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t cluster_update_fan_out(uint16_t local_endpoint_id, request_handle_t *req_handle,
+                                 const fan_out_config_t *config = NULL);
+
+/** Set group members
+ *
+ * Record the nodes which have been added to a group, so that `cluster_update_fan_out()` could replace the unicast
+ * requests to these nodes with a single group request. The group request reaches every endpoint of the members which
+ * is in the group, so the list should only be registered for groups whose members are bound on the endpoints in the
+ * group. Setting the members of an already registered group replaces its previous members.
+ *
+ * @note The group request is only sent if the local node has a group key mapped to the group on the fabric.
+ *
+ * @param[in] fabric_index Fabric index of the group.
+ * @param[in] group_id Group ID.
+ * @param[in] node_ids Node IDs of the group members.
+ * @param[in] count Number of node IDs, 0 removes the group.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_group_members(uint8_t fabric_index, uint16_t group_id, const uint64_t *node_ids, uint16_t count);
+
 } /* client */
 } /* esp_matter */
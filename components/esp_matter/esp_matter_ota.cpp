@@ -19,6 +19,7 @@
 #include <app/clusters/ota-requestor/DefaultOTARequestor.h>
 #include <app/clusters/ota-requestor/ExtendedOTARequestorDriver.h>
 #include <app/clusters/ota-requestor/DefaultOTARequestorStorage.h>
+#include <platform/PlatformManager.h>
 #ifdef CONFIG_CHIP_ENABLE_EXTERNAL_PLATFORM
 #ifndef EXTERNAL_ESP32OTAIMAGEPROCESSORIMPL_HEADER
 #error "Please define EXTERNAL_ESP32OTAIMAGEPROCESSORIMPL_HEADER in your external platform gn/cmake file"
@@ -27,9 +28,13 @@
 #else // CONFIG_CHIP_ENABLE_EXTERNAL_PLATFORM
 #include <platform/ESP32/OTAImageProcessorImpl.h>
 #endif // !CONFIG_CHIP_ENABLE_EXTERNAL_PLATFORM
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_IMAGE_PROCESSOR
+#include <esp_matter_ota_image_processor.h>
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_IMAGE_PROCESSOR
 
 #include <esp_matter.h>
 #include <esp_matter_ota.h>
+#include <inttypes.h>
 #include <zap-generated/endpoint_config.h>
 
 using chip::BDXDownloader;
@@ -44,11 +49,137 @@ using namespace esp_matter::endpoint;
 using namespace esp_matter::cluster;
 
 #if CONFIG_ENABLE_OTA_REQUESTOR
+static const char *TAG = "esp_matter_ota";
+
+static esp_matter::ota::transfer_recorder_t s_transfer_recorder;
+// Transfers of the update which failed since the last complete transfer
+static uint32_t s_failed_transfers = 0;
+// The image is received and the image processor is validating it
+static bool s_transfer_finalizing = false;
+static uint64_t s_block_query_ms = 0;
+
+// Downloader which records when the BlockQuery messages are sent, for the round-trip time of the blocks
+class EspBDXDownloader : public BDXDownloader {
+public:
+    CHIP_ERROR FetchNextData() override
+    {
+        s_block_query_ms = esp_matter::ota::transfer_timestamp_ms();
+        return BDXDownloader::FetchNextData();
+    }
+};
+
+// Image processor which records the transfer statistics and forwards the calls to the image processor of the
+// requestor, so that the statistics are recorded whichever image processor is used
+class EspOTATransferStatsProcessor : public chip::OTAImageProcessorInterface {
+public:
+    void SetImageProcessor(chip::OTAImageProcessorInterface *processor) { mProcessor = processor; }
+
+    CHIP_ERROR PrepareDownload() override
+    {
+        // A transfer which was not reported as downloaded or aborted is counted as failed
+        EndTransfer(false);
+        esp_matter::ota::transfer_recorder_start(&s_transfer_recorder, s_failed_transfers);
+        s_block_query_ms = 0;
+        return mProcessor->PrepareDownload();
+    }
+
+    CHIP_ERROR Finalize() override
+    {
+        // The transfer is complete once the image processor reports the image as downloaded, after the patch or the
+        // decompressor is finished and the image is validated
+        s_transfer_finalizing = StopRecording();
+        CHIP_ERROR err = mProcessor->Finalize();
+        if (err != CHIP_NO_ERROR) {
+            EndTransfer(false);
+        }
+        return err;
+    }
+
+    CHIP_ERROR Apply() override { return mProcessor->Apply(); }
+
+    CHIP_ERROR Abort() override
+    {
+        EndTransfer(false);
+        return mProcessor->Abort();
+    }
+
+    CHIP_ERROR ProcessBlock(chip::ByteSpan &block) override
+    {
+        if (s_block_query_ms != 0) {
+            esp_matter::ota::transfer_recorder_add_rtt(
+                &s_transfer_recorder,
+                static_cast<uint32_t>(esp_matter::ota::transfer_timestamp_ms() - s_block_query_ms));
+            s_block_query_ms = 0;
+        }
+        esp_matter::ota::transfer_recorder_add_block(&s_transfer_recorder, block.size());
+        return mProcessor->ProcessBlock(block);
+    }
+
+    chip::app::DataModel::Nullable<uint8_t> GetPercentComplete() override { return mProcessor->GetPercentComplete(); }
+    uint64_t GetBytesDownloaded() override { return mProcessor->GetBytesDownloaded(); }
+    bool IsFirstImageRun() override { return mProcessor->IsFirstImageRun(); }
+    CHIP_ERROR ConfirmCurrentImage() override { return mProcessor->ConfirmCurrentImage(); }
+
+    static void OnOtaStateChanged(const chip::DeviceLayer::ChipDeviceEvent *event, intptr_t arg)
+    {
+        if (event->Type != chip::DeviceLayer::DeviceEventType::kOtaStateChanged) {
+            return;
+        }
+        switch (event->OtaStateChanged.newState) {
+        case chip::DeviceLayer::kOtaDownloadComplete:
+            EndTransfer(true);
+            break;
+        case chip::DeviceLayer::kOtaDownloadFailed:
+        case chip::DeviceLayer::kOtaDownloadAborted:
+            EndTransfer(false);
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    // Returns whether a transfer was being recorded
+    static bool StopRecording()
+    {
+        esp_matter::ota::transfer_stats_t stats;
+        esp_matter::ota::transfer_recorder_get_stats(&s_transfer_recorder, &stats);
+        if (!stats.active) {
+            return false;
+        }
+        esp_matter::ota::transfer_recorder_stop(&s_transfer_recorder);
+        return true;
+    }
+
+    static void EndTransfer(bool complete)
+    {
+        if (!StopRecording() && !s_transfer_finalizing) {
+            return;
+        }
+        s_transfer_finalizing = false;
+        esp_matter::ota::transfer_stats_t stats;
+        esp_matter::ota::transfer_recorder_get_stats(&s_transfer_recorder, &stats);
+        s_failed_transfers = complete ? 0 : s_failed_transfers + 1;
+        ESP_LOGI(TAG,
+                 "OTA image transfer %s: %" PRIu64 " bytes in %" PRIu32 " ms (%" PRIu32 " B/s), rtt avg %" PRIu32
+                 " ms, max %" PRIu32 " ms, stalls %" PRIu32 " (%" PRIu32 " ms), retries %" PRIu32,
+                 complete ? "completed" : "failed", stats.bytes, stats.elapsed_ms, stats.throughput_bps,
+                 stats.avg_rtt_ms, stats.max_rtt_ms, stats.stalls, stats.total_stall_ms, stats.retries);
+    }
+
+    chip::OTAImageProcessorInterface *mProcessor = nullptr;
+};
+
 DefaultOTARequestor gRequestorCore;
 DefaultOTARequestorStorage gRequestorStorage;
 ExtendedOTARequestorDriver gRequestorUser;
-BDXDownloader gDownloader;
+EspBDXDownloader gDownloader;
+EspOTATransferStatsProcessor gTransferStatsProcessor;
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_IMAGE_PROCESSOR
+esp_matter::ota::EspOTAImageProcessor gImageProcessor;
+#else
 OTAImageProcessorImpl gImageProcessor;
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_IMAGE_PROCESSOR
 
 static esp_matter_ota_requestor_impl_t s_ota_requestor_impl = {
     .driver = &gRequestorUser,
@@ -105,7 +236,9 @@ void esp_matter_ota_requestor_start(void)
 
     gImageProcessor.SetOTADownloader(&gDownloader);
 
-    gDownloader.SetImageProcessorDelegate(s_ota_requestor_impl.image_processor);
+    gTransferStatsProcessor.SetImageProcessor(s_ota_requestor_impl.image_processor);
+    gDownloader.SetImageProcessorDelegate(&gTransferStatsProcessor);
+    chip::DeviceLayer::PlatformMgr().AddEventHandler(EspOTATransferStatsProcessor::OnOtaStateChanged, 0);
 
     s_ota_requestor_impl.driver->SetUserConsentDelegate(s_ota_requestor_impl.user_consent);
     s_ota_requestor_impl.driver->Init(&gRequestorCore, s_ota_requestor_impl.image_processor);
@@ -140,3 +273,14 @@ esp_err_t esp_matter_ota_requestor_set_config(const esp_matter_ota_config_t & co
     return ESP_ERR_NOT_SUPPORTED;
 #endif // CONFIG_ENABLE_OTA_REQUESTOR
 }
+
+esp_err_t esp_matter_ota_requestor_get_transfer_stats(esp_matter::ota::transfer_stats_t *stats)
+{
+#if CONFIG_ENABLE_OTA_REQUESTOR
+    VerifyOrReturnError(stats != nullptr, ESP_ERR_INVALID_ARG);
+    esp_matter::ota::transfer_recorder_get_stats(&s_transfer_recorder, stats);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif // CONFIG_ENABLE_OTA_REQUESTOR
+}
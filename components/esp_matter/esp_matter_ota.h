@@ -16,6 +16,7 @@
 
 #include "esp_err.h"
 #include "sdkconfig.h"
+#include <esp_matter_ota_transfer_stats.h>
 
 #include <app/clusters/ota-requestor/ExtendedOTARequestorDriver.h>
 #include <app/clusters/ota-requestor/OTARequestorUserConsentDelegate.h>
@@ -86,3 +87,19 @@ esp_err_t esp_matter_ota_requestor_encrypted_init(const char *key, uint16_t size
  * @note Ensure that this API is called only after esp_matter::start() has been invoked.
  */
 esp_err_t esp_matter_ota_requestor_set_config(const esp_matter_ota_config_t & config);
+
+/**
+ * @brief Get the statistics of the current or of the last BDX transfer of an OTA image to the OTA Requestor
+ *
+ * The statistics include the bytes downloaded, the round-trip time of the blocks, the throughput, the stalls of the
+ * transfer and the count of the transfers of the update which failed before it. A transfer is counted as complete
+ * once the image processor reports the image as downloaded with a kOtaDownloadComplete state change event, so that
+ * the transfers of the images which fail the validation are counted as failed.
+ *
+ * @param[out] stats The transfer statistics
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ *
+ * @note Call this API in the Matter context or with the Matter stack lock.
+ */
+esp_err_t esp_matter_ota_requestor_get_transfer_stats(esp_matter::ota::transfer_stats_t *stats);
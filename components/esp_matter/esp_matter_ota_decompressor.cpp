@@ -0,0 +1,174 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_decompressor.h>
+#include <inttypes.h>
+#include <string.h>
+
+static const char *TAG = "esp_matter_compressed_ota";
+
+namespace esp_matter {
+namespace ota {
+namespace compression {
+
+static constexpr size_t items_per_group = 8;
+
+typedef enum : uint8_t {
+    k_state_header,
+    k_state_flags,
+    k_state_item,
+    k_state_match,
+} decompressor_state_t;
+
+struct decompressor {
+    write_cb_t write;
+    void *ctx;
+    decompressor_state_t state;
+    header_t header;
+    size_t header_len;
+    uint8_t flags;
+    uint8_t items_left;
+    // The first byte of a match split between two blocks
+    uint8_t match_low;
+    // The window is a ring of the last decompressed bytes, the bytes from flushed to the write position are not
+    // written yet
+    uint32_t out_len;
+    size_t flushed;
+    uint8_t window[k_window_size];
+};
+
+static esp_err_t _flush(decompressor *dec, size_t end)
+{
+    if (end > dec->flushed) {
+        ESP_RETURN_ON_ERROR(dec->write(dec->ctx, dec->window + dec->flushed, end - dec->flushed), TAG,
+                            "Failed to write the decompressed firmware");
+    }
+    dec->flushed = end % k_window_size;
+    return ESP_OK;
+}
+
+static esp_err_t _put(decompressor *dec, uint8_t byte)
+{
+    ESP_RETURN_ON_FALSE(dec->out_len < dec->header.size, ESP_ERR_INVALID_SIZE, TAG,
+                        "The payload decompresses to more than %" PRIu32 " bytes", dec->header.size);
+    size_t pos = dec->out_len % k_window_size;
+    dec->window[pos] = byte;
+    dec->out_len++;
+    if (pos == k_window_size - 1) {
+        return _flush(dec, k_window_size);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t _process_header(decompressor *dec)
+{
+    ESP_RETURN_ON_FALSE(dec->header.magic == k_compressed_magic, ESP_ERR_INVALID_ARG, TAG, "Invalid payload magic");
+    ESP_RETURN_ON_FALSE(dec->header.version == k_compressed_version && dec->header.window_bits == k_window_bits,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "Unsupported compressed payload version %" PRIu32,
+                        dec->header.version);
+    ESP_LOGI(TAG, "Decompressing a firmware of %" PRIu32 " bytes", dec->header.size);
+    dec->state = k_state_flags;
+    return ESP_OK;
+}
+
+static esp_err_t _process_match(decompressor *dec, uint16_t match)
+{
+    uint32_t distance = (match & (k_window_size - 1)) + 1;
+    size_t len = (match >> k_window_bits) + k_min_match_len;
+    ESP_RETURN_ON_FALSE(distance <= dec->out_len, ESP_ERR_INVALID_ARG, TAG, "The match is before the firmware start");
+    for (size_t i = 0; i < len; ++i) {
+        ESP_RETURN_ON_ERROR(_put(dec, dec->window[(dec->out_len - distance) % k_window_size]), TAG,
+                            "Failed to decompress a match");
+    }
+    return ESP_OK;
+}
+
+esp_err_t decompressor_create(write_cb_t write, void *ctx, decompressor_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(write && handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    decompressor *dec = (decompressor *)esp_matter_mem_calloc(1, sizeof(decompressor));
+    ESP_RETURN_ON_FALSE(dec, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the decompressor");
+    dec->write = write;
+    dec->ctx = ctx;
+    dec->state = k_state_header;
+    *handle = dec;
+    return ESP_OK;
+}
+
+esp_err_t decompressor_feed(decompressor_handle_t handle, const uint8_t *data, size_t size)
+{
+    ESP_RETURN_ON_FALSE(handle && (data || size == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    const uint8_t *end = data + size;
+    while (data < end) {
+        switch (handle->state) {
+        case k_state_header: {
+            size_t len = std::min(static_cast<size_t>(end - data), sizeof(header_t) - handle->header_len);
+            memcpy(reinterpret_cast<uint8_t *>(&handle->header) + handle->header_len, data, len);
+            handle->header_len += len;
+            data += len;
+            if (handle->header_len == sizeof(header_t)) {
+                ESP_RETURN_ON_ERROR(_process_header(handle), TAG, "Invalid compressed payload header");
+            }
+            break;
+        }
+        case k_state_flags:
+            handle->flags = *data++;
+            handle->items_left = items_per_group;
+            handle->state = k_state_item;
+            break;
+        case k_state_item:
+            if (handle->flags & 1) {
+                ESP_RETURN_ON_ERROR(_put(handle, *data++), TAG, "Failed to decompress a literal");
+            } else {
+                handle->match_low = *data++;
+                handle->state = k_state_match;
+                break;
+            }
+            handle->flags >>= 1;
+            handle->state = --handle->items_left > 0 ? k_state_item : k_state_flags;
+            break;
+        case k_state_match:
+            ESP_RETURN_ON_ERROR(_process_match(handle, handle->match_low | (*data++ << 8)), TAG,
+                                "Invalid compressed payload");
+            handle->flags >>= 1;
+            handle->state = --handle->items_left > 0 ? k_state_item : k_state_flags;
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t decompressor_finish(decompressor_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(handle->state != k_state_header && handle->state != k_state_match &&
+                            handle->out_len == handle->header.size,
+                        ESP_ERR_INVALID_SIZE, TAG, "The payload is truncated, %" PRIu32 " of %" PRIu32 " bytes",
+                        handle->out_len, handle->header.size);
+    size_t end = handle->out_len % k_window_size;
+    return end > 0 ? _flush(handle, end) : ESP_OK;
+}
+
+void decompressor_destroy(decompressor_handle_t handle)
+{
+    esp_matter_mem_free(handle);
+}
+
+} // namespace compression
+} // namespace ota
+} // namespace esp_matter
@@ -0,0 +1,70 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota {
+namespace compression {
+
+/* Compressed OTA payloads
+ *
+ * The payload of a compressed OTA image is the firmware compressed with LZSS over a window of 4 KB, so that the
+ * decompressor only needs the window in RAM. The payload is decompressed while it is downloaded, and the firmware is
+ * written to the passive OTA partition in chunks of the window size.
+ *
+ * The payload starts with a header_t, followed by groups of up to 8 items. A group starts with a flags byte, the bit
+ * i (from the least significant bit) is set if the item i of the group is a literal byte, otherwise the item is a
+ * match of two bytes: a little endian u16 with the distance - 1 in the k_window_bits low bits and the length -
+ * k_min_match_len in the high bits. The integers are little endian. tools/compressed_ota/compress_ota_payload.py
+ * compresses the firmware.
+ */
+
+constexpr uint32_t k_compressed_magic = 0x41544F5A; // "ZOTA"
+constexpr uint32_t k_compressed_version = 1;
+constexpr uint8_t k_window_bits = 12;
+constexpr size_t k_window_size = 1 << k_window_bits;
+constexpr size_t k_min_match_len = 3;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t window_bits;
+    uint8_t reserved[3];
+    // Size of the decompressed firmware
+    uint32_t size;
+} __attribute__((packed)) header_t;
+
+// Write the next bytes of the decompressed firmware
+typedef esp_err_t (*write_cb_t)(void *ctx, const uint8_t *buf, size_t size);
+
+typedef struct decompressor *decompressor_handle_t;
+
+esp_err_t decompressor_create(write_cb_t write, void *ctx, decompressor_handle_t *handle);
+
+/* Decompress the next bytes of the payload, the decompressed bytes are written once the window is full */
+esp_err_t decompressor_feed(decompressor_handle_t handle, const uint8_t *data, size_t size);
+
+/* Write the rest of the decompressed bytes and check the size of the firmware */
+esp_err_t decompressor_finish(decompressor_handle_t handle);
+
+void decompressor_destroy(decompressor_handle_t handle);
+
+} // namespace compression
+} // namespace ota
+} // namespace esp_matter
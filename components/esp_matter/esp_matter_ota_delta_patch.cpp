@@ -0,0 +1,300 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_delta_patch.h>
+#include <inttypes.h>
+#include <mbedtls/sha256.h>
+#include <string.h>
+
+static const char *TAG = "esp_matter_delta_ota";
+
+namespace esp_matter {
+namespace ota {
+namespace delta {
+
+// The base and the target are processed in chunks of this size
+static constexpr size_t chunk_size = 256;
+static constexpr size_t offset_args_len = 8;
+static constexpr size_t insert_args_len = 4;
+
+typedef enum : uint8_t {
+    k_state_header,
+    k_state_check_base,
+    k_state_op,
+    k_state_args,
+    k_state_copy,
+    k_state_add,
+    k_state_insert,
+    k_state_end,
+} applier_state_t;
+
+struct patch_applier {
+    read_base_cb_t read_base;
+    write_target_cb_t write_target;
+    void *ctx;
+    applier_state_t state;
+    patch_op_t op;
+    patch_header_t header;
+    // Bytes of the header or of the arguments of a record received so far
+    uint8_t acc[sizeof(patch_header_t)];
+    size_t acc_len;
+    size_t acc_needed;
+    // The next base offset of the base check or of a record, and the bytes left in the current record
+    uint32_t base_offset;
+    uint32_t remaining;
+    uint32_t target_len;
+    mbedtls_sha256_context base_sha;
+    mbedtls_sha256_context target_sha;
+};
+
+static uint32_t _read_le32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Accumulate bytes in the applier until acc_needed bytes are received, returns whether they are all received
+static bool _accumulate(patch_applier *applier, const uint8_t *&data, size_t &size)
+{
+    size_t len = std::min(size, applier->acc_needed - applier->acc_len);
+    memcpy(applier->acc + applier->acc_len, data, len);
+    applier->acc_len += len;
+    data += len;
+    size -= len;
+    return applier->acc_len == applier->acc_needed;
+}
+
+static esp_err_t _write_target(patch_applier *applier, const uint8_t *buf, size_t size)
+{
+    ESP_RETURN_ON_FALSE(applier->target_len + size <= applier->header.target_size, ESP_ERR_INVALID_ARG, TAG,
+                        "The patch overflows the target size");
+    ESP_RETURN_ON_ERROR(applier->write_target(applier->ctx, buf, size), TAG, "Failed to write the target");
+    mbedtls_sha256_update(&applier->target_sha, buf, size);
+    applier->target_len += size;
+    return ESP_OK;
+}
+
+static esp_err_t _process_header(patch_applier *applier)
+{
+    memcpy(&applier->header, applier->acc, sizeof(patch_header_t));
+    ESP_RETURN_ON_FALSE(applier->header.magic == k_patch_magic, ESP_ERR_INVALID_ARG, TAG, "Invalid patch magic");
+    ESP_RETURN_ON_FALSE(applier->header.version == k_patch_version, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Unsupported patch version %" PRIu32, applier->header.version);
+    ESP_LOGI(TAG, "Applying a patch from a base of %" PRIu32 " bytes to a target of %" PRIu32 " bytes",
+             applier->header.base_size, applier->header.target_size);
+    applier->base_offset = 0;
+    applier->state = k_state_check_base;
+    return ESP_OK;
+}
+
+static esp_err_t _check_base(patch_applier *applier, size_t &budget)
+{
+    uint8_t buf[chunk_size];
+    size_t len = std::min({chunk_size, budget, static_cast<size_t>(applier->header.base_size - applier->base_offset)});
+    if (len > 0) {
+        ESP_RETURN_ON_ERROR(applier->read_base(applier->ctx, applier->base_offset, buf, len), TAG,
+                            "Failed to read the base");
+        mbedtls_sha256_update(&applier->base_sha, buf, len);
+        applier->base_offset += len;
+        budget -= len;
+    }
+    if (applier->base_offset == applier->header.base_size) {
+        uint8_t digest[k_patch_digest_len];
+        mbedtls_sha256_finish(&applier->base_sha, digest);
+        ESP_RETURN_ON_FALSE(memcmp(digest, applier->header.base_digest, k_patch_digest_len) == 0,
+                            ESP_ERR_INVALID_VERSION, TAG, "The running firmware is not the base of the patch");
+        applier->state = k_state_op;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t _process_args(patch_applier *applier)
+{
+    if (applier->op == k_op_insert) {
+        applier->remaining = _read_le32(applier->acc);
+        applier->state = k_state_insert;
+    } else {
+        applier->base_offset = _read_le32(applier->acc);
+        applier->remaining = _read_le32(applier->acc + 4);
+        ESP_RETURN_ON_FALSE(applier->base_offset <= applier->header.base_size &&
+                                applier->remaining <= applier->header.base_size - applier->base_offset,
+                            ESP_ERR_INVALID_ARG, TAG, "The patch reads out of the base");
+        applier->state = applier->op == k_op_copy ? k_state_copy : k_state_add;
+    }
+    if (applier->remaining == 0) {
+        applier->state = k_state_op;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t _process_copy(patch_applier *applier, size_t &budget)
+{
+    uint8_t buf[chunk_size];
+    size_t len = std::min({chunk_size, budget, static_cast<size_t>(applier->remaining)});
+    ESP_RETURN_ON_ERROR(applier->read_base(applier->ctx, applier->base_offset, buf, len), TAG,
+                        "Failed to read the base");
+    ESP_RETURN_ON_ERROR(_write_target(applier, buf, len), TAG, "Failed to apply a copy record");
+    applier->base_offset += len;
+    applier->remaining -= len;
+    budget -= len;
+    return ESP_OK;
+}
+
+static esp_err_t _process_add(patch_applier *applier, const uint8_t *&data, size_t &size, size_t &budget)
+{
+    uint8_t buf[chunk_size];
+    size_t len = std::min({size, chunk_size, budget, static_cast<size_t>(applier->remaining)});
+    ESP_RETURN_ON_ERROR(applier->read_base(applier->ctx, applier->base_offset, buf, len), TAG,
+                        "Failed to read the base");
+    for (size_t i = 0; i < len; ++i) {
+        buf[i] += data[i];
+    }
+    ESP_RETURN_ON_ERROR(_write_target(applier, buf, len), TAG, "Failed to apply an add record");
+    applier->base_offset += len;
+    applier->remaining -= len;
+    data += len;
+    size -= len;
+    budget -= len;
+    return ESP_OK;
+}
+
+static esp_err_t _process_insert(patch_applier *applier, const uint8_t *&data, size_t &size, size_t &budget)
+{
+    size_t len = std::min({size, budget, static_cast<size_t>(applier->remaining)});
+    ESP_RETURN_ON_ERROR(_write_target(applier, data, len), TAG, "Failed to apply an insert record");
+    applier->remaining -= len;
+    data += len;
+    size -= len;
+    budget -= len;
+    return ESP_OK;
+}
+
+// The base check and the copy records make progress without patch data
+static bool _is_busy(patch_applier *applier)
+{
+    return applier->state == k_state_check_base || applier->state == k_state_copy;
+}
+
+esp_err_t patch_applier_create(read_base_cb_t read_base, write_target_cb_t write_target, void *ctx,
+                               patch_applier_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(read_base && write_target && handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    patch_applier *applier = (patch_applier *)esp_matter_mem_calloc(1, sizeof(patch_applier));
+    ESP_RETURN_ON_FALSE(applier, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the patch applier");
+    applier->read_base = read_base;
+    applier->write_target = write_target;
+    applier->ctx = ctx;
+    applier->state = k_state_header;
+    applier->acc_needed = sizeof(patch_header_t);
+    mbedtls_sha256_init(&applier->base_sha);
+    mbedtls_sha256_starts(&applier->base_sha, 0);
+    mbedtls_sha256_init(&applier->target_sha);
+    mbedtls_sha256_starts(&applier->target_sha, 0);
+    *handle = applier;
+    return ESP_OK;
+}
+
+esp_err_t patch_applier_feed(patch_applier_handle_t handle, const uint8_t *data, size_t size, size_t *consumed)
+{
+    ESP_RETURN_ON_FALSE(handle && (data || size == 0) && consumed, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    const uint8_t *start = data;
+    size_t budget = k_patch_step_len;
+    while (budget > 0 && (size > 0 || _is_busy(handle))) {
+        switch (handle->state) {
+        case k_state_header:
+            if (_accumulate(handle, data, size)) {
+                ESP_RETURN_ON_ERROR(_process_header(handle), TAG, "Invalid patch header");
+            }
+            break;
+        case k_state_check_base:
+            ESP_RETURN_ON_ERROR(_check_base(handle, budget), TAG, "Failed to check the base");
+            break;
+        case k_state_op:
+            handle->op = static_cast<patch_op_t>(*data);
+            data++;
+            size--;
+            if (handle->op == k_op_end) {
+                handle->state = k_state_end;
+                break;
+            }
+            ESP_RETURN_ON_FALSE(handle->op == k_op_add || handle->op == k_op_insert || handle->op == k_op_copy,
+                                ESP_ERR_INVALID_ARG, TAG, "Invalid patch opcode 0x%02x", handle->op);
+            handle->acc_len = 0;
+            handle->acc_needed = handle->op == k_op_insert ? insert_args_len : offset_args_len;
+            handle->state = k_state_args;
+            break;
+        case k_state_args:
+            if (_accumulate(handle, data, size)) {
+                ESP_RETURN_ON_ERROR(_process_args(handle), TAG, "Invalid patch record");
+            }
+            break;
+        case k_state_copy:
+            ESP_RETURN_ON_ERROR(_process_copy(handle, budget), TAG, "Failed to apply the patch");
+            break;
+        case k_state_add:
+            ESP_RETURN_ON_ERROR(_process_add(handle, data, size, budget), TAG, "Failed to apply the patch");
+            break;
+        case k_state_insert:
+            ESP_RETURN_ON_ERROR(_process_insert(handle, data, size, budget), TAG, "Failed to apply the patch");
+            break;
+        case k_state_end:
+            ESP_LOGE(TAG, "Unexpected data after the end of the patch");
+            return ESP_ERR_INVALID_ARG;
+        }
+        if ((handle->state == k_state_copy || handle->state == k_state_add || handle->state == k_state_insert) &&
+            handle->remaining == 0) {
+            handle->state = k_state_op;
+        }
+    }
+    *consumed = data - start;
+    return ESP_OK;
+}
+
+esp_err_t patch_applier_finish(patch_applier_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (_is_busy(handle)) {
+        size_t consumed;
+        ESP_RETURN_ON_ERROR(patch_applier_feed(handle, nullptr, 0, &consumed), TAG, "Failed to apply the patch");
+        if (_is_busy(handle)) {
+            return ESP_ERR_NOT_FINISHED;
+        }
+    }
+    ESP_RETURN_ON_FALSE(handle->state == k_state_end, ESP_ERR_INVALID_SIZE, TAG, "The patch is truncated");
+    ESP_RETURN_ON_FALSE(handle->target_len == handle->header.target_size, ESP_ERR_INVALID_SIZE, TAG,
+                        "The target has %" PRIu32 " bytes, expected %" PRIu32, handle->target_len,
+                        handle->header.target_size);
+    uint8_t digest[k_patch_digest_len];
+    mbedtls_sha256_finish(&handle->target_sha, digest);
+    ESP_RETURN_ON_FALSE(memcmp(digest, handle->header.target_digest, k_patch_digest_len) == 0, ESP_ERR_INVALID_CRC,
+                        TAG, "The digest of the target does not match the patch");
+    return ESP_OK;
+}
+
+void patch_applier_destroy(patch_applier_handle_t handle)
+{
+    if (!handle) {
+        return;
+    }
+    mbedtls_sha256_free(&handle->base_sha);
+    mbedtls_sha256_free(&handle->target_sha);
+    esp_matter_mem_free(handle);
+}
+
+} // namespace delta
+} // namespace ota
+} // namespace esp_matter
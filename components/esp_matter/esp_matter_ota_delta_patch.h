@@ -0,0 +1,94 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota {
+namespace delta {
+
+/* Delta OTA patches
+ *
+ * The payload of a delta OTA image is a patch from the firmware running on the OTA Requestor (the base) to the new
+ * firmware (the target). The patch is applied while it is downloaded, the target is written to the passive OTA
+ * partition and the base is read from the running partition.
+ *
+ * The patch starts with a patch_header_t, followed by records which start with a one byte opcode:
+ *   - k_op_copy: base offset (u32) and length (u32), the base bytes from the base offset are copied to the target
+ *   - k_op_add: base offset (u32) and length (u32), followed by length bytes which are added to the base bytes from
+ *     the base offset to get the target bytes
+ *   - k_op_insert: length (u32), followed by length bytes of the target
+ *   - k_op_end: end of the patch
+ * The integers are little endian. tools/delta_ota/gen_delta_patch.py generates the patches.
+ */
+
+constexpr uint32_t k_patch_magic = 0x50444D45; // "EMDP"
+constexpr uint32_t k_patch_version = 1;
+constexpr size_t k_patch_digest_len = 32;
+// Bytes of the base and of the target processed per call, so that applying a patch does not block the caller for long
+constexpr size_t k_patch_step_len = 4096;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    // Sizes and SHA-256 digests of the base and of the target
+    uint32_t base_size;
+    uint8_t base_digest[k_patch_digest_len];
+    uint32_t target_size;
+    uint8_t target_digest[k_patch_digest_len];
+} __attribute__((packed)) patch_header_t;
+
+typedef enum : uint8_t {
+    k_op_end = 0,
+    k_op_add = 1,
+    k_op_insert = 2,
+    k_op_copy = 3,
+} patch_op_t;
+
+// Read size bytes of the base from offset
+typedef esp_err_t (*read_base_cb_t)(void *ctx, uint32_t offset, uint8_t *buf, size_t size);
+// Write the next bytes of the target
+typedef esp_err_t (*write_target_cb_t)(void *ctx, const uint8_t *buf, size_t size);
+
+typedef struct patch_applier *patch_applier_handle_t;
+
+esp_err_t patch_applier_create(read_base_cb_t read_base, write_target_cb_t write_target, void *ctx,
+                               patch_applier_handle_t *handle);
+
+/* Apply the next bytes of the patch
+ *
+ * At most k_patch_step_len bytes of the base and of the target are processed per call, the call should be repeated
+ * with the bytes after the consumed ones until they are all consumed.
+ *
+ * @param[out] consumed The count of bytes of the patch which were consumed
+ * @return ESP_ERR_INVALID_VERSION if the base is not the firmware the patch was generated from, so that the full
+ *         image should be downloaded instead, ESP_ERR_INVALID_ARG if the patch is malformed.
+ */
+esp_err_t patch_applier_feed(patch_applier_handle_t handle, const uint8_t *data, size_t size, size_t *consumed);
+
+/* Check that the whole patch was applied and that the digest of the target matches the patch header
+ *
+ * @return ESP_ERR_NOT_FINISHED if the last record is still being applied, the call should be repeated.
+ */
+esp_err_t patch_applier_finish(patch_applier_handle_t handle);
+
+void patch_applier_destroy(patch_applier_handle_t handle);
+
+} // namespace delta
+} // namespace ota
+} // namespace esp_matter
@@ -0,0 +1,382 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_image_format.h>
+#include <esp_log.h>
+#include <esp_matter_ota_image_processor.h>
+#include <esp_system.h>
+
+#include <app/clusters/ota-requestor/OTARequestorInterface.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/ESP32/ESP32Utils.h>
+
+using chip::ByteSpan;
+using chip::MutableByteSpan;
+using chip::OTAImageHeader;
+using chip::OTARequestorInterface;
+using namespace chip::DeviceLayer;
+
+static const char *TAG = "esp_matter_ota";
+
+namespace esp_matter {
+namespace ota {
+
+static void _post_ota_state_change_event(OtaState newState)
+{
+    ChipDeviceEvent otaChange;
+    otaChange.Type = DeviceEventType::kOtaStateChanged;
+    otaChange.OtaStateChanged.newState = newState;
+    if (PlatformMgr().PostEvent(&otaChange) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to post the OTA state change event");
+    }
+}
+
+CHIP_ERROR EspOTAImageProcessor::PrepareDownload()
+{
+    return PlatformMgr().ScheduleWork(HandlePrepareDownload, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR EspOTAImageProcessor::Finalize()
+{
+    return PlatformMgr().ScheduleWork(HandleFinalize, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR EspOTAImageProcessor::Apply()
+{
+    return PlatformMgr().ScheduleWork(HandleApply, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR EspOTAImageProcessor::Abort()
+{
+    return PlatformMgr().ScheduleWork(HandleAbort, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR EspOTAImageProcessor::ProcessBlock(ByteSpan &block)
+{
+    CHIP_ERROR err = SetBlock(block);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Cannot set block data: %" CHIP_ERROR_FORMAT, err.Format());
+        return err;
+    }
+    return PlatformMgr().ScheduleWork(HandleProcessBlock, reinterpret_cast<intptr_t>(this));
+}
+
+bool EspOTAImageProcessor::IsFirstImageRun()
+{
+    OTARequestorInterface *requestor = chip::GetRequestorInstance();
+    if (requestor == nullptr) {
+        return false;
+    }
+    return requestor->GetCurrentUpdateState() == OTARequestorInterface::OTAUpdateStateEnum::kApplying;
+}
+
+CHIP_ERROR EspOTAImageProcessor::ConfirmCurrentImage()
+{
+    OTARequestorInterface *requestor = chip::GetRequestorInstance();
+    if (requestor == nullptr) {
+        return CHIP_ERROR_INTERNAL;
+    }
+    uint32_t currentVersion;
+    ReturnErrorOnFailure(ConfigurationMgr().GetSoftwareVersion(currentVersion));
+    if (currentVersion != requestor->GetTargetVersion()) {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void EspOTAImageProcessor::HandlePrepareDownload(intptr_t context)
+{
+    auto *imageProcessor = reinterpret_cast<EspOTAImageProcessor *>(context);
+    if (imageProcessor == nullptr || imageProcessor->mDownloader == nullptr) {
+        ESP_LOGE(TAG, "The image processor or its downloader is null");
+        return;
+    }
+    imageProcessor->mOTAUpdatePartition = esp_ota_get_next_update_partition(NULL);
+    if (imageProcessor->mOTAUpdatePartition == NULL) {
+        ESP_LOGE(TAG, "No OTA partition to update");
+        imageProcessor->mDownloader->OnPreparedForDownload(ESP32Utils::MapError(ESP_ERR_NOT_FOUND));
+        return;
+    }
+    esp_err_t err = esp_ota_begin(imageProcessor->mOTAUpdatePartition, OTA_WITH_SEQUENTIAL_WRITES,
+                                  &imageProcessor->mOTAUpdateHandle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_begin failed: %s", esp_err_to_name(err));
+        imageProcessor->mDownloader->OnPreparedForDownload(ESP32Utils::MapError(err));
+        _post_ota_state_change_event(kOtaDownloadFailed);
+        return;
+    }
+    imageProcessor->ReleaseDecoders();
+    imageProcessor->mPayloadStarted = false;
+    imageProcessor->mHeaderParser.Init();
+    imageProcessor->mParams.downloadedBytes = 0;
+    imageProcessor->mDownloader->OnPreparedForDownload(CHIP_NO_ERROR);
+    _post_ota_state_change_event(kOtaDownloadInProgress);
+}
+
+void EspOTAImageProcessor::HandleFinalize(intptr_t context)
+{
+    auto *imageProcessor = reinterpret_cast<EspOTAImageProcessor *>(context);
+    if (imageProcessor == nullptr) {
+        return;
+    }
+    if (!imageProcessor->mPayload.empty()) {
+        // The last block is still being processed in steps, the block must be kept and the end of the patch must be
+        // fed before finishing
+        PlatformMgr().ScheduleWork(HandleFinalize, context);
+        return;
+    }
+    imageProcessor->ReleaseBlock();
+    esp_err_t err = ESP_OK;
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    if (imageProcessor->mPatch) {
+        err = delta::patch_applier_finish(imageProcessor->mPatch);
+        if (err == ESP_ERR_NOT_FINISHED) {
+            // The last record of the patch is still being applied
+            PlatformMgr().ScheduleWork(HandleFinalize, context);
+            return;
+        }
+    }
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    if (imageProcessor->mDecompressor) {
+        err = compression::decompressor_finish(imageProcessor->mDecompressor);
+    }
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    imageProcessor->ReleaseDecoders();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to decode the OTA image payload: %s", esp_err_to_name(err));
+        esp_ota_abort(imageProcessor->mOTAUpdateHandle);
+        _post_ota_state_change_event(kOtaDownloadFailed);
+        return;
+    }
+    err = esp_ota_end(imageProcessor->mOTAUpdateHandle);
+    if (err != ESP_OK) {
+        if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
+            ESP_LOGE(TAG, "Image validation failed, image is corrupted");
+        } else {
+            ESP_LOGE(TAG, "esp_ota_end failed: %s", esp_err_to_name(err));
+        }
+        _post_ota_state_change_event(kOtaDownloadFailed);
+        return;
+    }
+    ESP_LOGI(TAG, "OTA image downloaded to offset 0x%" PRIx32, imageProcessor->mOTAUpdatePartition->address);
+    _post_ota_state_change_event(kOtaDownloadComplete);
+}
+
+void EspOTAImageProcessor::HandleAbort(intptr_t context)
+{
+    auto *imageProcessor = reinterpret_cast<EspOTAImageProcessor *>(context);
+    if (imageProcessor == nullptr) {
+        return;
+    }
+    if (esp_ota_abort(imageProcessor->mOTAUpdateHandle) != ESP_OK) {
+        ESP_LOGE(TAG, "OTA abort failed");
+    }
+    imageProcessor->mPayload = ByteSpan();
+    imageProcessor->ReleaseBlock();
+    imageProcessor->ReleaseDecoders();
+    _post_ota_state_change_event(kOtaDownloadAborted);
+}
+
+void EspOTAImageProcessor::HandleProcessBlock(intptr_t context)
+{
+    auto *imageProcessor = reinterpret_cast<EspOTAImageProcessor *>(context);
+    if (imageProcessor == nullptr || imageProcessor->mDownloader == nullptr) {
+        ESP_LOGE(TAG, "The image processor or its downloader is null");
+        return;
+    }
+    ByteSpan block = ByteSpan(imageProcessor->mBlock.data(), imageProcessor->mBlock.size());
+    CHIP_ERROR error = imageProcessor->ProcessHeader(block);
+    if (error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to process the OTA image header: %" CHIP_ERROR_FORMAT, error.Format());
+        imageProcessor->mDownloader->EndDownload(error);
+        _post_ota_state_change_event(kOtaDownloadFailed);
+        return;
+    }
+    if (block.empty()) {
+        imageProcessor->mDownloader->FetchNextData();
+        return;
+    }
+    imageProcessor->mPayload = block;
+    HandleProcessPayload(context);
+}
+
+void EspOTAImageProcessor::HandleProcessPayload(intptr_t context)
+{
+    auto *imageProcessor = reinterpret_cast<EspOTAImageProcessor *>(context);
+    if (imageProcessor == nullptr || imageProcessor->mDownloader == nullptr || imageProcessor->mPayload.empty()) {
+        // The download was aborted
+        return;
+    }
+    CHIP_ERROR error = imageProcessor->ProcessPayload();
+    if (error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to process the OTA image block: %" CHIP_ERROR_FORMAT, error.Format());
+        // Ending the download aborts the OTA update
+        imageProcessor->mPayload = ByteSpan();
+        imageProcessor->ReleaseDecoders();
+        imageProcessor->mDownloader->EndDownload(error);
+        _post_ota_state_change_event(kOtaDownloadFailed);
+        return;
+    }
+    if (!imageProcessor->mPayload.empty()) {
+        // Let the other events of the Matter thread run between the steps of the patch
+        PlatformMgr().ScheduleWork(HandleProcessPayload, context);
+        return;
+    }
+    imageProcessor->mDownloader->FetchNextData();
+}
+
+void EspOTAImageProcessor::HandleApply(intptr_t context)
+{
+    auto *imageProcessor = reinterpret_cast<EspOTAImageProcessor *>(context);
+    if (imageProcessor == nullptr) {
+        return;
+    }
+    _post_ota_state_change_event(kOtaApplyInProgress);
+    esp_err_t err = esp_ota_set_boot_partition(imageProcessor->mOTAUpdatePartition);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_set_boot_partition failed: %s", esp_err_to_name(err));
+        _post_ota_state_change_event(kOtaApplyFailed);
+        return;
+    }
+    ESP_LOGI(TAG, "Applying, boot partition set to offset 0x%" PRIx32, imageProcessor->mOTAUpdatePartition->address);
+    _post_ota_state_change_event(kOtaApplyComplete);
+    // HandleApply is called after the delayed action time, so it is safe to restart
+    SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(2 * 1000), HandleRestart, nullptr);
+}
+
+void EspOTAImageProcessor::HandleRestart(chip::System::Layer *systemLayer, void *appState)
+{
+    esp_restart();
+}
+
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+esp_err_t EspOTAImageProcessor::ReadBase(void *ctx, uint32_t offset, uint8_t *buf, size_t size)
+{
+    return esp_partition_read(esp_ota_get_running_partition(), offset, buf, size);
+}
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+
+esp_err_t EspOTAImageProcessor::WriteTarget(void *ctx, const uint8_t *buf, size_t size)
+{
+    auto *imageProcessor = static_cast<EspOTAImageProcessor *>(ctx);
+    return esp_ota_write(imageProcessor->mOTAUpdateHandle, buf, size);
+}
+
+CHIP_ERROR EspOTAImageProcessor::ProcessHeader(ByteSpan &block)
+{
+    if (mHeaderParser.IsInitialized()) {
+        OTAImageHeader header;
+        CHIP_ERROR error = mHeaderParser.AccumulateAndDecode(block, header);
+        // Needs more data to decode the header
+        ReturnErrorCodeIf(error == CHIP_ERROR_BUFFER_TOO_SMALL, CHIP_NO_ERROR);
+        ReturnErrorOnFailure(error);
+        mParams.totalFileBytes = header.mPayloadSize;
+        mHeaderParser.Clear();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EspOTAImageProcessor::StartPayload()
+{
+    // The kind of payload is told by its first byte: the magic byte of the ESP image header for a firmware, the first
+    // byte of the magic of a compressed payload, or anything else for a patch
+    uint8_t firstByte = mPayload.data()[0];
+    mPayloadStarted = true;
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    if (firstByte == (compression::k_compressed_magic & 0xFF)) {
+        ESP_LOGI(TAG, "The OTA image is a compressed image");
+        esp_err_t err = compression::decompressor_create(WriteTarget, this, &mDecompressor);
+        return err == ESP_OK ? CHIP_NO_ERROR : ESP32Utils::MapError(err);
+    }
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    if (firstByte != ESP_IMAGE_HEADER_MAGIC) {
+        ESP_LOGI(TAG, "The OTA image is a delta image");
+        esp_err_t err = delta::patch_applier_create(ReadBase, WriteTarget, this, &mPatch);
+        return err == ESP_OK ? CHIP_NO_ERROR : ESP32Utils::MapError(err);
+    }
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EspOTAImageProcessor::ProcessPayload()
+{
+    if (!mPayloadStarted) {
+        ReturnErrorOnFailure(StartPayload());
+    }
+    size_t consumed = mPayload.size();
+    esp_err_t err;
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    if (mPatch) {
+        err = delta::patch_applier_feed(mPatch, mPayload.data(), mPayload.size(), &consumed);
+    } else
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    if (mDecompressor) {
+        err = compression::decompressor_feed(mDecompressor, mPayload.data(), mPayload.size());
+    } else
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    {
+        err = esp_ota_write(mOTAUpdateHandle, mPayload.data(), mPayload.size());
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write the OTA image: %s", esp_err_to_name(err));
+        return ESP32Utils::MapError(err);
+    }
+    mParams.downloadedBytes += consumed;
+    mPayload = mPayload.SubSpan(consumed);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EspOTAImageProcessor::SetBlock(ByteSpan &block)
+{
+    if (!IsSpanUsable(block)) {
+        return CHIP_NO_ERROR;
+    }
+    if (mBlock.size() < block.size()) {
+        if (!mBlock.empty()) {
+            ReleaseBlock();
+        }
+        uint8_t *blockPtr = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(block.size()));
+        if (blockPtr == nullptr) {
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        mBlock = MutableByteSpan(blockPtr, block.size());
+    }
+    return CopySpanToMutableSpan(block, mBlock);
+}
+
+void EspOTAImageProcessor::ReleaseBlock()
+{
+    if (mBlock.data() != nullptr) {
+        chip::Platform::MemoryFree(mBlock.data());
+    }
+    mBlock = MutableByteSpan();
+}
+
+void EspOTAImageProcessor::ReleaseDecoders()
+{
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    delta::patch_applier_destroy(mPatch);
+    mPatch = nullptr;
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    compression::decompressor_destroy(mDecompressor);
+    mDecompressor = nullptr;
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+}
+
+} // namespace ota
+} // namespace esp_matter
@@ -0,0 +1,97 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/clusters/ota-requestor/OTADownloader.h>
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+#include <esp_matter_ota_decompressor.h>
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+#include <esp_matter_ota_delta_patch.h>
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+#include <esp_ota_ops.h>
+#include <lib/core/OTAImageHeader.h>
+#include <platform/OTAImageProcessor.h>
+#include <system/SystemLayer.h>
+
+namespace esp_matter {
+namespace ota {
+
+/** OTA image processor for the delta and the compressed OTA images
+ *
+ * The payload of a delta OTA image is a patch from the running firmware to the new firmware (see
+ * esp_matter_ota_delta_patch.h), which is applied while the image is downloaded. A block of the patch is applied in
+ * several steps of the Matter thread, and the next block is fetched once it is applied.
+ *
+ * The payload of a compressed OTA image is the compressed firmware (see esp_matter_ota_decompressor.h), which is
+ * decompressed while the image is downloaded.
+ *
+ * The images with a full firmware are written as they are, so that the OTA Provider can fall back to the full image
+ * when the patch does not apply.
+ */
+class EspOTAImageProcessor : public chip::OTAImageProcessorInterface {
+public:
+    void SetOTADownloader(chip::OTADownloader *downloader) { mDownloader = downloader; }
+
+    // OTAImageProcessorInterface Implementation
+    CHIP_ERROR PrepareDownload() override;
+    CHIP_ERROR Finalize() override;
+    CHIP_ERROR Apply() override;
+    CHIP_ERROR Abort() override;
+    CHIP_ERROR ProcessBlock(chip::ByteSpan &block) override;
+    bool IsFirstImageRun() override;
+    CHIP_ERROR ConfirmCurrentImage() override;
+
+private:
+    static void HandlePrepareDownload(intptr_t context);
+    static void HandleFinalize(intptr_t context);
+    static void HandleAbort(intptr_t context);
+    static void HandleProcessBlock(intptr_t context);
+    static void HandleProcessPayload(intptr_t context);
+    static void HandleApply(intptr_t context);
+    static void HandleRestart(chip::System::Layer *systemLayer, void *appState);
+
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    static esp_err_t ReadBase(void *ctx, uint32_t offset, uint8_t *buf, size_t size);
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    static esp_err_t WriteTarget(void *ctx, const uint8_t *buf, size_t size);
+
+    CHIP_ERROR ProcessHeader(chip::ByteSpan &block);
+    CHIP_ERROR StartPayload();
+    CHIP_ERROR ProcessPayload();
+    CHIP_ERROR SetBlock(chip::ByteSpan &block);
+    void ReleaseBlock();
+    void ReleaseDecoders();
+
+    chip::OTADownloader *mDownloader = nullptr;
+    chip::MutableByteSpan mBlock;
+    // The bytes of the block after the header which are not processed yet
+    chip::ByteSpan mPayload;
+    chip::OTAImageHeaderParser mHeaderParser;
+    const esp_partition_t *mOTAUpdatePartition = nullptr;
+    esp_ota_handle_t mOTAUpdateHandle = 0;
+    // Whether the first byte of the payload was received, the patch applier or the decompressor is created if the
+    // payload is a patch or is compressed
+    bool mPayloadStarted = false;
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+    delta::patch_applier_handle_t mPatch = nullptr;
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA
+#if CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+    compression::decompressor_handle_t mDecompressor = nullptr;
+#endif // CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA
+};
+
+} // namespace ota
+} // namespace esp_matter
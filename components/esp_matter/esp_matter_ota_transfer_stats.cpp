@@ -0,0 +1,95 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_matter_ota_transfer_stats.h>
+#include <string.h>
+
+#include <system/SystemClock.h>
+
+namespace esp_matter {
+namespace ota {
+
+static constexpr uint32_t stall_threshold_ms = CONFIG_ESP_MATTER_OTA_TRANSFER_STALL_THRESHOLD_MS;
+
+uint64_t transfer_timestamp_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+static uint32_t _clamp_ms(uint64_t ms)
+{
+    return static_cast<uint32_t>(std::min<uint64_t>(ms, UINT32_MAX));
+}
+
+void transfer_recorder_start(transfer_recorder_t *recorder, uint32_t retries)
+{
+    memset(recorder, 0, sizeof(*recorder));
+    recorder->start_ms = transfer_timestamp_ms();
+    recorder->last_block_ms = recorder->start_ms;
+    recorder->stats.retries = retries;
+    recorder->stats.active = true;
+}
+
+void transfer_recorder_add_block(transfer_recorder_t *recorder, size_t len)
+{
+    if (!recorder->stats.active) {
+        return;
+    }
+    uint64_t now_ms = transfer_timestamp_ms();
+    uint32_t interval_ms = _clamp_ms(now_ms - recorder->last_block_ms);
+    if (interval_ms > stall_threshold_ms) {
+        recorder->stats.stalls++;
+        recorder->stats.total_stall_ms = _clamp_ms(static_cast<uint64_t>(recorder->stats.total_stall_ms) + interval_ms);
+        recorder->stats.max_stall_ms = std::max(recorder->stats.max_stall_ms, interval_ms);
+    }
+    recorder->last_block_ms = now_ms;
+    recorder->stats.bytes += len;
+    recorder->stats.blocks++;
+}
+
+void transfer_recorder_add_rtt(transfer_recorder_t *recorder, uint32_t rtt_ms)
+{
+    if (!recorder->stats.active) {
+        return;
+    }
+    recorder->stats.last_rtt_ms = rtt_ms;
+    recorder->stats.max_rtt_ms = std::max(recorder->stats.max_rtt_ms, rtt_ms);
+    recorder->total_rtt_ms += rtt_ms;
+    recorder->rtt_count++;
+}
+
+void transfer_recorder_stop(transfer_recorder_t *recorder)
+{
+    if (recorder->stats.active) {
+        recorder->end_ms = transfer_timestamp_ms();
+        recorder->stats.active = false;
+    }
+}
+
+void transfer_recorder_get_stats(const transfer_recorder_t *recorder, transfer_stats_t *stats)
+{
+    *stats = recorder->stats;
+    if (!stats->active && recorder->end_ms == 0) {
+        // No transfer was recorded
+        return;
+    }
+    uint64_t end_ms = stats->active ? transfer_timestamp_ms() : recorder->end_ms;
+    stats->elapsed_ms = _clamp_ms(end_ms - recorder->start_ms);
+    stats->throughput_bps = stats->elapsed_ms ? _clamp_ms(stats->bytes * 1000 / stats->elapsed_ms) : 0;
+    stats->avg_rtt_ms = recorder->rtt_count ? _clamp_ms(recorder->total_rtt_ms / recorder->rtt_count) : 0;
+}
+
+} // namespace ota
+} // namespace esp_matter
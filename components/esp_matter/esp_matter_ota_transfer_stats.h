@@ -0,0 +1,76 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota {
+
+/* Statistics of the BDX transfers of the OTA images
+ *
+ * The OTA Requestor and the OTA Provider record the blocks of each transfer. The round-trip time of a block is, on
+ * the Requestor, the time from the BlockQuery to the Block, and on the Provider, the time from the Block to the next
+ * BlockQuery, which includes the processing of the block by the Requestor. An interval between two blocks longer than
+ * CONFIG_ESP_MATTER_OTA_TRANSFER_STALL_THRESHOLD_MS is counted as a stall.
+ */
+
+typedef struct {
+    // Bytes of the image transferred, from the start offset of the transfer
+    uint64_t bytes;
+    uint32_t blocks;
+    uint32_t elapsed_ms;
+    // Bytes per second over the elapsed time
+    uint32_t throughput_bps;
+    uint32_t last_rtt_ms;
+    uint32_t avg_rtt_ms;
+    uint32_t max_rtt_ms;
+    // Transfers of the same image which failed before this one
+    uint32_t retries;
+    uint32_t stalls;
+    uint32_t total_stall_ms;
+    uint32_t max_stall_ms;
+    // Whether the transfer is running
+    bool active;
+} transfer_stats_t;
+
+typedef struct {
+    transfer_stats_t stats;
+    uint64_t start_ms;
+    uint64_t end_ms;
+    uint64_t last_block_ms;
+    uint64_t total_rtt_ms;
+    uint32_t rtt_count;
+} transfer_recorder_t;
+
+/** Start recording a transfer, the statistics of the previous transfer are cleared */
+void transfer_recorder_start(transfer_recorder_t *recorder, uint32_t retries);
+
+/** Record a block of len bytes received or sent now */
+void transfer_recorder_add_block(transfer_recorder_t *recorder, size_t len);
+
+void transfer_recorder_add_rtt(transfer_recorder_t *recorder, uint32_t rtt_ms);
+
+/** Stop recording the transfer, the statistics are kept until the next transfer starts */
+void transfer_recorder_stop(transfer_recorder_t *recorder);
+
+void transfer_recorder_get_stats(const transfer_recorder_t *recorder, transfer_stats_t *stats);
+
+/** Monotonic timestamp of the recorded events */
+uint64_t transfer_timestamp_ms();
+
+} // namespace ota
+} // namespace esp_matter
@@ -0,0 +1,229 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Downloads an OTA image with the OTA image processor on Linux, as the BDX downloader of the OTA Requestor does:
+//
+//     ota_image_processor_test <running firmware> <OTA image> <output> <block size>
+//
+// The image is processed in blocks, the next block is sent once the processor fetches it and the processor is
+// finalized right after the last block, without waiting for it to be processed. The passive OTA partition is the
+// output file, which is written by esp_ota_end(). The results are printed as '<name> <value>' lines.
+
+#include <algorithm>
+#include <esp_image_format.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_image_processor.h>
+#include <esp_ota_ops.h>
+#include <esp_system.h>
+#include <inttypes.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace chip::DeviceLayer;
+using esp_matter::ota::EspOTAImageProcessor;
+
+namespace host_test {
+size_t mem_in_use();
+} // namespace host_test
+
+static const esp_partition_t running_partition = {0x20000, 0x100000, "ota_0"};
+static const esp_partition_t update_partition = {0x120000, 0x100000, "ota_1"};
+static std::vector<uint8_t> s_running_firmware;
+static std::vector<uint8_t> s_written;
+static const char *s_output_path = nullptr;
+static bool s_ota_begun = false;
+static std::string s_states;
+
+static bool _read_file(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t buf[4096];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+        data.insert(data.end(), buf, buf + len);
+    }
+    fclose(file);
+    return true;
+}
+
+const esp_partition_t *esp_ota_get_running_partition(void)
+{
+    return &running_partition;
+}
+
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start_from)
+{
+    return &update_partition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size)
+{
+    if (partition != &running_partition || src_offset + size > partition->size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // The rest of the partition is erased
+    memset(dst, 0xFF, size);
+    if (src_offset < s_running_firmware.size()) {
+        size_t len = std::min(size, s_running_firmware.size() - src_offset);
+        memcpy(dst, s_running_firmware.data() + src_offset, len);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle)
+{
+    s_written.clear();
+    s_ota_begun = true;
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
+{
+    if (!s_ota_begun || s_written.size() + size > update_partition.size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    s_written.insert(s_written.end(), (const uint8_t *)data, (const uint8_t *)data + size);
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_end(esp_ota_handle_t handle)
+{
+    if (!s_ota_begun) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    s_ota_begun = false;
+    // The image is validated by its ESP image header only
+    if (s_written.empty() || s_written[0] != ESP_IMAGE_HEADER_MAGIC) {
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    FILE *file = fopen(s_output_path, "wb");
+    if (!file) {
+        return ESP_FAIL;
+    }
+    fwrite(s_written.data(), 1, s_written.size(), file);
+    fclose(file);
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_abort(esp_ota_handle_t handle)
+{
+    s_ota_begun = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition)
+{
+    return ESP_OK;
+}
+
+void esp_restart(void)
+{
+    abort();
+}
+
+class TestDownloader : public chip::OTADownloader {
+public:
+    void OnPreparedForDownload(CHIP_ERROR status) override { mPrepared = status; }
+    CHIP_ERROR FetchNextData() override
+    {
+        mFetched = true;
+        return CHIP_NO_ERROR;
+    }
+    // The BDX downloader aborts the image processor when the download is ended before it completes
+    void EndDownload(CHIP_ERROR reason) override
+    {
+        mEnded = reason;
+        mProcessor->Abort();
+    }
+
+    chip::OTAImageProcessorInterface *mProcessor = nullptr;
+    CHIP_ERROR mPrepared = CHIP_ERROR_INCORRECT_STATE;
+    CHIP_ERROR mEnded = CHIP_NO_ERROR;
+    bool mFetched = false;
+};
+
+static void _on_event(const ChipDeviceEvent *event, intptr_t arg)
+{
+    if (event->Type != DeviceEventType::kOtaStateChanged) {
+        return;
+    }
+    if (!s_states.empty()) {
+        s_states += ",";
+    }
+    s_states += std::to_string(event->OtaStateChanged.newState);
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<uint8_t> image;
+    if (argc != 5 || !_read_file(argv[1], s_running_firmware) || !_read_file(argv[2], image)) {
+        fprintf(stderr, "Usage: %s <running firmware> <OTA image> <output> <block size>\n", argv[0]);
+        return 1;
+    }
+    s_output_path = argv[3];
+    size_t block_size = strtoul(argv[4], nullptr, 0);
+
+    TestDownloader downloader;
+    EspOTAImageProcessor *processor = new EspOTAImageProcessor();
+    processor->SetOTADownloader(&downloader);
+    downloader.mProcessor = processor;
+    PlatformMgr().AddEventHandler(_on_event);
+    processor->PrepareDownload();
+    host_test::run_scheduled_work();
+    printf("prepare_result 0x%" PRIx32 "\n", downloader.mPrepared.AsInteger());
+
+    size_t blocks = 0;
+    size_t max_steps = 0;
+    // The buffer of the block is reused for the next block, as the buffer of the BDX transfer
+    std::vector<uint8_t> buf(block_size);
+    for (size_t offset = 0; offset < image.size(); offset += block_size) {
+        size_t len = std::min(block_size, image.size() - offset);
+        memcpy(buf.data(), image.data() + offset, len);
+        chip::ByteSpan block(buf.data(), len);
+        downloader.mFetched = false;
+        if (processor->ProcessBlock(block) != CHIP_NO_ERROR) {
+            break;
+        }
+        blocks++;
+        memset(buf.data(), 0xA5, buf.size());
+        if (offset + len == image.size()) {
+            // The downloader finalizes the image as soon as it receives the last block
+            processor->Finalize();
+            break;
+        }
+        max_steps = std::max(max_steps, host_test::run_scheduled_work());
+        if (!downloader.mFetched) {
+            break;
+        }
+    }
+    host_test::run_scheduled_work();
+
+    printf("blocks %zu\n", blocks);
+    printf("max_steps %zu\n", max_steps);
+    printf("end_download 0x%" PRIx32 "\n", downloader.mEnded.AsInteger());
+    printf("downloaded_bytes %" PRIu64 "\n", processor->GetBytesDownloaded());
+    printf("written %zu\n", s_written.size());
+    printf("states %s\n", s_states.c_str());
+    delete processor;
+    printf("mem_in_use %zu\n", host_test::mem_in_use());
+    return 0;
+}
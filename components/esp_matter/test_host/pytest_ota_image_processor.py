@@ -0,0 +1,179 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Host test of the OTA image processor built for Linux: the delta, compressed and full OTA images are downloaded in blocks
+as the BDX downloader of the OTA Requestor sends them
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter/test_host
+"""
+
+import pathlib
+import random
+import struct
+import subprocess
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+GEN_DELTA_PATCH = host_test.REPO_DIR / 'tools' / 'delta_ota' / 'gen_delta_patch.py'
+COMPRESS_OTA_PAYLOAD = host_test.REPO_DIR / 'tools' / 'compressed_ota' / 'compress_ota_payload.py'
+
+# The values of the OtaState events of tools/host_test/chip/platform/CHIPDeviceLayer.h
+OTA_DOWNLOAD_IN_PROGRESS = 1
+OTA_DOWNLOAD_COMPLETE = 2
+OTA_DOWNLOAD_FAILED = 3
+OTA_DOWNLOAD_ABORTED = 4
+
+# The host OTA image header of tools/host_test/chip/lib/core/OTAImageHeader.h, with a few bytes of TLV after it
+HOST_HEADER_MAGIC = 0x1BEEF11E
+HEADER_TLV = bytes(range(40))
+PATCH_STEP_LEN = 4096
+OP_COPY = 3
+OP_END = 0
+
+
+@pytest.fixture(scope='module')
+def processor(tmp_path_factory):
+    output = tmp_path_factory.mktemp('ota_image_processor') / 'ota_image_processor_test'
+    esp_matter_dir = host_test.COMPONENTS_DIR / 'esp_matter'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'ota_image_processor_test.cpp',
+                            esp_matter_dir / 'esp_matter_ota_image_processor.cpp',
+                            esp_matter_dir / 'esp_matter_ota_delta_patch.cpp',
+                            esp_matter_dir / 'esp_matter_ota_decompressor.cpp'],
+                           [esp_matter_dir], chip=True,
+                           defines=['CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA=1',
+                                    'CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA=1'])
+
+
+def firmwares():
+    """A running firmware and a new firmware which ends with a long region of the running one, so that the patch ends
+    with a copy record which is applied in several steps"""
+    rng = random.Random(0x4F54)
+    base = b'\xe9' + rng.randbytes(64 * 1024 - 1)
+    target = b'\xe9' + rng.randbytes(3000) + base[10000:30000] + rng.randbytes(2000) + base[36000:56000]
+    return base, target
+
+
+def ota_image(payload):
+    header_len = 16 + len(HEADER_TLV)
+    return struct.pack('<IIQ', HOST_HEADER_MAGIC, header_len, len(payload)) + HEADER_TLV + payload
+
+
+def run_tool(tool, tmp_path, *inputs):
+    paths = []
+    for index, data in enumerate(inputs):
+        paths.append(tmp_path / f'input{index}.bin')
+        paths[-1].write_bytes(data)
+    output = tmp_path / 'tool_output.bin'
+    subprocess.run([sys.executable, str(tool)] + [str(path) for path in paths] + ['-o', str(output)], check=True)
+    return output.read_bytes()
+
+
+def download(processor, tmp_path, base, image, block_size):
+    base_path = tmp_path / 'running.bin'
+    image_path = tmp_path / 'image.ota'
+    output_path = tmp_path / 'output.bin'
+    base_path.write_bytes(base)
+    image_path.write_bytes(image)
+    output_path.unlink(missing_ok=True)
+    results = host_test.run(processor, base_path, image_path, output_path, block_size)
+    results['output'] = output_path.read_bytes() if output_path.exists() else None
+    return results
+
+
+def last_block_size(image_len, min_len):
+    """A block size of the BDX transfer with which the last block has at least min_len bytes"""
+    for block_size in range(1024, 2048):
+        if image_len % block_size >= min_len:
+            return block_size
+    raise AssertionError('No block size found')
+
+
+def test_delta_image_last_block_with_copy(processor, tmp_path):
+    base, target = firmwares()
+    patch = run_tool(GEN_DELTA_PATCH, tmp_path, base, target)
+    # The patch ends with a copy record of several steps of the patch applier, then the end record
+    copy_record = patch[-10:-1]
+    op, _, length = struct.unpack('<BII', copy_record)
+    assert op == OP_COPY and patch[-1] == OP_END
+    assert length > 3 * PATCH_STEP_LEN
+
+    image = ota_image(patch)
+    block_size = last_block_size(len(image), len(copy_record) + 1)
+    results = download(processor, tmp_path, base, image, block_size)
+    assert results['prepare_result'] == 0
+    assert results['blocks'] == (len(image) + block_size - 1) // block_size
+    # The first block checks the whole running firmware in steps
+    assert results['max_steps'] > len(base) // PATCH_STEP_LEN
+    assert results['end_download'] == 0
+    assert results['downloaded_bytes'] == len(patch)
+    assert str(results['states']) == f'{OTA_DOWNLOAD_IN_PROGRESS},{OTA_DOWNLOAD_COMPLETE}'
+    assert results['output'] == target
+    assert results['mem_in_use'] == 0
+
+
+@pytest.mark.parametrize('block_size', [64, 1024])
+def test_delta_image(processor, tmp_path, block_size):
+    base, target = firmwares()
+    patch = run_tool(GEN_DELTA_PATCH, tmp_path, base, target)
+    results = download(processor, tmp_path, base, ota_image(patch), block_size)
+    assert str(results['states']) == f'{OTA_DOWNLOAD_IN_PROGRESS},{OTA_DOWNLOAD_COMPLETE}'
+    assert results['output'] == target
+    assert results['mem_in_use'] == 0
+
+
+def test_delta_image_wrong_base(processor, tmp_path):
+    base, target = firmwares()
+    patch = run_tool(GEN_DELTA_PATCH, tmp_path, base, target)
+    other_base = bytearray(base)
+    other_base[len(base) // 2] ^= 0xFF
+    results = download(processor, tmp_path, bytes(other_base), ota_image(patch), 1024)
+    # The download is ended after the first block, the OTA Provider should send the full image instead
+    assert results['blocks'] == 1
+    assert results['end_download'] != 0
+    assert str(results['states']) == f'{OTA_DOWNLOAD_IN_PROGRESS},{OTA_DOWNLOAD_FAILED},{OTA_DOWNLOAD_ABORTED}'
+    assert results['output'] is None
+    assert results['mem_in_use'] == 0
+
+
+def test_compressed_image(processor, tmp_path):
+    base, target = firmwares()
+    payload = run_tool(COMPRESS_OTA_PAYLOAD, tmp_path, target)
+    results = download(processor, tmp_path, base, ota_image(payload), 1024)
+    assert results['downloaded_bytes'] == len(payload)
+    assert str(results['states']) == f'{OTA_DOWNLOAD_IN_PROGRESS},{OTA_DOWNLOAD_COMPLETE}'
+    assert results['output'] == target
+    assert results['mem_in_use'] == 0
+
+
+def test_full_image(processor, tmp_path):
+    base, target = firmwares()
+    results = download(processor, tmp_path, base, ota_image(target), 1000)
+    assert results['downloaded_bytes'] == len(target)
+    assert str(results['states']) == f'{OTA_DOWNLOAD_IN_PROGRESS},{OTA_DOWNLOAD_COMPLETE}'
+    assert results['output'] == target
+
+    # The payload is neither a firmware nor a compressed firmware, and is not a patch either
+    results = download(processor, tmp_path, base, ota_image(b'\xe8' + target[1:]), 1000)
+    assert results['blocks'] == 1
+    assert str(results['states']) == f'{OTA_DOWNLOAD_IN_PROGRESS},{OTA_DOWNLOAD_FAILED},{OTA_DOWNLOAD_ABORTED}'
+    assert results['output'] is None
+    assert results['mem_in_use'] == 0
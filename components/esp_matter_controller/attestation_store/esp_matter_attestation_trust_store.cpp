@@ -19,9 +19,15 @@
 #include <esp_http_client.h>
 #include <esp_log.h>
 #include <esp_matter_attestation_trust_store.h>
+#include <esp_rom_crc.h>
 #include <esp_spiffs.h>
 #include <json_parser.h>
 #include <mbedtls/base64.h>
+#include <platform/KeyValueStoreManager.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 
 const char TAG[] = "spiffs_attestation";
 
@@ -99,40 +105,226 @@ void paa_der_cert_iterator::release()
     }
 }
 
+static constexpr char k_paa_path[] = "/paa";
+static constexpr char k_paa_index_path[] = "/paa/skid.idx";
+static constexpr uint32_t k_paa_index_magic = 0x58444B53; // "SKDX"
+
+static bool is_der_file(const char *filename)
+{
+    return strncmp(get_filename_extension(filename), "der", strlen("der")) == 0;
+}
+
 esp_err_t spiffs_attestation_trust_store::init()
 {
+    if (m_is_initialized) {
+        return ESP_OK;
+    }
     esp_vfs_spiffs_conf_t conf = {
-        .base_path = "/paa", .partition_label = nullptr, .max_files = 5, .format_if_mount_failed = false};
+        .base_path = k_paa_path, .partition_label = nullptr, .max_files = 5, .format_if_mount_failed = false};
     ESP_RETURN_ON_ERROR(esp_vfs_spiffs_register(&conf), TAG, "Failed to initialize SPIFFS");
     size_t total = 0, used = 0;
     ESP_RETURN_ON_ERROR(esp_spiffs_info(conf.partition_label, &total, &used), TAG, "Failed to get SPIFFS info");
     ESP_LOGI(TAG, "Partition size: total: %d, used: %d", total, used);
     m_is_initialized = true;
+    if (load_index() != ESP_OK) {
+        ESP_LOGW(TAG, "No SKID index, the PAA lookups will scan the certificates");
+    }
+    return ESP_OK;
+}
+
+esp_err_t spiffs_attestation_trust_store::compute_signature(uint32_t &signature, size_t &count)
+{
+    DIR *dir = opendir(k_paa_path);
+    ESP_RETURN_ON_FALSE(dir, ESP_FAIL, TAG, "Failed to open the directory");
+    signature = 0;
+    count = 0;
+    dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!is_der_file(entry->d_name)) {
+            continue;
+        }
+        char filename[280] = {0};
+        snprintf(filename, sizeof(filename), "%s/%s", k_paa_path, entry->d_name);
+        struct stat st;
+        uint32_t size = stat(filename, &st) == 0 ? (uint32_t)st.st_size : 0;
+        // SPIFFS does not keep the modification time, the names and sizes of the files are used instead
+        signature = esp_rom_crc32_le(signature, (const uint8_t *)entry->d_name, strlen(entry->d_name));
+        signature = esp_rom_crc32_le(signature, (const uint8_t *)&size, sizeof(size));
+        count++;
+    }
+    closedir(dir);
     return ESP_OK;
 }
 
+esp_err_t spiffs_attestation_trust_store::load_index()
+{
+    uint32_t signature = 0;
+    size_t count = 0;
+    ESP_RETURN_ON_ERROR(compute_signature(signature, count), TAG, "Failed to compute the PAA signature");
+    FILE *file = fopen(k_paa_index_path, "rb");
+    if (file) {
+        index_header_t header;
+        bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.magic == k_paa_index_magic &&
+            header.signature == signature && header.count <= count;
+        fclose(file);
+        if (valid) {
+            m_index_count = header.count;
+            m_index_loaded = true;
+            return ESP_OK;
+        }
+        ESP_LOGI(TAG, "The PAA certificates changed, rebuilding the SKID index");
+    }
+    return build_index(signature, count);
+}
+
+static int compare_index_record_skid(const void *a, const void *b)
+{
+    return memcmp(a, b, Crypto::kSubjectKeyIdentifierLength);
+}
+
+esp_err_t spiffs_attestation_trust_store::build_index(uint32_t signature, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    index_header_t header = {.magic = k_paa_index_magic, .signature = signature, .count = 0};
+    DIR *dir = NULL;
+    FILE *file = NULL;
+    dirent *entry = NULL;
+    paa_der_cert_t *paa_cert = NULL;
+    index_record_t *records = (index_record_t *)calloc(count > 0 ? count : 1, sizeof(index_record_t));
+    ESP_RETURN_ON_FALSE(records, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the SKID index");
+    paa_cert = (paa_der_cert_t *)calloc(1, sizeof(paa_der_cert_t));
+    ESP_GOTO_ON_FALSE(paa_cert, ESP_ERR_NO_MEM, cleanup, TAG, "Failed to alloc memory for paa_cert");
+    dir = opendir(k_paa_path);
+    ESP_GOTO_ON_FALSE(dir, ESP_FAIL, cleanup, TAG, "Failed to open the directory");
+    while ((entry = readdir(dir)) != NULL && header.count < count) {
+        if (!is_der_file(entry->d_name) || strlen(entry->d_name) >= sizeof(records[0].filename)) {
+            continue;
+        }
+        char filename[280] = {0};
+        snprintf(filename, sizeof(filename), "%s/%s", k_paa_path, entry->d_name);
+        FILE *der_file = fopen(filename, "rb");
+        if (!der_file) {
+            continue;
+        }
+        paa_cert->m_len = fread(paa_cert->m_buffer, sizeof(uint8_t), kMaxDERCertLength, der_file);
+        fclose(der_file);
+        MutableByteSpan skid_span{records[header.count].skid};
+        if (Crypto::ExtractSKIDFromX509Cert(ByteSpan{paa_cert->m_buffer, paa_cert->m_len}, skid_span) !=
+                CHIP_NO_ERROR ||
+            skid_span.size() != Crypto::kSubjectKeyIdentifierLength) {
+            continue;
+        }
+        strncpy(records[header.count].filename, entry->d_name, sizeof(records[0].filename) - 1);
+        header.count++;
+    }
+    qsort(records, header.count, sizeof(index_record_t), compare_index_record_skid);
+
+    file = fopen(k_paa_index_path, "wb");
+    ESP_GOTO_ON_FALSE(file, ESP_FAIL, cleanup, TAG, "Failed to create the SKID index");
+    ESP_GOTO_ON_FALSE(fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(records, sizeof(index_record_t), header.count, file) == header.count,
+                      ESP_FAIL, cleanup, TAG, "Failed to write the SKID index");
+    ESP_LOGI(TAG, "SKID index built with %" PRIu32 " PAA certificates", header.count);
+    m_index_count = header.count;
+    m_index_loaded = true;
+
+cleanup:
+    if (file) {
+        fclose(file);
+        if (ret != ESP_OK) {
+            unlink(k_paa_index_path);
+        }
+    }
+    if (dir) {
+        closedir(dir);
+    }
+    free(paa_cert);
+    free(records);
+    return ret;
+}
+
+CHIP_ERROR spiffs_attestation_trust_store::find_in_index(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const
+{
+    FILE *file = fopen(k_paa_index_path, "rb");
+    VerifyOrReturnError(file, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    index_record_t record;
+    bool found = false;
+    CHIP_ERROR err = CHIP_ERROR_CA_CERT_NOT_FOUND;
+    size_t low = 0, high = m_index_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (fseek(file, sizeof(index_header_t) + mid * sizeof(index_record_t), SEEK_SET) != 0 ||
+            fread(&record, sizeof(record), 1, file) != 1) {
+            err = CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+            break;
+        }
+        int cmp = memcmp(skid.data(), record.skid, sizeof(record.skid));
+        if (cmp == 0) {
+            found = true;
+            break;
+        }
+        if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    fclose(file);
+    VerifyOrReturnError(found, err);
+
+    record.filename[sizeof(record.filename) - 1] = 0;
+    char filename[280] = {0};
+    snprintf(filename, sizeof(filename), "%s/%s", k_paa_path, record.filename);
+    file = fopen(filename, "rb");
+    VerifyOrReturnError(file, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    size_t len = fread(outPaaDerBuffer.data(), sizeof(uint8_t), outPaaDerBuffer.size(), file);
+    fclose(file);
+
+    // Check the certificate in case the file was replaced after the index was built
+    uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
+    MutableByteSpan skid_span{skid_buf};
+    VerifyOrReturnError(Crypto::ExtractSKIDFromX509Cert(ByteSpan{outPaaDerBuffer.data(), len}, skid_span) ==
+                                CHIP_NO_ERROR &&
+                            skid.data_equal(skid_span),
+                        CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    outPaaDerBuffer.reduce_size(len);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR spiffs_attestation_trust_store::find_by_scan(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const
+{
+    paa_der_cert_iterator iter(k_paa_path);
+    paa_der_cert_t paa_cert;
+    while (iter.next(paa_cert)) {
+        if (paa_cert.m_len == 0) {
+            continue;
+        }
+        uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
+        MutableByteSpan skid_span{skid_buf};
+        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, skid_span)) {
+            continue;
+        }
+
+        if (skid.data_equal(skid_span)) {
+            return CopySpanToMutableSpan(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, outPaaDerBuffer);
+        }
+    }
+    return CHIP_ERROR_CA_CERT_NOT_FOUND;
+}
+
 CHIP_ERROR spiffs_attestation_trust_store::GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                                               MutableByteSpan &outPaaDerBuffer) const
 {
     if (m_is_initialized) {
-        paa_der_cert_iterator iter("/paa");
-        paa_der_cert_t paa_cert;
-        while (iter.next(paa_cert)) {
-            if (paa_cert.m_len == 0) {
-                continue;
-            }
-            uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
-            MutableByteSpan skid_span{skid_buf};
-            if (CHIP_NO_ERROR !=
-                Crypto::ExtractSKIDFromX509Cert(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, skid_span)) {
-                continue;
-            }
-
-            if (skid.data_equal(skid_span)) {
-                return CopySpanToMutableSpan(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, outPaaDerBuffer);
+        if (m_index_loaded && skid.size() == Crypto::kSubjectKeyIdentifierLength) {
+            // The index covers all the certificates, only an inconsistent index requires a scan
+            CHIP_ERROR err = find_in_index(skid, outPaaDerBuffer);
+            if (err == CHIP_NO_ERROR || err == CHIP_ERROR_CA_CERT_NOT_FOUND) {
+                return err;
             }
+            ESP_LOGW(TAG, "Inconsistent SKID index, scanning the certificates");
         }
-        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+        return find_by_scan(skid, outPaaDerBuffer);
     }
     return CHIP_ERROR_INCORRECT_STATE;
 }
@@ -195,12 +387,214 @@ static esp_err_t convert_pem_to_der(const char *pem, uint8_t *der_buf, size_t *d
     return ESP_OK;
 }
 
+static bool is_valid_paa_cert(const ByteSpan &skid, const ByteSpan &paa_der)
+{
+    uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
+    MutableByteSpan skid_span{skid_buf};
+    if (Crypto::VerifyAttestationCertificateFormat(paa_der, Crypto::AttestationCertType::kPAA) != CHIP_NO_ERROR ||
+        Crypto::ExtractSKIDFromX509Cert(paa_der, skid_span) != CHIP_NO_ERROR) {
+        return false;
+    }
+    return skid.data_equal(skid_span);
+}
+
+#if CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE > 0
+using DeviceLayer::PersistedStorage::KeyValueStoreMgr;
+
+static constexpr char k_paa_cache_index_key[] = "dcl-paa-idx";
+// The system time is considered as not set before 2021-01-01
+static constexpr time_t k_min_valid_time = 1609459200;
+static constexpr uint32_t k_paa_cache_ttl_s = CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_TTL_DAYS * 24 * 3600;
+
+static void get_paa_cache_record_key(size_t slot, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "dcl-paa-%02x", (unsigned)slot);
+}
+
+static uint32_t get_current_time()
+{
+    time_t now = time(nullptr);
+    return now >= k_min_valid_time ? (uint32_t)now : 0;
+}
+
+CHIP_ERROR dcl_paa_cache::load_index()
+{
+    if (m_index_loaded) {
+        return CHIP_NO_ERROR;
+    }
+    size_t read_size = 0;
+    CHIP_ERROR err = KeyValueStoreMgr().Get(k_paa_cache_index_key, m_entries, sizeof(m_entries), &read_size);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) {
+        memset(m_entries, 0, sizeof(m_entries));
+    } else if (err != CHIP_NO_ERROR || read_size != sizeof(m_entries)) {
+        // The cache size was changed or the index is corrupted, drop the cached certificates
+        ESP_LOGW(TAG, "Invalid PAA cache index, clearing the cache");
+        memset(m_entries, 0, sizeof(m_entries));
+        for (size_t i = 0; i < CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE; ++i) {
+            char key[16];
+            get_paa_cache_record_key(i, key, sizeof(key));
+            KeyValueStoreMgr().Delete(key);
+        }
+        KeyValueStoreMgr().Delete(k_paa_cache_index_key);
+    }
+    m_lru_clock = 0;
+    for (const index_entry_t &entry : m_entries) {
+        if (entry.last_used > m_lru_clock) {
+            m_lru_clock = entry.last_used;
+        }
+    }
+    m_index_loaded = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR dcl_paa_cache::save_index()
+{
+    return KeyValueStoreMgr().Put(k_paa_cache_index_key, m_entries, sizeof(m_entries));
+}
+
+int dcl_paa_cache::find_entry(dcl_net_type_t net_type, const ByteSpan &skid)
+{
+    for (size_t i = 0; i < CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE; ++i) {
+        if (m_entries[i].last_used != 0 && m_entries[i].net_type == net_type &&
+            skid.data_equal(ByteSpan(m_entries[i].skid))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int dcl_paa_cache::alloc_entry()
+{
+    int lru_slot = 0;
+    for (size_t i = 0; i < CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE; ++i) {
+        if (m_entries[i].last_used == 0) {
+            return i;
+        }
+        if (m_entries[i].last_used < m_entries[lru_slot].last_used) {
+            lru_slot = i;
+        }
+    }
+    m_evictions++;
+    return lru_slot;
+}
+
+void dcl_paa_cache::delete_entry(size_t slot)
+{
+    char key[16];
+    get_paa_cache_record_key(slot, key, sizeof(key));
+    KeyValueStoreMgr().Delete(key);
+    memset(&m_entries[slot], 0, sizeof(m_entries[slot]));
+    save_index();
+}
+
+bool dcl_paa_cache::is_expired(const index_entry_t &entry)
+{
+    uint32_t now = get_current_time();
+    if (now == 0) {
+        // The age cannot be checked without the system time
+        return false;
+    }
+    // An entry fetched before the system time was set is refreshed once the time is known
+    return entry.fetched_at == 0 || now < entry.fetched_at || now - entry.fetched_at > k_paa_cache_ttl_s;
+}
+
+CHIP_ERROR dcl_paa_cache::lookup(dcl_net_type_t net_type, const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer)
+{
+    ReturnErrorOnFailure(load_index());
+    int slot = find_entry(net_type, skid);
+    if (slot < 0) {
+        m_misses++;
+        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    }
+    if (is_expired(m_entries[slot])) {
+        ESP_LOGI(TAG, "Cached PAA certificate expired");
+        delete_entry(slot);
+        m_misses++;
+        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    }
+    char key[16];
+    get_paa_cache_record_key(slot, key, sizeof(key));
+    size_t read_size = 0;
+    CHIP_ERROR err = KeyValueStoreMgr().Get(key, outPaaDerBuffer.data(), outPaaDerBuffer.size(), &read_size);
+    if (err != CHIP_NO_ERROR || !is_valid_paa_cert(skid, ByteSpan(outPaaDerBuffer.data(), read_size))) {
+        ESP_LOGW(TAG, "Invalid cached PAA certificate, removing it");
+        delete_entry(slot);
+        m_misses++;
+        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    }
+    outPaaDerBuffer.reduce_size(read_size);
+    // The LRU order is only persisted with the next change of the index, to avoid a flash write per lookup
+    m_entries[slot].last_used = ++m_lru_clock;
+    m_hits++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR dcl_paa_cache::store(dcl_net_type_t net_type, const ByteSpan &skid, const ByteSpan &paaDer)
+{
+    VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(load_index());
+    int slot = find_entry(net_type, skid);
+    if (slot < 0) {
+        slot = alloc_entry();
+    }
+    char key[16];
+    get_paa_cache_record_key(slot, key, sizeof(key));
+    CHIP_ERROR err = KeyValueStoreMgr().Put(key, paaDer.data(), paaDer.size());
+    if (err != CHIP_NO_ERROR) {
+        delete_entry(slot);
+        return err;
+    }
+    index_entry_t &entry = m_entries[slot];
+    memcpy(entry.skid, skid.data(), skid.size());
+    entry.net_type = net_type;
+    entry.fetched_at = get_current_time();
+    entry.last_used = ++m_lru_clock;
+    return save_index();
+}
+
+CHIP_ERROR dcl_paa_cache::clear()
+{
+    ReturnErrorOnFailure(load_index());
+    for (size_t i = 0; i < CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE; ++i) {
+        if (m_entries[i].last_used != 0) {
+            char key[16];
+            get_paa_cache_record_key(i, key, sizeof(key));
+            KeyValueStoreMgr().Delete(key);
+        }
+    }
+    memset(m_entries, 0, sizeof(m_entries));
+    m_lru_clock = 0;
+    return save_index();
+}
+
+void dcl_paa_cache::get_stats(stats_t &stats)
+{
+    stats = {};
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    if (load_index() == CHIP_NO_ERROR) {
+        for (const index_entry_t &entry : m_entries) {
+            if (entry.last_used != 0) {
+                stats.entry_count++;
+            }
+        }
+    }
+}
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE > 0
+
 CHIP_ERROR dcl_attestation_trust_store::GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                                            MutableByteSpan &outPaaDerBuffer) const
 {
     VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(outPaaDerBuffer.size() > 0 && outPaaDerBuffer.size() <= kMaxDERCertLength,
                         CHIP_ERROR_INVALID_ARGUMENT);
+#if CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE > 0
+    if (dcl_paa_cache::get_instance().lookup(dcl_net_type, skid, outPaaDerBuffer) == CHIP_NO_ERROR) {
+        ChipLogProgress(Controller, "PAA certificate found in the DCL cache");
+        return CHIP_NO_ERROR;
+    }
+#endif
     char url[200];
     int offset = 0;
     esp_err_t ret = ESP_OK;
@@ -278,8 +672,19 @@ CHIP_ERROR dcl_attestation_trust_store::GetProductAttestationAuthorityCert(const
                         paa_pem_buffer[paa_str_len] = 0;
                         remove_backslash_n(paa_pem_buffer);
                         ret = convert_pem_to_der(paa_pem_buffer, outPaaDerBuffer.data(), &paa_der_len);
+                        if (ret == ESP_OK &&
+                            !is_valid_paa_cert(skid, ByteSpan(outPaaDerBuffer.data(), paa_der_len))) {
+                            ESP_LOGE(TAG, "The certificate from DCL is not a PAA certificate with the requested SKID");
+                            ret = ESP_FAIL;
+                        }
                         if (ret == ESP_OK) {
                             outPaaDerBuffer.reduce_size(paa_der_len);
+#if CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE > 0
+                            if (dcl_paa_cache::get_instance().store(dcl_net_type, skid, outPaaDerBuffer) !=
+                                CHIP_NO_ERROR) {
+                                ESP_LOGW(TAG, "Failed to cache the PAA certificate");
+                            }
+#endif
                         }
                     }
                     json_obj_leave_object(&jctx);
@@ -57,10 +57,36 @@ public:
     CHIP_ERROR GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                   MutableByteSpan &outPaaDerBuffer) const override;
 
+    /** Mount the PAA SPIFFS partition and load the SKID index of the PAA certificates
+     *
+     * The index maps the SKIDs to the DER files, sorted by SKID, so that a lookup is a binary search in the index
+     * instead of parsing every DER file. It is stored in the partition with a signature of the DER files (names
+     * and sizes) and rebuilt when the signature does not match the partition content. If it cannot be written, the
+     * lookups scan the DER files.
+     */
     esp_err_t init();
 
 private:
+    typedef struct __attribute__((packed)) {
+        uint32_t magic;
+        uint32_t signature;
+        uint32_t count;
+    } index_header_t;
+
+    typedef struct __attribute__((packed)) {
+        uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+        char filename[CONFIG_SPIFFS_OBJ_NAME_LEN];
+    } index_record_t;
+
+    esp_err_t compute_signature(uint32_t &signature, size_t &count);
+    esp_err_t load_index();
+    esp_err_t build_index(uint32_t signature, size_t count);
+    CHIP_ERROR find_in_index(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const;
+    CHIP_ERROR find_by_scan(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const;
+
     bool m_is_initialized = false;
+    bool m_index_loaded = false;
+    size_t m_index_count = 0;
     spiffs_attestation_trust_store() {}
 };
 
@@ -90,6 +116,73 @@ private:
     dcl_net_type_t dcl_net_type = DCL_MAIN_NET;
     dcl_attestation_trust_store() {}
 };
+
+#if CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE > 0
+/** Persistent LRU cache of the PAA certificates fetched from DCL, indexed by their SKID
+ *
+ * The certificates are stored in the Matter KVS, so they are still cached after a reboot. An entry is used only if it
+ * has been fetched from the same DCL network, it is not older than CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_TTL_DAYS
+ * (when the system time is set) and the stored certificate is a valid PAA certificate with the SKID of the entry.
+ * Otherwise the entry is removed and the certificate is fetched again.
+ */
+class dcl_paa_cache {
+public:
+    typedef dcl_attestation_trust_store::dcl_net_type_t dcl_net_type_t;
+
+    typedef struct {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        size_t entry_count;
+    } stats_t;
+
+    static dcl_paa_cache &get_instance()
+    {
+        static dcl_paa_cache instance;
+        return instance;
+    }
+
+    /** Copy the cached PAA certificate with the SKID to outPaaDerBuffer
+     *
+     * @return CHIP_ERROR_CA_CERT_NOT_FOUND if there is no valid certificate with the SKID in the cache.
+     */
+    CHIP_ERROR lookup(dcl_net_type_t net_type, const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer);
+
+    /** Add a PAA certificate fetched from DCL to the cache, the least recently used one is evicted if it is full */
+    CHIP_ERROR store(dcl_net_type_t net_type, const ByteSpan &skid, const ByteSpan &paaDer);
+
+    CHIP_ERROR clear();
+
+    void get_stats(stats_t &stats);
+
+private:
+    typedef struct __attribute__((packed)) {
+        uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+        uint8_t net_type;
+        // Seconds since the Unix epoch, 0 if the system time was not set when the certificate was fetched
+        uint32_t fetched_at;
+        // 0 for a free entry
+        uint32_t last_used;
+    } index_entry_t;
+
+    dcl_paa_cache() {}
+
+    CHIP_ERROR load_index();
+    CHIP_ERROR save_index();
+    int find_entry(dcl_net_type_t net_type, const ByteSpan &skid);
+    int alloc_entry();
+    void delete_entry(size_t slot);
+    bool is_expired(const index_entry_t &entry);
+
+    bool m_index_loaded = false;
+    index_entry_t m_entries[CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE] = {};
+    uint32_t m_lru_clock = 0;
+    uint32_t m_hits = 0;
+    uint32_t m_misses = 0;
+    uint32_t m_evictions = 0;
+};
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE > 0
+
 #endif // CONFIG_DCL_ATTESTATION_TRUST_STORE
 
 const AttestationTrustStore *get_attestation_trust_store();
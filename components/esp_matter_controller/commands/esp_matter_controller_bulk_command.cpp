@@ -0,0 +1,427 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_client.h>
+#include <esp_matter_controller_bulk_command.h>
+#include <esp_matter_controller_client.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+#include <esp_matter_controller_attribute_cache.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
+
+#include <app/OperationalSessionSetup.h>
+#include <app/server/Server.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+
+#include <string.h>
+
+using namespace esp_matter::client;
+using chip::app::CommandPathParams;
+using chip::app::ConcreteCommandPath;
+using chip::app::ConcreteDataAttributePath;
+using chip::app::StatusIB;
+using chip::DeviceLayer::PlatformMgr;
+using chip::TLV::TLVReader;
+
+static const char *TAG = "bulk_command";
+
+namespace esp_matter {
+namespace controller {
+
+static uint64_t now_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+bulk_command::bulk_command(bulk_command_type_t command_type, ScopedMemoryBufferWithSize<uint64_t> &&node_ids,
+                           ScopedMemoryBufferWithSize<AttributePathParams> &&attr_paths,
+                           const char *attr_val_json_str, const config_t &config,
+                           const chip::Optional<uint16_t> timed_timeout_ms)
+    : m_command_type(command_type)
+    , m_attr_paths(std::move(attr_paths))
+    , m_attr_vals(command_type == BULK_WRITE_ATTRIBUTE ? attr_val_json_str : nullptr)
+    , m_timed_timeout_ms(timed_timeout_ms)
+    , m_config(config)
+{
+    m_results.Calloc(node_ids.AllocatedSize());
+    for (size_t i = 0; m_results.Get() && i < node_ids.AllocatedSize(); ++i) {
+        m_results[i].node_id = node_ids[i];
+    }
+}
+
+bulk_command::bulk_command(ScopedMemoryBufferWithSize<uint64_t> &&node_ids, uint16_t endpoint_id, uint32_t cluster_id,
+                           uint32_t command_id, const char *command_data_json_str, const config_t &config,
+                           const chip::Optional<uint16_t> timed_timeout_ms)
+    : m_command_type(BULK_INVOKE_COMMAND)
+    , m_attr_vals(nullptr)
+    , m_endpoint_id(endpoint_id)
+    , m_cluster_id(cluster_id)
+    , m_command_id(command_id)
+    , m_timed_timeout_ms(timed_timeout_ms)
+    , m_config(config)
+{
+    m_results.Calloc(node_ids.AllocatedSize());
+    for (size_t i = 0; m_results.Get() && i < node_ids.AllocatedSize(); ++i) {
+        m_results[i].node_id = node_ids[i];
+    }
+    if (command_data_json_str) {
+        size_t len = strlen(command_data_json_str);
+        if (m_command_data.Alloc(len + 1)) {
+            memcpy(m_command_data.Get(), command_data_json_str, len + 1);
+        }
+    }
+}
+
+bulk_command::~bulk_command()
+{
+    for (size_t i = 0; i < m_slot_count; ++i) {
+        chip::Platform::Delete(m_slots[i]);
+    }
+}
+
+esp_err_t bulk_command::send_command()
+{
+    esp_err_t ret = ESP_OK;
+    size_t slot_count = std::min<size_t>(m_config.max_in_flight, k_max_in_flight);
+    ESP_GOTO_ON_FALSE(m_results.Get() && m_results.AllocatedSize() > 0, ESP_ERR_INVALID_ARG, cleanup, TAG,
+                      "Invalid node list");
+    ESP_GOTO_ON_FALSE(slot_count > 0, ESP_ERR_INVALID_ARG, cleanup, TAG, "Invalid concurrency window");
+    if (m_command_type == BULK_INVOKE_COMMAND) {
+        ESP_GOTO_ON_FALSE(m_attr_paths.AllocatedSize() == 0, ESP_ERR_INVALID_ARG, cleanup, TAG,
+                          "Invoke command does not take attribute paths");
+    } else {
+        ESP_GOTO_ON_FALSE(m_attr_paths.Get() && m_attr_paths.AllocatedSize() > 0, ESP_ERR_INVALID_ARG, cleanup, TAG,
+                          "Invalid attribute paths");
+    }
+
+    slot_count = std::min(slot_count, m_results.AllocatedSize());
+    for (m_slot_count = 0; m_slot_count < slot_count; ++m_slot_count) {
+        m_slots[m_slot_count] = chip::Platform::New<slot>(this);
+        ESP_GOTO_ON_FALSE(m_slots[m_slot_count], ESP_ERR_NO_MEM, cleanup, TAG, "Failed to alloc memory for slot");
+    }
+
+    ESP_LOGI(TAG, "Start bulk command on %u nodes, %u in flight", (unsigned)m_results.AllocatedSize(),
+             (unsigned)m_slot_count);
+    m_start_ms = now_ms();
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    m_batch_tag = batch_runner::get_instance().begin_interaction();
+#endif
+    pump();
+    return ESP_OK;
+
+cleanup:
+    chip::Platform::Delete(this);
+    return ret;
+}
+
+void bulk_command::pump_work(intptr_t context)
+{
+    bulk_command *cmd = reinterpret_cast<bulk_command *>(context);
+    cmd->m_pump_scheduled = false;
+    if (cmd->m_done_count == cmd->m_results.AllocatedSize()) {
+        cmd->finish();
+        return;
+    }
+    cmd->pump();
+}
+
+void bulk_command::pump()
+{
+    for (size_t i = 0; i < m_slot_count && m_next_node < m_results.AllocatedSize(); ++i) {
+        if (!m_slots[i]->is_busy()) {
+            m_slots[i]->start(m_next_node++);
+        }
+    }
+}
+
+void bulk_command::on_slot_done()
+{
+    m_done_count++;
+    // The slot is still in the callback of its interaction, so the next node is started, or the command is
+    // deleted, from a new work item
+    if (!m_pump_scheduled) {
+        m_pump_scheduled = true;
+        PlatformMgr().ScheduleWork(pump_work, reinterpret_cast<intptr_t>(this));
+    }
+}
+
+void bulk_command::finish()
+{
+    report_t report = {};
+    CHIP_ERROR first_error = CHIP_NO_ERROR;
+    uint64_t connect_ms_sum = 0;
+    uint64_t total_ms_sum = 0;
+    report.total = m_results.AllocatedSize();
+    report.elapsed_ms = now_ms() - m_start_ms;
+    for (size_t i = 0; i < m_results.AllocatedSize(); ++i) {
+        const node_result_t &result = m_results[i];
+        if (result.error == CHIP_NO_ERROR && result.failure_count == 0) {
+            report.succeeded++;
+        } else {
+            report.failed++;
+            if (first_error == CHIP_NO_ERROR) {
+                first_error = result.error != CHIP_NO_ERROR ? result.error : CHIP_ERROR_INTERNAL;
+            }
+        }
+        connect_ms_sum += result.connect_ms;
+        total_ms_sum += result.total_ms;
+        report.max_total_ms = std::max(report.max_total_ms, result.total_ms);
+    }
+    report.avg_connect_ms = connect_ms_sum / report.total;
+    report.avg_total_ms = total_ms_sum / report.total;
+
+    ESP_LOGI(TAG,
+             "Bulk command done: %u/%u nodes succeeded in %" PRIu32 " ms, avg connect %" PRIu32 " ms, avg %" PRIu32
+             " ms, max %" PRIu32 " ms",
+             report.succeeded, report.total, report.elapsed_ms, report.avg_connect_ms, report.avg_total_ms,
+             report.max_total_ms);
+    if (m_config.bulk_done_cb) {
+        m_config.bulk_done_cb(m_results.Get(), m_results.AllocatedSize(), &report, m_config.ctx);
+    }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(m_batch_tag, first_error);
+#endif
+    chip::Platform::Delete(this);
+}
+
+void bulk_command::slot::start(size_t node_index)
+{
+    node_result_t &result = m_owner->m_results[node_index];
+    m_node_index = node_index;
+    m_busy = true;
+    m_start_ms = now_ms();
+    result.wait_ms = m_start_ms - m_owner->m_start_ms;
+
+#ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+    chip::Server &server = chip::Server::GetInstance();
+    server.GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(result.node_id, get_fabric_index()),
+                                                           &on_device_connected_cb, &on_device_connection_failure_cb);
+#else
+    auto &controller_instance = esp_matter::controller::matter_controller_client::get_instance();
+#ifdef CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    CHIP_ERROR err = controller_instance.get_commissioner()->GetConnectedDevice(
+        result.node_id, &on_device_connected_cb, &on_device_connection_failure_cb);
+#else
+    CHIP_ERROR err = controller_instance.get_controller()->GetConnectedDevice(result.node_id, &on_device_connected_cb,
+                                                                              &on_device_connection_failure_cb);
+#endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    if (err != CHIP_NO_ERROR) {
+        complete(err);
+    }
+#endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+}
+
+void bulk_command::slot::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
+                                                 const SessionHandle &sessionHandle)
+{
+    slot *s = reinterpret_cast<slot *>(context);
+    bulk_command *cmd = s->m_owner;
+    cmd->m_results[s->m_node_index].connect_ms = now_ms() - s->m_start_ms;
+    chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
+    esp_err_t err = ESP_OK;
+    if (cmd->m_command_type == BULK_READ_ATTRIBUTE) {
+        err = interaction::read::send_request(&device_proxy, cmd->m_attr_paths.Get(), cmd->m_attr_paths.AllocatedSize(),
+                                              nullptr, 0, s->m_buffered_read_cb);
+    } else if (cmd->m_command_type == BULK_WRITE_ATTRIBUTE) {
+        err = interaction::write::send_request(&device_proxy, cmd->m_attr_paths, cmd->m_attr_vals,
+                                               s->m_chunked_write_cb, cmd->m_timed_timeout_ms);
+    } else {
+        CommandPathParams command_path = {cmd->m_endpoint_id, 0, cmd->m_cluster_id, cmd->m_command_id,
+                                          chip::app::CommandPathFlags::kEndpointIdValid};
+        err = interaction::invoke::send_request(s, &device_proxy, command_path, cmd->m_command_data.Get(),
+                                                on_invoke_success, on_invoke_error, cmd->m_timed_timeout_ms);
+    }
+    if (err != ESP_OK) {
+        s->complete(CHIP_ERROR_INTERNAL);
+    }
+}
+
+void bulk_command::slot::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId,
+                                                          CHIP_ERROR error)
+{
+    slot *s = reinterpret_cast<slot *>(context);
+    s->m_owner->m_results[s->m_node_index].connect_ms = now_ms() - s->m_start_ms;
+    s->complete(error);
+}
+
+void bulk_command::slot::on_invoke_success(void *ctx, const ConcreteCommandPath &command_path,
+                                           const StatusIB &status, TLVReader *response_data)
+{
+    slot *s = reinterpret_cast<slot *>(ctx);
+    s->record_status(status.ToChipError());
+    s->complete(CHIP_NO_ERROR);
+}
+
+void bulk_command::slot::on_invoke_error(void *ctx, CHIP_ERROR error)
+{
+    slot *s = reinterpret_cast<slot *>(ctx);
+    s->complete(error);
+}
+
+void bulk_command::slot::record_status(CHIP_ERROR error)
+{
+    node_result_t &result = m_owner->m_results[m_node_index];
+    if (error == CHIP_NO_ERROR) {
+        result.success_count++;
+        return;
+    }
+    result.failure_count++;
+    if (result.error == CHIP_NO_ERROR) {
+        result.error = error;
+    }
+}
+
+void bulk_command::slot::complete(CHIP_ERROR error)
+{
+    node_result_t &result = m_owner->m_results[m_node_index];
+    if (result.error == CHIP_NO_ERROR) {
+        result.error = error;
+    }
+    result.total_ms = now_ms() - m_start_ms;
+    m_busy = false;
+    if (result.error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Node 0x%" PRIx64 " failed: %s", result.node_id, chip::ErrorStr(result.error));
+    }
+    if (m_owner->m_config.node_done_cb) {
+        m_owner->m_config.node_done_cb(&result, m_owner->m_config.ctx);
+    }
+    m_owner->on_slot_done();
+}
+
+// ReadClient Callback Interface
+void bulk_command::slot::OnAttributeData(const ConcreteDataAttributePath &path, TLVReader *data,
+                                         const StatusIB &status)
+{
+    CHIP_ERROR error = status.ToChipError();
+    if (error == CHIP_NO_ERROR && data == nullptr) {
+        error = CHIP_ERROR_INCORRECT_STATE;
+    }
+    record_status(error);
+    if (error != CHIP_NO_ERROR) {
+        return;
+    }
+    uint64_t node_id = m_owner->m_results[m_node_index].node_id;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().update_attribute(node_id, path, data);
+#endif
+    if (m_owner->m_config.attribute_cb) {
+        TLVReader data_cpy;
+        data_cpy.Init(*data);
+        m_owner->m_config.attribute_cb(node_id, path, &data_cpy);
+    }
+    output_sink *sink = get_output_sink(m_owner->m_config.output_format);
+    if (sink) {
+        sink->on_attribute(node_id, path, data);
+    }
+}
+
+void bulk_command::slot::OnError(CHIP_ERROR error)
+{
+    node_result_t &result = m_owner->m_results[m_node_index];
+    if (result.error == CHIP_NO_ERROR) {
+        result.error = error;
+    }
+}
+
+void bulk_command::slot::OnDone(ReadClient *client)
+{
+    complete(CHIP_NO_ERROR);
+}
+
+// WriteClient Callback Interface
+void bulk_command::slot::OnResponse(const WriteClient *client, const ConcreteDataAttributePath &path,
+                                    StatusIB status)
+{
+    record_status(status.ToChipError());
+}
+
+void bulk_command::slot::OnError(const WriteClient *client, CHIP_ERROR error)
+{
+    OnError(error);
+}
+
+void bulk_command::slot::OnDone(WriteClient *client)
+{
+    complete(CHIP_NO_ERROR);
+}
+
+static esp_err_t make_attr_paths(ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                 ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                 ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                 ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths)
+{
+    ESP_RETURN_ON_FALSE(endpoint_ids.AllocatedSize() == cluster_ids.AllocatedSize() &&
+                            endpoint_ids.AllocatedSize() == attribute_ids.AllocatedSize(),
+                        ESP_ERR_INVALID_ARG, TAG,
+                        "The endpoint_id array length should be the same as the cluster_ids array length"
+                        "and the attribute_ids array length");
+    attr_paths.Alloc(endpoint_ids.AllocatedSize());
+    ESP_RETURN_ON_FALSE(attr_paths.Get(), ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for attribute paths");
+    for (size_t i = 0; i < attr_paths.AllocatedSize(); ++i) {
+        attr_paths[i] = AttributePathParams(endpoint_ids[i], cluster_ids[i], attribute_ids[i]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t send_bulk_read_attr_command(ScopedMemoryBufferWithSize<uint64_t> &node_ids,
+                                      ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                      ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                      ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                      const bulk_command::config_t &config)
+{
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ESP_RETURN_ON_ERROR(make_attr_paths(endpoint_ids, cluster_ids, attribute_ids, attr_paths), TAG,
+                        "Failed to make attribute paths");
+    bulk_command *cmd = chip::Platform::New<bulk_command>(BULK_READ_ATTRIBUTE, std::move(node_ids),
+                                                          std::move(attr_paths), nullptr, config);
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for bulk_command");
+    return cmd->send_command();
+}
+
+esp_err_t send_bulk_write_attr_command(ScopedMemoryBufferWithSize<uint64_t> &node_ids,
+                                       ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                       ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                       ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                       const char *attr_val_json_str, const bulk_command::config_t &config,
+                                       chip::Optional<uint16_t> timed_write_timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(attr_val_json_str, ESP_ERR_INVALID_ARG, TAG, "attribute value json string cannot be NULL");
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ESP_RETURN_ON_ERROR(make_attr_paths(endpoint_ids, cluster_ids, attribute_ids, attr_paths), TAG,
+                        "Failed to make attribute paths");
+    bulk_command *cmd =
+        chip::Platform::New<bulk_command>(BULK_WRITE_ATTRIBUTE, std::move(node_ids), std::move(attr_paths),
+                                          attr_val_json_str, config, timed_write_timeout_ms);
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for bulk_command");
+    return cmd->send_command();
+}
+
+esp_err_t send_bulk_invoke_command(ScopedMemoryBufferWithSize<uint64_t> &node_ids, uint16_t endpoint_id,
+                                   uint32_t cluster_id, uint32_t command_id, const char *command_data_json_str,
+                                   const bulk_command::config_t &config,
+                                   chip::Optional<uint16_t> timed_invoke_timeout_ms)
+{
+    bulk_command *cmd = chip::Platform::New<bulk_command>(std::move(node_ids), endpoint_id, cluster_id, command_id,
+                                                          command_data_json_str, config, timed_invoke_timeout_ms);
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for bulk_command");
+    return cmd->send_command();
+}
+
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,253 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/BufferedReadCallback.h>
+#include <app/ChunkedWriteCallback.h>
+#include <esp_matter.h>
+#include <esp_matter_client.h>
+#include <esp_matter_controller_output_sink.h>
+#include <esp_matter_controller_utils.h>
+#include <esp_matter_mem.h>
+
+namespace esp_matter {
+namespace controller {
+
+using chip::ScopedNodeId;
+using chip::SessionHandle;
+using chip::app::AttributePathParams;
+using chip::app::BufferedReadCallback;
+using chip::app::ChunkedWriteCallback;
+using chip::app::ReadClient;
+using chip::app::WriteClient;
+using chip::Messaging::ExchangeManager;
+using chip::Platform::ScopedMemoryBufferWithSize;
+using esp_matter::client::interaction::multiple_write_encodable_type;
+
+typedef enum {
+    BULK_READ_ATTRIBUTE = 0,
+    BULK_WRITE_ATTRIBUTE,
+    BULK_INVOKE_COMMAND,
+} bulk_command_type_t;
+
+/** Bulk command class to send the same read, write or invoke interaction to a list of nodes
+ *
+ * At most max_in_flight nodes are processed at the same time, the next node is started as soon as one of them
+ * completes. All the paths of a node are sent in one interaction over the CASE session of the node, an existing
+ * session is reused and only the nodes without one establish a new session.
+ *
+ * The command deletes itself after the bulk_done_cb is called.
+ **/
+class bulk_command {
+public:
+    typedef struct {
+        uint64_t node_id;
+        // First error of the node: session establishment, interaction or status of a path
+        CHIP_ERROR error;
+        uint16_t success_count;
+        uint16_t failure_count;
+        // Time the node waited for a free slot in the concurrency window
+        uint32_t wait_ms;
+        // Time to get a CASE session with the node
+        uint32_t connect_ms;
+        // Time from the start of the node to the end of its interaction
+        uint32_t total_ms;
+    } node_result_t;
+
+    typedef struct {
+        uint16_t total;
+        uint16_t succeeded;
+        uint16_t failed;
+        uint32_t elapsed_ms;
+        uint32_t avg_connect_ms;
+        uint32_t avg_total_ms;
+        uint32_t max_total_ms;
+    } report_t;
+
+    typedef void (*node_done_cb_t)(const node_result_t *result, void *ctx);
+    typedef void (*bulk_done_cb_t)(const node_result_t *results, size_t result_count, const report_t *report,
+                                   void *ctx);
+
+    typedef struct config {
+        // Maximum number of nodes processed at the same time
+        uint8_t max_in_flight;
+        output_format_t output_format;
+        attribute_report_cb_t attribute_cb;
+        node_done_cb_t node_done_cb;
+        bulk_done_cb_t bulk_done_cb;
+        void *ctx;
+
+        config()
+            : max_in_flight(CONFIG_ESP_MATTER_CONTROLLER_BULK_MAX_IN_FLIGHT)
+            , output_format(OUTPUT_FORMAT_DEFAULT)
+            , attribute_cb(nullptr)
+            , node_done_cb(nullptr)
+            , bulk_done_cb(nullptr)
+            , ctx(nullptr)
+        {
+        }
+    } config_t;
+
+    /** Constructor for bulk read and write commands, attr_val_json_str is ignored for the read commands */
+    bulk_command(bulk_command_type_t command_type, ScopedMemoryBufferWithSize<uint64_t> &&node_ids,
+                 ScopedMemoryBufferWithSize<AttributePathParams> &&attr_paths, const char *attr_val_json_str,
+                 const config_t &config, const chip::Optional<uint16_t> timed_timeout_ms = chip::NullOptional);
+
+    /** Constructor for bulk invoke commands */
+    bulk_command(ScopedMemoryBufferWithSize<uint64_t> &&node_ids, uint16_t endpoint_id, uint32_t cluster_id,
+                 uint32_t command_id, const char *command_data_json_str, const config_t &config,
+                 const chip::Optional<uint16_t> timed_timeout_ms = chip::NullOptional);
+
+    ~bulk_command();
+
+    esp_err_t send_command();
+
+private:
+    static constexpr size_t k_max_in_flight = 16;
+
+    /** One entry of the concurrency window, reused for the next node once its interaction completes */
+    class slot : public ReadClient::Callback, public WriteClient::Callback {
+    public:
+        slot(bulk_command *owner)
+            : m_owner(owner)
+            , m_buffered_read_cb(*this)
+            , m_chunked_write_cb(this)
+            , on_device_connected_cb(on_device_connected_fcn, this)
+            , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
+        {
+        }
+
+        void start(size_t node_index);
+        bool is_busy() { return m_busy; }
+
+        // ReadClient Callback Interface
+        void OnAttributeData(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
+                             const chip::app::StatusIB &status) override;
+        void OnError(CHIP_ERROR error) override;
+        void OnDone(ReadClient *client) override;
+
+        // WriteClient Callback Interface
+        void OnResponse(const WriteClient *client, const chip::app::ConcreteDataAttributePath &path,
+                        chip::app::StatusIB status) override;
+        void OnError(const WriteClient *client, CHIP_ERROR error) override;
+        void OnDone(WriteClient *client) override;
+
+    private:
+        static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
+                                            const SessionHandle &sessionHandle);
+        static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error);
+        static void on_invoke_success(void *ctx, const chip::app::ConcreteCommandPath &command_path,
+                                      const chip::app::StatusIB &status, chip::TLV::TLVReader *response_data);
+        static void on_invoke_error(void *ctx, CHIP_ERROR error);
+
+        void record_status(CHIP_ERROR error);
+        void complete(CHIP_ERROR error);
+
+        bulk_command *m_owner;
+        BufferedReadCallback m_buffered_read_cb;
+        ChunkedWriteCallback m_chunked_write_cb;
+        size_t m_node_index = 0;
+        bool m_busy = false;
+        uint64_t m_start_ms = 0;
+
+        chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
+        chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
+    };
+
+    static void pump_work(intptr_t context);
+    void pump();
+    void on_slot_done();
+    void finish();
+
+    bulk_command_type_t m_command_type;
+    ScopedMemoryBufferWithSize<node_result_t> m_results;
+    ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
+    multiple_write_encodable_type m_attr_vals;
+    chip::Platform::ScopedMemoryBuffer<char> m_command_data;
+    uint16_t m_endpoint_id = 0;
+    uint32_t m_cluster_id = 0;
+    uint32_t m_command_id = 0;
+    chip::Optional<uint16_t> m_timed_timeout_ms;
+    config_t m_config;
+
+    slot *m_slots[k_max_in_flight] = {};
+    size_t m_slot_count = 0;
+    size_t m_next_node = 0;
+    size_t m_done_count = 0;
+    bool m_pump_scheduled = false;
+    uint64_t m_start_ms = 0;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    uint32_t m_batch_tag = 0;
+#endif
+};
+
+/** Send read command with multiple attribute paths to a list of nodes
+ *
+ * @param[in] node_ids Remote NodeIds
+ * @param[in] endpoint_ids EndpointId array of the multiple attribute paths
+ * @param[in] cluster_ids ClusterId array of the multiple attribute paths
+ * @param[in] attribute_ids AttributeId array of the multiple attribute paths
+ * @param[in] config Concurrency window and callbacks of the bulk command
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t send_bulk_read_attr_command(ScopedMemoryBufferWithSize<uint64_t> &node_ids,
+                                      ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                      ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                      ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                      const bulk_command::config_t &config = bulk_command::config_t());
+
+/** Send write attribute command with multiple attribute paths to a list of nodes
+ *
+ * @param[in] node_ids Remote NodeIds
+ * @param[in] endpoint_ids EndpointIds
+ * @param[in] cluster_ids ClusterIds
+ * @param[in] attribute_ids AttributeIds
+ * @param[in] attr_val_json_str Attribute value string with JSON format, the same value is written to all the nodes
+ * @param[in] config Concurrency window and callbacks of the bulk command
+ * @param[in] timed_write_timeout_ms Timeout in millisecond for timed-write attributes
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t send_bulk_write_attr_command(ScopedMemoryBufferWithSize<uint64_t> &node_ids,
+                                       ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                       ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                       ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                       const char *attr_val_json_str,
+                                       const bulk_command::config_t &config = bulk_command::config_t(),
+                                       chip::Optional<uint16_t> timed_write_timeout_ms = chip::NullOptional);
+
+/** Send invoke command to a list of nodes
+ *
+ * @param[in] node_ids Remote NodeIds
+ * @param[in] endpoint_id EndpointId
+ * @param[in] cluster_id ClusterId
+ * @param[in] command_id CommandId
+ * @param[in] command_data_json_str Command data string with JSON format, the same data is sent to all the nodes
+ * @param[in] config Concurrency window and callbacks of the bulk command
+ * @param[in] timed_invoke_timeout_ms Timeout in millisecond for timed-invoke command
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t send_bulk_invoke_command(ScopedMemoryBufferWithSize<uint64_t> &node_ids, uint16_t endpoint_id,
+                                   uint32_t cluster_id, uint32_t command_id, const char *command_data_json_str,
+                                   const bulk_command::config_t &config = bulk_command::config_t(),
+                                   chip::Optional<uint16_t> timed_invoke_timeout_ms = chip::NullOptional);
+
+} // namespace controller
+} // namespace esp_matter
@@ -17,6 +17,12 @@
 #include <esp_check.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_cluster_command.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+#include <esp_matter_controller_node_stats.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 #include <json_parser.h>
@@ -142,6 +148,18 @@ void decode_response(const ConcreteCommandPath &command_path, TLVReader *reader)
 
 namespace controller {
 
+#if defined(CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS) || defined(CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER)
+static void on_invoke_done(uint64_t node_id, uint64_t start_ms, uint32_t batch_tag, CHIP_ERROR error)
+{
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_request(node_id, node_stats::REQUEST_INVOKE, start_ms, error);
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(batch_tag, error);
+#endif
+}
+#endif
+
 void cluster_command::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                               const SessionHandle &sessionHandle)
 {
@@ -149,8 +167,41 @@ void cluster_command::on_device_connected_fcn(void *context, ExchangeManager &ex
     chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
     chip::app::CommandPathParams command_path = {cmd->m_endpoint_id, 0, cmd->m_cluster_id, cmd->m_command_id,
                                                  chip::app::CommandPathFlags::kEndpointIdValid};
+#if defined(CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS) || defined(CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER)
+    // The command is deleted once the request is sent, so the response is observed by wrapping the callbacks
+    uint64_t node_id = cmd->m_destination_id;
+    uint64_t start_ms = 0;
+    uint32_t batch_tag = 0;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(node_id, cmd->m_start_ms, CHIP_NO_ERROR);
+    start_ms = node_stats::timestamp_ms();
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_tag = cmd->m_batch_tag;
+#endif
+    custom_command_callback::on_success_callback_t on_success =
+        [node_id, start_ms, batch_tag, cb = cmd->on_success_cb](void *ctx, const ConcreteCommandPath &path,
+                                                                const StatusIB &status, TLVReader *response_data) {
+            on_invoke_done(node_id, start_ms, batch_tag, status.ToChipError());
+            if (cb) {
+                cb(ctx, path, status, response_data);
+            }
+        };
+    custom_command_callback::on_error_callback_t on_error =
+        [node_id, start_ms, batch_tag, cb = cmd->on_error_cb](void *ctx, CHIP_ERROR error) {
+            on_invoke_done(node_id, start_ms, batch_tag, error);
+            if (cb) {
+                cb(ctx, error);
+            }
+        };
+    if (interaction::invoke::send_request(context, &device_proxy, command_path, cmd->m_command_data_field,
+                                          on_success, on_error, cmd->m_timed_invoke_timeout_ms) != ESP_OK) {
+        on_invoke_done(node_id, start_ms, batch_tag, CHIP_ERROR_INTERNAL);
+    }
+#else
     interaction::invoke::send_request(context, &device_proxy, command_path, cmd->m_command_data_field,
                                       cmd->on_success_cb, cmd->on_error_cb, cmd->m_timed_invoke_timeout_ms);
+#endif
     chip::Platform::Delete(cmd);
     return;
 }
@@ -158,6 +209,12 @@ void cluster_command::on_device_connected_fcn(void *context, ExchangeManager &ex
 void cluster_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     cluster_command *cmd = reinterpret_cast<cluster_command *>(context);
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_destination_id, cmd->m_start_ms, error);
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(cmd->m_batch_tag, error);
+#endif
     chip::Platform::Delete(cmd);
     return;
 }
@@ -220,6 +277,12 @@ esp_err_t cluster_command::send_command()
     if (is_group_command()) {
         return dispatch_group_command(reinterpret_cast<void *>(this));
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    m_start_ms = node_stats::timestamp_ms();
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    m_batch_tag = batch_runner::get_instance().begin_interaction();
+#endif
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
     chip::Server &server = chip::Server::GetInstance();
     server.GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_destination_id, get_fabric_index()),
@@ -241,6 +304,9 @@ esp_err_t cluster_command::send_command()
     }
 #endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(m_batch_tag, CHIP_ERROR_INTERNAL);
+#endif
     chip::Platform::Delete(this);
     return ESP_FAIL;
 }
@@ -67,6 +67,13 @@ private:
     uint32_t m_command_id;
     custom_encodable_type m_command_data_field;
     chip::Optional<uint16_t> m_timed_invoke_timeout_ms;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    // Start of the session lookup
+    uint64_t m_start_ms = 0;
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    uint32_t m_batch_tag = 0;
+#endif
 
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
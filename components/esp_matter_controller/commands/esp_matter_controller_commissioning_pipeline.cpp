@@ -0,0 +1,370 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_client.h>
+#include <esp_matter_controller_commissioning_pipeline.h>
+
+#include <lib/support/CHIPMem.h>
+#include <system/SystemClock.h>
+
+#include <string.h>
+
+static const char *TAG = "commissioning_pipeline";
+
+using chip::NodeId;
+using chip::Controller::CommissioningStage;
+using chip::Controller::DiscoveryType;
+
+namespace esp_matter {
+namespace controller {
+
+static uint64_t now_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+static const char *state_str(commissioning_pipeline::device_state_t state)
+{
+    switch (state) {
+    case commissioning_pipeline::k_queued:
+        return "queued";
+    case commissioning_pipeline::k_pase:
+        return "pase";
+    case commissioning_pipeline::k_pase_ready:
+        return "pase-ready";
+    case commissioning_pipeline::k_commissioning:
+        return "commissioning";
+    case commissioning_pipeline::k_succeeded:
+        return "succeeded";
+    case commissioning_pipeline::k_failed:
+        return "failed";
+    default:
+        return "unknown";
+    }
+}
+
+static chip::Controller::DeviceCommissioner *get_commissioner()
+{
+    return matter_controller_client::get_instance().get_commissioner();
+}
+
+commissioning_pipeline::device_entry *commissioning_pipeline::find_device(NodeId node_id)
+{
+    for (size_t i = 0; i < m_device_count; ++i) {
+        if (m_devices[i].status.node_id == node_id) {
+            return &m_devices[i];
+        }
+    }
+    return nullptr;
+}
+
+commissioning_pipeline::device_entry *commissioning_pipeline::find_device_in_state(device_state_t state)
+{
+    // The devices are taken in the order they were added
+    for (size_t i = 0; i < m_device_count; ++i) {
+        if (m_devices[i].status.state == state) {
+            return &m_devices[i];
+        }
+    }
+    return nullptr;
+}
+
+size_t commissioning_pipeline::count_devices_in_state(device_state_t state)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < m_device_count; ++i) {
+        count += m_devices[i].status.state == state ? 1 : 0;
+    }
+    return count;
+}
+
+esp_err_t commissioning_pipeline::add_device(NodeId node_id, const char *setup_code)
+{
+    ESP_RETURN_ON_FALSE(setup_code && strlen(setup_code) <= k_max_setup_code_len, ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid setup code");
+    ESP_RETURN_ON_FALSE(!find_device(node_id), ESP_ERR_INVALID_ARG, TAG, "Node 0x%" PRIx64 " is already in the batch",
+                        node_id);
+    ESP_RETURN_ON_FALSE(!m_stopping, ESP_ERR_INVALID_STATE, TAG, "The pipeline is stopping");
+    ESP_RETURN_ON_FALSE(m_device_count < CONFIG_ESP_MATTER_COMMISSIONING_PIPELINE_MAX_DEVICES, ESP_ERR_NO_MEM, TAG,
+                        "The batch is full");
+    if (!m_devices) {
+        m_devices = (device_entry *)chip::Platform::MemoryCalloc(CONFIG_ESP_MATTER_COMMISSIONING_PIPELINE_MAX_DEVICES,
+                                                                 sizeof(device_entry));
+        ESP_RETURN_ON_FALSE(m_devices, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the batch");
+    }
+    device_entry &device = m_devices[m_device_count++];
+    device = device_entry();
+    device.status.node_id = node_id;
+    device.status.state = k_queued;
+    device.status.stage = CommissioningStage::kSecurePairing;
+    device.status.error = CHIP_NO_ERROR;
+    strcpy(device.setup_code, setup_code);
+    if (m_running) {
+        pump();
+    }
+    return ESP_OK;
+}
+
+esp_err_t commissioning_pipeline::start(const config_t &config)
+{
+    ESP_RETURN_ON_FALSE(!m_running, ESP_ERR_INVALID_STATE, TAG, "The pipeline is already running");
+    ESP_RETURN_ON_FALSE(get_commissioner()->GetPairingDelegate() == nullptr, ESP_ERR_INVALID_STATE, TAG,
+                        "There is already a pairing process");
+    ESP_RETURN_ON_FALSE(config.max_pase_ahead > 0, ESP_ERR_INVALID_ARG, TAG, "max_pase_ahead should be positive");
+    m_config = config;
+    m_params = chip::Controller::CommissioningParameters();
+    if (config.wifi_ssid && config.wifi_password) {
+        chip::ByteSpan ssid(reinterpret_cast<const uint8_t *>(config.wifi_ssid), strlen(config.wifi_ssid));
+        chip::ByteSpan password(reinterpret_cast<const uint8_t *>(config.wifi_password),
+                                strlen(config.wifi_password));
+        m_params.SetWiFiCredentials(chip::Controller::WiFiCredentials(ssid, password));
+    }
+    if (config.thread_dataset && config.thread_dataset_len > 0) {
+        m_params.SetThreadOperationalDataset(chip::ByteSpan(config.thread_dataset, config.thread_dataset_len));
+    }
+    get_commissioner()->RegisterPairingDelegate(this);
+    m_running = true;
+    m_stopping = false;
+    m_start_ms = now_ms();
+    m_end_ms = 0;
+    ESP_LOGI(TAG, "Start commissioning %u devices, %u PASE sessions ahead", (unsigned)m_device_count,
+             config.max_pase_ahead);
+    pump();
+    return ESP_OK;
+}
+
+void commissioning_pipeline::stop()
+{
+    VerifyOrReturn(m_running && !m_stopping);
+    m_stopping = true;
+    for (size_t i = 0; i < m_device_count; ++i) {
+        device_entry *device = &m_devices[i];
+        if (device->status.state == k_pase || device->status.state == k_pase_ready) {
+            get_commissioner()->StopPairing(device->status.node_id);
+        }
+        if (device->status.state == k_queued || device->status.state == k_pase || device->status.state == k_pase_ready) {
+            complete_device(device, CHIP_ERROR_CANCELLED);
+        }
+    }
+    pump();
+}
+
+esp_err_t commissioning_pipeline::reset()
+{
+    ESP_RETURN_ON_FALSE(!m_running, ESP_ERR_INVALID_STATE, TAG, "The pipeline is running");
+    chip::Platform::MemoryFree(m_devices);
+    m_devices = nullptr;
+    m_device_count = 0;
+    m_start_ms = 0;
+    m_end_ms = 0;
+    return ESP_OK;
+}
+
+void commissioning_pipeline::pump()
+{
+    VerifyOrReturn(m_running && !m_pumping);
+    m_pumping = true;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        // The commissioner runs one commissioning at a time, start the next one as soon as it is idle.
+        device_entry *ready = find_device_in_state(k_pase_ready);
+        if (ready && count_devices_in_state(k_commissioning) == 0) {
+            start_commissioning(ready);
+            progress = true;
+        }
+        // Establish the PASE sessions of the next devices while the commissioner is busy.
+        device_entry *queued = m_stopping ? nullptr : find_device_in_state(k_queued);
+        if (queued && count_devices_in_state(k_pase) == 0 &&
+            count_devices_in_state(k_pase_ready) < m_config.max_pase_ahead) {
+            start_pase(queued);
+            progress = true;
+        }
+    }
+    m_pumping = false;
+
+    size_t pending = count_devices_in_state(k_queued) + count_devices_in_state(k_pase) +
+        count_devices_in_state(k_pase_ready) + count_devices_in_state(k_commissioning);
+    if (pending == 0) {
+        finish();
+    }
+}
+
+void commissioning_pipeline::start_pase(device_entry *device)
+{
+    device->status.state = k_pase;
+    device->stage_start_ms = now_ms();
+    ESP_LOGI(TAG, "Establishing PASE session with node 0x%" PRIx64, device->status.node_id);
+    CHIP_ERROR err = get_commissioner()->EstablishPASEConnection(device->status.node_id, device->setup_code,
+                                                                 DiscoveryType::kDiscoveryNetworkOnly);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to establish PASE session with node 0x%" PRIx64 ": %" CHIP_ERROR_FORMAT,
+                 device->status.node_id, err.Format());
+        complete_device(device, err);
+    }
+}
+
+void commissioning_pipeline::start_commissioning(device_entry *device)
+{
+    uint64_t now = now_ms();
+    device->status.wait_ms = static_cast<uint32_t>(now - device->stage_start_ms);
+    device->status.state = k_commissioning;
+    device->stage_start_ms = now;
+    ESP_LOGI(TAG, "Commissioning node 0x%" PRIx64, device->status.node_id);
+    CHIP_ERROR err = get_commissioner()->Commission(device->status.node_id, m_params);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to commission node 0x%" PRIx64 ": %" CHIP_ERROR_FORMAT, device->status.node_id,
+                 err.Format());
+        complete_device(device, err);
+    }
+}
+
+void commissioning_pipeline::complete_device(device_entry *device, CHIP_ERROR error)
+{
+    if (device->status.state == k_commissioning) {
+        device->status.commissioning_ms = static_cast<uint32_t>(now_ms() - device->stage_start_ms);
+    } else if (device->status.state == k_pase) {
+        device->status.pase_ms = static_cast<uint32_t>(now_ms() - device->stage_start_ms);
+    }
+    device->status.state = error == CHIP_NO_ERROR ? k_succeeded : k_failed;
+    device->status.error = error;
+    if (m_config.device_done_cb) {
+        m_config.device_done_cb(&device->status, m_config.ctx);
+    }
+}
+
+void commissioning_pipeline::finish()
+{
+    VerifyOrReturn(m_running);
+    m_running = false;
+    m_stopping = false;
+    m_end_ms = now_ms();
+    get_commissioner()->RegisterPairingDelegate(nullptr);
+    report_t report;
+    get_report(report);
+    ESP_LOGI(TAG, "Commissioned %u/%u devices in %" PRIu32 " ms, %.1f devices/min", report.succeeded, report.total,
+             report.elapsed_ms, report.devices_per_minute);
+    if (m_config.pipeline_done_cb) {
+        m_config.pipeline_done_cb(&report, m_config.ctx);
+    }
+}
+
+void commissioning_pipeline::OnPairingComplete(CHIP_ERROR error)
+{
+    // The commissioner establishes one PASE session at a time
+    device_entry *device = find_device_in_state(k_pase);
+    VerifyOrReturn(device);
+    if (error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "PASE session establishment with node 0x%" PRIx64 " failed: Matter-%s", device->status.node_id,
+                 chip::ErrorStr(error));
+        device->status.stage = CommissioningStage::kSecurePairing;
+        complete_device(device, error);
+    } else {
+        uint64_t now = now_ms();
+        device->status.pase_ms = static_cast<uint32_t>(now - device->stage_start_ms);
+        device->status.state = k_pase_ready;
+        device->stage_start_ms = now;
+    }
+    pump();
+}
+
+void commissioning_pipeline::OnCommissioningStatusUpdate(chip::PeerId peerId, CommissioningStage stageCompleted,
+                                                         CHIP_ERROR error)
+{
+    device_entry *device = find_device(peerId.GetNodeId());
+    if (device) {
+        device->status.stage = stageCompleted;
+    }
+}
+
+void commissioning_pipeline::OnCommissioningSuccess(chip::PeerId peerId)
+{
+    device_entry *device = find_device(peerId.GetNodeId());
+    VerifyOrReturn(device && device->status.state == k_commissioning);
+    complete_device(device, CHIP_NO_ERROR);
+    ESP_LOGI(TAG, "Node 0x%" PRIx64 " commissioned in %" PRIu32 " ms", device->status.node_id,
+             device->status.commissioning_ms);
+    pump();
+}
+
+void commissioning_pipeline::OnCommissioningFailure(
+    chip::PeerId peerId, CHIP_ERROR error, CommissioningStage stageFailed,
+    chip::Optional<chip::Credentials::AttestationVerificationResult> additionalErrorInfo)
+{
+    device_entry *device = find_device(peerId.GetNodeId());
+    VerifyOrReturn(device && device->status.state == k_commissioning);
+    device->status.stage = stageFailed;
+    complete_device(device, error == CHIP_NO_ERROR ? CHIP_ERROR_INTERNAL : error);
+    ESP_LOGE(TAG, "Node 0x%" PRIx64 " commissioning failed at stage %s: Matter-%s", device->status.node_id,
+             chip::Controller::StageToString(stageFailed), chip::ErrorStr(error));
+    pump();
+}
+
+esp_err_t commissioning_pipeline::get_device_status(NodeId node_id, device_status_t &status)
+{
+    device_entry *device = find_device(node_id);
+    ESP_RETURN_ON_FALSE(device, ESP_ERR_NOT_FOUND, TAG, "Node 0x%" PRIx64 " is not in the batch", node_id);
+    status = device->status;
+    return ESP_OK;
+}
+
+void commissioning_pipeline::get_report(report_t &report)
+{
+    memset(&report, 0, sizeof(report));
+    uint64_t pase_total = 0;
+    uint64_t commissioning_total = 0;
+    uint16_t pase_count = 0;
+    for (size_t i = 0; i < m_device_count; ++i) {
+        const device_status_t &status = m_devices[i].status;
+        report.total++;
+        if (status.pase_ms > 0) {
+            pase_total += status.pase_ms;
+            pase_count++;
+        }
+        if (status.state == k_succeeded) {
+            report.succeeded++;
+            commissioning_total += status.commissioning_ms;
+        } else if (status.state == k_failed) {
+            report.failed++;
+        }
+    }
+    if (m_start_ms != 0) {
+        report.elapsed_ms = static_cast<uint32_t>((m_end_ms != 0 ? m_end_ms : now_ms()) - m_start_ms);
+    }
+    report.avg_pase_ms = pase_count ? static_cast<uint32_t>(pase_total / pase_count) : 0;
+    report.avg_commissioning_ms = report.succeeded ? static_cast<uint32_t>(commissioning_total / report.succeeded) : 0;
+    report.devices_per_minute = report.elapsed_ms ? report.succeeded * 60000.0f / report.elapsed_ms : 0;
+}
+
+void commissioning_pipeline::dump()
+{
+    for (size_t i = 0; i < m_device_count; ++i) {
+        const device_status_t &status = m_devices[i].status;
+        ESP_LOGI(TAG, "Node 0x%" PRIx64 ": %s, pase %" PRIu32 " ms, wait %" PRIu32 " ms, commissioning %" PRIu32
+                 " ms, error %s",
+                 status.node_id, state_str(status.state), status.pase_ms, status.wait_ms, status.commissioning_ms,
+                 chip::ErrorStr(status.error));
+    }
+    report_t report;
+    get_report(report);
+    ESP_LOGI(TAG, "%s: %u/%u succeeded, %u failed, %" PRIu32 " ms, %.1f devices/min, avg pase %" PRIu32
+             " ms, avg commissioning %" PRIu32 " ms",
+             m_running ? "Running" : "Idle", report.succeeded, report.total, report.failed, report.elapsed_ms,
+             report.devices_per_minute, report.avg_pase_ms, report.avg_commissioning_ms);
+}
+
+} // namespace controller
+} // namespace esp_matter
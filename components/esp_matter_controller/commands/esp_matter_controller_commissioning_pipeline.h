@@ -0,0 +1,191 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <controller/CHIPDeviceController.h>
+#include <controller/CommissioningDelegate.h>
+#include <esp_err.h>
+#include <esp_matter.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Commissioning pipeline onboarding a batch of on-network Matter end-devices
+ *
+ * The devices are added with their setup codes and go through two stages:
+ *  - Discovery and PASE session establishment.
+ *  - Commissioning: device attestation, CSR/NOC issuance, network provisioning and CASE session establishment.
+ *
+ * The DeviceCommissioner runs one PASE session establishment and one commissioning at a time, so the pipeline
+ * overlaps the two stages: while a device is being commissioned, the next devices are discovered and their PASE
+ * sessions are established ahead, up to max_pase_ahead devices waiting for their commissioning. This removes the
+ * mDNS discovery and PASE time of all the devices but the first one from the batch duration.
+ *
+ * @note The pipeline registers itself as the pairing delegate of the commissioner while it is running, so it cannot
+ * run together with the pairing_command.
+ * @note All the APIs should be called in the Matter context.
+ */
+class commissioning_pipeline : public chip::Controller::DevicePairingDelegate {
+public:
+    typedef enum {
+        k_queued = 0,
+        k_pase,
+        k_pase_ready,
+        k_commissioning,
+        k_succeeded,
+        k_failed,
+    } device_state_t;
+
+    typedef struct {
+        chip::NodeId node_id;
+        device_state_t state;
+        // Last commissioning stage reported for the device
+        chip::Controller::CommissioningStage stage;
+        CHIP_ERROR error;
+        // Duration of the discovery and PASE session establishment
+        uint32_t pase_ms;
+        // Time the device waited for the commissioner after its PASE session was established
+        uint32_t wait_ms;
+        // Duration of the commissioning
+        uint32_t commissioning_ms;
+    } device_status_t;
+
+    typedef struct {
+        uint16_t total;
+        uint16_t succeeded;
+        uint16_t failed;
+        uint32_t elapsed_ms;
+        uint32_t avg_pase_ms;
+        uint32_t avg_commissioning_ms;
+        // Throughput of the batch, in devices per minute
+        float devices_per_minute;
+    } report_t;
+
+    typedef void (*device_done_cb_t)(const device_status_t *status, void *ctx);
+    typedef void (*pipeline_done_cb_t)(const report_t *report, void *ctx);
+
+    typedef struct config {
+        // Maximum number of devices with a PASE session established waiting for their commissioning
+        uint8_t max_pase_ahead;
+        // Optional Wi-Fi credentials and Thread dataset provisioned to the devices which need them, they should
+        // remain valid while the pipeline is running
+        const char *wifi_ssid;
+        const char *wifi_password;
+        const uint8_t *thread_dataset;
+        size_t thread_dataset_len;
+        device_done_cb_t device_done_cb;
+        pipeline_done_cb_t pipeline_done_cb;
+        void *ctx;
+
+        config()
+            : max_pase_ahead(CONFIG_ESP_MATTER_COMMISSIONING_PIPELINE_MAX_PASE_AHEAD)
+            , wifi_ssid(nullptr)
+            , wifi_password(nullptr)
+            , thread_dataset(nullptr)
+            , thread_dataset_len(0)
+            , device_done_cb(nullptr)
+            , pipeline_done_cb(nullptr)
+            , ctx(nullptr)
+        {
+        }
+    } config_t;
+
+    static commissioning_pipeline &get_instance()
+    {
+        static commissioning_pipeline s_instance;
+        return s_instance;
+    }
+
+    /** Add a device to the batch, it can be called before start() or while the pipeline is running
+     *
+     * The devices of the batch are allocated when the first one is added, and freed by reset().
+     *
+     * @param[in] node_id NodeId assigned to the device
+     * @param[in] setup_code QR code or manual pairing code of the device
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NO_MEM if the batch is full or cannot be allocated.
+     * @return ESP_ERR_INVALID_ARG if the node is already in the batch.
+     */
+    esp_err_t add_device(chip::NodeId node_id, const char *setup_code);
+
+    /** Start commissioning the devices of the batch
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_INVALID_STATE if the pipeline or another pairing process is running.
+     */
+    esp_err_t start(const config_t &config = config_t());
+
+    /** Stop the pipeline, the device being commissioned completes but the queued devices are dropped */
+    void stop();
+
+    /** Clear the devices of a completed batch and free them */
+    esp_err_t reset();
+
+    bool is_running() { return m_running; }
+
+    esp_err_t get_device_status(chip::NodeId node_id, device_status_t &status);
+
+    void get_report(report_t &report);
+
+    /** Print the state of every device and the report of the batch */
+    void dump();
+
+    /****************** DevicePairingDelegate Interface *****************/
+    void OnPairingComplete(CHIP_ERROR error) override;
+    void OnCommissioningSuccess(chip::PeerId peerId) override;
+    void OnCommissioningFailure(
+        chip::PeerId peerId, CHIP_ERROR error, chip::Controller::CommissioningStage stageFailed,
+        chip::Optional<chip::Credentials::AttestationVerificationResult> additionalErrorInfo) override;
+    void OnCommissioningStatusUpdate(chip::PeerId peerId, chip::Controller::CommissioningStage stageCompleted,
+                                     CHIP_ERROR error) override;
+
+private:
+    static constexpr size_t k_max_setup_code_len = 64;
+
+    struct device_entry {
+        device_status_t status;
+        char setup_code[k_max_setup_code_len + 1];
+        // Start of the current stage
+        uint64_t stage_start_ms;
+    };
+
+    commissioning_pipeline() {}
+
+    device_entry *find_device(chip::NodeId node_id);
+    device_entry *find_device_in_state(device_state_t state);
+    size_t count_devices_in_state(device_state_t state);
+    void pump();
+    void start_pase(device_entry *device);
+    void start_commissioning(device_entry *device);
+    void complete_device(device_entry *device, CHIP_ERROR error);
+    void finish();
+
+    // CONFIG_ESP_MATTER_COMMISSIONING_PIPELINE_MAX_DEVICES entries while there is a batch, the entries do not move
+    // so that the device pointers stay valid across the callbacks
+    device_entry *m_devices = nullptr;
+    size_t m_device_count = 0;
+    config_t m_config;
+    bool m_running = false;
+    bool m_stopping = false;
+    // Guard against the re-entrant calls of pump() from the delegate callbacks
+    bool m_pumping = false;
+    uint64_t m_start_ms = 0;
+    uint64_t m_end_ms = 0;
+    chip::Controller::CommissioningParameters m_params;
+};
+
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,557 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_client.h>
+#include <esp_matter_controller_icd_command_queue.h>
+#include <esp_matter_controller_utils.h>
+
+#include <lib/support/CHIPMem.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+
+#include <string.h>
+
+using namespace esp_matter::client;
+using chip::ScopedMemoryBufferWithSize;
+using chip::app::AttributePathParams;
+using chip::app::CommandPathParams;
+using chip::app::ConcreteCommandPath;
+using chip::app::ConcreteDataAttributePath;
+using chip::app::StatusIB;
+using chip::app::WriteClient;
+using chip::DeviceLayer::PlatformMgr;
+using chip::TLV::TLVReader;
+
+static const char *TAG = "icd_command_queue";
+
+namespace esp_matter {
+namespace controller {
+
+static uint64_t now_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+static bool is_same_write_path(const icd_command_queue::item_info_t &a, const icd_command_queue::item_info_t &b)
+{
+    return a.type == icd_command_queue::ICD_ITEM_WRITE_ATTRIBUTE &&
+        b.type == icd_command_queue::ICD_ITEM_WRITE_ATTRIBUTE && a.node_id == b.node_id &&
+        a.endpoint_id == b.endpoint_id && a.cluster_id == b.cluster_id && a.id == b.id;
+}
+
+void icd_command_queue::on_check_in(const chip::ScopedNodeId &peer_node, void *ctx)
+{
+    icd_command_queue *queue = reinterpret_cast<icd_command_queue *>(ctx);
+    if (peer_node.GetFabricIndex() != get_fabric_index() || queue->get_pending_count(peer_node.GetNodeId()) == 0) {
+        return;
+    }
+    ESP_LOGI(TAG, "ICD 0x%" PRIx64 " checked in, flushing its queued commands", peer_node.GetNodeId());
+    queue->flush(peer_node.GetNodeId());
+}
+
+bool icd_command_queue::is_registered_icd(uint64_t node_id)
+{
+    auto &icd_client_storage = matter_controller_client::get_instance().get_icd_client_storage();
+    auto iter = icd_client_storage.IterateICDClientInfo();
+    if (iter == nullptr) {
+        return false;
+    }
+    chip::app::DefaultICDClientStorage::ICDClientInfoIteratorWrapper wrapper(iter);
+    chip::app::ICDClientInfo info;
+    while (iter->Next(info)) {
+        if (info.peer_node.GetNodeId() == node_id && info.peer_node.GetFabricIndex() == get_fabric_index()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+esp_err_t icd_command_queue::queue_item(const item_info_t &info, const char *json_str, uint32_t ttl_ms,
+                                        chip::Optional<uint16_t> timed_timeout_ms)
+{
+    if (!m_check_in_registered) {
+        matter_controller_client::get_instance().get_icd_check_in_delegate().set_check_in_callback(on_check_in, this);
+        m_check_in_registered = true;
+    }
+    ESP_RETURN_ON_FALSE(is_registered_icd(info.node_id), ESP_ERR_NOT_FOUND, TAG,
+                        "Node 0x%" PRIx64 " is not a registered ICD", info.node_id);
+    drop_expired();
+
+    size_t json_len = json_str ? strlen(json_str) : 0;
+    char *json_copy = nullptr;
+    if (json_str) {
+        json_copy = static_cast<char *>(chip::Platform::MemoryAlloc(json_len + 1));
+        ESP_RETURN_ON_FALSE(json_copy, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the json string");
+        memcpy(json_copy, json_str, json_len + 1);
+    }
+    uint64_t expire_ms = now_ms() + (ttl_ms > 0 ? ttl_ms : CONFIG_ESP_MATTER_CONTROLLER_ICD_QUEUE_DEFAULT_TTL_MS);
+
+    item *tail = nullptr;
+    for (item *i = m_head; i; i = i->next) {
+        if (is_same_write_path(i->info, info)) {
+            // Only the last value written to an attribute matters, replace the queued one
+            chip::Platform::MemoryFree(i->json_str);
+            i->json_str = json_copy;
+            i->timed_timeout_ms = timed_timeout_ms.ValueOr(0);
+            i->expire_ms = expire_ms;
+            ESP_LOGI(TAG, "Coalesced the write to node 0x%" PRIx64 " 0x%" PRIx32 "/0x%" PRIx32, info.node_id,
+                     info.cluster_id, info.id);
+            return ESP_OK;
+        }
+        tail = i;
+    }
+
+    if (m_item_count >= CONFIG_ESP_MATTER_CONTROLLER_ICD_QUEUE_MAX_ITEMS) {
+        chip::Platform::MemoryFree(json_copy);
+        ESP_LOGE(TAG, "The ICD command queue is full");
+        return ESP_ERR_NO_MEM;
+    }
+    item *new_item = chip::Platform::New<item>();
+    if (!new_item) {
+        chip::Platform::MemoryFree(json_copy);
+        ESP_LOGE(TAG, "Failed to alloc memory for the queued item");
+        return ESP_ERR_NO_MEM;
+    }
+    new_item->info = info;
+    new_item->json_str = json_copy;
+    new_item->timed_timeout_ms = timed_timeout_ms.ValueOr(0);
+    new_item->expire_ms = expire_ms;
+    new_item->reported = false;
+    new_item->next = nullptr;
+    if (tail) {
+        tail->next = new_item;
+    } else {
+        m_head = new_item;
+    }
+    m_item_count++;
+    return ESP_OK;
+}
+
+esp_err_t icd_command_queue::queue_write(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id,
+                                         uint32_t attribute_id, const char *attr_val_json_str, uint32_t ttl_ms,
+                                         chip::Optional<uint16_t> timed_write_timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(attr_val_json_str, ESP_ERR_INVALID_ARG, TAG, "attribute value json string cannot be NULL");
+    item_info_t info = {node_id, ICD_ITEM_WRITE_ATTRIBUTE, endpoint_id, cluster_id, attribute_id};
+    return queue_item(info, attr_val_json_str, ttl_ms, timed_write_timeout_ms);
+}
+
+esp_err_t icd_command_queue::queue_invoke(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id,
+                                          uint32_t command_id, const char *command_data_json_str, uint32_t ttl_ms,
+                                          chip::Optional<uint16_t> timed_invoke_timeout_ms)
+{
+    item_info_t info = {node_id, ICD_ITEM_INVOKE_COMMAND, endpoint_id, cluster_id, command_id};
+    return queue_item(info, command_data_json_str, ttl_ms, timed_invoke_timeout_ms);
+}
+
+void icd_command_queue::report_item(item *i, CHIP_ERROR error)
+{
+    if (error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Queued %s to node 0x%" PRIx64 " 0x%" PRIx32 "/0x%" PRIx32 " failed: %s",
+                 i->info.type == ICD_ITEM_WRITE_ATTRIBUTE ? "write" : "invoke", i->info.node_id, i->info.cluster_id,
+                 i->info.id, chip::ErrorStr(error));
+    }
+    if (m_item_done_cb) {
+        m_item_done_cb(&i->info, error, m_item_done_ctx);
+    }
+}
+
+void icd_command_queue::free_item(item *i)
+{
+    chip::Platform::MemoryFree(i->json_str);
+    chip::Platform::Delete(i);
+}
+
+void icd_command_queue::drop_expired()
+{
+    uint64_t now = now_ms();
+    item **link = &m_head;
+    while (*link) {
+        item *i = *link;
+        if (i->expire_ms > now) {
+            link = &i->next;
+            continue;
+        }
+        *link = i->next;
+        m_item_count--;
+        report_item(i, CHIP_ERROR_TIMEOUT);
+        free_item(i);
+    }
+}
+
+icd_command_queue::flush_context *icd_command_queue::find_flush(uint64_t node_id)
+{
+    for (flush_context *f : m_flushes) {
+        if (f && f->get_node_id() == node_id) {
+            return f;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t icd_command_queue::flush(uint64_t node_id)
+{
+    drop_expired();
+    if (find_flush(node_id)) {
+        // The items queued during a flush are sent when it is done
+        return ESP_OK;
+    }
+    flush_context **free_slot = nullptr;
+    for (flush_context *&f : m_flushes) {
+        if (!f) {
+            free_slot = &f;
+            break;
+        }
+    }
+    ESP_RETURN_ON_FALSE(free_slot, ESP_ERR_NO_MEM, TAG, "Too many flushes in progress");
+
+    // Move the items of the node to the flush, keeping their order
+    item *items = nullptr;
+    item **items_tail = &items;
+    item **link = &m_head;
+    while (*link) {
+        item *i = *link;
+        if (i->info.node_id != node_id) {
+            link = &i->next;
+            continue;
+        }
+        *link = i->next;
+        m_item_count--;
+        i->next = nullptr;
+        *items_tail = i;
+        items_tail = &i->next;
+    }
+    if (!items) {
+        return ESP_OK;
+    }
+    *free_slot = chip::Platform::New<flush_context>(this, node_id, items);
+    if (!*free_slot) {
+        // Put the items back to the queue
+        *link = items;
+        for (item *i = items; i; i = i->next) {
+            m_item_count++;
+        }
+        ESP_LOGE(TAG, "Failed to alloc memory for flush_context");
+        return ESP_ERR_NO_MEM;
+    }
+    return (*free_slot)->start();
+}
+
+void icd_command_queue::requeue(item *items)
+{
+    uint64_t now = now_ms();
+    // The items of a flush belong to one node. They go back in their order, before the items of the node queued
+    // during the flush, so that the commands are still sent in the order they were queued.
+    item **link = &m_head;
+    while (items && *link && (*link)->info.node_id != items->info.node_id) {
+        link = &(*link)->next;
+    }
+    while (items) {
+        item *i = items;
+        items = i->next;
+        bool superseded = false;
+        for (item *queued = m_head; queued; queued = queued->next) {
+            if (is_same_write_path(queued->info, i->info)) {
+                superseded = true;
+                break;
+            }
+        }
+        if (i->expire_ms <= now || superseded) {
+            report_item(i, superseded ? CHIP_ERROR_CANCELLED : CHIP_ERROR_TIMEOUT);
+            free_item(i);
+            continue;
+        }
+        if (m_item_count >= CONFIG_ESP_MATTER_CONTROLLER_ICD_QUEUE_MAX_ITEMS) {
+            ESP_LOGE(TAG, "The ICD command queue is full");
+            report_item(i, CHIP_ERROR_NO_MEMORY);
+            free_item(i);
+            continue;
+        }
+        i->next = *link;
+        *link = i;
+        link = &i->next;
+        m_item_count++;
+    }
+}
+
+void icd_command_queue::on_flush_done(flush_context *done, bool flush_again)
+{
+    uint64_t node_id = done->get_node_id();
+    for (flush_context *&f : m_flushes) {
+        if (f == done) {
+            f = nullptr;
+        }
+    }
+    chip::Platform::Delete(done);
+    // Send the items queued during the flush while the ICD is still active
+    if (flush_again && get_pending_count(node_id) > 0) {
+        flush(node_id);
+    }
+}
+
+void icd_command_queue::cancel(uint64_t node_id)
+{
+    item **link = &m_head;
+    while (*link) {
+        item *i = *link;
+        if (i->info.node_id != node_id) {
+            link = &i->next;
+            continue;
+        }
+        *link = i->next;
+        m_item_count--;
+        report_item(i, CHIP_ERROR_CANCELLED);
+        free_item(i);
+    }
+}
+
+size_t icd_command_queue::get_pending_count(uint64_t node_id)
+{
+    size_t count = 0;
+    for (item *i = m_head; i; i = i->next) {
+        if (i->info.node_id == node_id) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void icd_command_queue::dump()
+{
+    drop_expired();
+    uint64_t now = now_ms();
+    ESP_LOGI(TAG, "%u/%u queued items", (unsigned)m_item_count, CONFIG_ESP_MATTER_CONTROLLER_ICD_QUEUE_MAX_ITEMS);
+    for (item *i = m_head; i; i = i->next) {
+        ESP_LOGI(TAG, "Node 0x%" PRIx64 ": %s 0x%x/0x%" PRIx32 "/0x%" PRIx32 " %s, expires in %" PRIu32 " s",
+                 i->info.node_id, i->info.type == ICD_ITEM_WRITE_ATTRIBUTE ? "write" : "invoke", i->info.endpoint_id,
+                 i->info.cluster_id, i->info.id, i->json_str ? i->json_str : "",
+                 (uint32_t)((i->expire_ms - now) / 1000));
+    }
+    for (flush_context *f : m_flushes) {
+        if (f) {
+            ESP_LOGI(TAG, "Flushing node 0x%" PRIx64, f->get_node_id());
+        }
+    }
+}
+
+esp_err_t icd_command_queue::flush_context::start()
+{
+    auto &controller_instance = esp_matter::controller::matter_controller_client::get_instance();
+#ifdef CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    CHIP_ERROR err = controller_instance.get_commissioner()->GetConnectedDevice(m_node_id, &on_device_connected_cb,
+                                                                                &on_device_connection_failure_cb);
+#else
+    CHIP_ERROR err = controller_instance.get_controller()->GetConnectedDevice(m_node_id, &on_device_connected_cb,
+                                                                              &on_device_connection_failure_cb);
+#endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to connect to node 0x%" PRIx64 ": %s", m_node_id, chip::ErrorStr(err));
+        // Keep the items for the next check-in
+        m_owner->requeue(m_items);
+        m_items = nullptr;
+        finish(err);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void icd_command_queue::flush_context::on_device_connected_fcn(void *context,
+                                                               chip::Messaging::ExchangeManager &exchangeMgr,
+                                                               const chip::SessionHandle &sessionHandle)
+{
+    flush_context *flush = reinterpret_cast<flush_context *>(context);
+    flush->m_exchange_mgr = &exchangeMgr;
+    flush->m_session.Grab(sessionHandle);
+    if (flush->send_writes() != ESP_OK) {
+        // Report the writes, the invokes can still be sent
+        item *end = flush->m_items;
+        while (end && end->info.type == ICD_ITEM_WRITE_ATTRIBUTE) {
+            end = end->next;
+        }
+        flush->complete_items(end, CHIP_ERROR_INTERNAL);
+        flush->send_next_invoke();
+    }
+}
+
+void icd_command_queue::flush_context::on_device_connection_failure_fcn(void *context,
+                                                                        const chip::ScopedNodeId &peerId,
+                                                                        CHIP_ERROR error)
+{
+    flush_context *flush = reinterpret_cast<flush_context *>(context);
+    ESP_LOGE(TAG, "Failed to connect to node 0x%" PRIx64 ": %s", peerId.GetNodeId(), chip::ErrorStr(error));
+    // The ICD is probably back to idle mode, keep the items for the next check-in
+    flush->m_owner->requeue(flush->m_items);
+    flush->m_items = nullptr;
+    flush->finish(error);
+}
+
+esp_err_t icd_command_queue::flush_context::send_writes()
+{
+    // The writes are moved before the invokes so that they are all sent in one write request
+    item *writes = nullptr;
+    item **writes_tail = &writes;
+    item **link = &m_items;
+    size_t write_count = 0;
+    size_t json_len = 2;
+    uint16_t timed_timeout_ms = 0;
+    while (*link) {
+        item *i = *link;
+        if (i->info.type != ICD_ITEM_WRITE_ATTRIBUTE) {
+            link = &i->next;
+            continue;
+        }
+        *link = i->next;
+        i->next = nullptr;
+        *writes_tail = i;
+        writes_tail = &i->next;
+        write_count++;
+        json_len += strlen(i->json_str) + 1;
+        timed_timeout_ms = std::max(timed_timeout_ms, i->timed_timeout_ms);
+    }
+    *writes_tail = m_items;
+    m_items = writes;
+    if (write_count == 0) {
+        send_next_invoke();
+        return ESP_OK;
+    }
+
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    chip::Platform::ScopedMemoryBuffer<char> json_array;
+    attr_paths.Alloc(write_count);
+    json_array.Alloc(json_len + 1);
+    ESP_RETURN_ON_FALSE(attr_paths.Get() && json_array.Get(), ESP_ERR_NO_MEM, TAG,
+                        "Failed to alloc memory for the write request");
+    size_t offset = 0;
+    json_array[offset++] = '[';
+    item *i = m_items;
+    for (size_t index = 0; index < write_count; ++index, i = i->next) {
+        attr_paths[index] = AttributePathParams(i->info.endpoint_id, i->info.cluster_id, i->info.id);
+        offset += snprintf(&json_array[offset], json_len + 1 - offset, "%s%s", index > 0 ? "," : "", i->json_str);
+    }
+    json_array[offset++] = ']';
+    json_array[offset] = '\0';
+
+    multiple_write_encodable_type attr_vals(json_array.Get());
+    chip::OperationalDeviceProxy device_proxy(m_exchange_mgr, m_session.Get().Value());
+    ESP_RETURN_ON_ERROR(interaction::write::send_request(&device_proxy, attr_paths, attr_vals, m_chunked_write_cb,
+                                                         timed_timeout_ms > 0 ? chip::MakeOptional(timed_timeout_ms)
+                                                                              : chip::NullOptional),
+                        TAG, "Failed to send the write request");
+    ESP_LOGI(TAG, "Sent %u queued writes to node 0x%" PRIx64, (unsigned)write_count, m_node_id);
+    return ESP_OK;
+}
+
+void icd_command_queue::flush_context::OnResponse(const WriteClient *client, const ConcreteDataAttributePath &path,
+                                                  StatusIB status)
+{
+    for (item *i = m_items; i && i->info.type == ICD_ITEM_WRITE_ATTRIBUTE; i = i->next) {
+        if (i->info.endpoint_id == path.mEndpointId && i->info.cluster_id == path.mClusterId &&
+            i->info.id == path.mAttributeId) {
+            m_owner->report_item(i, status.ToChipError());
+            i->reported = true;
+            break;
+        }
+    }
+}
+
+void icd_command_queue::flush_context::OnError(const WriteClient *client, CHIP_ERROR error)
+{
+    m_write_error = error;
+}
+
+void icd_command_queue::flush_context::OnDone(WriteClient *client)
+{
+    // The writes are at the head of the items, the ones without a response failed with the write request
+    CHIP_ERROR error = m_write_error == CHIP_NO_ERROR ? CHIP_ERROR_INCORRECT_STATE : m_write_error;
+    while (m_items && m_items->info.type == ICD_ITEM_WRITE_ATTRIBUTE) {
+        item *i = m_items;
+        m_items = i->next;
+        if (!i->reported) {
+            m_owner->report_item(i, error);
+        }
+        m_owner->free_item(i);
+    }
+    // The WriteClient is deleted after this callback, send the invokes from a new work item
+    PlatformMgr().ScheduleWork(send_next_work, reinterpret_cast<intptr_t>(this));
+}
+
+void icd_command_queue::flush_context::send_next_work(intptr_t context)
+{
+    flush_context *flush = reinterpret_cast<flush_context *>(context);
+    flush->send_next_invoke();
+}
+
+void icd_command_queue::flush_context::send_next_invoke()
+{
+    if (!m_items) {
+        finish(CHIP_NO_ERROR);
+        return;
+    }
+    if (!m_session) {
+        finish(CHIP_ERROR_CONNECTION_ABORTED);
+        return;
+    }
+    item *i = m_items;
+    chip::OperationalDeviceProxy device_proxy(m_exchange_mgr, m_session.Get().Value());
+    CommandPathParams command_path = {i->info.endpoint_id, 0, i->info.cluster_id, i->info.id,
+                                      chip::app::CommandPathFlags::kEndpointIdValid};
+    esp_err_t err = interaction::invoke::send_request(
+        this, &device_proxy, command_path, i->json_str, on_invoke_success, on_invoke_error,
+        i->timed_timeout_ms > 0 ? chip::MakeOptional(i->timed_timeout_ms) : chip::NullOptional);
+    if (err != ESP_OK) {
+        on_invoke_error(this, CHIP_ERROR_INTERNAL);
+    }
+}
+
+void icd_command_queue::flush_context::on_invoke_success(void *ctx, const ConcreteCommandPath &command_path,
+                                                         const StatusIB &status, TLVReader *response_data)
+{
+    flush_context *flush = reinterpret_cast<flush_context *>(ctx);
+    flush->complete_items(flush->m_items->next, status.ToChipError());
+    PlatformMgr().ScheduleWork(send_next_work, reinterpret_cast<intptr_t>(flush));
+}
+
+void icd_command_queue::flush_context::on_invoke_error(void *ctx, CHIP_ERROR error)
+{
+    flush_context *flush = reinterpret_cast<flush_context *>(ctx);
+    flush->complete_items(flush->m_items->next, error);
+    PlatformMgr().ScheduleWork(send_next_work, reinterpret_cast<intptr_t>(flush));
+}
+
+void icd_command_queue::flush_context::complete_items(item *end, CHIP_ERROR error)
+{
+    while (m_items && m_items != end) {
+        item *i = m_items;
+        m_items = i->next;
+        m_owner->report_item(i, error);
+        m_owner->free_item(i);
+    }
+}
+
+void icd_command_queue::flush_context::finish(CHIP_ERROR error)
+{
+    if (error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to flush the queued commands of node 0x%" PRIx64 ": %s", m_node_id,
+                 chip::ErrorStr(error));
+    }
+    complete_items(nullptr, error);
+    m_session.Release();
+    m_owner->on_flush_done(this, error == CHIP_NO_ERROR);
+}
+
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,197 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/ChunkedWriteCallback.h>
+#include <app/OperationalSessionSetup.h>
+#include <esp_err.h>
+#include <esp_matter_client.h>
+#include <stdint.h>
+#include <transport/SessionHolder.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Outbound queue of the writes and invokes destined for the registered ICDs
+ *
+ * A sleeping ICD only receives messages during its active mode, so instead of being sent right away the writes and
+ * invokes to a registered ICD are queued and flushed when the ICD checks in: the controller gets one CASE session
+ * with the ICD, sends all its queued writes in one write request, and then its queued invokes one after the other,
+ * while the ICD is still active.
+ *
+ * - A write to an attribute path with a queued write replaces the queued value.
+ * - The items not flushed before their time to live are dropped and reported with CHIP_ERROR_TIMEOUT.
+ * - The items are kept for the next check-in if the CASE session with the ICD cannot be established.
+ *
+ * @note All the APIs should be called in the Matter context or with the Matter stack lock.
+ */
+class icd_command_queue {
+public:
+    typedef enum {
+        ICD_ITEM_WRITE_ATTRIBUTE = 0,
+        ICD_ITEM_INVOKE_COMMAND,
+    } item_type_t;
+
+    typedef struct {
+        uint64_t node_id;
+        item_type_t type;
+        uint16_t endpoint_id;
+        uint32_t cluster_id;
+        // AttributeId of the writes, CommandId of the invokes
+        uint32_t id;
+    } item_info_t;
+
+    /** Called when a queued item is sent, or dropped, with the result of its interaction */
+    typedef void (*item_done_cb_t)(const item_info_t *item, CHIP_ERROR error, void *ctx);
+
+    static icd_command_queue &get_instance()
+    {
+        static icd_command_queue s_instance;
+        return s_instance;
+    }
+
+    void set_item_done_callback(item_done_cb_t cb, void *ctx)
+    {
+        m_item_done_cb = cb;
+        m_item_done_ctx = ctx;
+    }
+
+    /** Queue an attribute write for a registered ICD
+     *
+     * @param[in] node_id NodeId of the ICD
+     * @param[in] endpoint_id EndpointId
+     * @param[in] cluster_id ClusterId
+     * @param[in] attribute_id AttributeId
+     * @param[in] attr_val_json_str Attribute value string with JSON format
+     * @param[in] ttl_ms Time to live of the write, 0 for CONFIG_ESP_MATTER_CONTROLLER_ICD_QUEUE_DEFAULT_TTL_MS
+     * @param[in] timed_write_timeout_ms Timeout in millisecond for timed-write attributes
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FOUND if the node is not a registered ICD, the write should then be sent directly.
+     * @return ESP_ERR_NO_MEM if the queue is full.
+     */
+    esp_err_t queue_write(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                          const char *attr_val_json_str, uint32_t ttl_ms = 0,
+                          chip::Optional<uint16_t> timed_write_timeout_ms = chip::NullOptional);
+
+    /** Queue a command invoke for a registered ICD
+     *
+     * The invokes are not coalesced, they are sent in the order they are queued.
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FOUND if the node is not a registered ICD, the invoke should then be sent directly.
+     * @return ESP_ERR_NO_MEM if the queue is full.
+     */
+    esp_err_t queue_invoke(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                           const char *command_data_json_str, uint32_t ttl_ms = 0,
+                           chip::Optional<uint16_t> timed_invoke_timeout_ms = chip::NullOptional);
+
+    /** Send the queued items of a node now, it is done automatically when the node checks in */
+    esp_err_t flush(uint64_t node_id);
+
+    /** Drop the queued items of a node, they are reported with CHIP_ERROR_CANCELLED */
+    void cancel(uint64_t node_id);
+
+    size_t get_pending_count(uint64_t node_id);
+
+    /** Print the queued items */
+    void dump();
+
+private:
+    struct item {
+        item_info_t info;
+        // Attribute value or command data string with JSON format
+        char *json_str;
+        uint16_t timed_timeout_ms;
+        uint64_t expire_ms;
+        // The write response of the item is received
+        bool reported;
+        item *next;
+    };
+
+    /** Items of a node being sent over one CASE session */
+    class flush_context : public chip::app::WriteClient::Callback {
+    public:
+        flush_context(icd_command_queue *owner, uint64_t node_id, item *items)
+            : m_owner(owner)
+            , m_node_id(node_id)
+            , m_items(items)
+            , m_chunked_write_cb(this)
+            , on_device_connected_cb(on_device_connected_fcn, this)
+            , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
+        {
+        }
+
+        esp_err_t start();
+        uint64_t get_node_id() { return m_node_id; }
+
+        // WriteClient Callback Interface
+        void OnResponse(const chip::app::WriteClient *client, const chip::app::ConcreteDataAttributePath &path,
+                        chip::app::StatusIB status) override;
+        void OnError(const chip::app::WriteClient *client, CHIP_ERROR error) override;
+        void OnDone(chip::app::WriteClient *client) override;
+
+    private:
+        static void on_device_connected_fcn(void *context, chip::Messaging::ExchangeManager &exchangeMgr,
+                                            const chip::SessionHandle &sessionHandle);
+        static void on_device_connection_failure_fcn(void *context, const chip::ScopedNodeId &peerId,
+                                                     CHIP_ERROR error);
+        static void on_invoke_success(void *ctx, const chip::app::ConcreteCommandPath &command_path,
+                                      const chip::app::StatusIB &status, chip::TLV::TLVReader *response_data);
+        static void on_invoke_error(void *ctx, CHIP_ERROR error);
+        static void send_next_work(intptr_t context);
+
+        esp_err_t send_writes();
+        void send_next_invoke();
+        // Report the result of the items from the first one to end and free them
+        void complete_items(item *end, CHIP_ERROR error);
+        void finish(CHIP_ERROR error);
+
+        icd_command_queue *m_owner;
+        uint64_t m_node_id;
+        item *m_items;
+        chip::Messaging::ExchangeManager *m_exchange_mgr = nullptr;
+        chip::SessionHolder m_session;
+        chip::app::ChunkedWriteCallback m_chunked_write_cb;
+        CHIP_ERROR m_write_error = CHIP_NO_ERROR;
+
+        chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
+        chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
+    };
+
+    icd_command_queue() {}
+
+    static void on_check_in(const chip::ScopedNodeId &peer_node, void *ctx);
+    bool is_registered_icd(uint64_t node_id);
+    esp_err_t queue_item(const item_info_t &info, const char *json_str, uint32_t ttl_ms,
+                         chip::Optional<uint16_t> timed_timeout_ms);
+    void drop_expired();
+    // Put back the items of a flush which could not connect to the ICD
+    void requeue(item *items);
+    void report_item(item *i, CHIP_ERROR error);
+    void free_item(item *i);
+    flush_context *find_flush(uint64_t node_id);
+    void on_flush_done(flush_context *flush, bool flush_again);
+
+    item *m_head = nullptr;
+    size_t m_item_count = 0;
+    flush_context *m_flushes[CONFIG_ESP_MATTER_CONTROLLER_ICD_QUEUE_MAX_FLUSHES] = {};
+    bool m_check_in_registered = false;
+    item_done_cb_t m_item_done_cb = nullptr;
+    void *m_item_done_ctx = nullptr;
+};
+
+} // namespace controller
+} // namespace esp_matter
@@ -14,6 +14,9 @@
 
 #include <esp_check.h>
 #include <esp_log.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_pairing_command.h>
 #include <optional>
@@ -37,6 +40,9 @@ void pairing_command::OnPairingComplete(CHIP_ERROR err)
         ESP_LOGI(TAG, "PASE session establishment failure: Matter-%s", ErrorStr(err));
         auto &controller_instance = esp_matter::controller::matter_controller_client::get_instance();
         controller_instance.get_commissioner()->RegisterPairingDelegate(nullptr);
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+        batch_runner::get_instance().end_commissioning(err);
+#endif
     }
     if (m_callbacks.pase_callback) {
         m_callbacks.pase_callback(err);
@@ -54,6 +60,9 @@ void pairing_command::OnCommissioningSuccess(chip::PeerId peerId)
             peerId.GetCompressedFabricId());
         m_callbacks.commissioning_success_callback(ScopedNodeId(fabric->GetFabricIndex(), peerId.GetNodeId()));
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_commissioning(CHIP_NO_ERROR);
+#endif
 }
 
 void pairing_command::OnCommissioningFailure(
@@ -75,6 +84,9 @@ void pairing_command::OnCommissioningFailure(
         controller_instance.get_icd_client_storage().DeleteEntry(
             ScopedNodeId(peerId.GetNodeId(), controller_instance.get_fabric_index()));
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_commissioning(error);
+#endif
 }
 
 void pairing_command::OnICDRegistrationComplete(ScopedNodeId nodeId, uint32_t icdCounter)
@@ -17,11 +17,15 @@
 #include <esp_matter_client.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_read_command.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+#include <esp_matter_controller_attribute_cache.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+#include <esp_matter_controller_node_stats.h>
+#endif
 
 #include <app/server/Server.h>
 
-#include <commands/clusters/DataModelLogger.h>
-
 using namespace chip::app::Clusters;
 using namespace esp_matter::client;
 using chip::DeviceProxy;
@@ -38,11 +42,16 @@ void read_command::on_device_connected_fcn(void *context, ExchangeManager &excha
                                            const SessionHandle &sessionHandle)
 {
     read_command *cmd = (read_command *)context;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_node_id, cmd->m_start_ms, CHIP_NO_ERROR);
+    cmd->m_start_ms = node_stats::timestamp_ms();
+#endif
     chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
     esp_err_t err = interaction::read::send_request(&device_proxy, cmd->m_attr_paths.Get(),
                                                     cmd->m_attr_paths.AllocatedSize(), cmd->m_event_paths.Get(),
                                                     cmd->m_event_paths.AllocatedSize(), cmd->m_buffered_read_cb);
     if (err != ESP_OK) {
+        cmd->m_error = CHIP_ERROR_INTERNAL;
         chip::Platform::Delete(cmd);
     }
     return;
@@ -51,12 +60,22 @@ void read_command::on_device_connected_fcn(void *context, ExchangeManager &excha
 void read_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     read_command *cmd = (read_command *)context;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_node_id, cmd->m_start_ms, error);
+#endif
+    cmd->m_error = error;
     chip::Platform::Delete(cmd);
     return;
 }
 
 esp_err_t read_command::send_command()
 {
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    m_start_ms = node_stats::timestamp_ms();
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    m_batch_tag = batch_runner::get_instance().begin_interaction();
+#endif
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
     chip::Server &server = chip::Server::GetInstance();
     server.GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_node_id, get_fabric_index()),
@@ -79,6 +98,7 @@ esp_err_t read_command::send_command()
 #endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
 
+    m_error = CHIP_ERROR_INTERNAL;
     chip::Platform::Delete(this);
     return ESP_FAIL;
 }
@@ -90,6 +110,9 @@ void read_command::OnAttributeData(const chip::app::ConcreteDataAttributePath &p
     CHIP_ERROR error = status.ToChipError();
     if (CHIP_NO_ERROR != error) {
         ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+        node_stats::get_instance().record_status(m_node_id, status);
+#endif
         return;
     }
 
@@ -97,14 +120,17 @@ void read_command::OnAttributeData(const chip::app::ConcreteDataAttributePath &p
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().update_attribute(m_node_id, path, data);
+#endif
     if (attribute_data_cb) {
         chip::TLV::TLVReader data_cpy;
         data_cpy.Init(*data);
         attribute_data_cb(m_node_id, path, &data_cpy);
     }
-    error = DataModelLogger::LogAttribute(path, data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    output_sink *sink = get_output_sink(m_output_format);
+    if (sink) {
+        sink->on_attribute(m_node_id, path, data);
     }
 }
 
@@ -124,20 +150,24 @@ void read_command::OnEventData(const chip::app::EventHeader &event_header, chip:
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().update_event(m_node_id, event_header, data);
+#endif
     if (event_data_cb) {
         chip::TLV::TLVReader data_cpy;
         data_cpy.Init(*data);
         event_data_cb(m_node_id, event_header, &data_cpy);
     }
-    error = DataModelLogger::LogEvent(event_header, data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    output_sink *sink = get_output_sink(m_output_format);
+    if (sink) {
+        sink->on_event(m_node_id, event_header, data);
     }
 }
 
 void read_command::OnError(CHIP_ERROR error)
 {
     ESP_LOGE(TAG, "Read Error: %s", chip::ErrorStr(error));
+    m_error = error;
 }
 
 void read_command::OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepareParams)
@@ -149,12 +179,47 @@ void read_command::OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepare
 void read_command::OnDone(ReadClient *apReadClient)
 {
     ESP_LOGI(TAG, "read done");
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_request(m_node_id, node_stats::REQUEST_READ, m_start_ms, m_error);
+#endif
     if (read_done_cb) {
         read_done_cb(m_node_id, m_attr_paths, m_event_paths);
     }
     chip::Platform::Delete(this);
 }
 
+void read_command::OnReportEnd()
+{
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().on_report_end(m_node_id, m_attr_paths.Get(), m_attr_paths.AllocatedSize(), true);
+#endif
+}
+
+CHIP_ERROR read_command::OnUpdateDataVersionFilterList(
+    chip::app::DataVersionFilterIBs::Builder &data_version_filter_ibs_builder,
+    const chip::Span<AttributePathParams> &attribute_paths, bool &encoded_data_version_list)
+{
+    encoded_data_version_list = false;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    if (m_cache_filter_enabled) {
+        return attribute_cache::get_instance().encode_data_version_filters(m_node_id, data_version_filter_ibs_builder,
+                                                                           attribute_paths, encoded_data_version_list);
+    }
+#endif
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR read_command::GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number)
+{
+    event_number.ClearValue();
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    if (m_cache_filter_enabled) {
+        event_number = attribute_cache::get_instance().get_highest_event_number(m_node_id);
+    }
+#endif
+    return CHIP_NO_ERROR;
+}
+
 esp_err_t send_read_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
                                  ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
                                  ScopedMemoryBufferWithSize<uint32_t> &attribute_ids)
@@ -17,6 +17,10 @@
 #include <app/BufferedReadCallback.h>
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
+#include <esp_matter_controller_output_sink.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 
@@ -84,7 +88,12 @@ public:
         }
     }
 
-    ~read_command() {}
+    ~read_command()
+    {
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+        batch_runner::get_instance().end_interaction(m_batch_tag, m_error);
+#endif
+    }
 
     esp_err_t send_command();
 
@@ -101,12 +110,41 @@ public:
 
     void OnDone(ReadClient *apReadClient) override;
 
+    void OnReportEnd() override;
+
+    CHIP_ERROR OnUpdateDataVersionFilterList(chip::app::DataVersionFilterIBs::Builder &data_version_filter_ibs_builder,
+                                             const chip::Span<AttributePathParams> &attribute_paths,
+                                             bool &encoded_data_version_list) override;
+
+    CHIP_ERROR GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number) override;
+
+    /** Skip the clusters and events already in the attribute cache with DataVersionFilters and EventFilters.
+     *
+     * @note The attributes of the filtered clusters are not reported to the callbacks and should be read from the
+     * cache. It has no effect if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE is disabled.
+     */
+    void set_cache_filter_enabled(bool enabled) { m_cache_filter_enabled = enabled; }
+
+    /** Set the output format of the received reports, the global output format is used by default */
+    void set_output_format(output_format_t format) { m_output_format = format; }
+
 private:
     uint64_t m_node_id;
     BufferedReadCallback m_buffered_read_cb;
     ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
     ScopedMemoryBufferWithSize<EventPathParams> m_event_paths;
     size_t m_event_path_len;
+    bool m_cache_filter_enabled = false;
+    output_format_t m_output_format = OUTPUT_FORMAT_DEFAULT;
+    // First error of the interaction
+    CHIP_ERROR m_error = CHIP_NO_ERROR;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    // Start of the session lookup, then of the request
+    uint64_t m_start_ms = 0;
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    uint32_t m_batch_tag = 0;
+#endif
 
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
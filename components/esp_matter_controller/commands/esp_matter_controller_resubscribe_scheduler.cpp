@@ -0,0 +1,257 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_log.h>
+#include <esp_matter_controller_resubscribe_scheduler.h>
+#include <esp_matter_controller_subscribe_command.h>
+
+#include <crypto/RandUtils.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+
+static const char *TAG = "resubscribe_scheduler";
+
+using chip::app::ReadClient;
+
+namespace esp_matter {
+namespace controller {
+
+static uint64_t now_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+resubscribe_scheduler::entry *resubscribe_scheduler::find_entry(subscribe_command *cmd)
+{
+    for (entry &e : m_entries) {
+        if (e.state != k_free && e.cmd == cmd) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+resubscribe_scheduler::entry *resubscribe_scheduler::alloc_entry(subscribe_command *cmd)
+{
+    for (entry &e : m_entries) {
+        if (e.state == k_free) {
+            e = {};
+            e.cmd = cmd;
+            e.priority = cmd->get_priority();
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t resubscribe_scheduler::compute_backoff_ms(uint8_t retries)
+{
+    uint32_t backoff_ms = CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_MAX_BACKOFF_MS;
+    if (retries < 16) {
+        backoff_ms = std::min<uint32_t>(backoff_ms, CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_MIN_BACKOFF_MS << retries);
+    }
+    // Equal jitter: the delay is picked in [backoff / 2, backoff] so the retries are spread but still back off
+    return backoff_ms / 2 + chip::Crypto::GetRandU32() % (backoff_ms / 2 + 1);
+}
+
+esp_err_t resubscribe_scheduler::schedule_subscribe(subscribe_command *cmd)
+{
+    entry *e = find_entry(cmd);
+    if (!e) {
+        e = alloc_entry(cmd);
+        if (!e) {
+            ESP_LOGW(TAG, "No free entry for the subscription to node 0x%" PRIx64, cmd->get_node_id());
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    e->client = nullptr;
+    e->state = k_waiting;
+    e->due_ms = now_ms();
+    schedule_next();
+    return ESP_OK;
+}
+
+esp_err_t resubscribe_scheduler::schedule_resubscribe(subscribe_command *cmd, ReadClient *client,
+                                                      CHIP_ERROR termination_cause)
+{
+    uint64_t now = now_ms();
+    entry *e = find_entry(cmd);
+    if (e && e->state == k_active) {
+        // The previous attempt did not establish the subscription
+        m_active--;
+        m_failures++;
+    } else if (!e) {
+        e = alloc_entry(cmd);
+        if (!e) {
+            ESP_LOGW(TAG, "No free entry for the resubscription to node 0x%" PRIx64, cmd->get_node_id());
+            return ESP_ERR_NO_MEM;
+        }
+        e->lost_ms = now;
+    }
+    e->client = client;
+    e->state = k_waiting;
+    e->reestablish_case = termination_cause == CHIP_ERROR_TIMEOUT;
+    uint32_t backoff_ms = compute_backoff_ms(e->retries);
+    e->due_ms = now + backoff_ms;
+    if (e->retries < UINT8_MAX) {
+        e->retries++;
+    }
+    ESP_LOGI(TAG, "Resubscribe to node 0x%" PRIx64 " in %" PRIu32 " ms, retry %u, %s", cmd->get_node_id(),
+             backoff_ms, e->retries, e->reestablish_case ? "new CASE session" : "existing session");
+    schedule_next();
+    return ESP_OK;
+}
+
+void resubscribe_scheduler::on_established(subscribe_command *cmd)
+{
+    entry *e = find_entry(cmd);
+    if (!e) {
+        return;
+    }
+    if (e->lost_ms != 0) {
+        uint32_t recover_ms = now_ms() - e->lost_ms;
+        m_recoveries++;
+        m_last_recover_ms = recover_ms;
+        m_total_recover_ms += recover_ms;
+        m_max_recover_ms = std::max(m_max_recover_ms, recover_ms);
+        ESP_LOGI(TAG, "Subscription to node 0x%" PRIx64 " recovered in %" PRIu32 " ms", cmd->get_node_id(),
+                 recover_ms);
+    }
+    release(e, false);
+}
+
+void resubscribe_scheduler::remove(subscribe_command *cmd)
+{
+    entry *e = find_entry(cmd);
+    if (e) {
+        release(e, true);
+    }
+}
+
+void resubscribe_scheduler::release(entry *e, bool failed)
+{
+    if (e->state == k_active) {
+        m_active--;
+        if (failed) {
+            m_failures++;
+        }
+    }
+    *e = {};
+    schedule_next();
+}
+
+void resubscribe_scheduler::schedule_next()
+{
+    chip::System::Layer &system_layer = chip::DeviceLayer::SystemLayer();
+    system_layer.CancelTimer(timer_cb, this);
+    // The next attempt is started when a running one completes
+    if (m_active >= CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_MAX_CONCURRENT) {
+        return;
+    }
+    uint64_t next_due_ms = UINT64_MAX;
+    for (entry &e : m_entries) {
+        if (e.state == k_waiting) {
+            next_due_ms = std::min(next_due_ms, e.due_ms);
+        }
+    }
+    if (next_due_ms == UINT64_MAX) {
+        return;
+    }
+    uint64_t now = now_ms();
+    uint32_t delay_ms = next_due_ms > now ? next_due_ms - now : 0;
+    system_layer.StartTimer(chip::System::Clock::Milliseconds32(delay_ms), timer_cb, this);
+}
+
+void resubscribe_scheduler::timer_cb(chip::System::Layer *layer, void *ctx)
+{
+    resubscribe_scheduler *scheduler = reinterpret_cast<resubscribe_scheduler *>(ctx);
+    scheduler->start_due_attempts();
+    scheduler->schedule_next();
+}
+
+void resubscribe_scheduler::start_due_attempts()
+{
+    uint64_t now = now_ms();
+    while (m_active < CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_MAX_CONCURRENT) {
+        entry *next = nullptr;
+        for (entry &e : m_entries) {
+            if (e.state != k_waiting || e.due_ms > now) {
+                continue;
+            }
+            if (!next || e.priority > next->priority ||
+                (e.priority == next->priority && e.due_ms < next->due_ms)) {
+                next = &e;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        next->state = k_active;
+        m_active++;
+        m_attempts++;
+        subscribe_command *cmd = next->cmd;
+        if (next->client) {
+            CHIP_ERROR err = next->client->ScheduleResubscription(0, chip::NullOptional, next->reestablish_case);
+            if (err != CHIP_NO_ERROR) {
+                ESP_LOGE(TAG, "Failed to resubscribe to node 0x%" PRIx64 ": %s", cmd->get_node_id(),
+                         chip::ErrorStr(err));
+                release(next, true);
+            }
+        } else {
+            // The command might be deleted, and its entry released, if the subscription cannot be sent
+            cmd->establish();
+        }
+    }
+}
+
+void resubscribe_scheduler::get_metrics(metrics_t &metrics)
+{
+    metrics = {};
+    for (entry &e : m_entries) {
+        if (e.state == k_waiting) {
+            metrics.pending++;
+        }
+    }
+    metrics.active = m_active;
+    metrics.attempts = m_attempts;
+    metrics.failures = m_failures;
+    metrics.recoveries = m_recoveries;
+    metrics.last_recover_ms = m_last_recover_ms;
+    metrics.avg_recover_ms = m_recoveries ? m_total_recover_ms / m_recoveries : 0;
+    metrics.max_recover_ms = m_max_recover_ms;
+}
+
+void resubscribe_scheduler::dump()
+{
+    metrics_t metrics;
+    get_metrics(metrics);
+    ESP_LOGI(TAG,
+             "pending %u, active %u, attempts %" PRIu32 ", failures %" PRIu32 ", recoveries %" PRIu32
+             ", recover last %" PRIu32 " ms avg %" PRIu32 " ms max %" PRIu32 " ms",
+             metrics.pending, metrics.active, metrics.attempts, metrics.failures, metrics.recoveries,
+             metrics.last_recover_ms, metrics.avg_recover_ms, metrics.max_recover_ms);
+    uint64_t now = now_ms();
+    for (entry &e : m_entries) {
+        if (e.state == k_free) {
+            continue;
+        }
+        ESP_LOGI(TAG, "Node 0x%" PRIx64 ": %s, priority %u, retry %u, due in %" PRIu32 " ms", e.cmd->get_node_id(),
+                 e.state == k_active ? "active" : "waiting", e.priority, e.retries,
+                 (uint32_t)(e.due_ms > now ? e.due_ms - now : 0));
+    }
+}
+
+} // namespace controller
+} // namespace esp_matter
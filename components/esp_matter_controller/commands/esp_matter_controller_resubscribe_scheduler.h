@@ -0,0 +1,132 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/ReadClient.h>
+#include <esp_err.h>
+#include <stdint.h>
+#include <system/SystemLayer.h>
+
+namespace esp_matter {
+namespace controller {
+
+class subscribe_command;
+
+/** Central scheduler of the subscription establishments and resubscriptions of the subscribe commands
+ *
+ * Instead of letting every ReadClient retry on its own timer, the subscribe commands queue their attempts here:
+ *  - The resubscriptions are delayed with an exponential backoff with jitter, so the subscriptions lost at the same
+ *    time, after a controller reboot or a network outage, do not retry at the same time.
+ *  - At most CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_MAX_CONCURRENT attempts, each of them possibly establishing a
+ *    CASE session, run at the same time.
+ *  - When several attempts are due, the subscriptions with the highest priority go first.
+ *
+ * An attempt completes when its subscription is established, or fails when the subscription is lost again or done.
+ *
+ * @note All the APIs should be called in the Matter context.
+ */
+class resubscribe_scheduler {
+public:
+    typedef struct {
+        // Attempts waiting for their backoff delay or for a free slot
+        uint16_t pending;
+        // Attempts running
+        uint16_t active;
+        uint32_t attempts;
+        uint32_t failures;
+        uint32_t recoveries;
+        // Time from the loss of a subscription to its re-establishment
+        uint32_t last_recover_ms;
+        uint32_t avg_recover_ms;
+        uint32_t max_recover_ms;
+    } metrics_t;
+
+    static resubscribe_scheduler &get_instance()
+    {
+        static resubscribe_scheduler s_instance;
+        return s_instance;
+    }
+
+    /** Queue the first subscription attempt of a subscribe command, the attempt starts as soon as a slot is free
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NO_MEM if the scheduler is full, the command should then subscribe directly.
+     */
+    esp_err_t schedule_subscribe(subscribe_command *cmd);
+
+    /** Queue the resubscription of a lost subscription, called from OnResubscriptionNeeded()
+     *
+     * @param[in] cmd Subscribe command of the subscription
+     * @param[in] client ReadClient of the subscription, it stays idle until the resubscription starts
+     * @param[in] termination_cause Cause of the loss of the subscription
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NO_MEM if the scheduler is full, the command should then apply the default resubscribe policy.
+     */
+    esp_err_t schedule_resubscribe(subscribe_command *cmd, chip::app::ReadClient *client, CHIP_ERROR termination_cause);
+
+    /** Notify that the subscription of a command is established */
+    void on_established(subscribe_command *cmd);
+
+    /** Remove a command from the scheduler, called when the subscribe command is deleted */
+    void remove(subscribe_command *cmd);
+
+    void get_metrics(metrics_t &metrics);
+
+    /** Print the metrics and the queued attempts */
+    void dump();
+
+private:
+    typedef enum {
+        k_free = 0,
+        k_waiting,
+        k_active,
+    } entry_state_t;
+
+    struct entry {
+        subscribe_command *cmd;
+        // nullptr for the first subscription attempt
+        chip::app::ReadClient *client;
+        entry_state_t state;
+        uint8_t priority;
+        uint8_t retries;
+        bool reestablish_case;
+        uint64_t due_ms;
+        // Time the subscription was lost, 0 for the first subscription attempt
+        uint64_t lost_ms;
+    };
+
+    resubscribe_scheduler() {}
+
+    entry *find_entry(subscribe_command *cmd);
+    entry *alloc_entry(subscribe_command *cmd);
+    uint32_t compute_backoff_ms(uint8_t retries);
+    void release(entry *e, bool failed);
+    void schedule_next();
+    void start_due_attempts();
+    static void timer_cb(chip::System::Layer *layer, void *ctx);
+
+    entry m_entries[CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_MAX_ENTRIES] = {};
+    uint16_t m_active = 0;
+    uint32_t m_attempts = 0;
+    uint32_t m_failures = 0;
+    uint32_t m_recoveries = 0;
+    uint32_t m_last_recover_ms = 0;
+    uint64_t m_total_recover_ms = 0;
+    uint32_t m_max_recover_ms = 0;
+};
+
+} // namespace controller
+} // namespace esp_matter
@@ -18,8 +18,12 @@
 #include <esp_matter_client.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_subscribe_command.h>
-
-#include <commands/clusters/DataModelLogger.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+#include <esp_matter_controller_attribute_cache.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+#include <esp_matter_controller_node_stats.h>
+#endif
 
 using namespace chip::app::Clusters;
 using namespace esp_matter::client;
@@ -30,7 +34,9 @@ using chip::app::ReadPrepareParams;
 
 static const char *TAG = "read_command";
 
+#ifndef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
 static const uint8_t k_max_resubscribe_retries = 2;
+#endif
 
 namespace esp_matter {
 namespace controller {
@@ -39,12 +45,24 @@ void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &
                                                 const SessionHandle &sessionHandle)
 {
     subscribe_command *cmd = (subscribe_command *)context;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_node_id, cmd->m_start_ms, CHIP_NO_ERROR);
+    cmd->m_start_ms = node_stats::timestamp_ms();
+#endif
     chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
     esp_err_t err = interaction::subscribe::send_request(
         &device_proxy, cmd->m_attr_paths.Get(), cmd->m_attr_paths.AllocatedSize(), cmd->m_event_paths.Get(),
         cmd->m_event_paths.AllocatedSize(), cmd->m_min_interval, cmd->m_max_interval, cmd->m_keep_subscription,
         cmd->m_auto_resubscribe, cmd->m_buffered_read_cb);
     if (err != ESP_OK) {
+        // The subscription will never be established, notify it as a connection failure
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+        batch_runner::get_instance().end_interaction(cmd->m_batch_tag, CHIP_ERROR_INTERNAL);
+        cmd->m_batch_tag = 0;
+#endif
+        if (cmd->subscribe_failure_cb)
+            cmd->subscribe_failure_cb((void *)cmd);
+
         chip::Platform::Delete(cmd);
     }
     return;
@@ -53,6 +71,13 @@ void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &
 void subscribe_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     subscribe_command *cmd = (subscribe_command *)context;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_node_id, cmd->m_start_ms, error);
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(cmd->m_batch_tag, error);
+    cmd->m_batch_tag = 0;
+#endif
 
     if (cmd->subscribe_failure_cb)
         cmd->subscribe_failure_cb((void *)cmd);
@@ -63,6 +88,22 @@ void subscribe_command::on_device_connection_failure_fcn(void *context, const Sc
 
 esp_err_t subscribe_command::send_command()
 {
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    m_batch_tag = batch_runner::get_instance().begin_interaction();
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+    if (resubscribe_scheduler::get_instance().schedule_subscribe(this) == ESP_OK) {
+        return ESP_OK;
+    }
+#endif
+    return establish();
+}
+
+esp_err_t subscribe_command::establish()
+{
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    m_start_ms = node_stats::timestamp_ms();
+#endif
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
     chip::Server *server = &(chip::Server::GetInstance());
     server->GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_node_id, get_fabric_index()),
@@ -95,18 +136,24 @@ void subscribe_command::OnAttributeData(const chip::app::ConcreteDataAttributePa
     CHIP_ERROR error = status.ToChipError();
     if (CHIP_NO_ERROR != error) {
         ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+        node_stats::get_instance().record_status(m_node_id, status);
+#endif
         return;
     }
     if (data == nullptr) {
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().update_attribute(m_node_id, path, data);
+#endif
 
-    chip::TLV::TLVReader log_data;
-    log_data.Init(*data);
-    error = DataModelLogger::LogAttribute(path, &log_data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    output_sink *sink = get_output_sink(m_output_format);
+    if (sink) {
+        chip::TLV::TLVReader log_data;
+        log_data.Init(*data);
+        sink->on_attribute(m_node_id, path, &log_data);
     }
 
     if (attribute_data_cb) {
@@ -129,12 +176,15 @@ void subscribe_command::OnEventData(const chip::app::EventHeader &event_header,
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().update_event(m_node_id, event_header, data);
+#endif
 
-    chip::TLV::TLVReader log_data;
-    log_data.Init(*data);
-    error = DataModelLogger::LogEvent(event_header, &log_data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    output_sink *sink = get_output_sink(m_output_format);
+    if (sink) {
+        chip::TLV::TLVReader log_data;
+        log_data.Init(*data);
+        sink->on_event(m_node_id, event_header, &log_data);
     }
 
     if (event_data_cb) {
@@ -145,6 +195,18 @@ void subscribe_command::OnEventData(const chip::app::EventHeader &event_header,
 void subscribe_command::OnError(CHIP_ERROR error)
 {
     ESP_LOGE(TAG, "Subscribe Error: %s", chip::ErrorStr(error));
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    if (m_start_ms != 0) {
+        node_stats::get_instance().record_request(m_node_id, node_stats::REQUEST_SUBSCRIBE, m_start_ms, error);
+        m_start_ms = 0;
+    } else {
+        node_stats::get_instance().record_error(m_node_id, error);
+    }
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(m_batch_tag, error);
+    m_batch_tag = 0;
+#endif
 }
 
 void subscribe_command::OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepareParams)
@@ -158,16 +220,55 @@ void subscribe_command::OnSubscriptionEstablished(chip::SubscriptionId subscript
     m_subscription_id = subscriptionId;
     m_resubscribe_retries = 0;
     ESP_LOGI(TAG, "Subscription 0x%" PRIx32 " established", subscriptionId);
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    // The resubscriptions scheduled by the ReadClient are not timed
+    if (m_start_ms != 0) {
+        node_stats::get_instance().record_request(m_node_id, node_stats::REQUEST_SUBSCRIBE, m_start_ms,
+                                                  CHIP_NO_ERROR);
+        m_start_ms = 0;
+    }
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    batch_runner::get_instance().end_interaction(m_batch_tag, CHIP_NO_ERROR);
+    m_batch_tag = 0;
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+    resubscribe_scheduler::get_instance().on_established(this);
+#endif
+    if (subscribe_established_cb) {
+        subscribe_established_cb(m_node_id, subscriptionId);
+    }
 }
 
 CHIP_ERROR subscribe_command::OnResubscriptionNeeded(ReadClient *apReadClient, CHIP_ERROR aTerminationCause)
 {
+    // The new subscription will send a priming report again
+    m_primed = false;
     m_resubscribe_retries++;
+#ifndef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+    // With the resubscribe scheduler, the retries are backed off up to the maximum backoff instead of being given up
     if (m_resubscribe_retries > k_max_resubscribe_retries) {
         ESP_LOGE(TAG, "Could not find the devices in %d retries, terminate the subscription",
                  k_max_resubscribe_retries);
         return aTerminationCause;
     }
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    // OnError() is not called for the terminations which are resubscribed
+    if (m_start_ms != 0) {
+        node_stats::get_instance().record_request(m_node_id, node_stats::REQUEST_SUBSCRIBE, m_start_ms,
+                                                  aTerminationCause);
+        m_start_ms = 0;
+    } else {
+        node_stats::get_instance().record_error(m_node_id, aTerminationCause);
+    }
+    m_last_report_ms = 0;
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+    if (resubscribe_scheduler::get_instance().schedule_resubscribe(this, apReadClient, aTerminationCause) == ESP_OK) {
+        return CHIP_NO_ERROR;
+    }
+#endif
     return apReadClient->DefaultResubscribePolicy(aTerminationCause);
 }
 
@@ -181,6 +282,44 @@ void subscribe_command::OnDone(ReadClient *apReadClient)
     chip::Platform::Delete(this);
 }
 
+void subscribe_command::OnReportEnd()
+{
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    attribute_cache::get_instance().on_report_end(m_node_id, m_attr_paths.Get(), m_attr_paths.AllocatedSize(),
+                                                  !m_primed);
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_report(m_node_id, m_last_report_ms);
+    m_last_report_ms = node_stats::timestamp_ms();
+#endif
+    m_primed = true;
+}
+
+CHIP_ERROR subscribe_command::OnUpdateDataVersionFilterList(
+    chip::app::DataVersionFilterIBs::Builder &data_version_filter_ibs_builder,
+    const chip::Span<AttributePathParams> &attribute_paths, bool &encoded_data_version_list)
+{
+    encoded_data_version_list = false;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    if (m_cache_filter_enabled) {
+        return attribute_cache::get_instance().encode_data_version_filters(m_node_id, data_version_filter_ibs_builder,
+                                                                           attribute_paths, encoded_data_version_list);
+    }
+#endif
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR subscribe_command::GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number)
+{
+    event_number.ClearValue();
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE
+    if (m_cache_filter_enabled) {
+        event_number = attribute_cache::get_instance().get_highest_event_number(m_node_id);
+    }
+#endif
+    return CHIP_NO_ERROR;
+}
+
 esp_err_t send_subscribe_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
                                       ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
                                       ScopedMemoryBufferWithSize<uint32_t> &attribute_ids, uint16_t min_interval,
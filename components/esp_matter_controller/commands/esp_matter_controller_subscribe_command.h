@@ -17,6 +17,13 @@
 #include <app/BufferedReadCallback.h>
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
+#include <esp_matter_controller_output_sink.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+#include <esp_matter_controller_resubscribe_scheduler.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 
@@ -99,10 +106,23 @@ public:
         }
     }
 
-    ~subscribe_command() {}
+    ~subscribe_command()
+    {
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+        resubscribe_scheduler::get_instance().remove(this);
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+        // The subscription is dropped before being established
+        batch_runner::get_instance().end_interaction(m_batch_tag, CHIP_ERROR_CANCELLED);
+#endif
+    }
 
     esp_err_t send_command();
 
+    /** Establish the CASE session and send the subscribe request, send_command() calls it directly or through the
+     * resubscribe scheduler */
+    esp_err_t establish();
+
     // ReadClient Callback Interface
     void OnAttributeData(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
                          const chip::app::StatusIB &status) override;
@@ -116,12 +136,42 @@ public:
 
     void OnDone(ReadClient *apReadClient) override;
 
+    void OnReportEnd() override;
+
+    CHIP_ERROR OnUpdateDataVersionFilterList(chip::app::DataVersionFilterIBs::Builder &data_version_filter_ibs_builder,
+                                             const chip::Span<AttributePathParams> &attribute_paths,
+                                             bool &encoded_data_version_list) override;
+
+    CHIP_ERROR GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number) override;
+
+    /** Skip the clusters and events already in the attribute cache with DataVersionFilters and EventFilters.
+     *
+     * @note The attributes of the filtered clusters are not reported to the callbacks and should be read from the
+     * cache. It has no effect if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE is disabled.
+     */
+    void set_cache_filter_enabled(bool enabled) { m_cache_filter_enabled = enabled; }
+
+    /** Set the output format of the received reports, the global output format is used by default */
+    void set_output_format(output_format_t format) { m_output_format = format; }
+
     void OnSubscriptionEstablished(chip::SubscriptionId subscriptionId) override;
 
     CHIP_ERROR OnResubscriptionNeeded(ReadClient *apReadClient, CHIP_ERROR aTerminationCause) override;
 
     uint32_t get_subscription_id() { return m_subscription_id; }
 
+    uint64_t get_node_id() { return m_node_id; }
+
+    /** Set the priority of the subscription in the resubscribe scheduler, higher values go first */
+    void set_priority(uint8_t priority) { m_priority = priority; }
+
+    uint8_t get_priority() { return m_priority; }
+
+    void set_subscribe_established_cb(subscribe_established_cb_t established_cb)
+    {
+        subscribe_established_cb = established_cb;
+    }
+
 private:
     uint64_t m_node_id;
     uint16_t m_min_interval;
@@ -131,8 +181,22 @@ private:
     BufferedReadCallback m_buffered_read_cb;
     uint32_t m_subscription_id = 0;
     uint8_t m_resubscribe_retries = 0;
+    uint8_t m_priority = 0;
+    bool m_cache_filter_enabled = false;
+    output_format_t m_output_format = OUTPUT_FORMAT_DEFAULT;
+    // The priming report of the subscription has been received
+    bool m_primed = false;
     ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
     ScopedMemoryBufferWithSize<EventPathParams> m_event_paths;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    // Start of the session lookup, then of the subscribe request, 0 once the subscription is established
+    uint64_t m_start_ms = 0;
+    uint64_t m_last_report_ms = 0;
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    // Tag of the batch line which sent the command, 0 once the subscription is established or failed
+    uint32_t m_batch_tag = 0;
+#endif
 
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
@@ -144,6 +208,7 @@ private:
     event_report_cb_t event_data_cb;
     subscribe_done_cb_t subscribe_done_cb;
     subscribe_failure_cb_t subscribe_failure_cb;
+    subscribe_established_cb_t subscribe_established_cb = nullptr;
 };
 
 /** Send subscribe command with multiple attribute paths
@@ -0,0 +1,504 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_subscribe_command.h>
+#include <esp_matter_controller_subscription_manager.h>
+
+#include <lib/support/CHIPMem.h>
+
+#include <algorithm>
+
+static const char *TAG = "subscription_manager";
+
+namespace esp_matter {
+namespace controller {
+
+template <typename T>
+static bool id_covers(T outer, T inner, T wildcard)
+{
+    return outer == wildcard || outer == inner;
+}
+
+static bool attr_path_covers(const AttributePathParams &outer, const AttributePathParams &inner)
+{
+    return id_covers(outer.mEndpointId, inner.mEndpointId, chip::kInvalidEndpointId) &&
+        id_covers(outer.mClusterId, inner.mClusterId, chip::kInvalidClusterId) &&
+        id_covers(outer.mAttributeId, inner.mAttributeId, chip::kInvalidAttributeId);
+}
+
+static bool event_path_covers(const EventPathParams &outer, const EventPathParams &inner)
+{
+    return id_covers(outer.mEndpointId, inner.mEndpointId, chip::kInvalidEndpointId) &&
+        id_covers(outer.mClusterId, inner.mClusterId, chip::kInvalidClusterId) &&
+        id_covers(outer.mEventId, inner.mEventId, chip::kInvalidEventId);
+}
+
+static bool attr_path_equal(const AttributePathParams &a, const AttributePathParams &b)
+{
+    return attr_path_covers(a, b) && attr_path_covers(b, a);
+}
+
+static bool event_path_equal(const EventPathParams &a, const EventPathParams &b)
+{
+    return event_path_covers(a, b) && event_path_covers(b, a);
+}
+
+/* Merge the paths of the listeners into a minimal set: a path is dropped if another path covers it, and only the
+ * first of several identical paths is kept.
+ */
+template <typename T, typename GetPaths>
+static esp_err_t merge_paths(const GetPaths &get_paths, size_t total, bool (*covers)(const T &, const T &),
+                             bool (*equal)(const T &, const T &), ScopedMemoryBufferWithSize<T> &merged)
+{
+    merged.Free();
+    if (total == 0) {
+        return ESP_OK;
+    }
+    ScopedMemoryBufferWithSize<T> all;
+    all.Alloc(total);
+    VerifyOrReturnError(all.Get(), ESP_ERR_NO_MEM);
+    size_t count = get_paths(all.Get());
+
+    ScopedMemoryBufferWithSize<bool> kept;
+    kept.Calloc(count);
+    VerifyOrReturnError(kept.Get(), ESP_ERR_NO_MEM);
+    size_t kept_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool covered = false;
+        for (size_t j = 0; j < count && !covered; ++j) {
+            if (i == j || !covers(all[j], all[i])) {
+                continue;
+            }
+            // Two identical paths cover each other, keep the first one.
+            covered = !equal(all[i], all[j]) || j < i;
+        }
+        kept[i] = !covered;
+        kept_count += kept[i] ? 1 : 0;
+    }
+
+    merged.Alloc(kept_count);
+    VerifyOrReturnError(merged.Get(), ESP_ERR_NO_MEM);
+    for (size_t i = 0, index = 0; i < count; ++i) {
+        if (kept[i]) {
+            merged[index++] = all[i];
+        }
+    }
+    return ESP_OK;
+}
+
+template <typename T>
+static bool same_paths(const ScopedMemoryBufferWithSize<T> &a, const ScopedMemoryBufferWithSize<T> &b,
+                       bool (*equal)(const T &, const T &))
+{
+    if (a.AllocatedSize() != b.AllocatedSize()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.AllocatedSize(); ++i) {
+        bool found = false;
+        for (size_t j = 0; j < b.AllocatedSize() && !found; ++j) {
+            found = equal(a[i], b[j]);
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+static esp_err_t copy_paths(const ScopedMemoryBufferWithSize<T> &src, ScopedMemoryBufferWithSize<T> &dst)
+{
+    dst.Free();
+    if (src.AllocatedSize() == 0) {
+        return ESP_OK;
+    }
+    dst.Alloc(src.AllocatedSize());
+    VerifyOrReturnError(dst.Get(), ESP_ERR_NO_MEM);
+    for (size_t i = 0; i < src.AllocatedSize(); ++i) {
+        dst[i] = src[i];
+    }
+    return ESP_OK;
+}
+
+subscription_manager::node_entry *subscription_manager::find_node(uint64_t node_id)
+{
+    node_entry *node = m_nodes;
+    while (node && node->node_id != node_id) {
+        node = node->next;
+    }
+    return node;
+}
+
+esp_err_t subscription_manager::send_subscription(node_entry *node)
+{
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+    ESP_RETURN_ON_ERROR(copy_paths(node->attr_paths, attr_paths), TAG, "Failed to alloc memory for attribute paths");
+    ESP_RETURN_ON_ERROR(copy_paths(node->event_paths, event_paths), TAG, "Failed to alloc memory for event paths");
+
+    subscribe_command *cmd = chip::Platform::New<subscribe_command>(
+        node->node_id, std::move(attr_paths), std::move(event_paths), node->min_interval, node->max_interval,
+        true /* auto_resubscribe */, on_attribute_report, on_event_report, on_subscription_done,
+        on_subscription_failure, true /* keep_subscription */);
+    if (!cmd) {
+        ESP_LOGE(TAG, "Failed to alloc memory for subscribe_command");
+        return ESP_ERR_NO_MEM;
+    }
+    cmd->set_subscribe_established_cb(on_subscription_established);
+    node->state = k_pending;
+    node->remerge_needed = false;
+    esp_err_t err = cmd->send_command();
+    if (err != ESP_OK) {
+        // The command has been deleted by send_command()
+        node->state = node->replaced_subscription_id ? k_active : k_idle;
+        node->subscription_id = node->replaced_subscription_id;
+        node->replaced_subscription_id = 0;
+    }
+    return err;
+}
+
+esp_err_t subscription_manager::remerge(node_entry *node)
+{
+    if (node->state == k_pending) {
+        // Re-merge once the pending subscription is established
+        node->remerge_needed = true;
+        return ESP_OK;
+    }
+
+    size_t attr_path_total = 0;
+    size_t event_path_total = 0;
+    uint16_t min_interval = UINT16_MAX;
+    uint16_t max_interval = UINT16_MAX;
+    for (listener *l = node->listeners; l; l = l->next) {
+        if (l->removed) {
+            continue;
+        }
+        attr_path_total += l->attr_paths.AllocatedSize();
+        event_path_total += l->event_paths.AllocatedSize();
+        min_interval = std::min(min_interval, l->min_interval);
+        max_interval = std::min(max_interval, l->max_interval);
+    }
+
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+    ESP_RETURN_ON_ERROR(merge_paths<AttributePathParams>(
+                            [node](AttributePathParams *out) {
+                                size_t n = 0;
+                                for (listener *l = node->listeners; l; l = l->next) {
+                                    for (size_t i = 0; !l->removed && i < l->attr_paths.AllocatedSize(); ++i) {
+                                        out[n++] = l->attr_paths[i];
+                                    }
+                                }
+                                return n;
+                            },
+                            attr_path_total, attr_path_covers, attr_path_equal, attr_paths),
+                        TAG, "Failed to merge attribute paths");
+    ESP_RETURN_ON_ERROR(merge_paths<EventPathParams>(
+                            [node](EventPathParams *out) {
+                                size_t n = 0;
+                                for (listener *l = node->listeners; l; l = l->next) {
+                                    for (size_t i = 0; !l->removed && i < l->event_paths.AllocatedSize(); ++i) {
+                                        out[n++] = l->event_paths[i];
+                                    }
+                                }
+                                return n;
+                            },
+                            event_path_total, event_path_covers, event_path_equal, event_paths),
+                        TAG, "Failed to merge event paths");
+
+    if (node->state == k_active && min_interval == node->min_interval && max_interval == node->max_interval &&
+        same_paths(attr_paths, node->attr_paths, attr_path_equal) &&
+        same_paths(event_paths, node->event_paths, event_path_equal)) {
+        // The current subscription already covers all the listeners
+        return ESP_OK;
+    }
+
+    node->attr_paths = std::move(attr_paths);
+    node->event_paths = std::move(event_paths);
+    node->min_interval = min_interval;
+    node->max_interval = max_interval;
+    node->replaced_subscription_id = node->state == k_active ? node->subscription_id : 0;
+    ESP_LOGI(TAG, "Subscribe to node 0x%" PRIx64 " with %u attribute paths and %u event paths", node->node_id,
+             (unsigned)node->attr_paths.AllocatedSize(), (unsigned)node->event_paths.AllocatedSize());
+    return send_subscription(node);
+}
+
+void subscription_manager::remove_node(node_entry *node)
+{
+    if (node->state == k_pending) {
+        // The subscribe command in flight keeps its subscription, which can only be shut down once its ID is known.
+        node->removed = true;
+        node->remerge_needed = false;
+        if (node->replaced_subscription_id) {
+            send_shutdown_subscription(node->node_id, node->replaced_subscription_id);
+            node->replaced_subscription_id = 0;
+        }
+        return;
+    }
+    node_entry **current = &m_nodes;
+    while (*current && *current != node) {
+        current = &(*current)->next;
+    }
+    if (*current) {
+        *current = node->next;
+    }
+    // Unlink the node before shutting down its subscriptions, so that the done callbacks find nothing to update.
+    if (node->subscription_id) {
+        send_shutdown_subscription(node->node_id, node->subscription_id);
+    }
+    if (node->replaced_subscription_id) {
+        send_shutdown_subscription(node->node_id, node->replaced_subscription_id);
+    }
+    chip::Platform::Delete(node);
+}
+
+esp_err_t subscription_manager::add_listener(uint64_t node_id,
+                                             ScopedMemoryBufferWithSize<AttributePathParams> &&attr_paths,
+                                             ScopedMemoryBufferWithSize<EventPathParams> &&event_paths,
+                                             uint16_t min_interval, uint16_t max_interval,
+                                             attribute_report_cb_t attribute_cb, event_report_cb_t event_cb,
+                                             uint32_t *listener_id)
+{
+    VerifyOrReturnError(listener_id && min_interval <= max_interval, ESP_ERR_INVALID_ARG);
+    VerifyOrReturnError(attr_paths.AllocatedSize() > 0 || event_paths.AllocatedSize() > 0, ESP_ERR_INVALID_ARG);
+    listener *l = chip::Platform::New<listener>();
+    VerifyOrReturnError(l, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Failed to alloc memory for listener"));
+    l->id = m_next_listener_id++;
+    l->min_interval = min_interval;
+    l->max_interval = max_interval;
+    l->attr_paths = std::move(attr_paths);
+    l->event_paths = std::move(event_paths);
+    l->attribute_cb = attribute_cb;
+    l->event_cb = event_cb;
+    l->removed = false;
+
+    node_entry *node = find_node(node_id);
+    if (!node) {
+        node = chip::Platform::New<node_entry>();
+        if (!node) {
+            chip::Platform::Delete(l);
+            ESP_LOGE(TAG, "Failed to alloc memory for node entry");
+            return ESP_ERR_NO_MEM;
+        }
+        node->node_id = node_id;
+        node->next = m_nodes;
+        m_nodes = node;
+    }
+    node->removed = false;
+    l->next = node->listeners;
+    node->listeners = l;
+    *listener_id = l->id;
+    return remerge(node);
+}
+
+esp_err_t subscription_manager::remove_listener(uint32_t listener_id)
+{
+    for (node_entry *node = m_nodes; node; node = node->next) {
+        for (listener **current = &node->listeners; *current; current = &(*current)->next) {
+            if ((*current)->id != listener_id || (*current)->removed) {
+                continue;
+            }
+            if (node->dispatching) {
+                // The listeners are being iterated, the listener is deleted once the report is dispatched
+                (*current)->removed = true;
+                return ESP_OK;
+            }
+            listener *removed = *current;
+            *current = removed->next;
+            chip::Platform::Delete(removed);
+            if (!node->listeners) {
+                remove_node(node);
+                return ESP_OK;
+            }
+            return remerge(node);
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t subscription_manager::refresh(uint64_t node_id)
+{
+    node_entry *node = find_node(node_id);
+    VerifyOrReturnError(node, ESP_ERR_NOT_FOUND);
+    if (node->state != k_idle) {
+        return ESP_OK;
+    }
+    return remerge(node);
+}
+
+size_t subscription_manager::get_subscription_count()
+{
+    size_t count = 0;
+    for (node_entry *node = m_nodes; node; node = node->next) {
+        count += node->state != k_idle ? 1 : 0;
+    }
+    return count;
+}
+
+void subscription_manager::dump()
+{
+    static const char *state_str[] = {"idle", "pending", "active"};
+    for (node_entry *node = m_nodes; node; node = node->next) {
+        size_t listener_count = 0;
+        for (listener *l = node->listeners; l; l = l->next) {
+            listener_count++;
+        }
+        ESP_LOGI(TAG,
+                 "Node 0x%" PRIx64 ": %s subscription 0x%" PRIx32 ", %u listeners, %u attribute paths, %u event "
+                 "paths, interval [%u, %u], reports received %" PRIu32 " dispatched %" PRIu32,
+                 node->node_id, state_str[node->state], node->subscription_id, (unsigned)listener_count,
+                 (unsigned)node->attr_paths.AllocatedSize(), (unsigned)node->event_paths.AllocatedSize(),
+                 node->min_interval, node->max_interval, node->reports_received, node->reports_dispatched);
+    }
+}
+
+void subscription_manager::end_dispatch(node_entry *node)
+{
+    node->dispatching = false;
+    bool changed = false;
+    for (listener **current = &node->listeners; *current;) {
+        if (!(*current)->removed) {
+            current = &(*current)->next;
+            continue;
+        }
+        listener *removed = *current;
+        *current = removed->next;
+        chip::Platform::Delete(removed);
+        changed = true;
+    }
+    if (!changed) {
+        return;
+    }
+    if (!node->listeners) {
+        remove_node(node);
+        return;
+    }
+    remerge(node);
+}
+
+void subscription_manager::on_attribute_report(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                                               chip::TLV::TLVReader *data)
+{
+    node_entry *node = get_instance().find_node(node_id);
+    VerifyOrReturn(node && data);
+    node->reports_received++;
+    AttributePathParams concrete(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    // The callbacks may add or remove listeners, the removed ones are only deleted by end_dispatch()
+    node->dispatching = true;
+    for (listener *l = node->listeners; l; l = l->next) {
+        if (!l->attribute_cb || l->removed) {
+            continue;
+        }
+        for (size_t i = 0; i < l->attr_paths.AllocatedSize(); ++i) {
+            if (attr_path_covers(l->attr_paths[i], concrete)) {
+                // Each listener gets its own reader so that it can consume the data independently.
+                chip::TLV::TLVReader reader;
+                reader.Init(*data);
+                l->attribute_cb(node_id, path, &reader);
+                node->reports_dispatched++;
+                break;
+            }
+        }
+    }
+    get_instance().end_dispatch(node);
+}
+
+void subscription_manager::on_event_report(uint64_t node_id, const chip::app::EventHeader &header,
+                                           chip::TLV::TLVReader *data)
+{
+    node_entry *node = get_instance().find_node(node_id);
+    VerifyOrReturn(node && data);
+    node->reports_received++;
+    EventPathParams concrete(header.mPath.mEndpointId, header.mPath.mClusterId, header.mPath.mEventId);
+    // The callbacks may add or remove listeners, the removed ones are only deleted by end_dispatch()
+    node->dispatching = true;
+    for (listener *l = node->listeners; l; l = l->next) {
+        if (!l->event_cb || l->removed) {
+            continue;
+        }
+        for (size_t i = 0; i < l->event_paths.AllocatedSize(); ++i) {
+            if (event_path_covers(l->event_paths[i], concrete)) {
+                chip::TLV::TLVReader reader;
+                reader.Init(*data);
+                l->event_cb(node_id, header, &reader);
+                node->reports_dispatched++;
+                break;
+            }
+        }
+    }
+    get_instance().end_dispatch(node);
+}
+
+void subscription_manager::on_subscription_established(uint64_t node_id, uint32_t subscription_id)
+{
+    subscription_manager &manager = get_instance();
+    node_entry *node = manager.find_node(node_id);
+    VerifyOrReturn(node);
+    if (node->state == k_pending && node->replaced_subscription_id) {
+        // Break the previous subscription only once the re-merged one is up.
+        uint32_t replaced = node->replaced_subscription_id;
+        node->replaced_subscription_id = 0;
+        send_shutdown_subscription(node_id, replaced);
+    }
+    node->state = k_active;
+    // A resubscription of an active subscription also gets a new subscription ID.
+    node->subscription_id = subscription_id;
+    if (node->removed) {
+        // All the listeners were removed while the subscription was being established
+        manager.remove_node(node);
+        return;
+    }
+    if (node->remerge_needed) {
+        node->remerge_needed = false;
+        manager.remerge(node);
+    }
+}
+
+void subscription_manager::on_subscription_done(uint64_t node_id, uint32_t subscription_id)
+{
+    subscription_manager &manager = get_instance();
+    node_entry *node = manager.find_node(node_id);
+    VerifyOrReturn(node);
+    if (subscription_id != 0 && subscription_id == node->replaced_subscription_id) {
+        node->replaced_subscription_id = 0;
+        return;
+    }
+    if (node->state == k_pending && subscription_id == 0) {
+        // The re-merged subscription failed before being established, keep the previous one if any.
+        node->subscription_id = node->replaced_subscription_id;
+        node->replaced_subscription_id = 0;
+        node->state = node->subscription_id ? k_active : k_idle;
+        if (node->removed) {
+            manager.remove_node(node);
+        }
+        return;
+    }
+    if (subscription_id == node->subscription_id) {
+        ESP_LOGW(TAG, "Subscription 0x%" PRIx32 " to node 0x%" PRIx64 " terminated", subscription_id, node_id);
+        node->subscription_id = 0;
+        node->state = k_idle;
+    }
+}
+
+void subscription_manager::on_subscription_failure(void *subscribe_cmd)
+{
+    subscribe_command *cmd = static_cast<subscribe_command *>(subscribe_cmd);
+    ESP_LOGE(TAG, "Failed to establish the subscription to node 0x%" PRIx64, cmd->get_node_id());
+    on_subscription_done(cmd->get_node_id(), 0);
+}
+
+} // namespace controller
+} // namespace esp_matter
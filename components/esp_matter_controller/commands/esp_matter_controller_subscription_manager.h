@@ -0,0 +1,154 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_controller_subscribe_command.h>
+#include <esp_matter_controller_utils.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Subscription manager sharing one subscription per node between several listeners
+ *
+ * Each listener registers the attribute/event paths it is interested in on a node. The manager merges the paths of
+ * all the listeners of a node into a minimal path set, dropping the paths covered by a wildcard path of another
+ * listener, and keeps a single subscription per node with the merged paths. The reports of that subscription are
+ * then dispatched to every listener whose paths match.
+ *
+ * When the merged path set or intervals change, the manager establishes the new subscription before shutting down
+ * the previous one, so the listeners keep receiving reports during the re-merge.
+ *
+ * @note A listener whose paths are already covered by the subscription of the node does not trigger a new
+ * subscription, so it only receives the reports sent after it has been added.
+ * @note All the APIs should be called in the Matter context.
+ */
+class subscription_manager {
+public:
+    static subscription_manager &get_instance()
+    {
+        static subscription_manager s_instance;
+        return s_instance;
+    }
+
+    /** Add a listener
+     *
+     * @param[in] node_id Remote NodeId
+     * @param[in] attr_paths Attribute paths of the listener, wildcards are allowed
+     * @param[in] event_paths Event paths of the listener, wildcards are allowed
+     * @param[in] min_interval Minimum interval the listener accepts between two reports
+     * @param[in] max_interval Maximum interval the listener accepts between two reports
+     * @param[in] attribute_cb Callback for the attribute reports matching the listener attribute paths
+     * @param[in] event_cb Callback for the event reports matching the listener event paths
+     * @param[out] listener_id ID of the listener, used to remove it
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure.
+     */
+    esp_err_t add_listener(uint64_t node_id, ScopedMemoryBufferWithSize<AttributePathParams> &&attr_paths,
+                           ScopedMemoryBufferWithSize<EventPathParams> &&event_paths, uint16_t min_interval,
+                           uint16_t max_interval, attribute_report_cb_t attribute_cb, event_report_cb_t event_cb,
+                           uint32_t *listener_id);
+
+    /** Remove a listener
+     *
+     * The subscription of the node is re-merged with the remaining listeners, or shut down if it was the last one.
+     *
+     * @param[in] listener_id ID returned by add_listener()
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FOUND if the listener does not exist.
+     */
+    esp_err_t remove_listener(uint32_t listener_id);
+
+    /** Subscribe again to a node whose subscription has been terminated
+     *
+     * @param[in] node_id Remote NodeId
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure.
+     */
+    esp_err_t refresh(uint64_t node_id);
+
+    /** Number of subscriptions established or being established by the manager */
+    size_t get_subscription_count();
+
+    /** Print the listeners and the merged subscription of each node */
+    void dump();
+
+private:
+    typedef enum {
+        k_idle = 0,
+        k_pending,
+        k_active,
+    } subscription_state_t;
+
+    struct listener {
+        uint32_t id;
+        uint16_t min_interval;
+        uint16_t max_interval;
+        ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+        ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+        attribute_report_cb_t attribute_cb;
+        event_report_cb_t event_cb;
+        // The listener was removed by a report callback, it is deleted once the report is dispatched
+        bool removed;
+        listener *next;
+    };
+
+    struct node_entry {
+        uint64_t node_id;
+        listener *listeners = nullptr;
+        subscription_state_t state = k_idle;
+        uint32_t subscription_id = 0;
+        // Subscription which is shut down once the re-merged subscription is established
+        uint32_t replaced_subscription_id = 0;
+        // The listeners changed while the subscription was being established
+        bool remerge_needed = false;
+        // The last listener was removed while the subscription was being established. The entry is kept so that
+        // the subscription is shut down once it is established, and deleted then or when it fails.
+        bool removed = false;
+        // A report is being dispatched to the listeners, which must not be deleted until it is done
+        bool dispatching = false;
+        uint16_t min_interval = 0;
+        uint16_t max_interval = 0;
+        ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+        ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+        uint32_t reports_received = 0;
+        uint32_t reports_dispatched = 0;
+        node_entry *next = nullptr;
+    };
+
+    subscription_manager() {}
+
+    node_entry *find_node(uint64_t node_id);
+    esp_err_t remerge(node_entry *node);
+    esp_err_t send_subscription(node_entry *node);
+    void remove_node(node_entry *node);
+    void end_dispatch(node_entry *node);
+
+    static void on_attribute_report(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                                    chip::TLV::TLVReader *data);
+    static void on_event_report(uint64_t node_id, const chip::app::EventHeader &header, chip::TLV::TLVReader *data);
+    static void on_subscription_established(uint64_t node_id, uint32_t subscription_id);
+    static void on_subscription_done(uint64_t node_id, uint32_t subscription_id);
+    static void on_subscription_failure(void *subscribe_cmd);
+
+    node_entry *m_nodes = nullptr;
+    uint32_t m_next_listener_id = 1;
+};
+
+} // namespace controller
+} // namespace esp_matter
@@ -45,10 +45,15 @@ void write_command::on_device_connected_fcn(void *context, ExchangeManager &exch
                                             const SessionHandle &sessionHandle)
 {
     write_command *cmd = (write_command *)context;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_node_id, cmd->m_start_ms, CHIP_NO_ERROR);
+    cmd->m_start_ms = node_stats::timestamp_ms();
+#endif
     chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
     esp_err_t err = interaction::write::send_request(&device_proxy, cmd->m_attr_paths, cmd->m_attr_vals,
                                                      cmd->m_chunked_callback, cmd->m_timed_write_timeout_ms);
     if (err != ESP_OK) {
+        cmd->m_error = CHIP_ERROR_INTERNAL;
         chip::Platform::Delete(cmd);
     }
 }
@@ -56,12 +61,22 @@ void write_command::on_device_connected_fcn(void *context, ExchangeManager &exch
 void write_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     write_command *cmd = (write_command *)context;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    node_stats::get_instance().record_session(cmd->m_node_id, cmd->m_start_ms, error);
+#endif
+    cmd->m_error = error;
     chip::Platform::Delete(cmd);
     return;
 }
 
 esp_err_t write_command::send_command()
 {
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    m_start_ms = node_stats::timestamp_ms();
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    m_batch_tag = batch_runner::get_instance().begin_interaction();
+#endif
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
     chip::Server &server = chip::Server::GetInstance();
     server.GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_node_id, get_fabric_index()),
@@ -83,6 +98,7 @@ esp_err_t write_command::send_command()
     }
 #endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+    m_error = CHIP_ERROR_INTERNAL;
     chip::Platform::Delete(this);
     return ESP_FAIL;
 }
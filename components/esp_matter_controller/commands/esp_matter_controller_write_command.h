@@ -18,6 +18,12 @@
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
 #include <esp_matter_mem.h>
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+#include <esp_matter_controller_node_stats.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
 
 namespace esp_matter {
 namespace controller {
@@ -74,7 +80,12 @@ public:
         }
     }
 
-    ~write_command() {}
+    ~write_command()
+    {
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+        batch_runner::get_instance().end_interaction(m_batch_tag, m_error);
+#endif
+    }
 
     esp_err_t send_command();
 
@@ -84,17 +95,27 @@ public:
         CHIP_ERROR error = status.ToChipError();
         if (CHIP_NO_ERROR != error) {
             ChipLogError(chipTool, "Response Failure: %s", chip::ErrorStr(error));
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+            node_stats::get_instance().record_status(m_node_id, status);
+#endif
+            if (m_error == CHIP_NO_ERROR) {
+                m_error = error;
+            }
         }
     }
 
     void OnError(const WriteClient *client, CHIP_ERROR error) override
     {
         ChipLogProgress(chipTool, "Error: %s", chip::ErrorStr(error));
+        m_error = error;
     }
 
     void OnDone(WriteClient *client) override
     {
         ChipLogProgress(chipTool, "Write Done");
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+        node_stats::get_instance().record_request(m_node_id, node_stats::REQUEST_WRITE, m_start_ms, m_error);
+#endif
         chip::Platform::Delete(this);
     }
 
@@ -104,6 +125,15 @@ private:
     ChunkedWriteCallback m_chunked_callback;
     multiple_write_encodable_type m_attr_vals;
     chip::Optional<uint16_t> m_timed_write_timeout_ms;
+    // First error of the interaction
+    CHIP_ERROR m_error = CHIP_NO_ERROR;
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+    // Start of the session lookup, then of the request
+    uint64_t m_start_ms = 0;
+#endif
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+    uint32_t m_batch_tag = 0;
+#endif
 
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
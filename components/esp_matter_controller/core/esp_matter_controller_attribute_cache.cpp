@@ -0,0 +1,486 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_controller_attribute_cache.h>
+
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <inttypes.h>
+#include <string.h>
+
+using chip::DataVersion;
+using chip::app::AttributePathParams;
+using chip::app::DataVersionFilterIBs;
+
+static const char *TAG = "attribute_cache";
+
+// The values larger than this are not cached, the readers of these attributes will always get them from the node.
+static constexpr size_t k_max_value_size = 512;
+// Bookkeeping accounted for each cached value in addition to its TLV encoding
+static constexpr size_t k_entry_overhead = 32;
+
+namespace esp_matter {
+namespace controller {
+
+static uint8_t s_value_buf[k_max_value_size];
+
+static size_t attribute_size(size_t tlv_len)
+{
+    return tlv_len + k_entry_overhead;
+}
+
+static CHIP_ERROR encode_data_version_filter(DataVersionFilterIBs::Builder &builder, uint16_t endpoint_id,
+                                             uint32_t cluster_id, DataVersion data_version)
+{
+    chip::app::DataVersionFilterIB::Builder &filter = builder.CreateDataVersionFilter();
+    ReturnErrorOnFailure(builder.GetError());
+    chip::app::ClusterPathIB::Builder &cluster_path = filter.CreatePath();
+    ReturnErrorOnFailure(filter.GetError());
+    ReturnErrorOnFailure(cluster_path.Endpoint(endpoint_id).Cluster(cluster_id).EndOfClusterPathIB());
+    return filter.DataVersion(data_version).EndOfDataVersionFilterIB();
+}
+
+attribute_cache::cached_cluster *attribute_cache::find_cluster(uint64_t node_id, uint16_t endpoint_id,
+                                                               uint32_t cluster_id)
+{
+    for (cached_cluster *cluster = m_clusters; cluster; cluster = cluster->next) {
+        if (cluster->node_id == node_id && cluster->endpoint_id == endpoint_id && cluster->cluster_id == cluster_id) {
+            return cluster;
+        }
+    }
+    return nullptr;
+}
+
+attribute_cache::cached_attribute *attribute_cache::find_attribute(cached_cluster *cluster, uint32_t attribute_id)
+{
+    for (cached_attribute *attribute = cluster->attributes; attribute; attribute = attribute->next) {
+        if (attribute->attribute_id == attribute_id) {
+            return attribute;
+        }
+    }
+    return nullptr;
+}
+
+void attribute_cache::remove_attribute(cached_cluster *cluster, cached_attribute *attribute)
+{
+    cached_attribute **current = &cluster->attributes;
+    while (*current && *current != attribute) {
+        current = &(*current)->next;
+    }
+    if (*current) {
+        *current = attribute->next;
+    }
+    m_stats.used_bytes -= attribute_size(attribute->tlv_len);
+    m_stats.attribute_count--;
+    chip::Platform::MemoryFree(attribute->tlv);
+    chip::Platform::Delete(attribute);
+}
+
+void attribute_cache::remove_cluster(cached_cluster *cluster)
+{
+    while (cluster->attributes) {
+        remove_attribute(cluster, cluster->attributes);
+    }
+    cached_cluster **current = &m_clusters;
+    while (*current && *current != cluster) {
+        current = &(*current)->next;
+    }
+    if (*current) {
+        *current = cluster->next;
+    }
+    chip::Platform::Delete(cluster);
+}
+
+bool attribute_cache::evict_one()
+{
+    cached_cluster *lru_cluster = nullptr;
+    cached_attribute *lru_attribute = nullptr;
+    for (cached_cluster *cluster = m_clusters; cluster; cluster = cluster->next) {
+        for (cached_attribute *attribute = cluster->attributes; attribute; attribute = attribute->next) {
+            // Compare the ages so that the counter wrap-around is handled
+            if (!lru_attribute ||
+                (uint32_t)(m_use_counter - attribute->last_used) > (uint32_t)(m_use_counter - lru_attribute->last_used)) {
+                lru_cluster = cluster;
+                lru_attribute = attribute;
+            }
+        }
+    }
+    if (lru_attribute) {
+        remove_attribute(lru_cluster, lru_attribute);
+        // The cluster can no longer answer a wildcard read. A cluster being reported is kept until the report end.
+        lru_cluster->complete = false;
+        if (lru_cluster->touched) {
+            lru_cluster->truncated = true;
+        } else if (!lru_cluster->attributes) {
+            remove_cluster(lru_cluster);
+        }
+        m_stats.evictions++;
+        return true;
+    }
+    if (m_events) {
+        cached_event *event = m_events;
+        m_events = event->next;
+        m_stats.used_bytes -= attribute_size(event->tlv_len);
+        chip::Platform::MemoryFree(event->tlv);
+        chip::Platform::Delete(event);
+        m_stats.evictions++;
+        return true;
+    }
+    return false;
+}
+
+bool attribute_cache::reserve(size_t size)
+{
+    if (size > CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_SIZE) {
+        return false;
+    }
+    while (m_stats.used_bytes + size > CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_SIZE) {
+        if (!evict_one()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint8_t *attribute_cache::copy_element(chip::TLV::TLVReader *data, uint16_t &tlv_len)
+{
+    chip::TLV::TLVReader reader;
+    reader.Init(*data);
+    chip::TLV::TLVWriter writer;
+    writer.Init(s_value_buf, sizeof(s_value_buf));
+    if (writer.CopyElement(chip::TLV::AnonymousTag(), reader) != CHIP_NO_ERROR || writer.Finalize() != CHIP_NO_ERROR) {
+        return nullptr;
+    }
+    tlv_len = static_cast<uint16_t>(writer.GetLengthWritten());
+    uint8_t *tlv = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(tlv_len));
+    if (tlv) {
+        memcpy(tlv, s_value_buf, tlv_len);
+    }
+    return tlv;
+}
+
+esp_err_t attribute_cache::update_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                                            chip::TLV::TLVReader *data)
+{
+    VerifyOrReturnError(data, ESP_ERR_INVALID_ARG);
+    cached_cluster *cluster = find_cluster(node_id, path.mEndpointId, path.mClusterId);
+    if (!cluster) {
+        cluster = chip::Platform::New<cached_cluster>();
+        VerifyOrReturnError(cluster, ESP_ERR_NO_MEM);
+        cluster->node_id = node_id;
+        cluster->endpoint_id = path.mEndpointId;
+        cluster->cluster_id = path.mClusterId;
+        cluster->data_version = 0;
+        cluster->report_version = 0;
+        cluster->complete = false;
+        cluster->truncated = false;
+        cluster->attributes = nullptr;
+        cluster->next = m_clusters;
+        m_clusters = cluster;
+    }
+    // The touched clusters are kept until the report end, even if all their attributes are evicted.
+    cluster->touched = true;
+    cached_attribute *attribute = find_attribute(cluster, path.mAttributeId);
+    if (attribute) {
+        remove_attribute(cluster, attribute);
+    }
+    // The BufferedReadCallback reassembles the chunked lists, so the list item operations are not expected here. The
+    // values without data version could not be used to filter the later reads.
+    if (path.IsListItemOperation() || !path.mDataVersion.HasValue()) {
+        cluster->truncated = true;
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    cluster->report_version = path.mDataVersion.Value();
+
+    uint16_t tlv_len = 0;
+    uint8_t *tlv = copy_element(data, tlv_len);
+    if (!tlv || !reserve(attribute_size(tlv_len))) {
+        ESP_LOGD(TAG, "Attribute 0x%" PRIx32 " of node 0x%" PRIx64 " is not cached", path.mAttributeId, node_id);
+        chip::Platform::MemoryFree(tlv);
+        cluster->truncated = true;
+        return ESP_ERR_NO_MEM;
+    }
+    attribute = chip::Platform::New<cached_attribute>();
+    if (!attribute) {
+        chip::Platform::MemoryFree(tlv);
+        cluster->truncated = true;
+        return ESP_ERR_NO_MEM;
+    }
+    attribute->attribute_id = path.mAttributeId;
+    attribute->data_version = path.mDataVersion.Value();
+    attribute->last_used = ++m_use_counter;
+    attribute->tlv_len = tlv_len;
+    attribute->tlv = tlv;
+    attribute->next = cluster->attributes;
+    cluster->attributes = attribute;
+    m_stats.used_bytes += attribute_size(tlv_len);
+    m_stats.attribute_count++;
+    return ESP_OK;
+}
+
+esp_err_t attribute_cache::update_event(uint64_t node_id, const chip::app::EventHeader &header,
+                                        chip::TLV::TLVReader *data)
+{
+    VerifyOrReturnError(data, ESP_ERR_INVALID_ARG);
+    cached_event **current = &m_events;
+    while (*current) {
+        cached_event *event = *current;
+        if (event->node_id == node_id && event->endpoint_id == header.mPath.mEndpointId &&
+            event->cluster_id == header.mPath.mClusterId && event->event_id == header.mPath.mEventId) {
+            if (event->event_number > header.mEventNumber) {
+                return ESP_OK;
+            }
+            *current = event->next;
+            m_stats.used_bytes -= attribute_size(event->tlv_len);
+            chip::Platform::MemoryFree(event->tlv);
+            chip::Platform::Delete(event);
+            break;
+        }
+        current = &event->next;
+    }
+
+    uint16_t tlv_len = 0;
+    uint8_t *tlv = copy_element(data, tlv_len);
+    if (!tlv || !reserve(attribute_size(tlv_len))) {
+        chip::Platform::MemoryFree(tlv);
+        return ESP_ERR_NO_MEM;
+    }
+    cached_event *event = chip::Platform::New<cached_event>();
+    if (!event) {
+        chip::Platform::MemoryFree(tlv);
+        return ESP_ERR_NO_MEM;
+    }
+    event->node_id = node_id;
+    event->endpoint_id = header.mPath.mEndpointId;
+    event->cluster_id = header.mPath.mClusterId;
+    event->event_id = header.mPath.mEventId;
+    event->event_number = header.mEventNumber;
+    event->tlv_len = tlv_len;
+    event->tlv = tlv;
+    // The events are evicted from the head of the list, append the newest event at the tail.
+    event->next = nullptr;
+    current = &m_events;
+    while (*current) {
+        current = &(*current)->next;
+    }
+    *current = event;
+    m_stats.used_bytes += attribute_size(tlv_len);
+    return ESP_OK;
+}
+
+void attribute_cache::on_report_end(uint64_t node_id, const AttributePathParams *attr_paths, size_t attr_path_count,
+                                    bool full_report)
+{
+    cached_cluster *cluster = m_clusters;
+    while (cluster) {
+        cached_cluster *next = cluster->next;
+        if (cluster->node_id != node_id || !cluster->touched) {
+            cluster = next;
+            continue;
+        }
+        bool wildcard_read = false;
+        for (size_t i = 0; i < attr_path_count && !wildcard_read; ++i) {
+            const AttributePathParams &path = attr_paths[i];
+            wildcard_read = path.HasWildcardAttributeId() &&
+                (path.HasWildcardEndpointId() || path.mEndpointId == cluster->endpoint_id) &&
+                (path.HasWildcardClusterId() || path.mClusterId == cluster->cluster_id);
+        }
+        // A subscription report only contains the changed attributes, so the cluster stays complete only if it was
+        // complete before the report.
+        if (wildcard_read && !cluster->truncated && (full_report || cluster->complete)) {
+            cluster->complete = true;
+            cluster->data_version = cluster->report_version;
+        } else {
+            cluster->complete = false;
+        }
+        cluster->touched = false;
+        cluster->truncated = false;
+        if (!cluster->attributes) {
+            remove_cluster(cluster);
+        }
+        cluster = next;
+    }
+}
+
+esp_err_t attribute_cache::get_attribute(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id,
+                                         uint32_t attribute_id, uint8_t *tlv_buf, size_t &tlv_len,
+                                         chip::Optional<DataVersion> *data_version)
+{
+    cached_cluster *cluster = find_cluster(node_id, endpoint_id, cluster_id);
+    cached_attribute *attribute = cluster ? find_attribute(cluster, attribute_id) : nullptr;
+    if (!attribute) {
+        m_stats.misses++;
+        return ESP_ERR_NOT_FOUND;
+    }
+    VerifyOrReturnError(tlv_buf && tlv_len >= attribute->tlv_len, ESP_ERR_INVALID_SIZE);
+    memcpy(tlv_buf, attribute->tlv, attribute->tlv_len);
+    tlv_len = attribute->tlv_len;
+    attribute->last_used = ++m_use_counter;
+    if (data_version) {
+        data_version->SetValue(cluster->complete ? cluster->data_version : attribute->data_version);
+    }
+    m_stats.hits++;
+    return ESP_OK;
+}
+
+esp_err_t attribute_cache::get_event(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t event_id,
+                                     uint8_t *tlv_buf, size_t &tlv_len, chip::EventNumber *event_number)
+{
+    for (cached_event *event = m_events; event; event = event->next) {
+        if (event->node_id == node_id && event->endpoint_id == endpoint_id && event->cluster_id == cluster_id &&
+            event->event_id == event_id) {
+            VerifyOrReturnError(tlv_buf && tlv_len >= event->tlv_len, ESP_ERR_INVALID_SIZE);
+            memcpy(tlv_buf, event->tlv, event->tlv_len);
+            tlv_len = event->tlv_len;
+            if (event_number) {
+                *event_number = event->event_number;
+            }
+            m_stats.hits++;
+            return ESP_OK;
+        }
+    }
+    m_stats.misses++;
+    return ESP_ERR_NOT_FOUND;
+}
+
+bool attribute_cache::is_cluster_satisfied(cached_cluster *cluster,
+                                           const chip::Span<AttributePathParams> &attr_paths,
+                                           DataVersion &data_version)
+{
+    bool covered = false;
+    bool has_version = cluster->complete;
+    data_version = cluster->data_version;
+    for (const AttributePathParams &path : attr_paths) {
+        if ((!path.HasWildcardEndpointId() && path.mEndpointId != cluster->endpoint_id) ||
+            (!path.HasWildcardClusterId() && path.mClusterId != cluster->cluster_id)) {
+            continue;
+        }
+        covered = true;
+        if (path.HasWildcardAttributeId()) {
+            if (!cluster->complete) {
+                return false;
+            }
+            continue;
+        }
+        cached_attribute *attribute = find_attribute(cluster, path.mAttributeId);
+        if (!attribute) {
+            return false;
+        }
+        // The attributes of a complete cluster are all valid at the data version of the cluster, otherwise they
+        // should have been reported at the same data version.
+        if (cluster->complete) {
+            continue;
+        }
+        if (has_version && attribute->data_version != data_version) {
+            return false;
+        }
+        has_version = true;
+        data_version = attribute->data_version;
+    }
+    return covered && has_version;
+}
+
+CHIP_ERROR attribute_cache::encode_data_version_filters(uint64_t node_id, DataVersionFilterIBs::Builder &builder,
+                                                        const chip::Span<AttributePathParams> &attr_paths,
+                                                        bool &encoded)
+{
+    encoded = false;
+    for (cached_cluster *cluster = m_clusters; cluster; cluster = cluster->next) {
+        DataVersion data_version;
+        if (cluster->node_id != node_id || !is_cluster_satisfied(cluster, attr_paths, data_version)) {
+            continue;
+        }
+        chip::TLV::TLVWriter backup;
+        builder.Checkpoint(backup);
+        CHIP_ERROR err = encode_data_version_filter(builder, cluster->endpoint_id, cluster->cluster_id, data_version);
+        if (err != CHIP_NO_ERROR) {
+            builder.Rollback(backup);
+            // The remaining clusters which do not fit in the request are read again.
+            if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL) {
+                return CHIP_NO_ERROR;
+            }
+            return err;
+        }
+        encoded = true;
+        m_stats.filters_encoded++;
+    }
+    return CHIP_NO_ERROR;
+}
+
+chip::Optional<chip::EventNumber> attribute_cache::get_highest_event_number(uint64_t node_id)
+{
+    chip::Optional<chip::EventNumber> highest;
+    for (cached_event *event = m_events; event; event = event->next) {
+        if (event->node_id == node_id && (!highest.HasValue() || event->event_number > highest.Value())) {
+            highest.SetValue(event->event_number);
+        }
+    }
+    return highest;
+}
+
+void attribute_cache::remove_node(uint64_t node_id)
+{
+    cached_cluster *cluster = m_clusters;
+    while (cluster) {
+        cached_cluster *next = cluster->next;
+        if (cluster->node_id == node_id) {
+            remove_cluster(cluster);
+        }
+        cluster = next;
+    }
+    cached_event **current = &m_events;
+    while (*current) {
+        cached_event *event = *current;
+        if (event->node_id == node_id) {
+            *current = event->next;
+            m_stats.used_bytes -= attribute_size(event->tlv_len);
+            chip::Platform::MemoryFree(event->tlv);
+            chip::Platform::Delete(event);
+        } else {
+            current = &event->next;
+        }
+    }
+}
+
+void attribute_cache::clear()
+{
+    while (m_clusters) {
+        remove_cluster(m_clusters);
+    }
+    while (m_events) {
+        cached_event *event = m_events;
+        m_events = event->next;
+        chip::Platform::MemoryFree(event->tlv);
+        chip::Platform::Delete(event);
+    }
+    m_stats = {};
+}
+
+void attribute_cache::get_stats(stats_t &stats)
+{
+    stats = m_stats;
+}
+
+esp_err_t get_cached_attribute(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                               uint8_t *tlv_buf, size_t &tlv_len)
+{
+    return attribute_cache::get_instance().get_attribute(node_id, endpoint_id, cluster_id, attribute_id, tlv_buf,
+                                                         tlv_len);
+}
+
+} // namespace controller
+} // namespace esp_matter
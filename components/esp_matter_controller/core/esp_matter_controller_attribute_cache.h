@@ -0,0 +1,183 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/EventHeader.h>
+#include <app/MessageDef/DataVersionFilterIBs.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/Span.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Local cache of the attribute values and events reported by the remote nodes
+ *
+ * The cache is populated by the read_command and the subscribe_command. It keeps the TLV encoded value of each
+ * reported attribute, the data version of each cluster and the latest event of each event path, within
+ * CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_SIZE bytes. The least recently used attributes are evicted first.
+ *
+ * The data versions are used to build the DataVersionFilters of the reads and subscriptions which enable them, so
+ * that the nodes skip the clusters whose values in the cache are still up to date.
+ *
+ * @note The cache is shared by all the commands, a cluster is only considered complete when it has been reported
+ * with a wildcard attribute path.
+ * @note All the APIs should be called in the Matter context or with the Matter stack lock.
+ */
+class attribute_cache {
+public:
+    typedef struct {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t filters_encoded;
+        size_t used_bytes;
+        size_t attribute_count;
+    } stats_t;
+
+    static attribute_cache &get_instance()
+    {
+        static attribute_cache s_instance;
+        return s_instance;
+    }
+
+    /** Store a reported attribute value, data points to the attribute data element */
+    esp_err_t update_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                               chip::TLV::TLVReader *data);
+
+    /** Store a reported event, only the latest event of each event path is kept */
+    esp_err_t update_event(uint64_t node_id, const chip::app::EventHeader &header, chip::TLV::TLVReader *data);
+
+    /** Commit the attributes stored since the previous report end
+     *
+     * The clusters read with a concrete wildcard-attribute path become complete in the cache, so that the later reads
+     * of these clusters can be filtered by data version.
+     *
+     * @param[in] node_id Remote NodeId
+     * @param[in] attr_paths Attribute paths of the read or subscription
+     * @param[in] attr_path_count Number of attribute paths
+     * @param[in] full_report Whether the report contains all the attributes of the paths (read or subscription
+     *                        priming report), or only the changed attributes (subscription report)
+     */
+    void on_report_end(uint64_t node_id, const chip::app::AttributePathParams *attr_paths, size_t attr_path_count,
+                       bool full_report);
+
+    /** Get the TLV encoded value of an attribute, the element has an anonymous tag
+     *
+     * @param[in] node_id Remote NodeId
+     * @param[in] endpoint_id EndpointId
+     * @param[in] cluster_id ClusterId
+     * @param[in] attribute_id AttributeId
+     * @param[out] tlv_buf Buffer receiving the TLV element
+     * @param[in,out] tlv_len Size of the buffer as input, length of the TLV element as output
+     * @param[out] data_version (Optional) Data version of the cluster when the attribute was reported
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FOUND if the attribute is not in the cache.
+     * @return ESP_ERR_INVALID_SIZE if the buffer is too small.
+     */
+    esp_err_t get_attribute(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                            uint8_t *tlv_buf, size_t &tlv_len, chip::Optional<chip::DataVersion> *data_version = nullptr);
+
+    /** Get the TLV encoded data of the latest event reported on an event path */
+    esp_err_t get_event(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t event_id,
+                        uint8_t *tlv_buf, size_t &tlv_len, chip::EventNumber *event_number = nullptr);
+
+    /** Encode the DataVersionFilters of the cached clusters for a read or subscribe request to a node
+     *
+     * A cluster is only filtered if every requested path covering it can be answered from the cache with the same
+     * data version. The attributes of the filtered clusters are not reported again and should be read from the cache.
+     */
+    CHIP_ERROR encode_data_version_filters(uint64_t node_id, chip::app::DataVersionFilterIBs::Builder &builder,
+                                           const chip::Span<chip::app::AttributePathParams> &attr_paths,
+                                           bool &encoded);
+
+    /** Highest event number received from a node, used to avoid receiving the same events again on resubscription */
+    chip::Optional<chip::EventNumber> get_highest_event_number(uint64_t node_id);
+
+    /** Remove all the cached data of a node */
+    void remove_node(uint64_t node_id);
+
+    /** Remove all the cached data */
+    void clear();
+
+    void get_stats(stats_t &stats);
+
+private:
+    struct cached_attribute {
+        uint32_t attribute_id;
+        chip::DataVersion data_version;
+        uint32_t last_used;
+        uint16_t tlv_len;
+        uint8_t *tlv;
+        cached_attribute *next;
+    };
+
+    struct cached_cluster {
+        uint64_t node_id;
+        uint16_t endpoint_id;
+        uint32_t cluster_id;
+        // Data version at which all the attributes of the cluster are in the cache, only valid if complete
+        chip::DataVersion data_version;
+        chip::DataVersion report_version;
+        bool complete;
+        // Attributes of the cluster have been updated since the previous report end
+        bool touched;
+        // An attribute of the cluster was too large to be cached
+        bool truncated;
+        cached_attribute *attributes;
+        cached_cluster *next;
+    };
+
+    struct cached_event {
+        uint64_t node_id;
+        uint16_t endpoint_id;
+        uint32_t cluster_id;
+        uint32_t event_id;
+        chip::EventNumber event_number;
+        uint16_t tlv_len;
+        uint8_t *tlv;
+        cached_event *next;
+    };
+
+    attribute_cache() {}
+
+    cached_cluster *find_cluster(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id);
+    cached_attribute *find_attribute(cached_cluster *cluster, uint32_t attribute_id);
+    void remove_attribute(cached_cluster *cluster, cached_attribute *attribute);
+    void remove_cluster(cached_cluster *cluster);
+    bool evict_one();
+    bool reserve(size_t size);
+    uint8_t *copy_element(chip::TLV::TLVReader *data, uint16_t &tlv_len);
+    bool is_cluster_satisfied(cached_cluster *cluster, const chip::Span<chip::app::AttributePathParams> &attr_paths,
+                              chip::DataVersion &data_version);
+
+    cached_cluster *m_clusters = nullptr;
+    cached_event *m_events = nullptr;
+    uint32_t m_use_counter = 0;
+    stats_t m_stats = {};
+};
+
+/** Get the TLV encoded value of a cached attribute, see attribute_cache::get_attribute() */
+esp_err_t get_cached_attribute(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                               uint8_t *tlv_buf, size_t &tlv_len);
+
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,798 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <ctype.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_batch_runner.h>
+#include <esp_matter_controller_utils.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+#include <esp_matter_controller_client.h>
+#endif
+
+#include <lib/support/CHIPMem.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+
+static const char *TAG = "batch_runner";
+
+// Interval of the checks of the commissioning before a pairing line is started
+static constexpr uint32_t k_pairing_poll_ms = 100;
+
+namespace esp_matter {
+namespace controller {
+
+static uint64_t now_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+static const char *skip_spaces(const char *str)
+{
+    while (*str == ' ' || *str == '\t') {
+        str++;
+    }
+    return str;
+}
+
+static bool word_equals(const char *str, const char *word)
+{
+    size_t len = strlen(word);
+    return strncmp(str, word, len) == 0 && (str[len] == '\0' || str[len] == ' ' || str[len] == '\t');
+}
+
+static bool is_name_char(char c)
+{
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+/** Split a line in place in arguments, the quotes group words and the backslash escapes the next character */
+static int tokenize(char *line, char **argv, size_t max_args)
+{
+    int argc = 0;
+    char *src = line;
+    while (true) {
+        src = (char *)skip_spaces(src);
+        if (*src == '\0') {
+            break;
+        }
+        if ((size_t)argc >= max_args) {
+            return -1;
+        }
+        char *dst = src;
+        argv[argc++] = dst;
+        bool quoted = false;
+        while (*src != '\0' && (quoted || (*src != ' ' && *src != '\t'))) {
+            if (*src == '"') {
+                quoted = !quoted;
+                src++;
+            } else if (*src == '\\' && src[1] != '\0') {
+                *dst++ = src[1];
+                src += 2;
+            } else {
+                *dst++ = *src++;
+            }
+        }
+        bool end = *src == '\0';
+        *dst = '\0';
+        if (end) {
+            break;
+        }
+        src++;
+    }
+    return argc;
+}
+
+static esp_err_t parse_uint64(char *str, uint64_t &value)
+{
+    const char *digits = strncmp(str, "0x", 2) == 0 ? str + 2 : str;
+    ESP_RETURN_ON_FALSE(*digits != '\0', ESP_ERR_INVALID_ARG, TAG, "Invalid number %s", str);
+    for (const char *c = digits; *c; ++c) {
+        ESP_RETURN_ON_FALSE(digits == str ? isdigit((unsigned char)*c) : isxdigit((unsigned char)*c),
+                            ESP_ERR_INVALID_ARG, TAG, "Invalid number %s", str);
+    }
+    value = string_to_uint64(str);
+    return ESP_OK;
+}
+
+esp_err_t batch_runner::load_buffer(const char *script, size_t len)
+{
+    ESP_RETURN_ON_FALSE(!m_running, ESP_ERR_INVALID_STATE, TAG, "A script is running");
+    ESP_RETURN_ON_FALSE(script, ESP_ERR_INVALID_ARG, TAG, "script cannot be NULL");
+    clear();
+    while (len > 0) {
+        const char *newline = (const char *)memchr(script, '\n', len);
+        size_t line_len = newline ? newline - script : len;
+        char line[k_max_line_len];
+        ESP_RETURN_ON_FALSE(line_len < sizeof(line), ESP_ERR_INVALID_SIZE, TAG, "Line too long");
+        memcpy(line, script, line_len);
+        line[line_len] = '\0';
+        ESP_RETURN_ON_ERROR(append_line(line), TAG, "Failed to load the script");
+        if (!newline) {
+            break;
+        }
+        len -= line_len + 1;
+        script = newline + 1;
+    }
+    return ESP_OK;
+}
+
+esp_err_t batch_runner::load_file(const char *path)
+{
+    ESP_RETURN_ON_FALSE(!m_running, ESP_ERR_INVALID_STATE, TAG, "A script is running");
+    ESP_RETURN_ON_FALSE(path, ESP_ERR_INVALID_ARG, TAG, "path cannot be NULL");
+    FILE *file = fopen(path, "r");
+    ESP_RETURN_ON_FALSE(file, ESP_ERR_NOT_FOUND, TAG, "Failed to open %s", path);
+    clear();
+    esp_err_t err = ESP_OK;
+    while (fgets(m_line, sizeof(m_line), file)) {
+        size_t len = strlen(m_line);
+        if (len > 0 && m_line[len - 1] == '\n') {
+            m_line[len - 1] = '\0';
+        } else if (!feof(file)) {
+            ESP_LOGE(TAG, "Line too long in %s", path);
+            err = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        err = append_line(m_line);
+        if (err != ESP_OK) {
+            break;
+        }
+    }
+    fclose(file);
+    if (err != ESP_OK) {
+        clear();
+    }
+    return err;
+}
+
+esp_err_t batch_runner::append_line(const char *line)
+{
+    ESP_RETURN_ON_FALSE(!m_running, ESP_ERR_INVALID_STATE, TAG, "A script is running");
+    ESP_RETURN_ON_FALSE(line, ESP_ERR_INVALID_ARG, TAG, "line cannot be NULL");
+    size_t len = strlen(line);
+    // The lines are stored with their terminating NUL character
+    size_t needed = m_script_len + len + 1;
+    ESP_RETURN_ON_FALSE(needed <= CONFIG_ESP_MATTER_CONTROLLER_BATCH_MAX_SCRIPT_SIZE, ESP_ERR_NO_MEM, TAG,
+                        "The script exceeds %d bytes", CONFIG_ESP_MATTER_CONTROLLER_BATCH_MAX_SCRIPT_SIZE);
+    if (needed > m_script_size) {
+        size_t new_size = std::min<size_t>(std::max<size_t>(needed, m_script_size * 2),
+                                           CONFIG_ESP_MATTER_CONTROLLER_BATCH_MAX_SCRIPT_SIZE);
+        char *script = (char *)chip::Platform::MemoryRealloc(m_script, new_size);
+        ESP_RETURN_ON_FALSE(script, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the script");
+        m_script = script;
+        m_script_size = new_size;
+    }
+    memcpy(m_script + m_script_len, line, len + 1);
+    // Keep the CRLF line endings out of the last argument
+    for (char *c = m_script + m_script_len; *c; ++c) {
+        if (*c == '\r') {
+            *c = ' ';
+        }
+    }
+    m_script_len = needed;
+    m_parsed = false;
+    return ESP_OK;
+}
+
+void batch_runner::clear()
+{
+    if (m_running) {
+        return;
+    }
+    chip::Platform::MemoryFree(m_script);
+    chip::Platform::MemoryFree(m_steps);
+    m_script = nullptr;
+    m_steps = nullptr;
+    m_script_len = 0;
+    m_script_size = 0;
+    m_step_count = 0;
+    m_parsed = false;
+}
+
+batch_runner::step_kind_t batch_runner::classify(const char *line)
+{
+    if (*line == '\0' || *line == '#') {
+        return STEP_NONE;
+    } else if (word_equals(line, "set")) {
+        return STEP_SET;
+    } else if (word_equals(line, "foreach")) {
+        return STEP_FOREACH;
+    } else if (word_equals(line, "end")) {
+        return STEP_END;
+    } else if (word_equals(line, "sleep")) {
+        return STEP_SLEEP;
+    }
+    return STEP_COMMAND;
+}
+
+esp_err_t batch_runner::parse()
+{
+    size_t line_count = 0;
+    for (size_t offset = 0; offset < m_script_len; offset += strlen(m_script + offset) + 1) {
+        line_count++;
+    }
+    chip::Platform::MemoryFree(m_steps);
+    m_step_count = 0;
+    m_steps = (step_t *)chip::Platform::MemoryCalloc(std::max<size_t>(line_count, 1), sizeof(step_t));
+    ESP_RETURN_ON_FALSE(m_steps, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the steps");
+
+    uint16_t open_loops[k_max_loop_depth];
+    size_t depth = 0;
+    uint16_t line_no = 0;
+    for (size_t offset = 0; offset < m_script_len; offset += strlen(m_script + offset) + 1) {
+        line_no++;
+        const char *line = skip_spaces(m_script + offset);
+        step_kind_t kind = classify(line);
+        if (kind == STEP_NONE) {
+            continue;
+        }
+        ESP_RETURN_ON_FALSE(m_step_count < UINT16_MAX, ESP_ERR_INVALID_SIZE, TAG, "Too many lines");
+        uint16_t index = m_step_count++;
+        step_t &step = m_steps[index];
+        step.offset = line - m_script;
+        step.line_no = line_no;
+        step.kind = kind;
+        if (kind == STEP_FOREACH) {
+            ESP_RETURN_ON_FALSE(depth < k_max_loop_depth, ESP_ERR_INVALID_ARG, TAG,
+                                "Line %u: more than %u nested foreach", line_no, (unsigned)k_max_loop_depth);
+            open_loops[depth++] = index;
+        } else if (kind == STEP_END) {
+            ESP_RETURN_ON_FALSE(depth > 0, ESP_ERR_INVALID_ARG, TAG, "Line %u: end without foreach", line_no);
+            uint16_t loop = open_loops[--depth];
+            m_steps[loop].match = index;
+            step.match = loop;
+        }
+    }
+    ESP_RETURN_ON_FALSE(depth == 0, ESP_ERR_INVALID_ARG, TAG, "Line %u: foreach without end",
+                        m_steps[open_loops[depth - 1]].line_no);
+    m_parsed = true;
+    return ESP_OK;
+}
+
+esp_err_t batch_runner::start(command_exec_t exec, done_cb_t done_cb, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(exec, ESP_ERR_INVALID_ARG, TAG, "exec cannot be NULL");
+    ESP_RETURN_ON_FALSE(!m_running, ESP_ERR_INVALID_STATE, TAG, "A script is running");
+    ESP_RETURN_ON_FALSE(m_script_len > 0, ESP_ERR_INVALID_STATE, TAG, "No script is loaded");
+    if (!m_parsed) {
+        esp_err_t err = parse();
+        if (err != ESP_OK) {
+            m_parsed = false;
+            return err;
+        }
+    }
+    for (size_t i = 0; i < m_step_count; ++i) {
+        m_steps[i].executed = 0;
+        m_steps[i].failed = 0;
+        m_steps[i].max_ms = 0;
+        m_steps[i].total_ms = 0;
+    }
+    for (lane_t &lane : m_lanes) {
+        lane = {};
+    }
+    for (var_t &var : m_vars) {
+        var = {};
+    }
+    m_lanes[0].state = LANE_READY;
+    m_lanes[0].end_pc = m_step_count;
+    m_remaining = 0;
+    m_exec = exec;
+    m_done_cb = done_cb;
+    m_done_ctx = ctx;
+    m_run_id++;
+    m_executed = 0;
+    m_failed = 0;
+    m_start_ms = now_ms();
+    m_running = true;
+    ESP_LOGI(TAG, "Start the script, %u lines", (unsigned)m_step_count);
+    schedule_pump();
+    return ESP_OK;
+}
+
+void batch_runner::stop()
+{
+    if (m_running) {
+        finish("stopped");
+    }
+}
+
+void batch_runner::finish(const char *reason)
+{
+    m_running = false;
+    m_end_ms = now_ms();
+    chip::DeviceLayer::SystemLayer().CancelTimer(timer_cb, this);
+    for (lane_t &lane : m_lanes) {
+        lane.state = LANE_FREE;
+    }
+    uint32_t elapsed_ms = m_end_ms - m_start_ms;
+    ESP_LOGI(TAG, "Script %s: %" PRIu32 " lines executed, %" PRIu32 " failed, in %" PRIu32 " ms", reason,
+             m_executed, m_failed, elapsed_ms);
+    if (m_done_cb) {
+        m_done_cb(m_executed, m_failed, m_done_ctx);
+    }
+}
+
+void batch_runner::schedule_pump()
+{
+    if (m_pump_scheduled) {
+        return;
+    }
+    // The lines are executed in their own work item, outside of the callbacks of the completed interactions
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(pump_work, reinterpret_cast<intptr_t>(this)) ==
+        CHIP_NO_ERROR) {
+        m_pump_scheduled = true;
+    }
+}
+
+void batch_runner::pump_work(intptr_t ctx)
+{
+    batch_runner *runner = reinterpret_cast<batch_runner *>(ctx);
+    runner->m_pump_scheduled = false;
+    runner->pump();
+}
+
+void batch_runner::timer_cb(chip::System::Layer *layer, void *ctx)
+{
+    reinterpret_cast<batch_runner *>(ctx)->pump();
+}
+
+void batch_runner::pump()
+{
+    if (!m_running) {
+        return;
+    }
+    uint64_t now = now_ms();
+    for (size_t i = 0; i < sizeof(m_lanes) / sizeof(m_lanes[0]) && m_running; ++i) {
+        lane_t &lane = m_lanes[i];
+        if (lane.state == LANE_SLEEPING && lane.wake_ms <= now) {
+            lane.state = LANE_READY;
+        } else if (lane.state == LANE_PAIRING && !pairing_in_progress()) {
+            // The commissioning ended without reporting its result to the runner
+            complete_step(i, lane.error);
+        } else if ((lane.state == LANE_PENDING || lane.state == LANE_PAIRING) &&
+                   now - lane.step_start_ms >= CONFIG_ESP_MATTER_CONTROLLER_BATCH_STEP_TIMEOUT_MS) {
+            complete_step(i, CHIP_ERROR_TIMEOUT);
+        }
+        if (lane.state == LANE_READY) {
+            run_lane(i);
+        }
+        if (i == 0 && lane.state == LANE_JOINING) {
+            spawn_iterations(0);
+        }
+    }
+    if (!m_running) {
+        return;
+    }
+    if (m_lanes[0].state == LANE_FREE) {
+        finish("done");
+        return;
+    }
+    schedule_timer();
+}
+
+void batch_runner::schedule_timer()
+{
+    uint64_t now = now_ms();
+    uint64_t next_ms = UINT64_MAX;
+    for (lane_t &lane : m_lanes) {
+        if (lane.state == LANE_SLEEPING) {
+            next_ms = std::min(next_ms, lane.wake_ms);
+        } else if (lane.state == LANE_PENDING || lane.state == LANE_PAIRING) {
+            next_ms = std::min<uint64_t>(next_ms,
+                                         lane.step_start_ms + CONFIG_ESP_MATTER_CONTROLLER_BATCH_STEP_TIMEOUT_MS);
+            if (lane.state == LANE_PAIRING) {
+                next_ms = std::min<uint64_t>(next_ms, now + k_pairing_poll_ms);
+            }
+        }
+    }
+    chip::System::Layer &system_layer = chip::DeviceLayer::SystemLayer();
+    system_layer.CancelTimer(timer_cb, this);
+    if (next_ms != UINT64_MAX) {
+        uint32_t delay_ms = next_ms > now ? next_ms - now : 0;
+        system_layer.StartTimer(chip::System::Clock::Milliseconds32(delay_ms), timer_cb, this);
+    }
+}
+
+void batch_runner::run_lane(size_t lane_index)
+{
+    lane_t &lane = m_lanes[lane_index];
+    while (m_running && lane.state == LANE_READY) {
+        if (lane.pc >= lane.end_pc) {
+            lane.state = LANE_FREE;
+            if (lane_index != 0) {
+                // Start the next iteration, or resume the main lane
+                schedule_pump();
+            }
+            break;
+        }
+        exec_step(lane_index);
+    }
+}
+
+void batch_runner::exec_step(size_t lane_index)
+{
+    lane_t &lane = m_lanes[lane_index];
+    step_t &step = m_steps[lane.pc];
+    if (step.kind == STEP_END) {
+        exec_end(lane_index);
+        return;
+    }
+    if (substitute(lane, step_text(lane.pc), m_line, sizeof(m_line)) != ESP_OK) {
+        ESP_LOGE(TAG, "Line %u: failed to substitute the variables", step.line_no);
+        finish("failed");
+        return;
+    }
+    if (step.kind == STEP_FOREACH) {
+        exec_foreach(lane_index);
+        return;
+    }
+    if (step.kind == STEP_SET) {
+        char *name = (char *)skip_spaces(m_line + strlen("set"));
+        char *value = name;
+        while (*value && *value != ' ' && *value != '\t') {
+            value++;
+        }
+        if (*value) {
+            *value++ = '\0';
+        }
+        if (set_var(name, skip_spaces(value)) != ESP_OK) {
+            ESP_LOGE(TAG, "Line %u: failed to set the variable", step.line_no);
+            finish("failed");
+            return;
+        }
+        lane.pc++;
+        return;
+    }
+    if (step.kind == STEP_SLEEP) {
+        uint64_t sleep_ms = 0;
+        char *arg = (char *)skip_spaces(m_line + strlen("sleep"));
+        if (parse_uint64(arg, sleep_ms) != ESP_OK) {
+            ESP_LOGE(TAG, "Line %u: invalid sleep duration", step.line_no);
+            finish("failed");
+            return;
+        }
+        lane.wake_ms = now_ms() + sleep_ms;
+        lane.state = LANE_SLEEPING;
+        lane.pc++;
+        return;
+    }
+
+    char *argv[k_max_args];
+    strlcpy(lane.summary, m_line, sizeof(lane.summary));
+    int argc = tokenize(m_line, argv, k_max_args);
+    if (argc <= 0) {
+        ESP_LOGE(TAG, "Line %u: invalid command", step.line_no);
+        lane.step_start_ms = now_ms();
+        complete_step(lane_index, CHIP_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    bool is_pairing = strcmp(argv[0], "pairing") == 0;
+    if (is_pairing && pairing_in_progress()) {
+        // Only one commissioning can run at a time, retry the line later
+        lane.wake_ms = now_ms() + k_pairing_poll_ms;
+        lane.state = LANE_SLEEPING;
+        return;
+    }
+    lane.seq++;
+    lane.pending = 0;
+    lane.error = CHIP_NO_ERROR;
+    lane.step_start_ms = now_ms();
+    m_current_lane = lane_index;
+    esp_err_t err = m_exec(argc, argv);
+    m_current_lane = -1;
+    if (err != ESP_OK) {
+        complete_step(lane_index, CHIP_ERROR(chip::ChipError::Range::kPlatform, err));
+    } else if (is_pairing && pairing_in_progress()) {
+        lane.state = LANE_PAIRING;
+    } else if (lane.pending > 0) {
+        lane.state = LANE_PENDING;
+    } else {
+        complete_step(lane_index, lane.error);
+    }
+}
+
+void batch_runner::exec_foreach(size_t lane_index)
+{
+    lane_t &lane = m_lanes[lane_index];
+    step_t &step = m_steps[lane.pc];
+    char *argv[k_max_args];
+    int argc = tokenize(m_line, argv, k_max_args);
+    loop_t loop = {};
+    uint64_t parallel = 1;
+    bool valid = (argc == 4 || argc == 5 || argc == 6 || argc == 7) && strlen(argv[1]) < sizeof(loop.name) &&
+        parse_uint64(argv[2], loop.value) == ESP_OK && parse_uint64(argv[3], loop.last) == ESP_OK;
+    loop.increment = 1;
+    if (valid && (argc == 5 || argc == 7)) {
+        valid = parse_uint64(argv[4], loop.increment) == ESP_OK && loop.increment > 0;
+    }
+    if (valid && argc >= 6) {
+        valid = strcmp(argv[argc - 2], "parallel") == 0 && parse_uint64(argv[argc - 1], parallel) == ESP_OK &&
+            parallel > 0;
+    }
+    if (!valid) {
+        ESP_LOGE(TAG, "Line %u: usage: foreach <name> <first> <last> [<step>] [parallel <n>]", step.line_no);
+        finish("failed");
+        return;
+    }
+    strlcpy(loop.name, argv[1], sizeof(loop.name));
+    loop.step = lane.pc;
+    loop.hex = strncmp(argv[2], "0x", 2) == 0;
+    if (loop.value > loop.last) {
+        lane.pc = step.match + 1;
+        return;
+    }
+    // The iterations of a nested parallel foreach run one after the other in the lane of their parent iteration
+    if (parallel > 1 && lane_index == 0) {
+        m_parallel_loop = loop;
+        m_next_value = loop.value;
+        m_remaining = (loop.last - loop.value) / loop.increment + 1;
+        m_max_parallel = std::min<uint64_t>(parallel, CONFIG_ESP_MATTER_CONTROLLER_BATCH_MAX_LANES);
+        lane.state = LANE_JOINING;
+        spawn_iterations(lane_index);
+        return;
+    }
+    lane.loops[lane.loop_depth++] = loop;
+    lane.pc++;
+}
+
+void batch_runner::exec_end(size_t lane_index)
+{
+    lane_t &lane = m_lanes[lane_index];
+    loop_t &loop = lane.loops[lane.loop_depth - 1];
+    if (loop.last - loop.value < loop.increment) {
+        lane.loop_depth--;
+        lane.pc++;
+        return;
+    }
+    loop.value += loop.increment;
+    lane.pc = loop.step + 1;
+}
+
+void batch_runner::spawn_iterations(size_t lane_index)
+{
+    lane_t &parent = m_lanes[lane_index];
+    size_t active = 0;
+    for (size_t i = 1; i < sizeof(m_lanes) / sizeof(m_lanes[0]); ++i) {
+        if (m_lanes[i].state != LANE_FREE) {
+            active++;
+        }
+    }
+    for (size_t i = 1;
+         i < sizeof(m_lanes) / sizeof(m_lanes[0]) && m_running && m_remaining > 0 && active < m_max_parallel; ++i) {
+        lane_t &lane = m_lanes[i];
+        if (lane.state != LANE_FREE) {
+            continue;
+        }
+        uint16_t seq = lane.seq;
+        lane = {};
+        // Keep the sequence number so that the late completions of the previous iteration are ignored
+        lane.seq = seq + 1;
+        lane.state = LANE_READY;
+        lane.pc = m_parallel_loop.step + 1;
+        lane.end_pc = m_steps[m_parallel_loop.step].match;
+        // The iteration sees the loop variables of its parent
+        memcpy(lane.loops, parent.loops, sizeof(lane.loops));
+        lane.loop_depth = parent.loop_depth;
+        lane.loops[lane.loop_depth] = m_parallel_loop;
+        lane.loops[lane.loop_depth].value = m_next_value;
+        lane.loop_depth++;
+        m_remaining--;
+        if (m_remaining > 0) {
+            m_next_value += m_parallel_loop.increment;
+        }
+        active++;
+        run_lane(i);
+        if (lane.state == LANE_FREE) {
+            active--;
+        }
+    }
+    if (m_remaining == 0 && active == 0 && m_running) {
+        parent.pc = m_steps[m_parallel_loop.step].match + 1;
+        parent.state = LANE_READY;
+        schedule_pump();
+    }
+}
+
+void batch_runner::complete_step(size_t lane_index, CHIP_ERROR error)
+{
+    lane_t &lane = m_lanes[lane_index];
+    step_t &step = m_steps[lane.pc];
+    uint32_t elapsed_ms = now_ms() - lane.step_start_ms;
+    step.executed++;
+    step.total_ms += elapsed_ms;
+    step.max_ms = std::max(step.max_ms, elapsed_ms);
+    m_executed++;
+    if (error == CHIP_NO_ERROR) {
+        ESP_LOGI(TAG, "Line %u: %s: done in %" PRIu32 " ms", step.line_no, lane.summary, elapsed_ms);
+    } else {
+        step.failed++;
+        m_failed++;
+        ESP_LOGE(TAG, "Line %u: %s: failed in %" PRIu32 " ms: %" CHIP_ERROR_FORMAT, step.line_no, lane.summary,
+                 elapsed_ms, error.Format());
+    }
+    // The interactions of the line which complete later are ignored
+    lane.seq++;
+    lane.pending = 0;
+    lane.pc++;
+    lane.state = LANE_READY;
+    schedule_pump();
+}
+
+uint32_t batch_runner::begin_interaction()
+{
+    if (!m_running || m_current_lane < 0) {
+        return 0;
+    }
+    lane_t &lane = m_lanes[m_current_lane];
+    lane.pending++;
+    return ((uint32_t)m_run_id << 24) | ((uint32_t)lane.seq << 8) | (uint32_t)(m_current_lane + 1);
+}
+
+void batch_runner::end_interaction(uint32_t tag, CHIP_ERROR error)
+{
+    size_t lane_index = (tag & 0xFF) - 1;
+    if (tag == 0 || !m_running || (tag >> 24) != m_run_id || lane_index >= sizeof(m_lanes) / sizeof(m_lanes[0])) {
+        return;
+    }
+    lane_t &lane = m_lanes[lane_index];
+    if (((tag >> 8) & 0xFFFF) != lane.seq || lane.pending == 0) {
+        return;
+    }
+    if (lane.error == CHIP_NO_ERROR) {
+        lane.error = error;
+    }
+    lane.pending--;
+    // A lane which is still executing the line checks its pending interactions when the command returns
+    if (lane.pending == 0 && lane.state == LANE_PENDING) {
+        complete_step(lane_index, lane.error);
+    }
+}
+
+void batch_runner::end_commissioning(CHIP_ERROR error)
+{
+    for (size_t i = 0; i < sizeof(m_lanes) / sizeof(m_lanes[0]); ++i) {
+        if (m_lanes[i].state == LANE_PAIRING) {
+            complete_step(i, error);
+            return;
+        }
+    }
+}
+
+bool batch_runner::pairing_in_progress()
+{
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    return matter_controller_client::get_instance().get_commissioner()->GetPairingDelegate() != nullptr;
+#else
+    return false;
+#endif
+}
+
+const char *batch_runner::find_var(const lane_t &lane, const char *name, size_t name_len, char *buf,
+                                   size_t buf_size)
+{
+    for (int i = lane.loop_depth - 1; i >= 0; --i) {
+        const loop_t &loop = lane.loops[i];
+        if (strlen(loop.name) == name_len && strncmp(loop.name, name, name_len) == 0) {
+            snprintf(buf, buf_size, loop.hex ? "0x%" PRIx64 : "%" PRIu64, loop.value);
+            return buf;
+        }
+    }
+    for (const var_t &var : m_vars) {
+        if (var.name[0] && strlen(var.name) == name_len && strncmp(var.name, name, name_len) == 0) {
+            return var.value;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t batch_runner::substitute(const lane_t &lane, const char *line, char *out, size_t out_size)
+{
+    size_t len = 0;
+    char number[24];
+    while (*line) {
+        const char *value = line;
+        size_t value_len = 1;
+        if (*line == '$') {
+            const char *name = line + 1;
+            bool braced = *name == '{';
+            if (*name == '$') {
+                value_len = 1;
+                line += 2;
+                value = "$";
+            } else {
+                name += braced ? 1 : 0;
+                size_t name_len = 0;
+                while (is_name_char(name[name_len])) {
+                    name_len++;
+                }
+                ESP_RETURN_ON_FALSE(name_len > 0 && (!braced || name[name_len] == '}'), ESP_ERR_INVALID_ARG, TAG,
+                                    "Invalid variable reference");
+                value = find_var(lane, name, name_len, number, sizeof(number));
+                ESP_RETURN_ON_FALSE(value, ESP_ERR_NOT_FOUND, TAG, "Undefined variable %.*s", (int)name_len, name);
+                value_len = strlen(value);
+                line = name + name_len + (braced ? 1 : 0);
+            }
+        } else {
+            line++;
+        }
+        ESP_RETURN_ON_FALSE(len + value_len < out_size, ESP_ERR_INVALID_SIZE, TAG, "Line too long");
+        memcpy(out + len, value, value_len);
+        len += value_len;
+    }
+    out[len] = '\0';
+    return ESP_OK;
+}
+
+esp_err_t batch_runner::set_var(const char *name, const char *value)
+{
+    size_t name_len = strlen(name);
+    ESP_RETURN_ON_FALSE(name_len > 0 && name_len < k_max_name_len, ESP_ERR_INVALID_ARG, TAG, "Invalid name");
+    for (size_t i = 0; i < name_len; ++i) {
+        ESP_RETURN_ON_FALSE(is_name_char(name[i]), ESP_ERR_INVALID_ARG, TAG, "Invalid name %s", name);
+    }
+    ESP_RETURN_ON_FALSE(strlen(value) < k_max_value_len, ESP_ERR_INVALID_SIZE, TAG, "Value too long");
+    var_t *free_var = nullptr;
+    for (var_t &var : m_vars) {
+        if (strcmp(var.name, name) == 0) {
+            strlcpy(var.value, value, sizeof(var.value));
+            return ESP_OK;
+        }
+        if (!free_var && var.name[0] == '\0') {
+            free_var = &var;
+        }
+    }
+    ESP_RETURN_ON_FALSE(free_var, ESP_ERR_NO_MEM, TAG, "Too many variables");
+    strlcpy(free_var->name, name, sizeof(free_var->name));
+    strlcpy(free_var->value, value, sizeof(free_var->value));
+    return ESP_OK;
+}
+
+void batch_runner::get_report(report_t &report)
+{
+    report.running = m_running;
+    report.executed = m_executed;
+    report.failed = m_failed;
+    report.elapsed_ms = m_start_ms ? (m_running ? now_ms() : m_end_ms) - m_start_ms : 0;
+    report.line_count = m_step_count;
+}
+
+void batch_runner::dump()
+{
+    report_t report;
+    get_report(report);
+    ESP_LOGI(TAG, "%s, %" PRIu32 " lines executed, %" PRIu32 " failed, elapsed %" PRIu32 " ms",
+             report.running ? "running" : "idle", report.executed, report.failed, report.elapsed_ms);
+    for (size_t i = 0; i < m_step_count; ++i) {
+        const step_t &step = m_steps[i];
+        if (step.kind != STEP_COMMAND || step.executed == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG, "Line %u: executed %" PRIu32 ", failed %" PRIu32 ", avg %" PRIu32 " ms, max %" PRIu32 " ms",
+                 step.line_no, step.executed, step.failed, (uint32_t)(step.total_ms / step.executed), step.max_ms);
+    }
+    for (size_t i = 0; i < sizeof(m_lanes) / sizeof(m_lanes[0]); ++i) {
+        const lane_t &lane = m_lanes[i];
+        if (lane.state == LANE_PENDING || lane.state == LANE_PAIRING) {
+            ESP_LOGI(TAG, "Lane %u waiting on line %u: %s", (unsigned)i, m_steps[lane.pc].line_no, lane.summary);
+        }
+    }
+}
+
+} // namespace controller
+} // namespace esp_matter
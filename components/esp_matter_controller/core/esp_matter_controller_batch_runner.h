@@ -0,0 +1,238 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemLayer.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Runner of the controller console scripts
+ *
+ * A script is a list of controller console commands, one per line, which are executed at machine speed instead of
+ * being typed one after the other. The following directives are supported besides the commands:
+ *
+ * - `# comment`
+ * - `set <name> <value>`: define a variable, the rest of the line is the value.
+ * - `foreach <name> <first> <last> [<step>] [parallel <n>]` ... `end`: run the lines in between for each value of the
+ *   range, in the base of <first> (decimal, or hexadecimal with the 0x prefix). With `parallel <n>`, up to n
+ *   iterations run at the same time, the lines of an iteration still run one after the other.
+ * - `sleep <ms>`: wait before the next line.
+ *
+ * `$name` or `${name}` in a line is replaced by the value of the loop variable or the variable, and `$$` by `$`.
+ * The quotes group the words of an argument, as in the console.
+ *
+ * A line is complete when all the interactions it starts are complete: the read and write commands when the node
+ * responds, the invoke commands when the response is received, the subscribe commands when the subscription is
+ * established, and the pairing commands when the commissioning ends. The result and duration of each line are
+ * printed, and the statistics of each line of the script are kept for the report.
+ *
+ * @note All the APIs should be called in the Matter context or with the Matter stack lock.
+ */
+class batch_runner {
+public:
+    /** Executor of one command line of the script, argv[0] is the command name */
+    typedef esp_err_t (*command_exec_t)(int argc, char **argv);
+
+    typedef void (*done_cb_t)(uint32_t executed, uint32_t failed, void *ctx);
+
+    typedef struct {
+        bool running;
+        uint32_t executed;
+        uint32_t failed;
+        uint32_t elapsed_ms;
+        size_t line_count;
+    } report_t;
+
+    static batch_runner &get_instance()
+    {
+        static batch_runner s_instance;
+        return s_instance;
+    }
+
+    /** Load a script from a file, on the SPIFFS partition for example, replacing the loaded script */
+    esp_err_t load_file(const char *path);
+
+    /** Load a script from a buffer, replacing the loaded script */
+    esp_err_t load_buffer(const char *script, size_t len);
+
+    /** Append a line to the loaded script, so that a script can be streamed line by line */
+    esp_err_t append_line(const char *line);
+
+    /** Drop the loaded script */
+    void clear();
+
+    /** Run the loaded script
+     *
+     * @param[in] exec Executor of the command lines
+     * @param[in] done_cb Callback called when the script ends, can be NULL
+     * @param[in] ctx Context passed to done_cb
+     */
+    esp_err_t start(command_exec_t exec, done_cb_t done_cb = nullptr, void *ctx = nullptr);
+
+    /** Stop the running script, the interactions already sent are not cancelled */
+    void stop();
+
+    bool is_running() { return m_running; }
+
+    void get_report(report_t &report);
+
+    /** Print the state of the runner and the statistics of each line of the script */
+    void dump();
+
+    /** Called by the commands when they are sent, returns the tag of the running line or 0 */
+    uint32_t begin_interaction();
+
+    /** Called by the commands when the interaction of a tag returned by begin_interaction() is complete */
+    void end_interaction(uint32_t tag, CHIP_ERROR error);
+
+    /** Called by the pairing command when the commissioning it started ends */
+    void end_commissioning(CHIP_ERROR error);
+
+private:
+    static constexpr size_t k_max_line_len = 512;
+    static constexpr size_t k_max_args = 16;
+    static constexpr size_t k_max_vars = 16;
+    static constexpr size_t k_max_name_len = 16;
+    static constexpr size_t k_max_value_len = 128;
+    static constexpr size_t k_max_loop_depth = 4;
+    static constexpr size_t k_summary_len = 64;
+
+    typedef enum : uint8_t {
+        STEP_NONE = 0,
+        STEP_COMMAND,
+        STEP_SET,
+        STEP_FOREACH,
+        STEP_END,
+        STEP_SLEEP,
+    } step_kind_t;
+
+    typedef struct {
+        // Offset of the line in the script buffer
+        uint32_t offset;
+        uint16_t line_no;
+        step_kind_t kind;
+        // Index of the matching end of a foreach and of the matching foreach of an end
+        uint16_t match;
+        uint32_t executed;
+        uint32_t failed;
+        uint32_t max_ms;
+        uint64_t total_ms;
+    } step_t;
+
+    typedef struct {
+        uint16_t step;
+        char name[k_max_name_len];
+        uint64_t value;
+        uint64_t last;
+        uint64_t increment;
+        bool hex;
+    } loop_t;
+
+    typedef enum : uint8_t {
+        LANE_FREE = 0,
+        LANE_READY,
+        // Waiting for the interactions of the current line
+        LANE_PENDING,
+        // Waiting for the commissioning started by the current line
+        LANE_PAIRING,
+        LANE_SLEEPING,
+        // Waiting for the iterations of a parallel foreach
+        LANE_JOINING,
+    } lane_state_t;
+
+    /** Execution context of the main script or of one iteration of a parallel foreach */
+    typedef struct {
+        lane_state_t state;
+        uint16_t pc;
+        // Last step of the lane, the end of the foreach of an iteration
+        uint16_t end_pc;
+        uint16_t seq;
+        uint16_t pending;
+        CHIP_ERROR error;
+        uint64_t step_start_ms;
+        uint64_t wake_ms;
+        loop_t loops[k_max_loop_depth];
+        uint8_t loop_depth;
+        char summary[k_summary_len];
+    } lane_t;
+
+    typedef struct {
+        char name[k_max_name_len];
+        char value[k_max_value_len];
+    } var_t;
+
+    batch_runner() {}
+
+    esp_err_t parse();
+    step_kind_t classify(const char *line);
+    const char *step_text(uint16_t step) { return m_script + m_steps[step].offset; }
+
+    static void timer_cb(chip::System::Layer *layer, void *ctx);
+    static void pump_work(intptr_t ctx);
+    void schedule_pump();
+    void pump();
+    void schedule_timer();
+
+    void run_lane(size_t lane_index);
+    void exec_step(size_t lane_index);
+    void exec_foreach(size_t lane_index);
+    void exec_end(size_t lane_index);
+    void spawn_iterations(size_t lane_index);
+    void complete_step(size_t lane_index, CHIP_ERROR error);
+    void finish(const char *reason);
+
+    esp_err_t substitute(const lane_t &lane, const char *line, char *out, size_t out_size);
+    const char *find_var(const lane_t &lane, const char *name, size_t name_len, char *buf, size_t buf_size);
+    esp_err_t set_var(const char *name, const char *value);
+    bool pairing_in_progress();
+
+    char *m_script = nullptr;
+    size_t m_script_len = 0;
+    size_t m_script_size = 0;
+    step_t *m_steps = nullptr;
+    size_t m_step_count = 0;
+    bool m_parsed = false;
+
+    lane_t m_lanes[CONFIG_ESP_MATTER_CONTROLLER_BATCH_MAX_LANES + 1] = {};
+    var_t m_vars[k_max_vars] = {};
+    // Parallel foreach of the main lane: next value and remaining iterations to start
+    uint64_t m_next_value = 0;
+    uint64_t m_remaining = 0;
+    uint8_t m_max_parallel = 0;
+    loop_t m_parallel_loop = {};
+
+    command_exec_t m_exec = nullptr;
+    done_cb_t m_done_cb = nullptr;
+    void *m_done_ctx = nullptr;
+    bool m_running = false;
+    bool m_pump_scheduled = false;
+    uint8_t m_run_id = 0;
+    // Lane whose command line is being executed, interactions begun meanwhile are attributed to it
+    int m_current_lane = -1;
+    uint64_t m_start_ms = 0;
+    uint64_t m_end_ms = 0;
+    uint32_t m_executed = 0;
+    uint32_t m_failed = 0;
+    char m_line[k_max_line_len];
+};
+
+} // namespace controller
+} // namespace esp_matter
@@ -40,6 +40,10 @@
 #include <esp_matter_attestation_trust_store.h>
 #endif
 
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_STORAGE
+#include <esp_matter_controller_session_resumption_storage.h>
+#endif
+
 #if CONFIG_ENABLE_ESP32_BLE_CONTROLLER
 #include <platform/internal/BLEManager.h>
 #endif
@@ -71,6 +75,11 @@ esp_err_t matter_controller_client::init(NodeId node_id, FabricId fabric_id, uin
     factory_init_params.enableServerInteractions = m_operational_advertising;
     factory_init_params.sessionKeystore = &m_session_key_store;
     factory_init_params.dataModelProvider = chip::app::CodegenDataModelProviderInstance(&m_default_storage);
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_STORAGE
+    ESP_RETURN_ON_ERROR(session_resumption_storage::get_instance().init(&m_default_storage), TAG,
+                        "Failed to initialize session resumption storage");
+    factory_init_params.sessionResumptionStorage = &session_resumption_storage::get_instance();
+#endif
     m_controller_node_id = node_id;
     m_controller_fabric_id = fabric_id;
 
@@ -116,13 +116,37 @@ public:
         }
     };
 
+    /** Check-in delegate notifying the controller when a registered ICD checks in */
+    class icd_check_in_delegate : public chip::app::DefaultCheckInDelegate {
+    public:
+        typedef void (*check_in_cb_t)(const chip::ScopedNodeId &peer_node, void *ctx);
+
+        void set_check_in_callback(check_in_cb_t cb, void *ctx)
+        {
+            m_check_in_cb = cb;
+            m_check_in_ctx = ctx;
+        }
+
+        void OnCheckInComplete(const chip::app::ICDClientInfo &clientInfo) override
+        {
+            DefaultCheckInDelegate::OnCheckInComplete(clientInfo);
+            if (m_check_in_cb) {
+                m_check_in_cb(clientInfo.peer_node, m_check_in_ctx);
+            }
+        }
+
+    private:
+        check_in_cb_t m_check_in_cb = nullptr;
+        void *m_check_in_ctx = nullptr;
+    };
+
     using NodeId = ::chip::NodeId;
     using FabricId = ::chip::FabricId;
     using MatterDeviceCommissioner = ::chip::Controller::DeviceCommissioner;
     using MatterDeviceController = ::chip::Controller::DeviceController;
 
-    static constexpr uint16_t k_max_groups_per_fabric = 50;
-    static constexpr uint16_t k_max_group_keys_per_fabric = 25;
+    static constexpr uint16_t k_max_groups_per_fabric = CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUPS_PER_FABRIC;
+    static constexpr uint16_t k_max_group_keys_per_fabric = CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC;
 
     static matter_controller_client &get_instance()
     {
@@ -132,6 +156,7 @@ public:
 
     esp_err_t init(NodeId node_id, FabricId fabric_id, uint16_t listen_port);
     chip::app::DefaultICDClientStorage &get_icd_client_storage() { return m_icd_client_storage; }
+    icd_check_in_delegate &get_icd_check_in_delegate() { return m_icd_check_in_delegate; }
 
 #ifdef CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
     esp_err_t setup_commissioner();
@@ -170,7 +195,7 @@ private:
     NodeId m_controller_node_id;
     FabricId m_controller_fabric_id;
     chip::app::DefaultICDClientStorage m_icd_client_storage;
-    chip::app::DefaultCheckInDelegate m_icd_check_in_delegate;
+    icd_check_in_delegate m_icd_check_in_delegate;
     chip::app::CheckInHandler m_check_in_handler;
 
 #ifdef CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
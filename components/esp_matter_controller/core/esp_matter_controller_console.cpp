@@ -16,12 +16,14 @@
  */
 
 #include <esp_check.h>
+#include <esp_matter_controller_bulk_command.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_cluster_command.h>
 #include <esp_matter_controller_commissioning_window_opener.h>
 #include <esp_matter_controller_console.h>
 #include <esp_matter_controller_group_settings.h>
 #include <esp_matter_controller_icd_client.h>
+#include <esp_matter_controller_output_sink.h>
 #include <esp_matter_controller_pairing_command.h>
 #include <esp_matter_controller_read_command.h>
 #include <esp_matter_controller_subscribe_command.h>
@@ -38,6 +40,24 @@
 #include <platform/CHIPDeviceLayer.h>
 #include <protocols/secure_channel/RendezvousParameters.h>
 #include <protocols/user_directed_commissioning/UserDirectedCommissioning.h>
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+#include <esp_matter_controller_commissioning_pipeline.h>
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+#include <esp_matter_controller_resubscribe_scheduler.h>
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_STORAGE
+#include <esp_matter_controller_session_resumption_storage.h>
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_ICD_COMMAND_QUEUE
+#include <esp_matter_controller_icd_command_queue.h>
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+#include <esp_matter_controller_node_stats.h>
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+#include <esp_matter_controller_batch_runner.h>
+#endif
 
 using chip::NodeId;
 using chip::Inet::IPAddress;
@@ -62,19 +82,22 @@ static size_t get_array_size(const char *str)
     return ret;
 }
 
-static esp_err_t string_to_uint32_array(const char *str, ScopedMemoryBufferWithSize<uint32_t> &uint32_array)
+// Parse a comma separated list of decimal or hexadecimal numbers
+template <typename T>
+static esp_err_t string_to_uint_array(const char *str, ScopedMemoryBufferWithSize<T> &uint_array,
+                                      T (*string_to_uint)(char *))
 {
     size_t array_len = get_array_size(str);
     if (array_len == 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    uint32_array.Calloc(array_len);
-    if (!uint32_array.Get()) {
+    uint_array.Calloc(array_len);
+    if (!uint_array.Get()) {
         return ESP_ERR_NO_MEM;
     }
-    char number[11]; // max(strlen("0xFFFFFFFF"), strlen("4294967295")) + 1
+    char number[21]; // max(strlen("0xFFFFFFFFFFFFFFFF"), strlen("18446744073709551615")) + 1
     const char *next_number_start = str;
-    char *next_number_end = NULL;
+    const char *next_number_end = NULL;
     size_t next_number_len = 0;
     for (size_t i = 0; i < array_len; ++i) {
         next_number_end = strchr(next_number_start, ',');
@@ -87,7 +110,7 @@ static esp_err_t string_to_uint32_array(const char *str, ScopedMemoryBufferWithS
         }
         strncpy(number, next_number_start, next_number_len);
         number[next_number_len] = 0;
-        uint32_array[i] = string_to_uint32(number);
+        uint_array[i] = string_to_uint(number);
         if (next_number_end > next_number_start) {
             next_number_start = next_number_end + 1;
         }
@@ -95,37 +118,19 @@ static esp_err_t string_to_uint32_array(const char *str, ScopedMemoryBufferWithS
     return ESP_OK;
 }
 
+static esp_err_t string_to_uint32_array(const char *str, ScopedMemoryBufferWithSize<uint32_t> &uint32_array)
+{
+    return string_to_uint_array(str, uint32_array, string_to_uint32);
+}
+
 esp_err_t string_to_uint16_array(const char *str, ScopedMemoryBufferWithSize<uint16_t> &uint16_array)
 {
-    size_t array_len = get_array_size(str);
-    if (array_len == 0) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    uint16_array.Calloc(array_len);
-    if (!uint16_array.Get()) {
-        return ESP_ERR_NO_MEM;
-    }
-    char number[7]; // max(strlen(0xFFFF), strlen(65535)) + 1
-    const char *next_number_start = str;
-    char *next_number_end = NULL;
-    size_t next_number_len = 0;
-    for (size_t i = 0; i < array_len; ++i) {
-        next_number_end = strchr(next_number_start, ',');
-        if (next_number_end > next_number_start) {
-            next_number_len = std::min((size_t)(next_number_end - next_number_start), sizeof(number) - 1);
-        } else if (i == array_len - 1) {
-            next_number_len = strnlen(next_number_start, sizeof(number) - 1);
-        } else {
-            return ESP_ERR_INVALID_ARG;
-        }
-        strncpy(number, next_number_start, next_number_len);
-        number[next_number_len] = 0;
-        uint16_array[i] = string_to_uint16(number);
-        if (next_number_end > next_number_start) {
-            next_number_start = next_number_end + 1;
-        }
-    }
-    return ESP_OK;
+    return string_to_uint_array(str, uint16_array, string_to_uint16);
+}
+
+static esp_err_t string_to_uint64_array(const char *str, ScopedMemoryBufferWithSize<uint64_t> &uint64_array)
+{
+    return string_to_uint_array(str, uint64_array, string_to_uint64);
 }
 
 namespace console {
@@ -173,9 +178,38 @@ static bool convert_hex_str_to_bytes(const char *hex_str, uint8_t *bytes, uint8_
 #endif // defined(CONFIG_ENABLE_ESP32_BLE_CONTROLLER) && defined(CONFIG_ESP_MATTER_COMMISSIONER_ENABLE)
 
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+static esp_err_t controller_pairing_pipeline_handler(int argc, char **argv)
+{
+    auto &pipeline = controller::commissioning_pipeline::get_instance();
+    if (strncmp(argv[0], "pipeline-add", sizeof("pipeline-add")) == 0) {
+        VerifyOrReturnError(argc == 3, ESP_ERR_INVALID_ARG);
+        return pipeline.add_device(string_to_uint64(argv[1]), argv[2]);
+    } else if (strncmp(argv[0], "pipeline-start", sizeof("pipeline-start")) == 0) {
+        VerifyOrReturnError(argc <= 2, ESP_ERR_INVALID_ARG);
+        controller::commissioning_pipeline::config_t config;
+        if (argc == 2) {
+            config.max_pase_ahead = string_to_uint8(argv[1]);
+        }
+        return pipeline.start(config);
+    } else if (strncmp(argv[0], "pipeline-stop", sizeof("pipeline-stop")) == 0) {
+        pipeline.stop();
+        return ESP_OK;
+    } else if (strncmp(argv[0], "pipeline-reset", sizeof("pipeline-reset")) == 0) {
+        return pipeline.reset();
+    } else if (strncmp(argv[0], "pipeline-status", sizeof("pipeline-status")) == 0) {
+        pipeline.dump();
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
 static esp_err_t controller_pairing_handler(int argc, char **argv)
 {
-    VerifyOrReturnError(argc >= 2 && argc <= 6, ESP_ERR_INVALID_ARG);
+    VerifyOrReturnError(argc >= 1 && argc <= 6, ESP_ERR_INVALID_ARG);
+    if (strncmp(argv[0], "pipeline-", sizeof("pipeline-") - 1) == 0) {
+        return controller_pairing_pipeline_handler(argc, argv);
+    }
+    VerifyOrReturnError(argc >= 2, ESP_ERR_INVALID_ARG);
     esp_err_t result = ESP_ERR_INVALID_ARG;
 
     if (strncmp(argv[0], "onnetwork", sizeof("onnetwork")) == 0) {
@@ -377,6 +411,51 @@ static esp_err_t controller_group_settings_handler(int argc, char **argv)
             uint16_t group_id = string_to_uint16(argv[1]);
             uint16_t keyset_id = string_to_uint16(argv[2]);
             return controller::group_settings::unbind_keyset(group_id, keyset_id);
+        } else if (strncmp(argv[0], "add-groups", sizeof("add-groups")) == 0) {
+            if (argc != 3) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            ScopedMemoryBufferWithSize<uint16_t> group_ids;
+            ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], group_ids), TAG, "Failed to parse group IDs");
+            // The groups are named <name-prefix>-0x<group-id>
+            ScopedMemoryBufferWithSize<char *> group_names;
+            chip::Platform::ScopedMemoryBuffer<char> names_buf;
+            size_t name_size = CHIP_CONFIG_MAX_GROUP_NAME_LENGTH + 1;
+            group_names.Calloc(group_ids.AllocatedSize());
+            names_buf.Calloc(group_ids.AllocatedSize() * name_size);
+            ESP_RETURN_ON_FALSE(group_names.Get() && names_buf.Get(), ESP_ERR_NO_MEM, TAG,
+                                "Failed to alloc memory for group names");
+            for (size_t i = 0; i < group_ids.AllocatedSize(); ++i) {
+                group_names[i] = &names_buf[i * name_size];
+                snprintf(group_names[i], name_size, "%s-0x%x", argv[2], group_ids[i]);
+            }
+            return controller::group_settings::add_groups(group_ids.Get(), group_names.Get(),
+                                                          group_ids.AllocatedSize());
+        } else if (strncmp(argv[0], "remove-groups", sizeof("remove-groups")) == 0) {
+            if (argc != 2) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            ScopedMemoryBufferWithSize<uint16_t> group_ids;
+            ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], group_ids), TAG, "Failed to parse group IDs");
+            return controller::group_settings::remove_groups(group_ids.Get(), group_ids.AllocatedSize());
+        } else if (strncmp(argv[0], "bind-keyset-groups", sizeof("bind-keyset-groups")) == 0) {
+            if (argc != 3) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            ScopedMemoryBufferWithSize<uint16_t> group_ids;
+            ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], group_ids), TAG, "Failed to parse group IDs");
+            uint16_t keyset_id = string_to_uint16(argv[2]);
+            return controller::group_settings::bind_keyset_to_groups(group_ids.Get(), group_ids.AllocatedSize(),
+                                                                     keyset_id);
+        } else if (strncmp(argv[0], "unbind-keyset-groups", sizeof("unbind-keyset-groups")) == 0) {
+            if (argc != 3) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            ScopedMemoryBufferWithSize<uint16_t> group_ids;
+            ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], group_ids), TAG, "Failed to parse group IDs");
+            uint16_t keyset_id = string_to_uint16(argv[2]);
+            return controller::group_settings::unbind_keyset_from_groups(group_ids.Get(), group_ids.AllocatedSize(),
+                                                                         keyset_id);
         }
     }
     ESP_LOGI(TAG, "Subcommands of group-settings:");
@@ -390,6 +469,10 @@ static esp_err_t controller_group_settings_handler(int argc, char **argv)
     ESP_LOGI(TAG, "Remove keyset : controller group-settings remove-keyset <ketset_id>");
     ESP_LOGI(TAG, "Bind keyset   : controller group-settings bind-keyset <group_id> <ketset_id>");
     ESP_LOGI(TAG, "Unbind keyset : controller group-settings unbind-keyset <group_id> <ketset_id>");
+    ESP_LOGI(TAG, "Add groups    : controller group-settings add-groups <group_ids> <group_name_prefix>");
+    ESP_LOGI(TAG, "Remove groups : controller group-settings remove-groups <group_ids>");
+    ESP_LOGI(TAG, "Bind keyset to groups     : controller group-settings bind-keyset-groups <group_ids> <ketset_id>");
+    ESP_LOGI(TAG, "Unbind keyset from groups : controller group-settings unbind-keyset-groups <group_ids> <ketset_id>");
     return ESP_OK;
 }
 #endif
@@ -561,6 +644,71 @@ static esp_err_t controller_subscribe_event_handler(int argc, char **argv)
                                                     max_interval, keep_subscription, auto_resubscribe);
 }
 
+static esp_err_t controller_bulk_read_attr_handler(int argc, char **argv)
+{
+    if (argc != 4 && argc != 5) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ScopedMemoryBufferWithSize<uint64_t> node_ids;
+    ScopedMemoryBufferWithSize<uint16_t> endpoint_ids;
+    ScopedMemoryBufferWithSize<uint32_t> cluster_ids;
+    ScopedMemoryBufferWithSize<uint32_t> attribute_ids;
+    ESP_RETURN_ON_ERROR(string_to_uint64_array(argv[0], node_ids), TAG, "Failed to parse node IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], endpoint_ids), TAG, "Failed to parse endpoint IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint32_array(argv[2], cluster_ids), TAG, "Failed to parse cluster IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint32_array(argv[3], attribute_ids), TAG, "Failed to parse attribute IDs");
+
+    controller::bulk_command::config_t config;
+    if (argc > 4) {
+        config.max_in_flight = string_to_uint8(argv[4]);
+    }
+    return controller::send_bulk_read_attr_command(node_ids, endpoint_ids, cluster_ids, attribute_ids, config);
+}
+
+static esp_err_t controller_bulk_write_attr_handler(int argc, char **argv)
+{
+    if (argc != 5 && argc != 6) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ScopedMemoryBufferWithSize<uint64_t> node_ids;
+    ScopedMemoryBufferWithSize<uint16_t> endpoint_ids;
+    ScopedMemoryBufferWithSize<uint32_t> cluster_ids;
+    ScopedMemoryBufferWithSize<uint32_t> attribute_ids;
+    ESP_RETURN_ON_ERROR(string_to_uint64_array(argv[0], node_ids), TAG, "Failed to parse node IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], endpoint_ids), TAG, "Failed to parse endpoint IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint32_array(argv[2], cluster_ids), TAG, "Failed to parse cluster IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint32_array(argv[3], attribute_ids), TAG, "Failed to parse attribute IDs");
+
+    controller::bulk_command::config_t config;
+    if (argc > 5) {
+        config.max_in_flight = string_to_uint8(argv[5]);
+    }
+    return controller::send_bulk_write_attr_command(node_ids, endpoint_ids, cluster_ids, attribute_ids, argv[4],
+                                                    config);
+}
+
+static esp_err_t controller_bulk_invoke_command_handler(int argc, char **argv)
+{
+    if (argc < 4 || argc > 6) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ScopedMemoryBufferWithSize<uint64_t> node_ids;
+    ESP_RETURN_ON_ERROR(string_to_uint64_array(argv[0], node_ids), TAG, "Failed to parse node IDs");
+    uint16_t endpoint_id = string_to_uint16(argv[1]);
+    uint32_t cluster_id = string_to_uint32(argv[2]);
+    uint32_t command_id = string_to_uint32(argv[3]);
+
+    controller::bulk_command::config_t config;
+    if (argc > 5) {
+        config.max_in_flight = string_to_uint8(argv[5]);
+    }
+    return controller::send_bulk_invoke_command(node_ids, endpoint_id, cluster_id, command_id,
+                                                argc > 4 ? argv[4] : NULL, config);
+}
+
 static esp_err_t controller_shutdown_subscription_handler(int argc, char **argv)
 {
     if (argc != 2) {
@@ -590,14 +738,95 @@ static esp_err_t controller_shutdown_all_subscriptions_handler(int argc, char **
     return ESP_OK;
 }
 
-static esp_err_t controller_icd_list_handler(int argc, char **argv)
+#if CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+static esp_err_t controller_resubscribe_scheduler_handler(int argc, char **argv)
 {
-    if (argc != 1 || strncmp(argv[0], "list", sizeof("list")) != 0) {
+    if (argc != 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    controller::list_registered_icd();
+    controller::resubscribe_scheduler::get_instance().dump();
     return ESP_OK;
 }
+#endif
+
+#if CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_STORAGE
+static esp_err_t controller_session_resumption_handler(int argc, char **argv)
+{
+    if (argc == 0) {
+        controller::session_resumption_storage::get_instance().dump();
+        return ESP_OK;
+    }
+    if (argc == 1 && strncmp(argv[0], "clear", sizeof("clear")) == 0) {
+        return controller::session_resumption_storage::get_instance().clear();
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+#endif
+
+#if CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+static esp_err_t controller_node_stats_handler(int argc, char **argv)
+{
+    if (argc == 0) {
+        controller::node_stats::get_instance().dump();
+        return ESP_OK;
+    }
+    if (argc == 1 && strncmp(argv[0], "reset", sizeof("reset")) == 0) {
+        controller::node_stats::get_instance().reset();
+        return ESP_OK;
+    }
+    if (argc == 1) {
+        uint64_t node_id = string_to_uint64(argv[0]);
+        controller::node_stats::stats_t stats;
+        ESP_RETURN_ON_ERROR(controller::node_stats::get_instance().get_stats(node_id, stats), TAG,
+                            "No statistics for node 0x%" PRIx64, node_id);
+        controller::node_stats::get_instance().dump(node_id);
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+#endif
+
+static esp_err_t controller_icd_list_handler(int argc, char **argv)
+{
+    if (argc < 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (argc == 1 && strncmp(argv[0], "list", sizeof("list")) == 0) {
+        controller::list_registered_icd();
+        return ESP_OK;
+    }
+#if CONFIG_ESP_MATTER_CONTROLLER_ICD_COMMAND_QUEUE
+    controller::icd_command_queue &queue = controller::icd_command_queue::get_instance();
+    if (argc == 1 && strncmp(argv[0], "queue", sizeof("queue")) == 0) {
+        queue.dump();
+        return ESP_OK;
+    } else if (argc == 2 && strncmp(argv[0], "flush", sizeof("flush")) == 0) {
+        return queue.flush(string_to_uint64(argv[1]));
+    } else if (argc == 2 && strncmp(argv[0], "cancel", sizeof("cancel")) == 0) {
+        queue.cancel(string_to_uint64(argv[1]));
+        return ESP_OK;
+    } else if ((argc == 6 || argc == 7) && strncmp(argv[0], "queue-write", sizeof("queue-write")) == 0) {
+        return queue.queue_write(string_to_uint64(argv[1]), string_to_uint16(argv[2]), string_to_uint32(argv[3]),
+                                 string_to_uint32(argv[4]), argv[5], argc == 7 ? string_to_uint32(argv[6]) : 0);
+    } else if (argc >= 5 && argc <= 7 && strncmp(argv[0], "queue-invoke", sizeof("queue-invoke")) == 0) {
+        return queue.queue_invoke(string_to_uint64(argv[1]), string_to_uint16(argv[2]), string_to_uint32(argv[3]),
+                                  string_to_uint32(argv[4]), argc > 5 ? argv[5] : NULL,
+                                  argc == 7 ? string_to_uint32(argv[6]) : 0);
+    }
+#endif
+    return ESP_ERR_INVALID_ARG;
+}
+
+static esp_err_t controller_output_format_handler(int argc, char **argv)
+{
+    if (argc != 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    controller::output_format_t format;
+    ESP_RETURN_ON_ERROR(controller::output_format_from_str(argv[0], format), TAG, "Unknown output format %s",
+                        argv[0]);
+    return controller::set_default_output_format(format);
+}
 
 static esp_err_t controller_dispatch(int argc, char **argv)
 {
@@ -607,6 +836,65 @@ static esp_err_t controller_dispatch(int argc, char **argv)
     return controller_console.exec_command(argc, argv);
 }
 
+#if CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+// Join the arguments of the console back into a script line, quoting the arguments which were quoted
+static esp_err_t batch_join_line(int argc, char **argv, char *line, size_t line_size)
+{
+    size_t len = 0;
+    for (int i = 0; i < argc; ++i) {
+        bool quote = argv[i][0] == '\0' || strpbrk(argv[i], " \t") != nullptr;
+        size_t needed = (i > 0 ? 1 : 0) + (quote ? 2 : 0);
+        for (const char *c = argv[i]; *c; ++c) {
+            needed += (*c == '"' || *c == '\\') ? 2 : 1;
+        }
+        ESP_RETURN_ON_FALSE(len + needed < line_size, ESP_ERR_INVALID_SIZE, TAG, "The line is too long");
+        if (i > 0) {
+            line[len++] = ' ';
+        }
+        if (quote) {
+            line[len++] = '"';
+        }
+        for (const char *c = argv[i]; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                line[len++] = '\\';
+            }
+            line[len++] = *c;
+        }
+        if (quote) {
+            line[len++] = '"';
+        }
+    }
+    line[len] = '\0';
+    return ESP_OK;
+}
+
+static esp_err_t controller_batch_handler(int argc, char **argv)
+{
+    controller::batch_runner &runner = controller::batch_runner::get_instance();
+    if (argc == 2 && strncmp(argv[0], "run", sizeof("run")) == 0) {
+        ESP_RETURN_ON_ERROR(runner.load_file(argv[1]), TAG, "Failed to load the script %s", argv[1]);
+        return runner.start(controller_dispatch);
+    } else if (argc >= 2 && strncmp(argv[0], "append", sizeof("append")) == 0) {
+        char line[512];
+        ESP_RETURN_ON_ERROR(batch_join_line(argc - 1, &argv[1], line, sizeof(line)), TAG, "Invalid line");
+        return runner.append_line(line);
+    } else if (argc == 1 && strncmp(argv[0], "start", sizeof("start")) == 0) {
+        return runner.start(controller_dispatch);
+    } else if (argc == 1 && strncmp(argv[0], "stop", sizeof("stop")) == 0) {
+        runner.stop();
+        return ESP_OK;
+    } else if (argc == 1 && strncmp(argv[0], "status", sizeof("status")) == 0) {
+        runner.dump();
+        return ESP_OK;
+    } else if (argc == 1 && strncmp(argv[0], "clear", sizeof("clear")) == 0) {
+        ESP_RETURN_ON_FALSE(!runner.is_running(), ESP_ERR_INVALID_STATE, TAG, "A script is running");
+        runner.clear();
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+#endif
+
 esp_err_t controller_register_commands()
 {
     // Subcommands for root command: `controller <subcommand>`
@@ -628,7 +916,12 @@ esp_err_t controller_register_commands()
                            "\tcontroller pairing code-wifi <nodeid> <ssid> <password> <payload> OR\n"
                            "\tcontroller pairing code-thread <nodeid> <dataset> <payload> OR\n"
                            "\tcontroller pairing code-wifi-thread <nodeid> <ssid> <password> <dataset> <payload> OR\n"
-                           "\tcontroller pairing unpair <nodeid>",
+                           "\tcontroller pairing unpair <nodeid> OR\n"
+                           "\tcontroller pairing pipeline-add <nodeid> <payload> OR\n"
+                           "\tcontroller pairing pipeline-start [max-pase-ahead] OR\n"
+                           "\tcontroller pairing pipeline-stop OR\n"
+                           "\tcontroller pairing pipeline-reset OR\n"
+                           "\tcontroller pairing pipeline-status",
             .handler = controller_pairing_handler,
         },
         {
@@ -640,7 +933,18 @@ esp_err_t controller_register_commands()
         {
             .name = "icd",
             .description = "icd client management.\n"
-                           "\tUsage: controller icd list",
+                           "\tUsage: controller icd list"
+#if CONFIG_ESP_MATTER_CONTROLLER_ICD_COMMAND_QUEUE
+                           " OR\n"
+                           "\tcontroller icd queue-write <node-id> <endpoint-id> <cluster-id> <attr-id> <value> "
+                           "[ttl-ms] OR\n"
+                           "\tcontroller icd queue-invoke <node-id> <endpoint-id> <cluster-id> <command-id> "
+                           "[command-data] [ttl-ms] OR\n"
+                           "\tcontroller icd queue OR\n"
+                           "\tcontroller icd flush <node-id> OR\n"
+                           "\tcontroller icd cancel <node-id>"
+#endif
+                           ,
             .handler = controller_icd_list_handler,
         },
 #if CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY
@@ -723,6 +1027,33 @@ esp_err_t controller_register_commands()
                            "\tNotes: 'keep-subscription' and 'auto-resubscribe' are the same as 'subs-attr' command",
             .handler = controller_subscribe_event_handler,
         },
+        {
+            .name = "bulk-read",
+            .description = "Read attributes of multiple nodes.\n"
+                           "\tUsage: controller bulk-read <node-ids> <endpoint-ids> <cluster-ids> <attr-ids> "
+                           "[max-in-flight]\n"
+                           "\tNotes: node-ids can represent a single or multiple nodes, e.g. '1' or '1,2,3'. "
+                           "'max-in-flight' is the number of nodes read at the same time.",
+            .handler = controller_bulk_read_attr_handler,
+        },
+        {
+            .name = "bulk-write",
+            .description = "Write attributes of multiple nodes.\n"
+                           "\tUsage: controller bulk-write <node-ids> <endpoint-ids> <cluster-ids> <attr-ids> "
+                           "<attr-value> [max-in-flight]\n"
+                           "\tNotes: The same attr-value is written to all the nodes, its format is the same as "
+                           "'write-attr' command",
+            .handler = controller_bulk_write_attr_handler,
+        },
+        {
+            .name = "bulk-invoke",
+            .description = "Send command to multiple nodes.\n"
+                           "\tUsage: controller bulk-invoke <node-ids> <endpoint-id> <cluster-id> <command-id> "
+                           "[command_data] [max-in-flight]\n"
+                           "\tNotes: The same command_data is sent to all the nodes, its format is the same as "
+                           "'invoke-cmd' command",
+            .handler = controller_bulk_invoke_command_handler,
+        },
         {
             .name = "shutdown-subs",
             .description = "Shutdown subscription for given node id and subscription id.\n"
@@ -741,6 +1072,46 @@ esp_err_t controller_register_commands()
                            "\tUsage: controller shutdown-all-subss",
             .handler = controller_shutdown_all_subscriptions_handler,
         },
+#if CONFIG_ESP_MATTER_CONTROLLER_RESUBSCRIBE_SCHEDULER
+        {
+            .name = "subs-scheduler",
+            .description = "Print the metrics and the queued attempts of the resubscribe scheduler.\n"
+                           "\tUsage: controller subs-scheduler",
+            .handler = controller_resubscribe_scheduler_handler,
+        },
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_STORAGE
+        {
+            .name = "session-resumption",
+            .description = "Print the CASE session resumption statistics, or clear the resumption state.\n"
+                           "\tUsage: controller session-resumption [clear]",
+            .handler = controller_session_resumption_handler,
+        },
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS
+        {
+            .name = "node-stats",
+            .description = "Print the latency and failure statistics of all the nodes or of a node, or clear them.\n"
+                           "\tUsage: controller node-stats [<node-id>|reset]",
+            .handler = controller_node_stats_handler,
+        },
+#endif
+#if CONFIG_ESP_MATTER_CONTROLLER_BATCH_RUNNER
+        {
+            .name = "batch",
+            .description = "Run a script of controller commands, from a file or appended line by line.\n"
+                           "\tUsage: controller batch run <path> OR\n"
+                           "\tcontroller batch append <command line> OR\n"
+                           "\tcontroller batch <start|stop|status|clear>",
+            .handler = controller_batch_handler,
+        },
+#endif
+        {
+            .name = "output-format",
+            .description = "Set the output format of the attribute and event reports.\n"
+                           "\tUsage: controller output-format <none|text|binary|json|custom>",
+            .handler = controller_output_format_handler,
+        },
     };
 
     const static command_t controller_command = {
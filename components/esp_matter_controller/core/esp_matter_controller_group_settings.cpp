@@ -27,20 +27,157 @@ namespace esp_matter {
 namespace controller {
 namespace group_settings {
 
-static bool find_keyset_id(FabricIndex fabric_index, uint16_t group_id, KeysetId &keyset_id)
+/* In-memory index of the group key map and the keysets of the controller fabric
+ *
+ * Each step of the GroupDataProvider iterators reads the persistent storage, so walking the group key map for every
+ * lookup gets slow with hundreds of groups. The index mirrors the group key map, in the order of the provider so that
+ * its positions can be passed to SetGroupKeyAt() and RemoveGroupKeyAt(), and the IDs and policies of the keysets.
+ * It is loaded on first use and updated with every change made through the group settings, and reloaded after a
+ * failed change.
+ */
+typedef struct {
+    FabricIndex fabric_index;
+    bool loaded;
+    uint16_t group_key_count;
+    GroupDataProvider::GroupKey group_keys[CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUPS_PER_FABRIC];
+    uint16_t keyset_count;
+    KeysetId keyset_ids[CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC];
+    GroupDataProvider::SecurityPolicy keyset_policies[CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC];
+} group_index_t;
+
+static group_index_t s_index;
+
+static esp_err_t load_index(FabricIndex fabric_index)
 {
+    if (s_index.loaded && s_index.fabric_index == fabric_index) {
+        return ESP_OK;
+    }
     GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
-    auto iter = group_data_provider->IterateGroupKeys(fabric_index);
+    s_index.loaded = false;
+    s_index.fabric_index = fabric_index;
+    s_index.group_key_count = 0;
+    s_index.keyset_count = 0;
+
+    // The positions of the index are the ones of the provider, so an index missing entries of the provider would make
+    // the changes overwrite or remove the wrong entries. The provider may have more entries than the index if they
+    // were added with a larger limit or without the group settings, the index is then not loaded and every lookup
+    // and change fails.
+    auto group_key_iter = group_data_provider->IterateGroupKeys(fabric_index);
+    ESP_RETURN_ON_FALSE(group_key_iter, ESP_ERR_NO_MEM, TAG, "Failed to iterate the group keys");
     GroupDataProvider::GroupKey group_key;
-    while (iter->Next(group_key)) {
-        if (group_key.group_id == group_id) {
-            keyset_id = group_key.keyset_id;
-            iter->Release();
-            return true;
+    bool overflow = false;
+    while (group_key_iter->Next(group_key)) {
+        if (s_index.group_key_count == CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUPS_PER_FABRIC) {
+            overflow = true;
+            break;
+        }
+        s_index.group_keys[s_index.group_key_count++] = group_key;
+    }
+    group_key_iter->Release();
+    ESP_RETURN_ON_FALSE(!overflow, ESP_ERR_INVALID_SIZE, TAG, "The group key map has more than %d entries",
+                        CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUPS_PER_FABRIC);
+
+    auto keyset_iter = group_data_provider->IterateKeySets(fabric_index);
+    ESP_RETURN_ON_FALSE(keyset_iter, ESP_ERR_NO_MEM, TAG, "Failed to iterate the keysets");
+    GroupDataProvider::KeySet keyset;
+    while (keyset_iter->Next(keyset)) {
+        if (s_index.keyset_count == CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC) {
+            overflow = true;
+            break;
+        }
+        s_index.keyset_ids[s_index.keyset_count] = keyset.keyset_id;
+        s_index.keyset_policies[s_index.keyset_count] = keyset.policy;
+        s_index.keyset_count++;
+    }
+    keyset_iter->Release();
+    ESP_RETURN_ON_FALSE(!overflow, ESP_ERR_INVALID_SIZE, TAG, "There are more than %d keysets",
+                        CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC);
+    s_index.loaded = true;
+    return ESP_OK;
+}
+
+static void invalidate_index()
+{
+    s_index.loaded = false;
+}
+
+static int find_group_key(uint16_t group_id)
+{
+    for (uint16_t i = 0; i < s_index.group_key_count; ++i) {
+        if (s_index.group_keys[i].group_id == group_id) {
+            return i;
         }
     }
-    iter->Release();
-    return false;
+    return -1;
+}
+
+static int find_keyset(KeysetId keyset_id)
+{
+    for (uint16_t i = 0; i < s_index.keyset_count; ++i) {
+        if (s_index.keyset_ids[i] == keyset_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static esp_err_t remove_group_key_at(FabricIndex fabric_index, uint16_t index)
+{
+    GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+    if (group_data_provider->RemoveGroupKeyAt(fabric_index, index) != CHIP_NO_ERROR) {
+        invalidate_index();
+        ESP_LOGE(TAG, "Failed to remove the group key");
+        return ESP_FAIL;
+    }
+    // The following entries of the provider are shifted down as well
+    memmove(&s_index.group_keys[index], &s_index.group_keys[index + 1],
+            (s_index.group_key_count - index - 1) * sizeof(s_index.group_keys[0]));
+    s_index.group_key_count--;
+    return ESP_OK;
+}
+
+static esp_err_t bind_keyset_internal(FabricIndex fabric_index, uint16_t group_id, uint16_t keyset_id)
+{
+    GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+    int index = find_group_key(group_id);
+    if (index >= 0 && s_index.group_keys[index].keyset_id == keyset_id) {
+        return ESP_OK;
+    }
+    // A group is bound to one keyset per fabric, rebinding it replaces the entry in place
+    uint16_t map_index = index >= 0 ? index : s_index.group_key_count;
+    ESP_RETURN_ON_FALSE(map_index < CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUPS_PER_FABRIC, ESP_ERR_NO_MEM, TAG,
+                        "The group key map is full");
+    if (CHIP_NO_ERROR !=
+        group_data_provider->SetGroupKeyAt(fabric_index, map_index, GroupDataProvider::GroupKey(group_id, keyset_id))) {
+        invalidate_index();
+        ESP_LOGE(TAG, "Failed to bind keyset");
+        return ESP_FAIL;
+    }
+    s_index.group_keys[map_index] = GroupDataProvider::GroupKey(group_id, keyset_id);
+    if (index < 0) {
+        s_index.group_key_count++;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t unbind_keyset_internal(FabricIndex fabric_index, uint16_t group_id, uint16_t keyset_id)
+{
+    int index = find_group_key(group_id);
+    ESP_RETURN_ON_FALSE(index >= 0 && s_index.group_keys[index].keyset_id == keyset_id, ESP_ERR_NOT_FOUND, TAG,
+                        "Failed to find the group key");
+    return remove_group_key_at(fabric_index, index);
+}
+
+esp_err_t get_group_keyset(uint16_t group_id, uint16_t &keyset_id)
+{
+    FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
+    int index = find_group_key(group_id);
+    if (index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    keyset_id = s_index.group_keys[index].keyset_id;
+    return ESP_OK;
 }
 
 esp_err_t show_groups()
@@ -51,12 +188,14 @@ esp_err_t show_groups()
     ESP_LOGI(TAG, "  | Group Id   |  KeySet Id     |   Group Name                                          |");
     FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
     GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
     auto iter = group_data_provider->IterateGroupInfo(fabric_index);
     GroupDataProvider::GroupInfo group_info;
     if (iter) {
         while (iter->Next(group_info)) {
-            chip::KeysetId keyset_id;
-            if (find_keyset_id(fabric_index, group_info.group_id, keyset_id)) {
+            int index = find_group_key(group_info.group_id);
+            if (index >= 0) {
+                chip::KeysetId keyset_id = s_index.group_keys[index].keyset_id;
                 ESP_LOGI(TAG, "  | 0x%-12x  0x%-13x  %-50s |", group_info.group_id, keyset_id, group_info.name);
             } else {
                 ESP_LOGI(TAG, "  | 0x%-12x  %-15s  %-50s |", group_info.group_id, "None", group_info.name);
@@ -98,25 +237,38 @@ esp_err_t remove_group(uint16_t group_id)
     return ESP_OK;
 }
 
+esp_err_t add_groups(const uint16_t *group_ids, char *const *group_names, size_t count)
+{
+    ESP_RETURN_ON_FALSE(group_ids && group_names, ESP_ERR_INVALID_ARG, TAG, "group_ids and group_names cannot be NULL");
+    for (size_t i = 0; i < count; ++i) {
+        ESP_RETURN_ON_ERROR(add_group(group_names[i], group_ids[i]), TAG, "Failed to add group 0x%x", group_ids[i]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t remove_groups(const uint16_t *group_ids, size_t count)
+{
+    ESP_RETURN_ON_FALSE(group_ids, ESP_ERR_INVALID_ARG, TAG, "group_ids cannot be NULL");
+    for (size_t i = 0; i < count; ++i) {
+        ESP_RETURN_ON_ERROR(remove_group(group_ids[i]), TAG, "Failed to remove group 0x%x", group_ids[i]);
+    }
+    return ESP_OK;
+}
+
 esp_err_t show_keysets()
 {
     FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
-    GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
-    GroupDataProvider::KeySet keyset;
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
 
     ESP_LOGI(TAG, "  +-------------------------------------------------------------------------------------+");
     ESP_LOGI(TAG, "  | Available KeySets :                                                                 |");
     ESP_LOGI(TAG, "  +-------------------------------------------------------------------------------------+");
     ESP_LOGI(TAG, "  | KeySet Id   |   Key Policy                                                          |");
 
-    auto iter = group_data_provider->IterateKeySets(fabric_index);
-    if (iter) {
-        while (iter->Next(keyset)) {
-            ESP_LOGI(TAG, "  | 0x%-12x  %-66s  |", keyset.keyset_id,
-                     (keyset.policy == GroupDataProvider::SecurityPolicy::kCacheAndSync) ? "Cache and Sync"
-                                                                                         : "Trust First");
-        }
-        iter->Release();
+    for (uint16_t i = 0; i < s_index.keyset_count; ++i) {
+        ESP_LOGI(TAG, "  | 0x%-12x  %-66s  |", s_index.keyset_ids[i],
+                 (s_index.keyset_policies[i] == GroupDataProvider::SecurityPolicy::kCacheAndSync) ? "Cache and Sync"
+                                                                                                  : "Trust First");
     }
     ESP_LOGI(TAG, "  +-------------------------------------------------------------------------------------+");
     return ESP_OK;
@@ -124,42 +276,39 @@ esp_err_t show_keysets()
 
 esp_err_t bind_keyset(uint16_t group_id, uint16_t keyset_id)
 {
-    size_t current_count = 0;
     FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
-    GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
+    return bind_keyset_internal(fabric_index, group_id, keyset_id);
+}
 
-    auto iter = group_data_provider->IterateGroupKeys(fabric_index);
-    current_count = iter->Count();
-    iter->Release();
+esp_err_t unbind_keyset(uint16_t group_id, uint16_t keyset_id)
+{
+    FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
+    return unbind_keyset_internal(fabric_index, group_id, keyset_id);
+}
 
-    if (CHIP_NO_ERROR !=
-        group_data_provider->SetGroupKeyAt(fabric_index, current_count,
-                                           GroupDataProvider::GroupKey(group_id, keyset_id))) {
-        ESP_LOGE(TAG, "Failed to bind keyset");
-        return ESP_FAIL;
+esp_err_t bind_keyset_to_groups(const uint16_t *group_ids, size_t count, uint16_t keyset_id)
+{
+    ESP_RETURN_ON_FALSE(group_ids, ESP_ERR_INVALID_ARG, TAG, "group_ids cannot be NULL");
+    FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
+    for (size_t i = 0; i < count; ++i) {
+        ESP_RETURN_ON_ERROR(bind_keyset_internal(fabric_index, group_ids[i], keyset_id), TAG,
+                            "Failed to bind keyset 0x%x to group 0x%x", keyset_id, group_ids[i]);
     }
     return ESP_OK;
 }
 
-esp_err_t unbind_keyset(uint16_t group_id, uint16_t keyset_id)
+esp_err_t unbind_keyset_from_groups(const uint16_t *group_ids, size_t count, uint16_t keyset_id)
 {
-    size_t index = 0;
+    ESP_RETURN_ON_FALSE(group_ids, ESP_ERR_INVALID_ARG, TAG, "group_ids cannot be NULL");
     FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
-    GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
-
-    auto iter = group_data_provider->IterateGroupKeys(fabric_index);
-    size_t max_count = iter->Count();
-    GroupDataProvider::GroupKey group_key;
-    while (iter->Next(group_key)) {
-        if (group_key.group_id == group_id && group_key.keyset_id == keyset_id) {
-            break;
-        }
-        index++;
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
+    for (size_t i = 0; i < count; ++i) {
+        ESP_RETURN_ON_ERROR(unbind_keyset_internal(fabric_index, group_ids[i], keyset_id), TAG,
+                            "Failed to unbind keyset 0x%x from group 0x%x", keyset_id, group_ids[i]);
     }
-    iter->Release();
-    ESP_RETURN_ON_FALSE(index < max_count, ESP_ERR_NOT_FOUND, TAG, "Failed to find the group key");
-    ESP_RETURN_ON_FALSE(CHIP_NO_ERROR == group_data_provider->RemoveGroupKeyAt(fabric_index, index), ESP_FAIL, TAG,
-                        "Failed to remove the group key");
     return ESP_OK;
 }
 
@@ -193,11 +342,20 @@ esp_err_t add_keyset(uint16_t keyset_id, uint8_t key_policy, uint64_t validity_t
     }
     memcpy(epoch_key.key, epoch_key_buf, GroupDataProvider::EpochKey::kLengthBytes);
     memcpy(keyset.epoch_keys, &epoch_key, sizeof(GroupDataProvider::EpochKey));
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
+    int index = find_keyset(keyset_id);
+    ESP_RETURN_ON_FALSE(index >= 0 || s_index.keyset_count < CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC,
+                        ESP_ERR_NO_MEM, TAG, "The keysets are full");
     if (CHIP_NO_ERROR != group_data_provider->SetKeySet(fabric_index, compressed_fabric_id_span, keyset)) {
+        invalidate_index();
         ESP_LOGE(TAG, "Failed to set keyset");
         return ESP_FAIL;
     }
-
+    if (index < 0) {
+        index = s_index.keyset_count++;
+        s_index.keyset_ids[index] = keyset_id;
+    }
+    s_index.keyset_policies[index] = keyset.policy;
     return ESP_OK;
 }
 
@@ -205,28 +363,22 @@ esp_err_t remove_keyset(uint16_t keyset_id)
 {
     FabricIndex fabric_index = esp_matter::controller::matter_controller_client::get_instance().get_fabric_index();
     GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+    ESP_RETURN_ON_ERROR(load_index(fabric_index), TAG, "Failed to load the group index");
 
-    size_t index = 0;
-    CHIP_ERROR err = CHIP_NO_ERROR;
-    auto iter = group_data_provider->IterateGroupKeys(fabric_index);
-    GroupDataProvider::GroupKey group_key;
-    while (iter->Next(group_key)) {
-        if (group_key.keyset_id == keyset_id) {
-            err = group_data_provider->RemoveGroupKeyAt(fabric_index, index);
-            if (err != CHIP_NO_ERROR) {
-                break;
-            }
+    // Unbind the groups from the last one so that the positions of the remaining entries stay valid
+    for (int i = s_index.group_key_count - 1; i >= 0; --i) {
+        if (s_index.group_keys[i].keyset_id == keyset_id) {
+            ESP_RETURN_ON_ERROR(remove_group_key_at(fabric_index, i), TAG, "Failed to unbind the keyset");
         }
-        index++;
-    }
-    iter->Release();
-
-    if (err == CHIP_NO_ERROR) {
-        return ESP_OK;
     }
     ESP_RETURN_ON_FALSE(CHIP_NO_ERROR == group_data_provider->RemoveKeySet(fabric_index, keyset_id), ESP_FAIL, TAG,
                         "Failed to remove the keyset");
-
+    int index = find_keyset(keyset_id);
+    if (index >= 0) {
+        s_index.keyset_count--;
+        s_index.keyset_ids[index] = s_index.keyset_ids[s_index.keyset_count];
+        s_index.keyset_policies[index] = s_index.keyset_policies[s_index.keyset_count];
+    }
     return ESP_OK;
 }
 
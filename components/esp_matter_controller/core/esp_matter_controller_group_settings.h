@@ -14,6 +14,8 @@
 
 #pragma once
 #include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
 
 namespace esp_matter {
 namespace controller {
@@ -46,6 +48,40 @@ esp_err_t add_group(char *group_name, uint16_t group_id);
  */
 esp_err_t remove_group(uint16_t group_id);
 
+/**
+ * Add a list of groups
+ *
+ * @param[in] group_ids Group IDs
+ * @param[in] group_names Group names
+ * @param[in] count Number of groups
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure, the groups before the failed one are added
+ */
+esp_err_t add_groups(const uint16_t *group_ids, char *const *group_names, size_t count);
+
+/**
+ * Leave a list of groups
+ *
+ * @param[in] group_ids Group IDs
+ * @param[in] count Number of groups
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure, the groups before the failed one are removed
+ */
+esp_err_t remove_groups(const uint16_t *group_ids, size_t count);
+
+/**
+ * Get the group keyset bound to a group
+ *
+ * @param[in] group_id Group ID
+ * @param[out] keyset_id Group Keyset ID
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_NOT_FOUND if no keyset is bound to the group
+ */
+esp_err_t get_group_keyset(uint16_t group_id, uint16_t &keyset_id);
+
 /**
  * Print group keysets
  */
@@ -73,6 +109,32 @@ esp_err_t bind_keyset(uint16_t group_id, uint16_t keyset_id);
  */
 esp_err_t unbind_keyset(uint16_t group_id, uint16_t keyset_id);
 
+/**
+ * Bind a group keyset to a list of groups
+ *
+ * A group already bound to another keyset is rebound to this one.
+ *
+ * @param[in] group_ids Group IDs
+ * @param[in] count Number of groups
+ * @param[in] keyset_id Group Keyset ID
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure, the groups before the failed one are bound
+ */
+esp_err_t bind_keyset_to_groups(const uint16_t *group_ids, size_t count, uint16_t keyset_id);
+
+/**
+ * Unbind a group keyset from a list of groups
+ *
+ * @param[in] group_ids Group IDs
+ * @param[in] count Number of groups
+ * @param[in] keyset_id Group Keyset ID
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure, the groups before the failed one are unbound
+ */
+esp_err_t unbind_keyset_from_groups(const uint16_t *group_ids, size_t count, uint16_t keyset_id);
+
 /**
  * Add a group keyset
  *
@@ -87,7 +149,7 @@ esp_err_t unbind_keyset(uint16_t group_id, uint16_t keyset_id);
 esp_err_t add_keyset(uint16_t keyset_id, uint8_t key_policy, uint64_t validity_time, char *epoch_key_oct_str);
 
 /**
- * Remove a group keyset
+ * Remove a group keyset, the groups bound to it are unbound
  *
  * @param[in] keyset_id Group Keyset ID
  *
@@ -0,0 +1,227 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_log.h>
+#include <esp_matter_controller_node_stats.h>
+
+#include <protocols/interaction_model/StatusCode.h>
+#include <system/SystemClock.h>
+
+static const char *TAG = "node_stats";
+
+using chip::Protocols::InteractionModel::Status;
+
+namespace esp_matter {
+namespace controller {
+
+static const uint32_t k_rtt_bucket_bounds_ms[node_stats::k_rtt_bucket_count - 1] = {50,   100,  250, 500,
+                                                                                     1000, 2500, 5000};
+static const char *k_request_type_names[node_stats::REQUEST_TYPE_MAX] = {"read", "write", "invoke", "subscribe"};
+
+static uint32_t elapsed_ms(uint64_t start_ms)
+{
+    uint64_t now = node_stats::timestamp_ms();
+    return now > start_ms ? (uint32_t)std::min<uint64_t>(now - start_ms, UINT32_MAX) : 0;
+}
+
+uint64_t node_stats::timestamp_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+node_stats::entry_t *node_stats::find_entry(uint64_t node_id)
+{
+    for (entry_t &e : m_entries) {
+        if (e.in_use && e.stats.node_id == node_id) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+node_stats::entry_t *node_stats::get_entry(uint64_t node_id)
+{
+    entry_t *e = find_entry(node_id);
+    if (!e) {
+        for (entry_t &candidate : m_entries) {
+            if (!candidate.in_use) {
+                e = &candidate;
+                break;
+            }
+            if (!e || candidate.last_used < e->last_used) {
+                e = &candidate;
+            }
+        }
+        if (e->in_use) {
+            ESP_LOGD(TAG, "Evict the statistics of node 0x%" PRIx64, e->stats.node_id);
+        }
+        *e = {};
+        e->in_use = true;
+        e->stats.node_id = node_id;
+    }
+    e->last_used = ++m_lru_clock;
+    return e;
+}
+
+bool node_stats::classify_error(entry_t *e, CHIP_ERROR error)
+{
+    if (error == CHIP_NO_ERROR) {
+        return true;
+    }
+    if (error == CHIP_ERROR_TIMEOUT) {
+        e->stats.timeouts++;
+        return false;
+    }
+    if (error.IsIMStatus()) {
+        Status status = chip::app::StatusIB(error).mStatus;
+        if (status == Status::Busy) {
+            e->stats.busy++;
+        } else if (status == Status::ResourceExhausted) {
+            e->stats.resource_exhausted++;
+        }
+        // The node responded with an error status
+        return true;
+    }
+    return false;
+}
+
+void node_stats::record_session(uint64_t node_id, uint64_t start_ms, CHIP_ERROR error)
+{
+    entry_t *e = get_entry(node_id);
+    if (error != CHIP_NO_ERROR) {
+        e->stats.session_failures++;
+        classify_error(e, error);
+        return;
+    }
+    uint32_t session_ms = elapsed_ms(start_ms);
+    e->stats.sessions++;
+    e->total_session_ms += session_ms;
+    e->stats.max_session_ms = std::max(e->stats.max_session_ms, session_ms);
+}
+
+void node_stats::record_request(uint64_t node_id, request_type_t type, uint64_t start_ms, CHIP_ERROR error)
+{
+    if (type >= REQUEST_TYPE_MAX) {
+        return;
+    }
+    entry_t *e = get_entry(node_id);
+    e->stats.requests[type]++;
+    if (error != CHIP_NO_ERROR) {
+        e->stats.failures++;
+    }
+    if (!classify_error(e, error)) {
+        return;
+    }
+    uint32_t rtt_ms = elapsed_ms(start_ms);
+    size_t bucket = 0;
+    while (bucket < k_rtt_bucket_count - 1 && rtt_ms >= k_rtt_bucket_bounds_ms[bucket]) {
+        bucket++;
+    }
+    e->stats.rtt_histogram[bucket]++;
+    e->rtt_count++;
+    e->total_rtt_ms += rtt_ms;
+    e->stats.max_rtt_ms = std::max(e->stats.max_rtt_ms, rtt_ms);
+}
+
+void node_stats::record_error(uint64_t node_id, CHIP_ERROR error)
+{
+    if (error != CHIP_NO_ERROR) {
+        classify_error(get_entry(node_id), error);
+    }
+}
+
+void node_stats::record_status(uint64_t node_id, const chip::app::StatusIB &status)
+{
+    if (status.mStatus == Status::Busy || status.mStatus == Status::ResourceExhausted) {
+        classify_error(get_entry(node_id), status.ToChipError());
+    }
+}
+
+void node_stats::record_report(uint64_t node_id, uint64_t previous_report_ms)
+{
+    entry_t *e = get_entry(node_id);
+    e->stats.reports++;
+    if (previous_report_ms == 0) {
+        return;
+    }
+    uint32_t interval_ms = elapsed_ms(previous_report_ms);
+    e->stats.last_report_interval_ms = interval_ms;
+    e->report_interval_count++;
+    e->total_report_interval_ms += interval_ms;
+    e->stats.max_report_interval_ms = std::max(e->stats.max_report_interval_ms, interval_ms);
+}
+
+void node_stats::fill_stats(const entry_t &e, stats_t &stats)
+{
+    stats = e.stats;
+    stats.avg_session_ms = e.stats.sessions ? e.total_session_ms / e.stats.sessions : 0;
+    stats.avg_rtt_ms = e.rtt_count ? e.total_rtt_ms / e.rtt_count : 0;
+    stats.avg_report_interval_ms = e.report_interval_count ? e.total_report_interval_ms / e.report_interval_count : 0;
+}
+
+esp_err_t node_stats::get_stats(uint64_t node_id, stats_t &stats)
+{
+    entry_t *e = find_entry(node_id);
+    if (!e) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    fill_stats(*e, stats);
+    return ESP_OK;
+}
+
+void node_stats::dump(uint64_t node_id)
+{
+    for (entry_t &e : m_entries) {
+        if (!e.in_use || (node_id != 0 && e.stats.node_id != node_id)) {
+            continue;
+        }
+        stats_t stats;
+        fill_stats(e, stats);
+        ESP_LOGI(TAG, "Node 0x%" PRIx64 ":", stats.node_id);
+        ESP_LOGI(TAG, "  sessions %" PRIu32 ", failures %" PRIu32 ", avg %" PRIu32 " ms, max %" PRIu32 " ms",
+                 stats.sessions, stats.session_failures, stats.avg_session_ms, stats.max_session_ms);
+        for (size_t i = 0; i < REQUEST_TYPE_MAX; ++i) {
+            if (stats.requests[i]) {
+                ESP_LOGI(TAG, "  %s requests %" PRIu32, k_request_type_names[i], stats.requests[i]);
+            }
+        }
+        ESP_LOGI(TAG,
+                 "  failures %" PRIu32 ", timeouts %" PRIu32 ", busy %" PRIu32 ", resource exhausted %" PRIu32,
+                 stats.failures, stats.timeouts, stats.busy, stats.resource_exhausted);
+        ESP_LOGI(TAG,
+                 "  rtt avg %" PRIu32 " ms, max %" PRIu32 " ms, <50: %" PRIu32 ", <100: %" PRIu32 ", <250: %" PRIu32
+                 ", <500: %" PRIu32 ", <1000: %" PRIu32 ", <2500: %" PRIu32 ", <5000: %" PRIu32 ", >=5000: %" PRIu32,
+                 stats.avg_rtt_ms, stats.max_rtt_ms, stats.rtt_histogram[0], stats.rtt_histogram[1],
+                 stats.rtt_histogram[2], stats.rtt_histogram[3], stats.rtt_histogram[4], stats.rtt_histogram[5],
+                 stats.rtt_histogram[6], stats.rtt_histogram[7]);
+        if (stats.reports) {
+            ESP_LOGI(TAG,
+                     "  reports %" PRIu32 ", interval last %" PRIu32 " ms, avg %" PRIu32 " ms, max %" PRIu32 " ms",
+                     stats.reports, stats.last_report_interval_ms, stats.avg_report_interval_ms,
+                     stats.max_report_interval_ms);
+        }
+    }
+}
+
+void node_stats::reset()
+{
+    for (entry_t &e : m_entries) {
+        e = {};
+    }
+    m_lru_clock = 0;
+}
+
+} // namespace controller
+} // namespace esp_matter
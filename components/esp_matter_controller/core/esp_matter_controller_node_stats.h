@@ -0,0 +1,139 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Latency and failure statistics of the interactions with each remote node
+ *
+ * The read, write, invoke and subscribe commands record the time taken to get a CASE session with the node, the
+ * round-trip time of their requests, the timeouts, the Busy and ResourceExhausted statuses returned by the node and
+ * the intervals between the reports of the subscriptions. The statistics of up to
+ * CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS_MAX_NODES nodes are kept, the least recently active node is evicted first.
+ *
+ * @note The session time includes the sessions already established with the node, which are reused immediately.
+ * @note All the APIs should be called in the Matter context or with the Matter stack lock.
+ */
+class node_stats {
+public:
+    typedef enum {
+        REQUEST_READ = 0,
+        REQUEST_WRITE,
+        REQUEST_INVOKE,
+        REQUEST_SUBSCRIBE,
+        REQUEST_TYPE_MAX,
+    } request_type_t;
+
+    // The round-trip times are counted in buckets of < 50, 100, 250, 500, 1000, 2500, 5000 and >= 5000 ms
+    static constexpr size_t k_rtt_bucket_count = 8;
+
+    typedef struct {
+        uint64_t node_id;
+        uint32_t sessions;
+        uint32_t session_failures;
+        uint32_t avg_session_ms;
+        uint32_t max_session_ms;
+        uint32_t requests[REQUEST_TYPE_MAX];
+        // Requests completed with an error, including the timeouts and the Busy and ResourceExhausted statuses
+        uint32_t failures;
+        uint32_t timeouts;
+        uint32_t busy;
+        uint32_t resource_exhausted;
+        // Round-trip times of the requests the node responded to
+        uint32_t rtt_histogram[k_rtt_bucket_count];
+        uint32_t avg_rtt_ms;
+        uint32_t max_rtt_ms;
+        uint32_t reports;
+        uint32_t last_report_interval_ms;
+        uint32_t avg_report_interval_ms;
+        uint32_t max_report_interval_ms;
+    } stats_t;
+
+    static node_stats &get_instance()
+    {
+        static node_stats s_instance;
+        return s_instance;
+    }
+
+    /** Monotonic timestamp to pass as the start of the recorded operations */
+    static uint64_t timestamp_ms();
+
+    /** Record the end of a CASE session lookup or establishment started at start_ms */
+    void record_session(uint64_t node_id, uint64_t start_ms, CHIP_ERROR error);
+
+    /** Record the completion of a request sent at start_ms, the error is classified with record_error() */
+    void record_request(uint64_t node_id, request_type_t type, uint64_t start_ms, CHIP_ERROR error);
+
+    /** Count a timeout, Busy or ResourceExhausted error which is not the completion of a request */
+    void record_error(uint64_t node_id, CHIP_ERROR error);
+
+    /** Count a Busy or ResourceExhausted status of an attribute or command path */
+    void record_status(uint64_t node_id, const chip::app::StatusIB &status);
+
+    /** Record a subscription report
+     *
+     * @param[in] node_id Remote NodeId
+     * @param[in] previous_report_ms Timestamp of the previous report of the same subscription, 0 if it is the first
+     *            report, which has no interval
+     */
+    void record_report(uint64_t node_id, uint64_t previous_report_ms);
+
+    /** Get the statistics of a node
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FOUND if there is no statistics for the node.
+     */
+    esp_err_t get_stats(uint64_t node_id, stats_t &stats);
+
+    /** Print the statistics of a node, or of all the nodes if node_id is 0 */
+    void dump(uint64_t node_id = 0);
+
+    /** Clear the statistics of all the nodes */
+    void reset();
+
+private:
+    typedef struct {
+        stats_t stats;
+        uint64_t total_session_ms;
+        uint64_t total_rtt_ms;
+        uint64_t total_report_interval_ms;
+        uint32_t rtt_count;
+        uint32_t report_interval_count;
+        uint32_t last_used;
+        bool in_use;
+    } entry_t;
+
+    node_stats() {}
+
+    entry_t *find_entry(uint64_t node_id);
+    // Find the entry of a node, or evict the least recently active node for it
+    entry_t *get_entry(uint64_t node_id);
+    // Count the error in the entry and return whether the node responded
+    bool classify_error(entry_t *e, CHIP_ERROR error);
+    void fill_stats(const entry_t &e, stats_t &stats);
+
+    entry_t m_entries[CONFIG_ESP_MATTER_CONTROLLER_NODE_STATS_MAX_NODES] = {};
+    uint32_t m_lru_clock = 0;
+};
+
+} // namespace controller
+} // namespace esp_matter
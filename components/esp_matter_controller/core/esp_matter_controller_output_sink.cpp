@@ -0,0 +1,354 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_controller_output_sink.h>
+
+#include <commands/clusters/DataModelLogger.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+using chip::TLV::TLVReader;
+using chip::TLV::TLVType;
+
+static const char *TAG = "output_sink";
+
+// Size of the buffer holding one binary record or one JSON line, the larger reports are dropped from the output.
+static constexpr size_t k_output_buf_size = 1024;
+
+namespace esp_matter {
+namespace controller {
+
+static uint8_t s_output_buf[k_output_buf_size];
+
+static void default_write_cb(const uint8_t *data, size_t len, void *ctx)
+{
+    fwrite(data, 1, len, stdout);
+}
+
+static output_write_cb_t s_write_cb = default_write_cb;
+static void *s_write_ctx = nullptr;
+
+class text_output_sink : public output_sink {
+public:
+    void on_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, TLVReader *data) override
+    {
+        if (DataModelLogger::LogAttribute(path, data) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+        }
+    }
+
+    void on_event(uint64_t node_id, const chip::app::EventHeader &header, TLVReader *data) override
+    {
+        if (DataModelLogger::LogEvent(header, data) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+        }
+    }
+};
+
+class binary_output_sink : public output_sink {
+public:
+    void on_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, TLVReader *data) override
+    {
+        output_binary_record_header_t header = {
+            .type = OUTPUT_RECORD_ATTRIBUTE,
+            .node_id = node_id,
+            .endpoint_id = path.mEndpointId,
+            .cluster_id = path.mClusterId,
+            .id = path.mAttributeId,
+            .version = path.mDataVersion.ValueOr(0),
+            .tlv_len = 0,
+        };
+        write_record(header, data);
+    }
+
+    void on_event(uint64_t node_id, const chip::app::EventHeader &event_header, TLVReader *data) override
+    {
+        output_binary_record_header_t header = {
+            .type = OUTPUT_RECORD_EVENT,
+            .node_id = node_id,
+            .endpoint_id = event_header.mPath.mEndpointId,
+            .cluster_id = event_header.mPath.mClusterId,
+            .id = event_header.mPath.mEventId,
+            .version = event_header.mEventNumber,
+            .tlv_len = 0,
+        };
+        write_record(header, data);
+    }
+
+private:
+    static void write_record(output_binary_record_header_t &header, TLVReader *data)
+    {
+        // The ESP32 targets are little-endian, so the packed header is written as is.
+        chip::TLV::TLVWriter writer;
+        writer.Init(s_output_buf + sizeof(header), sizeof(s_output_buf) - sizeof(header));
+        if (writer.CopyElement(chip::TLV::AnonymousTag(), *data) != CHIP_NO_ERROR || writer.Finalize() != CHIP_NO_ERROR) {
+            ESP_LOGW(TAG, "Report of cluster 0x%" PRIx32 " is too large for the binary output", header.cluster_id);
+            return;
+        }
+        header.tlv_len = static_cast<uint16_t>(writer.GetLengthWritten());
+        memcpy(s_output_buf, &header, sizeof(header));
+        s_write_cb(s_output_buf, sizeof(header) + header.tlv_len, s_write_ctx);
+    }
+};
+
+/* Minimal JSON serializer of a TLV element into s_output_buf, without intermediate allocations. */
+class json_writer {
+public:
+    bool append(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        if (m_overflow) {
+            return false;
+        }
+        va_list args;
+        va_start(args, fmt);
+        int len = vsnprintf((char *)s_output_buf + m_len, sizeof(s_output_buf) - m_len, fmt, args);
+        va_end(args);
+        if (len < 0 || (size_t)len >= sizeof(s_output_buf) - m_len) {
+            m_overflow = true;
+            return false;
+        }
+        m_len += len;
+        return true;
+    }
+
+    bool append_string(const char *str, size_t len)
+    {
+        append("\"");
+        for (size_t i = 0; i < len; ++i) {
+            char c = str[i];
+            if (c == '"' || c == '\\') {
+                append("\\%c", c);
+            } else if ((uint8_t)c < 0x20) {
+                append("\\u%04x", c);
+            } else {
+                append("%c", c);
+            }
+        }
+        return append("\"");
+    }
+
+    CHIP_ERROR append_element(TLVReader &reader)
+    {
+        switch (reader.GetType()) {
+        case TLVType::kTLVType_SignedInteger: {
+            int64_t value;
+            ReturnErrorOnFailure(reader.Get(value));
+            append("%" PRId64, value);
+            break;
+        }
+        case TLVType::kTLVType_UnsignedInteger: {
+            uint64_t value;
+            ReturnErrorOnFailure(reader.Get(value));
+            append("%" PRIu64, value);
+            break;
+        }
+        case TLVType::kTLVType_Boolean: {
+            bool value;
+            ReturnErrorOnFailure(reader.Get(value));
+            append(value ? "true" : "false");
+            break;
+        }
+        case TLVType::kTLVType_FloatingPointNumber: {
+            double value;
+            ReturnErrorOnFailure(reader.Get(value));
+            append("%g", value);
+            break;
+        }
+        case TLVType::kTLVType_UTF8String: {
+            chip::CharSpan value;
+            ReturnErrorOnFailure(reader.Get(value));
+            append_string(value.data(), value.size());
+            break;
+        }
+        case TLVType::kTLVType_ByteString: {
+            chip::ByteSpan value;
+            ReturnErrorOnFailure(reader.Get(value));
+            append("\"");
+            for (size_t i = 0; i < value.size(); ++i) {
+                append("%02x", value.data()[i]);
+            }
+            append("\"");
+            break;
+        }
+        case TLVType::kTLVType_Null:
+            append("null");
+            break;
+        case TLVType::kTLVType_Structure:
+        case TLVType::kTLVType_Array:
+        case TLVType::kTLVType_List: {
+            bool is_struct = reader.GetType() == TLVType::kTLVType_Structure;
+            TLVType container_type;
+            ReturnErrorOnFailure(reader.EnterContainer(container_type));
+            append(is_struct ? "{" : "[");
+            CHIP_ERROR err;
+            bool first = true;
+            while ((err = reader.Next()) == CHIP_NO_ERROR) {
+                if (!first) {
+                    append(",");
+                }
+                first = false;
+                if (is_struct) {
+                    chip::TLV::Tag tag = reader.GetTag();
+                    append("\"%" PRIu32 "\":", chip::TLV::IsContextTag(tag) ? chip::TLV::TagNumFromTag(tag) : 0);
+                }
+                ReturnErrorOnFailure(append_element(reader));
+            }
+            VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+            ReturnErrorOnFailure(reader.ExitContainer(container_type));
+            append(is_struct ? "}" : "]");
+            break;
+        }
+        default:
+            return CHIP_ERROR_INVALID_TLV_ELEMENT;
+        }
+        return m_overflow ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+    }
+
+    void flush()
+    {
+        if (m_overflow || !append("\n")) {
+            ESP_LOGW(TAG, "Report is too large for the JSON output");
+            return;
+        }
+        s_write_cb(s_output_buf, m_len, s_write_ctx);
+    }
+
+private:
+    size_t m_len = 0;
+    bool m_overflow = false;
+};
+
+class json_output_sink : public output_sink {
+public:
+    void on_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, TLVReader *data) override
+    {
+        json_writer writer;
+        writer.append("{\"node\":\"0x%" PRIx64 "\",\"endpoint\":%u,\"cluster\":%" PRIu32 ",\"attribute\":%" PRIu32,
+                      node_id, path.mEndpointId, path.mClusterId, path.mAttributeId);
+        if (path.mDataVersion.HasValue()) {
+            writer.append(",\"dataVersion\":%" PRIu32, path.mDataVersion.Value());
+        }
+        writer.append(",\"value\":");
+        write_value(writer, data);
+    }
+
+    void on_event(uint64_t node_id, const chip::app::EventHeader &header, TLVReader *data) override
+    {
+        json_writer writer;
+        writer.append("{\"node\":\"0x%" PRIx64 "\",\"endpoint\":%u,\"cluster\":%" PRIu32 ",\"event\":%" PRIu32
+                      ",\"eventNumber\":%" PRIu64 ",\"priority\":%u,\"value\":",
+                      node_id, header.mPath.mEndpointId, header.mPath.mClusterId, header.mPath.mEventId,
+                      header.mEventNumber, static_cast<unsigned>(header.mPriorityLevel));
+        write_value(writer, data);
+    }
+
+private:
+    static void write_value(json_writer &writer, TLVReader *data)
+    {
+        TLVReader reader;
+        reader.Init(*data);
+        if (writer.append_element(reader) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Response Failure: Can not encode Data");
+            return;
+        }
+        writer.append("}");
+        writer.flush();
+    }
+};
+
+static text_output_sink s_text_sink;
+static binary_output_sink s_binary_sink;
+static json_output_sink s_json_sink;
+static output_sink *s_custom_sink = nullptr;
+
+#if defined(CONFIG_ESP_MATTER_CONTROLLER_OUTPUT_FORMAT_NONE)
+static output_format_t s_default_format = OUTPUT_FORMAT_NONE;
+#elif defined(CONFIG_ESP_MATTER_CONTROLLER_OUTPUT_FORMAT_BINARY)
+static output_format_t s_default_format = OUTPUT_FORMAT_BINARY;
+#elif defined(CONFIG_ESP_MATTER_CONTROLLER_OUTPUT_FORMAT_JSON)
+static output_format_t s_default_format = OUTPUT_FORMAT_JSON;
+#else
+static output_format_t s_default_format = OUTPUT_FORMAT_TEXT;
+#endif
+
+output_sink *get_output_sink(output_format_t format)
+{
+    if (format == OUTPUT_FORMAT_DEFAULT) {
+        format = s_default_format;
+    }
+    switch (format) {
+    case OUTPUT_FORMAT_TEXT:
+        return &s_text_sink;
+    case OUTPUT_FORMAT_BINARY:
+        return &s_binary_sink;
+    case OUTPUT_FORMAT_JSON:
+        return &s_json_sink;
+    case OUTPUT_FORMAT_CUSTOM:
+        return s_custom_sink;
+    default:
+        return nullptr;
+    }
+}
+
+esp_err_t set_default_output_format(output_format_t format)
+{
+    VerifyOrReturnError(format > OUTPUT_FORMAT_DEFAULT && format <= OUTPUT_FORMAT_CUSTOM, ESP_ERR_INVALID_ARG);
+    VerifyOrReturnError(format != OUTPUT_FORMAT_CUSTOM || s_custom_sink, ESP_ERR_INVALID_STATE);
+    s_default_format = format;
+    return ESP_OK;
+}
+
+output_format_t get_default_output_format()
+{
+    return s_default_format;
+}
+
+void set_custom_output_sink(output_sink *sink)
+{
+    s_custom_sink = sink;
+}
+
+void set_output_write_cb(output_write_cb_t write_cb, void *ctx)
+{
+    s_write_cb = write_cb ? write_cb : default_write_cb;
+    s_write_ctx = write_cb ? ctx : nullptr;
+}
+
+esp_err_t output_format_from_str(const char *str, output_format_t &format)
+{
+    static const struct {
+        const char *name;
+        output_format_t format;
+    } k_formats[] = {
+        {"none", OUTPUT_FORMAT_NONE},     {"text", OUTPUT_FORMAT_TEXT},     {"binary", OUTPUT_FORMAT_BINARY},
+        {"json", OUTPUT_FORMAT_JSON},     {"custom", OUTPUT_FORMAT_CUSTOM},
+    };
+    VerifyOrReturnError(str, ESP_ERR_INVALID_ARG);
+    for (size_t i = 0; i < sizeof(k_formats) / sizeof(k_formats[0]); ++i) {
+        if (strcmp(str, k_formats[i].name) == 0) {
+            format = k_formats[i].format;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+} // namespace controller
+} // namespace esp_matter
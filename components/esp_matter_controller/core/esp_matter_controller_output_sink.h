@@ -0,0 +1,112 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/ConcreteAttributePath.h>
+#include <app/EventHeader.h>
+#include <lib/core/TLVReader.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** Output format of the attribute and event reports received by the read and subscribe commands */
+typedef enum {
+    /** Use the global output format set by set_default_output_format() */
+    OUTPUT_FORMAT_DEFAULT = 0,
+    /** Do not output the reports, only the command callbacks receive them */
+    OUTPUT_FORMAT_NONE,
+    /** Pretty-print the decoded reports through the log, as the console does */
+    OUTPUT_FORMAT_TEXT,
+    /** Compact binary records carrying the raw TLV of the reports, see output_binary_record_header_t */
+    OUTPUT_FORMAT_BINARY,
+    /** One JSON object per report, the TLV structures are output with their context tags as keys */
+    OUTPUT_FORMAT_JSON,
+    /** Application output sink set by set_custom_output_sink() */
+    OUTPUT_FORMAT_CUSTOM,
+} output_format_t;
+
+/** Record type in the binary output */
+typedef enum : uint8_t {
+    OUTPUT_RECORD_ATTRIBUTE = 0,
+    OUTPUT_RECORD_EVENT = 1,
+} output_record_type_t;
+
+/** Header of the binary output records, all the fields are little-endian and the header is followed by tlv_len bytes
+ * of the TLV element of the attribute value or event data with an anonymous tag.
+ *
+ * For attributes, id is the AttributeId and version the DataVersion. For events, id is the EventId and version the
+ * EventNumber.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;
+    uint64_t node_id;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t id;
+    uint64_t version;
+    uint16_t tlv_len;
+} output_binary_record_header_t;
+
+/** Callback writing the binary and JSON output, the default one writes to stdout */
+using output_write_cb_t = void (*)(const uint8_t *data, size_t len, void *ctx);
+
+/** Output sink interface of the reports received by the read and subscribe commands */
+class output_sink {
+public:
+    virtual ~output_sink() {}
+
+    virtual void on_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                              chip::TLV::TLVReader *data) = 0;
+
+    virtual void on_event(uint64_t node_id, const chip::app::EventHeader &header, chip::TLV::TLVReader *data) = 0;
+};
+
+/** Get the output sink of a format, OUTPUT_FORMAT_DEFAULT resolves to the global output format
+ *
+ * @return nullptr if the reports should not be output.
+ */
+output_sink *get_output_sink(output_format_t format);
+
+/** Set the global output format, used by the commands whose output format is OUTPUT_FORMAT_DEFAULT
+ *
+ * @param[in] format Output format, OUTPUT_FORMAT_DEFAULT is not allowed
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the format is invalid.
+ * @return ESP_ERR_INVALID_STATE if the format is OUTPUT_FORMAT_CUSTOM and no custom output sink is set.
+ */
+esp_err_t set_default_output_format(output_format_t format);
+
+output_format_t get_default_output_format();
+
+/** Set the output sink used for OUTPUT_FORMAT_CUSTOM, the sink should outlive all the commands using it */
+void set_custom_output_sink(output_sink *sink);
+
+/** Set the callback writing the binary and JSON output
+ *
+ * @param[in] write_cb Write callback, nullptr to restore the default one writing to stdout
+ * @param[in] ctx Context passed to the callback
+ */
+void set_output_write_cb(output_write_cb_t write_cb, void *ctx);
+
+/** Parse an output format name: none, text, binary, json or custom */
+esp_err_t output_format_from_str(const char *str, output_format_t &format);
+
+} // namespace controller
+} // namespace esp_matter
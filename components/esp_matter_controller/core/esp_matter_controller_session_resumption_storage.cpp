@@ -0,0 +1,337 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_session_resumption_storage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+
+#include <string.h>
+
+#ifndef CONFIG_NVS_ENCRYPTION
+#error "The session resumption storage keeps the session secrets in NVS, it requires CONFIG_NVS_ENCRYPTION"
+#endif
+
+static const char *TAG = "session_resumption";
+
+using chip::CATValues;
+using chip::ScopedNodeId;
+using chip::Crypto::P256ECDHDerivedSecret;
+
+namespace esp_matter {
+namespace controller {
+
+static constexpr char k_index_key[] = "csr-idx";
+
+static uint64_t now_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+static void record_key(size_t slot, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "csr-%02x", (unsigned)slot);
+}
+
+esp_err_t session_resumption_storage::init(chip::PersistentStorageDelegate *storage)
+{
+    ESP_RETURN_ON_FALSE(storage, ESP_ERR_INVALID_ARG, TAG, "storage cannot be NULL");
+    m_storage = storage;
+    uint16_t size = sizeof(m_entries);
+    CHIP_ERROR err = m_storage->SyncGetKeyValue(k_index_key, m_entries, size);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) {
+        memset(m_entries, 0, sizeof(m_entries));
+        return ESP_OK;
+    }
+    if (err != CHIP_NO_ERROR || size != sizeof(m_entries)) {
+        // The cache size has changed or the index is corrupted, drop the persisted state
+        ESP_LOGW(TAG, "Discard the persisted session resumption state");
+        memset(m_entries, 0, sizeof(m_entries));
+        return clear();
+    }
+    for (const index_entry_t &entry : m_entries) {
+        if (entry.last_used > m_lru_clock) {
+            m_lru_clock = entry.last_used;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t session_resumption_storage::clear()
+{
+    ESP_RETURN_ON_FALSE(m_storage, ESP_ERR_INVALID_STATE, TAG, "Session resumption storage is not initialized");
+    char key[sizeof("csr-ff")];
+    for (size_t slot = 0; slot < CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE; ++slot) {
+        m_entries[slot] = {};
+        record_key(slot, key, sizeof(key));
+        m_storage->SyncDeleteKeyValue(key);
+    }
+    m_storage->SyncDeleteKeyValue(k_index_key);
+    return ESP_OK;
+}
+
+int session_resumption_storage::find_entry(const ScopedNodeId &node)
+{
+    for (size_t slot = 0; slot < CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE; ++slot) {
+        if (m_entries[slot].fabric_index != chip::kUndefinedFabricIndex &&
+            m_entries[slot].fabric_index == node.GetFabricIndex() && m_entries[slot].node_id == node.GetNodeId()) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+int session_resumption_storage::find_entry(ConstResumptionIdView resumption_id)
+{
+    for (size_t slot = 0; slot < CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE; ++slot) {
+        if (m_entries[slot].fabric_index != chip::kUndefinedFabricIndex &&
+            memcmp(m_entries[slot].resumption_id, resumption_id.data(), kResumptionIdSize) == 0) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+int session_resumption_storage::alloc_entry()
+{
+    int lru_slot = 0;
+    for (size_t slot = 0; slot < CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE; ++slot) {
+        if (m_entries[slot].fabric_index == chip::kUndefinedFabricIndex) {
+            return slot;
+        }
+        if (m_entries[slot].last_used < m_entries[lru_slot].last_used) {
+            lru_slot = slot;
+        }
+    }
+    ESP_LOGD(TAG, "Evict the resumption state of node 0x%" PRIx64, m_entries[lru_slot].node_id);
+    m_evictions++;
+    delete_entry(lru_slot);
+    return lru_slot;
+}
+
+CHIP_ERROR session_resumption_storage::load_record(size_t slot, P256ECDHDerivedSecret &shared_secret,
+                                                   CATValues &peer_cats)
+{
+    char key[sizeof("csr-ff")];
+    record_t record;
+    uint16_t size = sizeof(record);
+    record_key(slot, key, sizeof(key));
+    ReturnErrorOnFailure(m_storage->SyncGetKeyValue(key, &record, size));
+    VerifyOrReturnError(size == sizeof(record) && record.shared_secret_len <= shared_secret.Capacity(),
+                        CHIP_ERROR_INTERNAL);
+    memcpy(shared_secret.Bytes(), record.shared_secret, record.shared_secret_len);
+    shared_secret.SetLength(record.shared_secret_len);
+    for (size_t i = 0; i < chip::kMaxSubjectCATAttributeCount; ++i) {
+        peer_cats.values[i] = record.cats[i];
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR session_resumption_storage::delete_entry(size_t slot)
+{
+    char key[sizeof("csr-ff")];
+    record_key(slot, key, sizeof(key));
+    m_entries[slot] = {};
+    CHIP_ERROR err = m_storage->SyncDeleteKeyValue(key);
+    return err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND ? CHIP_NO_ERROR : err;
+}
+
+CHIP_ERROR session_resumption_storage::save_index()
+{
+    return m_storage->SyncSetKeyValue(k_index_key, m_entries, sizeof(m_entries));
+}
+
+void session_resumption_storage::start_pending(const ScopedNodeId &node)
+{
+    for (pending_t &pending : m_pending) {
+        if (pending.node == node) {
+            pending.start_ms = now_ms();
+            return;
+        }
+    }
+    // Overwrite the oldest pending handshake, it has most likely failed
+    m_pending[m_next_pending] = {node, now_ms()};
+    m_next_pending = (m_next_pending + 1) % k_max_pending;
+}
+
+bool session_resumption_storage::take_pending(const ScopedNodeId &node, uint64_t &start_ms)
+{
+    for (pending_t &pending : m_pending) {
+        if (pending.start_ms != 0 && pending.node == node) {
+            start_ms = pending.start_ms;
+            pending = {};
+            return true;
+        }
+    }
+    return false;
+}
+
+CHIP_ERROR session_resumption_storage::FindByScopedNodeId(const ScopedNodeId &node, ResumptionIdStorage &resumptionId,
+                                                          P256ECDHDerivedSecret &sharedSecret, CATValues &peerCATs)
+{
+    VerifyOrReturnError(m_storage, CHIP_ERROR_INCORRECT_STATE);
+    // The initiator looks up the peer at the beginning of every handshake
+    start_pending(node);
+    int slot = find_entry(node);
+    if (slot < 0) {
+        m_misses++;
+        return CHIP_ERROR_KEY_NOT_FOUND;
+    }
+    CHIP_ERROR err = load_record(slot, sharedSecret, peerCATs);
+    if (err != CHIP_NO_ERROR) {
+        m_misses++;
+        delete_entry(slot);
+        save_index();
+        return CHIP_ERROR_KEY_NOT_FOUND;
+    }
+    m_hits++;
+    memcpy(resumptionId.data(), m_entries[slot].resumption_id, kResumptionIdSize);
+    // The LRU order is only updated in RAM here, it is persisted with the index when the new session is saved
+    m_entries[slot].last_used = ++m_lru_clock;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR session_resumption_storage::FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId &node,
+                                                          P256ECDHDerivedSecret &sharedSecret, CATValues &peerCATs)
+{
+    VerifyOrReturnError(m_storage, CHIP_ERROR_INCORRECT_STATE);
+    int slot = find_entry(resumptionId);
+    VerifyOrReturnError(slot >= 0, CHIP_ERROR_KEY_NOT_FOUND);
+    ReturnErrorOnFailure(load_record(slot, sharedSecret, peerCATs));
+    node = ScopedNodeId(m_entries[slot].node_id, m_entries[slot].fabric_index);
+    m_entries[slot].last_used = ++m_lru_clock;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR session_resumption_storage::Save(const ScopedNodeId &node, ConstResumptionIdView resumptionId,
+                                            const P256ECDHDerivedSecret &sharedSecret, const CATValues &peerCATs)
+{
+    VerifyOrReturnError(m_storage, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(sharedSecret.Length() <= chip::Crypto::kMax_ECDH_Secret_Length, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    bool resumed = false;
+    int slot = find_entry(node);
+    if (slot >= 0) {
+        P256ECDHDerivedSecret previous_secret;
+        CATValues previous_cats;
+        if (load_record(slot, previous_secret, previous_cats) == CHIP_NO_ERROR) {
+            resumed = previous_secret.Length() == sharedSecret.Length() &&
+                memcmp(previous_secret.ConstBytes(), sharedSecret.ConstBytes(), sharedSecret.Length()) == 0;
+        }
+    } else {
+        slot = alloc_entry();
+    }
+
+    uint64_t start_ms = 0;
+    bool timed = take_pending(node, start_ms);
+    uint32_t duration_ms = timed ? now_ms() - start_ms : 0;
+    if (resumed) {
+        m_resumed_handshakes++;
+        if (timed) {
+            m_timed_resumed++;
+            m_total_resumed_ms += duration_ms;
+        }
+    } else {
+        m_full_handshakes++;
+        if (timed) {
+            m_timed_full++;
+            m_total_full_ms += duration_ms;
+        }
+    }
+    if (timed) {
+        ESP_LOGD(TAG, "%s handshake with node 0x%" PRIx64 " in %" PRIu32 " ms", resumed ? "Resumed" : "Full",
+                 node.GetNodeId(), duration_ms);
+    }
+
+    record_t record = {};
+    record.shared_secret_len = sharedSecret.Length();
+    memcpy(record.shared_secret, sharedSecret.ConstBytes(), sharedSecret.Length());
+    for (size_t i = 0; i < chip::kMaxSubjectCATAttributeCount; ++i) {
+        record.cats[i] = peerCATs.values[i];
+    }
+    char key[sizeof("csr-ff")];
+    record_key(slot, key, sizeof(key));
+    ReturnErrorOnFailure(m_storage->SyncSetKeyValue(key, &record, sizeof(record)));
+
+    index_entry_t &entry = m_entries[slot];
+    entry.fabric_index = node.GetFabricIndex();
+    entry.node_id = node.GetNodeId();
+    memcpy(entry.resumption_id, resumptionId.data(), kResumptionIdSize);
+    entry.last_used = ++m_lru_clock;
+    return save_index();
+}
+
+CHIP_ERROR session_resumption_storage::Delete(const ScopedNodeId &node)
+{
+    VerifyOrReturnError(m_storage, CHIP_ERROR_INCORRECT_STATE);
+    int slot = find_entry(node);
+    VerifyOrReturnError(slot >= 0, CHIP_ERROR_KEY_NOT_FOUND);
+    ReturnErrorOnFailure(delete_entry(slot));
+    return save_index();
+}
+
+CHIP_ERROR session_resumption_storage::DeleteAll(chip::FabricIndex fabricIndex)
+{
+    VerifyOrReturnError(m_storage, CHIP_ERROR_INCORRECT_STATE);
+    for (size_t slot = 0; slot < CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE; ++slot) {
+        if (m_entries[slot].fabric_index != chip::kUndefinedFabricIndex &&
+            m_entries[slot].fabric_index == fabricIndex) {
+            ReturnErrorOnFailure(delete_entry(slot));
+        }
+    }
+    return save_index();
+}
+
+void session_resumption_storage::get_stats(stats_t &stats)
+{
+    stats = {};
+    stats.full_handshakes = m_full_handshakes;
+    stats.resumed_handshakes = m_resumed_handshakes;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    stats.avg_full_ms = m_timed_full ? m_total_full_ms / m_timed_full : 0;
+    stats.avg_resumed_ms = m_timed_resumed ? m_total_resumed_ms / m_timed_resumed : 0;
+    if (m_timed_full && stats.avg_full_ms > stats.avg_resumed_ms) {
+        stats.time_saved_ms = (uint64_t)m_resumed_handshakes * (stats.avg_full_ms - stats.avg_resumed_ms);
+    }
+    for (const index_entry_t &entry : m_entries) {
+        if (entry.fabric_index != chip::kUndefinedFabricIndex) {
+            stats.entry_count++;
+        }
+    }
+}
+
+void session_resumption_storage::dump()
+{
+    stats_t stats;
+    get_stats(stats);
+    ESP_LOGI(TAG,
+             "%u/%u peers, full %" PRIu32 " (avg %" PRIu32 " ms), resumed %" PRIu32 " (avg %" PRIu32
+             " ms), saved %" PRIu64 " ms, hits %" PRIu32 ", misses %" PRIu32 ", evictions %" PRIu32,
+             (unsigned)stats.entry_count, CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE,
+             stats.full_handshakes, stats.avg_full_ms, stats.resumed_handshakes, stats.avg_resumed_ms,
+             stats.time_saved_ms, stats.hits, stats.misses, stats.evictions);
+    for (const index_entry_t &entry : m_entries) {
+        if (entry.fabric_index != chip::kUndefinedFabricIndex) {
+            ESP_LOGI(TAG, "Fabric %u node 0x%" PRIx64 ", last used %" PRIu32, entry.fabric_index, entry.node_id,
+                     entry.last_used);
+        }
+    }
+}
+
+} // namespace controller
+} // namespace esp_matter
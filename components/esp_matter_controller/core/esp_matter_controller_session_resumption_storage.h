@@ -0,0 +1,143 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/ScopedNodeId.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
+
+namespace esp_matter {
+namespace controller {
+
+/** CASE session resumption storage of the controller
+ *
+ * It keeps the resumption state of the last CASE session with up to
+ * CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE peers, the least recently used peer is evicted when it is
+ * full. The state is persisted through the controller storage delegate, so that the sessions established after a
+ * controller restart use the Sigma1 with resumption and Sigma2_Resume exchange instead of a full Sigma1-3 handshake
+ * with ECDH and signature verification. The state includes the shared secret of the sessions, so the storage requires
+ * the NVS encryption to keep it encrypted at rest.
+ *
+ * The handshakes are classified by comparing the shared secret saved at their end with the previous one of the peer:
+ * a resumed session keeps the shared secret of the session it resumes.
+ *
+ * @note All the APIs should be called in the Matter context or with the Matter stack lock.
+ */
+class session_resumption_storage : public chip::SessionResumptionStorage {
+public:
+    typedef struct {
+        // Handshakes completed with a full Sigma1-3 exchange
+        uint32_t full_handshakes;
+        // Handshakes completed with the resumption exchange
+        uint32_t resumed_handshakes;
+        // Lookups of the initiator finding a resumption state for the peer
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t avg_full_ms;
+        uint32_t avg_resumed_ms;
+        // Estimated time saved by the resumed handshakes, based on the average durations
+        uint64_t time_saved_ms;
+        size_t entry_count;
+    } stats_t;
+
+    static session_resumption_storage &get_instance()
+    {
+        static session_resumption_storage s_instance;
+        return s_instance;
+    }
+
+    /** Load the persisted resumption state
+     *
+     * @param[in] storage Storage delegate, it should outlive the session resumption storage
+     */
+    esp_err_t init(chip::PersistentStorageDelegate *storage);
+
+    /** Delete the resumption state of all the peers, the next sessions will use full handshakes */
+    esp_err_t clear();
+
+    void get_stats(stats_t &stats);
+
+    /** Print the statistics and the peers with a resumption state */
+    void dump();
+
+    /****************** SessionResumptionStorage Interface *****************/
+    CHIP_ERROR FindByScopedNodeId(const chip::ScopedNodeId &node, ResumptionIdStorage &resumptionId,
+                                  chip::Crypto::P256ECDHDerivedSecret &sharedSecret,
+                                  chip::CATValues &peerCATs) override;
+    CHIP_ERROR FindByResumptionId(ConstResumptionIdView resumptionId, chip::ScopedNodeId &node,
+                                  chip::Crypto::P256ECDHDerivedSecret &sharedSecret,
+                                  chip::CATValues &peerCATs) override;
+    CHIP_ERROR Save(const chip::ScopedNodeId &node, ConstResumptionIdView resumptionId,
+                    const chip::Crypto::P256ECDHDerivedSecret &sharedSecret, const chip::CATValues &peerCATs) override;
+    CHIP_ERROR Delete(const chip::ScopedNodeId &node);
+    CHIP_ERROR DeleteAll(chip::FabricIndex fabricIndex) override;
+
+private:
+    static constexpr size_t k_max_pending = 8;
+
+    typedef struct __attribute__((packed)) {
+        uint8_t fabric_index;
+        uint64_t node_id;
+        uint8_t resumption_id[kResumptionIdSize];
+        uint32_t last_used;
+    } index_entry_t;
+
+    typedef struct __attribute__((packed)) {
+        uint8_t shared_secret_len;
+        uint8_t shared_secret[chip::Crypto::kMax_ECDH_Secret_Length];
+        uint32_t cats[chip::kMaxSubjectCATAttributeCount];
+    } record_t;
+
+    // Handshake initiated by the controller, from the lookup of the peer to the save of the new session
+    typedef struct {
+        chip::ScopedNodeId node;
+        uint64_t start_ms;
+    } pending_t;
+
+    session_resumption_storage() {}
+
+    int find_entry(const chip::ScopedNodeId &node);
+    int find_entry(ConstResumptionIdView resumption_id);
+    int alloc_entry();
+    CHIP_ERROR load_record(size_t slot, chip::Crypto::P256ECDHDerivedSecret &shared_secret,
+                           chip::CATValues &peer_cats);
+    CHIP_ERROR delete_entry(size_t slot);
+    CHIP_ERROR save_index();
+    void start_pending(const chip::ScopedNodeId &node);
+    bool take_pending(const chip::ScopedNodeId &node, uint64_t &start_ms);
+
+    chip::PersistentStorageDelegate *m_storage = nullptr;
+    index_entry_t m_entries[CONFIG_ESP_MATTER_CONTROLLER_SESSION_RESUMPTION_CACHE_SIZE] = {};
+    uint32_t m_lru_clock = 0;
+    pending_t m_pending[k_max_pending] = {};
+    size_t m_next_pending = 0;
+
+    uint32_t m_full_handshakes = 0;
+    uint32_t m_resumed_handshakes = 0;
+    uint32_t m_hits = 0;
+    uint32_t m_misses = 0;
+    uint32_t m_evictions = 0;
+    uint32_t m_timed_full = 0;
+    uint32_t m_timed_resumed = 0;
+    uint64_t m_total_full_ms = 0;
+    uint64_t m_total_resumed_ms = 0;
+};
+
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,274 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the attestation trust stores of the controller on Linux:
+//
+//     attestation_trust_store_test dcl <kvs directory> <operations>...
+//     attestation_trust_store_test spiffs <partition directory> <ids>...
+//
+// The SPIFFS trust store is initialized with the PAA certificates of the partition directory, made by the test, then
+// looks up the PAAs with the SKIDs made of the ids. It prints the first SKID byte of each PAA found and the number of
+// accesses to the partition of the initialization and of each lookup.
+//
+// The DCL trust store looks up the PAA certificates in its cache and fetches the missing ones from a mock DCL, which
+// serves the host certificates of crypto/CHIPCryptoPAL.h. The cache is kept in the KVS directory, so that a second run
+// with the same directory starts with the cache of the first one, as after a reboot. The operations are:
+//
+//     time:<seconds>          set the system time, 0 before the first one
+//     get:<net>:<id>          look up the PAA with the SKID made of the id byte, on the main (m) or test (t) net
+//     clear                   clear the cache
+//
+// The mock DCL serves a PAA certificate for the ids below 0xD0, a 404 for the ids from 0xD0, a certificate with the
+// SKID of the next id from 0xE0 and a PAI certificate from 0xF0. The results are printed as '<name> <value>' lines,
+// numbered after the operations.
+
+#include <credentials/CHIPCert.h>
+#include <credentials/attestation_verifier/DefaultDeviceAttestationVerifier.h>
+#include <esp_crt_bundle.h>
+#include <esp_http_client.h>
+#include <esp_spiffs.h>
+#include <esp_matter_attestation_trust_store.h>
+#include <inttypes.h>
+#include <platform/KeyValueStoreManager.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+
+using namespace chip;
+using namespace chip::Credentials;
+
+static time_t s_time = 0;
+
+// The system time of the tested sources is set by the test
+extern "C" time_t time(time_t *tloc)
+{
+    if (tloc) {
+        *tloc = s_time;
+    }
+    return s_time;
+}
+
+static void make_skid(uint8_t id, uint8_t *skid)
+{
+    for (size_t index = 0; index < Crypto::kSubjectKeyIdentifierLength; ++index) {
+        skid[index] = static_cast<uint8_t>(id + index);
+    }
+}
+
+// A host certificate of crypto/CHIPCryptoPAL.h, the content tells the certificates of both nets apart
+static std::string make_cert(uint8_t id, Crypto::AttestationCertType type, bool test_net)
+{
+    std::string cert = "CERT";
+    cert.push_back(static_cast<char>(type));
+    uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+    make_skid(id, skid);
+    cert.append(reinterpret_cast<const char *>(skid), sizeof(skid));
+    cert += test_net ? "test-net PAA certificate" : "main-net PAA certificate";
+    return cert;
+}
+
+static std::string base64_encode(const std::string &data)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t index = 0; index < data.size(); index += 3) {
+        uint32_t bits = static_cast<uint8_t>(data[index]) << 16;
+        size_t len = data.size() - index < 3 ? data.size() - index : 3;
+        if (len > 1) {
+            bits |= static_cast<uint8_t>(data[index + 1]) << 8;
+        }
+        if (len > 2) {
+            bits |= static_cast<uint8_t>(data[index + 2]);
+        }
+        for (size_t out_index = 0; out_index < 4; ++out_index) {
+            out.push_back(out_index <= len ? alphabet[(bits >> (18 - 6 * out_index)) & 0x3F] : '=');
+        }
+    }
+    return out;
+}
+
+// Mock DCL
+struct esp_http_client {
+    std::string url;
+    int status;
+    std::string response;
+};
+
+static size_t s_http_requests = 0;
+
+static uint8_t hex_byte(const char *str)
+{
+    char hex[3] = {str[0], str[1], 0};
+    return static_cast<uint8_t>(strtoul(hex, nullptr, 16));
+}
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
+{
+    esp_http_client *client = new esp_http_client();
+    client->url = config->url;
+    return client;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_open(esp_http_client_handle_t client, int write_len)
+{
+    s_http_requests++;
+    bool test_net = client->url.find("test-net") != std::string::npos;
+    size_t pos = client->url.find("subjectKeyId=");
+    if (pos == std::string::npos) {
+        return ESP_FAIL;
+    }
+    uint8_t id = hex_byte(client->url.c_str() + pos + strlen("subjectKeyId="));
+    if (id >= 0xD0 && id < 0xE0) {
+        client->status = HttpStatus_NotFound;
+        return ESP_OK;
+    }
+    std::string cert = make_cert(id >= 0xE0 && id < 0xF0 ? id + 1 : id,
+                                 id >= 0xF0 ? Crypto::AttestationCertType::kPAI : Crypto::AttestationCertType::kPAA,
+                                 test_net);
+    client->status = HttpStatus_Ok;
+    client->response = "{\"approvedCertificates\":[{\"subjectKeyId\":\"" + client->url.substr(pos + 13) +
+        "\",\"certs\":[{\"pemCert\":\"-----BEGIN CERTIFICATE-----\\n" + base64_encode(cert) +
+        "\\n-----END CERTIFICATE-----\\n\",\"isRoot\":true}]}]}";
+    return ESP_OK;
+}
+
+int64_t esp_http_client_fetch_headers(esp_http_client_handle_t client)
+{
+    return static_cast<int64_t>(client->response.size());
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client)
+{
+    return client->status;
+}
+
+int esp_http_client_read_response(esp_http_client_handle_t client, char *buffer, int len)
+{
+    int read_len = static_cast<int>(client->response.size()) < len ? static_cast<int>(client->response.size()) : len;
+    memcpy(buffer, client->response.data(), read_len);
+    return read_len;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t client)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
+{
+    delete client;
+    return ESP_OK;
+}
+
+esp_err_t esp_crt_bundle_attach(void *conf)
+{
+    return ESP_OK;
+}
+
+const AttestationTrustStore *chip::Credentials::GetTestAttestationTrustStore()
+{
+    return nullptr;
+}
+
+static int test_dcl(int argc, char **argv)
+{
+    host_test::set_kvs_dir(argv[0]);
+    dcl_attestation_trust_store &store = dcl_attestation_trust_store::get_instance();
+    for (int index = 1; index < argc; ++index) {
+        const char *op = argv[index];
+        if (strncmp(op, "time:", 5) == 0) {
+            s_time = static_cast<time_t>(strtoll(op + 5, nullptr, 0));
+        } else if (strcmp(op, "clear") == 0) {
+            printf("clear_%d 0x%" PRIx32 "\n", index, dcl_paa_cache::get_instance().clear().AsInteger());
+        } else if (strncmp(op, "get:", 4) == 0 && strlen(op) > 6) {
+            bool test_net = op[4] == 't';
+            uint8_t id = static_cast<uint8_t>(strtoul(op + 6, nullptr, 0));
+            store.SetDCLNetType(test_net ? dcl_attestation_trust_store::DCL_TEST_NET
+                                         : dcl_attestation_trust_store::DCL_MAIN_NET);
+            uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+            make_skid(id, skid);
+            uint8_t buf[kMaxDERCertLength];
+            MutableByteSpan paa(buf);
+            size_t requests = s_http_requests;
+            CHIP_ERROR err = store.GetProductAttestationAuthorityCert(ByteSpan(skid), paa);
+            std::string expected = make_cert(id, Crypto::AttestationCertType::kPAA, test_net);
+            printf("get_%d 0x%" PRIx32 "\n", index, err.AsInteger());
+            printf("fetched_%d %zu\n", index, s_http_requests - requests);
+            if (err == CHIP_NO_ERROR) {
+                printf("cert_%d %d\n", index,
+                       paa.size() == expected.size() && memcmp(paa.data(), expected.data(), paa.size()) == 0);
+            }
+        } else {
+            fprintf(stderr, "Invalid operation %s\n", op);
+            return 1;
+        }
+    }
+    dcl_paa_cache::stats_t stats;
+    dcl_paa_cache::get_instance().get_stats(stats);
+    printf("hits %" PRIu32 "\n", stats.hits);
+    printf("misses %" PRIu32 "\n", stats.misses);
+    printf("evictions %" PRIu32 "\n", stats.evictions);
+    printf("entry_count %zu\n", stats.entry_count);
+    printf("http_requests %zu\n", s_http_requests);
+    printf("kvs_writes %zu\n", host_test::kvs_write_count());
+    return 0;
+}
+
+static int test_spiffs(int argc, char **argv)
+{
+    host_test::set_spiffs_dir(argv[0]);
+    spiffs_attestation_trust_store &store = spiffs_attestation_trust_store::get_instance();
+    printf("init %d\n", store.init());
+    printf("init_accesses %zu\n", host_test::spiffs_access_count());
+    for (int index = 1; index < argc; ++index) {
+        uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+        make_skid(static_cast<uint8_t>(strtoul(argv[index], nullptr, 0)), skid);
+        uint8_t buf[kMaxDERCertLength];
+        MutableByteSpan paa(buf);
+        size_t accesses = host_test::spiffs_access_count();
+        CHIP_ERROR err = store.GetProductAttestationAuthorityCert(ByteSpan(skid), paa);
+        printf("get_%d 0x%" PRIx32 "\n", index, err.AsInteger());
+        printf("accesses_%d %zu\n", index, host_test::spiffs_access_count() - accesses);
+        if (err == CHIP_NO_ERROR) {
+            uint8_t paa_skid[Crypto::kSubjectKeyIdentifierLength];
+            MutableByteSpan paa_skid_span(paa_skid);
+            if (Crypto::ExtractSKIDFromX509Cert(paa, paa_skid_span) == CHIP_NO_ERROR) {
+                printf("id_%d %u\n", index, paa_skid[0]);
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 1;
+    if (argc >= 3 && strcmp(argv[1], "dcl") == 0) {
+        ret = test_dcl(argc - 2, argv + 2);
+    } else if (argc >= 3 && strcmp(argv[1], "spiffs") == 0) {
+        ret = test_spiffs(argc - 2, argv + 2);
+    } else {
+        fprintf(stderr, "Usage: %s dcl <kvs directory> <operations>...\n", argv[0]);
+        fprintf(stderr, "       %s spiffs <partition directory> <ids>...\n", argv[0]);
+    }
+    return ret;
+}
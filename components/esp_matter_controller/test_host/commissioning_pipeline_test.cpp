@@ -0,0 +1,184 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the commissioning pipeline of the controller on Linux:
+//
+//     commissioning_pipeline_test <operations>...
+//
+// The pipeline drives the host commissioner of controller/CHIPDeviceController.h, which records the calls of the
+// pipeline and completes nothing by itself: the operations play the part of the devices and of the commissioner. The
+// operations are:
+//
+//     add:<node>               add the node to the batch, with a setup code made of the node id
+//     start:<ahead>            start the pipeline with max_pase_ahead devices
+//     time:<ms>                advance the clock
+//     pase:<error>             complete the PASE session establishment in progress, 0 on success
+//     success:<node>           complete the commissioning of the node
+//     failure:<node>:<error>   fail the commissioning of the node at the SendNOC stage
+//     refuse:<node>            refuse the next call of the commissioner for the node
+//     stop                     stop the pipeline
+//     reset                    reset the batch
+//     status:<node>            print the status of the node
+//     report                   print the report of the batch
+//
+// The results are printed as '<name>_<index> <value>' lines, numbered after the operations. The calls of the
+// commissioner are printed as 'call_<count> <pase|commission|stop>:<node>' and the devices done as
+// 'done_<count> <node>:<error>', and the batches done as 'finished_<count> <total>'.
+
+#include <controller/CHIPDeviceController.h>
+#include <esp_matter_controller_client.h>
+#include <esp_matter_controller_commissioning_pipeline.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::Controller;
+using esp_matter::controller::commissioning_pipeline;
+
+static int s_call_count = 0;
+static int s_done_count = 0;
+static int s_finished_count = 0;
+static NodeId s_refused_node = kUndefinedNodeId;
+
+static CHIP_ERROR record_call(const char *name, NodeId node_id)
+{
+    printf("call_%d %s:%" PRIu64 "\n", ++s_call_count, name, node_id);
+    if (node_id == s_refused_node) {
+        s_refused_node = kUndefinedNodeId;
+        return CHIP_ERROR_INTERNAL;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, const char *setUpCode,
+                                                       DiscoveryType discoveryType)
+{
+    char expected[32];
+    snprintf(expected, sizeof(expected), "MT:%" PRIu64, remoteDeviceId);
+    if (strcmp(setUpCode, expected) != 0 || discoveryType != DiscoveryType::kDiscoveryNetworkOnly) {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    return record_call("pase", remoteDeviceId);
+}
+
+CHIP_ERROR DeviceCommissioner::Commission(NodeId remoteDeviceId, CommissioningParameters &params)
+{
+    return record_call("commission", remoteDeviceId);
+}
+
+CHIP_ERROR DeviceCommissioner::StopPairing(NodeId remoteDeviceId)
+{
+    return record_call("stop", remoteDeviceId);
+}
+
+static void device_done(const commissioning_pipeline::device_status_t *status, void *ctx)
+{
+    printf("done_%d %" PRIu64 ":0x%" PRIx32 "\n", ++s_done_count, status->node_id, status->error.AsInteger());
+}
+
+static void pipeline_done(const commissioning_pipeline::report_t *report, void *ctx)
+{
+    printf("finished_%d %u\n", ++s_finished_count, report->total);
+}
+
+static DevicePairingDelegate *delegate()
+{
+    return esp_matter::controller::matter_controller_client::get_instance().get_commissioner()->GetPairingDelegate();
+}
+
+static void print_status(int index, NodeId node_id)
+{
+    commissioning_pipeline::device_status_t status;
+    esp_err_t err = commissioning_pipeline::get_instance().get_device_status(node_id, status);
+    printf("status_%d 0x%x\n", index, err);
+    if (err == ESP_OK) {
+        printf("state_%d %d\n", index, status.state);
+        printf("error_%d 0x%" PRIx32 "\n", index, status.error.AsInteger());
+        printf("stage_%d %d\n", index, status.stage);
+        printf("pase_ms_%d %" PRIu32 "\n", index, status.pase_ms);
+        printf("wait_ms_%d %" PRIu32 "\n", index, status.wait_ms);
+        printf("commissioning_ms_%d %" PRIu32 "\n", index, status.commissioning_ms);
+    }
+}
+
+static void print_report(int index)
+{
+    commissioning_pipeline::report_t report;
+    commissioning_pipeline::get_instance().get_report(report);
+    printf("total_%d %u\n", index, report.total);
+    printf("succeeded_%d %u\n", index, report.succeeded);
+    printf("failed_%d %u\n", index, report.failed);
+    printf("elapsed_ms_%d %" PRIu32 "\n", index, report.elapsed_ms);
+    printf("avg_pase_ms_%d %" PRIu32 "\n", index, report.avg_pase_ms);
+    printf("avg_commissioning_ms_%d %" PRIu32 "\n", index, report.avg_commissioning_ms);
+    // Printed in tenths, the test parses integers
+    printf("devices_per_minute_x10_%d %d\n", index, (int)(report.devices_per_minute * 10 + 0.5f));
+}
+
+int main(int argc, char **argv)
+{
+    commissioning_pipeline &pipeline = commissioning_pipeline::get_instance();
+    host_test::set_time_ms(1000);
+    for (int i = 1; i < argc; ++i) {
+        char *op = argv[i];
+        char *arg = strchr(op, ':');
+        if (arg) {
+            *arg++ = '\0';
+        }
+        if (strcmp(op, "add") == 0) {
+            char setup_code[32];
+            NodeId node_id = strtoull(arg, nullptr, 0);
+            snprintf(setup_code, sizeof(setup_code), "MT:%" PRIu64, node_id);
+            printf("add_%d 0x%x\n", i, pipeline.add_device(node_id, setup_code));
+        } else if (strcmp(op, "start") == 0) {
+            commissioning_pipeline::config_t config;
+            config.max_pase_ahead = strtoul(arg, nullptr, 0);
+            config.device_done_cb = device_done;
+            config.pipeline_done_cb = pipeline_done;
+            printf("start_%d 0x%x\n", i, pipeline.start(config));
+        } else if (strcmp(op, "time") == 0) {
+            host_test::advance_time_ms(strtoull(arg, nullptr, 0));
+        } else if (strcmp(op, "pase") == 0) {
+            delegate()->OnPairingComplete(CHIP_ERROR(strtoul(arg, nullptr, 0)));
+        } else if (strcmp(op, "success") == 0) {
+            delegate()->OnCommissioningSuccess(PeerId(0, strtoull(arg, nullptr, 0)));
+        } else if (strcmp(op, "failure") == 0) {
+            char *error = strchr(arg, ':');
+            *error++ = '\0';
+            PeerId peer_id(0, strtoull(arg, nullptr, 0));
+            delegate()->OnCommissioningStatusUpdate(peer_id, kSendNOC, CHIP_ERROR(strtoul(error, nullptr, 0)));
+            delegate()->OnCommissioningFailure(peer_id, CHIP_ERROR(strtoul(error, nullptr, 0)), kSendNOC,
+                                               Optional<Credentials::AttestationVerificationResult>());
+        } else if (strcmp(op, "refuse") == 0) {
+            s_refused_node = strtoull(arg, nullptr, 0);
+        } else if (strcmp(op, "stop") == 0) {
+            pipeline.stop();
+        } else if (strcmp(op, "reset") == 0) {
+            printf("reset_%d 0x%x\n", i, pipeline.reset());
+        } else if (strcmp(op, "status") == 0) {
+            print_status(i, strtoull(arg, nullptr, 0));
+        } else if (strcmp(op, "report") == 0) {
+            print_report(i);
+        } else {
+            fprintf(stderr, "Unknown operation %s\n", op);
+            return 1;
+        }
+        printf("running_%d %d\n", i, pipeline.is_running());
+    }
+    return 0;
+}
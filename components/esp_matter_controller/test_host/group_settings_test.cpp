@@ -0,0 +1,272 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the group settings of the controller on Linux:
+//
+//     group_settings_test <operations>...
+//
+// The group settings use a test group data provider, which keeps the group key map and the keysets of the fabric in
+// RAM and counts the steps of its iterators, each of which reads the persistent storage with the provider of the Matter
+// SDK. The operations are:
+//
+//     preload:<count>:<keyset>           add the group key map entries of the groups 1 to count to the provider, as
+//                                        another firmware would have
+//     preload_keysets:<count>            add the keysets 1 to count to the provider
+//     keyset:<keyset> / remove_keyset:<keyset>
+//     group:<group>
+//     bind:<group>:<keyset> / unbind:<group>:<keyset>
+//     bind_range:<first group>:<count>:<keyset> / unbind_range:<first group>:<count>:<keyset>
+//     get:<group>                        look up the keyset bound to the group
+//     fail                               fail the next change of the provider
+//     map                                print the count and the last entry of the group key map of the provider
+//     steps                              print the iterator steps since the previous steps operation
+//
+// The results are printed as '<name>_<index> <value>' lines, numbered after the operations.
+
+#include <credentials/GroupDataProvider.h>
+#include <esp_matter_controller_client.h>
+#include <esp_matter_controller_group_settings.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace esp_matter::controller;
+
+namespace {
+
+template <typename T>
+class test_iterator : public GroupDataProvider::Iterator<T> {
+public:
+    test_iterator(const std::vector<T> &items, size_t &steps) : m_items(items), m_steps(steps) {}
+    size_t Count() override { return m_items.size(); }
+    bool Next(T &item) override
+    {
+        if (m_next == m_items.size()) {
+            return false;
+        }
+        m_steps++;
+        item = m_items[m_next++];
+        return true;
+    }
+    void Release() override { delete this; }
+
+private:
+    std::vector<T> m_items;
+    size_t &m_steps;
+    size_t m_next = 0;
+};
+
+class test_group_data_provider : public GroupDataProvider {
+public:
+    std::vector<GroupInfo> groups;
+    std::vector<GroupKey> group_keys;
+    std::vector<KeySet> keysets;
+    size_t steps = 0;
+    bool fail_next = false;
+
+    CHIP_ERROR SetGroupInfo(FabricIndex fabric_index, const GroupInfo &info) override
+    {
+        VerifyOrReturnError(!failed(), CHIP_ERROR_INTERNAL);
+        for (GroupInfo &group : groups) {
+            if (group.group_id == info.group_id) {
+                group = info;
+                return CHIP_NO_ERROR;
+            }
+        }
+        groups.push_back(info);
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR RemoveGroupInfo(FabricIndex fabric_index, GroupId group_id) override
+    {
+        VerifyOrReturnError(!failed(), CHIP_ERROR_INTERNAL);
+        for (size_t i = 0; i < groups.size(); ++i) {
+            if (groups[i].group_id == group_id) {
+                groups.erase(groups.begin() + i);
+                return CHIP_NO_ERROR;
+            }
+        }
+        return CHIP_ERROR_NOT_FOUND;
+    }
+    GroupInfoIterator *IterateGroupInfo(FabricIndex fabric_index) override
+    {
+        return new test_iterator<GroupInfo>(groups, steps);
+    }
+
+    CHIP_ERROR SetGroupKeyAt(FabricIndex fabric_index, size_t index, const GroupKey &info) override
+    {
+        VerifyOrReturnError(!failed(), CHIP_ERROR_INTERNAL);
+        // As the provider of the Matter SDK, an entry is replaced or appended at the end of the map
+        VerifyOrReturnError(index <= group_keys.size(), CHIP_ERROR_INVALID_ARGUMENT);
+        if (index == group_keys.size()) {
+            group_keys.push_back(info);
+        } else {
+            group_keys[index] = info;
+        }
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR RemoveGroupKeyAt(FabricIndex fabric_index, size_t index) override
+    {
+        VerifyOrReturnError(!failed(), CHIP_ERROR_INTERNAL);
+        VerifyOrReturnError(index < group_keys.size(), CHIP_ERROR_NOT_FOUND);
+        group_keys.erase(group_keys.begin() + index);
+        return CHIP_NO_ERROR;
+    }
+    GroupKeyIterator *IterateGroupKeys(FabricIndex fabric_index) override
+    {
+        return new test_iterator<GroupKey>(group_keys, steps);
+    }
+
+    CHIP_ERROR SetKeySet(FabricIndex fabric_index, const ByteSpan &compressed_fabric_id, const KeySet &keys) override
+    {
+        VerifyOrReturnError(!failed(), CHIP_ERROR_INTERNAL);
+        for (KeySet &keyset : keysets) {
+            if (keyset.keyset_id == keys.keyset_id) {
+                keyset = keys;
+                return CHIP_NO_ERROR;
+            }
+        }
+        keysets.push_back(keys);
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR RemoveKeySet(FabricIndex fabric_index, KeysetId keyset_id) override
+    {
+        VerifyOrReturnError(!failed(), CHIP_ERROR_INTERNAL);
+        for (size_t i = 0; i < keysets.size(); ++i) {
+            if (keysets[i].keyset_id == keyset_id) {
+                keysets.erase(keysets.begin() + i);
+                return CHIP_NO_ERROR;
+            }
+        }
+        return CHIP_ERROR_NOT_FOUND;
+    }
+    KeySetIterator *IterateKeySets(FabricIndex fabric_index) override
+    {
+        return new test_iterator<KeySet>(keysets, steps);
+    }
+
+private:
+    bool failed()
+    {
+        bool fail = fail_next;
+        fail_next = false;
+        return fail;
+    }
+};
+
+test_group_data_provider s_provider;
+
+} // namespace
+
+namespace chip {
+namespace Credentials {
+
+GroupDataProvider *GetGroupDataProvider()
+{
+    return &s_provider;
+}
+
+} // namespace Credentials
+
+namespace Controller {
+
+CHIP_ERROR DeviceCommissioner::GetCompressedFabricIdBytes(MutableByteSpan &outBytes) const
+{
+    VerifyOrReturnError(outBytes.size() >= sizeof(uint64_t), CHIP_ERROR_BUFFER_TOO_SMALL);
+    memset(outBytes.data(), 0xCF, sizeof(uint64_t));
+    outBytes.reduce_size(sizeof(uint64_t));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Controller
+} // namespace chip
+
+static std::vector<uint16_t> group_range(uint16_t first, uint16_t count)
+{
+    std::vector<uint16_t> group_ids;
+    for (uint16_t i = 0; i < count; ++i) {
+        group_ids.push_back(first + i);
+    }
+    return group_ids;
+}
+
+int main(int argc, char **argv)
+{
+    char epoch_key[] = "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf";
+    for (int i = 1; i < argc; ++i) {
+        char *op = argv[i];
+        unsigned long args[3] = {0, 0, 0};
+        char *arg = strchr(op, ':');
+        if (arg) {
+            *arg++ = '\0';
+        }
+        for (size_t j = 0; arg && j < 3; ++j) {
+            args[j] = strtoul(arg, &arg, 0);
+            arg = *arg == ':' ? arg + 1 : nullptr;
+        }
+        if (strcmp(op, "preload") == 0) {
+            for (unsigned long group_id = 1; group_id <= args[0]; ++group_id) {
+                s_provider.group_keys.push_back(GroupDataProvider::GroupKey(group_id, args[1]));
+            }
+        } else if (strcmp(op, "preload_keysets") == 0) {
+            for (unsigned long keyset_id = 1; keyset_id <= args[0]; ++keyset_id) {
+                s_provider.keysets.push_back(
+                    GroupDataProvider::KeySet(keyset_id, GroupDataProvider::SecurityPolicy::kTrustFirst, 1));
+            }
+        } else if (strcmp(op, "keyset") == 0) {
+            printf("keyset_%d 0x%x\n", i, group_settings::add_keyset(args[0], 0, 0, epoch_key));
+        } else if (strcmp(op, "remove_keyset") == 0) {
+            printf("remove_keyset_%d 0x%x\n", i, group_settings::remove_keyset(args[0]));
+        } else if (strcmp(op, "group") == 0) {
+            char name[16];
+            snprintf(name, sizeof(name), "group%lu", args[0]);
+            printf("group_%d 0x%x\n", i, group_settings::add_group(name, args[0]));
+        } else if (strcmp(op, "bind") == 0) {
+            printf("bind_%d 0x%x\n", i, group_settings::bind_keyset(args[0], args[1]));
+        } else if (strcmp(op, "unbind") == 0) {
+            printf("unbind_%d 0x%x\n", i, group_settings::unbind_keyset(args[0], args[1]));
+        } else if (strcmp(op, "bind_range") == 0) {
+            std::vector<uint16_t> group_ids = group_range(args[0], args[1]);
+            printf("bind_range_%d 0x%x\n", i,
+                   group_settings::bind_keyset_to_groups(group_ids.data(), group_ids.size(), args[2]));
+        } else if (strcmp(op, "unbind_range") == 0) {
+            std::vector<uint16_t> group_ids = group_range(args[0], args[1]);
+            printf("unbind_range_%d 0x%x\n", i,
+                   group_settings::unbind_keyset_from_groups(group_ids.data(), group_ids.size(), args[2]));
+        } else if (strcmp(op, "get") == 0) {
+            uint16_t keyset_id = 0;
+            printf("get_%d 0x%x\n", i, group_settings::get_group_keyset(args[0], keyset_id));
+            printf("keyset_id_%d %u\n", i, keyset_id);
+        } else if (strcmp(op, "fail") == 0) {
+            s_provider.fail_next = true;
+        } else if (strcmp(op, "map") == 0) {
+            printf("entries_%d %zu\n", i, s_provider.group_keys.size());
+            if (!s_provider.group_keys.empty()) {
+                const GroupDataProvider::GroupKey &last = s_provider.group_keys.back();
+                printf("last_%d %u:%u\n", i, last.group_id, last.keyset_id);
+            }
+            printf("keysets_%d %zu\n", i, s_provider.keysets.size());
+        } else if (strcmp(op, "steps") == 0) {
+            printf("steps_%d %zu\n", i, s_provider.steps);
+            s_provider.steps = 0;
+        } else {
+            fprintf(stderr, "Unknown operation %s\n", op);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the controller client, its commissioner is the host one of controller/CHIPDeviceController.h and its
+// fabric is the fabric index 1
+
+#pragma once
+
+#include <controller/CHIPDeviceController.h>
+#include <credentials/GroupDataProvider.h>
+
+namespace esp_matter {
+namespace controller {
+
+class matter_controller_client {
+public:
+    static matter_controller_client &get_instance()
+    {
+        static matter_controller_client s_instance;
+        return s_instance;
+    }
+
+    chip::Controller::DeviceCommissioner *get_commissioner() { return &m_device_commissioner; }
+    chip::FabricIndex get_fabric_index() { return 1; }
+
+private:
+    matter_controller_client() {}
+
+    chip::Controller::DeviceCommissioner m_device_commissioner;
+};
+
+} // namespace controller
+} // namespace esp_matter
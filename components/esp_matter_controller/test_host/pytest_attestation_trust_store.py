@@ -0,0 +1,339 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""
+Host test of the attestation trust stores of the controller built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_controller/test_host
+"""
+
+import pathlib
+import struct
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+CACHE_SIZE = 4
+TTL_DAYS = 30
+TTL_S = TTL_DAYS * 24 * 3600
+# A time after 2021-01-01, the cache does not check the age of the certificates before
+NOW = 1700000000
+CHIP_NO_ERROR = 0
+CHIP_ERROR_CA_CERT_NOT_FOUND = 0x4f
+CHIP_ERROR_INTERNAL = 0xac
+SPIFFS_OBJ_NAME_LEN = 32
+# The SKID index of the SPIFFS trust store
+INDEX_MAGIC = 0x58444B53
+INDEX_HEADER = struct.Struct('<III')
+INDEX_RECORD = struct.Struct(f'<20s{SPIFFS_OBJ_NAME_LEN}s')
+
+
+@pytest.fixture(scope='module')
+def trust_store(tmp_path_factory):
+    output = tmp_path_factory.mktemp('attestation_trust_store') / 'attestation_trust_store_test'
+    controller_dir = host_test.COMPONENTS_DIR / 'esp_matter_controller'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'attestation_trust_store_test.cpp',
+                            controller_dir / 'attestation_store' / 'esp_matter_attestation_trust_store.cpp'],
+                           [controller_dir / 'attestation_store', controller_dir / 'core'],
+                           chip=True,
+                           defines=['CONFIG_DCL_ATTESTATION_TRUST_STORE=1',
+                                    f'CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE={CACHE_SIZE}',
+                                    f'CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_TTL_DAYS={TTL_DAYS}',
+                                    f'CONFIG_SPIFFS_OBJ_NAME_LEN={SPIFFS_OBJ_NAME_LEN}'],
+                           # The component builds with -Wno-write-strings, and ESP-IDF with -Wno-sign-compare. The
+                           # size_t arguments of the logs are unsigned int on the ESP32 targets.
+                           cflags=['-Wno-write-strings', '-Wno-sign-compare', '-Wno-format'])
+
+
+def run_dcl(trust_store, kvs_dir, *operations):
+    return host_test.run(trust_store, 'dcl', kvs_dir, *operations)
+
+
+def make_skid(id):
+    return bytes((id + index) & 0xFF for index in range(20))
+
+
+def make_paa(id, content=b'PAA certificate'):
+    # The host certificates of tools/host_test/chip/crypto/CHIPCryptoPAL.h
+    return b'CERT\x00' + make_skid(id) + content
+
+
+def paa_name(id):
+    # The order of the names is not the order of the SKIDs
+    return f'paa-{id * 7919 % 1000:03d}.der'
+
+
+def make_store(store_dir, ids):
+    for id in ids:
+        (store_dir / paa_name(id)).write_bytes(make_paa(id))
+    (store_dir / 'README.txt').write_text('Not a certificate')
+
+
+def read_index(store_dir):
+    data = (store_dir / 'skid.idx').read_bytes()
+    magic, signature, count = INDEX_HEADER.unpack_from(data)
+    records = [INDEX_RECORD.unpack_from(data, INDEX_HEADER.size + index * INDEX_RECORD.size) for index in range(count)]
+    return magic, count, [(skid, name.rstrip(b'\x00').decode()) for skid, name in records]
+
+
+def write_index_records(store_dir, records):
+    index = store_dir / 'skid.idx'
+    header = index.read_bytes()[:INDEX_HEADER.size]
+    index.write_bytes(header + b''.join(INDEX_RECORD.pack(skid, name.encode()) for skid, name in records))
+
+
+def run_spiffs(trust_store, store_dir, *ids):
+    return host_test.run(trust_store, 'spiffs', store_dir, *ids)
+
+
+def init_accesses(count, index_built):
+    # The signature opens the directory and gets the size of each certificate, the index is then read
+    accesses = 1 + count + 1
+    if index_built:
+        # The directory is read again with each certificate and the index written
+        accesses += 1 + count + 1
+    return accesses
+
+
+def test_dcl_cache_hit(trust_store, tmp_path):
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:m:1')
+    assert results['get_2'] == CHIP_NO_ERROR
+    assert results['fetched_2'] == 1
+    assert results['cert_2'] == 1
+    # The second lookup is served by the cache
+    assert results['get_3'] == CHIP_NO_ERROR
+    assert results['fetched_3'] == 0
+    assert results['cert_3'] == 1
+    assert results['hits'] == 1
+    assert results['misses'] == 1
+    assert results['entry_count'] == 1
+
+
+def test_dcl_cache_net_types(trust_store, tmp_path):
+    # The PAAs of the main net and of the test net are cached apart
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:t:1', 'get:m:1', 'get:t:1')
+    assert results['fetched_2'] == 1
+    assert results['fetched_3'] == 1
+    assert results['cert_3'] == 1
+    assert results['fetched_4'] == 0
+    assert results['cert_4'] == 1
+    assert results['fetched_5'] == 0
+    assert results['cert_5'] == 1
+    assert results['entry_count'] == 2
+
+
+def test_dcl_cache_ttl(trust_store, tmp_path):
+    run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1')
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW + TTL_S - 1}', 'get:m:1')
+    assert results['fetched_2'] == 0
+    assert results['hits'] == 1
+    # An expired certificate is fetched again
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW + TTL_S + 1}', 'get:m:1')
+    assert results['get_2'] == CHIP_NO_ERROR
+    assert results['fetched_2'] == 1
+    assert results['cert_2'] == 1
+    assert results['misses'] == 1
+    assert results['entry_count'] == 1
+    # The refreshed certificate is kept for another TTL
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW + 2 * TTL_S}', 'get:m:1')
+    assert results['fetched_2'] == 0
+
+
+def test_dcl_cache_ttl_without_time(trust_store, tmp_path):
+    # The age of the certificates is not checked before the system time is set
+    run_dcl(trust_store, tmp_path, 'get:m:1')
+    results = run_dcl(trust_store, tmp_path, 'get:m:1')
+    assert results['fetched_1'] == 0
+    # The certificate fetched without the system time is refreshed once it is set
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:m:1')
+    assert results['fetched_2'] == 1
+    assert results['fetched_3'] == 0
+
+
+def test_dcl_cache_lru_eviction(trust_store, tmp_path):
+    operations = [f'time:{NOW}'] + [f'get:m:{id}' for id in range(1, CACHE_SIZE + 1)]
+    # The first certificate is used again, the second one is the least recently used
+    operations += ['get:m:1', f'get:m:{CACHE_SIZE + 1}', 'get:m:1', 'get:m:2']
+    results = run_dcl(trust_store, tmp_path, *operations)
+    first = CACHE_SIZE + 2
+    assert results[f'fetched_{first}'] == 0
+    assert results[f'fetched_{first + 1}'] == 1
+    assert results[f'fetched_{first + 2}'] == 0
+    assert results[f'fetched_{first + 3}'] == 1
+    assert results['evictions'] == 2
+    assert results['entry_count'] == CACHE_SIZE
+    assert results['http_requests'] == CACHE_SIZE + 2
+
+
+@pytest.mark.parametrize('id', [
+    # Not found on the DCL
+    0xD1,
+    # A PAA with another SKID
+    0xE1,
+    # A PAI
+    0xF1,
+])
+def test_dcl_invalid_paa(trust_store, tmp_path, id):
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', f'get:m:{id}', f'get:m:{id}')
+    assert results['get_2'] == CHIP_ERROR_INTERNAL
+    assert 'cert_2' not in results
+    # The rejected certificates are not cached
+    assert results['get_3'] == CHIP_ERROR_INTERNAL
+    assert results['fetched_3'] == 1
+    assert results['entry_count'] == 0
+    assert results['kvs_writes'] == 0
+
+
+def test_dcl_cache_reboot(trust_store, tmp_path):
+    run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:t:2')
+    # The index and the certificates are loaded from the KVS
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:t:2')
+    assert results['cert_2'] == 1
+    assert results['cert_3'] == 1
+    assert results['http_requests'] == 0
+    assert results['entry_count'] == 2
+    # The lookups do not write the KVS
+    assert results['kvs_writes'] == 0
+
+
+def test_dcl_cache_corrupted_certificate(trust_store, tmp_path):
+    run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1')
+    record = tmp_path / 'dcl-paa-00'
+    record.write_bytes(b'CORRUPTED' + record.read_bytes()[9:])
+    # The invalid certificate is removed and fetched again
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:m:1')
+    assert results['get_2'] == CHIP_NO_ERROR
+    assert results['fetched_2'] == 1
+    assert results['cert_2'] == 1
+    assert results['fetched_3'] == 0
+    assert results['entry_count'] == 1
+
+
+def test_dcl_cache_corrupted_index(trust_store, tmp_path):
+    run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:m:2')
+    index = tmp_path / 'dcl-paa-idx'
+    index.write_bytes(index.read_bytes()[:-1])
+    # An index of another size drops the cache with its certificates
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1')
+    assert results['fetched_2'] == 1
+    assert results['cert_2'] == 1
+    assert results['entry_count'] == 1
+    assert not (tmp_path / 'dcl-paa-01').exists()
+
+
+def test_dcl_cache_clear(trust_store, tmp_path):
+    results = run_dcl(trust_store, tmp_path, f'time:{NOW}', 'get:m:1', 'get:m:2', 'clear', 'get:m:1')
+    assert results['clear_4'] == CHIP_NO_ERROR
+    assert results['fetched_5'] == 1
+    assert results['entry_count'] == 1
+    assert sorted(path.name for path in tmp_path.iterdir()) == ['dcl-paa-00', 'dcl-paa-idx']
+
+
+@pytest.mark.parametrize('count', [1, 3, 200])
+def test_spiffs_index(trust_store, tmp_path, count):
+    ids = list(range(count))
+    make_store(tmp_path, ids)
+    lookups = sorted({0, count // 2, count - 1}) + [250]
+    results = run_spiffs(trust_store, tmp_path, *lookups)
+    assert results['init'] == 0
+    assert results['init_accesses'] == init_accesses(count, True)
+    magic, index_count, records = read_index(tmp_path)
+    assert magic == INDEX_MAGIC
+    assert index_count == count
+    assert records == [(make_skid(id), paa_name(id)) for id in ids]
+    # A lookup reads the index and the certificate
+    for number, id in enumerate(lookups[:-1], 1):
+        assert results[f'get_{number}'] == CHIP_NO_ERROR
+        assert results[f'id_{number}'] == id
+        assert results[f'accesses_{number}'] == 2
+    # A SKID missing from the index is not looked up in the certificates
+    assert results[f'get_{len(lookups)}'] == CHIP_ERROR_CA_CERT_NOT_FOUND
+    assert results[f'accesses_{len(lookups)}'] == 1
+    # The index is loaded after a reboot
+    results = run_spiffs(trust_store, tmp_path, count - 1)
+    assert results['init_accesses'] == init_accesses(count, False)
+    assert results['get_1'] == CHIP_NO_ERROR
+    assert results['id_1'] == count - 1
+
+
+@pytest.mark.parametrize('change', ['add', 'remove', 'resize'])
+def test_spiffs_index_stale_signature(trust_store, tmp_path, change):
+    make_store(tmp_path, [1, 2, 3])
+    run_spiffs(trust_store, tmp_path)
+    ids = [1, 2, 3]
+    if change == 'add':
+        (tmp_path / paa_name(9)).write_bytes(make_paa(9))
+        ids.append(9)
+    elif change == 'remove':
+        (tmp_path / paa_name(2)).unlink()
+        ids.remove(2)
+    else:
+        (tmp_path / paa_name(3)).write_bytes(make_paa(3, b'Longer PAA certificate'))
+    # The index is rebuilt with the certificates of the partition
+    results = run_spiffs(trust_store, tmp_path, *ids, 2)
+    assert results['init'] == 0
+    assert results['init_accesses'] == init_accesses(len(ids), True)
+    assert read_index(tmp_path)[2] == [(make_skid(id), paa_name(id)) for id in ids]
+    for number, id in enumerate(ids, 1):
+        assert results[f'get_{number}'] == CHIP_NO_ERROR
+        assert results[f'id_{number}'] == id
+        assert results[f'accesses_{number}'] == 2
+    assert results[f'get_{len(ids) + 1}'] == (CHIP_ERROR_CA_CERT_NOT_FOUND if change == 'remove' else CHIP_NO_ERROR)
+
+
+def test_spiffs_index_skid_check(trust_store, tmp_path):
+    make_store(tmp_path, [1, 2, 3])
+    run_spiffs(trust_store, tmp_path)
+    # A certificate replaced by one of the same size keeps the signature of the index
+    (tmp_path / paa_name(2)).write_bytes(make_paa(7))
+    results = run_spiffs(trust_store, tmp_path, 2)
+    assert results['init_accesses'] == init_accesses(3, False)
+    # The certificate of the index entry is checked, another PAA is never returned for the SKID
+    assert results['get_1'] == CHIP_ERROR_CA_CERT_NOT_FOUND
+    assert 'id_1' not in results
+    # The certificates are scanned after the index entry
+    assert results['accesses_1'] == 2 + 1 + 3
+
+
+@pytest.mark.parametrize('corruption', ['swapped', 'truncated'])
+def test_spiffs_index_scan_fallback(trust_store, tmp_path, corruption):
+    ids = [1, 2, 3, 4]
+    make_store(tmp_path, ids)
+    run_spiffs(trust_store, tmp_path)
+    records = read_index(tmp_path)[2]
+    if corruption == 'swapped':
+        # The entries of the first SKIDs name the certificate of the other one
+        records[0], records[1] = (records[0][0], records[1][1]), (records[1][0], records[0][1])
+        lookup = 1
+    else:
+        records = records[:2]
+        lookup = 4
+    write_index_records(tmp_path, records)
+    # An inconsistent index falls back to the scan of the certificates
+    results = run_spiffs(trust_store, tmp_path, lookup, 3)
+    assert results['get_1'] == CHIP_NO_ERROR
+    assert results['id_1'] == lookup
+    assert results['accesses_1'] > 2
+    assert results['get_2'] == CHIP_NO_ERROR
+    assert results['id_2'] == 3
+    if corruption == 'swapped':
+        # The consistent entries are still found with the index
+        assert results['accesses_2'] == 2
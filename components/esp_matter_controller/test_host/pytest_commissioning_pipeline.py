@@ -0,0 +1,203 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+"""
+Host test of the commissioning pipeline of the controller built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_controller/test_host
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+MAX_DEVICES = 4
+ESP_OK = 0
+ESP_ERR_NO_MEM = 0x101
+ESP_ERR_INVALID_ARG = 0x102
+ESP_ERR_INVALID_STATE = 0x103
+ESP_ERR_NOT_FOUND = 0x105
+CHIP_ERROR_BUFFER_TOO_SMALL = 0x19
+CHIP_ERROR_TIMEOUT = 0x32
+CHIP_ERROR_CANCELLED = 0x50
+CHIP_ERROR_INTERNAL = 0xac
+# commissioning_pipeline::device_state_t
+QUEUED, PASE, PASE_READY, COMMISSIONING, SUCCEEDED, FAILED = range(6)
+# chip::Controller::CommissioningStage
+SECURE_PAIRING = 1
+SEND_NOC = 13
+
+
+@pytest.fixture(scope='module')
+def pipeline(tmp_path_factory):
+    output = tmp_path_factory.mktemp('commissioning_pipeline') / 'commissioning_pipeline_test'
+    controller_dir = host_test.COMPONENTS_DIR / 'esp_matter_controller'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'commissioning_pipeline_test.cpp',
+                            controller_dir / 'commands' / 'esp_matter_controller_commissioning_pipeline.cpp'],
+                           [CURRENT_DIR / 'include', controller_dir / 'commands'],
+                           chip=True,
+                           defines=[f'CONFIG_ESP_MATTER_COMMISSIONING_PIPELINE_MAX_DEVICES={MAX_DEVICES}',
+                                    'CONFIG_ESP_MATTER_COMMISSIONING_PIPELINE_MAX_PASE_AHEAD=2'],
+                           cflags=['-Wno-format'])
+
+
+def run_pipeline(pipeline, *operations):
+    results = host_test.run(pipeline, *operations)
+    results['calls'] = [results[f'call_{count}'] for count in range(1, len(results) + 1) if f'call_{count}' in results]
+    results['done'] = [results[f'done_{count}'] for count in range(1, len(results) + 1) if f'done_{count}' in results]
+    return results
+
+
+def test_pase_overlaps_commissioning(pipeline):
+    # The devices take 2 s to pair and 5 s to commission, the PASE sessions of the next devices are established while
+    # the first one is commissioned
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'add:3', 'start:2',
+                           'time:2000', 'pase:0', 'time:2000', 'pase:0', 'time:2000', 'pase:0',
+                           'time:1000', 'success:1', 'time:5000', 'success:2', 'time:5000', 'success:3',
+                           'status:2', 'status:3', 'report')
+    assert results['start_4'] == ESP_OK
+    assert results['calls'] == ['pase:1', 'commission:1', 'pase:2', 'pase:3', 'commission:2', 'commission:3']
+    assert results['done'] == ['1:0x0', '2:0x0', '3:0x0']
+    assert results['finished_1'] == 3
+    assert results['running_19'] == 0
+    assert results['state_17'] == SUCCEEDED
+    assert results['pase_ms_17'] == 2000
+    assert results['wait_ms_17'] == 3000
+    assert results['commissioning_ms_17'] == 5000
+    assert results['wait_ms_18'] == 6000
+    assert results['total_19'] == 3
+    assert results['succeeded_19'] == 3
+    assert results['failed_19'] == 0
+    assert results['avg_pase_ms_19'] == 2000
+    assert results['avg_commissioning_ms_19'] == 5000
+    # 17 s instead of the 21 s of the devices one after the other
+    assert results['elapsed_ms_19'] == 17000
+    assert results['devices_per_minute_x10_19'] == 106
+
+
+@pytest.mark.parametrize('ahead', [1, 2])
+def test_max_pase_ahead(pipeline, ahead):
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'add:3', 'add:4', f'start:{ahead}',
+                           'pase:0', 'pase:0', 'pase:0', f'status:{1 + ahead}', f'status:{2 + ahead}')
+    # The first device is commissioned, the next ones wait with their PASE session established
+    assert results['calls'] == ['pase:1', 'commission:1'] + [f'pase:{node}' for node in range(2, 2 + ahead)]
+    assert results['state_9'] == PASE_READY
+    assert results['state_10'] == QUEUED
+    assert results['running_10'] == 1
+
+
+def test_one_commissioning_at_a_time(pipeline):
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'start:2', 'pase:0', 'pase:0', 'status:1', 'status:2',
+                           'success:1', 'status:2')
+    assert results['state_6'] == COMMISSIONING
+    assert results['state_7'] == PASE_READY
+    assert results['calls'] == ['pase:1', 'commission:1', 'pase:2', 'commission:2']
+    assert results['state_9'] == COMMISSIONING
+
+
+def test_add_while_running(pipeline):
+    results = run_pipeline(pipeline, 'add:1', 'start:2', 'pase:0', 'add:2', 'add:1')
+    assert results['add_4'] == ESP_OK
+    assert results['add_5'] == ESP_ERR_INVALID_ARG
+    assert results['calls'] == ['pase:1', 'commission:1', 'pase:2']
+
+
+def test_pase_failure(pipeline):
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'start:2', f'pase:{CHIP_ERROR_TIMEOUT}', 'status:1',
+                           'pase:0', 'success:2', 'report')
+    assert results['done'] == [f'1:{CHIP_ERROR_TIMEOUT:#x}', '2:0x0']
+    assert results['state_5'] == FAILED
+    assert results['error_5'] == CHIP_ERROR_TIMEOUT
+    assert results['stage_5'] == SECURE_PAIRING
+    assert results['calls'] == ['pase:1', 'pase:2', 'commission:2']
+    assert results['succeeded_8'] == 1
+    assert results['failed_8'] == 1
+    assert results['finished_1'] == 2
+
+
+@pytest.mark.parametrize('error,reported', [(CHIP_ERROR_BUFFER_TOO_SMALL, CHIP_ERROR_BUFFER_TOO_SMALL),
+                                            (0, CHIP_ERROR_INTERNAL)])
+def test_commissioning_failure(pipeline, error, reported):
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'start:2', 'pase:0', 'pase:0', f'failure:1:{error}',
+                           'status:1', 'status:2')
+    assert results['state_7'] == FAILED
+    assert results['error_7'] == reported
+    assert results['stage_7'] == SEND_NOC
+    # The failure does not stop the batch
+    assert results['state_8'] == COMMISSIONING
+    assert results['calls'] == ['pase:1', 'commission:1', 'pase:2', 'commission:2']
+
+
+def test_refused_calls(pipeline):
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'add:3', 'start:2', 'refuse:2', 'pase:0', 'refuse:3',
+                           'pase:0', 'success:1', 'status:2', 'status:3')
+    assert results['calls'] == ['pase:1', 'commission:1', 'pase:2', 'pase:3', 'commission:3']
+    assert results['done'] == [f'2:{CHIP_ERROR_INTERNAL:#x}', '1:0x0', f'3:{CHIP_ERROR_INTERNAL:#x}']
+    assert results['state_10'] == FAILED
+    assert results['state_11'] == FAILED
+    assert results['finished_1'] == 3
+    assert results['running_11'] == 0
+
+
+def test_stop(pipeline):
+    results = run_pipeline(pipeline, 'add:1', 'add:2', 'add:3', 'add:4', 'start:2', 'pase:0', 'pase:0', 'stop',
+                           'add:5', 'status:1', 'success:1', 'report')
+    # The PASE sessions of the waiting devices are stopped, the device being commissioned completes
+    assert results['calls'] == ['pase:1', 'commission:1', 'pase:2', 'pase:3', 'stop:2', 'stop:3']
+    assert results['done'] == [f'2:{CHIP_ERROR_CANCELLED:#x}', f'3:{CHIP_ERROR_CANCELLED:#x}',
+                               f'4:{CHIP_ERROR_CANCELLED:#x}', '1:0x0']
+    assert results['running_8'] == 1
+    assert results['add_9'] == ESP_ERR_INVALID_STATE
+    assert results['state_10'] == COMMISSIONING
+    assert results['running_11'] == 0
+    assert results['succeeded_12'] == 1
+    assert results['failed_12'] == 3
+
+
+def test_full_batch(pipeline):
+    operations = [f'add:{node}' for node in range(1, MAX_DEVICES + 2)]
+    results = run_pipeline(pipeline, *operations)
+    assert [results[f'add_{index}'] for index in range(1, MAX_DEVICES + 1)] == [ESP_OK] * MAX_DEVICES
+    assert results[f'add_{MAX_DEVICES + 1}'] == ESP_ERR_NO_MEM
+
+
+def test_reset(pipeline):
+    # The batch is freed by the reset and allocated again by the first device of the next one
+    batch = [f'add:{node}' for node in range(11, 11 + MAX_DEVICES)]
+    results = run_pipeline(pipeline, 'add:1', 'start:2', 'reset', 'pase:0', 'success:1', 'reset', 'status:1',
+                           *batch, 'start:1', 'report')
+    assert results['reset_3'] == ESP_ERR_INVALID_STATE
+    assert results['finished_1'] == 1
+    assert results['reset_6'] == ESP_OK
+    assert results['status_7'] == ESP_ERR_NOT_FOUND
+    assert [results[f'add_{index}'] for index in range(8, 8 + MAX_DEVICES)] == [ESP_OK] * MAX_DEVICES
+    assert results[f'start_{8 + MAX_DEVICES}'] == ESP_OK
+    assert results['calls'][-1] == 'pase:11'
+    assert results[f'total_{9 + MAX_DEVICES}'] == MAX_DEVICES
+
+
+def test_empty_batch(pipeline):
+    results = run_pipeline(pipeline, 'start:2', 'start:0')
+    assert results['start_1'] == ESP_OK
+    assert results['finished_1'] == 0
+    assert results['start_2'] == ESP_ERR_INVALID_ARG
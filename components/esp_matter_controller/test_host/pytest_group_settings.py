@@ -0,0 +1,162 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+"""
+Host test of the group settings of the controller built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_controller/test_host
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+MAX_GROUPS = 256
+MAX_KEYSETS = 4
+ESP_OK = 0
+ESP_FAIL = 0xffffffff
+ESP_ERR_NO_MEM = 0x101
+ESP_ERR_INVALID_SIZE = 0x104
+ESP_ERR_NOT_FOUND = 0x105
+
+
+@pytest.fixture(scope='module')
+def group_settings(tmp_path_factory):
+    output = tmp_path_factory.mktemp('group_settings') / 'group_settings_test'
+    controller_dir = host_test.COMPONENTS_DIR / 'esp_matter_controller'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'group_settings_test.cpp',
+                            controller_dir / 'core' / 'esp_matter_controller_group_settings.cpp',
+                            controller_dir / 'core' / 'esp_matter_controller_utils.cpp'],
+                           [CURRENT_DIR / 'include', controller_dir / 'core'],
+                           chip=True,
+                           defines=['CONFIG_ESP_MATTER_COMMISSIONER_ENABLE=1',
+                                    f'CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUPS_PER_FABRIC={MAX_GROUPS}',
+                                    f'CONFIG_ESP_MATTER_CONTROLLER_MAX_GROUP_KEYS_PER_FABRIC={MAX_KEYSETS}'],
+                           cflags=['-Wno-format'])
+
+
+@pytest.mark.parametrize('count', [16, 64, MAX_GROUPS])
+def test_bind_scaling(group_settings, count):
+    # The group key map is read once, then the bindings and the lookups are served by the index whatever the count
+    binds = [f'bind:{group}:1' for group in range(1, count + 1)]
+    gets = [f'get:{group}' for group in range(1, count + 1)]
+    results = host_test.run(group_settings, 'keyset:1', *binds, *gets, 'steps', 'map')
+    assert all(results[f'bind_{index}'] == ESP_OK for index in range(2, count + 2))
+    assert all(results[f'get_{index}'] == ESP_OK for index in range(count + 2, 2 * count + 2))
+    assert all(results[f'keyset_id_{index}'] == 1 for index in range(count + 2, 2 * count + 2))
+    assert results[f'steps_{2 * count + 2}'] == 0
+    assert results[f'entries_{2 * count + 3}'] == count
+
+
+@pytest.mark.parametrize('count', [16, 64, MAX_GROUPS])
+def test_load_scaling(group_settings, count):
+    # After a restart the group key map is read once for all the lookups
+    gets = [f'get:{group}' for group in range(1, count + 1)]
+    results = host_test.run(group_settings, f'preload:{count}:2', 'preload_keysets:2', *gets, 'steps')
+    assert all(results[f'keyset_id_{index}'] == 2 for index in range(3, count + 3))
+    assert results[f'steps_{count + 3}'] == count + 2
+
+
+def test_bind_groups(group_settings):
+    results = host_test.run(group_settings, 'keyset:1', 'keyset:2', 'bind_range:1:100:1', 'bind_range:51:100:2',
+                            'unbind_range:1:10:1', 'get:10', 'get:11', 'get:60', 'get:150', 'map',
+                            'unbind_range:140:20:2', 'steps')
+    assert results['bind_range_3'] == ESP_OK
+    # The groups bound to keyset 1 are rebound in place
+    assert results['bind_range_4'] == ESP_OK
+    assert results['unbind_range_5'] == ESP_OK
+    assert results['get_6'] == ESP_ERR_NOT_FOUND
+    assert results['keyset_id_7'] == 1
+    assert results['keyset_id_8'] == 2
+    assert results['keyset_id_9'] == 2
+    assert results['entries_10'] == 140
+    assert results['last_10'] == '150:2'
+    # The groups after 150 are not bound, the groups before are unbound
+    assert results['unbind_range_11'] == ESP_ERR_NOT_FOUND
+    assert results['steps_12'] == 0
+
+
+def test_remove_keyset(group_settings):
+    results = host_test.run(group_settings, 'keyset:1', 'keyset:2', 'bind_range:1:10:1', 'bind_range:11:10:2',
+                            'bind_range:21:10:1', 'remove_keyset:1', 'map', 'get:15', 'get:25')
+    assert results['remove_keyset_6'] == ESP_OK
+    assert results['entries_7'] == 10
+    assert results['last_7'] == '20:2'
+    assert results['keysets_7'] == 1
+    assert results['keyset_id_8'] == 2
+    assert results['get_9'] == ESP_ERR_NOT_FOUND
+
+
+def test_failed_change_reloads(group_settings):
+    results = host_test.run(group_settings, 'keyset:1', 'bind_range:1:10:1', 'fail', 'bind:11:1', 'steps',
+                            'bind:11:1', 'get:11', 'steps', 'map')
+    assert results['bind_4'] == ESP_FAIL
+    assert results['steps_5'] == 0
+    assert results['bind_6'] == ESP_OK
+    assert results['keyset_id_7'] == 1
+    # The index is loaded again from the 10 entries and the keyset
+    assert results['steps_8'] == 11
+    assert results['entries_9'] == 11
+
+
+def test_full_group_key_map(group_settings):
+    results = host_test.run(group_settings, f'preload:{MAX_GROUPS}:1', 'preload_keysets:1', f'bind:{MAX_GROUPS + 1}:1',
+                            'bind:1:1', 'unbind:1:1', f'bind:{MAX_GROUPS + 1}:1', 'map')
+    assert results['bind_3'] == ESP_ERR_NO_MEM
+    assert results['bind_4'] == ESP_OK
+    assert results['unbind_5'] == ESP_OK
+    assert results['bind_6'] == ESP_OK
+    assert results['entries_7'] == MAX_GROUPS
+    assert results['last_7'] == f'{MAX_GROUPS + 1}:1'
+
+
+def test_provider_group_key_overflow(group_settings):
+    # The provider has more entries than the index can hold, the changes are refused instead of overwriting them
+    results = host_test.run(group_settings, f'preload:{MAX_GROUPS + 1}:1', 'preload_keysets:1',
+                            f'bind:{MAX_GROUPS + 2}:1', f'bind:{MAX_GROUPS + 1}:2', 'unbind:1:1', 'get:1',
+                            'bind_range:1:2:1', 'remove_keyset:1', 'map')
+    assert results['bind_3'] == ESP_ERR_INVALID_SIZE
+    assert results['bind_4'] == ESP_ERR_INVALID_SIZE
+    assert results['unbind_5'] == ESP_ERR_INVALID_SIZE
+    assert results['get_6'] == ESP_ERR_INVALID_SIZE
+    assert results['bind_range_7'] == ESP_ERR_INVALID_SIZE
+    assert results['remove_keyset_8'] == ESP_ERR_INVALID_SIZE
+    assert results['entries_9'] == MAX_GROUPS + 1
+    assert results['last_9'] == f'{MAX_GROUPS + 1}:1'
+    assert results['keysets_9'] == 1
+
+
+def test_provider_keyset_overflow(group_settings):
+    results = host_test.run(group_settings, f'preload_keysets:{MAX_KEYSETS + 1}', 'keyset:1', 'bind:1:1', 'map')
+    assert results['keyset_2'] == ESP_ERR_INVALID_SIZE
+    assert results['bind_3'] == ESP_ERR_INVALID_SIZE
+    assert results['entries_4'] == 0
+
+
+def test_full_keysets(group_settings):
+    results = host_test.run(group_settings, f'preload_keysets:{MAX_KEYSETS}', f'keyset:{MAX_KEYSETS + 1}',
+                            'keyset:1', 'map')
+    assert results['keyset_2'] == ESP_ERR_NO_MEM
+    # An existing keyset is updated
+    assert results['keyset_3'] == ESP_OK
+    assert results['keysets_4'] == MAX_KEYSETS
@@ -16,14 +16,25 @@
 
 #include <esp_err.h>
 #include <esp_http_client.h>
+#include <esp_matter_ota_transfer_stats.h>
+#include <messaging/ExchangeMgr.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <protocols/bdx/TransferFacilitator.h>
+#include <stdio.h>
+#include <system/SystemClock.h>
 
 #define OTA_URL_MAX_LEN 256
+#define OTA_IMAGE_DIGEST_LEN 32
+// Base version of the full OTA images, the delta OTA images only apply to the requestors running their base version
+#define OTA_FULL_IMAGE_BASE_VERSION UINT32_MAX
 
 namespace esp_matter {
 namespace ota_provider {
 
+struct read_ahead_stream;
+struct ota_image_source;
+class OtaBdxSenderPool;
+
 class OtaBdxSender : public chip::bdx::Responder {
 public:
     enum BdxSenderErr {
@@ -53,23 +64,169 @@ public:
 
     const char *GetOtaImageUrl() const { return mOtaImageUrl; }
 
+    // The image source the image URL is opened from, the source set with set_ota_image_source() if NULL
+    void SetOtaImageSource(const ota_image_source *source) { mImageSource = source; }
+
+    // Identify the image to send, so that it can be served from or added to the local image cache. The digest is the
+    // SHA-256 checksum published on the DCL, the image is not cached if it is NULL. The baseVersion is the version a
+    // delta image applies to, or OTA_FULL_IMAGE_BASE_VERSION. The imageSize is the published size of the image, 0 if
+    // unknown, the images larger than the cache are not downloaded to it.
+    void SetOtaImageInfo(uint16_t vendorId, uint16_t productId, uint32_t softwareVersion, uint32_t baseVersion,
+                         const uint8_t *digest, uint64_t imageSize);
+
+    // Count of the transfers of the image to the requestor which failed before this one, for the statistics
+    void SetTransferRetries(uint32_t retries) { mTransferRetries = retries; }
+
+    // Statistics of the running transfer
+    void GetTransferStats(esp_matter::ota::transfer_stats_t &stats) const;
+
+    // Percentage of the image sent, from the start of the image. The size of the image is read from its header, or is
+    // imageSize for the transfers resumed at an offset, the percentage is 0 if both are unknown.
+    uint8_t GetPercentComplete(uint64_t imageSize) const;
+
 private:
+    friend class OtaBdxSenderPool;
+
     void HandleTransferSessionOutput(chip::bdx::TransferSession::OutputEvent &event) override;
 
     esp_err_t ParseOtaImageHeader(const uint8_t *header_buf, size_t header_buf_size);
 
+    // Open the image in the local cache, or start downloading it from the image URL, and start reading it ahead
+    esp_err_t OpenImage();
+    // Close the image, the downloaded image is added to the local cache if the transfer is complete
+    void CloseImage(bool complete);
+
+    // Send the next block of the image, or wait for the read-ahead task if the block is not read yet
+    void SendBlock(bool async);
+    static void OnBlockReady(intptr_t context);
+
+    // Record the round-trip time of the last Block when the next BlockQuery or the AckEOF is received
+    void RecordBlockRtt();
+    // Report the end of the started transfer to the pool
+    void EndTransfer(bool complete);
+
     void Reset();
 
+    OtaBdxSenderPool *mPool = nullptr;
+
     uint64_t mNumBytesSent = 0;
+    // The StartOffset of the BDX transfer, the image is read from this offset
+    uint64_t mStartOffset = 0;
 
     bool mInitialized = false;
+    // Whether the requestor has sent the BDX init message of the transfer prepared for it
+    bool mTransferStarted = false;
+    chip::System::Clock::Timestamp mInitializedTime = chip::System::Clock::Timestamp(0);
 
     chip::Optional<chip::FabricIndex> mFabricIndex;
     chip::Optional<chip::NodeId> mNodeId;
 
     char mOtaImageUrl[OTA_URL_MAX_LEN];
+    const ota_image_source *mImageSource = nullptr;
     uint64_t mOtaImageSize;
-    esp_http_client_handle_t mHttpDownloader = nullptr;
+    read_ahead_stream *mReadAhead = nullptr;
+    // A BlockQuery is waiting for the read-ahead task
+    bool mBlockPending = false;
+
+    uint16_t mVendorId = 0;
+    uint16_t mProductId = 0;
+    uint32_t mSoftwareVersion = 0;
+    uint32_t mBaseVersion = OTA_FULL_IMAGE_BASE_VERSION;
+    uint8_t mImageDigest[OTA_IMAGE_DIGEST_LEN];
+    bool mHasImageDigest = false;
+    uint64_t mPublishedImageSize = 0;
+
+    esp_matter::ota::transfer_recorder_t mStatsRecorder = {};
+    uint32_t mTransferRetries = 0;
+    // When the last Block was sent, 0 if no Block is waiting for the next BlockQuery
+    uint64_t mBlockSentMs = 0;
+};
+
+// Pool of BDX senders, so that the OTA image is sent to several requestors at the same time. The pool is the
+// handler of the unsolicited BDX messages and hands each new BDX exchange over to the sender prepared for the
+// peer node of the exchange. Each sender has its own exchange context, transfer session, HTTP connection and
+// read-ahead ring.
+class OtaBdxSenderPool : public chip::Messaging::UnsolicitedMessageHandler, public chip::Messaging::ExchangeDelegate {
+public:
+    static constexpr size_t kMaxSessions = CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MAX_SESSIONS;
+
+    enum TransferEvent {
+        kTransferStarted,
+        kTransferCompleted,
+        kTransferFailed,
+    };
+
+    // Called in the Matter thread when a transfer starts or ends, the statistics are the ones of the transfer
+    using TransferEventCallback = void (*)(TransferEvent event, chip::FabricIndex fabricIndex, chip::NodeId nodeId,
+                                           const esp_matter::ota::transfer_stats_t &stats, void *ctx);
+
+    // A requestor which was refused a sender. The waiters are queued in the order they were first refused, and the
+    // free senders are kept for the ones which have waited longer.
+    struct Waiter {
+        // Order of the requestor in the queue, 0 if it is not waiting
+        uint32_t mTicket = 0;
+        // The requestor loses its position if it does not query again before this time
+        uint64_t mExpiryMs = 0;
+        Waiter *mPrev = nullptr;
+        Waiter *mNext = nullptr;
+    };
+
+    // A sender prepared for a requestor which does not start the transfer within reservationTimeout is reused for
+    // the other requestors.
+    esp_err_t Init(chip::Messaging::ExchangeManager &exchangeMgr, chip::System::Clock::Timeout reservationTimeout);
+
+    // Get the sender for a transfer to a node, the sender already prepared for the node is reset. Returns nullptr if
+    // all the senders are busy or if the free heap is too low for another transfer.
+    OtaBdxSender *Acquire(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
+
+    // Get the sender prepared for a node, or nullptr
+    OtaBdxSender *Find(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
+
+    // Number of senders which can be acquired for a new node
+    size_t GetFreeCount();
+
+    // Get the sender for a transfer to a node, unless the free senders are kept for the waiters queued before it.
+    // The waiter leaves the queue when it gets a sender. waitPosition is the count of the waiters queued before it.
+    OtaBdxSender *Admit(chip::FabricIndex fabricIndex, chip::NodeId nodeId, Waiter &waiter, size_t &waitPosition);
+
+    // Queue a waiter which was not admitted, or keep its position if it is already queued. Returns the delay after
+    // which it should query again, queryDelaySec for the first kMaxSessions waiters and longer for the next ones.
+    uint32_t Wait(Waiter &waiter, size_t waitPosition, uint32_t queryDelaySec);
+
+    // Remove a waiter from the queue, before the requestor is deleted
+    void CancelWait(Waiter &waiter);
+
+    // Number of the requestors waiting for a sender
+    size_t GetWaiterCount() const { return mWaiterCount; }
+
+    void SetTransferEventCallback(TransferEventCallback callback, void *ctx)
+    {
+        mTransferEventCallback = callback;
+        mTransferEventCtx = ctx;
+    }
+
+private:
+    friend class OtaBdxSender;
+
+    CHIP_ERROR OnUnsolicitedMessageReceived(const chip::PayloadHeader &payloadHeader,
+                                            chip::Messaging::ExchangeDelegate *&newDelegate) override;
+    CHIP_ERROR OnMessageReceived(chip::Messaging::ExchangeContext *ec, const chip::PayloadHeader &payloadHeader,
+                                 chip::System::PacketBufferHandle &&payload) override;
+    void OnResponseTimeout(chip::Messaging::ExchangeContext *ec) override {}
+
+    bool IsFree(const OtaBdxSender &sender);
+    // Remove the waiters which did not query again before their expiry
+    void ExpireWaiters();
+
+    OtaBdxSender mSenders[kMaxSessions];
+    // Queue of the waiters, in the order of their tickets
+    Waiter *mWaiterHead = nullptr;
+    Waiter *mWaiterTail = nullptr;
+    size_t mWaiterCount = 0;
+    uint32_t mNextTicket = 0;
+    chip::System::Clock::Timeout mReservationTimeout = chip::System::Clock::Timeout(0);
+    TransferEventCallback mTransferEventCallback = nullptr;
+    void *mTransferEventCtx = nullptr;
 };
 
 } // namespace ota_provider
@@ -0,0 +1,121 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_ota_provider.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota_provider {
+
+/* Sources of the OTA images served by the OTA Provider
+ *
+ * An image source finds the update of a model for the software version of a Requestor, and reads the image of the
+ * update for the BDX transfers. The OTA Provider uses the DCL source by default, which queries the DCL through the
+ * OTA candidates cache and downloads the images from their otaUrl over HTTPS. The local directory source serves the
+ * images listed in a manifest from a mounted filesystem, so that the OTA Provider works on isolated networks, and
+ * the memory source serves images from RAM or flash mapped buffers.
+ */
+
+typedef struct {
+    uint32_t software_version;
+    char software_version_str[SOFTWARE_VERSION_STR_MAX_LEN];
+    // The URL of the image, it is passed to open_image() of the source and its last path segment is the file name in
+    // the ImageURI sent to the Requestor
+    char ota_url[OTA_URL_MAX_LEN];
+    uint64_t ota_file_size;
+    // SHA-256 digest of the OTA image, valid if has_ota_digest is set
+    uint8_t ota_digest[OTA_IMAGE_DIGEST_LEN];
+    bool has_ota_digest;
+} ota_image_info_t;
+
+typedef struct ota_image_source {
+    /* Find the update of a model for a software version, returns ESP_ERR_NOT_FOUND if there is no update. It is called
+     * in the OTA candidates task and may block. */
+    esp_err_t (*query_image)(void *ctx, uint16_t vendor_id, uint16_t product_id, uint32_t software_version,
+                             ota_image_info_t *info);
+    /* Open an image returned by query_image() to read it from offset. It is called in the Matter thread. */
+    esp_err_t (*open_image)(void *ctx, const char *ota_url, uint64_t offset, void **reader);
+    /* Read the next bytes of the image in the read-ahead task, returns the count of bytes read, which is smaller than
+     * size only at the end of the image, or -1 on failure */
+    int (*read_image)(void *reader, uint8_t *buf, size_t size);
+    /* Release the reader, it is called in the Matter thread */
+    void (*close_image)(void *reader);
+    void *ctx;
+    // Whether the images are added to the local image cache with CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE. The
+    // images of a local source are read at flash speed already.
+    bool cache_images;
+} ota_image_source_t;
+
+/** The source which queries the DCL and downloads the images over HTTPS */
+const ota_image_source_t *get_dcl_image_source();
+
+/** Set the source of the OTA images
+ *
+ * The source is used for the next QueryImage commands and for the BDX transfers of the images they offer, the
+ * transfers prepared before keep the source of their image. It must stay valid as long as it is set, while the BDX
+ * transfers of its images are running and while the delta OTA images registered for it are registered.
+ *
+ * @param[in] source The image source, NULL to restore the DCL source
+ */
+void set_ota_image_source(const ota_image_source_t *source);
+
+const ota_image_source_t *get_ota_image_source();
+
+/** Create a source of the images in a local directory
+ *
+ * The images are listed in the manifest.json file of the directory, in the format of the OTA image list of the
+ * chip-ota-provider-app, plus the SHA-256 digest of the image in base64, as published on the DCL:
+ *
+ *     {"deviceSoftwareVersionModel": [{"vendorId": 65521, "productId": 32768, "softwareVersion": 2,
+ *       "softwareVersionString": "2.0", "minApplicableSoftwareVersion": 0, "maxApplicableSoftwareVersion": 1,
+ *       "otaURL": "light-v2.ota", "otaChecksum": "<base64 SHA-256>"}]}
+ *
+ * The otaURL is the path of the image relative to the directory. The manifest is read when the source is created.
+ *
+ * @param[in] path The directory, on a mounted SPIFFS, LittleFS or FAT partition
+ * @param[out] source The created source
+ */
+esp_err_t local_image_source_create(const char *path, ota_image_source_t **source);
+
+void local_image_source_destroy(ota_image_source_t *source);
+
+typedef struct {
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint32_t software_version;
+    // The string is not copied and must stay valid as long as the source
+    const char *software_version_str;
+    uint32_t min_applicable_software_version;
+    uint32_t max_applicable_software_version;
+    // The OTA image, it is not copied and must stay valid as long as the source
+    const uint8_t *data;
+    size_t size;
+} ota_memory_image_t;
+
+/** Create a source of OTA images in memory, for instance images embedded in the firmware or test images
+ *
+ * @param[in] images The images, the array is copied
+ * @param[in] count The count of the images
+ * @param[out] source The created source
+ */
+esp_err_t memory_image_source_create(const ota_memory_image_t *images, size_t count, ota_image_source_t **source);
+
+void memory_image_source_destroy(ota_image_source_t *source);
+
+} // namespace ota_provider
+} // namespace esp_matter
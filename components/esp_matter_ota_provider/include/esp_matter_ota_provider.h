@@ -29,6 +29,68 @@
 namespace esp_matter {
 namespace ota_provider {
 
+typedef struct {
+    // QueryImage commands answered from the OTA candidates cache, with an update or with no update
+    uint32_t hits;
+    uint32_t negative_hits;
+    // QueryImage commands which queried the DCL
+    uint32_t misses;
+    // HTTP requests sent to the DCL, and the ones which failed
+    uint32_t dcl_requests;
+    uint32_t dcl_failures;
+    uint32_t evictions;
+    // Count of the entries in the cache
+    uint32_t entries;
+} ota_candidates_stats_t;
+
+/** Get the statistics of the OTA candidates cache
+ *
+ * @param[out] stats The statistics since boot
+ */
+void get_ota_candidates_stats(ota_candidates_stats_t *stats);
+
+// State of the update of a requestor on the rollout dashboard of the OTA Provider
+typedef enum {
+    // The requestor queried the Provider and no transfer has started since
+    OTA_NODE_STATE_QUERIED = 0,
+    OTA_NODE_STATE_DOWNLOADING,
+    // The image was transferred and the requestor has not asked to apply it yet
+    OTA_NODE_STATE_DOWNLOADED,
+    // The Provider answered the ApplyUpdateRequest of the requestor with Proceed
+    OTA_NODE_STATE_APPLYING,
+    // The requestor notified that the update was applied
+    OTA_NODE_STATE_APPLIED,
+    // The transfer failed, or the requestor queried again from the same version after the transfer
+    OTA_NODE_STATE_FAILED,
+    OTA_NODE_STATE_MAX,
+} ota_node_state_t;
+
+typedef struct {
+    chip::FabricIndex fabric_index;
+    chip::NodeId node_id;
+    uint16_t vendor_id;
+    uint16_t product_id;
+    // The version the requestor runs, from its last QueryImage command
+    uint32_t current_version;
+    // The version of the update offered to the requestor, 0 if no update was found
+    uint32_t target_version;
+    ota_node_state_t state;
+    // Percentage of the image transferred, the one reached by the last transfer if it is not running
+    uint8_t percent_complete;
+    // Transfers of the update which failed
+    uint32_t failed_transfers;
+    // Statistics of the running transfer, or of the last one
+    esp_matter::ota::transfer_stats_t transfer_stats;
+} ota_node_status_t;
+
+typedef struct {
+    uint32_t nodes;
+    // Count of the requestors in each state
+    uint32_t state_count[OTA_NODE_STATE_MAX];
+} ota_rollout_summary_t;
+
+const char *ota_node_state_to_str(ota_node_state_t state);
+
 class EspOtaProvider : public chip::app::Clusters::OTAProviderDelegate {
 public:
     using OTAQueryStatus = chip::app::Clusters::OtaSoftwareUpdateProvider::OTAQueryStatus;
@@ -37,18 +99,83 @@ public:
     static constexpr size_t kUriMaxLen = 256;
     static constexpr uint8_t kUpdateTokenLen = 32;
     static constexpr uint8_t kUpdateTokenStrLen = kUpdateTokenLen * 2 + 1;
+    static constexpr size_t kRequestorBuckets = CONFIG_ESP_MATTER_OTA_PROVIDER_REQUESTOR_BUCKETS;
+    static constexpr size_t kMaxPolicyRules = CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_POLICY_RULES;
+    static constexpr size_t kMaxDeltaOtaImages = CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_DELTA_IMAGES;
+
     struct EspOtaRequestorEntry {
         chip::ScopedNodeId mNodeId;
+        // mOtaAllowed is the policy of the node if mOtaAllowedExplicit is set, otherwise the policy rules apply
         bool mOtaAllowed;
+        bool mOtaAllowedExplicit;
         bool mOtaAllowedOnce;
         bool mHasNewVersion;
         uint8_t mUpdateToken[kUpdateTokenLen];
         char mImageUri[kUriMaxLen];
         char mOtaImageUrl[OTA_URL_MAX_LEN];
+        // The image source mOtaImageUrl is opened from
+        const ota_image_source *mImageSource;
         size_t mOtaImageSize;
+        uint16_t mVendorId;
+        uint16_t mProductId;
+        uint8_t mOtaImageDigest[OTA_IMAGE_DIGEST_LEN];
+        bool mHasOtaImageDigest;
         uint32_t mSoftwareVersion;
         char mSoftwareVersionString[SOFTWARE_VERSION_STR_MAX_LEN];
+        // The version the requestor runs, from its last QueryImage command
+        uint32_t mCurrentVersion;
+        // Whether the image is a delta image from mCurrentVersion
+        bool mIsDeltaOtaImage;
+        // A delta image was sent to the requestor, and the requestor has not been updated since. When it queries again
+        // from the same version, the delta image is considered as failed and the full image is offered instead.
+        bool mDeltaOtaImageSent;
+        bool mDeltaOtaImageFailed;
+        ota_node_state_t mState;
+        uint8_t mPercentComplete;
+        uint32_t mFailedTransfers;
+        esp_matter::ota::transfer_stats_t mTransferStats;
+        // Position of the requestor in the queue of the requestors waiting for a BDX sender
+        OtaBdxSenderPool::Waiter mBdxWaiter;
+        // Next entry of the hash bucket
         EspOtaRequestorEntry *mNext;
+        // Slot of the policy of the node in NVS plus one, 0 if the node has no policy of its own
+        uint32_t mPolicySlot;
+    };
+
+    // Policy of a group of requestors. A requestor matches the rule if it matches all the fields, the default
+    // values match all the requestors.
+    struct OtaPolicyRule {
+        chip::FabricIndex mFabricIndex = chip::kUndefinedFabricIndex;
+        // 0 matches any VendorID or ProductID
+        uint16_t mVendorId = 0;
+        uint16_t mProductId = 0;
+        chip::NodeId mNodeIdMin = 0;
+        chip::NodeId mNodeIdMax = UINT64_MAX;
+        bool mOtaAllowed = true;
+        // Staged rollout, the update is offered to this percentage of the matching requestors. A requestor is always
+        // in the same share of the rollout, so that raising the percentage only adds requestors.
+        uint8_t mRolloutPercent = 100;
+        // Maintenance window in minutes of the UTC day, the window wraps around midnight if the start is after the
+        // end. The update is offered at any time if the start equals the end.
+        uint16_t mWindowStartMinute = 0;
+        uint16_t mWindowEndMinute = 0;
+    };
+
+    // A delta OTA image updates the requestors running mBaseVersion to mSoftwareVersion. It is offered instead of the
+    // full image of mSoftwareVersion found by the image source to these requestors.
+    struct DeltaOtaImage {
+        uint16_t mVendorId;
+        uint16_t mProductId;
+        uint32_t mBaseVersion;
+        uint32_t mSoftwareVersion;
+        char mOtaImageUrl[OTA_URL_MAX_LEN];
+        // The image source mOtaImageUrl is opened from, whichever source is set when the image is offered. NULL for
+        // the source set when the image is registered.
+        const ota_image_source *mImageSource;
+        size_t mOtaImageSize;
+        // SHA-256 digest of the OTA image, the image is not cached if mHasOtaImageDigest is false
+        uint8_t mOtaImageDigest[OTA_IMAGE_DIGEST_LEN];
+        bool mHasOtaImageDigest;
     };
 
     // OTAProviderDelegate Implementation
@@ -79,20 +206,40 @@ public:
     void SetPollInterval(uint32_t interval) { mPollInterval = (interval != 0) ? interval : mPollInterval; }
 
     static void FetchImageDoneCallback(OTAQueryStatus status, const char *imageUrl, size_t imageSize,
-                                       uint32_t softwareVersion, const char *softwareVersionStr, void *arg);
+                                       const uint8_t *imageDigest, uint32_t softwareVersion,
+                                       const char *softwareVersionStr, void *arg);
 
     // When the OTA Provider receives a QueryImage command from an OTA Requestor and there is no existing entry for the
     // Requestor node, the Provider will create an OTA Requestor Entry for the requestor, and set the entry's
     // mOtaAllowed to mOtaAllowedDefault.
     void SetOtaAllowedDefault(bool otaAllowed) { mOtaAllowedDefault = otaAllowed; }
     // When there is a Requestor entry for the nodeId, we can call the EnableOtaForNode/DisableOtaForNode to make the
-    // provider allow whether the requestor proceed the OTA process.
+    // provider allow whether the requestor proceed the OTA process. The policy of a node overrides the policy rules.
     esp_err_t EnableOtaForNode(const chip::ScopedNodeId &nodeId, bool forOnlyOnce);
     esp_err_t DisableOtaForNode(const chip::ScopedNodeId &nodeId);
     // This should be called when the OTA Provider is notified that one node is removed from the Fabric.
     esp_err_t RemoveOtaRequestorEntry(const chip::ScopedNodeId &nodeId);
     EspOtaRequestorEntry *FindOtaRequestorEntry(const chip::ScopedNodeId &nodeId);
 
+    // The policy rules apply to the requestors without a policy of their own, the rule with the lowest index which
+    // matches the requestor applies. The requestors which match no rule use the OtaAllowedDefault. The policy rules
+    // and the policies of the nodes are saved in NVS.
+    esp_err_t SetOtaPolicyRule(size_t index, const OtaPolicyRule &rule);
+    esp_err_t RemoveOtaPolicyRule(size_t index);
+
+    // Rollout dashboard, the status of the requestors which have queried the Provider. These are called in the Matter
+    // thread, or with the Matter stack locked.
+    using OtaNodeStatusCallback = void (*)(const ota_node_status_t &status, void *ctx);
+    esp_err_t GetOtaNodeStatus(const chip::ScopedNodeId &nodeId, ota_node_status_t &status);
+    void ForEachOtaNodeStatus(OtaNodeStatusCallback callback, void *ctx);
+    void GetOtaRolloutSummary(ota_rollout_summary_t &summary);
+
+    // Register a delta OTA image, it replaces the image registered for the same base and software versions. The image
+    // source of the delta image must stay valid while the image is registered.
+    esp_err_t AddDeltaOtaImage(const DeltaOtaImage &image);
+    esp_err_t RemoveDeltaOtaImage(uint16_t vendorId, uint16_t productId, uint32_t baseVersion,
+                                  uint32_t softwareVersion);
+
 private:
     EspOtaProvider() {}
     ~EspOtaProvider() {}
@@ -100,14 +247,49 @@ private:
     void SendQueryImageResponse(OTAQueryStatus status);
 
     esp_err_t CreateOtaRequestorEntry(const chip::ScopedNodeId &nodeId);
+    EspOtaRequestorEntry *&GetRequestorBucket(const chip::ScopedNodeId &nodeId);
+
+    // Whether the update is offered to the requestor now, windowDelaySec is set when it is offered in the next
+    // maintenance window.
+    bool IsOtaAllowed(const EspOtaRequestorEntry *requestor, uint32_t &windowDelaySec);
+    const OtaPolicyRule *FindOtaPolicyRule(const EspOtaRequestorEntry *requestor);
+    // The policies of the nodes are saved in NVS in chunks of kPolicyChunkSlots, so that a change only rewrites the
+    // chunk of the node. UpdateOtaNodePolicy() gives a slot to the nodes with a policy and frees the slot of the other
+    // ones, then SaveOtaNodePolicies() writes the chunks changed since the last save.
+    static constexpr size_t kPolicyChunkSlots = 32;
+    struct OtaPolicyChunk {
+        EspOtaRequestorEntry *mEntries[kPolicyChunkSlots];
+        bool mDirty;
+    };
+    void UpdateOtaNodePolicy(EspOtaRequestorEntry *requestor);
+    esp_err_t GrowOtaPolicyChunks(size_t count);
+    void SaveOtaNodePolicies();
+    void SaveOtaPolicyRules();
+    void LoadOtaPolicies();
+
+    DeltaOtaImage *FindDeltaOtaImage(uint16_t vendorId, uint16_t productId, uint32_t baseVersion,
+                                     uint32_t softwareVersion);
+
+    void FillOtaNodeStatus(const EspOtaRequestorEntry *requestor, ota_node_status_t &status);
+    static void HandleTransferEvent(OtaBdxSenderPool::TransferEvent event, chip::FabricIndex fabricIndex,
+                                    chip::NodeId nodeId, const esp_matter::ota::transfer_stats_t &stats, void *ctx);
+
+    uint32_t SetBusy(EspOtaRequestorEntry *requestor, size_t waitPosition);
 
-    OtaBdxSender mOtaBdxSender;
+    OtaBdxSenderPool mBdxSenderPool;
     uint32_t mDelayedQueryActionTimeSec;
     OTAApplyUpdateAction mUpdateAction;
     uint32_t mDelayedApplyActionTimeSec;
     uint32_t mPollInterval;
     bool mOtaAllowedDefault;
-    EspOtaRequestorEntry *mOtaRequestorList;
+    // Hash table of the requestor entries, chained in the buckets
+    EspOtaRequestorEntry *mRequestorBuckets[kRequestorBuckets];
+    OtaPolicyRule mPolicyRules[kMaxPolicyRules];
+    uint32_t mPolicyRuleMask = 0;
+    DeltaOtaImage mDeltaOtaImages[kMaxDeltaOtaImages];
+    size_t mDeltaOtaImageCount = 0;
+    OtaPolicyChunk *mPolicyChunks = nullptr;
+    size_t mPolicyChunkCount = 0;
 
     // Use async command handler for QueryImage command
     chip::app::CommandHandler::Handle mAsyncCommandHandle;
@@ -0,0 +1,32 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <esp_matter_console.h>
+
+namespace esp_matter {
+namespace console {
+
+/** Add OTA Provider Commands
+ *
+ * Adds the commands of the rollout dashboard of the OTA Provider, "matter esp ota-provider rollout" and
+ * "matter esp ota-provider node <fabric-index> <node-id>".
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t ota_provider_register_commands();
+
+} // namespace console
+} // namespace esp_matter
@@ -30,12 +30,23 @@ typedef struct {
     uint32_t max_applicable_software_version;
     char ota_url[OTA_URL_MAX_LEN];
     uint32_t ota_file_size;
-    uint32_t lifetime;
+    // SHA-256 digest of the OTA image published on the DCL, valid if has_ota_digest is set
+    uint8_t ota_digest[OTA_IMAGE_DIGEST_LEN];
+    bool has_ota_digest;
+    // Whether the DCL has an update for checked_software_version. A negative entry only caches that there is no
+    // update for checked_software_version, or for any version from latest_software_version.
+    bool update_available;
+    uint32_t checked_software_version;
+    // The highest software version of the model on the DCL, 0 if the model is not on the DCL
+    uint32_t latest_software_version;
+    // Seconds since boot after which the entry is queried again from the DCL
+    uint32_t expiry_time;
+    uint32_t last_used;
 } model_version_t;
 
 typedef void (*fetch_ota_image_done_callback_t)(EspOtaProvider::OTAQueryStatus status, const char *imageUrl,
-                                                size_t imageSize, uint32_t softwareVersion,
-                                                const char *softwareVersionStr, void *ctx);
+                                                size_t imageSize, const uint8_t *imageDigest,
+                                                uint32_t softwareVersion, const char *softwareVersionStr, void *ctx);
 
 esp_err_t fetch_ota_candidate(const uint16_t vendor_id, const uint16_t product_id, const uint32_t software_version,
                               fetch_ota_image_done_callback_t callback, void *callback_args);
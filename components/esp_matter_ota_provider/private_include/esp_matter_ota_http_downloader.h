@@ -30,11 +30,23 @@ typedef struct ota_image_header_prefix ota_image_header_prefix_t;
 
 constexpr uint32_t k_ota_image_file_identifier = 0x1BEEF11E;
 
-int http_downloader_read(esp_http_client_handle_t http_client, char *buf, size_t size);
-
-void http_downloader_abort(esp_http_client_handle_t http_client);
-
-esp_err_t http_downloader_start(esp_http_client_config_t *config, esp_http_client_handle_t *http_client);
+typedef struct http_downloader *http_downloader_handle_t;
+
+/* Read the next bytes of the image
+ *
+ * If the connection is lost, the downloader reconnects and resumes at the current offset with a range request, up to
+ * CONFIG_ESP_MATTER_OTA_PROVIDER_HTTP_RESUME_RETRIES times. This function blocks, it should not be called in the
+ * Matter thread.
+ *
+ * @return the count of bytes read, which is smaller than size only at the end of the image, or -1 on failure.
+ */
+int http_downloader_read(http_downloader_handle_t downloader, char *buf, size_t size);
+
+void http_downloader_abort(http_downloader_handle_t downloader);
+
+/* Start downloading the image from offset, with a range request if offset is not 0 */
+esp_err_t http_downloader_start(esp_http_client_config_t *config, uint64_t offset,
+                                http_downloader_handle_t *downloader);
 
 } // namespace ota_provider
 } // namespace esp_matter
@@ -0,0 +1,73 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_ota_bdx_sender.h>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace esp_matter {
+namespace ota_provider {
+
+/* Local cache of the OTA images served by the BDX senders
+ *
+ * The images are stored as files in CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PATH, which should be on a mounted
+ * SPIFFS, LittleFS or FAT partition. An image is keyed by its VendorID, ProductID, SoftwareVersion and base version
+ * plus the SHA-256 digest published on the DCL. It is added to the cache when a BDX sender has downloaded the whole image
+ * and its digest matches the DCL checksum, and then every following transfer of the image reads it from the cache.
+ * The least recently used images which are not being read are evicted to keep the count and the total size of the
+ * images under the limits.
+ */
+
+typedef struct {
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint32_t software_version;
+    // The version a delta image applies to, OTA_FULL_IMAGE_BASE_VERSION for the full images
+    uint32_t base_version;
+    uint8_t digest[OTA_IMAGE_DIGEST_LEN];
+} ota_image_id_t;
+
+typedef struct image_cache_fill *image_cache_fill_handle_t;
+
+esp_err_t image_cache_init();
+
+/* Open the cached image for reading, returns NULL if the image is not in the cache. The image is not evicted until the
+ * file is closed with image_cache_close() */
+FILE *image_cache_open(const ota_image_id_t &id);
+
+/* Close a file opened by image_cache_open() */
+void image_cache_close(const ota_image_id_t &id, FILE *file);
+
+/* Start to add an image to the cache, the image data is then passed in order with image_cache_fill_write()
+ *
+ * @return ESP_ERR_INVALID_STATE if the image is already in the cache or being added by another transfer.
+ */
+esp_err_t image_cache_fill_start(const ota_image_id_t &id, uint64_t image_size, image_cache_fill_handle_t *handle);
+
+esp_err_t image_cache_fill_write(image_cache_fill_handle_t handle, const uint8_t *data, size_t len);
+
+/* Verify the digest of the written data and add the image to the cache, the handle is released
+ *
+ * @return ESP_ERR_INVALID_STATE if another version of the image with another digest is being read.
+ */
+esp_err_t image_cache_fill_finish(image_cache_fill_handle_t handle);
+
+/* Drop the written data, the handle is released */
+void image_cache_fill_abort(image_cache_fill_handle_t handle);
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -0,0 +1,64 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota_provider {
+
+/* Read-ahead of the OTA images sent by the BDX senders
+ *
+ * A read-ahead task reads the next blocks of each image into a ring of CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_READ_AHEAD_BLOCKS
+ * blocks while the current block is sent, so that the BDX senders copy the blocks from RAM instead of waiting for
+ * the HTTP(S) connection or the filesystem in the Matter thread. The task serves the streams in turn, one block at a
+ * time.
+ */
+
+// Read the next bytes of the image in the read-ahead task, returns the count of bytes read or -1 on failure
+typedef int (*read_ahead_read_cb_t)(void *ctx, uint8_t *buf, size_t size);
+// Release the reader of the image, called in the Matter thread when no read is in progress
+typedef void (*read_ahead_close_cb_t)(void *ctx, bool complete);
+// Called in the Matter thread when a block is available after read_ahead_get() returned k_read_ahead_pending
+typedef void (*read_ahead_ready_cb_t)(intptr_t arg);
+
+typedef struct read_ahead_stream *read_ahead_handle_t;
+
+// Returned by read_ahead_get() when the next block is not read yet
+constexpr int k_read_ahead_pending = -2;
+
+esp_err_t read_ahead_init();
+
+/* Start to read an image ahead in blocks of block_size
+ *
+ * @note The reader is released with close_cb, including when this function fails.
+ */
+esp_err_t read_ahead_start(read_ahead_read_cb_t read_cb, read_ahead_close_cb_t close_cb, void *ctx, size_t block_size,
+                           read_ahead_ready_cb_t ready_cb, intptr_t ready_arg, read_ahead_handle_t *handle);
+
+/* Copy the next block of the image
+ *
+ * @return the length of the block, 0 at the end of the image, -1 if the read failed, or k_read_ahead_pending if the
+ *         block is not read yet, ready_cb is then called when it is available.
+ */
+int read_ahead_get(read_ahead_handle_t handle, uint8_t *buf, size_t size);
+
+/* Stop reading the image and release its reader, complete tells whether the whole image was sent */
+void read_ahead_release(read_ahead_handle_t handle, bool complete);
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -12,10 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <esp_crt_bundle.h>
+#include <esp_heap_caps.h>
 #include <esp_log.h>
+#include <esp_matter_mem.h>
 #include <esp_matter_ota_bdx_sender.h>
 #include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_image_source.h>
+#include <esp_matter_ota_read_ahead.h>
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+#include <esp_matter_ota_image_cache.h>
+#endif
 
 #include <lib/core/CHIPError.h>
 #include <lib/support/BitFlags.h>
@@ -49,9 +55,229 @@ esp_err_t OtaBdxSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip::
     mFabricIndex.SetValue(fabricIndex);
     mNodeId.SetValue(nodeId);
     mInitialized = true;
+    mInitializedTime = chip::System::SystemClock().GetMonotonicTimestamp();
     return ESP_OK;
 }
 
+void OtaBdxSender::SetOtaImageInfo(uint16_t vendorId, uint16_t productId, uint32_t softwareVersion,
+                                   uint32_t baseVersion, const uint8_t *digest, uint64_t imageSize)
+{
+    mVendorId = vendorId;
+    mProductId = productId;
+    mSoftwareVersion = softwareVersion;
+    mBaseVersion = baseVersion;
+    mPublishedImageSize = imageSize;
+    mHasImageDigest = digest != nullptr;
+    if (digest) {
+        memcpy(mImageDigest, digest, sizeof(mImageDigest));
+    }
+}
+
+// The reader of an image, it is owned by the read-ahead stream of the transfer
+typedef struct {
+    const ota_image_source_t *source;
+    void *source_reader;
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    ota_image_id_t cache_id;
+    FILE *cache_file;
+    image_cache_fill *cache_fill;
+    // The fill is released in the Matter thread, the read-ahead task only marks it failed
+    bool cache_fill_failed;
+#endif
+} ota_image_reader_t;
+
+static int _read_image(void *ctx, uint8_t *buf, size_t size)
+{
+    ota_image_reader_t *reader = static_cast<ota_image_reader_t *>(ctx);
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    if (reader->cache_file) {
+        size_t len = fread(buf, 1, size, reader->cache_file);
+        return (len < size && ferror(reader->cache_file)) ? -1 : static_cast<int>(len);
+    }
+#endif
+    int len = reader->source->read_image(reader->source_reader, buf, size);
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    if (reader->cache_fill && !reader->cache_fill_failed && len > 0 &&
+        image_cache_fill_write(reader->cache_fill, buf, len) != ESP_OK) {
+        reader->cache_fill_failed = true;
+    }
+#endif
+    return len;
+}
+
+static void _close_image(void *ctx, bool complete)
+{
+    ota_image_reader_t *reader = static_cast<ota_image_reader_t *>(ctx);
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    image_cache_close(reader->cache_id, reader->cache_file);
+    if (reader->cache_fill) {
+        if (complete && !reader->cache_fill_failed) {
+            image_cache_fill_finish(reader->cache_fill);
+        } else {
+            image_cache_fill_abort(reader->cache_fill);
+        }
+    }
+#endif
+    if (reader->source_reader) {
+        reader->source->close_image(reader->source_reader);
+    }
+    esp_matter_mem_free(reader);
+}
+
+esp_err_t OtaBdxSender::OpenImage()
+{
+    CloseImage(false);
+    ota_image_reader_t *reader = (ota_image_reader_t *)esp_matter_mem_calloc(1, sizeof(ota_image_reader_t));
+    if (!reader) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the OTA image reader");
+        return ESP_ERR_NO_MEM;
+    }
+    reader->source = mImageSource ? mImageSource : get_ota_image_source();
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    bool cacheImage = mHasImageDigest && reader->source->cache_images;
+    ota_image_id_t &imageId = reader->cache_id;
+    imageId = {mVendorId, mProductId, mSoftwareVersion, mBaseVersion, {}};
+    if (cacheImage) {
+        memcpy(imageId.digest, mImageDigest, sizeof(imageId.digest));
+        reader->cache_file = image_cache_open(imageId);
+        if (reader->cache_file && fseek(reader->cache_file, mStartOffset, SEEK_SET) != 0) {
+            ESP_LOGE(TAG, "Failed to seek the cached image to %" PRIu64, mStartOffset);
+            image_cache_close(imageId, reader->cache_file);
+            reader->cache_file = nullptr;
+        }
+        if (reader->cache_file) {
+            ESP_LOGI(TAG, "Send the OTA image from the local cache");
+        }
+    }
+    if (!reader->cache_file)
+#endif
+    {
+        if (reader->source->open_image(reader->source->ctx, mOtaImageUrl, mStartOffset, &reader->source_reader) !=
+            ESP_OK) {
+            esp_matter_mem_free(reader);
+            return ESP_FAIL;
+        }
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+        // Only one of the transfers of an image adds it to the cache, and only if it downloads the whole image
+        if (cacheImage && mStartOffset == 0 &&
+            image_cache_fill_start(imageId, mPublishedImageSize, &reader->cache_fill) != ESP_OK) {
+            reader->cache_fill = nullptr;
+        }
+#endif
+    }
+    // The blocks are read with the negotiated block size, so that each BlockQuery takes exactly one block of the ring
+    return read_ahead_start(_read_image, _close_image, reader, mTransfer.GetTransferBlockSize(), OnBlockReady,
+                            reinterpret_cast<intptr_t>(this), &mReadAhead);
+}
+
+void OtaBdxSender::CloseImage(bool complete)
+{
+    if (mReadAhead) {
+        read_ahead_release(mReadAhead, complete);
+        mReadAhead = nullptr;
+    }
+    mBlockPending = false;
+}
+
+void OtaBdxSender::GetTransferStats(esp_matter::ota::transfer_stats_t &stats) const
+{
+    esp_matter::ota::transfer_recorder_get_stats(&mStatsRecorder, &stats);
+}
+
+uint8_t OtaBdxSender::GetPercentComplete(uint64_t imageSize) const
+{
+    uint64_t size = mOtaImageSize != 0 ? mOtaImageSize : imageSize;
+    if (size == 0) {
+        return 0;
+    }
+    return static_cast<uint8_t>(std::min<uint64_t>(100, (mStartOffset + mNumBytesSent) * 100 / size));
+}
+
+void OtaBdxSender::EndTransfer(bool complete)
+{
+    if (!mTransferStarted || !mStatsRecorder.stats.active) {
+        return;
+    }
+    esp_matter::ota::transfer_recorder_stop(&mStatsRecorder);
+    esp_matter::ota::transfer_stats_t stats;
+    esp_matter::ota::transfer_recorder_get_stats(&mStatsRecorder, &stats);
+    ESP_LOGI(TAG,
+             "Transfer %s, sent %" PRIu64 " bytes in %" PRIu32 " ms (%" PRIu32 " B/s), rtt avg %" PRIu32
+             " ms, max %" PRIu32 " ms, stalls %" PRIu32 " (%" PRIu32 " ms)",
+             complete ? "completed" : "failed", stats.bytes, stats.elapsed_ms, stats.throughput_bps, stats.avg_rtt_ms,
+             stats.max_rtt_ms, stats.stalls, stats.total_stall_ms);
+    if (mPool && mPool->mTransferEventCallback && mFabricIndex.HasValue() && mNodeId.HasValue()) {
+        mPool->mTransferEventCallback(complete ? OtaBdxSenderPool::kTransferCompleted
+                                               : OtaBdxSenderPool::kTransferFailed,
+                                      mFabricIndex.Value(), mNodeId.Value(), stats, mPool->mTransferEventCtx);
+    }
+}
+
+void OtaBdxSender::OnBlockReady(intptr_t context)
+{
+    OtaBdxSender *sender = reinterpret_cast<OtaBdxSender *>(context);
+    // The transfer might have been reset since the block was requested
+    if (sender->mBlockPending && sender->mReadAhead) {
+        sender->SendBlock(true);
+    }
+}
+
+void OtaBdxSender::SendBlock(bool async)
+{
+    TransferSession::BlockData blockData;
+    uint16_t bytesToRead = mTransfer.GetTransferBlockSize();
+
+    chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
+    if (blockBuf.IsNull()) {
+        mTransfer.AbortTransfer(StatusCode::kUnknown);
+        return;
+    }
+    int bytes_read = read_ahead_get(mReadAhead, blockBuf->Start(), bytesToRead);
+    if (bytes_read == k_read_ahead_pending) {
+        // OnBlockReady() sends the block when the read-ahead task has read it
+        mBlockPending = true;
+        return;
+    }
+    mBlockPending = false;
+    if (bytes_read < 0) {
+        ESP_LOGE(TAG, "Failed to read the OTA image");
+        mTransfer.AbortTransfer(StatusCode::kUnknown);
+    } else if (mOtaImageSize == 0 && mStartOffset == 0 && mNumBytesSent == 0 &&
+               ParseOtaImageHeader(blockBuf->Start(), static_cast<size_t>(bytes_read)) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to Parse OTA image header");
+        mTransfer.AbortTransfer(StatusCode::kUnknown);
+    } else {
+        // The image size is unknown for a transfer resumed at an offset, its end is the end of the image data
+        uint64_t offset = mStartOffset + mNumBytesSent;
+        blockData.Data = blockBuf->Start();
+        blockData.Length = static_cast<size_t>(bytes_read);
+        if (mOtaImageSize != 0) {
+            blockData.Length =
+                static_cast<size_t>(std::min(static_cast<uint64_t>(bytes_read), mOtaImageSize - offset));
+        }
+        blockData.IsEof = (blockData.Length < bytesToRead) ||
+            (offset + static_cast<uint64_t>(blockData.Length) == mOtaImageSize);
+        mNumBytesSent = static_cast<uint64_t>(mNumBytesSent + blockData.Length);
+
+        CHIP_ERROR err = mTransfer.PrepareBlock(blockData);
+        if (err != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
+            mTransfer.AbortTransfer(StatusCode::kUnknown);
+        } else {
+            esp_matter::ota::transfer_recorder_add_block(&mStatsRecorder, blockData.Length);
+            mBlockSentMs = esp_matter::ota::transfer_timestamp_ms();
+        }
+    }
+    if (async) {
+        // Out of the message handling of the Responder, send the Block or the StatusReport now
+        TransferSession::OutputEvent event;
+        do {
+            mTransfer.PollOutput(event, chip::System::SystemClock().GetMonotonicTimestamp());
+            HandleTransferSessionOutput(event);
+        } while (event.EventType != TransferSession::OutputEventType::kNone);
+    }
+}
+
 esp_err_t OtaBdxSender::ParseOtaImageHeader(const uint8_t *header_buf, size_t header_buf_size)
 {
     if (header_buf_size < sizeof(ota_image_header_prefix_t)) {
@@ -96,6 +322,10 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
             if (!sendFlags.Has(chip::Messaging::SendMessageFlags::kExpectResponse)) {
                 // After sending the StatusReport, exchange context gets closed so, set mExchangeCtx to null
                 mExchangeCtx = nullptr;
+                // The StatusReport aborts the transfer, report it as failed to the rollout dashboard and release the
+                // sender for the other requestors
+                EndTransfer(false);
+                Reset();
             }
         } else {
             ESP_LOGE(TAG, "SendMessage failed: %" CHIP_ERROR_FORMAT, err.Format());
@@ -116,64 +346,34 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
             ESP_LOGE(TAG, "AcceptTransfter failed error:%" CHIP_ERROR_FORMAT, err.Format());
             return;
         }
-        // Establish http connection
-        esp_http_client_config_t config = {
-            .url = mOtaImageUrl,
-            .event_handler = NULL,
-            .transport_type = HTTP_TRANSPORT_OVER_SSL,
-            .skip_cert_common_name_check = false,
-            .crt_bundle_attach = esp_crt_bundle_attach,
-            .keep_alive_enable = true,
-        };
-        if (mHttpDownloader) {
-            http_downloader_abort(mHttpDownloader);
-        }
-        if (http_downloader_start(&config, &mHttpDownloader) != ESP_OK) {
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
+        mTransferStarted = true;
+        mStartOffset = mTransfer.GetStartOffset();
+        if (mStartOffset != 0) {
+            ESP_LOGI(TAG, "Resume the transfer at offset %" PRIu64, mStartOffset);
         }
-        break;
-    }
-    case TransferSession::OutputEventType::kQueryReceived: {
-        TransferSession::BlockData blockData;
-        uint16_t bytesToRead = mTransfer.GetTransferBlockSize();
-
-        chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
-        if (blockBuf.IsNull()) {
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-            return;
-        }
-        // Read http response
-        int bytes_read =
-            http_downloader_read(mHttpDownloader, reinterpret_cast<char *>(blockBuf->Start()), bytesToRead);
-        if (bytes_read < 0) {
-            ESP_LOGE(TAG, "http_downloader_read failed");
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-            break;
-        }
-        if (mOtaImageSize == 0 && mNumBytesSent == 0) {
-            if (ParseOtaImageHeader(blockBuf->Start(), static_cast<size_t>(bytes_read)) != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to Parse OTA image header");
-                mTransfer.AbortTransfer(StatusCode::kUnknown);
-                break;
-            }
+        esp_matter::ota::transfer_recorder_start(&mStatsRecorder, mTransferRetries);
+        mBlockSentMs = 0;
+        if (mPool && mPool->mTransferEventCallback) {
+            esp_matter::ota::transfer_stats_t stats;
+            GetTransferStats(stats);
+            mPool->mTransferEventCallback(OtaBdxSenderPool::kTransferStarted, mFabricIndex.Value(), mNodeId.Value(),
+                                          stats, mPool->mTransferEventCtx);
         }
-        blockData.Data = blockBuf->Start();
-        blockData.Length =
-            static_cast<size_t>(std::min(static_cast<uint64_t>(bytes_read), (mOtaImageSize - mNumBytesSent)));
-        blockData.IsEof = (blockData.Length < bytesToRead) ||
-            (mNumBytesSent + static_cast<uint64_t>(blockData.Length) == mOtaImageSize);
-        mNumBytesSent = static_cast<uint64_t>(mNumBytesSent + blockData.Length);
-
-        if (CHIP_NO_ERROR != mTransfer.PrepareBlock(blockData)) {
-            ESP_LOGE(TAG, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
+        if (OpenImage() != ESP_OK) {
             mTransfer.AbortTransfer(StatusCode::kUnknown);
         }
         break;
     }
+    case TransferSession::OutputEventType::kQueryReceived:
+        RecordBlockRtt();
+        SendBlock(false);
+        break;
     case TransferSession::OutputEventType::kAckReceived:
         break;
     case TransferSession::OutputEventType::kAckEOFReceived: {
-        ESP_LOGI(TAG, "Transfer completed, got AckEOF");
+        RecordBlockRtt();
+        EndTransfer(true);
+        CloseImage(mStartOffset == 0 && mOtaImageSize != 0 && mNumBytesSent == mOtaImageSize);
         Reset();
         break;
     }
@@ -201,8 +401,19 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
     return;
 }
 
+void OtaBdxSender::RecordBlockRtt()
+{
+    if (mBlockSentMs != 0) {
+        esp_matter::ota::transfer_recorder_add_rtt(
+            &mStatsRecorder, static_cast<uint32_t>(esp_matter::ota::transfer_timestamp_ms() - mBlockSentMs));
+        mBlockSentMs = 0;
+    }
+}
+
 void OtaBdxSender::Reset()
 {
+    // A transfer which did not get the AckEOF failed
+    EndTransfer(false);
     mFabricIndex.ClearValue();
     mNodeId.ClearValue();
     ResetTransfer();
@@ -212,14 +423,17 @@ void OtaBdxSender::Reset()
     }
 
     mInitialized = false;
+    mTransferStarted = false;
     mNumBytesSent = 0;
+    mStartOffset = 0;
     mOtaImageSize = 0;
-    if (mHttpDownloader) {
-        // Release current http client
-        http_downloader_abort(mHttpDownloader);
-    }
-    mHttpDownloader = nullptr;
+    CloseImage(false);
     memset(mOtaImageUrl, 0, sizeof(mOtaImageUrl));
+    mImageSource = nullptr;
+    mHasImageDigest = false;
+    mPublishedImageSize = 0;
+    mTransferRetries = 0;
+    mBlockSentMs = 0;
 }
 
 uint16_t OtaBdxSender::GetTransferBlockSize(void)
@@ -232,5 +446,186 @@ uint64_t OtaBdxSender::GetTransferLength()
     return mTransfer.GetTransferLength();
 }
 
+esp_err_t OtaBdxSenderPool::Init(chip::Messaging::ExchangeManager &exchangeMgr,
+                                 chip::System::Clock::Timeout reservationTimeout)
+{
+    mReservationTimeout = reservationTimeout;
+    for (OtaBdxSender &sender : mSenders) {
+        sender.mPool = this;
+    }
+    if (read_ahead_init() != ESP_OK) {
+        return ESP_FAIL;
+    }
+    CHIP_ERROR err = exchangeMgr.RegisterUnsolicitedMessageHandlerForProtocol(chip::Protocols::BDX::Id, this);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to register the BDX handler: %" CHIP_ERROR_FORMAT, err.Format());
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+bool OtaBdxSenderPool::IsFree(const OtaBdxSender &sender)
+{
+    if (!sender.mInitialized) {
+        return true;
+    }
+    return !sender.mTransferStarted &&
+        chip::System::SystemClock().GetMonotonicTimestamp() - sender.mInitializedTime >= mReservationTimeout;
+}
+
+OtaBdxSender *OtaBdxSenderPool::Find(chip::FabricIndex fabricIndex, chip::NodeId nodeId)
+{
+    for (OtaBdxSender &sender : mSenders) {
+        if (sender.mInitialized && sender.mFabricIndex.HasValue() && sender.mFabricIndex.Value() == fabricIndex &&
+            sender.mNodeId.HasValue() && sender.mNodeId.Value() == nodeId) {
+            return &sender;
+        }
+    }
+    return nullptr;
+}
+
+size_t OtaBdxSenderPool::GetFreeCount()
+{
+    size_t count = 0;
+    for (const OtaBdxSender &sender : mSenders) {
+        if (IsFree(sender)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+OtaBdxSender *OtaBdxSenderPool::Acquire(chip::FabricIndex fabricIndex, chip::NodeId nodeId)
+{
+    // A requestor which queries the image again restarts its transfer on the same sender
+    OtaBdxSender *sender = Find(fabricIndex, nodeId);
+    if (!sender) {
+        // Each transfer holds a HTTPS connection, do not start one which would exhaust the heap
+        size_t freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        if (freeHeap < CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MIN_FREE_HEAP) {
+            ESP_LOGW(TAG, "Free heap %u is too low to start another BDX transfer", static_cast<unsigned>(freeHeap));
+            return nullptr;
+        }
+        for (OtaBdxSender &candidate : mSenders) {
+            if (IsFree(candidate)) {
+                sender = &candidate;
+                break;
+            }
+        }
+        if (!sender) {
+            return nullptr;
+        }
+        if (sender->mInitialized) {
+            ESP_LOGW(TAG, "Node 0x%" PRIx64 " did not start its BDX transfer, release the sender",
+                     sender->mNodeId.Value());
+            sender->Reset();
+        }
+    }
+    if (sender->InitializeTransfer(fabricIndex, nodeId) != ESP_OK) {
+        return nullptr;
+    }
+    return sender;
+}
+
+static uint64_t _timestamp_ms()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+void OtaBdxSenderPool::ExpireWaiters()
+{
+    uint64_t nowMs = _timestamp_ms();
+    for (Waiter *waiter = mWaiterHead; waiter;) {
+        Waiter *next = waiter->mNext;
+        if (waiter->mExpiryMs < nowMs) {
+            CancelWait(*waiter);
+        }
+        waiter = next;
+    }
+}
+
+OtaBdxSender *OtaBdxSenderPool::Admit(chip::FabricIndex fabricIndex, chip::NodeId nodeId, Waiter &waiter,
+                                      size_t &waitPosition)
+{
+    ExpireWaiters();
+    waitPosition = 0;
+    for (Waiter *iter = mWaiterHead; iter && iter != &waiter; iter = iter->mNext) {
+        waitPosition++;
+    }
+    // A node which already has a sender restarts its transfer on it
+    if (!Find(fabricIndex, nodeId) && GetFreeCount() <= waitPosition) {
+        return nullptr;
+    }
+    OtaBdxSender *sender = Acquire(fabricIndex, nodeId);
+    if (sender) {
+        CancelWait(waiter);
+    }
+    return sender;
+}
+
+uint32_t OtaBdxSenderPool::Wait(Waiter &waiter, size_t waitPosition, uint32_t queryDelaySec)
+{
+    uint32_t delaySec = queryDelaySec * (1 + waitPosition / kMaxSessions);
+    if (waiter.mTicket == 0) {
+        waiter.mTicket = ++mNextTicket;
+        waiter.mPrev = mWaiterTail;
+        waiter.mNext = nullptr;
+        if (mWaiterTail) {
+            mWaiterTail->mNext = &waiter;
+        } else {
+            mWaiterHead = &waiter;
+        }
+        mWaiterTail = &waiter;
+        mWaiterCount++;
+    }
+    // The waiter keeps its position if it queries again within twice the delay
+    waiter.mExpiryMs = _timestamp_ms() + 2 * static_cast<uint64_t>(delaySec) * 1000;
+    return delaySec;
+}
+
+void OtaBdxSenderPool::CancelWait(Waiter &waiter)
+{
+    if (waiter.mTicket == 0) {
+        return;
+    }
+    if (waiter.mPrev) {
+        waiter.mPrev->mNext = waiter.mNext;
+    } else {
+        mWaiterHead = waiter.mNext;
+    }
+    if (waiter.mNext) {
+        waiter.mNext->mPrev = waiter.mPrev;
+    } else {
+        mWaiterTail = waiter.mPrev;
+    }
+    waiter.mTicket = 0;
+    waiter.mPrev = nullptr;
+    waiter.mNext = nullptr;
+    mWaiterCount--;
+}
+
+CHIP_ERROR OtaBdxSenderPool::OnUnsolicitedMessageReceived(const chip::PayloadHeader &payloadHeader,
+                                                          chip::Messaging::ExchangeDelegate *&newDelegate)
+{
+    newDelegate = this;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OtaBdxSenderPool::OnMessageReceived(chip::Messaging::ExchangeContext *ec,
+                                               const chip::PayloadHeader &payloadHeader,
+                                               chip::System::PacketBufferHandle &&payload)
+{
+    chip::ScopedNodeId peer = ec->GetSessionHandle()->GetPeer();
+    OtaBdxSender *sender = Find(peer.GetFabricIndex(), peer.GetNodeId());
+    if (!sender || sender->mExchangeCtx != nullptr) {
+        ESP_LOGE(TAG, "No BDX transfer prepared for node 0x%" PRIx64, peer.GetNodeId());
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+    // The next messages of the exchange are delivered to the sender directly
+    ec->SetDelegate(sender);
+    return static_cast<chip::Messaging::ExchangeDelegate *>(sender)->OnMessageReceived(ec, payloadHeader,
+                                                                                        std::move(payload));
+}
+
 } // namespace ota_provider
 } // namespace esp_matter
@@ -20,6 +20,8 @@
 #include <esp_log.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_ota_candidates.h>
+#include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_image_source.h>
 #include <esp_matter_ota_provider.h>
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
@@ -28,6 +30,8 @@
 #include <freertos/task.h>
 #include <functional>
 #include <json_parser.h>
+#include <mbedtls/base64.h>
+#include <nvs.h>
 
 #include <lib/support/ScopedBuffer.h>
 
@@ -46,8 +50,30 @@ static constexpr char dcl_rest_url[] = "https://on.dcl.csa-iot.org/dcl/model/ver
 static constexpr char dcl_rest_url[] = "https://on.test-net.dcl.csa-iot.org/dcl/model/versions";
 #endif
 static constexpr size_t max_ota_candidate_count = CONFIG_ESP_MATTER_MAX_OTA_CANDIDATES_COUNT;
+// OTA checksum type of SHA-256 in the DCL, from the IANA Named Information Hash Algorithm Registry
+static constexpr int dcl_ota_checksum_type_sha256 = 1;
 
-static model_version_t *_ota_candidates_cache[max_ota_candidate_count];
+static constexpr size_t _candidates_table_size(size_t count)
+{
+    // Power of two with at least twice the entries, so that the probe sequences stay short
+    size_t size = 1;
+    while (size < count * 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static constexpr size_t candidates_table_size = _candidates_table_size(max_ota_candidate_count);
+static constexpr uint32_t candidate_ttl_s = CONFIG_ESP_MATTER_OTA_CANDIDATES_TTL * 3600;
+static constexpr uint32_t negative_candidate_ttl_s = CONFIG_ESP_MATTER_OTA_CANDIDATES_NEGATIVE_TTL * 60;
+static constexpr char candidates_nvs_namespace[] = "ota_candidates";
+static constexpr char candidates_nvs_key[] = "cache";
+
+// Open addressing hash table of the candidates keyed by VendorID and ProductID, with linear probing
+static model_version_t *_ota_candidates_cache[candidates_table_size];
+static size_t _ota_candidates_count = 0;
+static uint32_t _ota_candidates_clock = 0;
+static ota_candidates_stats_t _ota_candidates_stats;
 static QueueHandle_t _ota_candidate_task_queue = NULL;
 #ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
 static esp_timer_handle_t _ota_candidates_update_timer = NULL;
@@ -61,59 +87,183 @@ typedef struct {
     void *callback_args;
 } ota_candidate_fetch_action_t;
 
+static uint32_t _now_s()
+{
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+}
+
+static size_t _candidate_hash(uint16_t vendor_id, uint16_t product_id)
+{
+    uint32_t key = ((uint32_t)vendor_id << 16) | product_id;
+    key = (key ^ (key >> 16)) * 0x45d9f3b;
+    key ^= key >> 16;
+    return key & (candidates_table_size - 1);
+}
+
 static bool _is_ota_candidate_valid(model_version_t *model, uint32_t current_software_version)
 {
-    return model->software_version > current_software_version &&
+    return model->update_available && model->software_version > current_software_version &&
         model->max_applicable_software_version >= current_software_version &&
         model->min_applicable_software_version <= current_software_version;
 }
 
-static int _search_ota_candidate(uint16_t vendor_id, uint16_t product_id, uint32_t software_ver)
+// Whether the entry tells that the DCL has no update for the software version
+static bool _is_ota_candidate_absent(model_version_t *model, uint32_t current_software_version)
 {
-    for (size_t index = 0; index < max_ota_candidate_count; ++index) {
+    return current_software_version >= model->latest_software_version ||
+        (!model->update_available && model->checked_software_version == current_software_version);
+}
+
+static int _find_ota_candidate_slot(uint16_t vendor_id, uint16_t product_id)
+{
+    size_t index = _candidate_hash(vendor_id, product_id);
+    for (size_t probe = 0; probe < candidates_table_size; ++probe) {
         model_version_t *cur_model = _ota_candidates_cache[index];
-        if (cur_model) {
-            if (cur_model->vendor_id == vendor_id && cur_model->product_id == product_id) {
-                if (_is_ota_candidate_valid(cur_model, software_ver)) {
-                    return index;
-                } else {
-                    // This candidate is not valid, expire it.
-                    esp_matter_mem_free(cur_model);
-                    _ota_candidates_cache[index] = nullptr;
-                    return -1;
-                }
-            }
+        if (!cur_model) {
+            return -1;
         }
+        if (cur_model->vendor_id == vendor_id && cur_model->product_id == product_id) {
+            return index;
+        }
+        index = (index + 1) & (candidates_table_size - 1);
     }
     return -1;
 }
 
-static size_t _find_empty_ota_candidates()
+static void _remove_ota_candidate(size_t index)
 {
-    uint8_t oldest_candidate_lifetime = 0;
-    size_t oldest_candidate_index = 0;
-    for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        if (!_ota_candidates_cache[index]) {
-            return index;
-        } else {
-            if (oldest_candidate_lifetime < _ota_candidates_cache[index]->lifetime) {
-                oldest_candidate_lifetime = _ota_candidates_cache[index]->lifetime;
-                oldest_candidate_index = index;
+    esp_matter_mem_free(_ota_candidates_cache[index]);
+    _ota_candidates_cache[index] = nullptr;
+    _ota_candidates_count--;
+    // Move back the following entries of the probe sequence so that the lookups do not stop at the hole
+    size_t hole = index;
+    size_t next = (index + 1) & (candidates_table_size - 1);
+    while (_ota_candidates_cache[next]) {
+        size_t home = _candidate_hash(_ota_candidates_cache[next]->vendor_id, _ota_candidates_cache[next]->product_id);
+        bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!stays) {
+            _ota_candidates_cache[hole] = _ota_candidates_cache[next];
+            _ota_candidates_cache[next] = nullptr;
+            hole = next;
+        }
+        next = (next + 1) & (candidates_table_size - 1);
+    }
+}
+
+// Add or replace the entry of the model, the least recently used entry is evicted when the cache is full
+static void _insert_ota_candidate(model_version_t *candidate)
+{
+    int index = _find_ota_candidate_slot(candidate->vendor_id, candidate->product_id);
+    if (index >= 0) {
+        _remove_ota_candidate(index);
+    } else if (_ota_candidates_count >= max_ota_candidate_count) {
+        size_t lru_index = 0;
+        for (size_t slot = 0; slot < candidates_table_size; ++slot) {
+            if (_ota_candidates_cache[slot] &&
+                (!_ota_candidates_cache[lru_index] ||
+                 _ota_candidates_cache[slot]->last_used < _ota_candidates_cache[lru_index]->last_used)) {
+                lru_index = slot;
             }
         }
+        _remove_ota_candidate(lru_index);
+        _ota_candidates_stats.evictions++;
+    }
+    size_t slot = _candidate_hash(candidate->vendor_id, candidate->product_id);
+    while (_ota_candidates_cache[slot]) {
+        slot = (slot + 1) & (candidates_table_size - 1);
+    }
+    candidate->last_used = ++_ota_candidates_clock;
+    _ota_candidates_cache[slot] = candidate;
+    _ota_candidates_count++;
+}
+
+static nvs_handle_t _open_candidates_nvs(nvs_open_mode_t mode)
+{
+    nvs_handle_t handle = 0;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, candidates_nvs_namespace, mode, &handle) != ESP_OK) {
+        return 0;
     }
-    // expire the oldest candidate
-    esp_matter_mem_free(_ota_candidates_cache[oldest_candidate_index]);
-    _ota_candidates_cache[oldest_candidate_index] = nullptr;
-    return oldest_candidate_index;
+    return handle;
 }
 
-static void _increase_ota_candidates_lifetime()
+// The entries are saved with the remaining time to live, the time the device is off is not counted
+static void _save_ota_candidates_cache()
 {
-    for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        if (_ota_candidates_cache[index]) {
-            _ota_candidates_cache[index]->lifetime++;
+    model_version_t *entries = nullptr;
+    nvs_handle_t handle = _open_candidates_nvs(NVS_READWRITE);
+    if (!handle) {
+        ESP_LOGE(TAG, "Failed to open the NVS namespace of the OTA candidates");
+        return;
+    }
+    if (_ota_candidates_count == 0) {
+        nvs_erase_key(handle, candidates_nvs_key);
+        goto close;
+    }
+    entries = (model_version_t *)esp_matter_mem_calloc(_ota_candidates_count, sizeof(model_version_t));
+    if (entries) {
+        uint32_t now = _now_s();
+        size_t count = 0;
+        for (model_version_t *candidate : _ota_candidates_cache) {
+            if (candidate) {
+                entries[count] = *candidate;
+                entries[count].expiry_time = candidate->expiry_time > now ? candidate->expiry_time - now : 0;
+                count++;
+            }
+        }
+        if (nvs_set_blob(handle, candidates_nvs_key, entries, count * sizeof(model_version_t)) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to save the OTA candidates cache");
+        }
+        esp_matter_mem_free(entries);
+    }
+close:
+    nvs_commit(handle);
+    nvs_close(handle);
+}
+
+static void _load_ota_candidates_cache()
+{
+    nvs_handle_t handle = _open_candidates_nvs(NVS_READONLY);
+    if (!handle) {
+        return;
+    }
+    size_t size = 0;
+    model_version_t *entries = nullptr;
+    if (nvs_get_blob(handle, candidates_nvs_key, nullptr, &size) != ESP_OK || size == 0) {
+        nvs_close(handle);
+        return;
+    }
+    // The entries were saved with another layout or cache size
+    if (size % sizeof(model_version_t) != 0 || size / sizeof(model_version_t) > max_ota_candidate_count) {
+        ESP_LOGW(TAG, "Drop the saved OTA candidates cache");
+        nvs_close(handle);
+        return;
+    }
+    entries = (model_version_t *)esp_matter_mem_calloc(1, size);
+    if (entries && nvs_get_blob(handle, candidates_nvs_key, entries, &size) == ESP_OK) {
+        uint32_t now = _now_s();
+        for (size_t index = 0; index < size / sizeof(model_version_t); ++index) {
+            if (entries[index].expiry_time == 0) {
+                continue;
+            }
+            model_version_t *candidate = (model_version_t *)esp_matter_mem_calloc(1, sizeof(model_version_t));
+            if (!candidate) {
+                break;
+            }
+            *candidate = entries[index];
+            candidate->expiry_time += now;
+            _insert_ota_candidate(candidate);
         }
+        ESP_LOGI(TAG, "Loaded %u OTA candidates from NVS", (unsigned)_ota_candidates_count);
+    }
+    esp_matter_mem_free(entries);
+    nvs_close(handle);
+}
+
+void get_ota_candidates_stats(ota_candidates_stats_t *stats)
+{
+    if (stats) {
+        *stats = _ota_candidates_stats;
+        stats->entries = _ota_candidates_count;
     }
 }
 
@@ -150,6 +300,7 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
     ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_GET), cleanup, TAG, "Failed to set http method");
 
     // HTTP GET
+    _ota_candidates_stats.dcl_requests++;
     ESP_GOTO_ON_ERROR(esp_http_client_open(client, 0), cleanup, TAG, "Failed to open http connection");
 
     // Read Response
@@ -165,7 +316,8 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
         http_payload[http_len] = '\0';
         ESP_LOGE(TAG, "Invalid response for %s", url);
         ESP_LOGE(TAG, "Status = %d, Data = %s", http_status_code, http_len > 0 ? http_payload.Get() : "None");
-        ret = ESP_FAIL;
+        // The model is not on the DCL
+        ret = http_status_code == HttpStatus_NotFound ? ESP_ERR_NOT_FOUND : ESP_FAIL;
         goto close;
     }
     ESP_LOGD(TAG, "http_response:\n%s", http_payload.Get());
@@ -203,6 +355,9 @@ close:
 cleanup:
     esp_http_client_cleanup(client);
 
+    if (ret != ESP_OK && ret != ESP_ERR_NOT_FOUND) {
+        _ota_candidates_stats.dcl_failures++;
+    }
     if (ret != ESP_OK) {
         if (*software_version_array) {
             esp_matter_mem_free(*software_version_array);
@@ -213,6 +368,29 @@ cleanup:
     return ret;
 }
 
+static void _parse_ota_file_info(jparse_ctx_t *jctx, model_version_t *model)
+{
+    // The 64-bit integers are encoded as strings in the DCL responses
+    char buf[64];
+    int64_t file_size = 0;
+    if (json_obj_get_string(jctx, "otaFileSize", buf, sizeof(buf)) == 0) {
+        model->ota_file_size = strtoul(buf, nullptr, 10);
+    } else if (json_obj_get_int64(jctx, "otaFileSize", &file_size) == 0) {
+        model->ota_file_size = file_size;
+    }
+    int checksum_type = 0;
+    size_t digest_len = 0;
+    model->has_ota_digest = false;
+    if (json_obj_get_int(jctx, "otaChecksumType", &checksum_type) == 0 &&
+        checksum_type == dcl_ota_checksum_type_sha256 &&
+        json_obj_get_string(jctx, "otaChecksum", buf, sizeof(buf)) == 0 &&
+        mbedtls_base64_decode(model->ota_digest, sizeof(model->ota_digest), &digest_len, (const unsigned char *)buf,
+                              strnlen(buf, sizeof(buf))) == 0 &&
+        digest_len == sizeof(model->ota_digest)) {
+        model->has_ota_digest = true;
+    }
+}
+
 static esp_err_t _query_ota_candidate(model_version_t *model, uint32_t new_software_version,
                                       uint32_t current_software_version)
 {
@@ -243,6 +421,7 @@ static esp_err_t _query_ota_candidate(model_version_t *model, uint32_t new_softw
     ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_GET), cleanup, TAG, "Failed to set http method");
 
     // HTTP GET
+    _ota_candidates_stats.dcl_requests++;
     ESP_GOTO_ON_ERROR(esp_http_client_open(client, 0), cleanup, TAG, "Failed to open http connection");
 
     // Read Response
@@ -290,6 +469,7 @@ static esp_err_t _query_ota_candidate(model_version_t *model, uint32_t new_softw
                 json_obj_get_string(&jctx, "otaUrl", model->ota_url, sizeof(model->ota_url)) == 0) {
                 model->ota_url[string_len] = 0;
             }
+            _parse_ota_file_info(&jctx, model);
         } else {
             ESP_LOGI(TAG, "This result is not valid for software version %ld, skip it", current_software_version);
             ret = ESP_ERR_NOT_FINISHED;
@@ -304,34 +484,76 @@ close:
     esp_http_client_close(client);
 cleanup:
     esp_http_client_cleanup(client);
+    if (ret != ESP_OK && ret != ESP_ERR_NOT_FINISHED) {
+        _ota_candidates_stats.dcl_failures++;
+    }
     return ret;
 }
 
+// Query the DCL for an update of the software version. Returns the new cache entry, which is negative if the DCL has
+// no update, or nullptr if the DCL could not be queried.
+static model_version_t *_fetch_ota_candidate_from_dcl(uint16_t vendor_id, uint16_t product_id,
+                                                      uint32_t software_version)
+{
+    uint32_t *software_version_array = nullptr;
+    size_t software_version_count = 0;
+    esp_err_t err =
+        _query_software_version_array(vendor_id, product_id, &software_version_array, software_version_count);
+    if (err != ESP_OK && err != ESP_ERR_NOT_FOUND) {
+        return nullptr;
+    }
+    model_version_t *candidate = (model_version_t *)esp_matter_mem_calloc(1, sizeof(model_version_t));
+    if (!candidate) {
+        esp_matter_mem_free(software_version_array);
+        return nullptr;
+    }
+    candidate->vendor_id = vendor_id;
+    candidate->product_id = product_id;
+    candidate->checked_software_version = software_version;
+    if (software_version_array && software_version_count > 0) {
+        // Sort the software version array
+        std::sort(software_version_array, software_version_array + software_version_count, std::greater<uint32_t>());
+        candidate->latest_software_version = software_version_array[0];
+        for (size_t index = 0; index < software_version_count && software_version_array[index] > software_version;
+             ++index) {
+            err = _query_ota_candidate(candidate, software_version_array[index], software_version);
+            if (err == ESP_OK) {
+                candidate->update_available = true;
+                break;
+            } else if (err != ESP_ERR_NOT_FINISHED) {
+                break;
+            }
+        }
+        esp_matter_mem_free(software_version_array);
+    }
+    if (!candidate->update_available && err != ESP_OK && err != ESP_ERR_NOT_FINISHED && err != ESP_ERR_NOT_FOUND) {
+        // Do not cache that there is no update when the DCL could not be queried
+        esp_matter_mem_free(candidate);
+        return nullptr;
+    }
+    candidate->expiry_time = _now_s() + (candidate->update_available ? candidate_ttl_s : negative_candidate_ttl_s);
+    return candidate;
+}
+
 #ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
 static void _update_all_ota_candidates_cache()
 {
-    for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        model_version_t *candidate = _ota_candidates_cache[index];
+    // The entries are refreshed in place, so that the slots of the hash table do not move during the iteration. The
+    // negative entries are not refreshed, they are queried again when they expire.
+    for (size_t index = 0; index < candidates_table_size; ++index) {
+        model_version_t *cached = _ota_candidates_cache[index];
+        if (!cached || !cached->update_available) {
+            continue;
+        }
+        model_version_t *candidate =
+            _fetch_ota_candidate_from_dcl(cached->vendor_id, cached->product_id, cached->checked_software_version);
         if (candidate) {
-            uint32_t *software_version_array = nullptr;
-            size_t software_version_count;
-            esp_err_t err = _query_software_version_array(candidate->vendor_id, candidate->product_id,
-                                                          &software_version_array, software_version_count);
-            if (err == ESP_OK && software_version_array && software_version_count > 0) {
-                std::sort(&software_version_array[0], &software_version_array[software_version_count - 1],
-                          std::greater<uint32_t>());
-                for (size_t index = 0;
-                     index < software_version_count && software_version_array[index] > candidate->software_version;
-                     ++index) {
-                    err = _query_ota_candidate(candidate, software_version_array[index], candidate->software_version);
-                    if (err == ESP_OK) {
-                        break;
-                    }
-                }
-                esp_matter_mem_free(software_version_array);
-            }
+            candidate->last_used = cached->last_used;
+            *cached = *candidate;
+            esp_matter_mem_free(candidate);
         }
     }
+    _save_ota_candidates_cache();
 }
 
 static void _ota_candidates_periodic_update_handler(void *arg)
@@ -344,51 +566,108 @@ static void _ota_candidates_periodic_update_handler(void *arg)
 }
 #endif
 
-static void _ota_candidate_fetch_handler(ota_candidate_fetch_action_t &action)
+static void _fill_ota_image_info(const model_version_t *candidate, ota_image_info_t *info)
+{
+    info->software_version = candidate->software_version;
+    strlcpy(info->software_version_str, candidate->software_version_str, sizeof(info->software_version_str));
+    strlcpy(info->ota_url, candidate->ota_url, sizeof(info->ota_url));
+    info->ota_file_size = candidate->ota_file_size;
+    info->has_ota_digest = candidate->has_ota_digest;
+    memcpy(info->ota_digest, candidate->ota_digest, sizeof(info->ota_digest));
+}
+
+// Find the update in the OTA candidates cache, or query the DCL if the cache has no answer for the software version
+static esp_err_t _dcl_query_image(void *ctx, uint16_t vendor_id, uint16_t product_id, uint32_t software_version,
+                                  ota_image_info_t *info)
 {
     model_version_t *candidate = nullptr;
+    int candidate_index = _find_ota_candidate_slot(vendor_id, product_id);
+    if (candidate_index >= 0) {
+        candidate = _ota_candidates_cache[candidate_index];
+        if (_now_s() >= candidate->expiry_time) {
+            _remove_ota_candidate(candidate_index);
+        } else if (_is_ota_candidate_valid(candidate, software_version)) {
+            _ota_candidates_stats.hits++;
+            candidate->last_used = ++_ota_candidates_clock;
+            _fill_ota_image_info(candidate, info);
+            return ESP_OK;
+        } else if (_is_ota_candidate_absent(candidate, software_version)) {
+            _ota_candidates_stats.negative_hits++;
+            candidate->last_used = ++_ota_candidates_clock;
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+    // Cannot find the candidate from cache, we need to query DCL for a new candidate
+    _ota_candidates_stats.misses++;
+    candidate = _fetch_ota_candidate_from_dcl(vendor_id, product_id, software_version);
+    if (candidate) {
+        _insert_ota_candidate(candidate);
+    }
+    if (candidate || candidate_index >= 0) {
+        _save_ota_candidates_cache();
+    }
+    if (candidate && candidate->update_available) {
+        _fill_ota_image_info(candidate, info);
+        return ESP_OK;
+    }
+    return candidate ? ESP_ERR_NOT_FOUND : ESP_FAIL;
+}
+
+static esp_err_t _dcl_open_image(void *ctx, const char *ota_url, uint64_t offset, void **reader)
+{
+    esp_http_client_config_t config = {
+        .url = ota_url,
+        .event_handler = NULL,
+        .transport_type = HTTP_TRANSPORT_OVER_SSL,
+        .skip_cert_common_name_check = false,
+        .crt_bundle_attach = esp_crt_bundle_attach,
+        .keep_alive_enable = true,
+    };
+    http_downloader_handle_t downloader = nullptr;
+    ESP_RETURN_ON_ERROR(http_downloader_start(&config, offset, &downloader), TAG, "Failed to download %s", ota_url);
+    *reader = downloader;
+    return ESP_OK;
+}
+
+static int _dcl_read_image(void *reader, uint8_t *buf, size_t size)
+{
+    return http_downloader_read(static_cast<http_downloader_handle_t>(reader), reinterpret_cast<char *>(buf), size);
+}
+
+static void _dcl_close_image(void *reader)
+{
+    http_downloader_abort(static_cast<http_downloader_handle_t>(reader));
+}
+
+static const ota_image_source_t _dcl_image_source = {
+    .query_image = _dcl_query_image,
+    .open_image = _dcl_open_image,
+    .read_image = _dcl_read_image,
+    .close_image = _dcl_close_image,
+    .ctx = nullptr,
+    .cache_images = true,
+};
+
+const ota_image_source_t *get_dcl_image_source()
+{
+    return &_dcl_image_source;
+}
+
+static void _ota_candidate_fetch_handler(ota_candidate_fetch_action_t &action)
+{
     assert(action.callback);
-    int candate_index = _search_ota_candidate(action.vendor_id, action.product_id, action.software_version);
-    if (candate_index >= 0 && candate_index < max_ota_candidate_count && _ota_candidates_cache[candate_index]) {
-        candidate = _ota_candidates_cache[candate_index];
-        action.callback(EspOtaProvider::OTAQueryStatus::kUpdateAvailable, candidate->ota_url, candidate->ota_file_size,
-                        candidate->software_version, candidate->software_version_str, action.callback_args);
+    const ota_image_source_t *source = get_ota_image_source();
+    ota_image_info_t info;
+    if (source->query_image(source->ctx, action.vendor_id, action.product_id, action.software_version, &info) ==
+        ESP_OK) {
+        action.callback(EspOtaProvider::OTAQueryStatus::kUpdateAvailable, info.ota_url,
+                        static_cast<size_t>(info.ota_file_size), info.has_ota_digest ? info.ota_digest : nullptr,
+                        info.software_version, info.software_version_str, action.callback_args);
         return;
-    } else {
-        // Cannot find the candidate from cache, we need to query DCL for a new candidate;
-        uint32_t *software_version_array = nullptr;
-        size_t software_version_count;
-        esp_err_t err = _query_software_version_array(action.vendor_id, action.product_id, &software_version_array,
-                                                      software_version_count);
-        if (err == ESP_OK && software_version_array && software_version_count > 0) {
-            // Sort the software version array
-            std::sort(&software_version_array[0], &software_version_array[software_version_count - 1],
-                      std::greater<uint32_t>());
-            candidate = (model_version_t *)esp_matter_mem_calloc(1, sizeof(model_version_t));
-            candidate->vendor_id = action.vendor_id;
-            candidate->product_id = action.product_id;
-            for (size_t index = 0;
-                 index < software_version_count && software_version_array[index] > action.software_version; ++index) {
-                err = _query_ota_candidate(candidate, software_version_array[index], action.software_version);
-                if (err == ESP_OK) {
-                    size_t empty_index = _find_empty_ota_candidates();
-                    _increase_ota_candidates_lifetime();
-                    candidate->lifetime = 0;
-                    // Add this candidate to cache
-                    _ota_candidates_cache[empty_index] = candidate;
-                    action.callback(EspOtaProvider::OTAQueryStatus::kUpdateAvailable, candidate->ota_url,
-                                    candidate->ota_file_size, candidate->software_version,
-                                    candidate->software_version_str, action.callback_args);
-                    esp_matter_mem_free(software_version_array);
-                    return;
-                }
-            }
-            esp_matter_mem_free(candidate);
-            esp_matter_mem_free(software_version_array);
-        }
     }
-    // Cannot fetch the candidate
-    action.callback(EspOtaProvider::OTAQueryStatus::kNotAvailable, nullptr, 0, 0, nullptr, action.callback_args);
+    // No update, or the source could not be queried
+    action.callback(EspOtaProvider::OTAQueryStatus::kNotAvailable, nullptr, 0, nullptr, 0, nullptr,
+                    action.callback_args);
 }
 
 static void ota_candidate_task(void *ctx)
@@ -436,10 +715,12 @@ esp_err_t fetch_ota_candidate(const uint16_t vendor_id, const uint16_t product_i
 
 esp_err_t init_ota_candidates()
 {
-    memset(_ota_candidates_cache, 0, sizeof(_ota_candidates_cache));
     if (_ota_candidate_task_queue) {
         return ESP_ERR_INVALID_STATE;
     }
+    memset(_ota_candidates_cache, 0, sizeof(_ota_candidates_cache));
+    _ota_candidates_count = 0;
+    _load_ota_candidates_cache();
     _ota_candidate_task_queue = xQueueCreate(8, sizeof(ota_candidate_fetch_action_t));
     if (!_ota_candidate_task_queue) {
         ESP_LOGE(TAG, "Failed to create ota_candidate task queue");
@@ -13,14 +13,20 @@
 // limitations under the License.
 
 #include "esp_err.h"
+#include <algorithm>
+#include <errno.h>
 #include <esp_check.h>
 #include <esp_http_client.h>
 #include <esp_log.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_ota_http_downloader.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
 #include <sdkconfig.h>
 
 static constexpr char TAG[] = "ota_provider";
+static constexpr int k_http_status_partial_content = 206;
 
 namespace esp_matter {
 namespace ota_provider {
@@ -118,6 +124,14 @@ static esp_err_t _http_connect(esp_http_client_handle_t http_client)
     return err;
 }
 
+struct http_downloader {
+    esp_http_client_handle_t client;
+    // Offset in the image of the next byte to read
+    uint64_t offset;
+    // Reconnections since the last data read, they share the retries and the backoff
+    int resume_retries;
+};
+
 static int _http_client_read_check_connection(esp_http_client_handle_t client, char *data, size_t size)
 {
     int len = esp_http_client_read(client, data, size);
@@ -128,19 +142,74 @@ static int _http_client_read_check_connection(esp_http_client_handle_t client, c
     return len;
 }
 
-static int _http_client_read(esp_http_client_handle_t http_client, char *data, size_t size)
+// Skip the bytes before the offset, for the servers which ignore the range requests
+static esp_err_t _http_client_skip(esp_http_client_handle_t client, uint64_t size)
+{
+    char skip_buf[256];
+    while (size > 0) {
+        int len = _http_client_read_check_connection(client, skip_buf, std::min(size, (uint64_t)sizeof(skip_buf)));
+        if (len <= 0) {
+            return ESP_FAIL;
+        }
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+// Open the connection to the image URL and position it at the offset of the downloader
+static esp_err_t _http_open_at_offset(http_downloader *downloader)
+{
+    esp_http_client_handle_t client = downloader->client;
+    if (downloader->offset > 0) {
+        char range[32];
+        snprintf(range, sizeof(range), "bytes=%" PRIu64 "-", downloader->offset);
+        esp_http_client_set_header(client, "Range", range);
+    } else {
+        esp_http_client_delete_header(client, "Range");
+    }
+    ESP_RETURN_ON_ERROR(_http_connect(client), TAG, "Failed to connect to HTTP server");
+    if (downloader->offset > 0 && esp_http_client_get_status_code(client) != k_http_status_partial_content) {
+        ESP_LOGW(TAG, "The server does not support range requests, skip %" PRIu64 " bytes", downloader->offset);
+        ESP_RETURN_ON_ERROR(_http_client_skip(client, downloader->offset), TAG, "Failed to skip to the offset");
+    }
+    return ESP_OK;
+}
+
+// Reconnect after the connection was lost or stalled and resume the download at the current offset
+static esp_err_t _http_resume(http_downloader *downloader)
 {
-    int read_len = 0;
+    while (downloader->resume_retries < CONFIG_ESP_MATTER_OTA_PROVIDER_HTTP_RESUME_RETRIES) {
+        int retry = ++downloader->resume_retries;
+        ESP_LOGW(TAG, "Connection lost at offset %" PRIu64 ", resume the download (%d/%d)", downloader->offset, retry,
+                 CONFIG_ESP_MATTER_OTA_PROVIDER_HTTP_RESUME_RETRIES);
+        esp_http_client_close(downloader->client);
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_ESP_MATTER_OTA_PROVIDER_HTTP_RESUME_DELAY_MS * retry));
+        if (_http_open_at_offset(downloader) == ESP_OK) {
+            return ESP_OK;
+        }
+    }
+    return ESP_FAIL;
+}
+
+static int _http_client_read(http_downloader *downloader, char *data, size_t size)
+{
+    size_t read_len = 0;
     while (read_len < size) {
-        int len = _http_client_read_check_connection(http_client, data, size - read_len);
-        if (esp_http_client_is_complete_data_received(http_client)) {
+        int len = _http_client_read_check_connection(downloader->client, data + read_len, size - read_len);
+        if (len > 0) {
+            read_len += len;
+            downloader->offset += len;
+            downloader->resume_retries = 0;
+        }
+        if (esp_http_client_is_complete_data_received(downloader->client)) {
             ESP_LOGI(TAG, "Finish downloading");
-            return read_len + len;
-        } else if (len < 0) {
-            ESP_LOGE(TAG, "Failed to read image");
             return read_len;
         }
-        read_len += len;
+        // A read without data before the end of the image is a stall, the connection is reopened as a lost one
+        if (len <= 0 && _http_resume(downloader) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to read image");
+            return -1;
+        }
     }
     return read_len;
 }
@@ -151,32 +220,40 @@ static void _http_client_cleanup(esp_http_client_handle_t client)
     esp_http_client_cleanup(client);
 }
 
-int http_downloader_read(esp_http_client_handle_t http_client, char *buf, size_t size)
+int http_downloader_read(http_downloader_handle_t downloader, char *buf, size_t size)
 {
-    if (!http_client) {
+    if (!downloader) {
         return -1;
     }
-    return _http_client_read(http_client, buf, size);
+    return _http_client_read(downloader, buf, size);
 }
 
-void http_downloader_abort(esp_http_client_handle_t http_client)
+void http_downloader_abort(http_downloader_handle_t downloader)
 {
-    if (http_client) {
-        _http_client_cleanup(http_client);
+    if (downloader) {
+        _http_client_cleanup(downloader->client);
+        esp_matter_mem_free(downloader);
     }
 }
 
-esp_err_t http_downloader_start(esp_http_client_config_t *config, esp_http_client_handle_t *http_client)
+esp_err_t http_downloader_start(esp_http_client_config_t *config, uint64_t offset,
+                                http_downloader_handle_t *downloader)
 {
     esp_err_t ret = ESP_OK;
-    ESP_RETURN_ON_FALSE(http_client, ESP_ERR_INVALID_ARG, TAG, "http_client cannot be NULL");
-    *http_client = esp_http_client_init(config);
-    ESP_RETURN_ON_FALSE(*http_client, ESP_ERR_NO_MEM, TAG, "Failed to initialize http client");
-    ESP_GOTO_ON_ERROR(_http_connect(*http_client), exit, TAG, "Failed to connect to HTTP server");
+    ESP_RETURN_ON_FALSE(downloader, ESP_ERR_INVALID_ARG, TAG, "downloader cannot be NULL");
+    http_downloader *handle = (http_downloader *)esp_matter_mem_calloc(1, sizeof(http_downloader));
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for http downloader");
+    handle->offset = offset;
+    handle->client = esp_http_client_init(config);
+    ESP_GOTO_ON_FALSE(handle->client, ESP_ERR_NO_MEM, free_handle, TAG, "Failed to initialize http client");
+    ESP_GOTO_ON_ERROR(_http_open_at_offset(handle), cleanup, TAG, "Failed to start downloading at %" PRIu64, offset);
+    *downloader = handle;
     return ESP_OK;
-exit:
-    _http_client_cleanup(*http_client);
-    *http_client = nullptr;
+cleanup:
+    _http_client_cleanup(handle->client);
+free_handle:
+    esp_matter_mem_free(handle);
+    *downloader = nullptr;
     return ret;
 }
 
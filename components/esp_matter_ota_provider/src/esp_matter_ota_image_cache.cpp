@@ -0,0 +1,366 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_image_cache.h>
+#include <inttypes.h>
+#include <mbedtls/sha256.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static constexpr char TAG[] = "ota_image_cache";
+
+namespace esp_matter {
+namespace ota_provider {
+
+static constexpr size_t max_cached_images = CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_MAX_IMAGES;
+static constexpr uint64_t max_cache_size = (uint64_t)CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_MAX_SIZE_KB * 1024;
+static constexpr uint32_t index_magic = 0x4F494332; // "OIC2"
+
+// The entries are saved as they are in the index file
+typedef struct {
+    ota_image_id_t id;
+    uint32_t size;
+    uint32_t last_used;
+    bool in_use;
+} cache_entry_t;
+
+struct image_cache_fill {
+    ota_image_id_t id;
+    uint64_t image_size;
+    uint64_t written;
+    FILE *file;
+    mbedtls_sha256_context sha256;
+};
+
+static cache_entry_t _cache_entries[max_cached_images];
+// The count of the open files of each cached image, an image being read is neither evicted nor replaced
+static uint8_t _open_counts[max_cached_images];
+// The uses of the images are saved with the next insertion or eviction, so that opening an image does not write the
+// filesystem
+static uint32_t _lru_clock = 0;
+static image_cache_fill *_active_fills[CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MAX_SESSIONS];
+
+static bool _same_image(const ota_image_id_t &a, const ota_image_id_t &b)
+{
+    return a.vendor_id == b.vendor_id && a.product_id == b.product_id && a.software_version == b.software_version &&
+           a.base_version == b.base_version;
+}
+
+static void _image_path(const ota_image_id_t &id, const char *suffix, char *path, size_t path_size)
+{
+    if (id.base_version == OTA_FULL_IMAGE_BASE_VERSION) {
+        snprintf(path, path_size, "%s/ota_%04x_%04x_%08" PRIx32 ".%s", CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PATH,
+                 id.vendor_id, id.product_id, id.software_version, suffix);
+    } else {
+        snprintf(path, path_size, "%s/ota_%04x_%04x_%08" PRIx32 "_%08" PRIx32 ".%s",
+                 CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PATH, id.vendor_id, id.product_id, id.software_version,
+                 id.base_version, suffix);
+    }
+}
+
+static void _index_path(char *path, size_t path_size)
+{
+    snprintf(path, path_size, "%s/ota_index.bin", CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PATH);
+}
+
+static esp_err_t _save_index()
+{
+    char path[64];
+    _index_path(path, sizeof(path));
+    FILE *file = fopen(path, "wb");
+    ESP_RETURN_ON_FALSE(file, ESP_FAIL, TAG, "Failed to open %s", path);
+    bool ok = fwrite(&index_magic, sizeof(index_magic), 1, file) == 1 &&
+        fwrite(&_lru_clock, sizeof(_lru_clock), 1, file) == 1 &&
+        fwrite(_cache_entries, sizeof(_cache_entries), 1, file) == 1;
+    fclose(file);
+    ESP_RETURN_ON_FALSE(ok, ESP_FAIL, TAG, "Failed to write %s", path);
+    return ESP_OK;
+}
+
+static bool _is_open(const cache_entry_t &entry)
+{
+    return _open_counts[&entry - _cache_entries] > 0;
+}
+
+static void _remove_entry(cache_entry_t &entry)
+{
+    char path[64];
+    _image_path(entry.id, "bin", path, sizeof(path));
+    remove(path);
+    ESP_LOGI(TAG, "Evict the image %04x:%04x version %" PRIu32, entry.id.vendor_id, entry.id.product_id,
+             entry.id.software_version);
+    memset(&entry, 0, sizeof(entry));
+}
+
+static cache_entry_t *_find_entry(const ota_image_id_t &id)
+{
+    for (cache_entry_t &entry : _cache_entries) {
+        if (entry.in_use && _same_image(entry.id, id)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+// Evict the least recently used images until an image of image_size fits, returns the free entry
+static cache_entry_t *_make_room(uint64_t image_size)
+{
+    if (image_size > max_cache_size) {
+        // Do not evict the cached images for an image which cannot fit anyway
+        return nullptr;
+    }
+    while (true) {
+        uint64_t total_size = 0;
+        cache_entry_t *free_entry = nullptr;
+        cache_entry_t *lru_entry = nullptr;
+        for (cache_entry_t &entry : _cache_entries) {
+            if (!entry.in_use) {
+                free_entry = free_entry ? free_entry : &entry;
+                continue;
+            }
+            total_size += entry.size;
+            if (!_is_open(entry) && (!lru_entry || entry.last_used < lru_entry->last_used)) {
+                lru_entry = &entry;
+            }
+        }
+        if (free_entry && total_size + image_size <= max_cache_size) {
+            return free_entry;
+        }
+        if (!lru_entry) {
+            return nullptr;
+        }
+        _remove_entry(*lru_entry);
+    }
+}
+
+esp_err_t image_cache_init()
+{
+    memset(_cache_entries, 0, sizeof(_cache_entries));
+    memset(_open_counts, 0, sizeof(_open_counts));
+    _lru_clock = 0;
+    char path[64];
+    _index_path(path, sizeof(path));
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return ESP_OK;
+    }
+    uint32_t magic = 0;
+    bool ok = fread(&magic, sizeof(magic), 1, file) == 1 && magic == index_magic &&
+        fread(&_lru_clock, sizeof(_lru_clock), 1, file) == 1 &&
+        fread(_cache_entries, sizeof(_cache_entries), 1, file) == 1;
+    fclose(file);
+    if (!ok) {
+        // The index was written with another configuration, the images it references are not reachable anymore
+        ESP_LOGW(TAG, "Drop the invalid OTA image cache index");
+        memset(_cache_entries, 0, sizeof(_cache_entries));
+        _lru_clock = 0;
+        return _save_index();
+    }
+    size_t count = 0;
+    for (cache_entry_t &entry : _cache_entries) {
+        if (!entry.in_use) {
+            continue;
+        }
+        struct stat st;
+        _image_path(entry.id, "bin", path, sizeof(path));
+        if (stat(path, &st) != 0 || st.st_size != entry.size) {
+            ESP_LOGW(TAG, "Drop the missing image %04x:%04x version %" PRIu32, entry.id.vendor_id,
+                     entry.id.product_id, entry.id.software_version);
+            _remove_entry(entry);
+            continue;
+        }
+        count++;
+    }
+    ESP_LOGI(TAG, "%u OTA images in the cache", (unsigned)count);
+    return ESP_OK;
+}
+
+FILE *image_cache_open(const ota_image_id_t &id)
+{
+    cache_entry_t *entry = _find_entry(id);
+    if (!entry) {
+        return nullptr;
+    }
+    if (memcmp(entry->id.digest, id.digest, sizeof(id.digest)) != 0) {
+        // The image was republished on the DCL with another content, it is removed once the transfers reading the
+        // previous one are done
+        if (!_is_open(*entry)) {
+            _remove_entry(*entry);
+            _save_index();
+        }
+        return nullptr;
+    }
+    char path[64];
+    _image_path(id, "bin", path, sizeof(path));
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        ESP_LOGW(TAG, "Failed to open %s", path);
+        if (!_is_open(*entry)) {
+            _remove_entry(*entry);
+            _save_index();
+        }
+        return nullptr;
+    }
+    if (_open_counts[entry - _cache_entries] == UINT8_MAX) {
+        fclose(file);
+        return nullptr;
+    }
+    _open_counts[entry - _cache_entries]++;
+    entry->last_used = ++_lru_clock;
+    return file;
+}
+
+void image_cache_close(const ota_image_id_t &id, FILE *file)
+{
+    if (!file) {
+        return;
+    }
+    fclose(file);
+    cache_entry_t *entry = _find_entry(id);
+    if (entry && _open_counts[entry - _cache_entries] > 0) {
+        _open_counts[entry - _cache_entries]--;
+    }
+}
+
+esp_err_t image_cache_fill_start(const ota_image_id_t &id, uint64_t image_size, image_cache_fill_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "handle cannot be NULL");
+    ESP_RETURN_ON_FALSE(image_size <= max_cache_size, ESP_ERR_INVALID_SIZE, TAG, "The image is larger than the cache");
+    image_cache_fill **slot = nullptr;
+    for (image_cache_fill *&fill : _active_fills) {
+        if (fill && _same_image(fill->id, id)) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        if (!fill && !slot) {
+            slot = &fill;
+        }
+    }
+    ESP_RETURN_ON_FALSE(slot, ESP_ERR_NO_MEM, TAG, "Too many images being added to the cache");
+    cache_entry_t *entry = _find_entry(id);
+    if (entry && memcmp(entry->id.digest, id.digest, sizeof(id.digest)) == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    image_cache_fill *fill = (image_cache_fill *)esp_matter_mem_calloc(1, sizeof(image_cache_fill));
+    ESP_RETURN_ON_FALSE(fill, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the cache fill");
+    char path[64];
+    _image_path(id, "tmp", path, sizeof(path));
+    fill->file = fopen(path, "wb");
+    if (!fill->file) {
+        ESP_LOGE(TAG, "Failed to create %s", path);
+        esp_matter_mem_free(fill);
+        return ESP_FAIL;
+    }
+    fill->id = id;
+    fill->image_size = image_size;
+    mbedtls_sha256_init(&fill->sha256);
+    mbedtls_sha256_starts(&fill->sha256, 0);
+    *slot = fill;
+    *handle = fill;
+    return ESP_OK;
+}
+
+esp_err_t image_cache_fill_write(image_cache_fill_handle_t handle, const uint8_t *data, size_t len)
+{
+    ESP_RETURN_ON_FALSE(handle && data, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(handle->image_size == 0 || handle->written + len <= handle->image_size, ESP_ERR_INVALID_SIZE,
+                        TAG, "More data than the image size");
+    ESP_RETURN_ON_FALSE(handle->written + len <= max_cache_size, ESP_ERR_INVALID_SIZE, TAG,
+                        "The image is larger than the cache");
+    ESP_RETURN_ON_FALSE(fwrite(data, 1, len, handle->file) == len, ESP_FAIL, TAG, "Failed to write the image");
+    mbedtls_sha256_update(&handle->sha256, data, len);
+    handle->written += len;
+    return ESP_OK;
+}
+
+static void _release_fill(image_cache_fill_handle_t handle, bool keep_file)
+{
+    for (image_cache_fill *&fill : _active_fills) {
+        if (fill == handle) {
+            fill = nullptr;
+        }
+    }
+    if (handle->file) {
+        fclose(handle->file);
+    }
+    if (!keep_file) {
+        char path[64];
+        _image_path(handle->id, "tmp", path, sizeof(path));
+        remove(path);
+    }
+    mbedtls_sha256_free(&handle->sha256);
+    esp_matter_mem_free(handle);
+}
+
+esp_err_t image_cache_fill_finish(image_cache_fill_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "handle cannot be NULL");
+    uint8_t digest[OTA_IMAGE_DIGEST_LEN];
+    mbedtls_sha256_finish(&handle->sha256, digest);
+    bool flushed = fflush(handle->file) == 0;
+    fclose(handle->file);
+    handle->file = nullptr;
+    if (!flushed || (handle->image_size != 0 && handle->written != handle->image_size) ||
+        memcmp(digest, handle->id.digest, sizeof(digest)) != 0) {
+        ESP_LOGE(TAG, "The image %04x:%04x version %" PRIu32 " does not match the DCL checksum, do not cache it",
+                 handle->id.vendor_id, handle->id.product_id, handle->id.software_version);
+        _release_fill(handle, false);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    // A previous version of the image with another digest is replaced, unless it is being read
+    cache_entry_t *entry = _find_entry(handle->id);
+    if (entry && _is_open(*entry)) {
+        ESP_LOGW(TAG, "The previous image %04x:%04x version %" PRIu32 " is being sent, do not replace it",
+                 handle->id.vendor_id, handle->id.product_id, handle->id.software_version);
+        _release_fill(handle, false);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (entry) {
+        _remove_entry(*entry);
+    }
+    entry = _make_room(handle->written);
+    char tmp_path[64];
+    char path[64];
+    _image_path(handle->id, "tmp", tmp_path, sizeof(tmp_path));
+    _image_path(handle->id, "bin", path, sizeof(path));
+    remove(path);
+    if (!entry || rename(tmp_path, path) != 0) {
+        ESP_LOGE(TAG, "Failed to add the image to the cache");
+        _release_fill(handle, false);
+        _save_index();
+        return ESP_FAIL;
+    }
+    entry->id = handle->id;
+    entry->size = handle->written;
+    entry->last_used = ++_lru_clock;
+    entry->in_use = true;
+    ESP_LOGI(TAG, "Cached the image %04x:%04x version %" PRIu32 ", %" PRIu32 " bytes", entry->id.vendor_id,
+             entry->id.product_id, entry->id.software_version, entry->size);
+    _release_fill(handle, true);
+    return _save_index();
+}
+
+void image_cache_fill_abort(image_cache_fill_handle_t handle)
+{
+    if (handle) {
+        _release_fill(handle, false);
+    }
+}
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -0,0 +1,381 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_image_source.h>
+#include <inttypes.h>
+#include <json_parser.h>
+#include <mbedtls/base64.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static constexpr char TAG[] = "ota_provider";
+
+namespace esp_matter {
+namespace ota_provider {
+
+static constexpr char local_manifest_name[] = "manifest.json";
+static constexpr size_t local_manifest_max_len = 16 * 1024;
+
+static const ota_image_source_t *_ota_image_source = nullptr;
+
+void set_ota_image_source(const ota_image_source_t *source)
+{
+    _ota_image_source = source;
+}
+
+const ota_image_source_t *get_ota_image_source()
+{
+    const ota_image_source_t *source = _ota_image_source;
+    return source ? source : get_dcl_image_source();
+}
+
+// Whether an image of the model updates the software version, as the DCL defines it
+static bool _is_update(uint32_t image_version, uint32_t min_applicable_version, uint32_t max_applicable_version,
+                       uint32_t software_version)
+{
+    return image_version > software_version && min_applicable_version <= software_version &&
+        max_applicable_version >= software_version;
+}
+
+/* Local directory source */
+
+typedef struct {
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint32_t min_applicable_software_version;
+    uint32_t max_applicable_software_version;
+    // The ota_url is the path of the image file
+    ota_image_info_t info;
+} local_image_t;
+
+typedef struct {
+    ota_image_source_t source;
+    local_image_t *images;
+    size_t image_count;
+} local_image_source_t;
+
+static esp_err_t _local_query_image(void *ctx, uint16_t vendor_id, uint16_t product_id, uint32_t software_version,
+                                    ota_image_info_t *info)
+{
+    local_image_source_t *local = static_cast<local_image_source_t *>(ctx);
+    const local_image_t *latest = nullptr;
+    for (size_t index = 0; index < local->image_count; ++index) {
+        const local_image_t *image = &local->images[index];
+        if (image->vendor_id == vendor_id && image->product_id == product_id &&
+            _is_update(image->info.software_version, image->min_applicable_software_version,
+                       image->max_applicable_software_version, software_version) &&
+            (!latest || image->info.software_version > latest->info.software_version)) {
+            latest = image;
+        }
+    }
+    if (!latest) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *info = latest->info;
+    return ESP_OK;
+}
+
+static esp_err_t _local_open_image(void *ctx, const char *ota_url, uint64_t offset, void **reader)
+{
+    FILE *file = fopen(ota_url, "rb");
+    ESP_RETURN_ON_FALSE(file, ESP_ERR_NOT_FOUND, TAG, "Failed to open %s", ota_url);
+    if (fseek(file, offset, SEEK_SET) != 0) {
+        ESP_LOGE(TAG, "Failed to seek %s to %" PRIu64, ota_url, offset);
+        fclose(file);
+        return ESP_FAIL;
+    }
+    *reader = file;
+    return ESP_OK;
+}
+
+static int _local_read_image(void *reader, uint8_t *buf, size_t size)
+{
+    FILE *file = static_cast<FILE *>(reader);
+    size_t len = fread(buf, 1, size, file);
+    return (len < size && ferror(file)) ? -1 : static_cast<int>(len);
+}
+
+static void _local_close_image(void *reader)
+{
+    fclose(static_cast<FILE *>(reader));
+}
+
+static bool _get_manifest_string(jparse_ctx_t *jctx, const char *name, char *buf, size_t size)
+{
+    int len = 0;
+    return json_obj_get_strlen(jctx, name, &len) == 0 && len >= 0 && static_cast<size_t>(len) < size &&
+        json_obj_get_string(jctx, name, buf, size) == 0;
+}
+
+static bool _get_manifest_u32(jparse_ctx_t *jctx, const char *name, uint32_t *value)
+{
+    int64_t tmp = 0;
+    if (json_obj_get_int64(jctx, name, &tmp) != 0 || tmp < 0 || tmp > UINT32_MAX) {
+        return false;
+    }
+    *value = static_cast<uint32_t>(tmp);
+    return true;
+}
+
+// Parse the image at the current object of the manifest, returns false if the image is skipped
+static bool _parse_manifest_image(jparse_ctx_t *jctx, const char *path, local_image_t *image)
+{
+    uint32_t vendor_id = 0, product_id = 0;
+    bool software_version_valid = true;
+    char file[OTA_URL_MAX_LEN];
+    if (!_get_manifest_u32(jctx, "vendorId", &vendor_id) || vendor_id > UINT16_MAX ||
+        !_get_manifest_u32(jctx, "productId", &product_id) || product_id > UINT16_MAX ||
+        !_get_manifest_u32(jctx, "softwareVersion", &image->info.software_version) ||
+        !_get_manifest_string(jctx, "otaURL", file, sizeof(file))) {
+        ESP_LOGE(TAG, "Invalid image in the manifest");
+        return false;
+    }
+    if (json_obj_get_bool(jctx, "softwareVersionValid", &software_version_valid) == 0 && !software_version_valid) {
+        return false;
+    }
+    image->vendor_id = static_cast<uint16_t>(vendor_id);
+    image->product_id = static_cast<uint16_t>(product_id);
+    if (!_get_manifest_u32(jctx, "minApplicableSoftwareVersion", &image->min_applicable_software_version)) {
+        image->min_applicable_software_version = 0;
+    }
+    if (!_get_manifest_u32(jctx, "maxApplicableSoftwareVersion", &image->max_applicable_software_version)) {
+        image->max_applicable_software_version = image->info.software_version - 1;
+    }
+    if (!_get_manifest_string(jctx, "softwareVersionString", image->info.software_version_str,
+                              sizeof(image->info.software_version_str))) {
+        snprintf(image->info.software_version_str, sizeof(image->info.software_version_str), "%" PRIu32,
+                 image->info.software_version);
+    }
+    // The paths of the images are relative to the directory of the manifest
+    int len = file[0] == '/' ? snprintf(image->info.ota_url, sizeof(image->info.ota_url), "%s", file)
+                             : snprintf(image->info.ota_url, sizeof(image->info.ota_url), "%s/%s", path, file);
+    struct stat st;
+    if (len < 0 || static_cast<size_t>(len) >= sizeof(image->info.ota_url) || stat(image->info.ota_url, &st) != 0) {
+        ESP_LOGE(TAG, "Cannot find the image %s", file);
+        return false;
+    }
+    image->info.ota_file_size = st.st_size;
+    char checksum[64];
+    size_t digest_len = 0;
+    image->info.has_ota_digest = _get_manifest_string(jctx, "otaChecksum", checksum, sizeof(checksum)) &&
+        mbedtls_base64_decode(image->info.ota_digest, sizeof(image->info.ota_digest), &digest_len,
+                              (const unsigned char *)checksum, strlen(checksum)) == 0 &&
+        digest_len == sizeof(image->info.ota_digest);
+    return true;
+}
+
+static esp_err_t _load_manifest(local_image_source_t *local, const char *path)
+{
+    esp_err_t ret = ESP_OK;
+    char manifest_path[OTA_URL_MAX_LEN];
+    char *manifest = nullptr;
+    long manifest_len = 0;
+    int image_count = 0;
+    jparse_ctx_t jctx;
+    int len = snprintf(manifest_path, sizeof(manifest_path), "%s/%s", path, local_manifest_name);
+    ESP_RETURN_ON_FALSE(len > 0 && static_cast<size_t>(len) < sizeof(manifest_path), ESP_ERR_INVALID_ARG, TAG,
+                        "The path of the image directory is too long");
+    FILE *file = fopen(manifest_path, "r");
+    ESP_RETURN_ON_FALSE(file, ESP_ERR_NOT_FOUND, TAG, "Failed to open %s", manifest_path);
+    ESP_GOTO_ON_FALSE(fseek(file, 0, SEEK_END) == 0 && (manifest_len = ftell(file)) > 0 &&
+                          static_cast<size_t>(manifest_len) <= local_manifest_max_len && fseek(file, 0, SEEK_SET) == 0,
+                      ESP_ERR_INVALID_SIZE, close, TAG, "Invalid size of %s", manifest_path);
+    manifest = (char *)esp_matter_mem_calloc(1, manifest_len + 1);
+    ESP_GOTO_ON_FALSE(manifest, ESP_ERR_NO_MEM, close, TAG, "Failed to alloc memory for the manifest");
+    ESP_GOTO_ON_FALSE(fread(manifest, 1, manifest_len, file) == static_cast<size_t>(manifest_len), ESP_FAIL, close,
+                      TAG, "Failed to read %s", manifest_path);
+
+    ESP_GOTO_ON_FALSE(json_parse_start(&jctx, manifest, manifest_len) == 0, ESP_ERR_INVALID_ARG, close, TAG,
+                      "Failed to parse %s", manifest_path);
+    if (json_obj_get_array(&jctx, "deviceSoftwareVersionModel", &image_count) == 0) {
+        if (image_count > 0) {
+            local->images = (local_image_t *)esp_matter_mem_calloc(image_count, sizeof(local_image_t));
+        }
+        if (image_count > 0 && !local->images) {
+            ret = ESP_ERR_NO_MEM;
+        }
+        for (int index = 0; index < image_count && local->images; ++index) {
+            if (json_arr_get_object(&jctx, index) == 0) {
+                if (_parse_manifest_image(&jctx, path, &local->images[local->image_count])) {
+                    local->image_count++;
+                }
+                json_arr_leave_object(&jctx);
+            }
+        }
+        json_obj_leave_array(&jctx);
+    } else {
+        ESP_LOGE(TAG, "No deviceSoftwareVersionModel array in %s", manifest_path);
+        ret = ESP_ERR_INVALID_ARG;
+    }
+    json_parse_end(&jctx);
+
+close:
+    fclose(file);
+    esp_matter_mem_free(manifest);
+    return ret;
+}
+
+esp_err_t local_image_source_create(const char *path, ota_image_source_t **source)
+{
+    ESP_RETURN_ON_FALSE(path && source, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    local_image_source_t *local = (local_image_source_t *)esp_matter_mem_calloc(1, sizeof(local_image_source_t));
+    ESP_RETURN_ON_FALSE(local, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the local image source");
+    esp_err_t err = _load_manifest(local, path);
+    if (err != ESP_OK) {
+        esp_matter_mem_free(local->images);
+        esp_matter_mem_free(local);
+        return err;
+    }
+    ESP_LOGI(TAG, "Serve %u OTA images from %s", static_cast<unsigned>(local->image_count), path);
+    local->source.query_image = _local_query_image;
+    local->source.open_image = _local_open_image;
+    local->source.read_image = _local_read_image;
+    local->source.close_image = _local_close_image;
+    local->source.ctx = local;
+    local->source.cache_images = false;
+    *source = &local->source;
+    return ESP_OK;
+}
+
+void local_image_source_destroy(ota_image_source_t *source)
+{
+    if (source) {
+        local_image_source_t *local = static_cast<local_image_source_t *>(source->ctx);
+        esp_matter_mem_free(local->images);
+        esp_matter_mem_free(local);
+    }
+}
+
+/* Memory source */
+
+static constexpr char memory_url_prefix[] = "mem/";
+
+typedef struct {
+    ota_image_source_t source;
+    ota_memory_image_t *images;
+    size_t image_count;
+} memory_image_source_t;
+
+typedef struct {
+    const ota_memory_image_t *image;
+    size_t offset;
+} memory_image_reader_t;
+
+static esp_err_t _memory_query_image(void *ctx, uint16_t vendor_id, uint16_t product_id, uint32_t software_version,
+                                     ota_image_info_t *info)
+{
+    memory_image_source_t *memory = static_cast<memory_image_source_t *>(ctx);
+    size_t latest = memory->image_count;
+    for (size_t index = 0; index < memory->image_count; ++index) {
+        const ota_memory_image_t *image = &memory->images[index];
+        if (image->vendor_id == vendor_id && image->product_id == product_id &&
+            _is_update(image->software_version, image->min_applicable_software_version,
+                       image->max_applicable_software_version, software_version) &&
+            (latest == memory->image_count || image->software_version > memory->images[latest].software_version)) {
+            latest = index;
+        }
+    }
+    if (latest == memory->image_count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    const ota_memory_image_t *image = &memory->images[latest];
+    memset(info, 0, sizeof(*info));
+    info->software_version = image->software_version;
+    strlcpy(info->software_version_str, image->software_version_str ? image->software_version_str : "",
+            sizeof(info->software_version_str));
+    // The index of the image is in the URL, the file name is only informative
+    snprintf(info->ota_url, sizeof(info->ota_url), "%s%u/ota_%04x_%04x_%08" PRIx32 ".ota", memory_url_prefix,
+             static_cast<unsigned>(latest), image->vendor_id, image->product_id, image->software_version);
+    info->ota_file_size = image->size;
+    return ESP_OK;
+}
+
+static esp_err_t _memory_open_image(void *ctx, const char *ota_url, uint64_t offset, void **reader)
+{
+    memory_image_source_t *memory = static_cast<memory_image_source_t *>(ctx);
+    unsigned index = 0;
+    ESP_RETURN_ON_FALSE(strncmp(ota_url, memory_url_prefix, strlen(memory_url_prefix)) == 0 &&
+                            sscanf(ota_url + strlen(memory_url_prefix), "%u/", &index) == 1 &&
+                            index < memory->image_count,
+                        ESP_ERR_NOT_FOUND, TAG, "No image in memory for %s", ota_url);
+    ESP_RETURN_ON_FALSE(offset <= memory->images[index].size, ESP_ERR_INVALID_ARG, TAG,
+                        "The offset %" PRIu64 " is after the end of the image", offset);
+    memory_image_reader_t *memory_reader =
+        (memory_image_reader_t *)esp_matter_mem_calloc(1, sizeof(memory_image_reader_t));
+    ESP_RETURN_ON_FALSE(memory_reader, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the image reader");
+    memory_reader->image = &memory->images[index];
+    memory_reader->offset = static_cast<size_t>(offset);
+    *reader = memory_reader;
+    return ESP_OK;
+}
+
+static int _memory_read_image(void *reader, uint8_t *buf, size_t size)
+{
+    memory_image_reader_t *memory_reader = static_cast<memory_image_reader_t *>(reader);
+    size_t len = std::min(size, memory_reader->image->size - memory_reader->offset);
+    memcpy(buf, memory_reader->image->data + memory_reader->offset, len);
+    memory_reader->offset += len;
+    return static_cast<int>(len);
+}
+
+static void _memory_close_image(void *reader)
+{
+    esp_matter_mem_free(reader);
+}
+
+esp_err_t memory_image_source_create(const ota_memory_image_t *images, size_t count, ota_image_source_t **source)
+{
+    ESP_RETURN_ON_FALSE((images || count == 0) && source, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    for (size_t index = 0; index < count; ++index) {
+        ESP_RETURN_ON_FALSE(images[index].data || images[index].size == 0, ESP_ERR_INVALID_ARG, TAG,
+                            "The image %u has no data", static_cast<unsigned>(index));
+    }
+    memory_image_source_t *memory = (memory_image_source_t *)esp_matter_mem_calloc(1, sizeof(memory_image_source_t));
+    ESP_RETURN_ON_FALSE(memory, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the memory image source");
+    if (count > 0) {
+        memory->images = (ota_memory_image_t *)esp_matter_mem_calloc(count, sizeof(ota_memory_image_t));
+        if (!memory->images) {
+            esp_matter_mem_free(memory);
+            ESP_LOGE(TAG, "Failed to alloc memory for the memory images");
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(memory->images, images, count * sizeof(ota_memory_image_t));
+    }
+    memory->image_count = count;
+    memory->source.query_image = _memory_query_image;
+    memory->source.open_image = _memory_open_image;
+    memory->source.read_image = _memory_read_image;
+    memory->source.close_image = _memory_close_image;
+    memory->source.ctx = memory;
+    memory->source.cache_images = false;
+    *source = &memory->source;
+    return ESP_OK;
+}
+
+void memory_image_source_destroy(ota_image_source_t *source)
+{
+    if (source) {
+        memory_image_source_t *memory = static_cast<memory_image_source_t *>(source->ctx);
+        esp_matter_mem_free(memory->images);
+        esp_matter_mem_free(memory);
+    }
+}
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -14,13 +14,19 @@
 
 #include <algorithm>
 #include <cstring>
+#include <esp_bit_defs.h>
 #include <esp_check.h>
 #include <esp_http_client.h>
 #include <esp_log.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_ota_candidates.h>
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+#include <esp_matter_ota_image_cache.h>
+#endif
+#include <esp_matter_ota_image_source.h>
 #include <esp_matter_ota_provider.h>
 #include <json_parser.h>
+#include <nvs.h>
 
 #include <app/server/Server.h>
 #include <platform/PlatformManager.h>
@@ -47,6 +53,9 @@ constexpr chip::System::Clock::Timeout kBdxTimeout =
     chip::System::Clock::Seconds16(5 * 60); // OTA Spec mandates >= 5 minutes
 constexpr uint32_t kBdxServerPollIntervalMillis = 50;
 
+static_assert((EspOtaProvider::kRequestorBuckets & (EspOtaProvider::kRequestorBuckets - 1)) == 0,
+              "CONFIG_ESP_MATTER_OTA_PROVIDER_REQUESTOR_BUCKETS must be a power of two");
+
 static void GenerateUpdateToken(uint8_t *buf, size_t bufSize)
 {
     for (size_t i = 0; i < bufSize; ++i) {
@@ -69,11 +78,24 @@ void EspOtaProvider::Init(bool otaAllowedDefault)
     mUpdateAction = OTAApplyUpdateAction::kProceed;
     mDelayedApplyActionTimeSec = 0;
     mPollInterval = kBdxServerPollIntervalMillis;
-    mOtaRequestorList = nullptr;
+    memset(mRequestorBuckets, 0, sizeof(mRequestorBuckets));
     mOtaAllowedDefault = otaAllowedDefault;
+    LoadOtaPolicies();
     init_ota_candidates();
-    chip::Server::GetInstance().GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(
-        chip::Protocols::BDX::Id, &mOtaBdxSender);
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    image_cache_init();
+#endif
+    mBdxSenderPool.Init(chip::Server::GetInstance().GetExchangeManager(), kBdxTimeout);
+    mBdxSenderPool.SetTransferEventCallback(HandleTransferEvent, this);
+}
+
+uint32_t EspOtaProvider::SetBusy(EspOtaRequestorEntry *requestor, size_t waitPosition)
+{
+    if (mDelayedApplyActionTimeSec == 0) {
+        mDelayedQueryActionTimeSec = 120;
+    }
+    // The requestors further in the queue are asked to query again later
+    return mBdxSenderPool.Wait(requestor->mBdxWaiter, waitPosition, mDelayedQueryActionTimeSec);
 }
 
 void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
@@ -85,12 +107,15 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
         return;
     }
     EspOtaRequestorEntry *requestor = FindOtaRequestorEntry(mPeerNodeId);
+    uint32_t windowDelaySec = 0;
     if (requestor) {
-        if ((!requestor->mOtaAllowed) && (!requestor->mOtaAllowedOnce)) {
+        if (!IsOtaAllowed(requestor, windowDelaySec)) {
             if (status == OTAQueryStatus::kUpdateAvailable) {
                 requestor->mHasNewVersion = true;
             }
-            status = OTAQueryStatus::kNotAvailable;
+            // Out of its maintenance window, the requestor is asked to query again at the start of the window
+            status = (status == OTAQueryStatus::kUpdateAvailable && windowDelaySec > 0) ? OTAQueryStatus::kBusy
+                                                                                         : OTAQueryStatus::kNotAvailable;
         }
     } else {
         status = OTAQueryStatus::kNotAvailable;
@@ -98,6 +123,7 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
 
     QueryImageResponse::Type response;
     char strBuf[kUpdateTokenStrLen] = {0};
+    size_t waitPosition = 0;
 
     // Set fields specific for an available status response
     if (status == OTAQueryStatus::kUpdateAvailable) {
@@ -121,10 +147,23 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
         // Initialize the transfer session in prepartion for a BDX transfer
         BitFlags<TransferControlFlags> bdxFlags;
         bdxFlags.Set(TransferControlFlags::kReceiverDrive);
-        if (mOtaBdxSender.InitializeTransfer(mSubjectDescriptor.fabricIndex, mSubjectDescriptor.subject) == ESP_OK) {
-            mOtaBdxSender.SetOtaImageUrl(requestor->mOtaImageUrl);
-            ESP_LOGI(TAG, "Bdx Sender will query the OTA image from %s", requestor->mOtaImageUrl);
-            CHIP_ERROR error = mOtaBdxSender.PrepareForTransfer(
+        // The requestors are served in the order they were first refused, so a free sender is kept for the
+        // requestors which have waited longer.
+        OtaBdxSender *bdxSender =
+            mBdxSenderPool.Admit(mSubjectDescriptor.fabricIndex, mSubjectDescriptor.subject, requestor->mBdxWaiter,
+                                 waitPosition);
+        if (bdxSender) {
+            bdxSender->SetOtaImageUrl(requestor->mOtaImageUrl);
+            bdxSender->SetOtaImageSource(requestor->mImageSource);
+            bdxSender->SetOtaImageInfo(requestor->mVendorId, requestor->mProductId, requestor->mSoftwareVersion,
+                                       requestor->mIsDeltaOtaImage ? requestor->mCurrentVersion
+                                                                   : OTA_FULL_IMAGE_BASE_VERSION,
+                                       requestor->mHasOtaImageDigest ? requestor->mOtaImageDigest : nullptr,
+                                       requestor->mOtaImageSize);
+            bdxSender->SetTransferRetries(requestor->mFailedTransfers);
+            ESP_LOGI(TAG, "Bdx Sender will query the %s OTA image from %s",
+                     requestor->mIsDeltaOtaImage ? "delta" : "full", requestor->mOtaImageUrl);
+            CHIP_ERROR error = bdxSender->PrepareForTransfer(
                 &chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender, bdxFlags, kMaxBdxBlockSize,
                 kBdxTimeout, chip::System::Clock::Milliseconds32(mPollInterval));
             if (error != CHIP_NO_ERROR) {
@@ -132,6 +171,7 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
                 commandHandle->AddStatus(mPath, Status::Failure);
                 return;
             }
+            requestor->mDeltaOtaImageSent = requestor->mIsDeltaOtaImage;
             GenerateUpdateToken(requestor->mUpdateToken, kUpdateTokenLen);
             GetUpdateTokenString(ByteSpan(requestor->mUpdateToken), strBuf, kUpdateTokenStrLen);
             ESP_LOGD(TAG, "Generated updateToken: %s", strBuf);
@@ -141,17 +181,14 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
             response.softwareVersionString.Emplace(chip::CharSpan::fromCharString(requestor->mSoftwareVersionString));
             response.updateToken.Emplace(chip::ByteSpan(requestor->mUpdateToken));
         } else {
-            // Another BDX transfer in progress
+            // All the BDX senders are in use, or reserved for the requestors which have waited longer
             status = OTAQueryStatus::kBusy;
         }
     }
 
     // Delay action time is only applicable when the provider is busy
     if (status == OTAQueryStatus::kBusy) {
-        if (mDelayedApplyActionTimeSec == 0) {
-            mDelayedQueryActionTimeSec = 120;
-        }
-        response.delayedActionTime.Emplace(mDelayedQueryActionTimeSec);
+        response.delayedActionTime.Emplace(windowDelaySec > 0 ? windowDelaySec : SetBusy(requestor, waitPosition));
     }
 
     // Set remaining fields common to all status types
@@ -161,18 +198,37 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
 }
 
 void EspOtaProvider::FetchImageDoneCallback(OTAQueryStatus status, const char *imageUrl, size_t imageSize,
-                                            uint32_t softwareVersion, const char *softwareVersionStr, void *arg)
+                                            const uint8_t *imageDigest, uint32_t softwareVersion,
+                                            const char *softwareVersionStr, void *arg)
 {
     EspOtaProvider *provider = (EspOtaProvider *)arg;
     assert(provider);
+    // The callback runs in the ota_candidate task, the requestor entries and the delta images are shared with the
+    // Matter thread
+    DeviceLayer::PlatformMgr().LockChipStack();
     EspOtaRequestorEntry *requestor = provider->FindOtaRequestorEntry(provider->mPeerNodeId);
     if (requestor && status == OTAQueryStatus::kUpdateAvailable) {
         strncpy(requestor->mOtaImageUrl, imageUrl, sizeof(requestor->mOtaImageUrl) - 1);
+        requestor->mImageSource = get_ota_image_source();
         requestor->mOtaImageSize = imageSize;
+        requestor->mHasOtaImageDigest = imageDigest != nullptr;
+        if (imageDigest) {
+            memcpy(requestor->mOtaImageDigest, imageDigest, sizeof(requestor->mOtaImageDigest));
+        }
         requestor->mSoftwareVersion = softwareVersion;
         strncpy(requestor->mSoftwareVersionString, softwareVersionStr, sizeof(requestor->mSoftwareVersionString) - 1);
+        // Offer the delta image from the running version of the requestor instead, unless it has failed
+        DeltaOtaImage *delta = provider->FindDeltaOtaImage(requestor->mVendorId, requestor->mProductId,
+                                                           requestor->mCurrentVersion, softwareVersion);
+        requestor->mIsDeltaOtaImage = delta && !requestor->mDeltaOtaImageFailed;
+        if (requestor->mIsDeltaOtaImage) {
+            strncpy(requestor->mOtaImageUrl, delta->mOtaImageUrl, sizeof(requestor->mOtaImageUrl) - 1);
+            requestor->mImageSource = delta->mImageSource;
+            requestor->mOtaImageSize = delta->mOtaImageSize;
+            requestor->mHasOtaImageDigest = delta->mHasOtaImageDigest;
+            memcpy(requestor->mOtaImageDigest, delta->mOtaImageDigest, sizeof(requestor->mOtaImageDigest));
+        }
     }
-    DeviceLayer::PlatformMgr().LockChipStack();
     provider->SendQueryImageResponse(status);
     DeviceLayer::PlatformMgr().UnlockChipStack();
 }
@@ -207,6 +263,48 @@ void EspOtaProvider::HandleQueryImage(CommandHandler *commandObj, const Concrete
     mPeerNodeId = commandObj->GetExchangeContext()->GetSessionHandle()->GetPeer();
     mAsyncCommandHandle = chip::app::CommandHandler::Handle(commandObj);
     mPath = commandPath;
+    EspOtaRequestorEntry *requestor = FindOtaRequestorEntry(mPeerNodeId);
+    requestor->mVendorId = vendor_id;
+    requestor->mProductId = product_id;
+    bool versionChanged = requestor->mCurrentVersion != software_version;
+    switch (requestor->mState) {
+    case OTA_NODE_STATE_DOWNLOADED:
+    case OTA_NODE_STATE_APPLYING:
+        if (!versionChanged) {
+            // The requestor still runs the same version, the downloaded image was not applied
+            ESP_LOGW(TAG, "The requestor 0x%" PRIx64 " did not apply the OTA image", mPeerNodeId.GetNodeId());
+            requestor->mState = OTA_NODE_STATE_FAILED;
+        } else {
+            requestor->mState = software_version == requestor->mSoftwareVersion ? OTA_NODE_STATE_APPLIED
+                                                                                 : OTA_NODE_STATE_QUERIED;
+        }
+        break;
+    case OTA_NODE_STATE_APPLIED:
+        if (software_version != requestor->mSoftwareVersion) {
+            requestor->mState = OTA_NODE_STATE_QUERIED;
+        }
+        break;
+    case OTA_NODE_STATE_FAILED:
+        if (versionChanged) {
+            requestor->mState = OTA_NODE_STATE_QUERIED;
+        }
+        break;
+    default:
+        // A running transfer reports its end to HandleTransferEvent()
+        break;
+    }
+    if (versionChanged) {
+        requestor->mFailedTransfers = 0;
+        requestor->mCurrentVersion = software_version;
+        requestor->mDeltaOtaImageSent = false;
+        requestor->mDeltaOtaImageFailed = false;
+    } else if (requestor->mDeltaOtaImageSent) {
+        // The requestor was sent a delta image and still runs the same version, so the delta image could not be
+        // downloaded or applied. The full image is offered to the requestor from now on.
+        ESP_LOGW(TAG, "The delta OTA image failed on the requestor, falling back to the full image");
+        requestor->mDeltaOtaImageSent = false;
+        requestor->mDeltaOtaImageFailed = true;
+    }
     if (fetch_ota_candidate(vendor_id, product_id, software_version, FetchImageDoneCallback, this) != ESP_OK) {
         SendQueryImageResponse(OTAQueryStatus::kNotAvailable);
     }
@@ -235,6 +333,9 @@ void EspOtaProvider::HandleApplyUpdateRequest(app::CommandHandler *commandObj,
         mDelayedApplyActionTimeSec = 0;
         // Reset back to success case for subsequent uses
         mUpdateAction = OTAApplyUpdateAction::kProceed;
+        if (response.action == OTAApplyUpdateAction::kProceed) {
+            requestor->mState = OTA_NODE_STATE_APPLYING;
+        }
 
         // Either sends the response or an error status
         commandObj->AddResponse(commandPath, response);
@@ -260,58 +361,342 @@ void EspOtaProvider::HandleNotifyUpdateApplied(app::CommandHandler *commandObj,
         commandData.softwareVersion == requestor->mSoftwareVersion) {
         commandObj->AddStatus(commandPath, Status::Success);
         // Finish OTA, set the set OtaAllowedOnce to false.
-        requestor->mOtaAllowedOnce = false;
+        requestor->mState = OTA_NODE_STATE_APPLIED;
+        requestor->mFailedTransfers = 0;
+        if (requestor->mOtaAllowedOnce) {
+            requestor->mOtaAllowedOnce = false;
+            UpdateOtaNodePolicy(requestor);
+            SaveOtaNodePolicies();
+        }
     } else {
         commandObj->AddStatus(commandPath, Status::InvalidCommand);
     }
 }
 
+const char *ota_node_state_to_str(ota_node_state_t state)
+{
+    switch (state) {
+    case OTA_NODE_STATE_QUERIED:
+        return "queried";
+    case OTA_NODE_STATE_DOWNLOADING:
+        return "downloading";
+    case OTA_NODE_STATE_DOWNLOADED:
+        return "downloaded";
+    case OTA_NODE_STATE_APPLYING:
+        return "applying";
+    case OTA_NODE_STATE_APPLIED:
+        return "applied";
+    case OTA_NODE_STATE_FAILED:
+        return "failed";
+    default:
+        return "unknown";
+    }
+}
+
+void EspOtaProvider::HandleTransferEvent(OtaBdxSenderPool::TransferEvent event, chip::FabricIndex fabricIndex,
+                                         chip::NodeId nodeId, const esp_matter::ota::transfer_stats_t &stats,
+                                         void *ctx)
+{
+    EspOtaProvider *provider = (EspOtaProvider *)ctx;
+    EspOtaRequestorEntry *requestor = provider->FindOtaRequestorEntry(chip::ScopedNodeId(nodeId, fabricIndex));
+    if (!requestor) {
+        return;
+    }
+    requestor->mTransferStats = stats;
+    switch (event) {
+    case OtaBdxSenderPool::kTransferStarted:
+        requestor->mState = OTA_NODE_STATE_DOWNLOADING;
+        requestor->mPercentComplete = 0;
+        break;
+    case OtaBdxSenderPool::kTransferCompleted:
+        requestor->mState = OTA_NODE_STATE_DOWNLOADED;
+        requestor->mPercentComplete = 100;
+        break;
+    case OtaBdxSenderPool::kTransferFailed: {
+        // The sender still belongs to the node when it reports the end of the transfer
+        OtaBdxSender *sender = provider->mBdxSenderPool.Find(fabricIndex, nodeId);
+        if (sender) {
+            requestor->mPercentComplete = sender->GetPercentComplete(requestor->mOtaImageSize);
+        }
+        requestor->mState = OTA_NODE_STATE_FAILED;
+        requestor->mFailedTransfers++;
+        break;
+    }
+    }
+}
+
+void EspOtaProvider::FillOtaNodeStatus(const EspOtaRequestorEntry *requestor, ota_node_status_t &status)
+{
+    memset(&status, 0, sizeof(status));
+    status.fabric_index = requestor->mNodeId.GetFabricIndex();
+    status.node_id = requestor->mNodeId.GetNodeId();
+    status.vendor_id = requestor->mVendorId;
+    status.product_id = requestor->mProductId;
+    status.current_version = requestor->mCurrentVersion;
+    status.target_version = requestor->mSoftwareVersion;
+    status.state = requestor->mState;
+    status.percent_complete = requestor->mPercentComplete;
+    status.failed_transfers = requestor->mFailedTransfers;
+    status.transfer_stats = requestor->mTransferStats;
+    if (requestor->mState == OTA_NODE_STATE_DOWNLOADING) {
+        OtaBdxSender *sender = mBdxSenderPool.Find(status.fabric_index, status.node_id);
+        if (sender) {
+            status.percent_complete = sender->GetPercentComplete(requestor->mOtaImageSize);
+            sender->GetTransferStats(status.transfer_stats);
+        }
+    }
+}
+
+esp_err_t EspOtaProvider::GetOtaNodeStatus(const chip::ScopedNodeId &nodeId, ota_node_status_t &status)
+{
+    EspOtaRequestorEntry *requestor = FindOtaRequestorEntry(nodeId);
+    ESP_RETURN_ON_FALSE(requestor, ESP_ERR_NOT_FOUND, TAG, "No requestor entry for the node");
+    FillOtaNodeStatus(requestor, status);
+    return ESP_OK;
+}
+
+void EspOtaProvider::ForEachOtaNodeStatus(OtaNodeStatusCallback callback, void *ctx)
+{
+    ota_node_status_t status;
+    for (size_t bucket = 0; bucket < kRequestorBuckets; ++bucket) {
+        for (EspOtaRequestorEntry *iter = mRequestorBuckets[bucket]; iter; iter = iter->mNext) {
+            FillOtaNodeStatus(iter, status);
+            callback(status, ctx);
+        }
+    }
+}
+
+void EspOtaProvider::GetOtaRolloutSummary(ota_rollout_summary_t &summary)
+{
+    memset(&summary, 0, sizeof(summary));
+    for (size_t bucket = 0; bucket < kRequestorBuckets; ++bucket) {
+        for (EspOtaRequestorEntry *iter = mRequestorBuckets[bucket]; iter; iter = iter->mNext) {
+            summary.nodes++;
+            if (iter->mState < OTA_NODE_STATE_MAX) {
+                summary.state_count[iter->mState]++;
+            }
+        }
+    }
+}
+
+static constexpr char kPolicyNvsNamespace[] = "ota_policy";
+static constexpr char kPolicyRulesKey[] = "rules";
+static constexpr char kPolicyRuleMaskKey[] = "rule_mask";
+static constexpr char kPolicyNodeChunksKey[] = "node_chunks";
+// Key of a chunk of node policies, formatted with the index of the chunk
+static constexpr char kPolicyNodeChunkKeyFmt[] = "nodes%u";
+static constexpr uint32_t kMinutesPerDay = 24 * 60;
+// Delay of the next query when the maintenance window cannot be checked
+static constexpr uint32_t kWindowUnknownDelaySec = 3600;
+
+// The policy of a node as it is saved in NVS, the slots of a chunk without a policy have an undefined fabric index
+typedef struct {
+    uint64_t node_id;
+    uint8_t fabric_index;
+    bool ota_allowed;
+    bool ota_allowed_explicit;
+    bool ota_allowed_once;
+} ota_node_policy_t;
+
+static bool MatchesNodeId(const chip::ScopedNodeId &pattern, const chip::ScopedNodeId &nodeId)
+{
+    return pattern == nodeId ||
+        (pattern.GetNodeId() == chip::kUndefinedNodeId &&
+         (pattern.GetFabricIndex() == nodeId.GetFabricIndex() ||
+          pattern.GetFabricIndex() == chip::kUndefinedFabricIndex));
+}
+
+// Share of the staged rollout of a node, it does not change across reboots
+static uint8_t GetRolloutBucket(const chip::ScopedNodeId &nodeId)
+{
+    uint64_t hash = nodeId.GetNodeId() ^ (static_cast<uint64_t>(nodeId.GetFabricIndex()) << 56);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<uint8_t>(hash % 100);
+}
+
+// Whether the current time is in the maintenance window, delaySec is set to the time until the start of the window
+static bool IsInMaintenanceWindow(uint16_t startMinute, uint16_t endMinute, uint32_t &delaySec)
+{
+    delaySec = 0;
+    if (startMinute == endMinute) {
+        return true;
+    }
+    chip::System::Clock::Microseconds64 realTime;
+    if (chip::System::SystemClock().GetClock_RealTime(realTime) != CHIP_NO_ERROR) {
+        // The window cannot be checked before the real time is synced, ask the requestor to query again later
+        ESP_LOGW(TAG, "The real time is not synced, cannot check the maintenance window");
+        delaySec = kWindowUnknownDelaySec;
+        return false;
+    }
+    uint32_t secOfDay = static_cast<uint32_t>((realTime.count() / 1000000) % (kMinutesPerDay * 60));
+    uint32_t minute = secOfDay / 60;
+    bool inWindow = startMinute < endMinute ? (minute >= startMinute && minute < endMinute)
+                                            : (minute >= startMinute || minute < endMinute);
+    if (!inWindow) {
+        delaySec = (startMinute * 60 + kMinutesPerDay * 60 - secOfDay) % (kMinutesPerDay * 60);
+    }
+    return inWindow;
+}
+
+const EspOtaProvider::OtaPolicyRule *EspOtaProvider::FindOtaPolicyRule(const EspOtaRequestorEntry *requestor)
+{
+    for (size_t index = 0; index < kMaxPolicyRules; ++index) {
+        const OtaPolicyRule &rule = mPolicyRules[index];
+        if ((mPolicyRuleMask & BIT(index)) &&
+            (rule.mFabricIndex == chip::kUndefinedFabricIndex ||
+             rule.mFabricIndex == requestor->mNodeId.GetFabricIndex()) &&
+            (rule.mVendorId == 0 || rule.mVendorId == requestor->mVendorId) &&
+            (rule.mProductId == 0 || rule.mProductId == requestor->mProductId) &&
+            requestor->mNodeId.GetNodeId() >= rule.mNodeIdMin && requestor->mNodeId.GetNodeId() <= rule.mNodeIdMax) {
+            return &rule;
+        }
+    }
+    return nullptr;
+}
+
+bool EspOtaProvider::IsOtaAllowed(const EspOtaRequestorEntry *requestor, uint32_t &windowDelaySec)
+{
+    windowDelaySec = 0;
+    if (requestor->mOtaAllowedOnce) {
+        return true;
+    }
+    if (requestor->mOtaAllowedExplicit) {
+        return requestor->mOtaAllowed;
+    }
+    const OtaPolicyRule *rule = FindOtaPolicyRule(requestor);
+    if (!rule) {
+        return mOtaAllowedDefault;
+    }
+    if (!rule->mOtaAllowed || GetRolloutBucket(requestor->mNodeId) >= rule->mRolloutPercent) {
+        return false;
+    }
+    return IsInMaintenanceWindow(rule->mWindowStartMinute, rule->mWindowEndMinute, windowDelaySec);
+}
+
+esp_err_t EspOtaProvider::SetOtaPolicyRule(size_t index, const OtaPolicyRule &rule)
+{
+    ESP_RETURN_ON_FALSE(index < kMaxPolicyRules, ESP_ERR_INVALID_ARG, TAG, "Invalid policy rule index");
+    ESP_RETURN_ON_FALSE(rule.mRolloutPercent <= 100 && rule.mWindowStartMinute < kMinutesPerDay &&
+                            rule.mWindowEndMinute < kMinutesPerDay && rule.mNodeIdMin <= rule.mNodeIdMax,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid policy rule");
+    mPolicyRules[index] = rule;
+    mPolicyRuleMask |= BIT(index);
+    SaveOtaPolicyRules();
+    return ESP_OK;
+}
+
+esp_err_t EspOtaProvider::RemoveOtaPolicyRule(size_t index)
+{
+    ESP_RETURN_ON_FALSE(index < kMaxPolicyRules, ESP_ERR_INVALID_ARG, TAG, "Invalid policy rule index");
+    ESP_RETURN_ON_FALSE(mPolicyRuleMask & BIT(index), ESP_ERR_NOT_FOUND, TAG, "No policy rule at %u",
+                        static_cast<unsigned>(index));
+    mPolicyRuleMask &= ~BIT(index);
+    SaveOtaPolicyRules();
+    return ESP_OK;
+}
+
+EspOtaProvider::DeltaOtaImage *EspOtaProvider::FindDeltaOtaImage(uint16_t vendorId, uint16_t productId,
+                                                                 uint32_t baseVersion, uint32_t softwareVersion)
+{
+    for (size_t index = 0; index < mDeltaOtaImageCount; ++index) {
+        DeltaOtaImage &image = mDeltaOtaImages[index];
+        if (image.mVendorId == vendorId && image.mProductId == productId && image.mBaseVersion == baseVersion &&
+            image.mSoftwareVersion == softwareVersion) {
+            return &image;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t EspOtaProvider::AddDeltaOtaImage(const DeltaOtaImage &image)
+{
+    ESP_RETURN_ON_FALSE(image.mBaseVersion != image.mSoftwareVersion &&
+                            image.mBaseVersion != OTA_FULL_IMAGE_BASE_VERSION &&
+                            strnlen(image.mOtaImageUrl, sizeof(image.mOtaImageUrl)) < sizeof(image.mOtaImageUrl) &&
+                            strrchr(image.mOtaImageUrl, '/'),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid delta OTA image");
+    DeltaOtaImage *entry =
+        FindDeltaOtaImage(image.mVendorId, image.mProductId, image.mBaseVersion, image.mSoftwareVersion);
+    if (!entry) {
+        ESP_RETURN_ON_FALSE(mDeltaOtaImageCount < kMaxDeltaOtaImages, ESP_ERR_NO_MEM, TAG,
+                            "No room for the delta OTA image");
+        entry = &mDeltaOtaImages[mDeltaOtaImageCount++];
+    }
+    *entry = image;
+    if (!entry->mImageSource) {
+        entry->mImageSource = get_ota_image_source();
+    }
+    return ESP_OK;
+}
+
+esp_err_t EspOtaProvider::RemoveDeltaOtaImage(uint16_t vendorId, uint16_t productId, uint32_t baseVersion,
+                                              uint32_t softwareVersion)
+{
+    DeltaOtaImage *entry = FindDeltaOtaImage(vendorId, productId, baseVersion, softwareVersion);
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NOT_FOUND, TAG, "No such delta OTA image");
+    *entry = mDeltaOtaImages[--mDeltaOtaImageCount];
+    return ESP_OK;
+}
+
 esp_err_t EspOtaProvider::EnableOtaForNode(const chip::ScopedNodeId &nodeId, bool forOnlyOnce)
 {
-    EspOtaRequestorEntry *iter = mOtaRequestorList;
     bool found = false;
-    while (iter) {
-        if (iter->mNodeId == nodeId ||
-            (nodeId.GetNodeId() == chip::kUndefinedNodeId &&
-             (nodeId.GetFabricIndex() == iter->mNodeId.GetFabricIndex() ||
-              nodeId.GetFabricIndex() == chip::kUndefinedFabricIndex))) {
-            if (!forOnlyOnce) {
-                iter->mOtaAllowed = true;
-            } else {
-                iter->mOtaAllowedOnce = true;
+    for (EspOtaRequestorEntry *bucket : mRequestorBuckets) {
+        for (EspOtaRequestorEntry *iter = bucket; iter; iter = iter->mNext) {
+            if (MatchesNodeId(nodeId, iter->mNodeId)) {
+                if (!forOnlyOnce) {
+                    iter->mOtaAllowed = true;
+                    iter->mOtaAllowedExplicit = true;
+                } else {
+                    iter->mOtaAllowedOnce = true;
+                }
+                UpdateOtaNodePolicy(iter);
+                found = true;
             }
-            found = true;
         }
-        iter = iter->mNext;
+    }
+    if (found) {
+        SaveOtaNodePolicies();
     }
     return found ? ESP_OK : ESP_ERR_NOT_FOUND;
 }
+
 esp_err_t EspOtaProvider::DisableOtaForNode(const chip::ScopedNodeId &nodeId)
 {
-    EspOtaRequestorEntry *iter = mOtaRequestorList;
     bool found = false;
-    while (iter) {
-        if (iter->mNodeId == nodeId ||
-            (nodeId.GetNodeId() == chip::kUndefinedNodeId &&
-             (nodeId.GetFabricIndex() == iter->mNodeId.GetFabricIndex() ||
-              nodeId.GetFabricIndex() == chip::kUndefinedFabricIndex))) {
-            iter->mOtaAllowed = false;
-            iter->mOtaAllowedOnce = false;
-            found = true;
+    for (EspOtaRequestorEntry *bucket : mRequestorBuckets) {
+        for (EspOtaRequestorEntry *iter = bucket; iter; iter = iter->mNext) {
+            if (MatchesNodeId(nodeId, iter->mNodeId)) {
+                iter->mOtaAllowed = false;
+                iter->mOtaAllowedExplicit = true;
+                iter->mOtaAllowedOnce = false;
+                UpdateOtaNodePolicy(iter);
+                found = true;
+            }
         }
-        iter = iter->mNext;
+    }
+    if (found) {
+        SaveOtaNodePolicies();
     }
     return found ? ESP_OK : ESP_ERR_NOT_FOUND;
 }
 
+EspOtaProvider::EspOtaRequestorEntry *&EspOtaProvider::GetRequestorBucket(const chip::ScopedNodeId &nodeId)
+{
+    uint64_t hash = nodeId.GetNodeId() ^ (static_cast<uint64_t>(nodeId.GetFabricIndex()) * 0x9e3779b97f4a7c15ULL);
+    hash ^= hash >> 32;
+    hash ^= hash >> 16;
+    return mRequestorBuckets[hash & (kRequestorBuckets - 1)];
+}
+
 EspOtaProvider::EspOtaRequestorEntry *EspOtaProvider::FindOtaRequestorEntry(const chip::ScopedNodeId &nodeId)
 {
-    EspOtaRequestorEntry *iter = mOtaRequestorList;
-    while (iter) {
+    for (EspOtaRequestorEntry *iter = GetRequestorBucket(nodeId); iter; iter = iter->mNext) {
         if (iter->mNodeId == nodeId) {
             return iter;
         }
-        iter = iter->mNext;
     }
     return nullptr;
 }
@@ -326,31 +711,195 @@ esp_err_t EspOtaProvider::CreateOtaRequestorEntry(const chip::ScopedNodeId &node
         }
         entry->mNodeId = nodeId;
         entry->mOtaAllowed = mOtaAllowedDefault;
-        entry->mNext = mOtaRequestorList;
-        mOtaRequestorList = entry;
+        EspOtaRequestorEntry *&bucket = GetRequestorBucket(nodeId);
+        entry->mNext = bucket;
+        bucket = entry;
     }
     return ESP_OK;
 }
 
 esp_err_t EspOtaProvider::RemoveOtaRequestorEntry(const chip::ScopedNodeId &nodeId)
 {
-    EspOtaRequestorEntry *prev = nullptr;
-    EspOtaRequestorEntry *iter = mOtaRequestorList;
-    while (iter && iter->mNodeId != nodeId) {
-        prev = iter;
-        iter = iter->mNext;
-    }
-    if (iter) {
-        if (!prev) {
-            mOtaRequestorList = iter->mNext;
-        } else {
-            prev->mNext = iter->mNext;
+    for (EspOtaRequestorEntry **iter = &GetRequestorBucket(nodeId); *iter; iter = &(*iter)->mNext) {
+        if ((*iter)->mNodeId == nodeId) {
+            EspOtaRequestorEntry *entry = *iter;
+            *iter = entry->mNext;
+            mBdxSenderPool.CancelWait(entry->mBdxWaiter);
+            if (entry->mPolicySlot != 0) {
+                entry->mOtaAllowedExplicit = false;
+                entry->mOtaAllowedOnce = false;
+                UpdateOtaNodePolicy(entry);
+                SaveOtaNodePolicies();
+            }
+            chip::Platform::Delete(entry);
+            return ESP_OK;
         }
-        chip::Platform::Delete(iter);
-        return ESP_OK;
     }
     return ESP_ERR_NOT_FOUND;
 }
 
+esp_err_t EspOtaProvider::GrowOtaPolicyChunks(size_t count)
+{
+    if (count <= mPolicyChunkCount) {
+        return ESP_OK;
+    }
+    OtaPolicyChunk *chunks = (OtaPolicyChunk *)esp_matter_mem_calloc(count, sizeof(OtaPolicyChunk));
+    ESP_RETURN_ON_FALSE(chunks, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the OTA node policies");
+    if (mPolicyChunks) {
+        memcpy(chunks, mPolicyChunks, mPolicyChunkCount * sizeof(OtaPolicyChunk));
+        esp_matter_mem_free(mPolicyChunks);
+    }
+    mPolicyChunks = chunks;
+    mPolicyChunkCount = count;
+    return ESP_OK;
+}
+
+void EspOtaProvider::UpdateOtaNodePolicy(EspOtaRequestorEntry *requestor)
+{
+    // Only the nodes with a policy of their own are saved, the other entries are created again when they query
+    bool hasPolicy = requestor->mOtaAllowedExplicit || requestor->mOtaAllowedOnce;
+    if (hasPolicy && requestor->mPolicySlot == 0) {
+        size_t slot = 0;
+        size_t slotCount = mPolicyChunkCount * kPolicyChunkSlots;
+        while (slot < slotCount && mPolicyChunks[slot / kPolicyChunkSlots].mEntries[slot % kPolicyChunkSlots]) {
+            slot++;
+        }
+        if (slot == slotCount && GrowOtaPolicyChunks(mPolicyChunkCount + 1) != ESP_OK) {
+            return;
+        }
+        mPolicyChunks[slot / kPolicyChunkSlots].mEntries[slot % kPolicyChunkSlots] = requestor;
+        requestor->mPolicySlot = slot + 1;
+    }
+    if (requestor->mPolicySlot == 0) {
+        return;
+    }
+    OtaPolicyChunk &chunk = mPolicyChunks[(requestor->mPolicySlot - 1) / kPolicyChunkSlots];
+    chunk.mDirty = true;
+    if (!hasPolicy) {
+        chunk.mEntries[(requestor->mPolicySlot - 1) % kPolicyChunkSlots] = nullptr;
+        requestor->mPolicySlot = 0;
+    }
+}
+
+void EspOtaProvider::SaveOtaNodePolicies()
+{
+    ota_node_policy_t *policies = (ota_node_policy_t *)esp_matter_mem_calloc(kPolicyChunkSlots,
+                                                                             sizeof(ota_node_policy_t));
+    if (!policies) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the OTA node policies");
+        return;
+    }
+    nvs_handle_t handle;
+    esp_err_t err =
+        nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, kPolicyNvsNamespace, NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        for (size_t index = 0; index < mPolicyChunkCount && err == ESP_OK; ++index) {
+            OtaPolicyChunk &chunk = mPolicyChunks[index];
+            if (!chunk.mDirty) {
+                continue;
+            }
+            memset(policies, 0, kPolicyChunkSlots * sizeof(ota_node_policy_t));
+            for (size_t slot = 0; slot < kPolicyChunkSlots; ++slot) {
+                const EspOtaRequestorEntry *entry = chunk.mEntries[slot];
+                policies[slot].fabric_index = chip::kUndefinedFabricIndex;
+                if (entry) {
+                    policies[slot].node_id = entry->mNodeId.GetNodeId();
+                    policies[slot].fabric_index = entry->mNodeId.GetFabricIndex();
+                    policies[slot].ota_allowed = entry->mOtaAllowed;
+                    policies[slot].ota_allowed_explicit = entry->mOtaAllowedExplicit;
+                    policies[slot].ota_allowed_once = entry->mOtaAllowedOnce;
+                }
+            }
+            char key[NVS_KEY_NAME_MAX_SIZE];
+            snprintf(key, sizeof(key), kPolicyNodeChunkKeyFmt, static_cast<unsigned>(index));
+            err = nvs_set_blob(handle, key, policies, kPolicyChunkSlots * sizeof(ota_node_policy_t));
+            chunk.mDirty = err != ESP_OK;
+        }
+        if (err == ESP_OK) {
+            err = nvs_set_u32(handle, kPolicyNodeChunksKey, mPolicyChunkCount);
+        }
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save the OTA node policies: %s", esp_err_to_name(err));
+    }
+    esp_matter_mem_free(policies);
+}
+
+void EspOtaProvider::SaveOtaPolicyRules()
+{
+    nvs_handle_t handle;
+    esp_err_t err =
+        nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, kPolicyNvsNamespace, NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_u32(handle, kPolicyRuleMaskKey, mPolicyRuleMask);
+        if (err == ESP_OK) {
+            err = nvs_set_blob(handle, kPolicyRulesKey, mPolicyRules, sizeof(mPolicyRules));
+        }
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save the OTA policy rules: %s", esp_err_to_name(err));
+    }
+}
+
+void EspOtaProvider::LoadOtaPolicies()
+{
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, kPolicyNvsNamespace, NVS_READONLY, &handle) !=
+        ESP_OK) {
+        return;
+    }
+    size_t size = sizeof(mPolicyRules);
+    uint32_t ruleMask = 0;
+    // The rules saved with another CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_POLICY_RULES are dropped
+    if (nvs_get_u32(handle, kPolicyRuleMaskKey, &ruleMask) == ESP_OK &&
+        nvs_get_blob(handle, kPolicyRulesKey, mPolicyRules, &size) == ESP_OK && size == sizeof(mPolicyRules)) {
+        mPolicyRuleMask = ruleMask;
+    }
+    uint32_t chunkCount = 0;
+    ota_node_policy_t *policies = nullptr;
+    if (nvs_get_u32(handle, kPolicyNodeChunksKey, &chunkCount) == ESP_OK && chunkCount > 0 &&
+        GrowOtaPolicyChunks(chunkCount) == ESP_OK) {
+        policies = (ota_node_policy_t *)esp_matter_mem_calloc(kPolicyChunkSlots, sizeof(ota_node_policy_t));
+    }
+    size_t nodeCount = 0;
+    for (size_t index = 0; policies && index < chunkCount; ++index) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        snprintf(key, sizeof(key), kPolicyNodeChunkKeyFmt, static_cast<unsigned>(index));
+        size = kPolicyChunkSlots * sizeof(ota_node_policy_t);
+        if (nvs_get_blob(handle, key, policies, &size) != ESP_OK || size != kPolicyChunkSlots * sizeof(*policies)) {
+            continue;
+        }
+        for (size_t slot = 0; slot < kPolicyChunkSlots; ++slot) {
+            if (policies[slot].fabric_index == chip::kUndefinedFabricIndex) {
+                continue;
+            }
+            chip::ScopedNodeId nodeId(policies[slot].node_id, policies[slot].fabric_index);
+            if (CreateOtaRequestorEntry(nodeId) != ESP_OK) {
+                break;
+            }
+            EspOtaRequestorEntry *entry = FindOtaRequestorEntry(nodeId);
+            entry->mOtaAllowed = policies[slot].ota_allowed;
+            entry->mOtaAllowedExplicit = policies[slot].ota_allowed_explicit;
+            entry->mOtaAllowedOnce = policies[slot].ota_allowed_once;
+            entry->mPolicySlot = index * kPolicyChunkSlots + slot + 1;
+            mPolicyChunks[index].mEntries[slot] = entry;
+            nodeCount++;
+        }
+    }
+    if (nodeCount > 0) {
+        ESP_LOGI(TAG, "Loaded the OTA policies of %u nodes", static_cast<unsigned>(nodeCount));
+    }
+    esp_matter_mem_free(policies);
+    nvs_close(handle);
+}
+
 } // namespace ota_provider
 } // namespace esp_matter
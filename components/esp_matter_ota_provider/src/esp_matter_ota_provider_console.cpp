@@ -0,0 +1,122 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_matter_ota_provider.h>
+#include <esp_matter_ota_provider_console.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <platform/PlatformManager.h>
+
+using esp_matter::ota_provider::EspOtaProvider;
+using esp_matter::ota_provider::ota_node_state_t;
+using esp_matter::ota_provider::ota_node_status_t;
+using esp_matter::ota_provider::ota_rollout_summary_t;
+
+namespace esp_matter {
+namespace console {
+
+static constexpr char TAG[] = "ota_provider_console";
+static engine ota_provider_console;
+
+static void print_node_status(const ota_node_status_t &status, void *ctx)
+{
+    printf("0x%x:0x%016" PRIX64 "\t%04x:%04x\t%" PRIu32 " -> %" PRIu32 "\t%s", status.fabric_index, status.node_id,
+           status.vendor_id, status.product_id, status.current_version, status.target_version,
+           ota_provider::ota_node_state_to_str(status.state));
+    if (status.state == ota_provider::OTA_NODE_STATE_DOWNLOADING ||
+        status.state == ota_provider::OTA_NODE_STATE_FAILED) {
+        printf(" %u%%", status.percent_complete);
+    }
+    printf("\tfailed transfers %" PRIu32 "\n", status.failed_transfers);
+}
+
+static esp_err_t rollout_handler(int argc, char **argv)
+{
+    ota_rollout_summary_t summary;
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    EspOtaProvider::GetInstance().GetOtaRolloutSummary(summary);
+    printf("Requestors: %" PRIu32 "\n", summary.nodes);
+    for (int state = 0; state < ota_provider::OTA_NODE_STATE_MAX; ++state) {
+        printf("  %s: %" PRIu32 "\n", ota_provider::ota_node_state_to_str(static_cast<ota_node_state_t>(state)),
+               summary.state_count[state]);
+    }
+    EspOtaProvider::GetInstance().ForEachOtaNodeStatus(print_node_status, nullptr);
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+    return ESP_OK;
+}
+
+static esp_err_t node_handler(int argc, char **argv)
+{
+    ESP_RETURN_ON_FALSE(argc == 2, ESP_ERR_INVALID_ARG, TAG,
+                        "Usage: matter esp ota-provider node <fabric-index> <node-id>");
+    chip::FabricIndex fabricIndex = static_cast<chip::FabricIndex>(strtoul(argv[0], nullptr, 0));
+    chip::ScopedNodeId nodeId(strtoull(argv[1], nullptr, 0), fabricIndex);
+    ota_node_status_t status;
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    esp_err_t err = EspOtaProvider::GetInstance().GetOtaNodeStatus(nodeId, status);
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to get the status of the node");
+
+    const esp_matter::ota::transfer_stats_t &stats = status.transfer_stats;
+    print_node_status(status, nullptr);
+    printf("Transfer: %s, %" PRIu64 " bytes in %" PRIu32 " blocks, %" PRIu32 " ms, %" PRIu32 " B/s\n",
+           stats.active ? "running" : "stopped", stats.bytes, stats.blocks, stats.elapsed_ms, stats.throughput_bps);
+    printf("Block RTT: last %" PRIu32 " ms, avg %" PRIu32 " ms, max %" PRIu32 " ms\n", stats.last_rtt_ms,
+           stats.avg_rtt_ms, stats.max_rtt_ms);
+    printf("Retries: %" PRIu32 ", stalls: %" PRIu32 ", total %" PRIu32 " ms, max %" PRIu32 " ms\n", stats.retries,
+           stats.stalls, stats.total_stall_ms, stats.max_stall_ms);
+    return ESP_OK;
+}
+
+static esp_err_t ota_provider_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        ota_provider_console.for_each_command(print_description, NULL);
+        return ESP_OK;
+    }
+    return ota_provider_console.exec_command(argc, argv);
+}
+
+esp_err_t ota_provider_register_commands()
+{
+    static const command_t command = {
+        .name = "ota-provider",
+        .description = "OTA Provider rollout dashboard. Usage matter esp ota-provider <command>.",
+        .handler = ota_provider_dispatch,
+    };
+
+    static const command_t ota_provider_commands[] = {
+        {
+            .name = "rollout",
+            .description = "print the state of the update of each requestor. Usage: matter esp ota-provider rollout",
+            .handler = rollout_handler,
+        },
+        {
+            .name = "node",
+            .description = "print the status and the transfer statistics of a requestor. "
+                           "Usage: matter esp ota-provider node <fabric-index> <node-id>",
+            .handler = node_handler,
+        },
+    };
+    ota_provider_console.register_commands(ota_provider_commands,
+                                           sizeof(ota_provider_commands) / sizeof(command_t));
+
+    return add_commands(&command, 1);
+}
+
+} // namespace console
+} // namespace esp_matter
@@ -0,0 +1,253 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_read_ahead.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <string.h>
+
+#include <platform/CHIPDeviceLayer.h>
+
+static constexpr char TAG[] = "ota_read_ahead";
+
+namespace esp_matter {
+namespace ota_provider {
+
+static constexpr size_t ring_blocks = CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_READ_AHEAD_BLOCKS;
+
+struct read_ahead_stream {
+    read_ahead_read_cb_t read_cb;
+    read_ahead_close_cb_t close_cb;
+    void *ctx;
+    read_ahead_ready_cb_t ready_cb;
+    intptr_t ready_arg;
+    size_t block_size;
+    uint8_t *ring;
+    size_t block_len[ring_blocks];
+    size_t head;
+    size_t count;
+    // The read-ahead task is reading the block after the last one of the ring
+    bool reading;
+    bool eof;
+    bool error;
+    // The consumer is waiting for the next block
+    bool waiting;
+    bool released;
+    bool complete;
+    read_ahead_stream *next;
+};
+
+static SemaphoreHandle_t _lock = NULL;
+static TaskHandle_t _task = NULL;
+static read_ahead_stream *_streams = nullptr;
+// The stream which got the last block, the next pass starts after it
+static read_ahead_stream *_cursor = nullptr;
+
+static void _free_stream(read_ahead_stream *stream)
+{
+    stream->close_cb(stream->ctx, stream->complete);
+    esp_matter_mem_free(stream->ring);
+    esp_matter_mem_free(stream);
+}
+
+static void _close_work(intptr_t arg)
+{
+    _free_stream(reinterpret_cast<read_ahead_stream *>(arg));
+}
+
+static void _unlink_stream(read_ahead_stream *stream)
+{
+    if (_cursor == stream) {
+        _cursor = nullptr;
+    }
+    for (read_ahead_stream **iter = &_streams; *iter; iter = &(*iter)->next) {
+        if (*iter == stream) {
+            *iter = stream->next;
+            return;
+        }
+    }
+}
+
+// Read one block of the first stream which has room in its ring, returns false if there is nothing to read
+static bool _read_next_block()
+{
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    read_ahead_stream *stream = nullptr;
+    // Continue after the stream served last, so that every stream gets a block in turn
+    read_ahead_stream *start = _cursor && _cursor->next ? _cursor->next : _streams;
+    read_ahead_stream *iter = start;
+    while (iter) {
+        if (!iter->released && !iter->eof && !iter->error && iter->count < ring_blocks) {
+            stream = iter;
+            break;
+        }
+        iter = iter->next ? iter->next : _streams;
+        if (iter == start) {
+            break;
+        }
+    }
+    if (!stream) {
+        _cursor = nullptr;
+        xSemaphoreGive(_lock);
+        return false;
+    }
+    size_t slot = (stream->head + stream->count) % ring_blocks;
+    stream->reading = true;
+    xSemaphoreGive(_lock);
+
+    int len = stream->read_cb(stream->ctx, stream->ring + slot * stream->block_size, stream->block_size);
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    stream->reading = false;
+    _cursor = stream;
+    if (stream->released) {
+        // The reader cannot be released while it is reading, release it now from the Matter thread
+        _unlink_stream(stream);
+        xSemaphoreGive(_lock);
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(_close_work, reinterpret_cast<intptr_t>(stream));
+        return true;
+    }
+    if (len < 0) {
+        stream->error = true;
+    } else {
+        stream->block_len[slot] = len;
+        stream->count++;
+        stream->eof = static_cast<size_t>(len) < stream->block_size;
+    }
+    bool notify = stream->waiting;
+    stream->waiting = false;
+    read_ahead_ready_cb_t ready_cb = stream->ready_cb;
+    intptr_t ready_arg = stream->ready_arg;
+    xSemaphoreGive(_lock);
+    if (notify) {
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(ready_cb, ready_arg);
+    }
+    return true;
+}
+
+static void _read_ahead_task(void *arg)
+{
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (_read_next_block()) {
+        }
+    }
+}
+
+esp_err_t read_ahead_init()
+{
+    if (_task) {
+        return ESP_OK;
+    }
+    _lock = xSemaphoreCreateMutex();
+    ESP_RETURN_ON_FALSE(_lock, ESP_ERR_NO_MEM, TAG, "Failed to create the read-ahead lock");
+    if (xTaskCreate(_read_ahead_task, "ota_read_ahead", CONFIG_ESP_MATTER_OTA_PROVIDER_READ_AHEAD_TASK_STACK_SIZE,
+                    NULL, 5, &_task) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to create the read-ahead task");
+        vSemaphoreDelete(_lock);
+        _lock = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t read_ahead_start(read_ahead_read_cb_t read_cb, read_ahead_close_cb_t close_cb, void *ctx, size_t block_size,
+                           read_ahead_ready_cb_t ready_cb, intptr_t ready_arg, read_ahead_handle_t *handle)
+{
+    esp_err_t ret = ESP_OK;
+    read_ahead_stream *stream = nullptr;
+    ESP_GOTO_ON_FALSE(_task, ESP_ERR_INVALID_STATE, cleanup, TAG, "The read-ahead task is not started");
+    ESP_GOTO_ON_FALSE(read_cb && ready_cb && handle && block_size > 0, ESP_ERR_INVALID_ARG, cleanup, TAG,
+                      "Invalid arguments");
+    stream = (read_ahead_stream *)esp_matter_mem_calloc(1, sizeof(read_ahead_stream));
+    ESP_GOTO_ON_FALSE(stream, ESP_ERR_NO_MEM, cleanup, TAG, "Failed to alloc memory for the read-ahead stream");
+    stream->ring = (uint8_t *)esp_matter_mem_calloc(ring_blocks, block_size);
+    ESP_GOTO_ON_FALSE(stream->ring, ESP_ERR_NO_MEM, cleanup, TAG, "Failed to alloc memory for the read-ahead ring");
+    stream->read_cb = read_cb;
+    stream->close_cb = close_cb;
+    stream->ctx = ctx;
+    stream->ready_cb = ready_cb;
+    stream->ready_arg = ready_arg;
+    stream->block_size = block_size;
+
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    stream->next = _streams;
+    _streams = stream;
+    xSemaphoreGive(_lock);
+    xTaskNotifyGive(_task);
+    *handle = stream;
+    return ESP_OK;
+
+cleanup:
+    if (stream) {
+        esp_matter_mem_free(stream);
+    }
+    close_cb(ctx, false);
+    return ret;
+}
+
+int read_ahead_get(read_ahead_handle_t handle, uint8_t *buf, size_t size)
+{
+    if (!handle) {
+        return -1;
+    }
+    int len;
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    if (handle->count > 0) {
+        size_t slot = handle->head;
+        len = static_cast<int>(std::min(size, handle->block_len[slot]));
+        memcpy(buf, handle->ring + slot * handle->block_size, len);
+        handle->head = (handle->head + 1) % ring_blocks;
+        handle->count--;
+    } else if (handle->error) {
+        len = -1;
+    } else if (handle->eof) {
+        len = 0;
+    } else {
+        handle->waiting = true;
+        len = k_read_ahead_pending;
+    }
+    xSemaphoreGive(_lock);
+    if (len != k_read_ahead_pending) {
+        // A slot of the ring is free again
+        xTaskNotifyGive(_task);
+    }
+    return len;
+}
+
+void read_ahead_release(read_ahead_handle_t handle, bool complete)
+{
+    if (!handle) {
+        return;
+    }
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    handle->released = true;
+    handle->complete = complete;
+    bool reading = handle->reading;
+    if (!reading) {
+        _unlink_stream(handle);
+    }
+    xSemaphoreGive(_lock);
+    if (!reading) {
+        _free_stream(handle);
+    }
+}
+
+} // namespace ota_provider
+} // namespace esp_matter
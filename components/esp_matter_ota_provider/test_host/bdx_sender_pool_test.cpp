@@ -0,0 +1,417 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the BDX sender pool of the OTA Provider on Linux, with CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MAX_SESSIONS senders:
+//
+//     bdx_sender_pool_test admission
+//     bdx_sender_pool_test queue
+//     bdx_sender_pool_test transfer <image size> <block size> <start offset> <pending reads>
+//
+// The Requestors are simulated by the test, which sends their BDX messages to the pool through the host exchange
+// manager. The images are read from a test image source, and the read-ahead task is replaced by synchronous reads,
+// which return k_read_ahead_pending for every block first with <pending reads>. The results are printed as
+// '<name> <value>' lines.
+
+#include <esp_heap_caps.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_bdx_sender.h>
+#include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_image_source.h>
+#include <esp_matter_ota_read_ahead.h>
+#include <inttypes.h>
+#include <messaging/ExchangeMgr.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace esp_matter::ota_provider;
+using chip::Messaging::ExchangeContext;
+
+static constexpr chip::FabricIndex k_fabric_index = 1;
+static constexpr uint32_t k_reservation_timeout_ms = 10000;
+static constexpr uint32_t k_query_delay_sec = 120;
+static constexpr uint32_t k_header_size = 32;
+
+static std::vector<uint8_t> s_image;
+static bool s_pending_reads = false;
+static size_t s_open_images = 0;
+
+static chip::Messaging::ExchangeManager s_exchange_mgr;
+static OtaBdxSenderPool s_pool;
+
+static int s_events[3] = {};
+static uint64_t s_completed_bytes = 0;
+
+// The test image source serves s_image at any URL but "missing"
+typedef struct {
+    size_t offset;
+} test_image_reader_t;
+
+static esp_err_t _open_image(void *ctx, const char *ota_url, uint64_t offset, void **reader)
+{
+    if (strcmp(ota_url, "missing") == 0 || offset > s_image.size()) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    test_image_reader_t *image_reader = (test_image_reader_t *)esp_matter_mem_calloc(1, sizeof(test_image_reader_t));
+    if (!image_reader) {
+        return ESP_ERR_NO_MEM;
+    }
+    image_reader->offset = offset;
+    *reader = image_reader;
+    s_open_images++;
+    return ESP_OK;
+}
+
+static int _read_image(void *reader, uint8_t *buf, size_t size)
+{
+    test_image_reader_t *image_reader = (test_image_reader_t *)reader;
+    size_t len = std::min(size, s_image.size() - image_reader->offset);
+    memcpy(buf, s_image.data() + image_reader->offset, len);
+    image_reader->offset += len;
+    return static_cast<int>(len);
+}
+
+static void _close_image(void *reader)
+{
+    s_open_images--;
+    esp_matter_mem_free(reader);
+}
+
+static const ota_image_source_t s_image_source = {nullptr, _open_image, _read_image, _close_image, nullptr, false};
+
+const ota_image_source_t *esp_matter::ota_provider::get_ota_image_source()
+{
+    return &s_image_source;
+}
+
+// Synchronous read-ahead, the blocks are read when they are requested
+struct esp_matter::ota_provider::read_ahead_stream {
+    read_ahead_read_cb_t read_cb;
+    read_ahead_close_cb_t close_cb;
+    void *ctx;
+    size_t block_size;
+    read_ahead_ready_cb_t ready_cb;
+    intptr_t ready_arg;
+    bool block_ready;
+};
+
+esp_err_t esp_matter::ota_provider::read_ahead_init()
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_matter::ota_provider::read_ahead_start(read_ahead_read_cb_t read_cb, read_ahead_close_cb_t close_cb,
+                                                     void *ctx, size_t block_size, read_ahead_ready_cb_t ready_cb,
+                                                     intptr_t ready_arg, read_ahead_handle_t *handle)
+{
+    read_ahead_stream *stream = (read_ahead_stream *)esp_matter_mem_calloc(1, sizeof(read_ahead_stream));
+    if (!stream) {
+        close_cb(ctx, false);
+        return ESP_ERR_NO_MEM;
+    }
+    *stream = {read_cb, close_cb, ctx, block_size, ready_cb, ready_arg, false};
+    *handle = stream;
+    return ESP_OK;
+}
+
+int esp_matter::ota_provider::read_ahead_get(read_ahead_handle_t handle, uint8_t *buf, size_t size)
+{
+    if (s_pending_reads && !handle->block_ready) {
+        handle->block_ready = true;
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(handle->ready_cb, handle->ready_arg);
+        return k_read_ahead_pending;
+    }
+    handle->block_ready = false;
+    return handle->read_cb(handle->ctx, buf, std::min(size, handle->block_size));
+}
+
+void esp_matter::ota_provider::read_ahead_release(read_ahead_handle_t handle, bool complete)
+{
+    handle->close_cb(handle->ctx, complete);
+    esp_matter_mem_free(handle);
+}
+
+static void _transfer_event(OtaBdxSenderPool::TransferEvent event, chip::FabricIndex fabric_index,
+                            chip::NodeId node_id, const esp_matter::ota::transfer_stats_t &stats, void *ctx)
+{
+    s_events[event]++;
+    if (event == OtaBdxSenderPool::kTransferCompleted) {
+        s_completed_bytes = stats.bytes;
+    }
+}
+
+static void init_pool()
+{
+    s_pool.Init(s_exchange_mgr, chip::System::Clock::Milliseconds64(k_reservation_timeout_ms));
+    s_pool.SetTransferEventCallback(_transfer_event, nullptr);
+}
+
+static void make_image(size_t size)
+{
+    s_image.resize(size);
+    for (size_t index = 0; index < size; ++index) {
+        s_image[index] = static_cast<uint8_t>(index * 7);
+    }
+    ota_image_header_prefix_t prefix = {k_ota_image_file_identifier, size, k_header_size};
+    memcpy(s_image.data(), &prefix, sizeof(prefix));
+}
+
+// Prepare the transfer of the sender as the OTA Provider does for a QueryImage
+static OtaBdxSender *prepare_transfer(OtaBdxSender *sender, uint16_t block_size = 1024, const char *url = "image.ota")
+{
+    if (!sender) {
+        return nullptr;
+    }
+    chip::BitFlags<chip::bdx::TransferControlFlags> flags;
+    flags.Set(chip::bdx::TransferControlFlags::kReceiverDrive);
+    sender->SetOtaImageUrl(url);
+    if (sender->PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender, flags,
+                                   block_size, chip::System::Clock::Milliseconds64(k_reservation_timeout_ms),
+                                   chip::System::Clock::Milliseconds32(50)) != CHIP_NO_ERROR) {
+        return nullptr;
+    }
+    return sender;
+}
+
+static OtaBdxSender *prepare(chip::NodeId node_id, uint16_t block_size = 1024)
+{
+    return prepare_transfer(s_pool.Acquire(k_fabric_index, node_id), block_size);
+}
+
+static CHIP_ERROR send(ExchangeContext &exchange, const std::vector<uint8_t> &payload)
+{
+    chip::Protocols::Id protocol_id =
+        payload[0] == static_cast<uint8_t>(chip::Protocols::SecureChannel::MsgType::StatusReport)
+        ? chip::Protocols::SecureChannel::Id
+        : chip::Protocols::BDX::Id;
+    return s_exchange_mgr.ReceiveMessage(&exchange, protocol_id,
+                                         chip::System::PacketBufferHandle::NewWithData(payload.data(), payload.size()));
+}
+
+static CHIP_ERROR send_init(ExchangeContext &exchange, uint64_t start_offset = 0)
+{
+    std::vector<uint8_t> payload = {static_cast<uint8_t>(chip::bdx::MessageType::ReceiveInit)};
+    for (int index = 0; index < 8; ++index) {
+        payload.push_back(static_cast<uint8_t>(start_offset >> (8 * index)));
+    }
+    return send(exchange, payload);
+}
+
+static CHIP_ERROR send_status_report(ExchangeContext &exchange)
+{
+    return send(exchange, {static_cast<uint8_t>(chip::Protocols::SecureChannel::MsgType::StatusReport), 0x5F, 0x00});
+}
+
+static uint8_t last_sent(const ExchangeContext &exchange)
+{
+    return exchange.GetSentMessages().empty() ? 0 : exchange.GetSentMessages().back().msgType;
+}
+
+static chip::ScopedNodeId peer(chip::NodeId node_id)
+{
+    return chip::ScopedNodeId(node_id, k_fabric_index);
+}
+
+static int test_admission()
+{
+    init_pool();
+    make_image(4096);
+    printf("max_sessions %zu\n", OtaBdxSenderPool::kMaxSessions);
+    OtaBdxSender *first = prepare(1);
+    OtaBdxSender *second = prepare(2);
+    printf("acquire_first %d\n", first != nullptr);
+    printf("acquire_second %d\n", second != nullptr && second != first);
+    printf("acquire_full %d\n", prepare(3) != nullptr);
+    printf("free_full %zu\n", s_pool.GetFreeCount());
+    // A node which queries again restarts its transfer on the same sender
+    printf("acquire_again %d\n", prepare(1) == first);
+    printf("find_second %d\n", s_pool.Find(k_fabric_index, 2) == second);
+    printf("find_other_fabric %d\n", s_pool.Find(k_fabric_index + 1, 2) != nullptr);
+
+    // A BDX exchange of a node without a prepared sender is refused
+    ExchangeContext unknown(peer(3));
+    printf("init_unknown 0x%" PRIx32 "\n", send_init(unknown).AsInteger());
+
+    // The second node starts its transfer, the first one does not within the reservation timeout
+    ExchangeContext exchange(peer(2));
+    printf("init_result 0x%" PRIx32 "\n", send_init(exchange).AsInteger());
+    printf("init_reply 0x%02x\n", last_sent(exchange));
+    host_test::advance_time_ms(k_reservation_timeout_ms);
+    printf("free_expired %zu\n", s_pool.GetFreeCount());
+    OtaBdxSender *third = prepare(3);
+    printf("acquire_expired %d\n", third == first);
+    printf("find_expired %d\n", s_pool.Find(k_fabric_index, 1) != nullptr);
+
+    // The started transfer keeps its sender until the Requestor aborts it
+    host_test::advance_time_ms(k_reservation_timeout_ms);
+    printf("free_started %zu\n", s_pool.GetFreeCount());
+    printf("status_result 0x%" PRIx32 "\n", send_status_report(exchange).AsInteger());
+    printf("exchange_closed %d\n", exchange.IsClosed());
+    printf("free_aborted %zu\n", s_pool.GetFreeCount());
+    printf("open_images %zu\n", s_open_images);
+
+    // The free heap is too low for a new transfer, a node with a sender still gets it
+    host_test::set_free_heap_size(CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MIN_FREE_HEAP - 1);
+    printf("acquire_low_heap %d\n", prepare(4) != nullptr);
+    printf("acquire_low_heap_again %d\n", prepare(3) == third);
+    host_test::set_free_heap_size(CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MIN_FREE_HEAP);
+    printf("acquire_heap %d\n", prepare(4) != nullptr);
+
+    printf("started %d\n", s_events[OtaBdxSenderPool::kTransferStarted]);
+    printf("failed %d\n", s_events[OtaBdxSenderPool::kTransferFailed]);
+    return 0;
+}
+
+struct requestor {
+    chip::NodeId node_id;
+    OtaBdxSenderPool::Waiter waiter;
+    uint32_t delay_sec;
+};
+
+// Query as the OTA Provider handles a QueryImage, a refused requestor is queued with its delay
+static bool query(requestor &req, size_t &position)
+{
+    if (prepare_transfer(s_pool.Admit(k_fabric_index, req.node_id, req.waiter, position))) {
+        req.delay_sec = 0;
+        return true;
+    }
+    req.delay_sec = s_pool.Wait(req.waiter, position, k_query_delay_sec);
+    return false;
+}
+
+static int test_queue()
+{
+    init_pool();
+    requestor reqs[9] = {};
+    for (size_t index = 0; index < 9; ++index) {
+        reqs[index].node_id = index + 1;
+    }
+    size_t position = 0;
+    // The first requestors get the senders and start their transfers, the next ones wait longer as the queue grows
+    printf("admit_1 %d\n", query(reqs[0], position));
+    printf("admit_2 %d\n", query(reqs[1], position));
+    ExchangeContext first_exchange(peer(1));
+    ExchangeContext second_exchange(peer(2));
+    send_init(first_exchange);
+    send_init(second_exchange);
+    for (size_t index = 2; index < 7; ++index) {
+        bool admitted = query(reqs[index], position);
+        printf("admit_%zu %d\n", index + 1, admitted);
+        printf("position_%zu %zu\n", index + 1, position);
+        printf("delay_%zu %" PRIu32 "\n", index + 1, reqs[index].delay_sec);
+    }
+    printf("waiters %zu\n", s_pool.GetWaiterCount());
+
+    // A requestor querying again keeps its position and its delay
+    host_test::advance_time_ms(60000);
+    query(reqs[4], position);
+    printf("requery_position %zu\n", position);
+    printf("requery_delay %" PRIu32 "\n", reqs[4].delay_sec);
+
+    // The sender of the first requestor is released, it is kept for the requestor which waited the longest
+    send_status_report(first_exchange);
+    printf("free_one %zu\n", s_pool.GetFreeCount());
+    printf("admit_later %d\n", query(reqs[4], position));
+    printf("admit_new %d\n", query(reqs[7], position));
+    printf("new_position %zu\n", position);
+    printf("admit_first_waiter %d\n", query(reqs[2], position));
+    printf("waiters_admitted %zu\n", s_pool.GetWaiterCount());
+    // The next waiter moved to the head of the queue
+    printf("next_admit %d\n", query(reqs[3], position));
+    printf("next_position %zu\n", position);
+    printf("next_delay %" PRIu32 "\n", reqs[3].delay_sec);
+
+    // A requestor which is removed leaves the queue
+    s_pool.CancelWait(reqs[3].waiter);
+    printf("cancel_ticket %" PRIu32 "\n", reqs[3].waiter.mTicket);
+    query(reqs[4], position);
+    printf("cancel_position %zu\n", position);
+
+    // The waiters which do not query again before twice their delay lose their position, and the sender reserved
+    // for the third requestor is released as it did not start its transfer
+    host_test::advance_time_ms(500 * 1000);
+    printf("free_expired %zu\n", s_pool.GetFreeCount());
+    printf("admit_after_expiry %d\n", query(reqs[7], position));
+    printf("expiry_position %zu\n", position);
+    printf("admit_kept %d\n", query(reqs[6], position));
+    printf("waiters_expired %zu\n", s_pool.GetWaiterCount());
+    send_status_report(second_exchange);
+    for (requestor &req : reqs) {
+        s_pool.CancelWait(req.waiter);
+    }
+    printf("waiters_cancelled %zu\n", s_pool.GetWaiterCount());
+    return 0;
+}
+
+static int test_transfer(char **argv)
+{
+    init_pool();
+    make_image(strtoul(argv[0], nullptr, 0));
+    uint16_t block_size = static_cast<uint16_t>(strtoul(argv[1], nullptr, 0));
+    uint64_t start_offset = strtoull(argv[2], nullptr, 0);
+    s_pending_reads = atoi(argv[3]) != 0;
+
+    OtaBdxSender *sender = prepare(1, block_size);
+    ExchangeContext exchange(peer(1));
+    printf("init_result 0x%" PRIx32 "\n", send_init(exchange, start_offset).AsInteger());
+    printf("init_reply 0x%02x\n", last_sent(exchange));
+    size_t blocks = 0;
+    size_t max_blocks = s_image.size() / block_size + 2;
+    while (blocks < max_blocks && last_sent(exchange) != static_cast<uint8_t>(chip::bdx::MessageType::BlockEOF)) {
+        size_t sent = exchange.GetSentMessages().size();
+        send(exchange, {static_cast<uint8_t>(chip::bdx::MessageType::BlockQuery)});
+        host_test::run_scheduled_work();
+        if (exchange.GetSentMessages().size() != sent + 1 ||
+            last_sent(exchange) == static_cast<uint8_t>(chip::Protocols::SecureChannel::MsgType::StatusReport)) {
+            break;
+        }
+        blocks++;
+        host_test::advance_time_ms(10);
+    }
+    printf("blocks %zu\n", blocks);
+    printf("last_reply 0x%02x\n", last_sent(exchange));
+    printf("percent %u\n", sender->GetPercentComplete(s_image.size()));
+    if (last_sent(exchange) == static_cast<uint8_t>(chip::bdx::MessageType::BlockEOF)) {
+        send(exchange, {static_cast<uint8_t>(chip::bdx::MessageType::BlockAckEOF)});
+    }
+    printf("exchange_closed %d\n", exchange.IsClosed());
+    printf("completed %d\n", s_events[OtaBdxSenderPool::kTransferCompleted]);
+    printf("failed %d\n", s_events[OtaBdxSenderPool::kTransferFailed]);
+    printf("completed_bytes %" PRIu64 "\n", s_completed_bytes);
+    printf("free %zu\n", s_pool.GetFreeCount());
+    printf("open_images %zu\n", s_open_images);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 1;
+    if (argc == 2 && strcmp(argv[1], "admission") == 0) {
+        ret = test_admission();
+    } else if (argc == 2 && strcmp(argv[1], "queue") == 0) {
+        ret = test_queue();
+    } else if (argc == 6 && strcmp(argv[1], "transfer") == 0) {
+        ret = test_transfer(argv + 2);
+    } else {
+        fprintf(stderr, "Usage: %s admission\n", argv[0]);
+        fprintf(stderr, "       %s queue\n", argv[0]);
+        fprintf(stderr, "       %s transfer <image size> <block size> <start offset> <pending reads>\n", argv[0]);
+        return ret;
+    }
+    printf("mem_in_use %zu\n", host_test::mem_in_use());
+    return ret;
+}
@@ -0,0 +1,216 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the HTTP downloader of the OTA Provider on Linux against a mock server:
+//
+//     http_downloader_test <image size> <read size> <connections>...
+//
+// The connections are opened in order, the ones after the last given are served fully. A connection is:
+//
+//     ok              serve the image up to its end
+//     stall:<n>       serve n bytes, then return no data without closing the connection
+//     reset:<n>       serve n bytes, then fail the reads with ECONNRESET
+//     refuse          fail to open
+//
+// The whole image is read with reads of the given size and the result of the download is printed as '<name> <value>'
+// lines. A connection which is read without data too many times prints 'spin 1' and exits, as the download would
+// never end.
+
+#include <algorithm>
+#include <errno.h>
+#include <esp_http_client.h>
+#include <esp_matter_ota_http_downloader.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace esp_matter::ota_provider;
+
+static constexpr int k_max_zero_reads = 1000;
+
+static uint64_t s_image_size;
+static std::vector<std::string> s_connections;
+static int s_opened;
+static int s_zero_reads;
+
+static uint8_t pattern(uint64_t offset)
+{
+    return static_cast<uint8_t>(offset * 7 + (offset >> 8));
+}
+
+// Mock server
+struct esp_http_client {
+    uint64_t range_start;
+    uint64_t offset;
+    int status;
+    // Bytes served before the connection stalls or is reset, -1 if it is served fully
+    int64_t limit;
+    bool reset;
+    int zero_reads;
+};
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
+{
+    return new esp_http_client();
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value)
+{
+    if (strcmp(key, "Range") == 0) {
+        client->range_start = strtoull(value + strlen("bytes="), nullptr, 10);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_delete_header(esp_http_client_handle_t client, const char *key)
+{
+    if (strcmp(key, "Range") == 0) {
+        client->range_start = 0;
+    }
+    return ESP_OK;
+}
+
+int esp_http_client_get_post_field(esp_http_client_handle_t client, char **data)
+{
+    *data = nullptr;
+    return 0;
+}
+
+esp_err_t esp_http_client_open(esp_http_client_handle_t client, int write_len)
+{
+    std::string connection = s_opened < static_cast<int>(s_connections.size()) ? s_connections[s_opened] : "ok";
+    s_opened++;
+    if (connection == "refuse") {
+        return ESP_FAIL;
+    }
+    client->offset = client->range_start;
+    client->status = client->range_start > 0 ? 206 : HttpStatus_Ok;
+    client->limit = -1;
+    client->reset = connection.compare(0, 6, "reset:") == 0;
+    client->zero_reads = 0;
+    if (client->reset || connection.compare(0, 6, "stall:") == 0) {
+        client->limit = strtoll(connection.c_str() + 6, nullptr, 10);
+    }
+    return ESP_OK;
+}
+
+int esp_http_client_write(esp_http_client_handle_t client, const char *buffer, int len)
+{
+    return len;
+}
+
+int64_t esp_http_client_fetch_headers(esp_http_client_handle_t client)
+{
+    return static_cast<int64_t>(s_image_size - client->offset);
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client)
+{
+    return client->status;
+}
+
+esp_err_t esp_http_client_set_redirection(esp_http_client_handle_t client)
+{
+    return ESP_OK;
+}
+
+void esp_http_client_add_auth(esp_http_client_handle_t client) {}
+
+int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len)
+{
+    uint64_t end = s_image_size;
+    if (client->limit >= 0 && client->range_start + client->limit < end) {
+        end = client->range_start + client->limit;
+    }
+    int read_len = static_cast<int>(std::min<uint64_t>(len, end - client->offset));
+    if (read_len == 0) {
+        errno = client->reset ? ECONNRESET : 0;
+        s_zero_reads++;
+        if (++client->zero_reads > k_max_zero_reads) {
+            printf("spin 1\n");
+            exit(0);
+        }
+        return 0;
+    }
+    for (int index = 0; index < read_len; ++index) {
+        buffer[index] = static_cast<char>(pattern(client->offset + index));
+    }
+    client->offset += read_len;
+    return read_len;
+}
+
+bool esp_http_client_is_complete_data_received(esp_http_client_handle_t client)
+{
+    return client->offset == s_image_size;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t client)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
+{
+    delete client;
+    return ESP_OK;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <image size> <read size> <connections>...\n", argv[0]);
+        return 1;
+    }
+    s_image_size = strtoull(argv[1], nullptr, 0);
+    size_t read_size = strtoul(argv[2], nullptr, 0);
+    for (int i = 3; i < argc; ++i) {
+        s_connections.push_back(argv[i]);
+    }
+
+    esp_http_client_config_t config = {};
+    config.url = "https://example.com/image.ota";
+    http_downloader_handle_t downloader = nullptr;
+    esp_err_t err = http_downloader_start(&config, 0, &downloader);
+    uint64_t bytes = 0, mismatches = 0;
+    std::vector<char> buf(read_size);
+    while (err == ESP_OK && bytes < s_image_size) {
+        int len = http_downloader_read(downloader, buf.data(), buf.size());
+        if (len < 0) {
+            err = ESP_FAIL;
+            break;
+        }
+        for (int index = 0; index < len; ++index) {
+            mismatches += static_cast<uint8_t>(buf[index]) != pattern(bytes + index);
+        }
+        bytes += len;
+        if (static_cast<size_t>(len) < read_size) {
+            break;
+        }
+    }
+    http_downloader_abort(downloader);
+
+    printf("result 0x%x\n", err);
+    printf("bytes %" PRIu64 "\n", bytes);
+    printf("mismatches %" PRIu64 "\n", mismatches);
+    printf("connections %d\n", s_opened);
+    printf("delay_ms %" PRIu64 "\n", host_test::task_delay_ms());
+    printf("zero_reads %d\n", s_zero_reads);
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the OTA image cache of the OTA Provider on Linux, in the cache directory:
+//
+//     image_cache_test <cache directory> <operations>...
+//
+// The images are identified by their VendorID and SoftwareVersion and their content is made of them and of their
+// size, so that an image with another size has another digest. The operations are:
+//
+//     init                        initialize the cache from its directory, as after a reboot
+//     fill:<vid>:<ver>:<size>     download the image and add it to the cache
+//     open:<vid>:<ver>:<size>     open the cached image, as a BDX transfer does
+//     read:<vid>:<ver>            read the whole image opened first and check its content
+//     close:<vid>:<ver>           close the image opened first
+//     drop_index                  remove the index file
+//     index                       print whether the index file exists
+//     cached:<vid>:<ver>          print whether the image file exists
+//
+// The results are printed as '<name>_<index> <value>' lines, numbered after the operations.
+
+#include <esp_matter_ota_image_cache.h>
+#include <mbedtls/sha256.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace esp_matter::ota_provider;
+
+struct open_image {
+    ota_image_id_t id;
+    uint32_t size;
+    FILE *file;
+};
+
+static std::vector<open_image> s_open_images;
+
+static uint8_t pattern(const ota_image_id_t &id, uint32_t size, uint32_t offset)
+{
+    return static_cast<uint8_t>(id.vendor_id + id.software_version * 3 + size + offset * 7);
+}
+
+static ota_image_id_t make_id(unsigned long vendor_id, unsigned long version, uint32_t size)
+{
+    ota_image_id_t id = {static_cast<uint16_t>(vendor_id), 0x8000, static_cast<uint32_t>(version),
+                         OTA_FULL_IMAGE_BASE_VERSION, {}};
+    mbedtls_sha256_context sha256;
+    mbedtls_sha256_init(&sha256);
+    mbedtls_sha256_starts(&sha256, 0);
+    for (uint32_t offset = 0; offset < size; ++offset) {
+        uint8_t byte = pattern(id, size, offset);
+        mbedtls_sha256_update(&sha256, &byte, 1);
+    }
+    mbedtls_sha256_finish(&sha256, id.digest);
+    mbedtls_sha256_free(&sha256);
+    return id;
+}
+
+static open_image *find_open_image(unsigned long vendor_id, unsigned long version)
+{
+    for (open_image &image : s_open_images) {
+        if (image.id.vendor_id == vendor_id && image.id.software_version == version) {
+            return &image;
+        }
+    }
+    return nullptr;
+}
+
+static bool file_exists(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || chdir(argv[1]) != 0) {
+        fprintf(stderr, "Invalid cache directory\n");
+        return 1;
+    }
+    // The operations are numbered from 1
+    argc--;
+    argv++;
+    for (int i = 1; i < argc; ++i) {
+        char *op = argv[i];
+        unsigned long args[3] = {0, 0, 0};
+        char *arg = strchr(op, ':');
+        if (arg) {
+            *arg++ = '\0';
+        }
+        for (size_t j = 0; arg && j < 3; ++j) {
+            args[j] = strtoul(arg, &arg, 0);
+            arg = *arg == ':' ? arg + 1 : nullptr;
+        }
+        if (strcmp(op, "init") == 0) {
+            printf("init_%d 0x%x\n", i, image_cache_init());
+        } else if (strcmp(op, "fill") == 0) {
+            ota_image_id_t id = make_id(args[0], args[1], args[2]);
+            image_cache_fill_handle_t fill;
+            esp_err_t err = image_cache_fill_start(id, args[2], &fill);
+            for (uint32_t offset = 0; err == ESP_OK && offset < args[2]; ++offset) {
+                uint8_t byte = pattern(id, args[2], offset);
+                err = image_cache_fill_write(fill, &byte, 1);
+            }
+            if (err == ESP_OK) {
+                err = image_cache_fill_finish(fill);
+            }
+            printf("fill_%d 0x%x\n", i, err);
+        } else if (strcmp(op, "open") == 0) {
+            ota_image_id_t id = make_id(args[0], args[1], args[2]);
+            FILE *file = image_cache_open(id);
+            if (file) {
+                s_open_images.push_back({id, static_cast<uint32_t>(args[2]), file});
+            }
+            printf("open_%d %d\n", i, file != nullptr);
+        } else if (strcmp(op, "read") == 0) {
+            open_image *image = find_open_image(args[0], args[1]);
+            size_t matches = 0;
+            int byte;
+            for (uint32_t offset = 0; image && (byte = fgetc(image->file)) != EOF; ++offset) {
+                matches += byte == pattern(image->id, image->size, offset) ? 1 : 0;
+            }
+            printf("read_%d %d\n", i, image && matches == image->size);
+        } else if (strcmp(op, "close") == 0) {
+            open_image *image = find_open_image(args[0], args[1]);
+            if (image) {
+                image_cache_close(image->id, image->file);
+                s_open_images.erase(s_open_images.begin() + (image - s_open_images.data()));
+            }
+        } else if (strcmp(op, "drop_index") == 0) {
+            remove("ota_index.bin");
+        } else if (strcmp(op, "index") == 0) {
+            printf("index_%d %d\n", i, file_exists("ota_index.bin"));
+        } else if (strcmp(op, "cached") == 0) {
+            char path[64];
+            snprintf(path, sizeof(path), "ota_%04lx_8000_%08lx.bin", args[0], args[1]);
+            printf("cached_%d %d\n", i, file_exists(path));
+        } else {
+            fprintf(stderr, "Unknown operation %s\n", op);
+            return 1;
+        }
+    }
+    for (open_image &image : s_open_images) {
+        image_cache_close(image.id, image.file);
+    }
+    return 0;
+}
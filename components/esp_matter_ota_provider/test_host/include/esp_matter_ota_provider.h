@@ -0,0 +1,55 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the declarations of esp_matter_ota_provider.h used by the image sources and the OTA candidates cache,
+// without the Matter stack
+
+#pragma once
+
+#include <stdint.h>
+
+#define SOFTWARE_VERSION_STR_MAX_LEN 64
+#define OTA_URL_MAX_LEN 256
+#define OTA_IMAGE_DIGEST_LEN 32
+
+namespace esp_matter {
+namespace ota_provider {
+
+typedef struct {
+    // QueryImage commands answered from the OTA candidates cache, with an update or with no update
+    uint32_t hits;
+    uint32_t negative_hits;
+    // QueryImage commands which queried the DCL
+    uint32_t misses;
+    // HTTP requests sent to the DCL, and the ones which failed
+    uint32_t dcl_requests;
+    uint32_t dcl_failures;
+    uint32_t evictions;
+    // Count of the entries in the cache
+    uint32_t entries;
+} ota_candidates_stats_t;
+
+void get_ota_candidates_stats(ota_candidates_stats_t *stats);
+
+class EspOtaProvider {
+public:
+    enum class OTAQueryStatus : uint8_t {
+        kUpdateAvailable = 0,
+        kBusy = 1,
+        kNotAvailable = 2,
+    };
+};
+
+} // namespace ota_provider
+} // namespace esp_matter
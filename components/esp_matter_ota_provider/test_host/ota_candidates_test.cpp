@@ -0,0 +1,252 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Runs the OTA candidates cache of the DCL image source on Linux:
+//
+//     ota_candidates_test <nvs directory> <operations>...
+//
+// The cache is kept in the NVS directory, so that a second run with the same directory starts with the cache saved
+// by the first one, as after a reboot. The operations are:
+//
+//     time:<seconds>                          set the time since boot, 0 before the first one
+//     model:<vendor>:<product>:<versions>     publish the comma separated software versions of a model on the mock
+//                                             DCL, each version updates all the lower versions
+//     dcl:<mode>                              answer the DCL requests (ok), fail them all (down) or fail the requests
+//                                             of the model versions (versions_down)
+//     init                                    initialize the cache, which loads it from NVS
+//     query:<vendor>:<product>:<version>      query the DCL image source for the update of the software version
+//
+// The results are printed as '<name> <value>' lines, numbered after the operations, and the statistics of the cache
+// at the end.
+
+#include <esp_crt_bundle.h>
+#include <esp_http_client.h>
+#include <esp_matter_ota_candidates.h>
+#include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_image_source.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <map>
+#include <nvs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace esp_matter::ota_provider;
+
+static std::map<uint32_t, std::vector<uint32_t>> s_models;
+static std::string s_dcl_mode = "ok";
+
+static uint32_t model_key(uint16_t vendor_id, uint16_t product_id)
+{
+    return (static_cast<uint32_t>(vendor_id) << 16) | product_id;
+}
+
+// Mock DCL
+struct esp_http_client {
+    std::string url;
+    int status;
+    std::string response;
+};
+
+static void serve_dcl_request(esp_http_client *client)
+{
+    static const char versions_path[] = "/dcl/model/versions/";
+    client->status = HttpStatus_NotFound;
+    client->response = "{\"code\":5,\"message\":\"not found\"}";
+    size_t pos = client->url.find(versions_path);
+    if (pos == std::string::npos) {
+        return;
+    }
+    unsigned vendor_id = 0, product_id = 0, version = 0;
+    int fields = sscanf(client->url.c_str() + pos + strlen(versions_path), "%u/%u/%u", &vendor_id, &product_id,
+                        &version);
+    auto model = s_models.find(model_key(vendor_id, product_id));
+    if (fields < 2 || model == s_models.end()) {
+        return;
+    }
+    if (fields == 2) {
+        client->status = HttpStatus_Ok;
+        client->response = "{\"modelVersions\":{\"vid\":" + std::to_string(vendor_id) +
+            ",\"pid\":" + std::to_string(product_id) + ",\"softwareVersions\":[";
+        for (size_t index = 0; index < model->second.size(); ++index) {
+            client->response += (index ? "," : "") + std::to_string(model->second[index]);
+        }
+        client->response += "]}}";
+        return;
+    }
+    for (uint32_t published : model->second) {
+        if (published != version) {
+            continue;
+        }
+        if (s_dcl_mode == "versions_down") {
+            client->status = HttpStatus_InternalError;
+            client->response = "{}";
+            return;
+        }
+        std::string number = std::to_string(version);
+        client->status = HttpStatus_Ok;
+        client->response = "{\"modelVersion\":{\"vid\":" + std::to_string(vendor_id) +
+            ",\"pid\":" + std::to_string(product_id) + ",\"softwareVersion\":" + number +
+            ",\"softwareVersionString\":\"" + number + ".0\",\"cdVersionNumber\":1,\"softwareVersionValid\":true," +
+            "\"otaUrl\":\"https://example.com/v" + number + ".ota\",\"otaFileSize\":\"1000\"," +
+            "\"minApplicableSoftwareVersion\":0,\"maxApplicableSoftwareVersion\":" + std::to_string(version - 1) +
+            "}}";
+        return;
+    }
+}
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
+{
+    esp_http_client *client = new esp_http_client();
+    client->url = config->url;
+    return client;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_client_method_t method)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_open(esp_http_client_handle_t client, int write_len)
+{
+    if (s_dcl_mode == "down") {
+        return ESP_FAIL;
+    }
+    serve_dcl_request(client);
+    return ESP_OK;
+}
+
+int64_t esp_http_client_fetch_headers(esp_http_client_handle_t client)
+{
+    return static_cast<int64_t>(client->response.size());
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client)
+{
+    return client->status;
+}
+
+int esp_http_client_read_response(esp_http_client_handle_t client, char *buffer, int len)
+{
+    // The sources terminate the response after the bytes read
+    int read_len = static_cast<int>(client->response.size()) < len - 1 ? static_cast<int>(client->response.size())
+                                                                          : len - 1;
+    memcpy(buffer, client->response.data(), read_len);
+    return read_len;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t client)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
+{
+    delete client;
+    return ESP_OK;
+}
+
+esp_err_t esp_crt_bundle_attach(void *conf)
+{
+    return ESP_OK;
+}
+
+// The images are never downloaded in these tests
+esp_err_t esp_matter::ota_provider::http_downloader_start(esp_http_client_config_t *config, uint64_t offset,
+                                                          http_downloader_handle_t *downloader)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+int esp_matter::ota_provider::http_downloader_read(http_downloader_handle_t downloader, char *buf, size_t size)
+{
+    return -1;
+}
+
+void esp_matter::ota_provider::http_downloader_abort(http_downloader_handle_t downloader) {}
+
+const ota_image_source_t *esp_matter::ota_provider::get_ota_image_source()
+{
+    return get_dcl_image_source();
+}
+
+static void print_stats()
+{
+    ota_candidates_stats_t stats;
+    get_ota_candidates_stats(&stats);
+    printf("hits %" PRIu32 "\n", stats.hits);
+    printf("negative_hits %" PRIu32 "\n", stats.negative_hits);
+    printf("misses %" PRIu32 "\n", stats.misses);
+    printf("dcl_requests %" PRIu32 "\n", stats.dcl_requests);
+    printf("dcl_failures %" PRIu32 "\n", stats.dcl_failures);
+    printf("evictions %" PRIu32 "\n", stats.evictions);
+    printf("entries %" PRIu32 "\n", stats.entries);
+    printf("nvs_writes %zu\n", host_test::nvs_write_count());
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <nvs directory> <operations>...\n", argv[0]);
+        return 1;
+    }
+    host_test::set_nvs_dir(argv[1]);
+    const ota_image_source_t *source = get_dcl_image_source();
+    for (int index = 2; index < argc; ++index) {
+        const char *op = argv[index];
+        int number = index - 1;
+        unsigned vendor_id = 0, product_id = 0, version = 0;
+        char versions[256];
+        if (strncmp(op, "time:", 5) == 0) {
+            host_test::set_timer_time_us(strtoll(op + 5, nullptr, 0) * 1000000);
+        } else if (strncmp(op, "dcl:", 4) == 0) {
+            s_dcl_mode = op + 4;
+        } else if (strcmp(op, "init") == 0) {
+            printf("init_%d 0x%x\n", number, init_ota_candidates());
+        } else if (sscanf(op, "model:%u:%u:%255s", &vendor_id, &product_id, versions) == 3) {
+            std::vector<uint32_t> &model = s_models[model_key(vendor_id, product_id)];
+            model.clear();
+            for (char *token = strtok(versions, ","); token; token = strtok(nullptr, ",")) {
+                model.push_back(strtoul(token, nullptr, 0));
+            }
+        } else if (sscanf(op, "query:%u:%u:%u", &vendor_id, &product_id, &version) == 3) {
+            ota_candidates_stats_t stats;
+            get_ota_candidates_stats(&stats);
+            uint32_t requests = stats.dcl_requests;
+            ota_image_info_t info;
+            esp_err_t err = source->query_image(source->ctx, vendor_id, product_id, version, &info);
+            get_ota_candidates_stats(&stats);
+            printf("query_%d 0x%x\n", number, err);
+            printf("requests_%d %" PRIu32 "\n", number, stats.dcl_requests - requests);
+            if (err == ESP_OK) {
+                printf("version_%d %" PRIu32 "\n", number, info.software_version);
+                printf("size_%d %" PRIu64 "\n", number, info.ota_file_size);
+            }
+        } else {
+            fprintf(stderr, "Invalid operation %s\n", op);
+            return 1;
+        }
+    }
+    print_stats();
+    return 0;
+}
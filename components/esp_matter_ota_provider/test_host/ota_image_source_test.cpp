@@ -0,0 +1,168 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Queries and reads the OTA image sources on Linux:
+//
+//     ota_image_source_test local <directory> <vendor id> <product id> <software version> <offset>
+//     ota_image_source_test memory <vendor id> <product id> <software version> <offset>
+//
+// The source is created, queried for the update of the software version, and the image found is read from the offset.
+// The results are printed as '<name> <value>' lines. The memory source serves the images of memory_images.
+
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_image_source.h>
+#include <inttypes.h>
+#include <mbedtls/sha256.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace esp_matter::ota_provider;
+
+static uint8_t image_v2[5000];
+static uint8_t image_v3[3000];
+static uint8_t image_v4[1000];
+
+static const ota_memory_image_t memory_images[] = {
+    {0xFFF1, 0x8000, 2, "2.0", 0, 1, image_v2, sizeof(image_v2)},
+    {0xFFF1, 0x8000, 3, "3.0", 1, 2, image_v3, sizeof(image_v3)},
+    {0xFFF1, 0x8000, 4, "4.0", 0, 1, image_v4, sizeof(image_v4)},
+    {0xFFF1, 0x8001, 7, nullptr, 0, 6, image_v4, sizeof(image_v4)},
+};
+
+// The images are never needed from the DCL in these tests
+const ota_image_source_t *esp_matter::ota_provider::get_dcl_image_source()
+{
+    return nullptr;
+}
+
+static void print_digest(const char *name, const uint8_t *digest)
+{
+    printf("%s 0x", name);
+    for (size_t index = 0; index < OTA_IMAGE_DIGEST_LEN; ++index) {
+        printf("%02x", digest[index]);
+    }
+    printf("\n");
+}
+
+static void query_and_read(const ota_image_source_t *source, uint16_t vendor_id, uint16_t product_id,
+                           uint32_t software_version, uint64_t offset)
+{
+    ota_image_info_t info;
+    esp_err_t err = source->query_image(source->ctx, vendor_id, product_id, software_version, &info);
+    printf("result 0x%x\n", err);
+    if (err != ESP_OK) {
+        return;
+    }
+    printf("software_version %" PRIu32 "\n", info.software_version);
+    printf("software_version_str %s\n", info.software_version_str);
+    printf("ota_url %s\n", info.ota_url);
+    printf("ota_file_size %" PRIu64 "\n", info.ota_file_size);
+    printf("has_ota_digest %d\n", info.has_ota_digest);
+    if (info.has_ota_digest) {
+        print_digest("ota_digest", info.ota_digest);
+    }
+
+    // Read the image as the read-ahead task does, in blocks
+    void *reader = nullptr;
+    err = source->open_image(source->ctx, info.ota_url, offset, &reader);
+    printf("open_result 0x%x\n", err);
+    if (err != ESP_OK) {
+        return;
+    }
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    uint8_t buf[1024];
+    uint64_t read_len = 0;
+    int len;
+    while ((len = source->read_image(reader, buf, sizeof(buf))) > 0) {
+        mbedtls_sha256_update(&sha, buf, len);
+        read_len += len;
+        if (static_cast<size_t>(len) < sizeof(buf)) {
+            break;
+        }
+    }
+    printf("read_len %" PRIu64 "\n", read_len);
+    printf("read_end %d\n", source->read_image(reader, buf, sizeof(buf)));
+    source->close_image(reader);
+    uint8_t digest[OTA_IMAGE_DIGEST_LEN];
+    mbedtls_sha256_finish(&sha, digest);
+    mbedtls_sha256_free(&sha);
+    print_digest("read_digest", digest);
+}
+
+static int test_local(char **args)
+{
+    ota_image_source_t *source = nullptr;
+    esp_err_t err = local_image_source_create(args[0], &source);
+    printf("create_result 0x%x\n", err);
+    if (err == ESP_OK) {
+        query_and_read(source, strtoul(args[1], nullptr, 0), strtoul(args[2], nullptr, 0),
+                       strtoul(args[3], nullptr, 0), strtoull(args[4], nullptr, 0));
+        local_image_source_destroy(source);
+    }
+    return 0;
+}
+
+static int test_memory(char **args)
+{
+    for (size_t index = 0; index < sizeof(image_v2); ++index) {
+        image_v2[index] = index * 7;
+    }
+    for (size_t index = 0; index < sizeof(image_v3); ++index) {
+        image_v3[index] = index * 3;
+    }
+    for (size_t index = 0; index < sizeof(image_v4); ++index) {
+        image_v4[index] = index * 5;
+    }
+    ota_image_source_t *source = nullptr;
+    esp_err_t err = memory_image_source_create(memory_images, sizeof(memory_images) / sizeof(memory_images[0]),
+                                               &source);
+    printf("create_result 0x%x\n", err);
+    if (err != ESP_OK) {
+        return 0;
+    }
+    query_and_read(source, strtoul(args[0], nullptr, 0), strtoul(args[1], nullptr, 0), strtoul(args[2], nullptr, 0),
+                   strtoull(args[3], nullptr, 0));
+    // The URLs which are not the ones of the images of the source
+    void *reader = nullptr;
+    printf("open_bad_index 0x%x\n", source->open_image(source->ctx, "mem/9/ota_fff1_8000_00000002.ota", 0, &reader));
+    printf("open_bad_url 0x%x\n", source->open_image(source->ctx, "https://example.com/light-v2.ota", 0, &reader));
+    printf("open_bad_offset 0x%x\n", source->open_image(source->ctx, "mem/0/light.ota", sizeof(image_v2) + 1,
+                                                         &reader));
+    memory_image_source_destroy(source);
+
+    // An image without data is rejected
+    ota_memory_image_t empty = memory_images[0];
+    empty.data = nullptr;
+    printf("create_no_data 0x%x\n", memory_image_source_create(&empty, 1, &source));
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 1;
+    if (argc == 7 && strcmp(argv[1], "local") == 0) {
+        ret = test_local(argv + 2);
+    } else if (argc == 6 && strcmp(argv[1], "memory") == 0) {
+        ret = test_memory(argv + 2);
+    } else {
+        fprintf(stderr, "Usage: %s local <directory> <vendor id> <product id> <software version> <offset>\n", argv[0]);
+        fprintf(stderr, "       %s memory <vendor id> <product id> <software version> <offset>\n", argv[0]);
+        return ret;
+    }
+    printf("mem_in_use %zu\n", host_test::mem_in_use());
+    return ret;
+}
@@ -0,0 +1,174 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""
+Host test of the BDX sender pool of the OTA Provider built for Linux: admission of the Requestors, queue of the busy
+Requestors and BDX transfers
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_ota_provider/test_host
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+MAX_SESSIONS = 2
+MIN_FREE_HEAP = 49152
+QUERY_DELAY_SEC = 120
+# The BDX message types sent by the pool
+RECEIVE_ACCEPT = 0x05
+BLOCK_EOF = 0x12
+STATUS_REPORT = 0x40
+CHIP_ERROR_INCORRECT_STATE = 0x03
+
+
+@pytest.fixture(scope='module')
+def bdx_sender_pool(tmp_path_factory):
+    output = tmp_path_factory.mktemp('bdx_sender_pool') / 'bdx_sender_pool_test'
+    provider_dir = host_test.COMPONENTS_DIR / 'esp_matter_ota_provider'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'bdx_sender_pool_test.cpp',
+                            provider_dir / 'src' / 'esp_matter_ota_bdx_sender.cpp',
+                            host_test.COMPONENTS_DIR / 'esp_matter' / 'esp_matter_ota_transfer_stats.cpp'],
+                           [CURRENT_DIR / 'include', provider_dir / 'include', provider_dir / 'private_include',
+                            host_test.COMPONENTS_DIR / 'esp_matter'],
+                           chip=True,
+                           defines=[f'CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MAX_SESSIONS={MAX_SESSIONS}',
+                                    f'CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MIN_FREE_HEAP={MIN_FREE_HEAP}',
+                                    'CONFIG_ESP_MATTER_OTA_TRANSFER_STALL_THRESHOLD_MS=2000'])
+
+
+def test_admission(bdx_sender_pool):
+    results = host_test.run(bdx_sender_pool, 'admission')
+    assert results['max_sessions'] == MAX_SESSIONS
+    assert results['acquire_first'] == 1
+    assert results['acquire_second'] == 1
+    # All the senders are reserved
+    assert results['acquire_full'] == 0
+    assert results['free_full'] == 0
+    # A node querying again restarts on its sender, the senders are found by fabric and node
+    assert results['acquire_again'] == 1
+    assert results['find_second'] == 1
+    assert results['find_other_fabric'] == 0
+    assert results['init_unknown'] == CHIP_ERROR_INCORRECT_STATE
+    assert results['init_result'] == 0
+    assert results['init_reply'] == RECEIVE_ACCEPT
+    # The sender of the node which did not start its transfer is reused after the reservation timeout
+    assert results['free_expired'] == 1
+    assert results['acquire_expired'] == 1
+    assert results['find_expired'] == 0
+    # A started transfer keeps its sender past the reservation timeout, until the Requestor aborts it
+    assert results['free_started'] == 1
+    assert results['status_result'] == 0
+    assert results['exchange_closed'] == 1
+    assert results['free_aborted'] == MAX_SESSIONS
+    assert results['open_images'] == 0
+    assert results['started'] == 1
+    assert results['failed'] == 1
+    assert results['mem_in_use'] == 0
+
+
+def test_admission_heap_guard(bdx_sender_pool):
+    results = host_test.run(bdx_sender_pool, 'admission')
+    # No new transfer below the minimum free heap, the node which has a sender still restarts on it
+    assert results['acquire_low_heap'] == 0
+    assert results['acquire_low_heap_again'] == 1
+    assert results['acquire_heap'] == 1
+
+
+def test_busy_queue_delays(bdx_sender_pool):
+    results = host_test.run(bdx_sender_pool, 'queue')
+    assert results['admit_1'] == 1
+    assert results['admit_2'] == 1
+    # The delay grows by the query delay for each MAX_SESSIONS Requestors queued before
+    for node, position in [(3, 0), (4, 1), (5, 2), (6, 3), (7, 4)]:
+        assert results[f'admit_{node}'] == 0
+        assert results[f'position_{node}'] == position
+        assert results[f'delay_{node}'] == QUERY_DELAY_SEC * (1 + position // MAX_SESSIONS)
+    assert results['waiters'] == 5
+    # A Requestor querying again within twice its delay keeps its position
+    assert results['requery_position'] == 2
+    assert results['requery_delay'] == 2 * QUERY_DELAY_SEC
+    assert results['mem_in_use'] == 0
+
+
+def test_busy_queue_fairness(bdx_sender_pool):
+    results = host_test.run(bdx_sender_pool, 'queue')
+    assert results['free_one'] == 1
+    # The free sender is kept for the Requestor at the head of the queue, neither a later waiter nor a new Requestor
+    # takes it
+    assert results['admit_later'] == 0
+    assert results['admit_new'] == 0
+    assert results['new_position'] == 5
+    assert results['admit_first_waiter'] == 1
+    assert results['waiters_admitted'] == 5
+    assert results['next_admit'] == 0
+    assert results['next_position'] == 0
+    assert results['next_delay'] == QUERY_DELAY_SEC
+    # A removed Requestor leaves the queue
+    assert results['cancel_ticket'] == 0
+    assert results['cancel_position'] == 0
+
+
+def test_busy_queue_expiry(bdx_sender_pool):
+    results = host_test.run(bdx_sender_pool, 'queue')
+    assert results['free_expired'] == 1
+    # The waiters which did not query again are dropped, the ones within twice their delay keep their order
+    assert results['admit_after_expiry'] == 0
+    assert results['expiry_position'] == 1
+    assert results['admit_kept'] == 1
+    assert results['waiters_expired'] == 1
+    assert results['waiters_cancelled'] == 0
+    assert results['mem_in_use'] == 0
+
+
+@pytest.mark.parametrize('image_size, block_size, start_offset, pending_reads, blocks', [
+    (5000, 1024, 0, 0, 5),
+    (4096, 1024, 0, 0, 4),
+    (5000, 1024, 0, 1, 5),
+    (5000, 256, 2048, 0, 12),
+])
+def test_transfer(bdx_sender_pool, image_size, block_size, start_offset, pending_reads, blocks):
+    results = host_test.run(bdx_sender_pool, 'transfer', image_size, block_size, start_offset, pending_reads)
+    assert results['init_reply'] == RECEIVE_ACCEPT
+    assert results['blocks'] == blocks
+    assert results['last_reply'] == BLOCK_EOF
+    assert results['percent'] == 100
+    assert results['exchange_closed'] == 1
+    assert results['completed'] == 1
+    assert results['failed'] == 0
+    assert results['completed_bytes'] == image_size - start_offset
+    # The sender and the image are released at the end of the transfer
+    assert results['free'] == MAX_SESSIONS
+    assert results['open_images'] == 0
+    assert results['mem_in_use'] == 0
+
+
+def test_transfer_invalid_header(bdx_sender_pool):
+    # The image is shorter than its header
+    results = host_test.run(bdx_sender_pool, 'transfer', 20, 1024, 0, 0)
+    assert results['blocks'] == 0
+    assert results['last_reply'] == STATUS_REPORT
+    assert results['completed'] == 0
+    assert results['failed'] == 1
+    assert results['free'] == MAX_SESSIONS
+    assert results['open_images'] == 0
+    assert results['mem_in_use'] == 0
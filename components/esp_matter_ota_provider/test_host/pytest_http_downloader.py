@@ -0,0 +1,109 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""
+Host test of the HTTP downloader of the OTA Provider built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_ota_provider/test_host
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+RESUME_RETRIES = 3
+RESUME_DELAY_MS = 100
+IMAGE_SIZE = 10000
+READ_SIZE = 1024
+ESP_OK = 0
+ESP_FAIL = 0xffffffff
+
+
+@pytest.fixture(scope='module')
+def http_downloader(tmp_path_factory):
+    output = tmp_path_factory.mktemp('http_downloader') / 'http_downloader_test'
+    provider_dir = host_test.COMPONENTS_DIR / 'esp_matter_ota_provider'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'http_downloader_test.cpp',
+                            provider_dir / 'src' / 'esp_matter_ota_http_downloader.cpp'],
+                           [provider_dir / 'private_include', host_test.COMPONENTS_DIR / 'esp_matter'],
+                           defines=[f'CONFIG_ESP_MATTER_OTA_PROVIDER_HTTP_RESUME_RETRIES={RESUME_RETRIES}',
+                                    f'CONFIG_ESP_MATTER_OTA_PROVIDER_HTTP_RESUME_DELAY_MS={RESUME_DELAY_MS}'])
+
+
+def download(http_downloader, *connections):
+    results = host_test.run(http_downloader, IMAGE_SIZE, READ_SIZE, *connections)
+    assert 'spin' not in results, 'the downloader reads a stalled connection without end'
+    return results
+
+
+def assert_downloaded(results):
+    assert results['result'] == ESP_OK
+    assert results['bytes'] == IMAGE_SIZE
+    assert results['mismatches'] == 0
+
+
+def test_download(http_downloader):
+    results = download(http_downloader, 'ok')
+    assert_downloaded(results)
+    assert results['connections'] == 1
+    assert results['delay_ms'] == 0
+
+
+@pytest.mark.parametrize('lost', ['stall', 'reset'])
+def test_resume_after_lost_connection(http_downloader, lost):
+    results = download(http_downloader, f'{lost}:3000', 'ok')
+    assert_downloaded(results)
+    assert results['connections'] == 2
+    assert results['delay_ms'] == RESUME_DELAY_MS
+    # The first read without data reconnects
+    assert results['zero_reads'] == 1
+
+
+@pytest.mark.parametrize('lost', ['stall', 'reset'])
+def test_fail_after_retries_without_progress(http_downloader, lost):
+    results = download(http_downloader, f'{lost}:3000', *[f'{lost}:0'] * RESUME_RETRIES)
+    assert results['result'] == ESP_FAIL
+    assert results['bytes'] < IMAGE_SIZE
+    assert results['connections'] == 1 + RESUME_RETRIES
+    # The delay grows with each retry
+    assert results['delay_ms'] == RESUME_DELAY_MS * sum(range(1, RESUME_RETRIES + 1))
+
+
+def test_progress_resets_retries(http_downloader):
+    stalls = RESUME_RETRIES + 2
+    results = download(http_downloader, *['stall:1000'] * stalls, 'ok')
+    assert_downloaded(results)
+    assert results['connections'] == stalls + 1
+    assert results['delay_ms'] == RESUME_DELAY_MS * stalls
+
+
+def test_refused_reconnection_backs_off(http_downloader):
+    results = download(http_downloader, 'stall:3000', 'refuse', 'ok')
+    assert_downloaded(results)
+    assert results['connections'] == 3
+    assert results['delay_ms'] == RESUME_DELAY_MS * 3
+
+
+def test_fail_when_reconnections_are_refused(http_downloader):
+    results = download(http_downloader, 'stall:3000', *['refuse'] * RESUME_RETRIES)
+    assert results['result'] == ESP_FAIL
+    assert results['connections'] == 1 + RESUME_RETRIES
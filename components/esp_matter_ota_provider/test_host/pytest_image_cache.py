@@ -0,0 +1,121 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+"""
+Host test of the OTA image cache of the OTA Provider built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_ota_provider/test_host
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+MAX_IMAGES = 3
+MAX_SIZE_KB = 16
+SIZE = 1000
+ESP_OK = 0
+ESP_FAIL = 0xffffffff
+ESP_ERR_INVALID_STATE = 0x103
+
+
+@pytest.fixture(scope='module')
+def image_cache(tmp_path_factory):
+    output = tmp_path_factory.mktemp('image_cache') / 'image_cache_test'
+    provider_dir = host_test.COMPONENTS_DIR / 'esp_matter_ota_provider'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'image_cache_test.cpp',
+                            provider_dir / 'src' / 'esp_matter_ota_image_cache.cpp'],
+                           [provider_dir / 'include', provider_dir / 'private_include',
+                            host_test.COMPONENTS_DIR / 'esp_matter'],
+                           chip=True,
+                           # The test runs in the cache directory
+                           defines=['CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PATH="."',
+                                    f'CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_MAX_IMAGES={MAX_IMAGES}',
+                                    f'CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_MAX_SIZE_KB={MAX_SIZE_KB}',
+                                    'CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_MAX_SESSIONS=2'])
+
+
+def fill(*versions):
+    return [f'fill:1:{version}:{SIZE}' for version in versions]
+
+
+def test_open_does_not_save_index(image_cache, tmp_path):
+    results = host_test.run(image_cache, tmp_path, 'init', *fill(1), 'drop_index', f'open:1:1:{SIZE}', 'read:1:1',
+                            'close:1:1', f'open:1:1:{SIZE}', 'close:1:1', 'index', *fill(2), 'index')
+    assert results['open_4'] == 1
+    assert results['read_5'] == 1
+    assert results['index_9'] == 0
+    # The index is saved when an image is inserted
+    assert results['fill_10'] == ESP_OK
+    assert results['index_11'] == 1
+
+
+def test_lru_saved_with_next_insertion(image_cache, tmp_path):
+    # The use of the image 1 is saved with the insertion of the image 4, which evicts the image 2 instead
+    results = host_test.run(image_cache, tmp_path, 'init', *fill(1, 2, 3), f'open:1:1:{SIZE}', 'close:1:1',
+                            *fill(4), 'cached:1:1', 'cached:1:2')
+    assert results['fill_7'] == ESP_OK
+    assert results['cached_8'] == 1
+    assert results['cached_9'] == 0
+    # After a reboot, the image 3 is the least recently used
+    results = host_test.run(image_cache, tmp_path, 'init', *fill(5), 'cached:1:1', 'cached:1:3', 'cached:1:4')
+    assert results['fill_2'] == ESP_OK
+    assert results['cached_3'] == 1
+    assert results['cached_4'] == 0
+    assert results['cached_5'] == 1
+
+
+def test_open_image_not_evicted(image_cache, tmp_path):
+    results = host_test.run(image_cache, tmp_path, 'init', *fill(1, 2, 3), f'open:1:1:{SIZE}', f'open:1:2:{SIZE}',
+                            'close:1:2', f'open:1:3:{SIZE}', 'close:1:3', *fill(4), 'cached:1:1', 'cached:1:2',
+                            'read:1:1')
+    # The image 1 is the least recently used but a transfer still reads it
+    assert results['fill_10'] == ESP_OK
+    assert results['cached_11'] == 1
+    assert results['cached_12'] == 0
+    assert results['read_13'] == 1
+
+
+def test_all_images_open(image_cache, tmp_path):
+    opens = [f'open:1:{version}:{SIZE}' for version in (1, 2, 3)]
+    results = host_test.run(image_cache, tmp_path, 'init', *fill(1, 2, 3), *opens, *fill(4), 'cached:1:4',
+                            'close:1:1', *fill(4), 'cached:1:1', 'cached:1:4')
+    assert results['fill_8'] == ESP_FAIL
+    assert results['cached_9'] == 0
+    assert results['fill_11'] == ESP_OK
+    assert results['cached_12'] == 0
+    assert results['cached_13'] == 1
+
+
+def test_open_image_not_replaced(image_cache, tmp_path):
+    # The image is republished with another content while a transfer reads the previous one
+    results = host_test.run(image_cache, tmp_path, 'init', *fill(1), f'open:1:1:{SIZE}', f'open:1:1:{SIZE + 1}',
+                            f'fill:1:1:{SIZE + 1}', 'read:1:1', 'close:1:1', f'fill:1:1:{SIZE + 1}',
+                            f'open:1:1:{SIZE + 1}', f'open:1:1:{SIZE}')
+    assert results['open_3'] == 1
+    assert results['open_4'] == 0
+    assert results['fill_5'] == ESP_ERR_INVALID_STATE
+    assert results['read_6'] == 1
+    assert results['fill_8'] == ESP_OK
+    assert results['open_9'] == 1
+    assert results['open_10'] == 0
@@ -0,0 +1,243 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+"""
+Host test of the OTA candidates cache of the DCL image source built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_ota_provider/test_host
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+MAX_CANDIDATES = 4
+# The hash table of the cache has twice the entries, rounded up to a power of two
+TABLE_SIZE = 8
+TTL_HOURS = 24
+TTL_S = TTL_HOURS * 3600
+NEGATIVE_TTL_MINUTES = 10
+NEGATIVE_TTL_S = NEGATIVE_TTL_MINUTES * 60
+VENDOR_ID = 0xFFF1
+ESP_OK = 0
+ESP_FAIL = 0xffffffff
+ESP_ERR_NOT_FOUND = 0x105
+
+
+@pytest.fixture(scope='module')
+def ota_candidates(tmp_path_factory):
+    output = tmp_path_factory.mktemp('ota_candidates') / 'ota_candidates_test'
+    provider_dir = host_test.COMPONENTS_DIR / 'esp_matter_ota_provider'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'ota_candidates_test.cpp',
+                            provider_dir / 'src' / 'esp_matter_ota_candidates.cpp'],
+                           [CURRENT_DIR / 'include', provider_dir / 'include', provider_dir / 'private_include',
+                            host_test.HOST_TEST_DIR / 'chip' / 'lib'],
+                           chip=True,
+                           defines=['CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_MAINNET=1',
+                                    f'CONFIG_ESP_MATTER_MAX_OTA_CANDIDATES_COUNT={MAX_CANDIDATES}',
+                                    f'CONFIG_ESP_MATTER_OTA_CANDIDATES_TTL={TTL_HOURS}',
+                                    f'CONFIG_ESP_MATTER_OTA_CANDIDATES_NEGATIVE_TTL={NEGATIVE_TTL_MINUTES}',
+                                    'CONFIG_ESP_MATTER_NVS_PART_NAME="nvs"'],
+                           # ESP-IDF builds with -Wno-sign-compare, the int32_t arguments of the logs are long on the
+                           # ESP32 targets
+                           cflags=['-Wno-sign-compare', '-Wno-format'])
+
+
+def home_slot(vendor_id, product_id):
+    # The hash of the cache
+    key = (vendor_id << 16) | product_id
+    key = ((key ^ (key >> 16)) * 0x45d9f3b) & 0xffffffff
+    key ^= key >> 16
+    return key & (TABLE_SIZE - 1)
+
+
+def products_with_home(slot, count, start=0x8000):
+    products = []
+    product_id = start
+    while len(products) < count:
+        if home_slot(VENDOR_ID, product_id) == slot:
+            products.append(product_id)
+        product_id += 1
+    return products
+
+
+def model(product_id, versions='1,2,3'):
+    return f'model:{VENDOR_ID}:{product_id}:{versions}'
+
+
+def query(product_id, version=1):
+    return f'query:{VENDOR_ID}:{product_id}:{version}'
+
+
+def run(ota_candidates, nvs_dir, *operations):
+    return host_test.run(ota_candidates, nvs_dir, *operations)
+
+
+def test_cache_hit(ota_candidates, tmp_path):
+    results = run(ota_candidates, tmp_path, 'init', model(0x8000), query(0x8000), query(0x8000))
+    assert results['init_1'] == ESP_OK
+    # The versions of the model, then the highest version
+    assert results['query_3'] == ESP_OK
+    assert results['requests_3'] == 2
+    assert results['version_3'] == 3
+    assert results['size_3'] == 1000
+    assert results['query_4'] == ESP_OK
+    assert results['requests_4'] == 0
+    assert results['version_4'] == 3
+    assert results['hits'] == 1
+    assert results['misses'] == 1
+    assert results['entries'] == 1
+
+
+@pytest.mark.parametrize('slot', [
+    3,
+    # The probe sequence wraps around the end of the table
+    TABLE_SIZE - 1,
+])
+def test_delete_backward_shift(ota_candidates, tmp_path, slot):
+    first, last = products_with_home(slot, 2)
+    next_home = products_with_home((slot + 1) % TABLE_SIZE, 1)[0]
+    # The first product is not on the DCL, it is cached as negative. The product with the next home slot is probed
+    # after the first one and stays in its home slot, the last one is moved back into the slot of the first one.
+    operations = ['init', model(next_home), model(last), query(first), query(next_home), query(last)]
+    operations += [f'time:{NEGATIVE_TTL_S}', 'dcl:down', query(first), 'dcl:ok', query(next_home), query(last)]
+    results = run(ota_candidates, tmp_path, *operations)
+    assert results['query_4'] == ESP_ERR_NOT_FOUND
+    # The expired negative entry is deleted, and not cached again as the DCL is down
+    assert results['query_9'] == ESP_FAIL
+    assert results['entries'] == 2
+    # The following entries of the probe sequence are still found
+    for number in [11, 12]:
+        assert results[f'query_{number}'] == ESP_OK
+        assert results[f'requests_{number}'] == 0
+    assert results['hits'] == 2
+
+
+def test_lru_eviction(ota_candidates, tmp_path):
+    products = list(range(0x8000, 0x8000 + MAX_CANDIDATES + 1))
+    operations = ['init'] + [model(product_id) for product_id in products]
+    operations += [query(product_id) for product_id in products[:MAX_CANDIDATES]]
+    # The first product is used again, the second one is the least recently used
+    operations += [query(products[0]), query(products[-1]), query(products[0]), query(products[1])]
+    results = run(ota_candidates, tmp_path, *operations)
+    first = len(products) + MAX_CANDIDATES + 2
+    assert results[f'requests_{first}'] == 0
+    assert results[f'requests_{first + 1}'] == 2
+    assert results[f'requests_{first + 2}'] == 0
+    assert results[f'requests_{first + 3}'] == 2
+    assert results['evictions'] == 2
+    assert results['entries'] == MAX_CANDIDATES
+
+
+def test_ttl(ota_candidates, tmp_path):
+    results = run(ota_candidates, tmp_path, 'init', model(0x8000), query(0x8000), f'time:{TTL_S - 1}', query(0x8000),
+                  f'time:{TTL_S}', query(0x8000))
+    assert results['requests_5'] == 0
+    # The expired update is queried again
+    assert results['query_7'] == ESP_OK
+    assert results['requests_7'] == 2
+    assert results['entries'] == 1
+
+
+def test_negative_ttl(ota_candidates, tmp_path):
+    operations = ['init', model(0x8000)]
+    # No update for the highest version, nor for a model which is not on the DCL
+    operations += [query(0x8000, 3), query(0x8001)]
+    operations += [f'time:{NEGATIVE_TTL_S - 1}', query(0x8000, 3), query(0x8000, 4), query(0x8001)]
+    operations += [f'time:{NEGATIVE_TTL_S}', query(0x8000, 3), query(0x8001)]
+    results = run(ota_candidates, tmp_path, *operations)
+    assert results['query_3'] == ESP_ERR_NOT_FOUND
+    assert results['requests_3'] == 1
+    assert results['query_4'] == ESP_ERR_NOT_FOUND
+    assert results['requests_4'] == 1
+    # The negative entries answer the queries of the versions with no update until they expire
+    for number in [6, 7, 8]:
+        assert results[f'query_{number}'] == ESP_ERR_NOT_FOUND
+        assert results[f'requests_{number}'] == 0
+    assert results['negative_hits'] == 3
+    for number in [10, 11]:
+        assert results[f'query_{number}'] == ESP_ERR_NOT_FOUND
+        assert results[f'requests_{number}'] == 1
+
+
+def test_negative_entry_other_version(ota_candidates, tmp_path):
+    results = run(ota_candidates, tmp_path, 'init', model(0x8000), query(0x8000, 3), query(0x8000, 1),
+                  query(0x8000, 2))
+    # The negative entry of the version 3 does not answer for the version 1, the update replaces it
+    assert results['query_4'] == ESP_OK
+    assert results['requests_4'] == 2
+    assert results['version_4'] == 3
+    assert results['query_5'] == ESP_OK
+    assert results['requests_5'] == 0
+    assert results['entries'] == 1
+
+
+@pytest.mark.parametrize('mode', ['down', 'versions_down'])
+def test_no_negative_cache_on_dcl_failure(ota_candidates, tmp_path, mode):
+    results = run(ota_candidates, tmp_path, 'init', model(0x8000), f'dcl:{mode}', query(0x8000), 'dcl:ok',
+                  query(0x8000))
+    assert results['query_4'] == ESP_FAIL
+    assert results['dcl_failures'] == 1
+    # The failure is not cached as no update, the DCL is queried again
+    assert results['query_6'] == ESP_OK
+    assert results['requests_6'] == 2
+    assert results['negative_hits'] == 0
+    assert results['entries'] == 1
+
+
+def test_nvs_round_trip(ota_candidates, tmp_path):
+    boot = 100
+    operations = [f'time:{boot}', 'init', model(0x8000), model(0x8003), query(0x8000), query(0x8001)]
+    # The negative entry of 0x8001 has expired when the cache is saved after the query of 0x8002
+    saved_after = NEGATIVE_TTL_S + 5
+    operations += [f'time:{boot + saved_after}', query(0x8002)]
+    results = run(ota_candidates, tmp_path, *operations)
+    assert results['entries'] == 3
+    assert results['nvs_writes'] == 3
+
+    # After the reboot, the entries expire after the time to live they had left when they were saved
+    boot = 50
+    operations = [f'time:{boot}', 'init', model(0x8000)]
+    operations += [f'time:{boot + NEGATIVE_TTL_S - 1}', query(0x8002), query(0x8001)]
+    remaining_ttl = TTL_S - saved_after
+    operations += [f'time:{boot + remaining_ttl - 1}', query(0x8000), f'time:{boot + remaining_ttl}', query(0x8000)]
+    results = run(ota_candidates, tmp_path, *operations)
+    assert results['init_2'] == ESP_OK
+    assert results['query_5'] == ESP_ERR_NOT_FOUND
+    assert results['requests_5'] == 0
+    # The expired entry was not loaded
+    assert results['requests_6'] == 1
+    assert results['query_8'] == ESP_OK
+    assert results['requests_8'] == 0
+    assert results['query_10'] == ESP_OK
+    assert results['requests_10'] == 2
+
+
+def test_nvs_invalid_cache(ota_candidates, tmp_path):
+    run(ota_candidates, tmp_path, 'init', model(0x8000), query(0x8000))
+    cache = tmp_path / 'nvs.ota_candidates.cache'
+    cache.write_bytes(cache.read_bytes()[:-1])
+    # A cache saved with another layout is dropped
+    results = run(ota_candidates, tmp_path, 'init', model(0x8000), query(0x8000))
+    assert results['requests_3'] == 2
+    assert results['entries'] == 1
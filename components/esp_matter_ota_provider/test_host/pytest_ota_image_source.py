@@ -0,0 +1,192 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Host test of the local directory and memory OTA image sources built for Linux
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_ota_provider/test_host
+"""
+
+import base64
+import hashlib
+import json
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+VENDOR_ID = 0xFFF1
+PRODUCT_ID = 0x8000
+
+
+@pytest.fixture(scope='module')
+def image_source(tmp_path_factory):
+    output = tmp_path_factory.mktemp('ota_image_source') / 'ota_image_source_test'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'ota_image_source_test.cpp',
+                            host_test.COMPONENTS_DIR / 'esp_matter_ota_provider' / 'src' /
+                            'esp_matter_ota_image_source.cpp'],
+                           [CURRENT_DIR / 'include', host_test.COMPONENTS_DIR / 'esp_matter_ota_provider' / 'include'])
+
+
+def digest_int(data):
+    return int.from_bytes(hashlib.sha256(data).digest(), 'big')
+
+
+def image_entry(version, ota_url, **fields):
+    entry = {'vendorId': VENDOR_ID, 'productId': PRODUCT_ID, 'softwareVersion': version,
+             'softwareVersionString': f'{version}.0', 'minApplicableSoftwareVersion': 0,
+             'maxApplicableSoftwareVersion': version - 1, 'otaURL': ota_url}
+    entry.update(fields)
+    return entry
+
+
+@pytest.fixture
+def image_dir(tmp_path):
+    """A directory with the images of the versions 2 to 4, and the entries of the manifest which must be skipped"""
+    images = {}
+    for version, size in [(2, 5000), (3, 3000), (4, 1000)]:
+        images[version] = bytes((index * version) & 0xFF for index in range(size))
+        (tmp_path / f'light-v{version}.ota').write_bytes(images[version])
+    (tmp_path / 'light-v9.ota').write_bytes(images[4])
+    (tmp_path / 'images').mkdir()
+    (tmp_path / 'images' / 'light-v5.ota').write_bytes(images[2])
+    checksum = base64.b64encode(hashlib.sha256(images[4]).digest()).decode()
+    manifest = {'deviceSoftwareVersionModel': [
+        image_entry(2, 'light-v2.ota', maxApplicableSoftwareVersion=1),
+        # The version 3 only updates the version 2
+        image_entry(3, 'light-v3.ota', minApplicableSoftwareVersion=2, maxApplicableSoftwareVersion=2,
+                    otaChecksum=base64.b64encode(b'short').decode()),
+        image_entry(4, 'light-v4.ota', maxApplicableSoftwareVersion=1, otaChecksum=checksum),
+        # Absolute path, default applicable versions and version string
+        {'vendorId': VENDOR_ID, 'productId': PRODUCT_ID + 1, 'softwareVersion': 5,
+         'otaURL': str(tmp_path / 'images' / 'light-v5.ota')},
+        # Skipped: not valid, missing image file, invalid VendorID
+        image_entry(9, 'light-v9.ota', softwareVersionValid=False),
+        image_entry(8, 'light-v8.ota'),
+        image_entry(7, 'light-v4.ota', vendorId=0x10000),
+    ]}
+    (tmp_path / 'manifest.json').write_text(json.dumps(manifest, indent=2))
+    return tmp_path, images
+
+
+def query_local(image_source, directory, software_version, product_id=PRODUCT_ID, offset=0):
+    return host_test.run(image_source, 'local', directory, VENDOR_ID, product_id, software_version, offset)
+
+
+def test_local_source_latest_update(image_source, image_dir):
+    directory, images = image_dir
+    results = query_local(image_source, directory, 1)
+    assert results['create_result'] == host_test.ESP_OK
+    assert results['result'] == host_test.ESP_OK
+    # The version 9 is not valid and the version 8 has no image, the latest update of the version 1 is the version 4
+    assert results['software_version'] == 4
+    assert results['software_version_str'] == '4.0'
+    assert results['ota_url'] == str(directory / 'light-v4.ota')
+    assert results['ota_file_size'] == len(images[4])
+    assert results['has_ota_digest'] == 1
+    assert results['ota_digest'] == digest_int(images[4])
+    assert results['read_len'] == len(images[4])
+    assert results['read_end'] == 0
+    assert results['read_digest'] == digest_int(images[4])
+    assert results['mem_in_use'] == 0
+
+
+def test_local_source_applicable_versions(image_source, image_dir):
+    directory, images = image_dir
+    results = query_local(image_source, directory, 2, offset=1000)
+    assert results['result'] == host_test.ESP_OK
+    assert results['software_version'] == 3
+    # The checksum is not a SHA-256 digest
+    assert results['has_ota_digest'] == 0
+    # The image is read from the offset, as for a resumed transfer
+    assert results['read_len'] == len(images[3]) - 1000
+    assert results['read_digest'] == digest_int(images[3][1000:])
+
+    assert query_local(image_source, directory, 3)['result'] == host_test.ESP_ERR_NOT_FOUND
+    assert query_local(image_source, directory, 1, product_id=PRODUCT_ID + 2)['result'] == host_test.ESP_ERR_NOT_FOUND
+
+
+def test_local_source_manifest_defaults(image_source, image_dir):
+    directory, images = image_dir
+    results = query_local(image_source, directory, 4, product_id=PRODUCT_ID + 1)
+    assert results['result'] == host_test.ESP_OK
+    assert results['software_version'] == 5
+    assert str(results['software_version_str']) == '5'
+    assert results['ota_url'] == str(directory / 'images' / 'light-v5.ota')
+    assert results['read_digest'] == digest_int(images[2])
+    # The default maxApplicableSoftwareVersion is the version before the image
+    assert query_local(image_source, directory, 5, product_id=PRODUCT_ID + 1)['result'] == host_test.ESP_ERR_NOT_FOUND
+
+
+@pytest.mark.parametrize('manifest, expected', [
+    (None, host_test.ESP_ERR_NOT_FOUND),
+    ('', host_test.ESP_ERR_INVALID_SIZE),
+    ('{"deviceSoftwareVersionModel": [', host_test.ESP_ERR_INVALID_ARG),
+    ('{"images": []}', host_test.ESP_ERR_INVALID_ARG),
+    ('{"deviceSoftwareVersionModel": []}', host_test.ESP_OK),
+])
+def test_local_source_invalid_manifest(image_source, tmp_path, manifest, expected):
+    if manifest is not None:
+        (tmp_path / 'manifest.json').write_text(manifest)
+    results = query_local(image_source, tmp_path, 1)
+    assert results['create_result'] == expected
+    if expected == host_test.ESP_OK:
+        assert results['result'] == host_test.ESP_ERR_NOT_FOUND
+    assert results['mem_in_use'] == 0
+
+
+def memory_image(version, size):
+    factor = {2: 7, 3: 3, 4: 5}[version]
+    return bytes((index * factor) & 0xFF for index in range(size))
+
+
+def test_memory_source(image_source):
+    results = host_test.run(image_source, 'memory', VENDOR_ID, PRODUCT_ID, 1, 0)
+    assert results['create_result'] == host_test.ESP_OK
+    assert results['result'] == host_test.ESP_OK
+    assert results['software_version'] == 4
+    assert results['software_version_str'] == '4.0'
+    assert results['ota_url'] == 'mem/2/ota_fff1_8000_00000004.ota'
+    assert results['ota_file_size'] == 1000
+    assert results['has_ota_digest'] == 0
+    assert results['read_len'] == 1000
+    assert results['read_end'] == 0
+    assert results['read_digest'] == digest_int(memory_image(4, 1000))
+    assert results['open_bad_index'] == host_test.ESP_ERR_NOT_FOUND
+    assert results['open_bad_url'] == host_test.ESP_ERR_NOT_FOUND
+    assert results['open_bad_offset'] == host_test.ESP_ERR_INVALID_ARG
+    assert results['create_no_data'] == host_test.ESP_ERR_INVALID_ARG
+    assert results['mem_in_use'] == 0
+
+
+def test_memory_source_applicable_versions(image_source):
+    results = host_test.run(image_source, 'memory', VENDOR_ID, PRODUCT_ID, 2, 1000)
+    assert results['software_version'] == 3
+    assert results['read_len'] == 2000
+    assert results['read_digest'] == digest_int(memory_image(3, 3000)[1000:])
+
+    results = host_test.run(image_source, 'memory', VENDOR_ID, PRODUCT_ID + 1, 1, 0)
+    # An image without version string
+    assert results['software_version'] == 7
+    assert results['software_version_str'] == ''
+
+    for product_id, version in [(PRODUCT_ID, 3), (PRODUCT_ID, 4), (PRODUCT_ID + 2, 1)]:
+        results = host_test.run(image_source, 'memory', VENDOR_ID, product_id, version, 0)
+        assert results['result'] == host_test.ESP_ERR_NOT_FOUND
@@ -0,0 +1,73 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+"""
+Host benchmark of the read-ahead of the OTA images of the BDX senders built for Linux, against a throttled source
+
+    pytest -c tools/host_test/pytest.ini components/esp_matter_ota_provider/test_host -s
+"""
+
+import pathlib
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parents[2] / 'tools' / 'host_test'))
+
+import host_test  # noqa: E402
+
+READ_AHEAD_BLOCKS = 4
+BLOCK_SIZE = 1024
+IMAGE_SIZE = 64 * BLOCK_SIZE + 100
+
+
+@pytest.fixture(scope='module')
+def read_ahead(tmp_path_factory):
+    output = tmp_path_factory.mktemp('read_ahead') / 'read_ahead_test'
+    provider_dir = host_test.COMPONENTS_DIR / 'esp_matter_ota_provider'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'read_ahead_test.cpp',
+                            provider_dir / 'src' / 'esp_matter_ota_read_ahead.cpp'],
+                           [provider_dir / 'private_include'],
+                           chip=True,
+                           defines=[f'CONFIG_ESP_MATTER_OTA_PROVIDER_BDX_READ_AHEAD_BLOCKS={READ_AHEAD_BLOCKS}',
+                                    'CONFIG_ESP_MATTER_OTA_PROVIDER_READ_AHEAD_TASK_STACK_SIZE=6144'])
+
+
+def run_read_ahead(read_ahead, mode, streams, read_us, query_us):
+    results = host_test.run(read_ahead, mode, streams, IMAGE_SIZE, BLOCK_SIZE, read_us, query_us)
+    print(f'{mode}: {streams} streams, read {read_us} us, query {query_us} us: {results["kb_per_s"]} KB/s')
+    assert results['bytes'] == streams * IMAGE_SIZE
+    assert results['mismatches'] == 0
+    assert results['closed'] == streams
+    return results
+
+
+@pytest.mark.parametrize('read_us,query_us', [(2000, 2000), (3000, 1000), (1000, 3000)])
+def test_throughput(read_ahead, read_us, query_us):
+    # Without read-ahead a block takes the read and the query, with it the longest of both
+    direct = run_read_ahead(read_ahead, 'direct', 1, read_us, query_us)
+    ahead = run_read_ahead(read_ahead, 'ahead', 1, read_us, query_us)
+    expected = (read_us + query_us) / max(read_us, query_us)
+    assert ahead['kb_per_s'] >= direct['kb_per_s'] * (1 + (expected - 1) * 0.6)
+
+
+def test_streams(read_ahead):
+    # The source of the blocks is shared by the streams, which get the blocks in turn
+    direct = run_read_ahead(read_ahead, 'direct', 3, 1000, 3000)
+    ahead = run_read_ahead(read_ahead, 'ahead', 3, 1000, 3000)
+    assert ahead['kb_per_s'] >= direct['kb_per_s'] * 0.9
@@ -0,0 +1,175 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Benchmarks the read-ahead of the OTA images of the BDX senders on Linux:
+//
+//     read_ahead_test <direct|ahead> <streams> <image size> <block size> <read us> <query us>
+//
+// Each stream reads an image of <image size> bytes from a throttled source, which takes <read us> to return a block
+// as the HTTP(S) connection of a DCL image would. The Requestors are simulated by the test thread, which plays the
+// part of the Matter thread: the next BlockQuery of a stream arrives <query us> after its previous Block is sent. With
+// direct, the blocks are read from the source when the BlockQuery arrives, in the Matter thread. With ahead, they are
+// copied from the ring of the read-ahead task, run in a thread. The test checks the content of the blocks and prints
+// the bytes sent, the duration and the throughput of the streams as '<name> <value>' lines.
+
+#include <chrono>
+#include <esp_matter_ota_read_ahead.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+using namespace esp_matter::ota_provider;
+using clock_type = std::chrono::steady_clock;
+
+struct source {
+    size_t id;
+    size_t size;
+    size_t offset;
+    uint32_t read_us;
+};
+
+struct stream {
+    source src;
+    read_ahead_handle_t handle;
+    clock_type::time_point next_query;
+    bool pending;
+    bool done;
+    size_t received;
+};
+
+static std::vector<stream> s_streams;
+static size_t s_mismatches = 0;
+static size_t s_closed_complete = 0;
+
+static uint8_t pattern(size_t id, size_t offset)
+{
+    return static_cast<uint8_t>((offset * 7 + id) ^ (offset >> 8));
+}
+
+static int read_source(void *ctx, uint8_t *buf, size_t size)
+{
+    source *src = static_cast<source *>(ctx);
+    std::this_thread::sleep_for(std::chrono::microseconds(src->read_us));
+    size_t len = std::min(size, src->size - src->offset);
+    for (size_t i = 0; i < len; ++i) {
+        buf[i] = pattern(src->id, src->offset + i);
+    }
+    src->offset += len;
+    return static_cast<int>(len);
+}
+
+static void close_source(void *ctx, bool complete)
+{
+    s_closed_complete += complete ? 1 : 0;
+}
+
+static void block_ready(intptr_t arg)
+{
+    // The BlockQuery waiting for the block is answered now
+    s_streams[arg].pending = false;
+    s_streams[arg].next_query = clock_type::now();
+}
+
+static void send_block(stream &s, const uint8_t *buf, int len, uint32_t query_us)
+{
+    if (len <= 0) {
+        s.done = true;
+        if (s.handle) {
+            read_ahead_release(s.handle, len == 0);
+            s.handle = nullptr;
+        } else {
+            close_source(&s.src, len == 0);
+        }
+        return;
+    }
+    for (int i = 0; i < len; ++i) {
+        s_mismatches += buf[i] != pattern(s.src.id, s.received + i) ? 1 : 0;
+    }
+    s.received += len;
+    s.next_query = clock_type::now() + std::chrono::microseconds(query_us);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 7) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+    bool ahead = strcmp(argv[1], "ahead") == 0;
+    size_t stream_count = strtoul(argv[2], nullptr, 0);
+    size_t image_size = strtoul(argv[3], nullptr, 0);
+    size_t block_size = strtoul(argv[4], nullptr, 0);
+    uint32_t read_us = strtoul(argv[5], nullptr, 0);
+    uint32_t query_us = strtoul(argv[6], nullptr, 0);
+    std::vector<uint8_t> buf(block_size);
+
+    host_test::set_run_tasks(true);
+    s_streams.resize(stream_count);
+    clock_type::time_point start = clock_type::now();
+    for (size_t i = 0; i < stream_count; ++i) {
+        stream &s = s_streams[i];
+        s.src = {i, image_size, 0, read_us};
+        s.next_query = start;
+        if (ahead) {
+            if (read_ahead_init() != ESP_OK ||
+                read_ahead_start(read_source, close_source, &s.src, block_size, block_ready, i, &s.handle) != ESP_OK) {
+                fprintf(stderr, "Failed to start the read-ahead\n");
+                return 1;
+            }
+        }
+    }
+
+    size_t done = 0;
+    while (done < stream_count) {
+        host_test::run_scheduled_work();
+        bool idle = true;
+        for (stream &s : s_streams) {
+            if (s.done || s.pending || clock_type::now() < s.next_query) {
+                continue;
+            }
+            idle = false;
+            int len = ahead ? read_ahead_get(s.handle, buf.data(), block_size)
+                            : read_source(&s.src, buf.data(), block_size);
+            if (len == k_read_ahead_pending) {
+                s.pending = true;
+                continue;
+            }
+            send_block(s, buf.data(), len, query_us);
+            done += s.done ? 1 : 0;
+        }
+        if (idle) {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+    }
+    int64_t elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+    // The released streams are closed by work scheduled in the Matter thread
+    host_test::run_scheduled_work();
+
+    size_t bytes = 0;
+    for (const stream &s : s_streams) {
+        bytes += s.received;
+    }
+    printf("bytes %zu\n", bytes);
+    printf("mismatches %zu\n", s_mismatches);
+    printf("closed %zu\n", s_closed_complete);
+    printf("elapsed_us %" PRId64 "\n", elapsed_us);
+    printf("kb_per_s %" PRId64 "\n", elapsed_us ? static_cast<int64_t>(bytes) * 1000000 / 1024 / elapsed_us : 0);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to compress the firmware of a compressed OTA image
+
+The format is described in components/esp_matter/esp_matter_ota_decompressor.h. Wrap the compressed firmware in a
+Matter OTA image:
+
+    compress_ota_payload.py firmware.bin -o firmware.zota
+    $ESP_MATTER_PATH/connectedhomeip/connectedhomeip/src/app/ota_image_tool.py create -v <vid> -p <pid> \\
+        -vn <version> -vs <version string> -da sha256 firmware.zota firmware.ota
+
+The OTA Requestors decompress the compressed OTA images with CONFIG_ESP_MATTER_OTA_REQUESTOR_COMPRESSED_OTA. The
+OTA Provider serves them as any other OTA image.
+"""
+
+import argparse
+import logging
+import struct
+import sys
+
+COMPRESSED_MAGIC = 0x41544F5A  # "ZOTA"
+COMPRESSED_VERSION = 1
+WINDOW_BITS = 12
+WINDOW_SIZE = 1 << WINDOW_BITS
+MIN_MATCH_LEN = 3
+MAX_MATCH_LEN = MIN_MATCH_LEN + (1 << (16 - WINDOW_BITS)) - 1
+# The positions of each prefix of MIN_MATCH_LEN bytes which are tried for a match, the most recent first
+MAX_CANDIDATES = 32
+
+
+def find_match(data, pos, candidates):
+    best_len = 0
+    best_distance = 0
+    max_len = min(MAX_MATCH_LEN, len(data) - pos)
+    for candidate in reversed(candidates):
+        distance = pos - candidate
+        if distance > WINDOW_SIZE:
+            break
+        length = 0
+        while length < max_len and data[candidate + length] == data[pos + length]:
+            length += 1
+        if length > best_len:
+            best_len = length
+            best_distance = distance
+            if length == max_len:
+                break
+    return best_len, best_distance
+
+
+def compress(data):
+    out = bytearray(struct.pack('<IIB3xI', COMPRESSED_MAGIC, COMPRESSED_VERSION, WINDOW_BITS, len(data)))
+    chains = {}
+    flags_pos = 0
+    items = 8
+    pos = 0
+    while pos < len(data):
+        if items == 8:
+            flags_pos = len(out)
+            out.append(0)
+            items = 0
+        length = 0
+        if pos + MIN_MATCH_LEN <= len(data):
+            length, distance = find_match(data, pos, chains.get(data[pos:pos + MIN_MATCH_LEN], ()))
+        if length >= MIN_MATCH_LEN:
+            out += struct.pack('<H', (distance - 1) | ((length - MIN_MATCH_LEN) << WINDOW_BITS))
+        else:
+            length = 1
+            out[flags_pos] |= 1 << items
+            out.append(data[pos])
+        items += 1
+        for index in range(pos, min(pos + length, len(data) - MIN_MATCH_LEN + 1)):
+            chain = chains.setdefault(data[index:index + MIN_MATCH_LEN], [])
+            chain.append(index)
+            if len(chain) > MAX_CANDIDATES:
+                del chain[0]
+        pos += length
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress the firmware of a compressed OTA image')
+    parser.add_argument('firmware', help='Firmware binary')
+    parser.add_argument('-o', '--output', required=True, help='Output compressed firmware')
+    args = parser.parse_args()
+    logging.basicConfig(format='%(message)s', level=logging.INFO)
+
+    with open(args.firmware, 'rb') as f:
+        firmware = f.read()
+    compressed = compress(firmware)
+    with open(args.output, 'wb') as f:
+        f.write(compressed)
+    logging.info('Compressed %d bytes to %d bytes, %.1f%%', len(firmware), len(compressed),
+                 100.0 * len(compressed) / max(len(firmware), 1))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
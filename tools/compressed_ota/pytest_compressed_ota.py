@@ -0,0 +1,115 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Host test of the compressed OTA payloads: the payloads compressed by compress_ota_payload.py are decompressed by the
+decompressor of components/esp_matter built for Linux
+
+    pytest -c tools/host_test/pytest.ini tools/compressed_ota
+"""
+
+import pathlib
+import random
+import struct
+import subprocess
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parent / 'host_test'))
+
+import host_test  # noqa: E402
+
+COMPRESS_OTA_PAYLOAD = CURRENT_DIR / 'compress_ota_payload.py'
+WINDOW_SIZE = 4096
+HEADER = struct.Struct('<IIB3xI')
+
+
+@pytest.fixture(scope='module')
+def decompressor(tmp_path_factory):
+    output = tmp_path_factory.mktemp('compressed_ota') / 'decompressor_test'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'test' / 'decompressor_test.cpp',
+                            host_test.COMPONENTS_DIR / 'esp_matter' / 'esp_matter_ota_decompressor.cpp'],
+                           [host_test.COMPONENTS_DIR / 'esp_matter'])
+
+
+@pytest.fixture(scope='module')
+def compressed(tmp_path_factory):
+    """A synthetic firmware with repeated regions within and beyond the window, and its compressed payload"""
+    rng = random.Random(0x5A4F)
+    words = [rng.randbytes(4) for _ in range(64)]
+    firmware = bytearray()
+    while len(firmware) < 40000:
+        firmware += rng.choice(words) if rng.random() < 0.8 else rng.randbytes(rng.randint(1, 40))
+    firmware += firmware[1000:9000] + bytes(3000)
+    tmp_path = tmp_path_factory.mktemp('compressed_payload')
+    firmware_path = tmp_path / 'firmware.bin'
+    payload_path = tmp_path / 'payload.bin'
+    firmware_path.write_bytes(firmware)
+    subprocess.run([sys.executable, str(COMPRESS_OTA_PAYLOAD), str(firmware_path), '-o', str(payload_path)],
+                   check=True)
+    return bytes(firmware), payload_path.read_bytes()
+
+
+def decompress(decompressor, tmp_path, payload, chunk_size):
+    payload_path = tmp_path / 'payload.bin'
+    output_path = tmp_path / 'output.bin'
+    payload_path.write_bytes(payload)
+    results = host_test.run(decompressor, payload_path, output_path, chunk_size)
+    # The decompressor only holds the window, whatever the size of the firmware
+    assert results['mem_peak'] < WINDOW_SIZE + 256
+    assert results['max_write'] <= WINDOW_SIZE
+    assert results['mem_in_use'] == 0
+    return results['result'], output_path.read_bytes()
+
+
+@pytest.mark.parametrize('chunk_size', [1, 3, 1024])
+def test_decompress(decompressor, compressed, tmp_path, chunk_size):
+    firmware, payload = compressed
+    assert len(payload) < len(firmware)
+    result, output = decompress(decompressor, tmp_path, payload, chunk_size)
+    assert result == host_test.ESP_OK
+    assert output == firmware
+
+
+def test_decompress_truncated(decompressor, compressed, tmp_path):
+    firmware, payload = compressed
+    result, _ = decompress(decompressor, tmp_path, payload[:-10], 1024)
+    assert result == host_test.ESP_ERR_INVALID_SIZE
+
+
+def test_decompress_oversize(decompressor, compressed, tmp_path):
+    firmware, payload = compressed
+    # The payload decompresses to more bytes than its header announces
+    magic, version, window_bits, size = HEADER.unpack_from(payload)
+    oversize = HEADER.pack(magic, version, window_bits, size - 100) + payload[HEADER.size:]
+    result, output = decompress(decompressor, tmp_path, oversize, 1024)
+    assert result == host_test.ESP_ERR_INVALID_SIZE
+    assert len(output) <= size - 100
+
+
+def test_decompress_bad_distance(decompressor, tmp_path):
+    # Two literals, then a match 3 bytes back, before the start of the firmware
+    payload = HEADER.pack(0x41544F5A, 1, 12, 10) + bytes([0b011]) + b'ab' + struct.pack('<H', 3 - 1)
+    result, _ = decompress(decompressor, tmp_path, payload, 1)
+    assert result == host_test.ESP_ERR_INVALID_ARG
+
+
+def test_decompress_bad_header(decompressor, compressed, tmp_path):
+    firmware, payload = compressed
+    magic, version, window_bits, size = HEADER.unpack_from(payload)
+    result, _ = decompress(decompressor, tmp_path, HEADER.pack(magic, version + 1, window_bits, size), 1024)
+    assert result == host_test.ESP_ERR_NOT_SUPPORTED
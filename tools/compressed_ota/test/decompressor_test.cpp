@@ -0,0 +1,95 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Decompresses a compressed OTA payload on Linux: decompressor_test <payload> <firmware output> <chunk size>
+//
+// The payload is fed to the decompressor in chunks of the chunk size, as the BDX blocks of a download, and the
+// firmware is written to the firmware output. The result of the decompressor is printed as 'result 0x<code>'.
+
+#include <algorithm>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_decompressor.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace esp_matter::ota::compression;
+
+typedef struct {
+    FILE *firmware;
+    size_t max_write;
+} test_ctx_t;
+
+static std::vector<uint8_t> read_file(const char *path)
+{
+    std::vector<uint8_t> data;
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        exit(1);
+    }
+    uint8_t buf[1024];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+        data.insert(data.end(), buf, buf + len);
+    }
+    fclose(file);
+    return data;
+}
+
+static esp_err_t write_firmware(void *ctx, const uint8_t *buf, size_t size)
+{
+    test_ctx_t *test = (test_ctx_t *)ctx;
+    test->max_write = std::max(test->max_write, size);
+    return fwrite(buf, 1, size, test->firmware) == size ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t decompress(decompressor_handle_t dec, const std::vector<uint8_t> &payload, size_t chunk_size)
+{
+    for (size_t offset = 0; offset < payload.size(); offset += chunk_size) {
+        esp_err_t err = decompressor_feed(dec, payload.data() + offset, std::min(chunk_size, payload.size() - offset));
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return decompressor_finish(dec);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s <payload> <firmware output> <chunk size>\n", argv[0]);
+        return 1;
+    }
+    std::vector<uint8_t> payload = read_file(argv[1]);
+    size_t chunk_size = strtoul(argv[3], nullptr, 0);
+    test_ctx_t test = {fopen(argv[2], "wb"), 0};
+    if (!test.firmware || chunk_size == 0) {
+        fprintf(stderr, "Invalid firmware output or chunk size\n");
+        return 1;
+    }
+
+    decompressor_handle_t dec;
+    esp_err_t err = decompressor_create(write_firmware, &test, &dec);
+    if (err == ESP_OK) {
+        err = decompress(dec, payload, chunk_size);
+        decompressor_destroy(dec);
+    }
+    fclose(test.firmware);
+    printf("result 0x%x\n", err);
+    printf("max_write %zu\n", test.max_write);
+    printf("mem_peak %zu\n", host_test::mem_peak());
+    printf("mem_in_use %zu\n", host_test::mem_in_use());
+    return 0;
+}
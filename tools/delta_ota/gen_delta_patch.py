@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to generate the patch of a delta OTA image
+
+The patch updates the devices running the base firmware to the target firmware, the format is described in
+components/esp_matter/esp_matter_ota_delta_patch.h. Wrap the patch in a Matter OTA image with the software version
+of the target firmware:
+
+    gen_delta_patch.py base.bin target.bin -o patch.bin
+    $ESP_MATTER_PATH/connectedhomeip/connectedhomeip/src/app/ota_image_tool.py create -v <vid> -p <pid> \\
+        -vn <target version> -vs <target version string> -da sha256 patch.bin delta.ota
+
+The OTA Requestors apply the delta OTA images with CONFIG_ESP_MATTER_OTA_REQUESTOR_DELTA_OTA, and the OTA Provider
+offers them to the Requestors running the base version once they are registered with AddDeltaOtaImage().
+"""
+
+import argparse
+import hashlib
+import logging
+import struct
+import sys
+
+PATCH_MAGIC = 0x50444D45  # "EMDP"
+PATCH_VERSION = 1
+OP_END = 0
+OP_ADD = 1
+OP_INSERT = 2
+OP_COPY = 3
+
+# Length of the blocks of the base index, the matches shorter than a block are not looked for
+BLOCK_LEN = 16
+# The base is indexed at this alignment, as the code and data of the firmware are mostly word aligned
+BLOCK_STEP = 4
+# A match is extended past the exact match while at least half of the bytes still match, and stops after this many
+# bytes without improvement
+MAX_MISMATCH_RUN = 64
+# The runs of equal bytes of a match shorter than this are in add records, the longer ones are copied
+MIN_COPY_LEN = 16
+
+
+def index_base(base):
+    index = {}
+    for offset in range(0, len(base) - BLOCK_LEN + 1, BLOCK_STEP):
+        index.setdefault(base[offset:offset + BLOCK_LEN], offset)
+    return index
+
+
+def extend_approximately(base, target, base_offset, target_offset, length):
+    """Extend an exact match of length bytes while the extension has more matching than differing bytes"""
+    best_length = length
+    score = 0
+    best_score = 0
+    while base_offset + length < len(base) and target_offset + length < len(target):
+        score += 1 if base[base_offset + length] == target[target_offset + length] else -1
+        length += 1
+        if score > best_score:
+            best_score = score
+            best_length = length
+        elif length - best_length > MAX_MISMATCH_RUN:
+            break
+    return best_length
+
+
+def find_match(base, target, index, target_offset):
+    base_offset = index.get(target[target_offset:target_offset + BLOCK_LEN])
+    if base_offset is None:
+        return None, 0
+    length = BLOCK_LEN
+    while (base_offset + length < len(base) and target_offset + length < len(target) and
+           base[base_offset + length] == target[target_offset + length]):
+        length += 1
+    return base_offset, length
+
+
+def add_record(base, target, base_offset, target_offset, length):
+    delta = bytes((target[target_offset + i] - base[base_offset + i]) & 0xFF for i in range(length))
+    return struct.pack('<BII', OP_ADD, base_offset, length) + delta
+
+
+def match_records(base, target, base_offset, target_offset, length):
+    """Copy the long runs of equal bytes of a match, and add the differences between them"""
+    records = []
+    add_start = 0
+    run_start = 0
+    for i in range(length + 1):
+        if i < length and base[base_offset + i] == target[target_offset + i]:
+            continue
+        if i - run_start >= MIN_COPY_LEN:
+            if run_start > add_start:
+                records.append(add_record(base, target, base_offset + add_start, target_offset + add_start,
+                                          run_start - add_start))
+            records.append(struct.pack('<BII', OP_COPY, base_offset + run_start, i - run_start))
+            add_start = i
+        run_start = i + 1
+    if length > add_start:
+        records.append(add_record(base, target, base_offset + add_start, target_offset + add_start,
+                                  length - add_start))
+    return records
+
+
+def insert_record(data):
+    return struct.pack('<BI', OP_INSERT, len(data)) + data
+
+
+def generate_patch(base, target):
+    index = index_base(base)
+    records = []
+    insert_start = 0
+    target_offset = 0
+    added = 0
+    while target_offset < len(target):
+        base_offset, length = find_match(base, target, index, target_offset)
+        if base_offset is None:
+            target_offset += 1
+            continue
+        # The match may start before the indexed block, take these bytes from the pending insert
+        while (base_offset > 0 and target_offset > insert_start and
+               base[base_offset - 1] == target[target_offset - 1]):
+            base_offset -= 1
+            target_offset -= 1
+            length += 1
+        length = extend_approximately(base, target, base_offset, target_offset, length)
+        if target_offset > insert_start:
+            records.append(insert_record(target[insert_start:target_offset]))
+        records.extend(match_records(base, target, base_offset, target_offset, length))
+        added += length
+        target_offset += length
+        insert_start = target_offset
+    if insert_start < len(target):
+        records.append(insert_record(target[insert_start:]))
+    records.append(struct.pack('<B', OP_END))
+
+    header = struct.pack('<III32sI32s', PATCH_MAGIC, PATCH_VERSION, len(base), hashlib.sha256(base).digest(),
+                         len(target), hashlib.sha256(target).digest())
+    logging.info('%d of %d target bytes are taken from the base', added, len(target))
+    return header + b''.join(records)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the patch of a delta OTA image')
+    parser.add_argument('base', help='Firmware binary running on the devices')
+    parser.add_argument('target', help='New firmware binary')
+    parser.add_argument('-o', '--output', required=True, help='Output patch file')
+    args = parser.parse_args()
+    logging.basicConfig(format='%(message)s', level=logging.INFO)
+
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.target, 'rb') as f:
+        target = f.read()
+    patch = generate_patch(base, target)
+    with open(args.output, 'wb') as f:
+        f.write(patch)
+    logging.info('Patch of %d bytes, %.1f%% of the target', len(patch), 100.0 * len(patch) / max(len(target), 1))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,110 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Host test of the delta OTA patches: the patches generated by gen_delta_patch.py are applied by the patch applier of
+components/esp_matter built for Linux
+
+    pytest -c tools/host_test/pytest.ini tools/delta_ota
+"""
+
+import hashlib
+import pathlib
+import random
+import subprocess
+import sys
+
+import pytest
+
+CURRENT_DIR = pathlib.Path(__file__).parent
+sys.path.insert(0, str(CURRENT_DIR.parent / 'host_test'))
+
+import host_test  # noqa: E402
+
+GEN_DELTA_PATCH = CURRENT_DIR / 'gen_delta_patch.py'
+
+
+@pytest.fixture(scope='module')
+def applier(tmp_path_factory):
+    output = tmp_path_factory.mktemp('delta_ota') / 'delta_patch_test'
+    return host_test.build(output,
+                           [CURRENT_DIR / 'test' / 'delta_patch_test.cpp',
+                            host_test.COMPONENTS_DIR / 'esp_matter' / 'esp_matter_ota_delta_patch.cpp'],
+                           [host_test.COMPONENTS_DIR / 'esp_matter'])
+
+
+def synthetic_firmwares():
+    """A base firmware and a target firmware with moved, edited, inserted and removed regions, as in a new build"""
+    rng = random.Random(0x5044)
+    base = bytearray(rng.randbytes(96 * 1024))
+    target = bytearray(base[:20000])
+    # Code moved by a new function, with a few patched words
+    function = rng.randbytes(1500)
+    target += function + base[20000:50000]
+    for offset in range(21000, 50000, 997):
+        target[offset] ^= 0x5A
+    # Removed region, then a region copied from further in the base, then new data at the end
+    target += base[60000:80000] + base[30000:34000] + rng.randbytes(7000)
+    return bytes(base), bytes(target)
+
+
+def gen_patch(tmp_path, base, target):
+    base_path = tmp_path / 'base.bin'
+    target_path = tmp_path / 'target.bin'
+    patch_path = tmp_path / 'patch.bin'
+    base_path.write_bytes(base)
+    target_path.write_bytes(target)
+    subprocess.run([sys.executable, str(GEN_DELTA_PATCH), str(base_path), str(target_path), '-o', str(patch_path)],
+                   check=True)
+    return patch_path
+
+
+@pytest.mark.parametrize('chunk_size', [1, 7, 1024])
+def test_delta_patch_applies(applier, tmp_path, chunk_size):
+    base, target = synthetic_firmwares()
+    patch_path = gen_patch(tmp_path, base, target)
+    # The patch only holds the new bytes of the target
+    assert patch_path.stat().st_size < len(target) // 2
+
+    output_path = tmp_path / 'output.bin'
+    results = host_test.run(applier, tmp_path / 'base.bin', patch_path, output_path, chunk_size)
+    assert results['result'] == host_test.ESP_OK
+    assert hashlib.sha256(output_path.read_bytes()).digest() == hashlib.sha256(target).digest()
+    assert results['mem_in_use'] == 0
+
+
+def test_delta_patch_wrong_base(applier, tmp_path):
+    base, target = synthetic_firmwares()
+    patch_path = gen_patch(tmp_path, base, target)
+    # A device running another firmware of the same size must download the full image instead
+    other_base = bytearray(base)
+    other_base[len(base) // 2] ^= 0xFF
+    other_base_path = tmp_path / 'other_base.bin'
+    other_base_path.write_bytes(other_base)
+
+    output_path = tmp_path / 'output.bin'
+    results = host_test.run(applier, other_base_path, patch_path, output_path, 1024)
+    assert results['result'] == host_test.ESP_ERR_INVALID_VERSION
+    assert output_path.read_bytes() == b''
+    assert results['mem_in_use'] == 0
+
+
+def test_delta_patch_truncated(applier, tmp_path):
+    base, target = synthetic_firmwares()
+    patch_path = gen_patch(tmp_path, base, target)
+    truncated_path = tmp_path / 'truncated.bin'
+    truncated_path.write_bytes(patch_path.read_bytes()[:-100])
+
+    results = host_test.run(applier, tmp_path / 'base.bin', truncated_path, tmp_path / 'output.bin', 1024)
+    assert results['result'] == host_test.ESP_ERR_INVALID_SIZE
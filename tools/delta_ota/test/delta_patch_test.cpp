@@ -0,0 +1,116 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Applies a delta OTA patch on Linux: delta_patch_test <base> <patch> <target output> <chunk size>
+//
+// The patch is fed to the applier in chunks of the chunk size, as the BDX blocks of a download, and the target is
+// written to the target output. The result of the applier is printed as 'result 0x<code>'.
+
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_delta_patch.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace esp_matter::ota::delta;
+
+typedef struct {
+    std::vector<uint8_t> base;
+    FILE *target;
+} test_ctx_t;
+
+static std::vector<uint8_t> read_file(const char *path)
+{
+    std::vector<uint8_t> data;
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        exit(1);
+    }
+    uint8_t buf[1024];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+        data.insert(data.end(), buf, buf + len);
+    }
+    fclose(file);
+    return data;
+}
+
+static esp_err_t read_base(void *ctx, uint32_t offset, uint8_t *buf, size_t size)
+{
+    test_ctx_t *test = (test_ctx_t *)ctx;
+    if (offset > test->base.size() || size > test->base.size() - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(buf, test->base.data() + offset, size);
+    return ESP_OK;
+}
+
+static esp_err_t write_target(void *ctx, const uint8_t *buf, size_t size)
+{
+    test_ctx_t *test = (test_ctx_t *)ctx;
+    return fwrite(buf, 1, size, test->target) == size ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t apply_patch(patch_applier_handle_t applier, const std::vector<uint8_t> &patch, size_t chunk_size)
+{
+    for (size_t offset = 0; offset < patch.size(); offset += chunk_size) {
+        const uint8_t *data = patch.data() + offset;
+        size_t size = std::min(chunk_size, patch.size() - offset);
+        // The applier may consume a block in several calls, as the download does
+        while (size > 0) {
+            size_t consumed = 0;
+            esp_err_t err = patch_applier_feed(applier, data, size, &consumed);
+            if (err != ESP_OK) {
+                return err;
+            }
+            data += consumed;
+            size -= consumed;
+        }
+    }
+    esp_err_t err;
+    while ((err = patch_applier_finish(applier)) == ESP_ERR_NOT_FINISHED) {
+    }
+    return err;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 5) {
+        fprintf(stderr, "Usage: %s <base> <patch> <target output> <chunk size>\n", argv[0]);
+        return 1;
+    }
+    test_ctx_t test;
+    test.base = read_file(argv[1]);
+    std::vector<uint8_t> patch = read_file(argv[2]);
+    size_t chunk_size = strtoul(argv[4], nullptr, 0);
+    test.target = fopen(argv[3], "wb");
+    if (!test.target || chunk_size == 0) {
+        fprintf(stderr, "Invalid target output or chunk size\n");
+        return 1;
+    }
+
+    patch_applier_handle_t applier;
+    esp_err_t err = patch_applier_create(read_base, write_target, &test, &applier);
+    if (err == ESP_OK) {
+        err = apply_patch(applier, patch, chunk_size);
+        patch_applier_destroy(applier);
+    }
+    fclose(test.target);
+    printf("result 0x%x\n", err);
+    printf("mem_peak %zu\n", host_test::mem_peak());
+    printf("mem_in_use %zu\n", host_test::mem_in_use());
+    return 0;
+}
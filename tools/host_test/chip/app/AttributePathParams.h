@@ -0,0 +1,63 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the attribute and event paths of the Matter SDK
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+
+using EndpointId = uint16_t;
+using ClusterId = uint32_t;
+using AttributeId = uint32_t;
+using EventId = uint32_t;
+using CommandId = uint32_t;
+
+constexpr EndpointId kInvalidEndpointId = 0xFFFF;
+constexpr ClusterId kInvalidClusterId = 0xFFFFFFFF;
+constexpr AttributeId kInvalidAttributeId = 0xFFFFFFFF;
+constexpr EventId kInvalidEventId = 0xFFFFFFFF;
+
+namespace app {
+
+struct AttributePathParams {
+    AttributePathParams() = default;
+    AttributePathParams(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId)
+        : mClusterId(clusterId), mAttributeId(attributeId), mEndpointId(endpointId)
+    {
+    }
+
+    ClusterId mClusterId = kInvalidClusterId;
+    AttributeId mAttributeId = kInvalidAttributeId;
+    EndpointId mEndpointId = kInvalidEndpointId;
+};
+
+struct EventPathParams {
+    EventPathParams() = default;
+    EventPathParams(EndpointId endpointId, ClusterId clusterId, EventId eventId, bool urgentEvent = false)
+        : mClusterId(clusterId), mEventId(eventId), mEndpointId(endpointId), mIsUrgentEvent(urgentEvent)
+    {
+    }
+
+    ClusterId mClusterId = kInvalidClusterId;
+    EventId mEventId = kInvalidEventId;
+    EndpointId mEndpointId = kInvalidEndpointId;
+    bool mIsUrgentEvent = false;
+};
+
+} // namespace app
+} // namespace chip
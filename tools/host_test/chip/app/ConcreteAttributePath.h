@@ -0,0 +1,53 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the concrete paths of the Matter SDK
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+
+namespace chip {
+namespace app {
+
+struct ConcreteAttributePath {
+    ConcreteAttributePath() = default;
+    ConcreteAttributePath(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId)
+        : mEndpointId(endpointId), mClusterId(clusterId), mAttributeId(attributeId)
+    {
+    }
+
+    EndpointId mEndpointId = 0;
+    ClusterId mClusterId = 0;
+    AttributeId mAttributeId = 0;
+};
+
+struct ConcreteDataAttributePath : public ConcreteAttributePath {
+    using ConcreteAttributePath::ConcreteAttributePath;
+};
+
+struct ConcreteCommandPath {
+    ConcreteCommandPath(EndpointId endpointId, ClusterId clusterId, CommandId commandId)
+        : mEndpointId(endpointId), mClusterId(clusterId), mCommandId(commandId)
+    {
+    }
+
+    EndpointId mEndpointId = 0;
+    ClusterId mClusterId = 0;
+    CommandId mCommandId = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,33 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the OTA downloader interface of the Matter SDK, with the calls made by the image processors
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <platform/OTAImageProcessor.h>
+
+namespace chip {
+
+class OTADownloader {
+public:
+    virtual ~OTADownloader() = default;
+
+    virtual void OnPreparedForDownload(CHIP_ERROR status) = 0;
+    virtual CHIP_ERROR FetchNextData() = 0;
+    virtual void EndDownload(CHIP_ERROR reason = CHIP_NO_ERROR) = 0;
+};
+
+} // namespace chip
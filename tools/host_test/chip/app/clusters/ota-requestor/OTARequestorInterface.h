@@ -0,0 +1,44 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the OTA requestor interface of the Matter SDK, with the calls made by the image processors
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+
+class OTARequestorInterface {
+public:
+    enum class OTAUpdateStateEnum : uint8_t {
+        kUnknown = 0,
+        kIdle,
+        kQuerying,
+        kDelayedOnQuery,
+        kDownloading,
+        kApplying,
+        kDelayedOnApply,
+        kRollingBack,
+        kDelayedOnUserConsent,
+    };
+
+    virtual ~OTARequestorInterface() = default;
+    virtual OTAUpdateStateEnum GetCurrentUpdateState() = 0;
+    virtual uint32_t GetTargetVersion() = 0;
+};
+
+OTARequestorInterface *GetRequestorInstance();
+
+} // namespace chip
@@ -0,0 +1,333 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the platform manager, the system layer timers, the clock and the key value store of the Matter SDK.
+// The work is run by the test thread from host_test::run_scheduled_work(), as the Matter thread would run it. The
+// tasks run in threads by host_test::set_run_tasks() may schedule work.
+
+#include <app/clusters/ota-requestor/OTARequestorInterface.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/KeyValueStoreManager.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct work_item {
+    chip::DeviceLayer::AsyncWorkFunct work;
+    intptr_t arg;
+    // The work items without work function deliver the event
+    chip::DeviceLayer::ChipDeviceEvent event;
+};
+
+struct event_handler {
+    chip::DeviceLayer::EventHandlerFunct handler;
+    intptr_t arg;
+};
+
+struct timer {
+    chip::System::Clock::Timestamp deadline;
+    chip::System::TimerCompleteCallback on_complete;
+    void *app_state;
+};
+
+std::deque<work_item> s_work;
+std::mutex s_work_lock;
+std::vector<event_handler> s_event_handlers;
+std::vector<timer> s_timers;
+chip::System::Clock::Timestamp s_time = chip::System::Clock::kZero;
+uint32_t s_software_version = 1;
+int s_lock_depth = 0;
+
+std::map<std::string, std::vector<uint8_t>> s_kvs;
+std::string s_kvs_dir;
+size_t s_kvs_write_count = 0;
+
+chip::DeviceLayer::PlatformManager s_platform_mgr;
+chip::DeviceLayer::ConfigurationManager s_configuration_mgr;
+chip::System::Layer s_system_layer;
+chip::System::ClockBase s_clock;
+chip::DeviceLayer::PersistedStorage::KeyValueStoreManager s_kvs_mgr;
+
+std::string kvs_file(const char *key)
+{
+    return s_kvs_dir + "/" + key;
+}
+
+} // namespace
+
+namespace chip {
+namespace System {
+
+Clock::Timestamp ClockBase::GetMonotonicTimestamp()
+{
+    return s_time;
+}
+
+ClockBase &SystemClock()
+{
+    return s_clock;
+}
+
+CHIP_ERROR Layer::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void *appState)
+{
+    CancelTimer(onComplete, appState);
+    s_timers.push_back({s_time + delay, onComplete, appState});
+    return CHIP_NO_ERROR;
+}
+
+void Layer::CancelTimer(TimerCompleteCallback onComplete, void *appState)
+{
+    for (auto it = s_timers.begin(); it != s_timers.end(); ++it) {
+        if (it->on_complete == onComplete && it->app_state == appState) {
+            s_timers.erase(it);
+            return;
+        }
+    }
+}
+
+bool Layer::IsTimerActive(TimerCompleteCallback onComplete, void *appState)
+{
+    for (const timer &t : s_timers) {
+        if (t.on_complete == onComplete && t.app_state == appState) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace System
+
+namespace DeviceLayer {
+
+System::Layer &SystemLayer()
+{
+    return s_system_layer;
+}
+
+CHIP_ERROR PlatformManager::ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg)
+{
+    work_item item = {};
+    item.work = workFunct;
+    item.arg = arg;
+    std::lock_guard<std::mutex> guard(s_work_lock);
+    s_work.push_back(item);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PlatformManager::PostEvent(const ChipDeviceEvent *event)
+{
+    work_item item = {};
+    item.event = *event;
+    std::lock_guard<std::mutex> guard(s_work_lock);
+    s_work.push_back(item);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PlatformManager::AddEventHandler(EventHandlerFunct handler, intptr_t arg)
+{
+    s_event_handlers.push_back({handler, arg});
+    return CHIP_NO_ERROR;
+}
+
+void PlatformManager::LockChipStack()
+{
+    s_lock_depth++;
+}
+
+void PlatformManager::UnlockChipStack()
+{
+    s_lock_depth--;
+}
+
+PlatformManager &PlatformMgr()
+{
+    return s_platform_mgr;
+}
+
+CHIP_ERROR ConfigurationManager::GetSoftwareVersion(uint32_t &softwareVer)
+{
+    softwareVer = s_software_version;
+    return CHIP_NO_ERROR;
+}
+
+ConfigurationManager &ConfigurationMgr()
+{
+    return s_configuration_mgr;
+}
+
+namespace PersistedStorage {
+
+CHIP_ERROR KeyValueStoreManager::Get(const char *key, void *buffer, size_t buffer_size, size_t *read_bytes_size,
+                                     size_t offset)
+{
+    std::vector<uint8_t> value;
+    if (s_kvs_dir.empty()) {
+        auto it = s_kvs.find(key);
+        if (it == s_kvs.end()) {
+            return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+        }
+        value = it->second;
+    } else {
+        FILE *file = fopen(kvs_file(key).c_str(), "rb");
+        if (!file) {
+            return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+        }
+        uint8_t buf[256];
+        size_t len;
+        while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+            value.insert(value.end(), buf, buf + len);
+        }
+        fclose(file);
+    }
+    if (offset > value.size()) {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    size_t len = value.size() - offset < buffer_size ? value.size() - offset : buffer_size;
+    if (len > 0) {
+        memcpy(buffer, value.data() + offset, len);
+    }
+    if (read_bytes_size) {
+        *read_bytes_size = len;
+    }
+    return len < value.size() - offset ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR KeyValueStoreManager::Put(const char *key, const void *value, size_t value_size)
+{
+    s_kvs_write_count++;
+    if (s_kvs_dir.empty()) {
+        const uint8_t *data = static_cast<const uint8_t *>(value);
+        s_kvs[key] = std::vector<uint8_t>(data, data + value_size);
+        return CHIP_NO_ERROR;
+    }
+    FILE *file = fopen(kvs_file(key).c_str(), "wb");
+    if (!file) {
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    bool written = fwrite(value, 1, value_size, file) == value_size;
+    fclose(file);
+    return written ? CHIP_NO_ERROR : CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+}
+
+CHIP_ERROR KeyValueStoreManager::Delete(const char *key)
+{
+    if (s_kvs_dir.empty()) {
+        return s_kvs.erase(key) > 0 ? CHIP_NO_ERROR : CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+    }
+    return remove(kvs_file(key).c_str()) == 0 ? CHIP_NO_ERROR : CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+KeyValueStoreManager &KeyValueStoreMgr()
+{
+    return s_kvs_mgr;
+}
+
+} // namespace PersistedStorage
+
+} // namespace DeviceLayer
+
+// The tests which need an OTA Requestor define their own instance
+__attribute__((weak)) OTARequestorInterface *GetRequestorInstance()
+{
+    return nullptr;
+}
+
+} // namespace chip
+
+namespace host_test {
+
+void set_time_ms(uint64_t time_ms)
+{
+    s_time = chip::System::Clock::Milliseconds64(time_ms);
+}
+
+void advance_time_ms(uint64_t delta_ms)
+{
+    s_time += chip::System::Clock::Milliseconds64(delta_ms);
+}
+
+void set_software_version(uint32_t software_version)
+{
+    s_software_version = software_version;
+}
+
+void set_kvs_dir(const char *dir)
+{
+    s_kvs_dir = dir;
+}
+
+size_t kvs_write_count()
+{
+    return s_kvs_write_count;
+}
+
+bool chip_stack_locked()
+{
+    return s_lock_depth > 0;
+}
+
+bool run_next_work()
+{
+    std::unique_lock<std::mutex> guard(s_work_lock);
+    if (s_work.empty()) {
+        return false;
+    }
+    work_item item = s_work.front();
+    s_work.pop_front();
+    guard.unlock();
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    if (item.work) {
+        item.work(item.arg);
+    } else {
+        // A handler may add handlers
+        std::vector<event_handler> handlers = s_event_handlers;
+        for (const event_handler &handler : handlers) {
+            handler.handler(&item.event, handler.arg);
+        }
+    }
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+    return true;
+}
+
+static bool _run_expired_timer()
+{
+    for (auto it = s_timers.begin(); it != s_timers.end(); ++it) {
+        if (it->deadline <= s_time) {
+            timer expired = *it;
+            s_timers.erase(it);
+            chip::DeviceLayer::PlatformMgr().LockChipStack();
+            expired.on_complete(&s_system_layer, expired.app_state);
+            chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t run_scheduled_work()
+{
+    size_t count = 0;
+    while (run_next_work() || _run_expired_timer()) {
+        count++;
+    }
+    return count;
+}
+
+} // namespace host_test
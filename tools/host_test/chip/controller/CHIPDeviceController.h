@@ -0,0 +1,54 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the commissioner of the Matter SDK, the tests define the functions which pair and commission the
+// devices
+
+#pragma once
+
+#include <controller/CommissioningDelegate.h>
+#include <controller/DevicePairingDelegate.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ErrorStr.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace Controller {
+
+enum class DiscoveryType : uint8_t {
+    kDiscoveryNetworkOnly,
+    kDiscoveryNetworkOnlyWithoutPASEAutoRetry,
+    kAll,
+};
+
+class DeviceCommissioner {
+public:
+    void RegisterPairingDelegate(DevicePairingDelegate *pairingDelegate) { mPairingDelegate = pairingDelegate; }
+    DevicePairingDelegate *GetPairingDelegate() const { return mPairingDelegate; }
+
+    CHIP_ERROR EstablishPASEConnection(NodeId remoteDeviceId, const char *setUpCode,
+                                       DiscoveryType discoveryType = DiscoveryType::kAll);
+    CHIP_ERROR Commission(NodeId remoteDeviceId, CommissioningParameters &params);
+    CHIP_ERROR StopPairing(NodeId remoteDeviceId);
+    CHIP_ERROR GetCompressedFabricIdBytes(MutableByteSpan &outBytes) const;
+
+private:
+    DevicePairingDelegate *mPairingDelegate = nullptr;
+};
+
+} // namespace Controller
+} // namespace chip
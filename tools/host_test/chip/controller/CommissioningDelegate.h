@@ -0,0 +1,98 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the commissioning stages and parameters of the Matter SDK
+
+#pragma once
+
+#include <lib/core/Optional.h>
+#include <lib/support/Span.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Controller {
+
+enum CommissioningStage : uint8_t {
+    kError,
+    kSecurePairing,
+    kReadCommissioningInfo,
+    kArmFailsafe,
+    kConfigRegulatory,
+    kSendPAICertificateRequest,
+    kSendDACCertificateRequest,
+    kSendAttestationRequest,
+    kAttestationVerification,
+    kSendOpCertSigningRequest,
+    kValidateCSR,
+    kGenerateNOCChain,
+    kSendTrustedRootCert,
+    kSendNOC,
+    kWiFiNetworkSetup,
+    kThreadNetworkSetup,
+    kWiFiNetworkEnable,
+    kThreadNetworkEnable,
+    kFindOperationalForCommissioningComplete,
+    kSendComplete,
+    kCleanup,
+};
+
+inline const char *StageToString(CommissioningStage stage)
+{
+    switch (stage) {
+    case kSecurePairing:
+        return "SecurePairing";
+    case kAttestationVerification:
+        return "AttestationVerification";
+    case kSendNOC:
+        return "SendNOC";
+    case kSendComplete:
+        return "SendComplete";
+    case kCleanup:
+        return "Cleanup";
+    default:
+        return "???";
+    }
+}
+
+struct WiFiCredentials {
+    ByteSpan ssid;
+    ByteSpan credentials;
+    WiFiCredentials() {}
+    WiFiCredentials(ByteSpan newSsid, ByteSpan newCreds) : ssid(newSsid), credentials(newCreds) {}
+};
+
+class CommissioningParameters {
+public:
+    const Optional<WiFiCredentials> &GetWiFiCredentials() const { return mWiFiCreds; }
+    const Optional<ByteSpan> &GetThreadOperationalDataset() const { return mThreadOperationalDataset; }
+
+    CommissioningParameters &SetWiFiCredentials(WiFiCredentials wifiCreds)
+    {
+        mWiFiCreds.SetValue(wifiCreds);
+        return *this;
+    }
+    CommissioningParameters &SetThreadOperationalDataset(ByteSpan threadOperationalDataset)
+    {
+        mThreadOperationalDataset.SetValue(threadOperationalDataset);
+        return *this;
+    }
+
+private:
+    Optional<WiFiCredentials> mWiFiCreds;
+    Optional<ByteSpan> mThreadOperationalDataset;
+};
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,43 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the pairing delegate of the Matter SDK
+
+#pragma once
+
+#include <controller/CommissioningDelegate.h>
+#include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <lib/core/PeerId.h>
+
+namespace chip {
+namespace Controller {
+
+class DevicePairingDelegate {
+public:
+    virtual ~DevicePairingDelegate() {}
+
+    virtual void OnPairingComplete(CHIP_ERROR error) {}
+    virtual void OnCommissioningSuccess(PeerId peerId) {}
+    virtual void OnCommissioningFailure(PeerId peerId, CHIP_ERROR error, CommissioningStage stageFailed,
+                                        Optional<Credentials::AttestationVerificationResult> additionalErrorInfo)
+    {
+    }
+    virtual void OnCommissioningStatusUpdate(PeerId peerId, CommissioningStage stageCompleted, CHIP_ERROR error) {}
+};
+
+} // namespace Controller
+} // namespace chip
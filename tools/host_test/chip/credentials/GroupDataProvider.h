@@ -0,0 +1,116 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the group data provider of the Matter SDK, the tests implement the provider
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/Span.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
+
+namespace chip {
+namespace Credentials {
+
+class GroupDataProvider {
+public:
+    enum class SecurityPolicy : uint8_t {
+        kTrustFirst = 0,
+        kCacheAndSync = 1,
+    };
+
+    struct GroupInfo {
+        static constexpr size_t kGroupNameMax = CHIP_CONFIG_MAX_GROUP_NAME_LENGTH;
+
+        GroupId group_id = kUndefinedGroupId;
+        char name[kGroupNameMax + 1] = { 0 };
+
+        GroupInfo() {}
+        GroupInfo(GroupId id, const char *groupName) : group_id(id) { SetName(groupName); }
+        void SetName(const char *groupName)
+        {
+            strncpy(name, groupName ? groupName : "", kGroupNameMax);
+            name[kGroupNameMax] = '\0';
+        }
+    };
+
+    struct GroupKey {
+        GroupKey() = default;
+        GroupKey(GroupId group, KeysetId keyset) : group_id(group), keyset_id(keyset) {}
+
+        GroupId group_id = kUndefinedGroupId;
+        KeysetId keyset_id = 0;
+    };
+
+    struct EpochKey {
+        static constexpr size_t kLengthBytes = 16;
+
+        uint64_t start_time = 0;
+        uint8_t key[kLengthBytes] = { 0 };
+    };
+
+    struct KeySet {
+        static constexpr size_t kEpochKeysMax = 3;
+
+        KeySet() = default;
+        KeySet(KeysetId id, SecurityPolicy policy_id, uint8_t num_keys)
+            : keyset_id(id), policy(policy_id), num_keys_used(num_keys)
+        {
+        }
+
+        EpochKey epoch_keys[kEpochKeysMax];
+        KeysetId keyset_id = 0;
+        SecurityPolicy policy = SecurityPolicy::kCacheAndSync;
+        uint8_t num_keys_used = 0;
+    };
+
+    template <typename T>
+    class Iterator {
+    public:
+        virtual ~Iterator() = default;
+        virtual size_t Count() = 0;
+        virtual bool Next(T &item) = 0;
+        virtual void Release() = 0;
+    };
+
+    using GroupInfoIterator = Iterator<GroupInfo>;
+    using GroupKeyIterator = Iterator<GroupKey>;
+    using KeySetIterator = Iterator<KeySet>;
+
+    virtual ~GroupDataProvider() = default;
+
+    virtual CHIP_ERROR SetGroupInfo(FabricIndex fabric_index, const GroupInfo &info) = 0;
+    virtual CHIP_ERROR RemoveGroupInfo(FabricIndex fabric_index, GroupId group_id) = 0;
+    virtual GroupInfoIterator *IterateGroupInfo(FabricIndex fabric_index) = 0;
+
+    virtual CHIP_ERROR SetGroupKeyAt(FabricIndex fabric_index, size_t index, const GroupKey &info) = 0;
+    virtual CHIP_ERROR RemoveGroupKeyAt(FabricIndex fabric_index, size_t index) = 0;
+    virtual GroupKeyIterator *IterateGroupKeys(FabricIndex fabric_index) = 0;
+
+    virtual CHIP_ERROR SetKeySet(FabricIndex fabric_index, const ByteSpan &compressed_fabric_id, const KeySet &keys) = 0;
+    virtual CHIP_ERROR RemoveKeySet(FabricIndex fabric_index, KeysetId keyset_id) = 0;
+    virtual KeySetIterator *IterateKeySets(FabricIndex fabric_index) = 0;
+};
+
+GroupDataProvider *GetGroupDataProvider();
+
+} // namespace Credentials
+} // namespace chip
@@ -0,0 +1,44 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the attestation trust store interface of the Matter SDK
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Credentials {
+
+enum class AttestationVerificationResult : uint16_t {
+    kSuccess = 0,
+    kPaaUntrusted = 100,
+    kPaaNotFound = 101,
+    kDacSignatureInvalid = 304,
+    kNotImplemented = 0xFFFFU,
+};
+
+class AttestationTrustStore {
+public:
+    virtual ~AttestationTrustStore() = default;
+
+    virtual CHIP_ERROR GetProductAttestationAuthorityCert(const ByteSpan &skid,
+                                                          MutableByteSpan &outPaaDerBuffer) const = 0;
+};
+
+} // namespace Credentials
+} // namespace chip
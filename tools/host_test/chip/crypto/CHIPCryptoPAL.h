@@ -0,0 +1,70 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the certificate functions of the Matter SDK. The host certificates are not X.509 certificates, they
+// are made by the tests: the 'CERT' magic, the attestation certificate type, the subject key identifier and any
+// content.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace chip {
+namespace Crypto {
+
+constexpr size_t kSubjectKeyIdentifierLength = 20;
+
+enum class AttestationCertType : uint8_t {
+    kPAA = 0,
+    kPAI = 1,
+    kDAC = 2,
+};
+
+// Length of the magic and the type of the host certificates
+constexpr size_t kHostCertPrefixLength = 5;
+
+inline bool IsHostCert(const ByteSpan &certificate)
+{
+    return certificate.size() >= kHostCertPrefixLength + kSubjectKeyIdentifierLength &&
+        memcmp(certificate.data(), "CERT", 4) == 0;
+}
+
+inline CHIP_ERROR ExtractSKIDFromX509Cert(const ByteSpan &certificate, MutableByteSpan &skid)
+{
+    if (!IsHostCert(certificate)) {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (skid.size() < kSubjectKeyIdentifierLength) {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+    memcpy(skid.data(), certificate.data() + kHostCertPrefixLength, kSubjectKeyIdentifierLength);
+    skid.reduce_size(kSubjectKeyIdentifierLength);
+    return CHIP_NO_ERROR;
+}
+
+inline CHIP_ERROR VerifyAttestationCertificateFormat(const ByteSpan &cert, AttestationCertType certType)
+{
+    if (!IsHostCert(cert)) {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    return cert.data()[4] == static_cast<uint8_t>(certType) ? CHIP_NO_ERROR : CHIP_ERROR_WRONG_CERT_TYPE;
+}
+
+} // namespace Crypto
+} // namespace chip
@@ -0,0 +1,63 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the CHIP_ERROR of the Matter SDK, for the components tested on Linux
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace chip {
+
+class ChipError {
+public:
+    constexpr ChipError() : mValue(0) {}
+    explicit constexpr ChipError(uint32_t value) : mValue(value) {}
+
+    constexpr bool operator==(const ChipError &other) const { return mValue == other.mValue; }
+    constexpr bool operator!=(const ChipError &other) const { return mValue != other.mValue; }
+    constexpr uint32_t AsInteger() const { return mValue; }
+    constexpr bool IsSuccess() const { return mValue == 0; }
+
+    // The returned string is valid until the next call
+    const char *Format() const
+    {
+        static char buf[16];
+        snprintf(buf, sizeof(buf), "0x%x", static_cast<unsigned>(mValue));
+        return buf;
+    }
+
+private:
+    uint32_t mValue;
+};
+
+} // namespace chip
+
+using CHIP_ERROR = ::chip::ChipError;
+
+#define CHIP_ERROR_FORMAT "s"
+#define CHIP_NO_ERROR CHIP_ERROR(0)
+#define CHIP_ERROR_INCORRECT_STATE CHIP_ERROR(0x03)
+#define CHIP_ERROR_TIMEOUT CHIP_ERROR(0x32)
+#define CHIP_ERROR_NO_MEMORY CHIP_ERROR(0x0b)
+#define CHIP_ERROR_BUFFER_TOO_SMALL CHIP_ERROR(0x19)
+#define CHIP_ERROR_INVALID_ARGUMENT CHIP_ERROR(0x2f)
+#define CHIP_ERROR_NOT_FOUND CHIP_ERROR(0x92)
+#define CHIP_ERROR_CA_CERT_NOT_FOUND CHIP_ERROR(0x4f)
+#define CHIP_ERROR_CANCELLED CHIP_ERROR(0x50)
+#define CHIP_ERROR_WRONG_CERT_TYPE CHIP_ERROR(0x52)
+#define CHIP_ERROR_PERSISTED_STORAGE_FAILED CHIP_ERROR(0x9f)
+#define CHIP_ERROR_INTERNAL CHIP_ERROR(0xac)
+#define CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND CHIP_ERROR(0xa0)
@@ -0,0 +1,33 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the data model types of the Matter SDK
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+
+using VendorId = uint16_t;
+using GroupId = uint16_t;
+using KeysetId = uint16_t;
+
+constexpr GroupId kUndefinedGroupId = 0;
+
+// The highest VendorID, the test vendor 4
+constexpr VendorId kMaxVendorId = 0xFFF4;
+
+} // namespace chip
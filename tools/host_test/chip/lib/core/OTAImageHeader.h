@@ -0,0 +1,79 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the OTA image header parser of the Matter SDK. The host header is the magic (u32), the size of the
+// header (u32) and the size of the payload (u64), little endian, followed by the rest of the header.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace chip {
+
+struct OTAImageHeader {
+    uint64_t mPayloadSize = 0;
+};
+
+class OTAImageHeaderParser {
+public:
+    static constexpr uint32_t kHostHeaderMagic = 0x1BEEF11E;
+    static constexpr size_t kFixedHeaderLen = 16;
+
+    void Init()
+    {
+        mInitialized = true;
+        mLen = 0;
+    }
+    bool IsInitialized() const { return mInitialized; }
+    void Clear() { mInitialized = false; }
+
+    // The header bytes are consumed from the buffer, CHIP_ERROR_BUFFER_TOO_SMALL if the header is not complete
+    CHIP_ERROR AccumulateAndDecode(ByteSpan &buffer, OTAImageHeader &header)
+    {
+        while (!buffer.empty() && (mLen < kFixedHeaderLen || mLen < HeaderLen())) {
+            if (mLen < sizeof(mFixed)) {
+                mFixed[mLen] = buffer.data()[0];
+            }
+            mLen++;
+            buffer = buffer.SubSpan(1);
+        }
+        if (mLen < kFixedHeaderLen || mLen < HeaderLen()) {
+            return CHIP_ERROR_BUFFER_TOO_SMALL;
+        }
+        uint32_t magic;
+        memcpy(&magic, mFixed, sizeof(magic));
+        if (magic != kHostHeaderMagic) {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        memcpy(&header.mPayloadSize, mFixed + 8, sizeof(header.mPayloadSize));
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    uint32_t HeaderLen() const
+    {
+        uint32_t len;
+        memcpy(&len, mFixed + 4, sizeof(len));
+        return len;
+    }
+
+    bool mInitialized = false;
+    size_t mLen = 0;
+    uint8_t mFixed[kFixedHeaderLen];
+};
+
+} // namespace chip
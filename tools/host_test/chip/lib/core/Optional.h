@@ -0,0 +1,56 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the Optional of the Matter SDK
+
+#pragma once
+
+#include <utility>
+
+namespace chip {
+
+template <class T>
+class Optional {
+public:
+    constexpr Optional() : mHasValue(false), mValue() {}
+    explicit Optional(const T &value) : mHasValue(true), mValue(value) {}
+
+    bool HasValue() const { return mHasValue; }
+    const T &Value() const { return mValue; }
+    T &Value() { return mValue; }
+    void SetValue(const T &value)
+    {
+        mValue = value;
+        mHasValue = true;
+    }
+    template <class... Args>
+    T &Emplace(Args &&...args)
+    {
+        mValue = T(std::forward<Args>(args)...);
+        mHasValue = true;
+        return mValue;
+    }
+    void ClearValue()
+    {
+        mValue = T();
+        mHasValue = false;
+    }
+
+private:
+    bool mHasValue;
+    T mValue;
+};
+
+} // namespace chip
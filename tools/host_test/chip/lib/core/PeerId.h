@@ -0,0 +1,47 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the operational peer identifier of the Matter SDK
+
+#pragma once
+
+#include <lib/core/ScopedNodeId.h>
+#include <stdint.h>
+
+namespace chip {
+
+using CompressedFabricId = uint64_t;
+
+class PeerId {
+public:
+    PeerId() {}
+    PeerId(CompressedFabricId compressedFabricId, NodeId nodeId) : mNodeId(nodeId), mCompressedFabricId(compressedFabricId)
+    {
+    }
+
+    NodeId GetNodeId() const { return mNodeId; }
+    PeerId &SetNodeId(NodeId id)
+    {
+        mNodeId = id;
+        return *this;
+    }
+    CompressedFabricId GetCompressedFabricId() const { return mCompressedFabricId; }
+
+private:
+    NodeId mNodeId = kUndefinedNodeId;
+    CompressedFabricId mCompressedFabricId = 0;
+};
+
+} // namespace chip
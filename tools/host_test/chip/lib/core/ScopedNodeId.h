@@ -0,0 +1,48 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the node identifiers of the Matter SDK
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+
+using FabricIndex = uint8_t;
+using NodeId = uint64_t;
+
+constexpr FabricIndex kUndefinedFabricIndex = 0;
+constexpr NodeId kUndefinedNodeId = 0;
+
+class ScopedNodeId {
+public:
+    constexpr ScopedNodeId() : mNodeId(kUndefinedNodeId), mFabricIndex(kUndefinedFabricIndex) {}
+    constexpr ScopedNodeId(NodeId nodeId, FabricIndex fabricIndex) : mNodeId(nodeId), mFabricIndex(fabricIndex) {}
+
+    NodeId GetNodeId() const { return mNodeId; }
+    FabricIndex GetFabricIndex() const { return mFabricIndex; }
+    bool operator==(const ScopedNodeId &other) const
+    {
+        return mNodeId == other.mNodeId && mFabricIndex == other.mFabricIndex;
+    }
+    bool operator!=(const ScopedNodeId &other) const { return !(*this == other); }
+
+private:
+    NodeId mNodeId;
+    FabricIndex mFabricIndex;
+};
+
+} // namespace chip
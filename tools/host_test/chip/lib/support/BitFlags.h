@@ -0,0 +1,47 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the BitFlags of the Matter SDK
+
+#pragma once
+
+#include <type_traits>
+
+namespace chip {
+
+template <typename FlagsEnum, typename StorageType = typename std::underlying_type<FlagsEnum>::type>
+class BitFlags {
+public:
+    BitFlags() : mValue(0) {}
+    BitFlags(FlagsEnum value) : mValue(static_cast<StorageType>(value)) {}
+
+    BitFlags &Set(FlagsEnum flag)
+    {
+        mValue = static_cast<StorageType>(mValue | static_cast<StorageType>(flag));
+        return *this;
+    }
+    BitFlags &Clear(FlagsEnum flag)
+    {
+        mValue = static_cast<StorageType>(mValue & ~static_cast<StorageType>(flag));
+        return *this;
+    }
+    bool Has(FlagsEnum flag) const { return (mValue & static_cast<StorageType>(flag)) != 0; }
+    StorageType Raw() const { return mValue; }
+
+private:
+    StorageType mValue;
+};
+
+} // namespace chip
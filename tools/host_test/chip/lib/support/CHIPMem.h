@@ -0,0 +1,54 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the allocator of the Matter SDK
+
+#pragma once
+
+#include <new>
+#include <stdlib.h>
+#include <utility>
+
+namespace chip {
+namespace Platform {
+
+inline void *MemoryAlloc(size_t size)
+{
+    return malloc(size);
+}
+
+inline void *MemoryCalloc(size_t num, size_t size)
+{
+    return calloc(num, size);
+}
+
+inline void MemoryFree(void *ptr)
+{
+    free(ptr);
+}
+
+template <typename T, typename... Args>
+inline T *New(Args &&...args)
+{
+    return new (std::nothrow) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+inline void Delete(T *p)
+{
+    delete p;
+}
+
+} // namespace Platform
+} // namespace chip
@@ -0,0 +1,35 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the string helpers of the Matter SDK
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+namespace chip {
+namespace Platform {
+
+inline void CopyString(char *dest, size_t destSize, const char *source)
+{
+    if (dest && destSize > 0) {
+        strncpy(dest, source, destSize - 1);
+        dest[destSize - 1] = '\0';
+    }
+}
+
+} // namespace Platform
+} // namespace chip
@@ -0,0 +1,60 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the error check macros of the Matter SDK
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#define ReturnErrorOnFailure(expr)                                                                                     \
+    do {                                                                                                               \
+        CHIP_ERROR __err = (expr);                                                                                     \
+        if (__err != CHIP_NO_ERROR) {                                                                                  \
+            return __err;                                                                                              \
+        }                                                                                                              \
+    } while (false)
+
+#define ReturnErrorCodeIf(expr, code)                                                                                  \
+    do {                                                                                                               \
+        if (expr) {                                                                                                    \
+            return code;                                                                                               \
+        }                                                                                                              \
+    } while (false)
+
+#define VerifyOrReturn(expr, ...)                                                                                      \
+    do {                                                                                                               \
+        if (!(expr)) {                                                                                                 \
+            __VA_ARGS__;                                                                                               \
+            return;                                                                                                    \
+        }                                                                                                              \
+    } while (false)
+
+#define VerifyOrReturnError(expr, code, ...)                                                                           \
+    do {                                                                                                               \
+        if (!(expr)) {                                                                                                 \
+            __VA_ARGS__;                                                                                               \
+            return code;                                                                                               \
+        }                                                                                                              \
+    } while (false)
+
+#define VerifyOrReturnValue(expr, value, ...) VerifyOrReturnError(expr, value, ##__VA_ARGS__)
+
+#define SuccessOrExit(expr)                                                                                            \
+    do {                                                                                                               \
+        if ((expr) != CHIP_NO_ERROR) {                                                                                 \
+            goto exit;                                                                                                 \
+        }                                                                                                              \
+    } while (false)
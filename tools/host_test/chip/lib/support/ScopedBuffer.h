@@ -0,0 +1,58 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the scoped buffers of the Matter SDK
+
+#pragma once
+
+#include <lib/support/CHIPMem.h>
+#include <stddef.h>
+
+namespace chip {
+namespace Platform {
+
+template <typename T>
+class ScopedMemoryBufferWithSize {
+public:
+    ScopedMemoryBufferWithSize() = default;
+    ScopedMemoryBufferWithSize(const ScopedMemoryBufferWithSize &) = delete;
+    ScopedMemoryBufferWithSize &operator=(const ScopedMemoryBufferWithSize &) = delete;
+    ~ScopedMemoryBufferWithSize() { Free(); }
+
+    ScopedMemoryBufferWithSize &Calloc(size_t elementCount)
+    {
+        Free();
+        mBuffer = static_cast<T *>(MemoryCalloc(elementCount, sizeof(T)));
+        mCount = mBuffer ? elementCount : 0;
+        return *this;
+    }
+    void Free()
+    {
+        MemoryFree(mBuffer);
+        mBuffer = nullptr;
+        mCount = 0;
+    }
+
+    T *Get() const { return mBuffer; }
+    size_t AllocatedSize() const { return mCount; }
+    T &operator[](size_t index) const { return mBuffer[index]; }
+
+private:
+    T *mBuffer = nullptr;
+    size_t mCount = 0;
+};
+
+} // namespace Platform
+} // namespace chip
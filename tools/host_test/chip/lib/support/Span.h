@@ -0,0 +1,78 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the spans of the Matter SDK
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace chip {
+
+template <class T>
+class Span {
+public:
+    constexpr Span() : mData(nullptr), mDataLen(0) {}
+    constexpr Span(T *data, size_t size) : mData(data), mDataLen(size) {}
+    template <size_t N>
+    constexpr Span(T (&array)[N]) : mData(array), mDataLen(N) {}
+    template <class U>
+    constexpr Span(const Span<U> &other) : mData(other.data()), mDataLen(other.size()) {}
+
+    constexpr T *data() const { return mData; }
+    constexpr size_t size() const { return mDataLen; }
+    constexpr bool empty() const { return mDataLen == 0; }
+    constexpr T *begin() const { return mData; }
+    constexpr T *end() const { return mData + mDataLen; }
+    T &operator[](size_t index) const { return mData[index]; }
+
+    Span SubSpan(size_t offset) const { return Span(mData + offset, mDataLen - offset); }
+    Span SubSpan(size_t offset, size_t length) const { return Span(mData + offset, length); }
+    void reduce_size(size_t size) { mDataLen = size < mDataLen ? size : mDataLen; }
+
+    bool data_equal(const Span<const T> &other) const
+    {
+        return mDataLen == other.size() && (mDataLen == 0 || memcmp(mData, other.data(), mDataLen) == 0);
+    }
+
+private:
+    T *mData;
+    size_t mDataLen;
+};
+
+using ByteSpan = Span<const uint8_t>;
+using MutableByteSpan = Span<uint8_t>;
+using CharSpan = Span<const char>;
+using MutableCharSpan = Span<char>;
+
+template <class T>
+inline bool IsSpanUsable(const Span<T> &span)
+{
+    return span.data() != nullptr && span.size() > 0;
+}
+
+inline CHIP_ERROR CopySpanToMutableSpan(ByteSpan span_to_copy, MutableByteSpan &out_buf)
+{
+    if (out_buf.size() < span_to_copy.size()) {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+    memcpy(out_buf.data(), span_to_copy.data(), span_to_copy.size());
+    out_buf.reduce_size(span_to_copy.size());
+    return CHIP_NO_ERROR;
+}
+
+} // namespace chip
@@ -0,0 +1,24 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the logging macros of the Matter SDK, the logs are printed to stderr
+
+#pragma once
+
+#include <stdio.h>
+
+#define ChipLogError(MOD, MSG, ...) fprintf(stderr, "E " #MOD ": " MSG "\n", ##__VA_ARGS__)
+#define ChipLogProgress(MOD, MSG, ...) fprintf(stderr, "I " #MOD ": " MSG "\n", ##__VA_ARGS__)
+#define ChipLogDetail(MOD, MSG, ...) fprintf(stderr, "D " #MOD ": " MSG "\n", ##__VA_ARGS__)
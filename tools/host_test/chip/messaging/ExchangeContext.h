@@ -0,0 +1,86 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the exchange contexts of the Matter SDK. The test creates the exchange of a peer node, the messages
+// sent on it are recorded and Close() only marks it closed.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <lib/core/ScopedNodeId.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/Flags.h>
+#include <protocols/Protocols.h>
+#include <stdint.h>
+#include <system/SystemPacketBuffer.h>
+#include <vector>
+
+namespace chip {
+
+class Session {
+public:
+    explicit Session(const ScopedNodeId &peer) : mPeer(peer) {}
+    ScopedNodeId GetPeer() const { return mPeer; }
+
+private:
+    ScopedNodeId mPeer;
+};
+
+class SessionHandle {
+public:
+    explicit SessionHandle(const Session &session) : mSession(session) {}
+    const Session *operator->() const { return &mSession; }
+
+private:
+    const Session &mSession;
+};
+
+namespace Messaging {
+
+class ExchangeContext {
+public:
+    struct SentMessage {
+        Protocols::Id protocolId;
+        uint8_t msgType;
+        bool expectResponse;
+    };
+
+    explicit ExchangeContext(const ScopedNodeId &peer) : mSession(peer) {}
+
+    CHIP_ERROR SendMessage(Protocols::Id protocolId, uint8_t msgType, System::PacketBufferHandle &&msgBuf,
+                           const SendFlags &sendFlags)
+    {
+        mSentMessages.push_back({protocolId, msgType, sendFlags.Has(SendMessageFlags::kExpectResponse)});
+        return CHIP_NO_ERROR;
+    }
+    void Close() { mClosed = true; }
+    SessionHandle GetSessionHandle() const { return SessionHandle(mSession); }
+    ExchangeDelegate *GetDelegate() const { return mDelegate; }
+    void SetDelegate(ExchangeDelegate *delegate) { mDelegate = delegate; }
+
+    // Recorded for the tests
+    const std::vector<SentMessage> &GetSentMessages() const { return mSentMessages; }
+    bool IsClosed() const { return mClosed; }
+
+private:
+    Session mSession;
+    ExchangeDelegate *mDelegate = nullptr;
+    std::vector<SentMessage> mSentMessages;
+    bool mClosed = false;
+};
+
+} // namespace Messaging
+} // namespace chip
@@ -0,0 +1,47 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the exchange delegates of the Matter SDK
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/MessageHeader.h>
+
+namespace chip {
+namespace Messaging {
+
+class ExchangeContext;
+
+class ExchangeDelegate {
+public:
+    virtual ~ExchangeDelegate() {}
+    virtual CHIP_ERROR OnMessageReceived(ExchangeContext *ec, const PayloadHeader &payloadHeader,
+                                         System::PacketBufferHandle &&payload) = 0;
+    virtual void OnResponseTimeout(ExchangeContext *ec) = 0;
+    virtual void OnExchangeClosing(ExchangeContext *ec) {}
+};
+
+class UnsolicitedMessageHandler {
+public:
+    virtual ~UnsolicitedMessageHandler() {}
+    virtual CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader &payloadHeader,
+                                                    ExchangeDelegate *&newDelegate) = 0;
+    virtual void OnExchangeCreationFailed(ExchangeDelegate *delegate) {}
+};
+
+} // namespace Messaging
+} // namespace chip
@@ -0,0 +1,63 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the exchange manager of the Matter SDK. The messages are delivered by the test with
+// ReceiveMessage(), to the delegate of their exchange or to the unsolicited message handler of their protocol.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <protocols/Protocols.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/MessageHeader.h>
+#include <utility>
+
+namespace chip {
+namespace Messaging {
+
+class ExchangeManager {
+public:
+    CHIP_ERROR RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId,
+                                                            UnsolicitedMessageHandler *handler)
+    {
+        mProtocolId = protocolId;
+        mHandler = handler;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR ReceiveMessage(ExchangeContext *ec, Protocols::Id protocolId, System::PacketBufferHandle &&payload)
+    {
+        PayloadHeader payloadHeader;
+        if (!ec->GetDelegate()) {
+            if (!mHandler || protocolId != mProtocolId) {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            ExchangeDelegate *delegate = nullptr;
+            ReturnErrorOnFailure(mHandler->OnUnsolicitedMessageReceived(payloadHeader, delegate));
+            ec->SetDelegate(delegate);
+        }
+        return ec->GetDelegate()->OnMessageReceived(ec, payloadHeader, std::move(payload));
+    }
+
+private:
+    Protocols::Id mProtocolId = Protocols::NotSpecified;
+    UnsolicitedMessageHandler *mHandler = nullptr;
+};
+
+} // namespace Messaging
+} // namespace chip
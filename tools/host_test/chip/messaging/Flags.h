@@ -0,0 +1,34 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the message send flags of the Matter SDK
+
+#pragma once
+
+#include <lib/support/BitFlags.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Messaging {
+
+enum class SendMessageFlags : uint16_t {
+    kNone = 0x0000,
+    kExpectResponse = 0x0001,
+};
+
+using SendFlags = BitFlags<SendMessageFlags>;
+
+} // namespace Messaging
+} // namespace chip
@@ -0,0 +1,90 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the platform manager of the Matter SDK. The scheduled work and the posted events are run by
+// host_test::run_scheduled_work(), in the order they were scheduled or posted.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+#include <stdint.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+enum OtaState {
+    kOtaSpaceAvailable = 0,
+    kOtaDownloadInProgress,
+    kOtaDownloadComplete,
+    kOtaDownloadFailed,
+    kOtaDownloadAborted,
+    kOtaApplyInProgress,
+    kOtaApplyComplete,
+    kOtaApplyFailed,
+};
+
+namespace DeviceEventType {
+enum {
+    kOtaStateChanged = 0x8000,
+};
+} // namespace DeviceEventType
+
+struct ChipDeviceEvent {
+    uint16_t Type;
+    union {
+        struct {
+            OtaState newState;
+        } OtaStateChanged;
+    };
+};
+
+typedef void (*AsyncWorkFunct)(intptr_t arg);
+typedef void (*EventHandlerFunct)(const ChipDeviceEvent *event, intptr_t arg);
+
+class PlatformManager {
+public:
+    CHIP_ERROR ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg = 0);
+    CHIP_ERROR PostEvent(const ChipDeviceEvent *event);
+    CHIP_ERROR AddEventHandler(EventHandlerFunct handler, intptr_t arg = 0);
+    void LockChipStack();
+    void UnlockChipStack();
+};
+
+PlatformManager &PlatformMgr();
+
+class ConfigurationManager {
+public:
+    CHIP_ERROR GetSoftwareVersion(uint32_t &softwareVer);
+};
+
+ConfigurationManager &ConfigurationMgr();
+
+} // namespace DeviceLayer
+} // namespace chip
+
+namespace host_test {
+// Run the scheduled work, the posted events and the expired timers until there are none left, returns the count of
+// the work items, events and timers run
+size_t run_scheduled_work();
+// Run the next scheduled work item or event only, returns false if there is none
+bool run_next_work();
+// The software version returned by the configuration manager, 1 by default
+void set_software_version(uint32_t software_version);
+// Whether the Matter stack is locked, by a work item, an event handler or LockChipStack()
+bool chip_stack_locked();
+} // namespace host_test
@@ -0,0 +1,37 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the ESP32 utilities of the Matter SDK
+
+#pragma once
+
+#include <esp_err.h>
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ESP32Utils {
+public:
+    static CHIP_ERROR MapError(esp_err_t error)
+    {
+        return error == ESP_OK ? CHIP_NO_ERROR : CHIP_ERROR(0x02000000 | static_cast<uint32_t>(error));
+    }
+};
+
+} // namespace Internal
+using Internal::ESP32Utils;
+} // namespace DeviceLayer
+} // namespace chip
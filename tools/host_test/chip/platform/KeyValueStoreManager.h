@@ -0,0 +1,46 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the key value store of the Matter SDK. The values are kept in memory, or in the files of the
+// directory set with host_test::set_kvs_dir() so that they persist across the runs of a test program.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <stddef.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace PersistedStorage {
+
+class KeyValueStoreManager {
+public:
+    CHIP_ERROR Get(const char *key, void *buffer, size_t buffer_size, size_t *read_bytes_size = nullptr,
+                   size_t offset = 0);
+    CHIP_ERROR Put(const char *key, const void *value, size_t value_size);
+    CHIP_ERROR Delete(const char *key);
+};
+
+KeyValueStoreManager &KeyValueStoreMgr();
+
+} // namespace PersistedStorage
+} // namespace DeviceLayer
+} // namespace chip
+
+namespace host_test {
+void set_kvs_dir(const char *dir);
+// Count of the Put() calls, to check the flash writes
+size_t kvs_write_count();
+} // namespace host_test
@@ -0,0 +1,47 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the OTA image processor interface of the Matter SDK
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <stdint.h>
+
+namespace chip {
+
+struct OTAImageProgress {
+    uint64_t downloadedBytes = 0;
+    uint64_t totalFileBytes = 0;
+};
+
+class OTAImageProcessorInterface {
+public:
+    virtual ~OTAImageProcessorInterface() = default;
+
+    virtual CHIP_ERROR PrepareDownload() = 0;
+    virtual CHIP_ERROR Finalize() = 0;
+    virtual CHIP_ERROR Apply() = 0;
+    virtual CHIP_ERROR Abort() = 0;
+    virtual CHIP_ERROR ProcessBlock(ByteSpan &block) = 0;
+    virtual bool IsFirstImageRun() = 0;
+    virtual CHIP_ERROR ConfirmCurrentImage() = 0;
+    virtual uint64_t GetBytesDownloaded() { return mParams.downloadedBytes; }
+
+protected:
+    OTAImageProgress mParams;
+};
+
+} // namespace chip
@@ -0,0 +1,55 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the protocol identifiers of the Matter SDK
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+namespace Protocols {
+
+class Id {
+public:
+    constexpr Id(uint16_t vendorId, uint16_t protocolId) : mVendorId(vendorId), mProtocolId(protocolId) {}
+
+    constexpr bool operator==(const Id &other) const
+    {
+        return mVendorId == other.mVendorId && mProtocolId == other.mProtocolId;
+    }
+    constexpr bool operator!=(const Id &other) const { return !(*this == other); }
+    constexpr uint16_t GetProtocolId() const { return mProtocolId; }
+
+private:
+    uint16_t mVendorId;
+    uint16_t mProtocolId;
+};
+
+constexpr Id NotSpecified(0xFFFF, 0xFFFF);
+
+namespace SecureChannel {
+constexpr Id Id(0, 0x0000);
+enum class MsgType : uint8_t {
+    StatusReport = 0x40,
+};
+} // namespace SecureChannel
+
+namespace BDX {
+constexpr Id Id(0, 0x0002);
+} // namespace BDX
+
+} // namespace Protocols
+} // namespace chip
@@ -0,0 +1,282 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the BDX transfer session of the Matter SDK, for the sender role of the receiver drive mode. The
+// first byte of the received payloads is the BDX message type: ReceiveInit, followed by the StartOffset as a little
+// endian uint64 if the transfer is resumed, BlockQuery or BlockAckEOF, or it is the SecureChannel StatusReport,
+// followed by the little endian status code. The sent messages carry no payload.
+
+#pragma once
+
+#include <deque>
+#include <lib/core/CHIPError.h>
+#include <lib/support/BitFlags.h>
+#include <protocols/Protocols.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/MessageHeader.h>
+#include <utility>
+
+namespace chip {
+namespace bdx {
+
+enum class MessageType : uint8_t {
+    ReceiveInit = 0x04,
+    ReceiveAccept = 0x05,
+    BlockQuery = 0x10,
+    Block = 0x11,
+    BlockEOF = 0x12,
+    BlockAckEOF = 0x14,
+};
+
+enum class StatusCode : uint16_t {
+    kUnexpectedMessage = 0x0018,
+    kUnknown = 0x005F,
+};
+
+enum class TransferControlFlags : uint8_t {
+    kSenderDrive = 0x10,
+    kReceiverDrive = 0x20,
+    kAsync = 0x40,
+};
+
+enum class TransferRole : uint8_t {
+    kReceiver = 0,
+    kSender = 1,
+};
+
+class TransferSession {
+public:
+    enum class OutputEventType : uint16_t {
+        kNone = 0,
+        kMsgToSend,
+        kInitReceived,
+        kAcceptReceived,
+        kBlockReceived,
+        kQueryReceived,
+        kQueryWithSkipReceived,
+        kAckReceived,
+        kAckEOFReceived,
+        kStatusReceived,
+        kInternalError,
+        kTransferTimeout,
+    };
+
+    struct MessageTypeData {
+        Protocols::Id ProtocolId = Protocols::NotSpecified;
+        uint8_t MessageType = 0;
+
+        bool HasMessageType(Protocols::SecureChannel::MsgType type) const
+        {
+            return ProtocolId == Protocols::SecureChannel::Id && MessageType == static_cast<uint8_t>(type);
+        }
+    };
+
+    struct StatusReportData {
+        StatusCode statusCode = StatusCode::kUnknown;
+    };
+
+    struct OutputEvent {
+        OutputEventType EventType = OutputEventType::kNone;
+        System::PacketBufferHandle MsgData;
+        MessageTypeData msgTypeData;
+        StatusReportData statusData;
+
+        static const char *ToString(OutputEventType outputEventType)
+        {
+            static const char *const names[] = {"None",          "MsgToSend",       "InitReceived",
+                                                "AcceptReceived", "BlockReceived",   "QueryReceived",
+                                                "QueryWithSkipReceived", "AckReceived", "AckEOFReceived",
+                                                "StatusReceived", "InternalError",  "TransferTimeout"};
+            return names[static_cast<uint16_t>(outputEventType)];
+        }
+    };
+
+    struct TransferAcceptData {
+        TransferControlFlags ControlMode = TransferControlFlags::kReceiverDrive;
+        uint16_t MaxBlockSize = 0;
+        uint64_t StartOffset = 0;
+        uint64_t Length = 0;
+    };
+
+    struct BlockData {
+        const uint8_t *Data = nullptr;
+        size_t Length = 0;
+        bool IsEof = false;
+    };
+
+    CHIP_ERROR WaitForTransfer(TransferRole role, BitFlags<TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
+                               System::Clock::Timeout timeout)
+    {
+        if (mState != State::kUnitialized) {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+        mMaxBlockSize = maxBlockSize;
+        mState = State::kAwaitingInitMsg;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR HandleMessageReceived(const PayloadHeader &payloadHeader, System::PacketBufferHandle msg,
+                                     System::Clock::Timestamp curTime)
+    {
+        if (msg.IsNull() || msg->DataLength() == 0) {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        const uint8_t *data = msg->Start();
+        size_t length = msg->DataLength();
+        if (data[0] == static_cast<uint8_t>(Protocols::SecureChannel::MsgType::StatusReport)) {
+            uint16_t code = static_cast<uint16_t>(StatusCode::kUnknown);
+            if (length >= 3) {
+                code = static_cast<uint16_t>(data[1] | (data[2] << 8));
+            }
+            OutputEvent event;
+            event.EventType = OutputEventType::kStatusReceived;
+            event.statusData.statusCode = static_cast<StatusCode>(code);
+            mState = State::kErrorState;
+            mPendingOutput.push_back(std::move(event));
+            return CHIP_NO_ERROR;
+        }
+        switch (static_cast<MessageType>(data[0])) {
+        case MessageType::ReceiveInit:
+            if (mState != State::kAwaitingInitMsg) {
+                break;
+            }
+            mStartOffset = 0;
+            if (length >= 9) {
+                for (int i = 0; i < 8; ++i) {
+                    mStartOffset |= static_cast<uint64_t>(data[1 + i]) << (8 * i);
+                }
+            }
+            mState = State::kNegotiateTransferParams;
+            PushEvent(OutputEventType::kInitReceived);
+            return CHIP_NO_ERROR;
+        case MessageType::BlockQuery:
+            if (mState != State::kTransferInProgress || mAwaitingQuery == false) {
+                break;
+            }
+            mAwaitingQuery = false;
+            PushEvent(OutputEventType::kQueryReceived);
+            return CHIP_NO_ERROR;
+        case MessageType::BlockAckEOF:
+            if (mState != State::kAwaitingEOFAck) {
+                break;
+            }
+            mState = State::kTransferDone;
+            PushEvent(OutputEventType::kAckEOFReceived);
+            return CHIP_NO_ERROR;
+        default:
+            break;
+        }
+        AbortTransfer(StatusCode::kUnexpectedMessage);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR AcceptTransfer(const TransferAcceptData &acceptData)
+    {
+        if (mState != State::kNegotiateTransferParams) {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+        mStartOffset = acceptData.StartOffset;
+        mState = State::kTransferInProgress;
+        mAwaitingQuery = true;
+        PushMessage(Protocols::BDX::Id, static_cast<uint8_t>(MessageType::ReceiveAccept));
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR PrepareBlock(const BlockData &inData)
+    {
+        if (mState != State::kTransferInProgress || mAwaitingQuery || inData.Length > mMaxBlockSize) {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+        mAwaitingQuery = true;
+        if (inData.IsEof) {
+            mState = State::kAwaitingEOFAck;
+        }
+        PushMessage(Protocols::BDX::Id,
+                    static_cast<uint8_t>(inData.IsEof ? MessageType::BlockEOF : MessageType::Block));
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR AbortTransfer(StatusCode reason)
+    {
+        mState = State::kErrorState;
+        PushMessage(Protocols::SecureChannel::Id,
+                    static_cast<uint8_t>(Protocols::SecureChannel::MsgType::StatusReport));
+        return CHIP_NO_ERROR;
+    }
+
+    void PollOutput(OutputEvent &event, System::Clock::Timestamp curTime)
+    {
+        if (mPendingOutput.empty()) {
+            event = OutputEvent();
+            return;
+        }
+        event = std::move(mPendingOutput.front());
+        mPendingOutput.pop_front();
+    }
+
+    void Reset()
+    {
+        mState = State::kUnitialized;
+        mMaxBlockSize = 0;
+        mStartOffset = 0;
+        mAwaitingQuery = false;
+        mPendingOutput.clear();
+    }
+
+    uint16_t GetTransferBlockSize() const { return mMaxBlockSize; }
+    uint64_t GetStartOffset() const { return mStartOffset; }
+    uint64_t GetTransferLength() const { return 0; }
+
+private:
+    enum class State : uint8_t {
+        kUnitialized,
+        kAwaitingInitMsg,
+        kNegotiateTransferParams,
+        kTransferInProgress,
+        kAwaitingEOFAck,
+        kTransferDone,
+        kErrorState,
+    };
+
+    void PushEvent(OutputEventType type)
+    {
+        OutputEvent event;
+        event.EventType = type;
+        mPendingOutput.push_back(std::move(event));
+    }
+
+    void PushMessage(Protocols::Id protocolId, uint8_t msgType)
+    {
+        OutputEvent event;
+        event.EventType = OutputEventType::kMsgToSend;
+        event.msgTypeData.ProtocolId = protocolId;
+        event.msgTypeData.MessageType = msgType;
+        event.MsgData = System::PacketBufferHandle::New(0);
+        mPendingOutput.push_back(std::move(event));
+    }
+
+    State mState = State::kUnitialized;
+    uint16_t mMaxBlockSize = 0;
+    uint64_t mStartOffset = 0;
+    bool mAwaitingQuery = false;
+    std::deque<OutputEvent> mPendingOutput;
+};
+
+} // namespace bdx
+} // namespace chip
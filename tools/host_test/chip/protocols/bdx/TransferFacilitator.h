@@ -0,0 +1,82 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the BDX responder of the Matter SDK, the transfers do not time out
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/BitFlags.h>
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <protocols/bdx/BdxTransferSession.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <utility>
+
+namespace chip {
+namespace bdx {
+
+class TransferFacilitator : public Messaging::ExchangeDelegate {
+public:
+    virtual ~TransferFacilitator() {}
+
+protected:
+    CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext *ec, const PayloadHeader &payloadHeader,
+                                 System::PacketBufferHandle &&payload) override
+    {
+        if (mExchangeCtx == nullptr) {
+            mExchangeCtx = ec;
+        }
+        CHIP_ERROR err = mTransfer.HandleMessageReceived(payloadHeader, std::move(payload),
+                                                         System::SystemClock().GetMonotonicTimestamp());
+        PollForOutput();
+        return err;
+    }
+
+    void OnResponseTimeout(Messaging::ExchangeContext *ec) override {}
+
+    virtual void HandleTransferSessionOutput(TransferSession::OutputEvent &event) = 0;
+
+    void PollForOutput()
+    {
+        TransferSession::OutputEvent outEvent;
+        do {
+            mTransfer.PollOutput(outEvent, System::SystemClock().GetMonotonicTimestamp());
+            HandleTransferSessionOutput(outEvent);
+        } while (outEvent.EventType != TransferSession::OutputEventType::kNone);
+    }
+
+    void ResetTransfer() { mTransfer.Reset(); }
+
+    TransferSession mTransfer;
+    Messaging::ExchangeContext *mExchangeCtx = nullptr;
+};
+
+class Responder : public TransferFacilitator {
+public:
+    CHIP_ERROR PrepareForTransfer(System::Layer *layer, TransferRole role, BitFlags<TransferControlFlags> xferControlOpts,
+                                  uint16_t maxBlockSize, System::Clock::Timeout timeout,
+                                  System::Clock::Timeout pollFreq = System::Clock::Timeout(500))
+    {
+        VerifyOrReturnError(layer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        return mTransfer.WaitForTransfer(role, xferControlOpts, maxBlockSize, timeout);
+    }
+};
+
+} // namespace bdx
+} // namespace chip
@@ -0,0 +1,52 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the clock of the Matter SDK, the time starts at 0 and is moved by the test
+
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+
+namespace chip {
+namespace System {
+namespace Clock {
+
+using Milliseconds64 = std::chrono::duration<uint64_t, std::milli>;
+using Milliseconds32 = std::chrono::duration<uint32_t, std::milli>;
+using Seconds16 = std::chrono::duration<uint16_t>;
+using Seconds32 = std::chrono::duration<uint32_t>;
+using Timestamp = Milliseconds64;
+using Timeout = Milliseconds64;
+
+constexpr Timestamp kZero{0};
+
+} // namespace Clock
+
+class ClockBase {
+public:
+    Clock::Timestamp GetMonotonicTimestamp();
+    Clock::Milliseconds64 GetMonotonicMilliseconds64() { return GetMonotonicTimestamp(); }
+};
+
+ClockBase &SystemClock();
+
+} // namespace System
+} // namespace chip
+
+namespace host_test {
+// Set the time of the clock of the Matter SDK, in milliseconds
+void set_time_ms(uint64_t time_ms);
+void advance_time_ms(uint64_t delta_ms);
+} // namespace host_test
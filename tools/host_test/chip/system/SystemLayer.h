@@ -0,0 +1,41 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the system layer timers of the Matter SDK. The timers fire from host_test::run_scheduled_work() when
+// the time set with host_test::set_time_ms() reaches them.
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace System {
+
+class Layer;
+using TimerCompleteCallback = void (*)(Layer *aLayer, void *appState);
+
+class Layer {
+public:
+    CHIP_ERROR StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void *appState);
+    void CancelTimer(TimerCompleteCallback onComplete, void *appState);
+    bool IsTimerActive(TimerCompleteCallback onComplete, void *appState);
+};
+
+} // namespace System
+
+namespace DeviceLayer {
+System::Layer &SystemLayer();
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,82 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the packet buffers of the Matter SDK, the buffers are allocated on the heap
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+namespace chip {
+namespace System {
+
+class PacketBuffer {
+public:
+    explicit PacketBuffer(size_t size) : mData(size) {}
+
+    uint8_t *Start() { return mData.data(); }
+    size_t DataLength() const { return mDataLength; }
+    void SetDataLength(size_t length) { mDataLength = length; }
+    size_t AvailableDataLength() const { return mData.size() - mDataLength; }
+
+private:
+    std::vector<uint8_t> mData;
+    size_t mDataLength = 0;
+};
+
+class PacketBufferHandle {
+public:
+    PacketBufferHandle() = default;
+    PacketBufferHandle(PacketBufferHandle &&other) : mBuffer(other.mBuffer) { other.mBuffer = nullptr; }
+    PacketBufferHandle &operator=(PacketBufferHandle &&other)
+    {
+        if (this != &other) {
+            delete mBuffer;
+            mBuffer = other.mBuffer;
+            other.mBuffer = nullptr;
+        }
+        return *this;
+    }
+    PacketBufferHandle(const PacketBufferHandle &) = delete;
+    PacketBufferHandle &operator=(const PacketBufferHandle &) = delete;
+    ~PacketBufferHandle() { delete mBuffer; }
+
+    static PacketBufferHandle New(size_t availableSize)
+    {
+        PacketBufferHandle handle;
+        handle.mBuffer = new PacketBuffer(availableSize);
+        return handle;
+    }
+    static PacketBufferHandle NewWithData(const void *data, size_t dataLen)
+    {
+        PacketBufferHandle handle = New(dataLen);
+        memcpy(handle->Start(), data, dataLen);
+        handle->SetDataLength(dataLen);
+        return handle;
+    }
+
+    bool IsNull() const { return mBuffer == nullptr; }
+    PacketBuffer *operator->() const { return mBuffer; }
+
+private:
+    PacketBuffer *mBuffer = nullptr;
+};
+
+} // namespace System
+} // namespace chip
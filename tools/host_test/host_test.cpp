@@ -0,0 +1,556 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <condition_variable>
+#include <deque>
+#include <esp_err.h>
+#include <esp_heap_caps.h>
+#include <esp_matter_mem.h>
+#include <esp_rom_crc.h>
+#include <esp_spiffs.h>
+#include <esp_timer.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <mbedtls/base64.h>
+#include <mbedtls/sha256.h>
+#include <mutex>
+#include <nvs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The size of each allocation is stored before it to count the bytes in use
+static constexpr size_t mem_header_len = sizeof(max_align_t);
+static size_t s_mem_in_use = 0;
+static size_t s_mem_peak = 0;
+
+void *esp_matter_mem_calloc(size_t n, size_t size)
+{
+    size_t len = n * size;
+    uint8_t *ptr = (uint8_t *)calloc(1, mem_header_len + len);
+    if (!ptr) {
+        return nullptr;
+    }
+    memcpy(ptr, &len, sizeof(len));
+    s_mem_in_use += len;
+    if (s_mem_in_use > s_mem_peak) {
+        s_mem_peak = s_mem_in_use;
+    }
+    return ptr + mem_header_len;
+}
+
+void esp_matter_mem_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    uint8_t *header = (uint8_t *)ptr - mem_header_len;
+    size_t len;
+    memcpy(&len, header, sizeof(len));
+    s_mem_in_use -= len;
+    free(header);
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t index = 0; index < len; ++index) {
+        crc ^= buf[index];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static std::string s_spiffs_dir;
+static std::string s_spiffs_base_path;
+static size_t s_spiffs_access_count = 0;
+
+esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t *conf)
+{
+    if (s_spiffs_dir.empty()) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (!s_spiffs_base_path.empty()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_spiffs_base_path = conf->base_path;
+    return ESP_OK;
+}
+
+esp_err_t esp_vfs_spiffs_unregister(const char *partition_label)
+{
+    s_spiffs_base_path.clear();
+    return ESP_OK;
+}
+
+esp_err_t esp_spiffs_info(const char *partition_label, size_t *total_bytes, size_t *used_bytes)
+{
+    *total_bytes = 0;
+    *used_bytes = 0;
+    return s_spiffs_base_path.empty() ? ESP_ERR_INVALID_STATE : ESP_OK;
+}
+
+static size_t s_free_heap_size = 256 * 1024;
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return s_free_heap_size;
+}
+
+static int64_t s_timer_time_us = 0;
+
+int64_t esp_timer_get_time()
+{
+    return s_timer_time_us;
+}
+
+struct host_queue {
+    size_t length;
+    size_t item_size;
+    std::deque<std::vector<uint8_t>> items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    return new host_queue{length, item_size, {}};
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+    if (queue->items.size() >= queue->length) {
+        return pdFALSE;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(item);
+    queue->items.emplace_back(bytes, bytes + queue->item_size);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks_to_wait)
+{
+    if (queue->items.empty()) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    return pdTRUE;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+struct host_task {
+    std::mutex lock;
+    std::condition_variable notified;
+    uint32_t notifications;
+};
+
+static bool s_run_tasks = false;
+static thread_local host_task *s_current_task = nullptr;
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack_depth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *created_task)
+{
+    if (!s_run_tasks) {
+        if (created_task) {
+            *created_task = nullptr;
+        }
+        return pdPASS;
+    }
+    // The tasks run until the end of the test, as on the device
+    host_task *task = new host_task();
+    task->notifications = 0;
+    std::thread([function, parameters, task]() {
+        s_current_task = task;
+        function(parameters);
+    }).detach();
+    if (created_task) {
+        *created_task = task;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {}
+
+static uint64_t s_task_delay_ms = 0;
+
+void vTaskDelay(TickType_t ticks)
+{
+    s_task_delay_ms += ticks * portTICK_PERIOD_MS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_count_on_exit, TickType_t ticks_to_wait)
+{
+    host_task *task = s_current_task;
+    std::unique_lock<std::mutex> guard(task->lock);
+    task->notified.wait(guard, [task]() { return task->notifications > 0; });
+    uint32_t notifications = task->notifications;
+    task->notifications = clear_count_on_exit ? 0 : notifications - 1;
+    return notifications;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    if (task) {
+        std::lock_guard<std::mutex> guard(task->lock);
+        task->notifications++;
+        task->notified.notify_one();
+    }
+    return pdPASS;
+}
+
+struct host_semaphore {
+    std::mutex mutex;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    return new host_semaphore();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait)
+{
+    semaphore->mutex.lock();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    semaphore->mutex.unlock();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    delete semaphore;
+}
+
+static std::string s_nvs_dir;
+static size_t s_nvs_write_count = 0;
+// The file name prefix and the open mode of each handle, the handle is the index plus 1
+static std::vector<std::pair<std::string, nvs_open_mode_t>> s_nvs_handles;
+
+static std::string _nvs_file(nvs_handle_t handle, const char *key)
+{
+    return s_nvs_dir + "/" + s_nvs_handles[handle - 1].first + key;
+}
+
+esp_err_t nvs_open_from_partition(const char *part_name, const char *namespace_name, nvs_open_mode_t open_mode,
+                                  nvs_handle_t *out_handle)
+{
+    if (s_nvs_dir.empty()) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    s_nvs_handles.emplace_back(std::string(part_name) + "." + namespace_name + ".", open_mode);
+    *out_handle = s_nvs_handles.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    if (handle == 0 || handle > s_nvs_handles.size()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    FILE *file = fopen(_nvs_file(handle, key).c_str(), "rb");
+    if (!file) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    std::vector<uint8_t> value;
+    uint8_t buf[256];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+        value.insert(value.end(), buf, buf + len);
+    }
+    fclose(file);
+    if (out_value) {
+        if (*length < value.size()) {
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        }
+        memcpy(out_value, value.data(), value.size());
+    }
+    *length = value.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    if (handle == 0 || handle > s_nvs_handles.size()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (s_nvs_handles[handle - 1].second == NVS_READONLY) {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    FILE *file = fopen(_nvs_file(handle, key).c_str(), "wb");
+    if (!file) {
+        return ESP_FAIL;
+    }
+    bool written = fwrite(value, 1, length, file) == length;
+    fclose(file);
+    s_nvs_write_count++;
+    return written ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    if (handle == 0 || handle > s_nvs_handles.size()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (s_nvs_handles[handle - 1].second == NVS_READONLY) {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    return unlink(_nvs_file(handle, key).c_str()) == 0 ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    return handle == 0 || handle > s_nvs_handles.size() ? ESP_ERR_NVS_INVALID_HANDLE : ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {}
+
+namespace host_test {
+void set_spiffs_dir(const char *dir)
+{
+    s_spiffs_dir = dir;
+}
+
+const char *spiffs_path(const char *path)
+{
+    // The mapped paths of the last calls stay valid, a call may map several paths
+    static std::string paths[4];
+    static size_t next = 0;
+    size_t base_len = s_spiffs_base_path.size();
+    if (base_len == 0 || strncmp(path, s_spiffs_base_path.c_str(), base_len) != 0 ||
+        (path[base_len] != '/' && path[base_len] != '\0')) {
+        return path;
+    }
+    s_spiffs_access_count++;
+    std::string &mapped = paths[next];
+    next = (next + 1) % 4;
+    mapped = s_spiffs_dir + (path + base_len);
+    return mapped.c_str();
+}
+
+size_t spiffs_access_count()
+{
+    return s_spiffs_access_count;
+}
+
+void set_timer_time_us(int64_t time_us)
+{
+    s_timer_time_us = time_us;
+}
+
+void set_nvs_dir(const char *dir)
+{
+    s_nvs_dir = dir;
+}
+
+void set_run_tasks(bool run_tasks)
+{
+    s_run_tasks = run_tasks;
+}
+
+uint64_t task_delay_ms()
+{
+    return s_task_delay_ms;
+}
+
+size_t nvs_write_count()
+{
+    return s_nvs_write_count;
+}
+
+void set_free_heap_size(size_t size)
+{
+    s_free_heap_size = size;
+}
+
+size_t mem_in_use()
+{
+    return s_mem_in_use;
+}
+
+size_t mem_peak()
+{
+    return s_mem_peak;
+}
+} // namespace host_test
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static uint32_t _rotr(uint32_t x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+static void _sha256_block(mbedtls_sha256_context *ctx, const uint8_t *block)
+{
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (block[i * 4] << 24) | (block[i * 4 + 1] << 16) | (block[i * 4 + 2] << 8) | block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = _rotr(w[i - 15], 7) ^ _rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = _rotr(w[i - 2], 17) ^ _rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t v[8];
+    memcpy(v, ctx->state, sizeof(v));
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = _rotr(v[4], 6) ^ _rotr(v[4], 11) ^ _rotr(v[4], 25);
+        uint32_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        uint32_t t1 = v[7] + s1 + ch + sha256_k[i] + w[i];
+        uint32_t s0 = _rotr(v[0], 2) ^ _rotr(v[0], 13) ^ _rotr(v[0], 22);
+        uint32_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+        memmove(v + 1, v, sizeof(uint32_t) * 7);
+        v[4] += t1;
+        v[0] = t1 + s0 + maj;
+    }
+    for (int i = 0; i < 8; ++i) {
+        ctx->state[i] += v[i];
+    }
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context *ctx, int is224)
+{
+    static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    if (is224) {
+        return -1;
+    }
+    memcpy(ctx->state, init, sizeof(init));
+    ctx->total = 0;
+    return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen)
+{
+    while (ilen > 0) {
+        size_t used = ctx->total % 64;
+        size_t len = ilen < 64 - used ? ilen : 64 - used;
+        memcpy(ctx->buffer + used, input, len);
+        ctx->total += len;
+        input += len;
+        ilen -= len;
+        if (used + len == 64) {
+            _sha256_block(ctx, ctx->buffer);
+        }
+    }
+    return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context *ctx, unsigned char *output)
+{
+    uint64_t bits = ctx->total * 8;
+    uint8_t pad[72] = {0x80};
+    size_t used = ctx->total % 64;
+    size_t pad_len = (used < 56 ? 56 : 120) - used;
+    mbedtls_sha256_update(ctx, pad, pad_len);
+    for (int i = 0; i < 8; ++i) {
+        pad[i] = bits >> (56 - i * 8);
+    }
+    mbedtls_sha256_update(ctx, pad, 8);
+    for (int i = 0; i < 8; ++i) {
+        output[i * 4] = ctx->state[i] >> 24;
+        output[i * 4 + 1] = ctx->state[i] >> 16;
+        output[i * 4 + 2] = ctx->state[i] >> 8;
+        output[i * 4 + 3] = ctx->state[i];
+    }
+    return 0;
+}
+
+int mbedtls_base64_decode(unsigned char *dst, size_t dlen, size_t *olen, const unsigned char *src, size_t slen)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t padding = 0;
+    while (padding < 2 && slen > padding && src[slen - 1 - padding] == '=') {
+        padding++;
+    }
+    if ((slen % 4) != 0) {
+        return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    }
+    size_t len = slen / 4 * 3 - padding;
+    *olen = len;
+    if (!dst || dlen < len) {
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+    uint32_t bits = 0;
+    size_t out = 0;
+    for (size_t index = 0; index < slen - padding; ++index) {
+        const char *pos = src[index] ? strchr(alphabet, src[index]) : nullptr;
+        if (!pos) {
+            return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(pos - alphabet);
+        if (index % 4 == 3) {
+            dst[out++] = bits >> 16;
+            dst[out++] = bits >> 8;
+            dst[out++] = bits;
+        }
+    }
+    if (padding == 1) {
+        dst[out++] = bits >> 10;
+        dst[out++] = bits >> 2;
+    } else if (padding == 2) {
+        dst[out++] = bits >> 4;
+    }
+    return 0;
+}
+
+#if HOST_TEST_STRLCPY
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t copied = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, copied);
+        dst[copied] = '\0';
+    }
+    return len;
+}
+#endif
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    static char name[16];
+    snprintf(name, sizeof(name), "0x%x", code);
+    return name;
+}
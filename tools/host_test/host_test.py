@@ -0,0 +1,88 @@
+# Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Helpers of the host tests of the esp_matter components
+
+The host tests build the sources of a component with g++ and the headers of include/, which stand in for the ESP-IDF
+headers, and run them on Linux. The sources which use the Matter SDK are also built with the headers of chip/, which
+stand in for the few Matter SDK classes they use. The host tests do not need the pytest-embedded plugins of the
+repository pytest.ini:
+
+    pytest -c tools/host_test/pytest.ini tools/delta_ota tools/compressed_ota components/esp_matter_ota_provider/test_host \
+        components/esp_matter/test_host components/esp_matter_controller/test_host
+"""
+
+import os
+import pathlib
+import shutil
+import subprocess
+
+import pytest
+
+HOST_TEST_DIR = pathlib.Path(__file__).parent
+REPO_DIR = HOST_TEST_DIR.parent.parent
+COMPONENTS_DIR = REPO_DIR / 'components'
+
+# The error codes of include/esp_err.h
+ESP_OK = 0
+ESP_ERR_NO_MEM = 0x101
+ESP_ERR_INVALID_ARG = 0x102
+ESP_ERR_INVALID_STATE = 0x103
+ESP_ERR_INVALID_SIZE = 0x104
+ESP_ERR_NOT_FOUND = 0x105
+ESP_ERR_NOT_SUPPORTED = 0x106
+ESP_ERR_INVALID_CRC = 0x109
+ESP_ERR_INVALID_VERSION = 0x10A
+
+
+def build(output, sources, include_dirs=(), chip=False, defines=(), cflags=()):
+    """Build a host test program from the sources, the test is skipped without a C++ compiler
+
+    With chip, the sources are built with the host Matter SDK headers of chip/ and the scheduled work of the Matter
+    thread is run by host_test::run_scheduled_work(). The defines are the Kconfig options of the tested sources and the
+    cflags are the compile options their component adds to the ESP-IDF ones.
+    """
+    cxx = os.environ.get('CXX', 'g++')
+    if not shutil.which(cxx):
+        pytest.skip(f'{cxx} is required to build the host tests')
+    cmd = [cxx, '-std=c++17', '-g', '-Wall', '-Werror', '-fsanitize=address,undefined', '-pthread', '-o', str(output),
+           '-I', str(HOST_TEST_DIR / 'include'), '-include', 'host_test_compat.h']
+    if chip:
+        cmd += ['-I', str(HOST_TEST_DIR / 'chip')]
+    for include_dir in include_dirs:
+        cmd += ['-I', str(include_dir)]
+    cmd += [f'-D{define}' for define in defines]
+    cmd += list(cflags)
+    cmd += [str(source) for source in sources]
+    if chip:
+        cmd.append(str(HOST_TEST_DIR / 'chip' / 'chip_host.cpp'))
+    cmd += [str(HOST_TEST_DIR / 'host_test.cpp'), str(HOST_TEST_DIR / 'json_parser.cpp')]
+    subprocess.run(cmd, check=True)
+    return output
+
+
+def run(program, *args):
+    """Run a host test program, it prints the esp_err_t result of the tested calls as 'result 0x<code>' and the
+    other values it checks as '<name> <value>' lines"""
+    proc = subprocess.run([str(program)] + [str(arg) for arg in args], stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                          text=True, check=True)
+    results = {}
+    for line in proc.stdout.splitlines():
+        key, _, value = line.partition(' ')
+        try:
+            results[key] = int(value, 0)
+        except ValueError:
+            results[key] = value
+    return results
@@ -0,0 +1,28 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the esp_matter allocator, the allocations are counted so that the tests can check the peak memory
+
+#pragma once
+
+#include <stddef.h>
+
+void *esp_matter_mem_calloc(size_t n, size_t size);
+void esp_matter_mem_free(void *ptr);
+
+namespace host_test {
+// Bytes currently allocated with esp_matter_mem_calloc() and the highest count so far
+size_t mem_in_use();
+size_t mem_peak();
+} // namespace host_test
@@ -0,0 +1,51 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the SPIFFS VFS of ESP-IDF. The partition is a host directory set by the test, the paths under the
+// registered base path are mapped to it in the sources which include this header, as the VFS routes them.
+
+#pragma once
+
+#include <dirent.h>
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    const char *base_path;
+    const char *partition_label;
+    size_t max_files;
+    bool format_if_mount_failed;
+} esp_vfs_spiffs_conf_t;
+
+esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t *conf);
+esp_err_t esp_vfs_spiffs_unregister(const char *partition_label);
+esp_err_t esp_spiffs_info(const char *partition_label, size_t *total_bytes, size_t *used_bytes);
+
+namespace host_test {
+// The host directory of the SPIFFS partition, esp_vfs_spiffs_register() fails if it is not set
+void set_spiffs_dir(const char *dir);
+// The host path of a path under the registered base path, the other paths are not changed
+const char *spiffs_path(const char *path);
+// The number of accesses to the files and directories of the partition
+size_t spiffs_access_count();
+} // namespace host_test
+
+#define fopen(path, mode) fopen(host_test::spiffs_path(path), mode)
+#define opendir(path) opendir(host_test::spiffs_path(path))
+#define stat(path, buf) stat(host_test::spiffs_path(path), buf)
+#define unlink(path) unlink(host_test::spiffs_path(path))
@@ -0,0 +1,27 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Host build of the esp_timer API of ESP-IDF, the time since boot is set by the test
+
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time();
+
+namespace host_test {
+// The time returned by esp_timer_get_time(), 0 by default
+void set_timer_time_us(int64_t time_us);
+} // namespace host_test
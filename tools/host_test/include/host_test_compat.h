@@ -0,0 +1,32 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Functions of the newlib C library of ESP-IDF which the host C library may not have, this header is included in all
+// the sources of the host tests
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+#define HOST_TEST_STRLCPY 1
+#ifdef __cplusplus
+extern "C" {
+#endif
+size_t strlcpy(char *dst, const char *src, size_t size);
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,50 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Host build of the subset of the json_parser component API used by the components tested on Linux, implemented in
+// json_parser.cpp
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define OS_SUCCESS 0
+#define OS_FAIL -1
+
+typedef struct json_tok json_tok_t;
+
+typedef struct {
+    json_tok_t *tokens;
+    int num_tokens;
+    // The object or array the getters look into
+    int cur;
+} jparse_ctx_t;
+
+int json_parse_start(jparse_ctx_t *jctx, const char *js, int len);
+int json_parse_end(jparse_ctx_t *jctx);
+
+int json_obj_get_array(jparse_ctx_t *jctx, const char *name, int *num_elem);
+int json_obj_leave_array(jparse_ctx_t *jctx);
+int json_obj_get_object(jparse_ctx_t *jctx, const char *name);
+int json_obj_leave_object(jparse_ctx_t *jctx);
+int json_obj_get_bool(jparse_ctx_t *jctx, const char *name, bool *val);
+int json_obj_get_int(jparse_ctx_t *jctx, const char *name, int *val);
+int json_obj_get_int64(jparse_ctx_t *jctx, const char *name, int64_t *val);
+int json_obj_get_strlen(jparse_ctx_t *jctx, const char *name, int *strlen);
+int json_obj_get_string(jparse_ctx_t *jctx, const char *name, char *val, int size);
+
+int json_arr_get_object(jparse_ctx_t *jctx, uint32_t index);
+int json_arr_leave_object(jparse_ctx_t *jctx);
+int json_arr_get_int(jparse_ctx_t *jctx, uint32_t index, int *val);
@@ -0,0 +1,321 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctype.h>
+#include <json_parser.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef enum {
+    k_tok_object,
+    k_tok_array,
+    k_tok_string,
+    k_tok_primitive,
+} json_tok_type_t;
+
+struct json_tok {
+    json_tok_type_t type;
+    // The string tokens hold the string as in the JSON, with its escape sequences, the primitive tokens their text
+    std::string text;
+    // The tokens of an object are its keys followed by their value, the tokens of an array its elements
+    std::vector<int> children;
+    int parent;
+};
+
+class json_host_parser {
+public:
+    json_host_parser(const char *js, int len) : m_js(js), m_len(len) {}
+
+    bool parse(std::vector<json_tok> &tokens)
+    {
+        m_tokens = &tokens;
+        if (parse_value(-1) != 0) {
+            return false;
+        }
+        skip_spaces();
+        return m_pos == m_len && tokens[0].type == k_tok_object;
+    }
+
+private:
+    void skip_spaces()
+    {
+        while (m_pos < m_len && isspace(static_cast<unsigned char>(m_js[m_pos]))) {
+            m_pos++;
+        }
+    }
+
+    int add_token(json_tok_type_t type, int parent)
+    {
+        m_tokens->push_back({type, "", {}, parent});
+        int index = static_cast<int>(m_tokens->size()) - 1;
+        if (parent >= 0) {
+            (*m_tokens)[parent].children.push_back(index);
+        }
+        return index;
+    }
+
+    int parse_string(int parent)
+    {
+        int index = add_token(k_tok_string, parent);
+        std::string text;
+        for (m_pos++; m_pos < m_len && m_js[m_pos] != '"'; m_pos++) {
+            // As with jsmn, the escape sequences are kept in the string
+            if (m_js[m_pos] == '\\') {
+                text += m_js[m_pos++];
+                if (m_pos >= m_len) {
+                    return -1;
+                }
+            }
+            text += m_js[m_pos];
+        }
+        if (m_pos >= m_len) {
+            return -1;
+        }
+        m_pos++;
+        (*m_tokens)[index].text = text;
+        return 0;
+    }
+
+    int parse_value(int parent)
+    {
+        skip_spaces();
+        if (m_pos >= m_len) {
+            return -1;
+        }
+        char c = m_js[m_pos];
+        if (c == '"') {
+            return parse_string(parent);
+        }
+        if (c == '{' || c == '[') {
+            bool object = c == '{';
+            int index = add_token(object ? k_tok_object : k_tok_array, parent);
+            m_pos++;
+            skip_spaces();
+            if (m_pos < m_len && m_js[m_pos] == (object ? '}' : ']')) {
+                m_pos++;
+                return 0;
+            }
+            while (true) {
+                if (object) {
+                    skip_spaces();
+                    if (m_pos >= m_len || m_js[m_pos] != '"' || parse_string(index) != 0) {
+                        return -1;
+                    }
+                    skip_spaces();
+                    if (m_pos >= m_len || m_js[m_pos++] != ':') {
+                        return -1;
+                    }
+                }
+                if (parse_value(index) != 0) {
+                    return -1;
+                }
+                skip_spaces();
+                if (m_pos >= m_len) {
+                    return -1;
+                }
+                c = m_js[m_pos++];
+                if (c == (object ? '}' : ']')) {
+                    return 0;
+                }
+                if (c != ',') {
+                    return -1;
+                }
+            }
+        }
+        int index = add_token(k_tok_primitive, parent);
+        int start = m_pos;
+        while (m_pos < m_len && !isspace(static_cast<unsigned char>(m_js[m_pos])) && !strchr(",]}", m_js[m_pos])) {
+            m_pos++;
+        }
+        (*m_tokens)[index].text.assign(m_js + start, m_pos - start);
+        return m_pos > start ? 0 : -1;
+    }
+
+    const char *m_js;
+    int m_len;
+    int m_pos = 0;
+    std::vector<json_tok> *m_tokens = nullptr;
+};
+
+int json_parse_start(jparse_ctx_t *jctx, const char *js, int len)
+{
+    std::vector<json_tok> tokens;
+    if (!jctx || !js || len <= 0 || !json_host_parser(js, len).parse(tokens)) {
+        return OS_FAIL;
+    }
+    jctx->tokens = new json_tok[tokens.size()];
+    for (size_t index = 0; index < tokens.size(); ++index) {
+        jctx->tokens[index] = tokens[index];
+    }
+    jctx->num_tokens = static_cast<int>(tokens.size());
+    jctx->cur = 0;
+    return OS_SUCCESS;
+}
+
+int json_parse_end(jparse_ctx_t *jctx)
+{
+    delete[] jctx->tokens;
+    jctx->tokens = nullptr;
+    jctx->num_tokens = 0;
+    return OS_SUCCESS;
+}
+
+// Find the value of a key in the current object, or nullptr
+static json_tok *_get_value(jparse_ctx_t *jctx, const char *name, int *index = nullptr)
+{
+    json_tok &object = jctx->tokens[jctx->cur];
+    if (object.type != k_tok_object) {
+        return nullptr;
+    }
+    for (size_t child = 0; child + 1 < object.children.size(); child += 2) {
+        if (jctx->tokens[object.children[child]].text == name) {
+            if (index) {
+                *index = object.children[child + 1];
+            }
+            return &jctx->tokens[object.children[child + 1]];
+        }
+    }
+    return nullptr;
+}
+
+static int _leave(jparse_ctx_t *jctx)
+{
+    if (jctx->tokens[jctx->cur].parent < 0) {
+        return OS_FAIL;
+    }
+    jctx->cur = jctx->tokens[jctx->cur].parent;
+    return OS_SUCCESS;
+}
+
+int json_obj_get_array(jparse_ctx_t *jctx, const char *name, int *num_elem)
+{
+    int index;
+    json_tok *value = _get_value(jctx, name, &index);
+    if (!value || value->type != k_tok_array) {
+        return OS_FAIL;
+    }
+    jctx->cur = index;
+    *num_elem = static_cast<int>(value->children.size());
+    return OS_SUCCESS;
+}
+
+int json_obj_leave_array(jparse_ctx_t *jctx)
+{
+    return _leave(jctx);
+}
+
+int json_obj_get_object(jparse_ctx_t *jctx, const char *name)
+{
+    int index;
+    json_tok *value = _get_value(jctx, name, &index);
+    if (!value || value->type != k_tok_object) {
+        return OS_FAIL;
+    }
+    jctx->cur = index;
+    return OS_SUCCESS;
+}
+
+int json_obj_leave_object(jparse_ctx_t *jctx)
+{
+    return _leave(jctx);
+}
+
+int json_obj_get_bool(jparse_ctx_t *jctx, const char *name, bool *val)
+{
+    json_tok *value = _get_value(jctx, name);
+    if (!value || value->type != k_tok_primitive || (value->text != "true" && value->text != "false")) {
+        return OS_FAIL;
+    }
+    *val = value->text == "true";
+    return OS_SUCCESS;
+}
+
+static int _get_int64(json_tok *value, int64_t *val)
+{
+    if (!value || value->type != k_tok_primitive) {
+        return OS_FAIL;
+    }
+    char *end = nullptr;
+    long long number = strtoll(value->text.c_str(), &end, 10);
+    if (end == value->text.c_str() || *end != '\0') {
+        return OS_FAIL;
+    }
+    *val = number;
+    return OS_SUCCESS;
+}
+
+int json_obj_get_int64(jparse_ctx_t *jctx, const char *name, int64_t *val)
+{
+    return _get_int64(_get_value(jctx, name), val);
+}
+
+int json_obj_get_int(jparse_ctx_t *jctx, const char *name, int *val)
+{
+    int64_t number;
+    if (json_obj_get_int64(jctx, name, &number) != OS_SUCCESS) {
+        return OS_FAIL;
+    }
+    *val = static_cast<int>(number);
+    return OS_SUCCESS;
+}
+
+int json_obj_get_strlen(jparse_ctx_t *jctx, const char *name, int *strlen)
+{
+    json_tok *value = _get_value(jctx, name);
+    if (!value || value->type != k_tok_string) {
+        return OS_FAIL;
+    }
+    *strlen = static_cast<int>(value->text.size());
+    return OS_SUCCESS;
+}
+
+int json_obj_get_string(jparse_ctx_t *jctx, const char *name, char *val, int size)
+{
+    json_tok *value = _get_value(jctx, name);
+    if (!value || value->type != k_tok_string || static_cast<int>(value->text.size()) >= size) {
+        return OS_FAIL;
+    }
+    memcpy(val, value->text.c_str(), value->text.size() + 1);
+    return OS_SUCCESS;
+}
+
+int json_arr_get_object(jparse_ctx_t *jctx, uint32_t index)
+{
+    json_tok &array = jctx->tokens[jctx->cur];
+    if (array.type != k_tok_array || index >= array.children.size() ||
+        jctx->tokens[array.children[index]].type != k_tok_object) {
+        return OS_FAIL;
+    }
+    jctx->cur = array.children[index];
+    return OS_SUCCESS;
+}
+
+int json_arr_leave_object(jparse_ctx_t *jctx)
+{
+    return _leave(jctx);
+}
+
+int json_arr_get_int(jparse_ctx_t *jctx, uint32_t index, int *val)
+{
+    json_tok &array = jctx->tokens[jctx->cur];
+    int64_t number;
+    if (array.type != k_tok_array || index >= array.children.size() ||
+        _get_int64(&jctx->tokens[array.children[index]], &number) != OS_SUCCESS) {
+        return OS_FAIL;
+    }
+    *val = static_cast<int>(number);
+    return OS_SUCCESS;
+}